@@ -6,6 +6,7 @@ include $(CLEAR_VARS)
 LOCAL_CPP_EXTENSION := .cc
 
 LOCAL_SRC_FILES := \
+    source/batch.cc             \
     source/compare.cc           \
     source/compare_common.cc    \
     source/compare_gcc.cc       \
@@ -15,11 +16,13 @@ LOCAL_SRC_FILES := \
     source/compare_neon64.cc    \
     source/convert.cc           \
     source/convert_argb.cc      \
+    source/convert_bayer.cc     \
     source/convert_from.cc      \
     source/convert_from_argb.cc \
     source/convert_to_argb.cc   \
     source/convert_to_i420.cc   \
     source/cpu_id.cc            \
+    source/executor.cc          \
     source/planar_functions.cc  \
     source/rotate.cc            \
     source/rotate_any.cc        \
@@ -46,6 +49,11 @@ LOCAL_SRC_FILES := \
     source/scale_msa.cc         \
     source/scale_neon.cc        \
     source/scale_neon64.cc      \
+    source/scale_plan.cc        \
+    source/scale_uv.cc          \
+    source/scratch.cc           \
+    source/slice.cc             \
+    source/stats.cc             \
     source/video_common.cc
 
 common_CFLAGS := -Wall -fexceptions
@@ -87,17 +95,24 @@ LOCAL_C_INCLUDES += $(LOCAL_PATH)/include
 LOCAL_SRC_FILES := \
     unit_test/unit_test.cc        \
     unit_test/basictypes_test.cc  \
+    unit_test/batch_test.cc       \
     unit_test/color_test.cc       \
     unit_test/compare_test.cc     \
     unit_test/convert_test.cc     \
     unit_test/cpu_test.cc         \
     unit_test/cpu_thread_test.cc  \
+    unit_test/executor_test.cc    \
     unit_test/math_test.cc        \
     unit_test/planar_test.cc      \
     unit_test/rotate_argb_test.cc \
     unit_test/rotate_test.cc      \
     unit_test/scale_argb_test.cc  \
+    unit_test/scale_plan_test.cc  \
     unit_test/scale_test.cc       \
+    unit_test/scale_uv_test.cc    \
+    unit_test/scratch_test.cc     \
+    unit_test/slice_test.cc       \
+    unit_test/stats_test.cc       \
     unit_test/video_common_test.cc
 
 LOCAL_MODULE := libyuv_unittest
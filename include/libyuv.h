@@ -12,12 +12,14 @@
 #define INCLUDE_LIBYUV_H_
 
 #include "libyuv/basic_types.h"
+#include "libyuv/batch.h"
 #include "libyuv/compare.h"
 #include "libyuv/convert.h"
 #include "libyuv/convert_argb.h"
 #include "libyuv/convert_from.h"
 #include "libyuv/convert_from_argb.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/executor.h"
 #include "libyuv/mjpeg_decoder.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
@@ -25,7 +27,12 @@
 #include "libyuv/row.h"
 #include "libyuv/scale.h"
 #include "libyuv/scale_argb.h"
+#include "libyuv/scale_plan.h"
 #include "libyuv/scale_row.h"
+#include "libyuv/scale_uv.h"
+#include "libyuv/scratch.h"
+#include "libyuv/slice.h"
+#include "libyuv/stats.h"
 #include "libyuv/version.h"
 #include "libyuv/video_common.h"
 
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_BATCH_H_
+#define INCLUDE_LIBYUV_BATCH_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/scale.h"  // For FilterMode
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// A frame of a batch conversion.
+// For NV12 and NV21 sources src_u is the interleaved UV plane and src_v is
+// unused. When the destination size differs from the source size the frame
+// is scaled.
+struct YUVToARGBBatchFrame {
+  const uint8_t* src_y;
+  int src_stride_y;
+  const uint8_t* src_u;
+  int src_stride_u;
+  const uint8_t* src_v;
+  int src_stride_v;
+  int src_width;
+  int src_height;
+  uint8_t* dst_argb;
+  int dst_stride_argb;
+  int dst_width;
+  int dst_height;
+};
+
+// Convert many small frames, such as the tiles of a sprite sheet or a set of
+// thumbnails, to ARGB or ABGR.
+// src_fourcc is FOURCC_I420, FOURCC_NV12 or FOURCC_NV21, and dst_fourcc is
+// FOURCC_ARGB or FOURCC_ABGR. Row functions are chosen once for the batch
+// and temporary buffers are shared by the frames. Frames of the same size
+// share a ScalePlan, so scalers and filter tables are set up once for each
+// distinct geometry; the interleaved UV plane of NV12 and NV21 is scaled with
+// UVScale, which has no tables to share. With an executor set by
+// SetThreadExecutor frames are converted in parallel.
+// Returns 0 if successful, or -1 without converting any frame if a frame or
+// format is invalid or memory could not be allocated.
+LIBYUV_API
+int YUVToARGBBatch(const struct YUVToARGBBatchFrame* frames,
+                   int num_frames,
+                   uint32_t src_fourcc,
+                   uint32_t dst_fourcc,
+                   enum FilterMode filtering);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_BATCH_H_
@@ -50,11 +50,59 @@ uint64_t ComputeSumSquareErrorPlane(const uint8_t* src_a,
                                     int width,
                                     int height);
 
+// Sum Square Error of 16 bit samples.
+LIBYUV_API
+uint64_t ComputeSumSquareError_16(const uint16_t* src_a,
+                                  const uint16_t* src_b,
+                                  int count);
+
+// Strides are in samples.
+LIBYUV_API
+uint64_t ComputeSumSquareErrorPlane_16(const uint16_t* src_a,
+                                       int stride_a,
+                                       const uint16_t* src_b,
+                                       int stride_b,
+                                       int width,
+                                       int height);
+
+// Sum Square Error of each block_size x block_size block, in one pass over
+// the planes. dst_sse is a map of (width + block_size - 1) / block_size by
+// (height + block_size - 1) / block_size blocks, with dst_stride_sse in
+// elements. Blocks at the right and bottom edges sum the pixels they cover.
+// block_size is 1 to 256. Returns 0 if successful.
+LIBYUV_API
+int ComputeSumSquareErrorBlocks(const uint8_t* src_a,
+                                int stride_a,
+                                const uint8_t* src_b,
+                                int stride_b,
+                                int width,
+                                int height,
+                                int block_size,
+                                uint32_t* dst_sse,
+                                int dst_stride_sse);
+
+// Sum Square Error of each block of planes of uint16_t samples. Strides are
+// in samples.
+LIBYUV_API
+int ComputeSumSquareErrorBlocks_16(const uint16_t* src_a,
+                                   int stride_a,
+                                   const uint16_t* src_b,
+                                   int stride_b,
+                                   int width,
+                                   int height,
+                                   int block_size,
+                                   uint64_t* dst_sse,
+                                   int dst_stride_sse);
+
 static const int kMaxPsnr = 128;
 
 LIBYUV_API
 double SumSquareErrorToPsnr(uint64_t sse, uint64_t count);
 
+// PSNR of samples of depth bits, with a peak of (1 << depth) - 1.
+LIBYUV_API
+double SumSquareErrorToPsnr_16(uint64_t sse, uint64_t count, int depth);
+
 LIBYUV_API
 double CalcFramePsnr(const uint8_t* src_a,
                      int stride_a,
@@ -79,6 +127,32 @@ double I420Psnr(const uint8_t* src_y_a,
                 int width,
                 int height);
 
+LIBYUV_API
+double CalcFramePsnr_16(const uint16_t* src_a,
+                        int stride_a,
+                        const uint16_t* src_b,
+                        int stride_b,
+                        int width,
+                        int height,
+                        int depth);
+
+// PSNR of 10 bit I420 frames.
+LIBYUV_API
+double I010Psnr(const uint16_t* src_y_a,
+                int stride_y_a,
+                const uint16_t* src_u_a,
+                int stride_u_a,
+                const uint16_t* src_v_a,
+                int stride_v_a,
+                const uint16_t* src_y_b,
+                int stride_y_b,
+                const uint16_t* src_u_b,
+                int stride_u_b,
+                const uint16_t* src_v_b,
+                int stride_v_b,
+                int width,
+                int height);
+
 LIBYUV_API
 double CalcFrameSsim(const uint8_t* src_a,
                      int stride_a,
@@ -87,6 +161,47 @@ double CalcFrameSsim(const uint8_t* src_a,
                      int width,
                      int height);
 
+// SSIM of planes of 8 to 12 bit samples stored in uint16_t. Strides are in
+// samples. Returns 0 for other depths.
+LIBYUV_API
+double CalcFrameSsim_16(const uint16_t* src_a,
+                        int stride_a,
+                        const uint16_t* src_b,
+                        int stride_b,
+                        int width,
+                        int height,
+                        int depth);
+
+// Map of the mean SSIM of the 8x8 windows of CalcFrameSsim in each
+// block_size x block_size block, on the same grid as
+// ComputeSumSquareErrorBlocks. A window belongs to the block its top left
+// pixel is in. Blocks at the right and bottom edges with no window repeat
+// the block next to them. block_size is a multiple of 4. Returns 0 if
+// successful, or -1 if the planes are too small for a window.
+LIBYUV_API
+int CalcSsimMap(const uint8_t* src_a,
+                int stride_a,
+                const uint8_t* src_b,
+                int stride_b,
+                int width,
+                int height,
+                int block_size,
+                float* dst_ssim,
+                int dst_stride_ssim);
+
+// SSIM map of planes of 8 to 12 bit samples stored in uint16_t.
+LIBYUV_API
+int CalcSsimMap_16(const uint16_t* src_a,
+                   int stride_a,
+                   const uint16_t* src_b,
+                   int stride_b,
+                   int width,
+                   int height,
+                   int depth,
+                   int block_size,
+                   float* dst_ssim,
+                   int dst_stride_ssim);
+
 LIBYUV_API
 double I420Ssim(const uint8_t* src_y_a,
                 int stride_y_a,
@@ -103,6 +218,23 @@ double I420Ssim(const uint8_t* src_y_a,
                 int width,
                 int height);
 
+// SSIM of 10 bit I420 frames.
+LIBYUV_API
+double I010Ssim(const uint16_t* src_y_a,
+                int stride_y_a,
+                const uint16_t* src_u_a,
+                int stride_u_a,
+                const uint16_t* src_v_a,
+                int stride_v_a,
+                const uint16_t* src_y_b,
+                int stride_y_b,
+                const uint16_t* src_u_b,
+                int stride_u_b,
+                const uint16_t* src_v_b,
+                int stride_v_b,
+                int width,
+                int height);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
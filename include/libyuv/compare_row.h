@@ -45,6 +45,13 @@ extern "C" {
 #endif  // clang >= 3.4
 #endif  // __clang__
 
+// GCC >= 4.7.0 required for AVX2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ > 4) || (__GNUC__ == 4 && (__GNUC_MINOR__ >= 7))
+#define GCC_HAS_AVX2 1
+#endif  // GNUC >= 4.7
+#endif  // __GNUC__
+
 // The following are available for Visual C and GCC:
 #if !defined(LIBYUV_DISABLE_X86) && \
     (defined(__x86_64__) || defined(__i386__) || defined(_M_IX86))
@@ -72,6 +79,17 @@ extern "C" {
 #define HAS_HAMMINGDISTANCE_AVX2
 #endif
 
+// The following are available for GCC and clang 64 bit x86:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__)
+#define HAS_SSIMSUMS4X4_SSE41
+#define HAS_SSIMSUMS4X4_16_SSE41
+#define HAS_SUMSQUAREERROR_16_SSE2
+#if defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2)
+#define HAS_SSIMSUMS4X4_AVX2
+#define HAS_SUMSQUAREERROR_16_AVX2
+#endif
+#endif
+
 // The following are available for Neon:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
@@ -79,6 +97,13 @@ extern "C" {
 #define HAS_HAMMINGDISTANCE_NEON
 #endif
 
+// The following are available for Neon 64 bit:
+#if !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
+#define HAS_SSIMSUMS4X4_NEON
+#define HAS_SSIMSUMS4X4_16_NEON
+#define HAS_SUMSQUAREERROR_16_NEON
+#endif
+
 #if !defined(LIBYUV_DISABLE_MSA) && defined(__mips_msa)
 #define HAS_HAMMINGDISTANCE_MSA
 #define HAS_SUMSQUAREERROR_MSA
@@ -128,6 +153,68 @@ uint32_t SumSquareError_MSA(const uint8_t* src_a,
 uint32_t SumSquareError_MMI(const uint8_t* src_a,
                             const uint8_t* src_b,
                             int count);
+// Sum square error of 16 bit samples. The SIMD versions require
+// count to be a multiple of 16, or 32 for AVX2.
+uint64_t SumSquareError_16_C(const uint16_t* src_a,
+                             const uint16_t* src_b,
+                             int count);
+uint64_t SumSquareError_16_SSE2(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count);
+uint64_t SumSquareError_16_AVX2(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count);
+uint64_t SumSquareError_16_NEON(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count);
+
+// Sums of a, b, a * a, b * b and a * b of the 4x4 blocks of 4 rows, used by
+// SSIM. width is in pixels and a multiple of 4. Each group of 4 blocks is
+// stored as 20 sums: 4 of a, 4 of b, 4 of a * a, 4 of b * b and 4 of a * b.
+// The SIMD versions require width to be a multiple of 16, or 32 for AVX2.
+// The 16 bit versions support up to 12 bits.
+void SsimSums4x4_C(const uint8_t* src_a,
+                   int stride_a,
+                   const uint8_t* src_b,
+                   int stride_b,
+                   uint32_t* sums,
+                   int width);
+void SsimSums4x4_SSE41(const uint8_t* src_a,
+                       int stride_a,
+                       const uint8_t* src_b,
+                       int stride_b,
+                       uint32_t* sums,
+                       int width);
+void SsimSums4x4_AVX2(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width);
+void SsimSums4x4_NEON(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width);
+void SsimSums4x4_16_C(const uint16_t* src_a,
+                      int stride_a,
+                      const uint16_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width);
+void SsimSums4x4_16_SSE41(const uint16_t* src_a,
+                          int stride_a,
+                          const uint16_t* src_b,
+                          int stride_b,
+                          uint32_t* sums,
+                          int width);
+void SsimSums4x4_16_NEON(const uint16_t* src_a,
+                         int stride_a,
+                         const uint16_t* src_b,
+                         int stride_b,
+                         uint32_t* sums,
+                         int width);
 
 uint32_t HashDjb2_C(const uint8_t* src, int count, uint32_t seed);
 uint32_t HashDjb2_SSE41(const uint8_t* src, int count, uint32_t seed);
@@ -14,6 +14,7 @@
 #include "libyuv/basic_types.h"
 
 #include "libyuv/rotate.h"  // For enum RotationMode.
+#include "libyuv/scale.h"   // For enum FilterMode.
 
 // TODO(fbarchard): fix WebRTC source to include following libyuv headers:
 #include "libyuv/convert_argb.h"      // For WebRTC I420ToARGB. b/620
@@ -144,6 +145,51 @@ int I010ToI420(const uint16_t* src_y,
                int width,
                int height);
 
+// Convert P010 to I010.
+// P010 is biplanar 4:2:0 with 10 bits in the upper bits of 16 bit samples.
+LIBYUV_API
+int P010ToI010(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint16_t* dst_y,
+               int dst_stride_y,
+               uint16_t* dst_u,
+               int dst_stride_u,
+               uint16_t* dst_v,
+               int dst_stride_v,
+               int width,
+               int height);
+
+// Convert I010 to P010.
+LIBYUV_API
+int I010ToP010(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_u,
+               int src_stride_u,
+               const uint16_t* src_v,
+               int src_stride_v,
+               uint16_t* dst_y,
+               int dst_stride_y,
+               uint16_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height);
+
+// Convert P010 to NV12, rounding to the nearest 8 bit value.
+// Also works for P016.
+LIBYUV_API
+int P010ToNV12(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height);
+
 // Convert I400 (grey) to I420.
 LIBYUV_API
 int I400ToI420(const uint8_t* src_y,
@@ -157,6 +203,21 @@ int I400ToI420(const uint8_t* src_y,
                int width,
                int height);
 
+// Convert Bayer to I420 with a bilinear demosaic, without an ARGB frame.
+// fourcc is FOURCC_RGGB, FOURCC_BGGR, FOURCC_GRBG or FOURCC_GBRG.
+LIBYUV_API
+int BayerToI420(const uint8_t* src_bayer,
+                int src_stride_bayer,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_u,
+                int dst_stride_u,
+                uint8_t* dst_v,
+                int dst_stride_v,
+                int width,
+                int height,
+                uint32_t fourcc);
+
 // Convert I400 (grey) to NV21.
 LIBYUV_API
 int I400ToNV21(const uint8_t* src_y,
@@ -426,6 +487,38 @@ int MJPGToNV21(const uint8_t* sample,
                int dst_width,
                int dst_height);
 
+// JPEG to I420 scaled to dst_width x dst_height. The frame is decoded at
+// 1/2, 1/4 or 1/8 size by libjpeg when that is at least dst_width x
+// dst_height, and the remaining ratio is scaled with filtering.
+LIBYUV_API
+int MJPGToI420Scaled(const uint8_t* sample,
+                     size_t sample_size,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering);
+
+// JPEG to NV21 scaled to dst_width x dst_height.
+LIBYUV_API
+int MJPGToNV21Scaled(const uint8_t* sample,
+                     size_t sample_size,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_vu,
+                     int dst_stride_vu,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering);
+
 // Query size of MJPG in pixels.
 LIBYUV_API
 int MJPGSize(const uint8_t* sample,
@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_EXECUTOR_H_
+#define INCLUDE_LIBYUV_EXECUTOR_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Processes items [begin, end) of a range.
+typedef void (*ParallelRangeFunc)(void* arg, int begin, int end);
+
+// An executor runs ranges in parallel on behalf of libyuv.
+// parallel_for must call func(arg, begin, end) for subranges that together
+// cover [0, count) exactly once, from any threads including the calling
+// thread, and return when all calls have finished.
+// concurrency is the number of ranges libyuv splits work into, typically the
+// number of threads available to the executor.
+struct ParallelExecutor {
+  void (*parallel_for)(void* opaque,
+                       int count,
+                       ParallelRangeFunc func,
+                       void* arg);
+  void* opaque;
+  int concurrency;
+};
+
+// Create a pool of num_threads - 1 worker threads. The thread calling
+// parallel_for also does work, so num_threads is the concurrency.
+// The pool may be shared by any number of threads.
+LIBYUV_API
+struct ParallelExecutor* CreateThreadPool(int num_threads);
+
+LIBYUV_API
+void DestroyThreadPool(struct ParallelExecutor* executor);
+
+// Set the executor used by libyuv functions called on the current thread.
+// Frame level conversion, rotation and scaling functions split their rows
+// between the threads of the executor. NULL, the default, does all work on
+// the calling thread. The executor must outlive its use.
+LIBYUV_API
+void SetThreadExecutor(const struct ParallelExecutor* executor);
+
+LIBYUV_API
+const struct ParallelExecutor* GetThreadExecutor(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_EXECUTOR_H_
@@ -22,6 +22,8 @@ namespace libyuv {
 extern "C" {
 #endif
 
+struct YuvConstants;  // See convert_argb.h
+
 // TODO(fbarchard): Move cpu macros to row.h
 #if defined(__pnacl__) || defined(__CLR_VER) ||            \
     (defined(__native_client__) && defined(__x86_64__)) || \
@@ -105,6 +107,54 @@ void MergeUVPlane(const uint8_t* src_u,
                   int width,
                   int height);
 
+// Split a 16 bit interleaved UV plane with msb data, as found in P010 and
+// P016, into separate U and V planes with lsb data.
+// depth is the number of bits of the lsb data, e.g. 10 for P010.
+LIBYUV_API
+void SplitUVPlane_16(const uint16_t* src_uv,
+                     int src_stride_uv,
+                     uint16_t* dst_u,
+                     int dst_stride_u,
+                     uint16_t* dst_v,
+                     int dst_stride_v,
+                     int width,
+                     int height,
+                     int depth);
+
+// Merge separate U and V planes with lsb data into a 16 bit interleaved UV
+// plane with msb data.
+LIBYUV_API
+void MergeUVPlane_16(const uint16_t* src_u,
+                     int src_stride_u,
+                     const uint16_t* src_v,
+                     int src_stride_v,
+                     uint16_t* dst_uv,
+                     int dst_stride_uv,
+                     int width,
+                     int height,
+                     int depth);
+
+// Convert a plane of 16 bit lsb data, as found in I010, to msb data, as
+// found in P010.
+LIBYUV_API
+void ConvertToMSBPlane_16(const uint16_t* src_y,
+                          int src_stride_y,
+                          uint16_t* dst_y,
+                          int dst_stride_y,
+                          int width,
+                          int height,
+                          int depth);
+
+// Convert a plane of 16 bit msb data to lsb data.
+LIBYUV_API
+void ConvertToLSBPlane_16(const uint16_t* src_y,
+                          int src_stride_y,
+                          uint16_t* dst_y,
+                          int dst_stride_y,
+                          int width,
+                          int height,
+                          int depth);
+
 // Split interleaved RGB plane into separate R, G and B planes.
 LIBYUV_API
 void SplitRGBPlane(const uint8_t* src_rgb,
@@ -355,6 +405,20 @@ int I422ToRGBA(const uint8_t* src_y,
                int width,
                int height);
 
+// Convert I422 to RGBA with matrix.
+LIBYUV_API
+int I422ToRGBAMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_rgba,
+                     int dst_stride_rgba,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height);
+
 // Alias
 #define RGB24ToRAW RAWToRGB24
 
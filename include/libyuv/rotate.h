@@ -12,6 +12,7 @@
 #define INCLUDE_LIBYUV_ROTATE_H_
 
 #include "libyuv/basic_types.h"
+#include "libyuv/scale.h"  // For FilterMode
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -65,6 +66,48 @@ int NV12ToI420Rotate(const uint8_t* src_y,
                      int height,
                      enum RotationMode mode);
 
+// Scale and rotate an I420 frame in one pass.
+// dst_width and dst_height are the size of the rotated destination, so for
+// 90 and 270 the source is scaled to dst_height by dst_width and rotated.
+LIBYUV_API
+int I420ScaleRotate(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_y,
+                    int dst_stride_y,
+                    uint8_t* dst_u,
+                    int dst_stride_u,
+                    uint8_t* dst_v,
+                    int dst_stride_v,
+                    int dst_width,
+                    int dst_height,
+                    enum RotationMode mode,
+                    enum FilterMode filtering);
+
+// Scale and rotate NV12 input and store in I420, in one pass.
+LIBYUV_API
+int NV12ToI420ScaleRotate(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum RotationMode mode,
+                          enum FilterMode filtering);
+
 // Rotate a plane by 0, 90, 180, or 270.
 LIBYUV_API
 int RotatePlane(const uint8_t* src,
@@ -75,6 +118,17 @@ int RotatePlane(const uint8_t* src,
                 int height,
                 enum RotationMode mode);
 
+// Rotate a plane of 16 bit samples, such as 10 bit Y, by 0, 90, 180, or 270.
+// Strides are in samples.
+LIBYUV_API
+int RotatePlane_16(const uint16_t* src,
+                   int src_stride,
+                   uint16_t* dst,
+                   int dst_stride,
+                   int width,
+                   int height,
+                   enum RotationMode mode);
+
 // Rotate planes by 90, 180, 270. Deprecated.
 LIBYUV_API
 void RotatePlane90(const uint8_t* src,
@@ -146,6 +200,15 @@ void TransposePlane(const uint8_t* src,
                     int width,
                     int height);
 
+// Transpose a plane of 16 bit samples. Strides are in samples.
+LIBYUV_API
+void TransposePlane_16(const uint16_t* src,
+                       int src_stride,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int width,
+                       int height);
+
 LIBYUV_API
 void TransposeUV(const uint8_t* src,
                  int src_stride,
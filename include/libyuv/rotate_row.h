@@ -32,6 +32,35 @@ extern "C" {
 #define LIBYUV_DISABLE_X86
 #endif
 #endif
+// GCC >= 4.7.0 required for AVX2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ > 4) || (__GNUC__ == 4 && (__GNUC_MINOR__ >= 7))
+#define GCC_HAS_AVX2 1
+#endif  // GNUC >= 4.7
+#endif  // __GNUC__
+
+// clang >= 3.4.0 required for AVX2.
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#if (__clang_major__ > 3) || (__clang_major__ == 3 && (__clang_minor__ >= 4))
+#define CLANG_HAS_AVX2 1
+#endif  // clang >= 3.4
+#endif  // __clang__
+
+// GCC >= 6.0.0 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 6)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 6
+#endif  // __GNUC__
+
+// clang >= 7.0.0 required for AVX512.
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#if (__clang_major__ >= 7) && !defined(__APPLE__)
+#define CLANG_HAS_AVX512 1
+#endif  // clang >= 7
+#endif  // __clang__
+
 // The following are available for Visual C and clangcl 32 bit:
 #if !defined(LIBYUV_DISABLE_X86) && defined(_M_IX86) && defined(_MSC_VER)
 #define HAS_TRANSPOSEWX8_SSSE3
@@ -41,18 +70,38 @@ extern "C" {
 // The following are available for GCC 32 or 64 bit:
 #if !defined(LIBYUV_DISABLE_X86) && (defined(__i386__) || defined(__x86_64__))
 #define HAS_TRANSPOSEWX8_SSSE3
+#define HAS_TRANSPOSEARGBWX4_SSE2
 #endif
 
 // The following are available for 64 bit GCC:
 #if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__)
 #define HAS_TRANSPOSEWX8_FAST_SSSE3
 #define HAS_TRANSPOSEUVWX8_SSE2
+#define HAS_TRANSPOSEWX8_16_SSE2
+#endif
+
+// The following are available for AVX2 64 bit GCC:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_TRANSPOSEARGBWX8_AVX2
+#define HAS_TRANSPOSEWX16_AVX2
+#define HAS_TRANSPOSEUVWX16_AVX2
+#endif
+
+// The following are available for AVX512 64 bit GCC.
+// They are slower than the AVX2 transposes, so TransposePlane and TransposeUV
+// do not select them.
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_TRANSPOSEWX16_AVX512VBMI
+#define HAS_TRANSPOSEUVWX16_AVX512VBMI
 #endif
 
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
 #define HAS_TRANSPOSEWX8_NEON
 #define HAS_TRANSPOSEUVWX8_NEON
+#define HAS_TRANSPOSEARGBWX4_NEON
 #endif
 
 #if !defined(LIBYUV_DISABLE_MSA) && defined(__mips_msa)
@@ -107,6 +156,16 @@ void TransposeWx16_MSA(const uint8_t* src,
                        uint8_t* dst,
                        int dst_stride,
                        int width);
+void TransposeWx16_AVX2(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width);
+void TransposeWx16_AVX512VBMI(const uint8_t* src,
+                              int src_stride,
+                              uint8_t* dst,
+                              int dst_stride,
+                              int width);
 
 void TransposeWx8_Any_NEON(const uint8_t* src,
                            int src_stride,
@@ -133,6 +192,16 @@ void TransposeWx16_Any_MSA(const uint8_t* src,
                            uint8_t* dst,
                            int dst_stride,
                            int width);
+void TransposeWx16_Any_AVX2(const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int width);
+void TransposeWx16_Any_AVX512VBMI(const uint8_t* src,
+                                  int src_stride,
+                                  uint8_t* dst,
+                                  int dst_stride,
+                                  int width);
 
 void TransposeUVWxH_C(const uint8_t* src,
                       int src_stride,
@@ -185,6 +254,20 @@ void TransposeUVWx16_MSA(const uint8_t* src,
                          uint8_t* dst_b,
                          int dst_stride_b,
                          int width);
+void TransposeUVWx16_AVX2(const uint8_t* src,
+                          int src_stride,
+                          uint8_t* dst_a,
+                          int dst_stride_a,
+                          uint8_t* dst_b,
+                          int dst_stride_b,
+                          int width);
+void TransposeUVWx16_AVX512VBMI(const uint8_t* src,
+                                int src_stride,
+                                uint8_t* dst_a,
+                                int dst_stride_a,
+                                uint8_t* dst_b,
+                                int dst_stride_b,
+                                int width);
 
 void TransposeUVWx8_Any_SSE2(const uint8_t* src,
                              int src_stride,
@@ -214,6 +297,90 @@ void TransposeUVWx16_Any_MSA(const uint8_t* src,
                              uint8_t* dst_b,
                              int dst_stride_b,
                              int width);
+void TransposeUVWx16_Any_AVX2(const uint8_t* src,
+                              int src_stride,
+                              uint8_t* dst_a,
+                              int dst_stride_a,
+                              uint8_t* dst_b,
+                              int dst_stride_b,
+                              int width);
+void TransposeUVWx16_Any_AVX512VBMI(const uint8_t* src,
+                                    int src_stride,
+                                    uint8_t* dst_a,
+                                    int dst_stride_a,
+                                    uint8_t* dst_b,
+                                    int dst_stride_b,
+                                    int width);
+
+void TransposeWxH_16_C(const uint16_t* src,
+                       int src_stride,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int width,
+                       int height);
+void TransposeWx8_16_C(const uint16_t* src,
+                       int src_stride,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int width);
+void TransposeWx8_16_SSE2(const uint16_t* src,
+                          int src_stride,
+                          uint16_t* dst,
+                          int dst_stride,
+                          int width);
+void TransposeWx8_16_Any_SSE2(const uint16_t* src,
+                              int src_stride,
+                              uint16_t* dst,
+                              int dst_stride,
+                              int width);
+
+void TransposeARGBWxH_C(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width,
+                        int height);
+void TransposeARGBWx4_C(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width);
+void TransposeARGBWx8_C(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width);
+void TransposeARGBWx4_SSE2(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width);
+void TransposeARGBWx8_AVX2(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width);
+void TransposeARGBWx4_NEON(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width);
+
+void TransposeARGBWx4_Any_SSE2(const uint8_t* src,
+                               int src_stride,
+                               uint8_t* dst,
+                               int dst_stride,
+                               int width);
+void TransposeARGBWx8_Any_AVX2(const uint8_t* src,
+                               int src_stride,
+                               uint8_t* dst,
+                               int dst_stride,
+                               int width);
+void TransposeARGBWx4_Any_NEON(const uint8_t* src,
+                               int src_stride,
+                               uint8_t* dst,
+                               int dst_stride,
+                               int width);
 
 #ifdef __cplusplus
 }  // extern "C"
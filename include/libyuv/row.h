@@ -14,6 +14,7 @@
 #include <stdlib.h>  // For malloc.
 
 #include "libyuv/basic_types.h"
+#include "libyuv/scratch.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -64,6 +65,14 @@ extern "C" {
 #endif  // clang >= 7
 #endif  // __clang__
 
+// GCC >= 6.0.0 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 6)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 6
+#endif  // __GNUC__
+
 // Visual C 2012 required for AVX2.
 #if defined(_M_IX86) && !defined(__clang__) && defined(_MSC_VER) && \
     _MSC_VER >= 1700
@@ -267,14 +276,24 @@ extern "C" {
     (defined(__x86_64__) || (defined(__i386__) && !defined(_MSC_VER)))
 #define HAS_ABGRTOAR30ROW_SSSE3
 #define HAS_ARGBTOAR30ROW_SSSE3
+#define HAS_BAYERROWTOARGBROW_SSE2
 #define HAS_CONVERT16TO8ROW_SSSE3
 #define HAS_CONVERT8TO16ROW_SSE2
+#define HAS_DIVIDEROW_16_SSE2
 // I210 is for H010.  2 = 422.  I for 601 vs H for 709.
 #define HAS_I210TOAR30ROW_SSSE3
 #define HAS_I210TOARGBROW_SSSE3
 #define HAS_I422TOAR30ROW_SSSE3
+#define HAS_INTERPOLATEROW_16_SSE2
 #define HAS_MERGERGBROW_SSSE3
+#define HAS_MERGEUVROW_16_SSE2
+#define HAS_MULTIPLYROW_16_SSE2
+// P210 is the 422 row of P010 and P016.
+#define HAS_P210TOAR30ROW_SSSE3
+#define HAS_P210TOARGBROW_SSSE3
+#define HAS_ROUND16TO8ROW_SSE2
 #define HAS_SPLITRGBROW_SSSE3
+#define HAS_SPLITUVROW_16_SSE2
 #endif
 
 // The following are available for AVX2 gcc/clang x86 platforms:
@@ -286,15 +305,22 @@ extern "C" {
 #define HAS_ARGBTOAR30ROW_AVX2
 #define HAS_ARGBTORAWROW_AVX2
 #define HAS_ARGBTORGB24ROW_AVX2
+#define HAS_BAYERROWTOARGBROW_AVX2
 #define HAS_CONVERT16TO8ROW_AVX2
 #define HAS_CONVERT8TO16ROW_AVX2
+#define HAS_DIVIDEROW_16_AVX2
 #define HAS_I210TOAR30ROW_AVX2
 #define HAS_I210TOARGBROW_AVX2
 #define HAS_I422TOAR30ROW_AVX2
 #define HAS_I422TOUYVYROW_AVX2
 #define HAS_I422TOYUY2ROW_AVX2
+#define HAS_INTERPOLATEROW_16_AVX2
 #define HAS_MERGEUVROW_16_AVX2
 #define HAS_MULTIPLYROW_16_AVX2
+#define HAS_P210TOAR30ROW_AVX2
+#define HAS_P210TOARGBROW_AVX2
+#define HAS_ROUND16TO8ROW_AVX2
+#define HAS_SPLITUVROW_16_AVX2
 // TODO(fbarchard): Fix AVX2 version of YUV24
 // #define HAS_NV21TOYUV24ROW_AVX2
 #endif
@@ -308,6 +334,25 @@ extern "C" {
 #define HAS_ARGBTORGB24ROW_AVX512VBMI
 #endif
 
+// The following are available for AVX512 gcc/clang x86 platforms:
+#if !defined(LIBYUV_DISABLE_X86) &&                                       \
+    (defined(__x86_64__) || (defined(__i386__) && !defined(_MSC_VER))) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_INTERPOLATEROW_16_AVX512BW
+#endif
+
+// The following are available for AVX512 64 bit gcc/clang x86 platforms:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_ARGBTOUVROW_AVX512BW
+#define HAS_ARGBTOYROW_AVX512BW
+#define HAS_COPYROW_AVX512BW
+#define HAS_I422TOARGBROW_AVX512BW
+#define HAS_MERGEUVROW_AVX512BW
+#define HAS_NV12TOARGBROW_AVX512BW
+#define HAS_SPLITUVROW_AVX512BW
+#endif
+
 // The following are available on Neon platforms:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__aarch64__) || defined(__ARM_NEON__) || defined(LIBYUV_NEON))
@@ -335,10 +380,12 @@ extern "C" {
 #define HAS_AYUVTOUVROW_NEON
 #define HAS_AYUVTOVUROW_NEON
 #define HAS_AYUVTOYROW_NEON
+#define HAS_BAYERROWTOARGBROW_NEON
 #define HAS_BGRATOUVROW_NEON
 #define HAS_BGRATOYROW_NEON
 #define HAS_BYTETOFLOATROW_NEON
 #define HAS_COPYROW_NEON
+#define HAS_DIVIDEROW_16_NEON
 #define HAS_HALFFLOATROW_NEON
 #define HAS_I400TOARGBROW_NEON
 #define HAS_I422ALPHATOARGBROW_NEON
@@ -361,6 +408,8 @@ extern "C" {
 #define HAS_NV21TOARGBROW_NEON
 #define HAS_NV21TORGB24ROW_NEON
 #define HAS_NV21TOYUV24ROW_NEON
+#define HAS_P210TOAR30ROW_NEON
+#define HAS_P210TOARGBROW_NEON
 #define HAS_RAWTOARGBROW_NEON
 #define HAS_RAWTORGB24ROW_NEON
 #define HAS_RAWTOUVROW_NEON
@@ -373,8 +422,10 @@ extern "C" {
 #define HAS_RGB565TOYROW_NEON
 #define HAS_RGBATOUVROW_NEON
 #define HAS_RGBATOYROW_NEON
+#define HAS_ROUND16TO8ROW_NEON
 #define HAS_SETROW_NEON
 #define HAS_SPLITRGBROW_NEON
+#define HAS_SPLITUVROW_16_NEON
 #define HAS_SPLITUVROW_NEON
 #define HAS_UVToVUROW_NEON
 #define HAS_UYVYTOARGBROW_NEON
@@ -660,23 +711,30 @@ struct YuvConstants {
 #endif
 
 // Conversion matrix for YUV to RGB
-extern const struct YuvConstants SIMD_ALIGNED(kYuvI601Constants);  // BT.601
-extern const struct YuvConstants SIMD_ALIGNED(kYuvJPEGConstants);  // JPeg
-extern const struct YuvConstants SIMD_ALIGNED(kYuvH709Constants);  // BT.709
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYuvI601Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYuvJPEGConstants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYuvH709Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYuvF709Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYuv2020Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYuvV2020Constants);
 
 // Conversion matrix for YVU to BGR
-extern const struct YuvConstants SIMD_ALIGNED(kYvuI601Constants);  // BT.601
-extern const struct YuvConstants SIMD_ALIGNED(kYvuJPEGConstants);  // JPeg
-extern const struct YuvConstants SIMD_ALIGNED(kYvuH709Constants);  // BT.709
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYvuI601Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYvuJPEGConstants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYvuH709Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYvuF709Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYvu2020Constants);
+LIBYUV_API extern const struct YuvConstants SIMD_ALIGNED(kYvuV2020Constants);
 
 #define IS_ALIGNED(p, a) (!((uintptr_t)(p) & ((a)-1)))
 
+// Row buffers come from the scratch arena of the calling thread, if any.
 #define align_buffer_64(var, size)                                           \
-  uint8_t* var##_mem = (uint8_t*)(malloc((size) + 63));         /* NOLINT */ \
+  uint8_t* var##_mem = (uint8_t*)(ScratchAlloc((size) + 63));   /* NOLINT */ \
   uint8_t* var = (uint8_t*)(((intptr_t)(var##_mem) + 63) & ~63) /* NOLINT */
 
 #define free_aligned_buffer_64(var) \
-  free(var##_mem);                  \
+  ScratchFree(var##_mem);           \
   var = 0
 
 #if defined(__APPLE__) || defined(__x86_64__) || defined(__llvm__)
@@ -911,6 +969,10 @@ void UYVYToARGBRow_MSA(const uint8_t* src_uyvy,
 
 void ARGBToYRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void ARGBToYRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void ARGBToYRow_AVX512BW(const uint8_t* src_argb, uint8_t* dst_y, int width);
+void ARGBToYRow_Any_AVX512BW(const uint8_t* src_ptr,
+                             uint8_t* dst_ptr,
+                             int width);
 void ARGBToYRow_SSSE3(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void ARGBToYJRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void ARGBToYJRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
@@ -1173,6 +1235,11 @@ void ARGBToUVRow_AVX2(const uint8_t* src_argb0,
                       uint8_t* dst_u,
                       uint8_t* dst_v,
                       int width);
+void ARGBToUVRow_AVX512BW(const uint8_t* src_argb0,
+                          int src_stride_argb,
+                          uint8_t* dst_u,
+                          uint8_t* dst_v,
+                          int width);
 void ARGBToUVJRow_AVX2(const uint8_t* src_argb0,
                        int src_stride_argb,
                        uint8_t* dst_u,
@@ -1208,6 +1275,11 @@ void ARGBToUVRow_Any_AVX2(const uint8_t* src_ptr,
                           uint8_t* dst_u,
                           uint8_t* dst_v,
                           int width);
+void ARGBToUVRow_Any_AVX512BW(const uint8_t* src_ptr,
+                              int src_stride_ptr,
+                              uint8_t* dst_u,
+                              uint8_t* dst_v,
+                              int width);
 void ARGBToUVJRow_Any_AVX2(const uint8_t* src_ptr,
                            int src_stride_ptr,
                            uint8_t* dst_u,
@@ -1534,6 +1606,10 @@ void SplitUVRow_AVX2(const uint8_t* src_uv,
                      uint8_t* dst_u,
                      uint8_t* dst_v,
                      int width);
+void SplitUVRow_AVX512BW(const uint8_t* src_uv,
+                         uint8_t* dst_u,
+                         uint8_t* dst_v,
+                         int width);
 void SplitUVRow_NEON(const uint8_t* src_uv,
                      uint8_t* dst_u,
                      uint8_t* dst_v,
@@ -1554,6 +1630,10 @@ void SplitUVRow_Any_AVX2(const uint8_t* src_ptr,
                          uint8_t* dst_u,
                          uint8_t* dst_v,
                          int width);
+void SplitUVRow_Any_AVX512BW(const uint8_t* src_ptr,
+                             uint8_t* dst_u,
+                             uint8_t* dst_v,
+                             int width);
 void SplitUVRow_Any_NEON(const uint8_t* src_ptr,
                          uint8_t* dst_u,
                          uint8_t* dst_v,
@@ -1579,6 +1659,10 @@ void MergeUVRow_AVX2(const uint8_t* src_u,
                      const uint8_t* src_v,
                      uint8_t* dst_uv,
                      int width);
+void MergeUVRow_AVX512BW(const uint8_t* src_u,
+                         const uint8_t* src_v,
+                         uint8_t* dst_uv,
+                         int width);
 void MergeUVRow_NEON(const uint8_t* src_u,
                      const uint8_t* src_v,
                      uint8_t* dst_uv,
@@ -1599,6 +1683,10 @@ void MergeUVRow_Any_AVX2(const uint8_t* y_buf,
                          const uint8_t* uv_buf,
                          uint8_t* dst_ptr,
                          int width);
+void MergeUVRow_Any_AVX512BW(const uint8_t* y_buf,
+                             const uint8_t* uv_buf,
+                             uint8_t* dst_ptr,
+                             int width);
 void MergeUVRow_Any_NEON(const uint8_t* y_buf,
                          const uint8_t* uv_buf,
                          uint8_t* dst_ptr,
@@ -1684,17 +1772,72 @@ void MergeRGBRow_Any_MMI(const uint8_t* src_r,
                          uint8_t* dst_rgb,
                          int width);
 
+void SplitUVRow_16_C(const uint16_t* src_uv,
+                     uint16_t* dst_u,
+                     uint16_t* dst_v,
+                     int depth, /* 10 for P010 */
+                     int width);
+void SplitUVRow_16_SSE2(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width);
+void SplitUVRow_16_AVX2(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width);
+void SplitUVRow_16_Any_SSE2(const uint16_t* src_uv,
+                            uint16_t* dst_u,
+                            uint16_t* dst_v,
+                            int depth,
+                            int width);
+void SplitUVRow_16_Any_AVX2(const uint16_t* src_uv,
+                            uint16_t* dst_u,
+                            uint16_t* dst_v,
+                            int depth,
+                            int width);
+void SplitUVRow_16_NEON(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width);
+void SplitUVRow_16_Any_NEON(const uint16_t* src_uv,
+                            uint16_t* dst_u,
+                            uint16_t* dst_v,
+                            int depth,
+                            int width);
+
 void MergeUVRow_16_C(const uint16_t* src_u,
                      const uint16_t* src_v,
                      uint16_t* dst_uv,
                      int scale, /* 64 for 10 bit */
                      int width);
+void MergeUVRow_16_SSE2(const uint16_t* src_u,
+                        const uint16_t* src_v,
+                        uint16_t* dst_uv,
+                        int scale,
+                        int width);
 void MergeUVRow_16_AVX2(const uint16_t* src_u,
                         const uint16_t* src_v,
                         uint16_t* dst_uv,
                         int scale,
                         int width);
+void MergeUVRow_16_Any_SSE2(const uint16_t* src_u,
+                            const uint16_t* src_v,
+                            uint16_t* dst_uv,
+                            int scale,
+                            int width);
+void MergeUVRow_16_Any_AVX2(const uint16_t* src_u,
+                            const uint16_t* src_v,
+                            uint16_t* dst_uv,
+                            int scale,
+                            int width);
 
+void MultiplyRow_16_SSE2(const uint16_t* src_y,
+                         uint16_t* dst_y,
+                         int scale,
+                         int width);
 void MultiplyRow_16_AVX2(const uint16_t* src_y,
                          uint16_t* dst_y,
                          int scale,
@@ -1703,6 +1846,43 @@ void MultiplyRow_16_C(const uint16_t* src_y,
                       uint16_t* dst_y,
                       int scale,
                       int width);
+void MultiplyRow_16_Any_SSE2(const uint16_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             int scale,
+                             int width);
+void MultiplyRow_16_Any_AVX2(const uint16_t* src_ptr,
+                             uint16_t* dst_ptr,
+                             int scale,
+                             int width);
+
+void DivideRow_16_C(const uint16_t* src_y,
+                    uint16_t* dst_y,
+                    int scale, /* 1024 for 10 bit */
+                    int width);
+void DivideRow_16_SSE2(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width);
+void DivideRow_16_AVX2(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width);
+void DivideRow_16_Any_SSE2(const uint16_t* src_ptr,
+                           uint16_t* dst_ptr,
+                           int scale,
+                           int width);
+void DivideRow_16_Any_AVX2(const uint16_t* src_ptr,
+                           uint16_t* dst_ptr,
+                           int scale,
+                           int width);
+void DivideRow_16_NEON(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width);
+void DivideRow_16_Any_NEON(const uint16_t* src_ptr,
+                           uint16_t* dst_ptr,
+                           int scale,
+                           int width);
 
 void Convert8To16Row_C(const uint8_t* src_y,
                        uint16_t* dst_y,
@@ -1746,14 +1926,30 @@ void Convert16To8Row_Any_AVX2(const uint16_t* src_ptr,
                               int scale,
                               int width);
 
+void Round16To8Row_C(const uint16_t* src_y, uint8_t* dst_y, int width);
+void Round16To8Row_SSE2(const uint16_t* src_y, uint8_t* dst_y, int width);
+void Round16To8Row_AVX2(const uint16_t* src_y, uint8_t* dst_y, int width);
+void Round16To8Row_Any_SSE2(const uint16_t* src_ptr,
+                            uint8_t* dst_ptr,
+                            int width);
+void Round16To8Row_Any_AVX2(const uint16_t* src_ptr,
+                            uint8_t* dst_ptr,
+                            int width);
+void Round16To8Row_NEON(const uint16_t* src_y, uint8_t* dst_y, int width);
+void Round16To8Row_Any_NEON(const uint16_t* src_ptr,
+                            uint8_t* dst_ptr,
+                            int width);
+
 void CopyRow_SSE2(const uint8_t* src, uint8_t* dst, int width);
 void CopyRow_AVX(const uint8_t* src, uint8_t* dst, int width);
+void CopyRow_AVX512BW(const uint8_t* src, uint8_t* dst, int width);
 void CopyRow_ERMS(const uint8_t* src, uint8_t* dst, int width);
 void CopyRow_NEON(const uint8_t* src, uint8_t* dst, int width);
 void CopyRow_MIPS(const uint8_t* src, uint8_t* dst, int count);
 void CopyRow_C(const uint8_t* src, uint8_t* dst, int count);
 void CopyRow_Any_SSE2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void CopyRow_Any_AVX(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void CopyRow_Any_AVX512BW(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void CopyRow_Any_NEON(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 
 void CopyRow_16_C(const uint16_t* src, uint16_t* dst, int count);
@@ -2133,6 +2329,61 @@ void J400ToARGBRow_Any_NEON(const uint8_t* src_ptr,
 void J400ToARGBRow_Any_MSA(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void J400ToARGBRow_Any_MMI(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 
+// Bayer rows are demosaiced with 3 source rows, the row above, the row and the
+// row below.  bayer_row is the kind of row, named by its first 2 pixels:
+// 0 = RG, 1 = GR, 2 = BG, 3 = GB.  Bit 0 is set when green comes first and
+// bit 1 when the row has blue instead of red.
+// BayerRowToARGBRow reads 1 pixel left and right of the row, which
+// BayerEdgesToARGBRow_C mirrors for the first and last pixel.
+void BayerRowToARGBRow_C(const uint8_t* src_bayer0,
+                         const uint8_t* src_bayer1,
+                         const uint8_t* src_bayer2,
+                         uint8_t* dst_argb,
+                         int bayer_row,
+                         int width);
+void BayerRowToARGBRow_SSE2(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width);
+void BayerRowToARGBRow_AVX2(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width);
+void BayerRowToARGBRow_NEON(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width);
+void BayerRowToARGBRow_Any_SSE2(const uint8_t* src_bayer0,
+                                const uint8_t* src_bayer1,
+                                const uint8_t* src_bayer2,
+                                uint8_t* dst_ptr,
+                                int bayer_row,
+                                int width);
+void BayerRowToARGBRow_Any_AVX2(const uint8_t* src_bayer0,
+                                const uint8_t* src_bayer1,
+                                const uint8_t* src_bayer2,
+                                uint8_t* dst_ptr,
+                                int bayer_row,
+                                int width);
+void BayerRowToARGBRow_Any_NEON(const uint8_t* src_bayer0,
+                                const uint8_t* src_bayer1,
+                                const uint8_t* src_bayer2,
+                                uint8_t* dst_ptr,
+                                int bayer_row,
+                                int width);
+void BayerEdgesToARGBRow_C(const uint8_t* src_bayer0,
+                           const uint8_t* src_bayer1,
+                           const uint8_t* src_bayer2,
+                           uint8_t* dst_argb,
+                           int bayer_row,
+                           int width);
+
 void I444ToARGBRow_C(const uint8_t* src_y,
                      const uint8_t* src_u,
                      const uint8_t* src_v,
@@ -2163,6 +2414,16 @@ void I210ToARGBRow_C(const uint16_t* src_y,
                      uint8_t* rgb_buf,
                      const struct YuvConstants* yuvconstants,
                      int width);
+void P210ToAR30Row_C(const uint16_t* src_y,
+                     const uint16_t* src_uv,
+                     uint8_t* rgb_buf,
+                     const struct YuvConstants* yuvconstants,
+                     int width);
+void P210ToARGBRow_C(const uint16_t* src_y,
+                     const uint16_t* src_uv,
+                     uint8_t* rgb_buf,
+                     const struct YuvConstants* yuvconstants,
+                     int width);
 void I422AlphaToARGBRow_C(const uint8_t* src_y,
                           const uint8_t* src_u,
                           const uint8_t* src_v,
@@ -2243,6 +2504,12 @@ void I422ToARGBRow_AVX2(const uint8_t* y_buf,
                         uint8_t* dst_argb,
                         const struct YuvConstants* yuvconstants,
                         int width);
+void I422ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                            const uint8_t* u_buf,
+                            const uint8_t* v_buf,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
 void I422ToRGBARow_AVX2(const uint8_t* y_buf,
                         const uint8_t* u_buf,
                         const uint8_t* v_buf,
@@ -2316,6 +2583,36 @@ void I210ToAR30Row_AVX2(const uint16_t* y_buf,
                         uint8_t* dst_ar30,
                         const struct YuvConstants* yuvconstants,
                         int width);
+void P210ToARGBRow_SSSE3(const uint16_t* y_buf,
+                         const uint16_t* uv_buf,
+                         uint8_t* dst_argb,
+                         const struct YuvConstants* yuvconstants,
+                         int width);
+void P210ToAR30Row_SSSE3(const uint16_t* y_buf,
+                         const uint16_t* uv_buf,
+                         uint8_t* dst_ar30,
+                         const struct YuvConstants* yuvconstants,
+                         int width);
+void P210ToARGBRow_AVX2(const uint16_t* y_buf,
+                        const uint16_t* uv_buf,
+                        uint8_t* dst_argb,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+void P210ToAR30Row_AVX2(const uint16_t* y_buf,
+                        const uint16_t* uv_buf,
+                        uint8_t* dst_ar30,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+void P210ToARGBRow_NEON(const uint16_t* src_y,
+                        const uint16_t* src_uv,
+                        uint8_t* dst_argb,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+void P210ToAR30Row_NEON(const uint16_t* src_y,
+                        const uint16_t* src_uv,
+                        uint8_t* dst_ar30,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
 void I422AlphaToARGBRow_SSSE3(const uint8_t* y_buf,
                               const uint8_t* u_buf,
                               const uint8_t* v_buf,
@@ -2340,6 +2637,11 @@ void NV12ToARGBRow_AVX2(const uint8_t* y_buf,
                         uint8_t* dst_argb,
                         const struct YuvConstants* yuvconstants,
                         int width);
+void NV12ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                            const uint8_t* uv_buf,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
 void NV12ToRGB24Row_SSSE3(const uint8_t* src_y,
                           const uint8_t* src_uv,
                           uint8_t* dst_rgb24,
@@ -2460,6 +2762,12 @@ void I422ToARGBRow_Any_AVX2(const uint8_t* y_buf,
                             uint8_t* dst_ptr,
                             const struct YuvConstants* yuvconstants,
                             int width);
+void I422ToARGBRow_Any_AVX512BW(const uint8_t* y_buf,
+                                const uint8_t* u_buf,
+                                const uint8_t* v_buf,
+                                uint8_t* dst_ptr,
+                                const struct YuvConstants* yuvconstants,
+                                int width);
 void I422ToRGBARow_Any_AVX2(const uint8_t* y_buf,
                             const uint8_t* u_buf,
                             const uint8_t* v_buf,
@@ -2520,6 +2828,36 @@ void I210ToAR30Row_Any_AVX2(const uint16_t* y_buf,
                             uint8_t* dst_ptr,
                             const struct YuvConstants* yuvconstants,
                             int width);
+void P210ToARGBRow_Any_SSSE3(const uint16_t* y_buf,
+                             const uint16_t* uv_buf,
+                             uint8_t* dst_ptr,
+                             const struct YuvConstants* yuvconstants,
+                             int width);
+void P210ToAR30Row_Any_SSSE3(const uint16_t* y_buf,
+                             const uint16_t* uv_buf,
+                             uint8_t* dst_ptr,
+                             const struct YuvConstants* yuvconstants,
+                             int width);
+void P210ToARGBRow_Any_AVX2(const uint16_t* y_buf,
+                            const uint16_t* uv_buf,
+                            uint8_t* dst_ptr,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
+void P210ToAR30Row_Any_AVX2(const uint16_t* y_buf,
+                            const uint16_t* uv_buf,
+                            uint8_t* dst_ptr,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
+void P210ToARGBRow_Any_NEON(const uint16_t* y_buf,
+                            const uint16_t* uv_buf,
+                            uint8_t* dst_ptr,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
+void P210ToAR30Row_Any_NEON(const uint16_t* y_buf,
+                            const uint16_t* uv_buf,
+                            uint8_t* dst_ptr,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
 void I422AlphaToARGBRow_Any_SSSE3(const uint8_t* y_buf,
                                   const uint8_t* u_buf,
                                   const uint8_t* v_buf,
@@ -2544,6 +2882,11 @@ void NV12ToARGBRow_Any_AVX2(const uint8_t* y_buf,
                             uint8_t* dst_ptr,
                             const struct YuvConstants* yuvconstants,
                             int width);
+void NV12ToARGBRow_Any_AVX512BW(const uint8_t* y_buf,
+                                const uint8_t* uv_buf,
+                                uint8_t* dst_ptr,
+                                const struct YuvConstants* yuvconstants,
+                                int width);
 void NV21ToARGBRow_Any_SSSE3(const uint8_t* y_buf,
                              const uint8_t* uv_buf,
                              uint8_t* dst_ptr,
@@ -3757,6 +4100,36 @@ void InterpolateRow_16_C(uint16_t* dst_ptr,
                          ptrdiff_t src_stride,
                          int width,
                          int source_y_fraction);
+void InterpolateRow_16_SSE2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int width,
+                            int source_y_fraction);
+void InterpolateRow_16_AVX2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int width,
+                            int source_y_fraction);
+void InterpolateRow_16_AVX512BW(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int width,
+                                int source_y_fraction);
+void InterpolateRow_Any_16_SSE2(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int width,
+                                int source_y_fraction);
+void InterpolateRow_Any_16_AVX2(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int width,
+                                int source_y_fraction);
+void InterpolateRow_Any_16_AVX512BW(uint16_t* dst_ptr,
+                                    const uint16_t* src_ptr,
+                                    ptrdiff_t src_stride,
+                                    int width,
+                                    int source_y_fraction);
 
 // Sobel images.
 void SobelXRow_C(const uint8_t* src_y0,
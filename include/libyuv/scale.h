@@ -12,6 +12,7 @@
 #define INCLUDE_LIBYUV_SCALE_H_
 
 #include "libyuv/basic_types.h"
+#include "libyuv/executor.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -19,11 +20,16 @@ extern "C" {
 #endif
 
 // Supported filtering.
+// Bicubic and Lanczos are much slower than box. On x86 an 8 bit plane takes
+// up to 20 times as long as box. 16 bit planes and ARM use C code and take
+// 5 to 80 times as long.
 typedef enum FilterMode {
   kFilterNone = 0,      // Point sample; Fastest.
   kFilterLinear = 1,    // Filter horizontally only.
   kFilterBilinear = 2,  // Faster than box, but lower quality scaling down.
-  kFilterBox = 3        // Highest quality.
+  kFilterBox = 3,       // Averaging; fast and high quality scaling down.
+  kFilterBicubic = 4,   // Polyphase cubic convolution. Sharper than box; slow.
+  kFilterLanczos = 5    // Polyphase 3 lobe Lanczos. Sharpest; slowest.
 } FilterModeEnum;
 
 // Scale a YUV plane.
@@ -57,6 +63,11 @@ void ScalePlane_16(const uint16_t* src,
 // quality image, at the expense of speed.
 // If filtering is kFilterBox, averaging is used to produce ever better
 // quality image, at further expense of speed.
+// If filtering is kFilterBicubic or kFilterLanczos, each output pixel is a
+// weighted sum of a window of source pixels, filtered vertically and then
+// horizontally. This avoids both the aliasing of bilinear and the blur of box
+// when scaling down. Planes other than Y, U, V and ARGB, such as the UV plane
+// of NV12, use kFilterBox instead.
 // Returns 0 if successful.
 
 LIBYUV_API
@@ -97,6 +108,133 @@ int I420Scale_16(const uint16_t* src_y,
                  int dst_height,
                  enum FilterMode filtering);
 
+// Clipped scale takes destination rectangle coordinates for clip values.
+// Only the rectangle of dst is written, with the pixels of scaling the whole
+// plane, so tiles of the destination can be scaled independently.
+LIBYUV_API
+int ScalePlaneClip(const uint8_t* src,
+                   int src_stride,
+                   int src_width,
+                   int src_height,
+                   uint8_t* dst,
+                   int dst_stride,
+                   int dst_width,
+                   int dst_height,
+                   int clip_x,
+                   int clip_y,
+                   int clip_width,
+                   int clip_height,
+                   enum FilterMode filtering);
+
+LIBYUV_API
+int ScalePlaneClip_16(const uint16_t* src,
+                      int src_stride,
+                      int src_width,
+                      int src_height,
+                      uint16_t* dst,
+                      int dst_stride,
+                      int dst_width,
+                      int dst_height,
+                      int clip_x,
+                      int clip_y,
+                      int clip_width,
+                      int clip_height,
+                      enum FilterMode filtering);
+
+// The clip rectangle is in Y plane coordinates. The U and V planes are
+// scaled for the chroma samples covering it.
+LIBYUV_API
+int I420ScaleClip(const uint8_t* src_y,
+                  int src_stride_y,
+                  const uint8_t* src_u,
+                  int src_stride_u,
+                  const uint8_t* src_v,
+                  int src_stride_v,
+                  int src_width,
+                  int src_height,
+                  uint8_t* dst_y,
+                  int dst_stride_y,
+                  uint8_t* dst_u,
+                  int dst_stride_u,
+                  uint8_t* dst_v,
+                  int dst_stride_v,
+                  int dst_width,
+                  int dst_height,
+                  int clip_x,
+                  int clip_y,
+                  int clip_width,
+                  int clip_height,
+                  enum FilterMode filtering);
+
+// Multithreaded versions of the scalers above.
+// The destination is split into one horizontal band per thread of executor,
+// and the bands are scaled with executor->parallel_for. A NULL executor
+// scales on the calling thread. The output is identical to the single
+// threaded functions.
+LIBYUV_API
+void ScalePlaneMT(const uint8_t* src,
+                  int src_stride,
+                  int src_width,
+                  int src_height,
+                  uint8_t* dst,
+                  int dst_stride,
+                  int dst_width,
+                  int dst_height,
+                  enum FilterMode filtering,
+                  const struct ParallelExecutor* executor);
+
+LIBYUV_API
+void ScalePlaneMT_16(const uint16_t* src,
+                     int src_stride,
+                     int src_width,
+                     int src_height,
+                     uint16_t* dst,
+                     int dst_stride,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering,
+                     const struct ParallelExecutor* executor);
+
+LIBYUV_API
+int I420ScaleMT(const uint8_t* src_y,
+                int src_stride_y,
+                const uint8_t* src_u,
+                int src_stride_u,
+                const uint8_t* src_v,
+                int src_stride_v,
+                int src_width,
+                int src_height,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_u,
+                int dst_stride_u,
+                uint8_t* dst_v,
+                int dst_stride_v,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering,
+                const struct ParallelExecutor* executor);
+
+LIBYUV_API
+int I420ScaleMT_16(const uint16_t* src_y,
+                   int src_stride_y,
+                   const uint16_t* src_u,
+                   int src_stride_u,
+                   const uint16_t* src_v,
+                   int src_stride_v,
+                   int src_width,
+                   int src_height,
+                   uint16_t* dst_y,
+                   int dst_stride_y,
+                   uint16_t* dst_u,
+                   int dst_stride_u,
+                   uint16_t* dst_v,
+                   int dst_stride_v,
+                   int dst_width,
+                   int dst_height,
+                   enum FilterMode filtering,
+                   const struct ParallelExecutor* executor);
+
 #ifdef __cplusplus
 // Legacy API.  Deprecated.
 LIBYUV_API
@@ -47,6 +47,11 @@ int ARGBScaleClip(const uint8_t* src_argb,
                   enum FilterMode filtering);
 
 // Scale with YUV conversion to ARGB and clipping.
+// src_fourcc is FOURCC_I420, FOURCC_I444, FOURCC_NV12 or FOURCC_NV21. For
+// NV12 and NV21 src_u is the interleaved chroma plane and src_v is unused.
+// dst_fourcc is FOURCC_ARGB or FOURCC_ABGR.
+// Scaling happens in YUV before conversion, a strip of rows at a time, unless
+// the clip rectangle is narrower than the destination.
 LIBYUV_API
 int YUVToARGBScaleClip(const uint8_t* src_y,
                        int src_stride_y,
@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_SCALE_PLAN_H_
+#define INCLUDE_LIBYUV_SCALE_PLAN_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/scale.h"  // For FilterMode
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// A scale plan holds what scaling a sequence of frames of the same size and
+// format has in common: the scaler chosen for each plane, the source position
+// and step, and the polyphase filter tables. Create a plan once and scale
+// every frame with it. A plan is not modified by scaling, so it may be used
+// by any number of threads at once.
+struct ScalePlan;
+
+// Create a plan to scale frames of fourcc from src_width x src_height to
+// dst_width x dst_height. fourcc is FOURCC_I400, FOURCC_I420 or FOURCC_ARGB.
+// A negative src_width mirrors and a negative src_height inverts, with any
+// filter.
+// Returns NULL if the format or a size is invalid.
+LIBYUV_API
+struct ScalePlan* CreateScalePlan(uint32_t fourcc,
+                                  int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  enum FilterMode filtering);
+
+LIBYUV_API
+void DestroyScalePlan(struct ScalePlan* plan);
+
+// Scale a frame with a plan of the matching format. The results are the same
+// as ScalePlane, I420Scale and ARGBScale, and with an executor set by
+// SetThreadExecutor planes are scaled in parallel in the same way.
+// Return 0 if successful, or -1 if the plan is for another format.
+LIBYUV_API
+int ScalePlanI400(const struct ScalePlan* plan,
+                  const uint8_t* src_y,
+                  int src_stride_y,
+                  uint8_t* dst_y,
+                  int dst_stride_y);
+
+LIBYUV_API
+int ScalePlanI420(const struct ScalePlan* plan,
+                  const uint8_t* src_y,
+                  int src_stride_y,
+                  const uint8_t* src_u,
+                  int src_stride_u,
+                  const uint8_t* src_v,
+                  int src_stride_v,
+                  uint8_t* dst_y,
+                  int dst_stride_y,
+                  uint8_t* dst_u,
+                  int dst_stride_u,
+                  uint8_t* dst_v,
+                  int dst_stride_v);
+
+LIBYUV_API
+int ScalePlanARGB(const struct ScalePlan* plan,
+                  const uint8_t* src_argb,
+                  int src_stride_argb,
+                  uint8_t* dst_argb,
+                  int dst_stride_argb);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_SCALE_PLAN_H_
@@ -53,6 +53,21 @@ extern "C" {
 #define VISUALC_HAS_AVX2 1
 #endif  // VisualStudio >= 2012
 
+// GCC >= 6.0.0 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 6)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 6
+#endif  // __GNUC__
+
+// clang >= 7.0.0 required for AVX512.
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#if (__clang_major__ >= 7) && !defined(__APPLE__)
+#define CLANG_HAS_AVX512 1
+#endif  // clang >= 7
+#endif  // __clang__
+
 // The following are available on all x86 platforms:
 #if !defined(LIBYUV_DISABLE_X86) && \
     (defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
@@ -72,6 +87,64 @@ extern "C" {
 #define HAS_SCALEROWDOWN4_SSSE3
 #endif
 
+// The following are available for 16 bit scaling on GCC and clang x86
+// platforms:
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || (defined(__i386__) && !defined(_MSC_VER)))
+#define HAS_SCALEADDROW_16_SSE2
+#define HAS_SCALECOLS_16_SSE2
+#define HAS_SCALEFILTERCOLS_16_SSSE3
+#define HAS_SCALEROWDOWN2_16_SSE2
+#define HAS_SCALEROWDOWN34_16_SSSE3
+#define HAS_SCALEROWDOWN38_16_SSSE3
+#define HAS_SCALEROWDOWN4_16_SSE2
+#endif
+
+// The following are available for UV scaling on GCC and clang x86 platforms:
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || (defined(__i386__) && !defined(_MSC_VER)))
+#define HAS_SCALEUVCOLS_SSE2
+#define HAS_SCALEUVFILTERCOLS_16_SSSE3
+#define HAS_SCALEUVFILTERCOLS_SSSE3
+#define HAS_SCALEUVROWDOWN2_16_SSE2
+#define HAS_SCALEUVROWDOWN2_SSSE3
+#define HAS_SCALEUVROWDOWNEVENBOX_16_SSE2
+#endif
+
+#if !defined(LIBYUV_DISABLE_X86) &&                                       \
+    (defined(__x86_64__) || (defined(__i386__) && !defined(_MSC_VER))) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_SCALEADDROW_16_AVX2
+#define HAS_SCALEFILTERCOLS_16_AVX2
+#define HAS_SCALEROWDOWN2_16_AVX2
+#define HAS_SCALEROWDOWN4_16_AVX2
+#define HAS_SCALEUVROWDOWN2_16_AVX2
+#define HAS_SCALEUVROWDOWN2BOX_AVX2
+#endif
+
+// The following are available for polyphase filtering on GCC and clang
+// x86_64 platforms:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__)
+#define HAS_SCALEARGBPOLYPHASECOLS_SSSE3
+#define HAS_SCALEPOLYPHASECOLS_SSSE3
+#define HAS_SCALEPOLYPHASEROWS_SSE2
+#endif
+
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_SCALEPOLYPHASEROWS_AVX2
+#endif
+
+// The following are available for AVX512 GCC and clang x86 platforms:
+#if !defined(LIBYUV_DISABLE_X86) &&                                       \
+    (defined(__x86_64__) || (defined(__i386__) && !defined(_MSC_VER))) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_SCALEADDROW_16_AVX512BW
+#define HAS_SCALEROWDOWN2_16_AVX512BW
+#define HAS_SCALEROWDOWN2_AVX512BW
+#define HAS_SCALEROWDOWN4_16_AVX512BW
+#endif
+
 // The following are available on all x86 platforms, but
 // require VS2012, clang 3.4 or gcc 4.7.
 // The code supports NaCL but requires a new compiler and validator.
@@ -162,6 +235,199 @@ enum FilterMode ScaleFilterReduce(int src_width,
                                   int dst_height,
                                   enum FilterMode filtering);
 
+// Number of taps of the polyphase filter for scaling src_size to dst_size.
+int ScalePolyphaseTaps(int src_size,
+                       int dst_size,
+                       enum FilterMode filtering);
+
+// Compute the polyphase filter of destination pixels [dst_begin, dst_begin +
+// dst_count). offsets receives the first of taps source pixels of each, and
+// coeffs receives their 2.14 fixed point weights, padded with zeros to
+// filter_taps. A negative src_size mirrors the source.
+void ScalePolyphaseCoeffs(int src_size,
+                          int dst_size,
+                          int dst_begin,
+                          int dst_count,
+                          enum FilterMode filtering,
+                          int taps,
+                          int filter_taps,
+                          int* offsets,
+                          int16_t* coeffs);
+
+// Polyphase filter of the destination rows [begin_y, begin_y + count_y) and
+// columns [begin_x, begin_x + count_x), with the kernels to apply it.
+// Planes have 1 byte per pixel and ARGB 4.
+typedef struct {
+  int src_width;
+  int bpp;
+  int count_x;
+  int begin_y;
+  int taps_y;
+  int filter_x_taps;
+  int filter_y_taps;
+  int* offsets_x;
+  int16_t* filter_x;
+  int* offsets_y;
+  int16_t* filter_y;
+  void (*ScalePolyphaseRows)(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint8_t* dst_ptr,
+                             int dst_width);
+  void (*ScalePolyphaseCols)(uint8_t* dst_ptr,
+                             const uint8_t* src_ptr,
+                             int dst_width,
+                             const int* offsets,
+                             const int16_t* filter,
+                             int filter_taps);
+} ScalePolyphase;
+
+// Bytes of memory for the tables of a ScalePolyphase.
+size_t ScalePolyphaseSize(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          int count_x,
+                          int count_y,
+                          int bpp,
+                          enum FilterMode filtering);
+
+// Compute the tables of a ScalePolyphase into mem, which must be 16 byte
+// aligned and ScalePolyphaseSize bytes. A negative src_width mirrors.
+void ScalePolyphaseInit(ScalePolyphase* polyphase,
+                        uint8_t* mem,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        int begin_x,
+                        int count_x,
+                        int begin_y,
+                        int count_y,
+                        int bpp,
+                        enum FilterMode filtering);
+
+// Filter destination rows [y, y + height), which must be within the rows of
+// the polyphase. src points to the first source row and dst to column begin_x
+// of row y.
+void ScalePolyphaseRun(const ScalePolyphase* polyphase,
+                       const uint8_t* src_ptr,
+                       int src_stride,
+                       uint8_t* dst_ptr,
+                       int dst_stride,
+                       int y,
+                       int height);
+
+// The scaler chosen for a plane and its source position and step.
+typedef struct {
+  int src_width;   // Negative mirrors.
+  int src_height;  // Negative inverts.
+  int dst_width;
+  int dst_height;
+  enum FilterMode filtering;  // Reduced to the scaler's filter.
+  int scaler;
+  int row_align;  // Bands must start on a multiple of row_align.
+  int x;
+  int y;
+  int dx;
+  int dy;
+  ScalePolyphase polyphase;  // Tables are set up by the caller.
+} ScalePlaneSetup;
+
+// Choose the scaler of a plane. If the scaler is polyphase
+// (ScalePlaneSetupPolyphase returns true) the caller initializes
+// setup->polyphase for the rows it will scale.
+void ScalePlaneSetupInit(ScalePlaneSetup* setup,
+                         int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering);
+LIBYUV_BOOL ScalePlaneSetupPolyphase(const ScalePlaneSetup* setup);
+
+// Scale rows [band_y, band_y + band_height) of the destination plane into
+// dst, which points to row band_y. See ScalePlaneBand.
+void ScalePlaneSetupRun(const ScalePlaneSetup* setup,
+                        const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int band_y,
+                        int band_height);
+
+// Scale columns [clip_x, clip_x + clip_width) of rows [band_y, band_y +
+// band_height) into dst, which points to column clip_x of row band_y.
+// A polyphase setup scales the columns of its tables.
+void ScalePlaneSetupRunClip(const ScalePlaneSetup* setup,
+                            const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int clip_x,
+                            int clip_width,
+                            int band_y,
+                            int band_height);
+void ScalePlaneSetupRunClip_16(const ScalePlaneSetup* setup,
+                               const uint16_t* src,
+                               int src_stride,
+                               uint16_t* dst,
+                               int dst_stride,
+                               int clip_x,
+                               int clip_width,
+                               int band_y,
+                               int band_height);
+
+// Source rows [*src_begin, *src_end) read by ScalePlaneSetupRun to scale
+// destination rows [band_y, band_y + band_height). The source must not be
+// inverted. The range grows with band_y, so source rows before src_begin of
+// a band are not read by later bands.
+void ScalePlaneSetupSrcRows(const ScalePlaneSetup* setup,
+                            int band_y,
+                            int band_height,
+                            int* src_begin,
+                            int* src_end);
+
+// The scaler chosen for the clip rectangle of an ARGB image and its source
+// position and step.
+typedef struct {
+  int src_width;  // Negative mirrors.
+  int src_height;
+  int invert;
+  int clip_x;
+  int clip_y;
+  int clip_width;
+  int clip_height;
+  enum FilterMode filtering;
+  int scaler;
+  int src_x;  // Source pixel of the first column of the clip rectangle.
+  int src_y;  // Source row of the first row of the clip rectangle.
+  int x;
+  int y;
+  int dx;
+  int dy;
+  ScalePolyphase polyphase;  // Tables are set up by the caller.
+} ScaleARGBSetup;
+
+void ScaleARGBSetupInit(ScaleARGBSetup* setup,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        int clip_x,
+                        int clip_y,
+                        int clip_width,
+                        int clip_height,
+                        enum FilterMode filtering);
+LIBYUV_BOOL ScaleARGBSetupPolyphase(const ScaleARGBSetup* setup);
+
+// Scale the clip rectangle. dst points to the destination image.
+void ScaleARGBSetupRun(const ScaleARGBSetup* setup,
+                       const uint8_t* src,
+                       int src_stride,
+                       uint8_t* dst,
+                       int dst_stride);
+
 // Divide num by div and return as 16.16 fixed point result.
 int FixedDiv_C(int num, int div);
 int FixedDiv_X86(int num, int div);
@@ -192,6 +458,42 @@ void ScaleSlope(int src_width,
                 int* dx,
                 int* dy);
 
+// Scale rows [band_y, band_y + band_height) of a destination plane of
+// dst_width by dst_height. dst points to row band_y.
+void ScalePlaneBand(const uint8_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    int band_y,
+                    int band_height,
+                    enum FilterMode filtering);
+void ScalePlaneBand_16(const uint16_t* src,
+                       int src_stride,
+                       int src_width,
+                       int src_height,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int dst_width,
+                       int dst_height,
+                       int band_y,
+                       int band_height,
+                       enum FilterMode filtering);
+void ScaleUVBand(const uint8_t* src_uv,
+                 int src_stride_uv,
+                 int src_width,
+                 int src_height,
+                 uint8_t* dst_uv,
+                 int dst_stride_uv,
+                 int dst_width,
+                 int dst_height,
+                 int band_y,
+                 int band_height,
+                 enum FilterMode filtering);
+
 void ScaleRowDown2_C(const uint8_t* src_ptr,
                      ptrdiff_t src_stride,
                      uint8_t* dst,
@@ -300,6 +602,39 @@ void ScaleFilterCols64_16_C(uint16_t* dst_ptr,
                             int dst_width,
                             int x32,
                             int dx);
+// Filter a row from filter_taps rows of src_stride, weighted by filter.
+void ScalePolyphaseRows_C(const uint8_t* src_ptr,
+                          ptrdiff_t src_stride,
+                          const int16_t* filter,
+                          int filter_taps,
+                          uint8_t* dst_ptr,
+                          int dst_width);
+void ScalePolyphaseRows_16_C(const uint16_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint16_t* dst_ptr,
+                             int dst_width);
+// Filter each destination pixel from filter_taps pixels starting at its
+// offset. filter holds filter_taps weights for each destination pixel.
+void ScalePolyphaseCols_C(uint8_t* dst_ptr,
+                          const uint8_t* src_ptr,
+                          int dst_width,
+                          const int* offsets,
+                          const int16_t* filter,
+                          int filter_taps);
+void ScalePolyphaseCols_16_C(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             const int* offsets,
+                             const int16_t* filter,
+                             int filter_taps);
+void ScaleARGBPolyphaseCols_C(uint8_t* dst_argb,
+                              const uint8_t* src_argb,
+                              int dst_width,
+                              const int* offsets,
+                              const int16_t* filter,
+                              int filter_taps);
 void ScaleRowDown38_C(const uint8_t* src_ptr,
                       ptrdiff_t src_stride,
                       uint8_t* dst,
@@ -376,6 +711,77 @@ void ScaleARGBFilterCols64_C(uint8_t* dst_argb,
                              int x32,
                              int dx);
 
+void ScaleUVRowDown2_C(const uint8_t* src_uv,
+                       ptrdiff_t src_stride,
+                       uint8_t* dst_uv,
+                       int dst_width);
+void ScaleUVRowDown2Linear_C(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_uv,
+                             int dst_width);
+void ScaleUVRowDown2Box_C(const uint8_t* src_uv,
+                          ptrdiff_t src_stride,
+                          uint8_t* dst_uv,
+                          int dst_width);
+void ScaleUVRowDownEven_C(const uint8_t* src_uv,
+                          ptrdiff_t src_stride,
+                          int src_stepx,
+                          uint8_t* dst_uv,
+                          int dst_width);
+void ScaleUVRowDownEvenBox_C(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             int src_stepx,
+                             uint8_t* dst_uv,
+                             int dst_width);
+void ScaleUVCols_C(uint8_t* dst_uv,
+                   const uint8_t* src_uv,
+                   int dst_width,
+                   int x,
+                   int dx);
+void ScaleUVCols64_C(uint8_t* dst_uv,
+                     const uint8_t* src_uv,
+                     int dst_width,
+                     int x32,
+                     int dx);
+void ScaleUVColsUp2_C(uint8_t* dst_uv,
+                      const uint8_t* src_uv,
+                      int dst_width,
+                      int,
+                      int);
+void ScaleUVFilterCols_C(uint8_t* dst_uv,
+                         const uint8_t* src_uv,
+                         int dst_width,
+                         int x,
+                         int dx);
+void ScaleUVFilterCols64_C(uint8_t* dst_uv,
+                           const uint8_t* src_uv,
+                           int dst_width,
+                           int x32,
+                           int dx);
+void ScaleUVRowDown2Linear_16_C(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                uint16_t* dst_uv,
+                                int dst_width);
+void ScaleUVRowDown2Box_16_C(const uint16_t* src_uv,
+                             ptrdiff_t src_stride,
+                             uint16_t* dst_uv,
+                             int dst_width);
+void ScaleUVRowDownEvenBox_16_C(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                int src_stepx,
+                                uint16_t* dst_uv,
+                                int dst_width);
+void ScaleUVFilterCols_16_C(uint16_t* dst_uv,
+                            const uint16_t* src_uv,
+                            int dst_width,
+                            int x,
+                            int dx);
+void ScaleUVFilterCols64_16_C(uint16_t* dst_uv,
+                              const uint16_t* src_uv,
+                              int dst_width,
+                              int x32,
+                              int dx);
+
 // Specialized scalers for x86.
 void ScaleRowDown2_SSSE3(const uint8_t* src_ptr,
                          ptrdiff_t src_stride,
@@ -401,6 +807,18 @@ void ScaleRowDown2Box_AVX2(const uint8_t* src_ptr,
                            ptrdiff_t src_stride,
                            uint8_t* dst_ptr,
                            int dst_width);
+void ScaleRowDown2_AVX512BW(const uint8_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            uint8_t* dst_ptr,
+                            int dst_width);
+void ScaleRowDown2Linear_AVX512BW(const uint8_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint8_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown2Box_AVX512BW(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width);
 void ScaleRowDown4_SSSE3(const uint8_t* src_ptr,
                          ptrdiff_t src_stride,
                          uint8_t* dst_ptr,
@@ -474,6 +892,22 @@ void ScaleRowDown2Box_Odd_AVX2(const uint8_t* src_ptr,
                                ptrdiff_t src_stride,
                                uint8_t* dst_ptr,
                                int dst_width);
+void ScaleRowDown2_Any_AVX512BW(const uint8_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                uint8_t* dst_ptr,
+                                int dst_width);
+void ScaleRowDown2Linear_Any_AVX512BW(const uint8_t* src_ptr,
+                                      ptrdiff_t src_stride,
+                                      uint8_t* dst_ptr,
+                                      int dst_width);
+void ScaleRowDown2Box_Any_AVX512BW(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown2Box_Odd_AVX512BW(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
 void ScaleRowDown4_Any_SSSE3(const uint8_t* src_ptr,
                              ptrdiff_t src_stride,
                              uint8_t* dst_ptr,
@@ -536,6 +970,264 @@ void ScaleColsUp2_SSE2(uint8_t* dst_ptr,
                        int x,
                        int dx);
 
+void ScalePolyphaseRows_SSE2(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint8_t* dst_ptr,
+                             int dst_width);
+void ScalePolyphaseRows_AVX2(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint8_t* dst_ptr,
+                             int dst_width);
+void ScalePolyphaseRows_Any_SSE2(const uint8_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 const int16_t* filter,
+                                 int filter_taps,
+                                 uint8_t* dst_ptr,
+                                 int dst_width);
+void ScalePolyphaseRows_Any_AVX2(const uint8_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 const int16_t* filter,
+                                 int filter_taps,
+                                 uint8_t* dst_ptr,
+                                 int dst_width);
+void ScalePolyphaseCols_SSSE3(uint8_t* dst_ptr,
+                              const uint8_t* src_ptr,
+                              int dst_width,
+                              const int* offsets,
+                              const int16_t* filter,
+                              int filter_taps);
+void ScalePolyphaseCols_Any_SSSE3(uint8_t* dst_ptr,
+                                  const uint8_t* src_ptr,
+                                  int dst_width,
+                                  const int* offsets,
+                                  const int16_t* filter,
+                                  int filter_taps);
+void ScaleARGBPolyphaseCols_SSSE3(uint8_t* dst_argb,
+                                  const uint8_t* src_argb,
+                                  int dst_width,
+                                  const int* offsets,
+                                  const int16_t* filter,
+                                  int filter_taps);
+
+// 16 bit row functions.
+void ScaleRowDown2_16_SSE2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width);
+void ScaleRowDown2Linear_16_SSE2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst_ptr,
+                                 int dst_width);
+void ScaleRowDown2Box_16_SSE2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width);
+void ScaleRowDown4_16_SSE2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width);
+void ScaleRowDown4Box_16_SSE2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width);
+void ScaleRowDown2_16_AVX2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width);
+void ScaleRowDown2Linear_16_AVX2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst_ptr,
+                                 int dst_width);
+void ScaleRowDown2Box_16_AVX2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width);
+void ScaleRowDown4_16_AVX2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width);
+void ScaleRowDown4Box_16_AVX2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width);
+void ScaleRowDown2_16_AVX512BW(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown2Linear_16_AVX512BW(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst_ptr,
+                                     int dst_width);
+void ScaleRowDown2Box_16_AVX512BW(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown4_16_AVX512BW(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown4Box_16_AVX512BW(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown34_16_SSSE3(const uint16_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint16_t* dst_ptr,
+                             int dst_width);
+void ScaleRowDown34_0_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown34_1_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown38_16_SSSE3(const uint16_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint16_t* dst_ptr,
+                             int dst_width);
+void ScaleRowDown38_3_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown38_2_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown2_Any_16_SSE2(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown2Linear_Any_16_SSE2(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst_ptr,
+                                     int dst_width);
+void ScaleRowDown2Box_Any_16_SSE2(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown4_Any_16_SSE2(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown4Box_Any_16_SSE2(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown2_Any_16_AVX2(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown2Linear_Any_16_AVX2(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst_ptr,
+                                     int dst_width);
+void ScaleRowDown2Box_Any_16_AVX2(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown4_Any_16_AVX2(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown4Box_Any_16_AVX2(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width);
+void ScaleRowDown2_Any_16_AVX512BW(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown2Linear_Any_16_AVX512BW(const uint16_t* src_ptr,
+                                         ptrdiff_t src_stride,
+                                         uint16_t* dst_ptr,
+                                         int dst_width);
+void ScaleRowDown2Box_Any_16_AVX512BW(const uint16_t* src_ptr,
+                                      ptrdiff_t src_stride,
+                                      uint16_t* dst_ptr,
+                                      int dst_width);
+void ScaleRowDown4_Any_16_AVX512BW(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown4Box_Any_16_AVX512BW(const uint16_t* src_ptr,
+                                      ptrdiff_t src_stride,
+                                      uint16_t* dst_ptr,
+                                      int dst_width);
+void ScaleRowDown34_Any_16_SSSE3(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst_ptr,
+                                 int dst_width);
+void ScaleRowDown34_0_Box_Any_16_SSSE3(const uint16_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       uint16_t* dst_ptr,
+                                       int dst_width);
+void ScaleRowDown34_1_Box_Any_16_SSSE3(const uint16_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       uint16_t* dst_ptr,
+                                       int dst_width);
+void ScaleRowDown38_Any_16_SSSE3(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst_ptr,
+                                 int dst_width);
+void ScaleRowDown38_3_Box_Any_16_SSSE3(const uint16_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       uint16_t* dst_ptr,
+                                       int dst_width);
+void ScaleRowDown38_2_Box_Any_16_SSSE3(const uint16_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       uint16_t* dst_ptr,
+                                       int dst_width);
+
+void ScaleAddRow_16_SSE2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width);
+void ScaleAddRow_16_AVX2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width);
+void ScaleAddRow_16_AVX512BW(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width);
+void ScaleAddRow_Any_16_SSE2(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width);
+void ScaleAddRow_Any_16_AVX2(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width);
+void ScaleAddRow_Any_16_AVX512BW(const uint16_t* src_ptr,
+                                 uint32_t* dst_ptr,
+                                 int src_width);
+
+void ScaleCols_16_SSE2(uint16_t* dst_ptr,
+                       const uint16_t* src_ptr,
+                       int dst_width,
+                       int x,
+                       int dx);
+void ScaleColsUp2_16_SSE2(uint16_t* dst_ptr,
+                          const uint16_t* src_ptr,
+                          int dst_width,
+                          int x,
+                          int dx);
+void ScaleFilterCols_16_SSSE3(uint16_t* dst_ptr,
+                              const uint16_t* src_ptr,
+                              int dst_width,
+                              int x,
+                              int dx);
+void ScaleFilterCols_16_AVX2(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx);
+void ScaleFilterCols_Any_16_AVX2(uint16_t* dst_ptr,
+                                 const uint16_t* src_ptr,
+                                 int dst_width,
+                                 int x,
+                                 int dx);
+
 // ARGB Column functions
 void ScaleARGBCols_SSE2(uint8_t* dst_argb,
                         const uint8_t* src_argb,
@@ -781,6 +1473,103 @@ void ScaleARGBRowDownEvenBox_Any_MMI(const uint8_t* src_ptr,
                                      uint8_t* dst_ptr,
                                      int dst_width);
 
+void ScaleUVRowDown2_SSSE3(const uint8_t* src_uv,
+                           ptrdiff_t src_stride,
+                           uint8_t* dst_uv,
+                           int dst_width);
+void ScaleUVRowDown2Linear_SSSE3(const uint8_t* src_uv,
+                                 ptrdiff_t src_stride,
+                                 uint8_t* dst_uv,
+                                 int dst_width);
+void ScaleUVRowDown2Box_SSSE3(const uint8_t* src_uv,
+                              ptrdiff_t src_stride,
+                              uint8_t* dst_uv,
+                              int dst_width);
+void ScaleUVRowDown2Box_AVX2(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_uv,
+                             int dst_width);
+void ScaleUVRowDown2_Any_SSSE3(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width);
+void ScaleUVRowDown2Linear_Any_SSSE3(const uint8_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint8_t* dst_ptr,
+                                     int dst_width);
+void ScaleUVRowDown2Box_Any_SSSE3(const uint8_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint8_t* dst_ptr,
+                                  int dst_width);
+void ScaleUVRowDown2Box_Any_AVX2(const uint8_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint8_t* dst_ptr,
+                                 int dst_width);
+void ScaleUVCols_SSE2(uint8_t* dst_uv,
+                      const uint8_t* src_uv,
+                      int dst_width,
+                      int x,
+                      int dx);
+void ScaleUVColsUp2_SSE2(uint8_t* dst_uv,
+                         const uint8_t* src_uv,
+                         int dst_width,
+                         int x,
+                         int dx);
+void ScaleUVFilterCols_SSSE3(uint8_t* dst_uv,
+                             const uint8_t* src_uv,
+                             int dst_width,
+                             int x,
+                             int dx);
+
+// 16 bit UV scalers for x86.
+void ScaleUVRowDown2Linear_16_SSE2(const uint16_t* src_uv,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_uv,
+                                   int dst_width);
+void ScaleUVRowDown2Box_16_SSE2(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                uint16_t* dst_uv,
+                                int dst_width);
+void ScaleUVRowDown2Linear_16_AVX2(const uint16_t* src_uv,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_uv,
+                                   int dst_width);
+void ScaleUVRowDown2Box_16_AVX2(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                uint16_t* dst_uv,
+                                int dst_width);
+void ScaleUVRowDownEvenBox_16_SSE2(const uint16_t* src_uv,
+                                   ptrdiff_t src_stride,
+                                   int src_stepx,
+                                   uint16_t* dst_uv,
+                                   int dst_width);
+void ScaleUVFilterCols_16_SSSE3(uint16_t* dst_uv,
+                                const uint16_t* src_uv,
+                                int dst_width,
+                                int x,
+                                int dx);
+void ScaleUVRowDown2Linear_Any_16_SSE2(const uint16_t* src_uv,
+                                       ptrdiff_t src_stride,
+                                       uint16_t* dst_uv,
+                                       int dst_width);
+void ScaleUVRowDown2Box_Any_16_SSE2(const uint16_t* src_uv,
+                                    ptrdiff_t src_stride,
+                                    uint16_t* dst_uv,
+                                    int dst_width);
+void ScaleUVRowDown2Linear_Any_16_AVX2(const uint16_t* src_uv,
+                                       ptrdiff_t src_stride,
+                                       uint16_t* dst_uv,
+                                       int dst_width);
+void ScaleUVRowDown2Box_Any_16_AVX2(const uint16_t* src_uv,
+                                    ptrdiff_t src_stride,
+                                    uint16_t* dst_uv,
+                                    int dst_width);
+void ScaleUVRowDownEvenBox_Any_16_SSE2(const uint16_t* src_uv,
+                                       ptrdiff_t src_stride,
+                                       int src_stepx,
+                                       uint16_t* dst_uv,
+                                       int dst_width);
+
 // ScaleRowDown2Box also used by planar functions
 // NEON downscalers with interpolation.
 
@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_SCRATCH_H_
+#define INCLUDE_LIBYUV_SCRATCH_H_
+
+#include <stddef.h>  // For size_t.
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// A scratch arena holds the temporary row and frame buffers of libyuv
+// functions so repeated calls do not allocate memory.
+// Buffers that do not fit are allocated with malloc. When no buffers are in
+// use the arena grows to the most memory used at once, so after the first
+// call of a sequence of conversions the same sequence is allocation free.
+struct LibyuvScratch;
+
+// Create an arena with size bytes of memory. size may be 0.
+LIBYUV_API
+struct LibyuvScratch* CreateScratch(size_t size);
+
+LIBYUV_API
+void DestroyScratch(struct LibyuvScratch* scratch);
+
+// Set the arena used by libyuv functions called on the current thread.
+// NULL, the default, allocates buffers with malloc. An arena must only be
+// used by one thread at a time.
+LIBYUV_API
+void SetThreadScratch(struct LibyuvScratch* scratch);
+
+LIBYUV_API
+struct LibyuvScratch* GetThreadScratch(void);
+
+// Returns the most memory used at once by libyuv functions called with the
+// arena. An arena created with this size does not allocate memory for the
+// same calls.
+LIBYUV_API
+size_t GetScratchPeak(const struct LibyuvScratch* scratch);
+
+// Returns the size of the arena memory.
+LIBYUV_API
+size_t GetScratchSize(const struct LibyuvScratch* scratch);
+
+// Internal functions used by align_buffer_64.
+// Allocate memory from the arena of the calling thread, or malloc.
+// Memory must be freed with ScratchFree on the same thread.
+LIBYUV_API
+void* ScratchAlloc(size_t size);
+
+LIBYUV_API
+void ScratchFree(void* ptr);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_SCRATCH_H_
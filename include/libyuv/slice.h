@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_SLICE_H_
+#define INCLUDE_LIBYUV_SLICE_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/scale.h"  // For FilterMode
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// A slice converter converts or scales a frame that arrives in slices of
+// rows, such as from a camera that delivers a few rows at a time. Each
+// destination row is written as soon as the source rows it depends on have
+// been pushed, and the result is identical to converting the whole frame.
+// Source rows still needed by later destination rows, such as the chroma row
+// shared by two luma rows or the rows under a vertical filter, are copied
+// into the converter, so a slice may be overwritten once pushed.
+//
+// Supported conversions are:
+//   FOURCC_I420 to FOURCC_ARGB
+//   FOURCC_ARGB to FOURCC_I420
+//   FOURCC_NV12 to FOURCC_I420
+// with the destination the size of the source, and scaling
+//   FOURCC_I420 to FOURCC_I420
+//   FOURCC_I400 to FOURCC_I400
+// to any size with ScalePlane filtering. A negative src_width mirrors when
+// scaling. Inverted sources are not supported.
+struct SliceConverter;
+
+// Returns NULL if the conversion or a size is not supported.
+LIBYUV_API
+struct SliceConverter* CreateSliceConverter(uint32_t src_fourcc,
+                                            uint32_t dst_fourcc,
+                                            int src_width,
+                                            int src_height,
+                                            int dst_width,
+                                            int dst_height,
+                                            enum FilterMode filtering);
+
+LIBYUV_API
+void DestroySliceConverter(struct SliceConverter* converter);
+
+// Start a frame with the destination planes. dst_u and dst_v are unused for
+// ARGB and I400 destinations.
+LIBYUV_API
+int SliceConverterBegin(struct SliceConverter* converter,
+                        uint8_t* dst_y,
+                        int dst_stride_y,
+                        uint8_t* dst_u,
+                        int dst_stride_u,
+                        uint8_t* dst_v,
+                        int dst_stride_v);
+
+// Push the next num_rows rows of the source. For ARGB and I400 sources the
+// rows are in src_y. For I420 and NV12 sources, a slice starting at row y
+// holds the chroma rows that start within it, chroma rows
+// [(y + 1) / 2, (y + num_rows + 1) / 2), in src_u and src_v, or in src_u
+// for the interleaved UV of NV12.
+// Returns the number of destination rows written, counting rows with their
+// chroma, or -1 if the frame was not begun or would get too many rows.
+LIBYUV_API
+int SliceConverterPushRows(struct SliceConverter* converter,
+                           const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_u,
+                           int src_stride_u,
+                           const uint8_t* src_v,
+                           int src_stride_v,
+                           int num_rows);
+
+// Finish the frame. Returns 0 if the frame is complete, or -1 if rows are
+// missing. The converter may then begin another frame.
+LIBYUV_API
+int SliceConverterEnd(struct SliceConverter* converter);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_SLICE_H_
@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_STATS_H_
+#define INCLUDE_LIBYUV_STATS_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Instrumentation counters of public functions and the row functions they
+// choose. Counting is compiled in when libyuv is built with LIBYUV_STATS
+// defined. Otherwise no counters are recorded and the calls cost nothing.
+//
+// Row functions are counted by family, ie ScaleFilterCols, with a counter
+// for each version of the family, ie ScaleFilterCols_C or
+// ScaleFilterCols_Any_NEON. Frames that fall back to C or to the _Any_
+// versions for unaligned widths show up as counts on those versions.
+// Conversions that run bands of rows on threads count a call per band.
+typedef struct LibyuvStat {
+  const char* name;    // Public function or row function family.
+  const char* kernel;  // Row function version, or NULL for public functions.
+  uint64_t calls;      // Calls of the function, or rows of the row function.
+  uint64_t pixels;     // Pixels written.
+  uint64_t cycles;     // Time stamp counter ticks on x86, else nanoseconds.
+} LibyuvStat;
+
+// Returns 1 if libyuv was built with LIBYUV_STATS.
+LIBYUV_API
+int LibyuvStatsEnabled(void);
+
+// Copy up to max_stats counters that were called since the last reset to
+// stats. Public functions come first. Returns the number of counters that
+// were called, which may be more than max_stats.
+LIBYUV_API
+int LibyuvGetStats(LibyuvStat* stats, int max_stats);
+
+// Set all counters to 0.
+LIBYUV_API
+void LibyuvResetStats(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_STATS_H_
@@ -11,6 +11,6 @@
 #ifndef INCLUDE_LIBYUV_VERSION_H_
 #define INCLUDE_LIBYUV_VERSION_H_
 
-#define LIBYUV_VERSION 1727
+#define LIBYUV_VERSION 1764
 
 #endif  // INCLUDE_LIBYUV_VERSION_H_
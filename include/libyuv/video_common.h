@@ -60,6 +60,8 @@ enum FourCC {
   FOURCC_YUY2 = FOURCC('Y', 'U', 'Y', '2'),
   FOURCC_UYVY = FOURCC('U', 'Y', 'V', 'Y'),
   FOURCC_H010 = FOURCC('H', '0', '1', '0'),  // unofficial fourcc. 10 bit lsb
+  FOURCC_P010 = FOURCC('P', '0', '1', '0'),  // 10 bit msb biplanar 420.
+  FOURCC_P016 = FOURCC('P', '0', '1', '6'),  // 16 bit biplanar 420.
 
   // 1 Secondary YUV format: row biplanar.
   FOURCC_M420 = FOURCC('M', '4', '2', '0'),
@@ -159,6 +161,8 @@ enum FourCCBpp {
   FOURCC_BPP_H420 = 12,
   FOURCC_BPP_H422 = 16,
   FOURCC_BPP_H010 = 24,
+  FOURCC_BPP_P010 = 24,
+  FOURCC_BPP_P016 = 24,
   FOURCC_BPP_MJPG = 0,  // 0 means unknown.
   FOURCC_BPP_H264 = 0,
   FOURCC_BPP_IYUV = 12,
@@ -183,6 +187,11 @@ enum FourCCBpp {
 // Converts fourcc aliases into canonical ones.
 LIBYUV_API uint32_t CanonicalFourCC(uint32_t fourcc);
 
+// Returns the Bayer fourcc of an image cropped at crop_x, crop_y from an image
+// of Bayer fourcc.  Odd offsets change which color comes first.
+// Other fourccs are returned as is.
+LIBYUV_API uint32_t CropBayerFourCC(uint32_t fourcc, int crop_x, int crop_y);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
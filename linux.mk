@@ -10,6 +10,7 @@ CXXFLAGS?=-O2 -fomit-frame-pointer
 CXXFLAGS+=-Iinclude/
 
 LOCAL_OBJ_FILES := \
+	source/batch.o             \
 	source/compare.o           \
 	source/compare_common.o    \
 	source/compare_gcc.o       \
@@ -19,6 +20,7 @@ LOCAL_OBJ_FILES := \
 	source/compare_neon.o      \
 	source/compare_win.o       \
 	source/convert_argb.o      \
+	source/convert_bayer.o     \
 	source/convert.o           \
 	source/convert_from_argb.o \
 	source/convert_from.o      \
@@ -26,6 +28,7 @@ LOCAL_OBJ_FILES := \
 	source/convert_to_argb.o   \
 	source/convert_to_i420.o   \
 	source/cpu_id.o            \
+	source/executor.o          \
 	source/mjpeg_decoder.o     \
 	source/mjpeg_validate.o    \
 	source/planar_functions.o  \
@@ -56,7 +59,12 @@ LOCAL_OBJ_FILES := \
 	source/scale_msa.o         \
 	source/scale_neon64.o      \
 	source/scale_neon.o        \
+	source/scale_plan.o        \
+	source/scale_uv.o          \
 	source/scale_win.o         \
+	source/scratch.o           \
+	source/slice.o             \
+	source/stats.o             \
 	source/video_common.o
 
 .cc.o:
@@ -65,7 +73,7 @@ LOCAL_OBJ_FILES := \
 .c.o:
 	$(CC) -c $(CFLAGS) $*.c -o $*.o
 
-all: libyuv.a yuvconvert cpuid psnr
+all: libyuv.a yuvconvert cpuid psnr libyuv_bench
 
 libyuv.a: $(LOCAL_OBJ_FILES)
 	$(AR) $(ARFLAGS) $@ $(LOCAL_OBJ_FILES)
@@ -74,9 +82,13 @@ libyuv.a: $(LOCAL_OBJ_FILES)
 yuvconvert: util/yuvconvert.cc libyuv.a
 	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/yuvconvert.cc libyuv.a
 
+# A benchmark of the row kernels and functions at each instruction set.
+libyuv_bench: util/libyuv_bench.cc libyuv.a
+	$(CXX) $(CXXFLAGS) -o $@ util/libyuv_bench.cc libyuv.a -lpthread
+
 # A standalone test utility
-psnr: util/psnr.cc
-	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/psnr.cc util/psnr_main.cc util/ssim.cc
+psnr: util/psnr.cc util/psnr_main.cc util/ssim.cc libyuv.a
+	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/psnr.cc util/psnr_main.cc util/ssim.cc libyuv.a -lpthread
 
 # A C test utility that uses libyuv conversion from C.
 # gcc 4.4 and older require -fno-exceptions to avoid link error on __gxx_personality_v0
@@ -85,4 +97,4 @@ cpuid: util/cpuid.c libyuv.a
 	$(CC) $(CFLAGS) -o $@ util/cpuid.c libyuv.a
 
 clean:
-	/bin/rm -f source/*.o *.ii *.s libyuv.a yuvconvert cpuid psnr
+	/bin/rm -f source/*.o *.ii *.s libyuv.a yuvconvert cpuid psnr libyuv_bench
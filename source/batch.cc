@@ -0,0 +1,417 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/batch.h"
+
+#include <stdlib.h>  // For malloc.
+
+#include "executor_internal.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/row.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_plan.h"
+#include "libyuv/scale_uv.h"
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+typedef void (*I422ToARGBRowFunc)(const uint8_t* y_buf,
+                                  const uint8_t* u_buf,
+                                  const uint8_t* v_buf,
+                                  uint8_t* rgb_buf,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width);
+typedef void (*NVToARGBRowFunc)(const uint8_t* y_buf,
+                                const uint8_t* uv_buf,
+                                uint8_t* rgb_buf,
+                                const struct YuvConstants* yuvconstants,
+                                int width);
+
+// Row functions and constants chosen once for all frames of a batch.
+// Frames with a width that is a multiple of align use the aligned row
+// function and the others use the Any version.
+struct BatchJob {
+  const YUVToARGBBatchFrame* frames;
+  ScalePlan** frame_plans;  // Plan of each frame, or NULL if not scaled.
+  I422ToARGBRowFunc I422ToARGBRow_Any;
+  I422ToARGBRowFunc I422ToARGBRow;
+  NVToARGBRowFunc NVToARGBRow_Any;
+  NVToARGBRowFunc NVToARGBRow;
+  int align;
+  const struct YuvConstants* yuvconstants;
+  int biplanar;  // 1 if src_u is an interleaved UV plane.
+  int swap_uv;   // 1 if the U and V planes of I420 are swapped for ABGR.
+  enum FilterMode filtering;
+};
+
+static void InitI420Kernels(BatchJob* job) {
+  job->I422ToARGBRow_Any = I422ToARGBRow_C;
+  job->I422ToARGBRow = I422ToARGBRow_C;
+  job->align = 1;
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    job->I422ToARGBRow_Any = I422ToARGBRow_Any_SSSE3;
+    job->I422ToARGBRow = I422ToARGBRow_SSSE3;
+    job->align = 8;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    job->I422ToARGBRow_Any = I422ToARGBRow_Any_AVX2;
+    job->I422ToARGBRow = I422ToARGBRow_AVX2;
+    job->align = 16;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    job->I422ToARGBRow_Any = I422ToARGBRow_Any_AVX512BW;
+    job->I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    job->align = 32;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    job->I422ToARGBRow_Any = I422ToARGBRow_Any_NEON;
+    job->I422ToARGBRow = I422ToARGBRow_NEON;
+    job->align = 8;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    job->I422ToARGBRow_Any = I422ToARGBRow_Any_MSA;
+    job->I422ToARGBRow = I422ToARGBRow_MSA;
+    job->align = 8;
+  }
+#endif
+}
+
+static void InitNV12Kernels(BatchJob* job) {
+  job->NVToARGBRow_Any = NV12ToARGBRow_C;
+  job->NVToARGBRow = NV12ToARGBRow_C;
+  job->align = 1;
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    job->NVToARGBRow_Any = NV12ToARGBRow_Any_SSSE3;
+    job->NVToARGBRow = NV12ToARGBRow_SSSE3;
+    job->align = 8;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    job->NVToARGBRow_Any = NV12ToARGBRow_Any_AVX2;
+    job->NVToARGBRow = NV12ToARGBRow_AVX2;
+    job->align = 16;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    job->NVToARGBRow_Any = NV12ToARGBRow_Any_AVX512BW;
+    job->NVToARGBRow = NV12ToARGBRow_AVX512BW;
+    job->align = 32;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    job->NVToARGBRow_Any = NV12ToARGBRow_Any_NEON;
+    job->NVToARGBRow = NV12ToARGBRow_NEON;
+    job->align = 8;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    job->NVToARGBRow_Any = NV12ToARGBRow_Any_MSA;
+    job->NVToARGBRow = NV12ToARGBRow_MSA;
+    job->align = 8;
+  }
+#endif
+}
+
+static void InitNV21Kernels(BatchJob* job) {
+  job->NVToARGBRow_Any = NV21ToARGBRow_C;
+  job->NVToARGBRow = NV21ToARGBRow_C;
+  job->align = 1;
+#if defined(HAS_NV21TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    job->NVToARGBRow_Any = NV21ToARGBRow_Any_SSSE3;
+    job->NVToARGBRow = NV21ToARGBRow_SSSE3;
+    job->align = 8;
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    job->NVToARGBRow_Any = NV21ToARGBRow_Any_AVX2;
+    job->NVToARGBRow = NV21ToARGBRow_AVX2;
+    job->align = 16;
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    job->NVToARGBRow_Any = NV21ToARGBRow_Any_NEON;
+    job->NVToARGBRow = NV21ToARGBRow_NEON;
+    job->align = 8;
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    job->NVToARGBRow_Any = NV21ToARGBRow_Any_MSA;
+    job->NVToARGBRow = NV21ToARGBRow_MSA;
+    job->align = 8;
+  }
+#endif
+}
+
+// Bytes of temporary memory needed to scale a frame, or 0 if the frame is
+// converted without scaling.
+static int BatchFrameScratchSize(const YUVToARGBBatchFrame* f) {
+  int halfwidth = (f->dst_width + 1) >> 1;
+  int halfheight = (f->dst_height + 1) >> 1;
+  if (f->src_width == f->dst_width && f->src_height == f->dst_height) {
+    return 0;
+  }
+  return f->dst_width * f->dst_height + halfwidth * halfheight * 2;
+}
+
+// Frames of the same size share a plan, so the scalers and polyphase tables
+// are set up once for each distinct geometry of the batch. plans receives the
+// distinct plans and frame_plans the plan of each frame. Returns the number
+// of plans, or -1 if a plan could not be created.
+static int CreateBatchPlans(const YUVToARGBBatchFrame* frames,
+                            int num_frames,
+                            uint32_t fourcc,
+                            enum FilterMode filtering,
+                            ScalePlan** plans,
+                            int* plan_frames,
+                            ScalePlan** frame_plans) {
+  int num_plans = 0;
+  int i, j;
+  for (i = 0; i < num_frames; ++i) {
+    const YUVToARGBBatchFrame* f = &frames[i];
+    frame_plans[i] = NULL;
+    if (!BatchFrameScratchSize(f)) {
+      continue;
+    }
+    for (j = 0; j < num_plans; ++j) {
+      const YUVToARGBBatchFrame* g = &frames[plan_frames[j]];
+      if (f->src_width == g->src_width && f->src_height == g->src_height &&
+          f->dst_width == g->dst_width && f->dst_height == g->dst_height) {
+        frame_plans[i] = plans[j];
+        break;
+      }
+    }
+    if (frame_plans[i]) {
+      continue;
+    }
+    plans[num_plans] = CreateScalePlan(fourcc, f->src_width, f->src_height,
+                                       f->dst_width, f->dst_height, filtering);
+    if (!plans[num_plans]) {
+      for (j = 0; j < num_plans; ++j) {
+        DestroyScalePlan(plans[j]);
+      }
+      return -1;
+    }
+    plan_frames[num_plans] = i;
+    frame_plans[i] = plans[num_plans++];
+  }
+  return num_plans;
+}
+
+static void ConvertBatchFrame(const BatchJob* job,
+                              const YUVToARGBBatchFrame* f,
+                              const ScalePlan* plan,
+                              uint8_t* scratch) {
+  const uint8_t* src_y = f->src_y;
+  const uint8_t* src_u = f->src_u;
+  const uint8_t* src_v = f->src_v;
+  int src_stride_y = f->src_stride_y;
+  int src_stride_u = f->src_stride_u;
+  int src_stride_v = f->src_stride_v;
+  uint8_t* dst_argb = f->dst_argb;
+  int width = f->dst_width;
+  int height = f->dst_height;
+  int y;
+
+  // Scale the frame to the destination size, then convert it.
+  if (plan) {
+    int halfwidth = (width + 1) >> 1;
+    int halfheight = (height + 1) >> 1;
+    int src_halfwidth = (f->src_width + 1) >> 1;
+    int src_halfheight = (f->src_height + 1) >> 1;
+    uint8_t* scale_y = scratch;
+    uint8_t* scale_u = scale_y + width * height;
+    if (job->biplanar) {
+      ScalePlanI400(plan, src_y, src_stride_y, scale_y, width);
+      UVScale(src_u, src_stride_u, src_halfwidth, src_halfheight, scale_u,
+              halfwidth * 2, halfwidth, halfheight, job->filtering);
+      src_stride_u = halfwidth * 2;
+    } else {
+      uint8_t* scale_v = scale_u + halfwidth * halfheight;
+      ScalePlanI420(plan, src_y, src_stride_y, src_u, src_stride_u, src_v,
+                    src_stride_v, scale_y, width, scale_u, halfwidth, scale_v,
+                    halfwidth);
+      src_v = scale_v;
+      src_stride_u = halfwidth;
+      src_stride_v = halfwidth;
+    }
+    src_y = scale_y;
+    src_u = scale_u;
+    src_stride_y = width;
+  }
+
+  if (job->biplanar) {
+    NVToARGBRowFunc NVToARGBRow = IS_ALIGNED(width, job->align)
+                                      ? job->NVToARGBRow
+                                      : job->NVToARGBRow_Any;
+    for (y = 0; y < height; ++y) {
+      NVToARGBRow(src_y, src_u, dst_argb, job->yuvconstants, width);
+      dst_argb += f->dst_stride_argb;
+      src_y += src_stride_y;
+      if (y & 1) {
+        src_u += src_stride_u;
+      }
+    }
+    return;
+  }
+  {
+    I422ToARGBRowFunc I422ToARGBRow = IS_ALIGNED(width, job->align)
+                                          ? job->I422ToARGBRow
+                                          : job->I422ToARGBRow_Any;
+    if (job->swap_uv) {
+      const uint8_t* src_t = src_u;
+      int src_stride_t = src_stride_u;
+      src_u = src_v;
+      src_stride_u = src_stride_v;
+      src_v = src_t;
+      src_stride_v = src_stride_t;
+    }
+    for (y = 0; y < height; ++y) {
+      I422ToARGBRow(src_y, src_u, src_v, dst_argb, job->yuvconstants, width);
+      dst_argb += f->dst_stride_argb;
+      src_y += src_stride_y;
+      if (y & 1) {
+        src_u += src_stride_u;
+        src_v += src_stride_v;
+      }
+    }
+  }
+}
+
+// Convert frames [begin, end). The scale buffer is sized for the largest
+// frame and shared by all frames of the range.
+static void BatchFrames(void* arg, int begin, int end) {
+  const BatchJob* job = static_cast<const BatchJob*>(arg);
+  int scratch_size = 0;
+  int i;
+  for (i = begin; i < end; ++i) {
+    int size = BatchFrameScratchSize(&job->frames[i]);
+    if (size > scratch_size) {
+      scratch_size = size;
+    }
+  }
+  align_buffer_64(scratch, scratch_size);
+  for (i = begin; i < end; ++i) {
+    ConvertBatchFrame(job, &job->frames[i], job->frame_plans[i], scratch);
+  }
+  free_aligned_buffer_64(scratch);
+}
+
+LIBYUV_API
+int YUVToARGBBatch(const struct YUVToARGBBatchFrame* frames,
+                   int num_frames,
+                   uint32_t src_fourcc,
+                   uint32_t dst_fourcc,
+                   enum FilterMode filtering) {
+  BatchJob job;
+  ScalePlan** plans;
+  int* plan_frames;
+  int num_plans;
+  int64_t total_pixels = 0;
+  int i;
+  if (!frames || num_frames <= 0 ||
+      (dst_fourcc != FOURCC_ARGB && dst_fourcc != FOURCC_ABGR)) {
+    return -1;
+  }
+  job.frames = frames;
+  job.filtering = filtering;
+  job.swap_uv = 0;
+  job.yuvconstants =
+      dst_fourcc == FOURCC_ABGR ? &kYvuI601Constants : &kYuvI601Constants;
+  // ABGR is ARGB with U and V swapped and the constants of YVU.
+  switch (src_fourcc) {
+    case FOURCC_I420:
+      job.biplanar = 0;
+      job.swap_uv = dst_fourcc == FOURCC_ABGR;
+      InitI420Kernels(&job);
+      break;
+    case FOURCC_NV12:
+      job.biplanar = 1;
+      if (dst_fourcc == FOURCC_ABGR) {
+        InitNV21Kernels(&job);
+      } else {
+        InitNV12Kernels(&job);
+      }
+      break;
+    case FOURCC_NV21:
+      job.biplanar = 1;
+      if (dst_fourcc == FOURCC_ABGR) {
+        InitNV12Kernels(&job);
+      } else {
+        InitNV21Kernels(&job);
+      }
+      break;
+    default:
+      return -1;
+  }
+
+  for (i = 0; i < num_frames; ++i) {
+    const YUVToARGBBatchFrame* f = &frames[i];
+    if (!f->src_y || !f->src_u || (!job.biplanar && !f->src_v) ||
+        !f->dst_argb || f->src_width <= 0 || f->src_height <= 0 ||
+        f->dst_width <= 0 || f->dst_height <= 0) {
+      return -1;
+    }
+    total_pixels += (int64_t)f->dst_width * f->dst_height;
+  }
+
+  // The interleaved UV plane of NV12 and NV21 is scaled by UVScale, so only
+  // the Y plane has a plan.
+  plans = (ScalePlan**)malloc(num_frames * (2 * sizeof(ScalePlan*) +
+                                            sizeof(int))); /* NOLINT */
+  if (!plans) {
+    return -1;
+  }
+  job.frame_plans = plans + num_frames;
+  plan_frames = (int*)(plans + num_frames * 2);
+  num_plans = CreateBatchPlans(frames, num_frames,
+                               job.biplanar ? FOURCC_I400 : FOURCC_I420,
+                               filtering, plans, plan_frames, job.frame_plans);
+  if (num_plans < 0) {
+    free(plans);
+    return -1;
+  }
+
+  // Each frame is a row of the range, as wide as the average frame.
+  if (ParallelRows((int)(total_pixels / num_frames), num_frames, 1,
+                   BatchFrames, &job) != 0) {
+    BatchFrames(&job, 0, num_frames);
+  }
+  for (i = 0; i < num_plans; ++i) {
+    DestroyScalePlan(plans[i]);
+  }
+  free(plans);
+  return 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -12,10 +12,12 @@
 
 #include <float.h>
 #include <math.h>
+#include <string.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#include "executor_internal.h"
 #include "libyuv/basic_types.h"
 #include "libyuv/compare_row.h"
 #include "libyuv/cpu_id.h"
@@ -264,6 +266,257 @@ uint64_t ComputeSumSquareErrorPlane(const uint8_t* src_a,
   return sse;
 }
 
+// SumSquareError_16 returns 64 bit sums, so any count can be summed at once.
+LIBYUV_API
+uint64_t ComputeSumSquareError_16(const uint16_t* src_a,
+                                  const uint16_t* src_b,
+                                  int count) {
+  int simd_mask = 0;
+  int simd_count;
+  uint64_t sse = 0;
+  uint64_t (*SumSquareError_16)(const uint16_t* src_a, const uint16_t* src_b,
+                                int count) = SumSquareError_16_C;
+#if defined(HAS_SUMSQUAREERROR_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SumSquareError_16 = SumSquareError_16_NEON;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SumSquareError_16 = SumSquareError_16_SSE2;
+    simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SumSquareError_16 = SumSquareError_16_AVX2;
+    simd_mask = 31;
+  }
+#endif
+  simd_count = count & ~simd_mask;
+  if (simd_count > 0) {
+    sse += SumSquareError_16(src_a, src_b, simd_count);
+  }
+  if (count > simd_count) {
+    sse += SumSquareError_16_C(src_a + simd_count, src_b + simd_count,
+                               count - simd_count);
+  }
+  return sse;
+}
+
+LIBYUV_API
+uint64_t ComputeSumSquareErrorPlane_16(const uint16_t* src_a,
+                                       int stride_a,
+                                       const uint16_t* src_b,
+                                       int stride_b,
+                                       int width,
+                                       int height) {
+  uint64_t sse = 0;
+  int h;
+  // Coalesce rows.
+  if (stride_a == width && stride_b == width) {
+    width *= height;
+    height = 1;
+    stride_a = stride_b = 0;
+  }
+  for (h = 0; h < height; ++h) {
+    sse += ComputeSumSquareError_16(src_a, src_b, width);
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  return sse;
+}
+
+// Rows of blocks, split into bands by ParallelRows. 8 bit planes are summed
+// by SumSquareError into dst_sse and planes of more bits by
+// SumSquareError_16 into dst_sse_16.
+struct SumSquareErrorBlocksArgs {
+  const uint8_t* src_a;
+  int stride_a;  // In bytes.
+  const uint8_t* src_b;
+  int stride_b;
+  int width;
+  int block_size;
+  uint32_t* dst_sse;
+  uint64_t* dst_sse_16;
+  int dst_stride_sse;
+  uint32_t (*SumSquareError)(const uint8_t* src_a,
+                             const uint8_t* src_b,
+                             int count);
+  uint64_t (*SumSquareError_16)(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count);
+  int simd_mask;  // Counts the SIMD version can not do.
+};
+
+// Each row of pixels is added to the blocks of its row of blocks. Bands
+// start on a row of blocks.
+static void SumSquareErrorBlockRows(void* arg, int begin, int end) {
+  const SumSquareErrorBlocksArgs* args =
+      (const SumSquareErrorBlocksArgs*)(arg);
+  const int block_size = args->block_size;
+  const int dst_width = (args->width + block_size - 1) / block_size;
+  int y;
+  for (y = begin; y < end; ++y) {
+    const uint8_t* src_a = args->src_a + y * (intptr_t)args->stride_a;
+    const uint8_t* src_b = args->src_b + y * (intptr_t)args->stride_b;
+    const int dst_offset = (y / block_size) * args->dst_stride_sse;
+    int x;
+    if (y % block_size == 0) {
+      if (args->SumSquareError_16) {
+        memset(args->dst_sse_16 + dst_offset, 0, dst_width * 8);
+      } else {
+        memset(args->dst_sse + dst_offset, 0, dst_width * 4);
+      }
+    }
+    for (x = 0; x < dst_width; ++x) {
+      const int i = x * block_size;
+      const int count =
+          args->width - i < block_size ? args->width - i : block_size;
+      const int simd_count = count & ~args->simd_mask;
+      if (args->SumSquareError_16) {
+        const uint16_t* a = (const uint16_t*)(src_a) + i;
+        const uint16_t* b = (const uint16_t*)(src_b) + i;
+        uint64_t sse = 0;
+        if (simd_count > 0) {
+          sse += args->SumSquareError_16(a, b, simd_count);
+        }
+        if (count > simd_count) {
+          sse += SumSquareError_16_C(a + simd_count, b + simd_count,
+                                     count - simd_count);
+        }
+        args->dst_sse_16[dst_offset + x] += sse;
+      } else {
+        uint32_t sse = 0;
+        if (simd_count > 0) {
+          sse += args->SumSquareError(src_a + i, src_b + i, simd_count);
+        }
+        if (count > simd_count) {
+          sse += SumSquareError_C(src_a + i + simd_count,
+                                  src_b + i + simd_count, count - simd_count);
+        }
+        args->dst_sse[dst_offset + x] += sse;
+      }
+    }
+  }
+}
+
+static void SumSquareErrorBlocksRun(SumSquareErrorBlocksArgs* args,
+                                    int height) {
+  if (ParallelRows(args->width, height, args->block_size,
+                   SumSquareErrorBlockRows, args) != 0) {
+    SumSquareErrorBlockRows(args, 0, height);
+  }
+}
+
+LIBYUV_API
+int ComputeSumSquareErrorBlocks(const uint8_t* src_a,
+                                int stride_a,
+                                const uint8_t* src_b,
+                                int stride_b,
+                                int width,
+                                int height,
+                                int block_size,
+                                uint32_t* dst_sse,
+                                int dst_stride_sse) {
+  SumSquareErrorBlocksArgs args;
+  if (!src_a || !src_b || !dst_sse || width <= 0 || height <= 0 ||
+      block_size < 1 || block_size > 256) {
+    return -1;
+  }
+  memset(&args, 0, sizeof(args));
+  args.src_a = src_a;
+  args.stride_a = stride_a;
+  args.src_b = src_b;
+  args.stride_b = stride_b;
+  args.width = width;
+  args.block_size = block_size;
+  args.dst_sse = dst_sse;
+  args.dst_stride_sse = dst_stride_sse;
+  args.SumSquareError = SumSquareError_C;
+#if defined(HAS_SUMSQUAREERROR_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    args.SumSquareError = SumSquareError_NEON;
+    args.simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    args.SumSquareError = SumSquareError_SSE2;
+    args.simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_AVX2)
+  // Blocks of 16 would only use C.
+  if (TestCpuFlag(kCpuHasAVX2) && block_size >= 32) {
+    args.SumSquareError = SumSquareError_AVX2;
+    args.simd_mask = 31;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_MSA)
+  if (TestCpuFlag(kCpuHasMSA) && block_size >= 32) {
+    args.SumSquareError = SumSquareError_MSA;
+    args.simd_mask = 31;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    args.SumSquareError = SumSquareError_MMI;
+    args.simd_mask = 7;
+  }
+#endif
+  SumSquareErrorBlocksRun(&args, height);
+  return 0;
+}
+
+LIBYUV_API
+int ComputeSumSquareErrorBlocks_16(const uint16_t* src_a,
+                                   int stride_a,
+                                   const uint16_t* src_b,
+                                   int stride_b,
+                                   int width,
+                                   int height,
+                                   int block_size,
+                                   uint64_t* dst_sse,
+                                   int dst_stride_sse) {
+  SumSquareErrorBlocksArgs args;
+  if (!src_a || !src_b || !dst_sse || width <= 0 || height <= 0 ||
+      block_size < 1) {
+    return -1;
+  }
+  memset(&args, 0, sizeof(args));
+  args.src_a = (const uint8_t*)(src_a);
+  args.stride_a = stride_a * 2;
+  args.src_b = (const uint8_t*)(src_b);
+  args.stride_b = stride_b * 2;
+  args.width = width;
+  args.block_size = block_size;
+  args.dst_sse_16 = dst_sse;
+  args.dst_stride_sse = dst_stride_sse;
+  args.SumSquareError_16 = SumSquareError_16_C;
+#if defined(HAS_SUMSQUAREERROR_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    args.SumSquareError_16 = SumSquareError_16_NEON;
+    args.simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    args.SumSquareError_16 = SumSquareError_16_SSE2;
+    args.simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SUMSQUAREERROR_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && block_size >= 32) {
+    args.SumSquareError_16 = SumSquareError_16_AVX2;
+    args.simd_mask = 31;
+  }
+#endif
+  SumSquareErrorBlocksRun(&args, height);
+  return 0;
+}
+
 LIBYUV_API
 double SumSquareErrorToPsnr(uint64_t sse, uint64_t count) {
   double psnr;
@@ -323,62 +576,408 @@ double I420Psnr(const uint8_t* src_y_a,
   return SumSquareErrorToPsnr(sse, samples);
 }
 
+LIBYUV_API
+double SumSquareErrorToPsnr_16(uint64_t sse, uint64_t count, int depth) {
+  const double peak = (double)((1 << depth) - 1);
+  double psnr;
+  if (sse > 0) {
+    double mse = (double)count / (double)sse;
+    psnr = 10.0 * log10(peak * peak * mse);
+  } else {
+    psnr = kMaxPsnr;  // Limit to prevent divide by 0
+  }
+
+  if (psnr > kMaxPsnr) {
+    psnr = kMaxPsnr;
+  }
+
+  return psnr;
+}
+
+LIBYUV_API
+double CalcFramePsnr_16(const uint16_t* src_a,
+                        int stride_a,
+                        const uint16_t* src_b,
+                        int stride_b,
+                        int width,
+                        int height,
+                        int depth) {
+  const uint64_t samples = (uint64_t)width * (uint64_t)height;
+  const uint64_t sse = ComputeSumSquareErrorPlane_16(src_a, stride_a, src_b,
+                                                     stride_b, width, height);
+  return SumSquareErrorToPsnr_16(sse, samples, depth);
+}
+
+LIBYUV_API
+double I010Psnr(const uint16_t* src_y_a,
+                int stride_y_a,
+                const uint16_t* src_u_a,
+                int stride_u_a,
+                const uint16_t* src_v_a,
+                int stride_v_a,
+                const uint16_t* src_y_b,
+                int stride_y_b,
+                const uint16_t* src_u_b,
+                int stride_u_b,
+                const uint16_t* src_v_b,
+                int stride_v_b,
+                int width,
+                int height) {
+  const uint64_t sse_y = ComputeSumSquareErrorPlane_16(
+      src_y_a, stride_y_a, src_y_b, stride_y_b, width, height);
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const uint64_t sse_u = ComputeSumSquareErrorPlane_16(
+      src_u_a, stride_u_a, src_u_b, stride_u_b, width_uv, height_uv);
+  const uint64_t sse_v = ComputeSumSquareErrorPlane_16(
+      src_v_a, stride_v_a, src_v_b, stride_v_b, width_uv, height_uv);
+  const uint64_t samples = (uint64_t)width * (uint64_t)height +
+                           2 * ((uint64_t)width_uv * (uint64_t)height_uv);
+  const uint64_t sse = sse_y + sse_u + sse_v;
+  return SumSquareErrorToPsnr_16(sse, samples, 10);
+}
+
 static const int64_t cc1 = 26634;   // (64^2*(.01*255)^2
 static const int64_t cc2 = 239708;  // (64^2*(.03*255)^2
 
-static double Ssim8x8_C(const uint8_t* src_a,
-                        int stride_a,
-                        const uint8_t* src_b,
-                        int stride_b) {
-  int64_t sum_a = 0;
-  int64_t sum_b = 0;
-  int64_t sum_sq_a = 0;
-  int64_t sum_sq_b = 0;
-  int64_t sum_axb = 0;
+// SSIM of an 8x8 window from the sums of its pixels.
+static double Ssim8x8(int64_t sum_a,
+                      int64_t sum_b,
+                      int64_t sum_sq_a,
+                      int64_t sum_sq_b,
+                      int64_t sum_axb) {
+  const int64_t count = 64;
+  // scale the constants by number of pixels
+  const int64_t c1 = (cc1 * count * count) >> 12;
+  const int64_t c2 = (cc2 * count * count) >> 12;
 
-  int i;
-  for (i = 0; i < 8; ++i) {
-    int j;
-    for (j = 0; j < 8; ++j) {
-      sum_a += src_a[j];
-      sum_b += src_b[j];
-      sum_sq_a += src_a[j] * src_a[j];
-      sum_sq_b += src_b[j] * src_b[j];
-      sum_axb += src_a[j] * src_b[j];
-    }
+  const int64_t sum_a_x_sum_b = sum_a * sum_b;
 
-    src_a += stride_a;
-    src_b += stride_b;
+  const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
+                         (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+
+  const int64_t sum_a_sq = sum_a * sum_a;
+  const int64_t sum_b_sq = sum_b * sum_b;
+
+  const int64_t ssim_d =
+      (sum_a_sq + sum_b_sq + c1) *
+      (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+
+  if (ssim_d == 0.0) {
+    return DBL_MAX;
   }
+  return ssim_n * 1.0 / ssim_d;
+}
 
-  {
-    const int64_t count = 64;
-    // scale the constants by number of pixels
-    const int64_t c1 = (cc1 * count * count) >> 12;
-    const int64_t c2 = (cc2 * count * count) >> 12;
+// SSIM of an 8x8 window of samples of more than 8 bits. The products do not
+// fit in 64 bits, so they are done in double.
+static double Ssim8x8_16(int64_t sum_a,
+                         int64_t sum_b,
+                         int64_t sum_sq_a,
+                         int64_t sum_sq_b,
+                         int64_t sum_axb,
+                         double c1,
+                         double c2) {
+  const int64_t count = 64;
+  const int64_t sum_a_x_sum_b = sum_a * sum_b;
+  const int64_t sum_a_sq = sum_a * sum_a;
+  const int64_t sum_b_sq = sum_b * sum_b;
+  const double ssim_n =
+      ((double)(2 * sum_a_x_sum_b) + c1) *
+      ((double)(2 * count * sum_axb - 2 * sum_a_x_sum_b) + c2);
+  const double ssim_d =
+      ((double)(sum_a_sq + sum_b_sq) + c1) *
+      ((double)(count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq) +
+       c2);
+  if (ssim_d == 0.0) {
+    return DBL_MAX;
+  }
+  return ssim_n / ssim_d;
+}
+
+// Sum c of the 8x8 window made of blocks x and x + 1 of 2 rows of 4x4 block
+// sums, stored as SsimSums4x4 does.
+static __inline int64_t SsimWindowSum(const uint32_t* sums0,
+                                      const uint32_t* sums1,
+                                      int x,
+                                      int c) {
+  const int i0 = (x >> 2) * 20 + c * 4 + (x & 3);
+  const int i1 = ((x + 1) >> 2) * 20 + c * 4 + ((x + 1) & 3);
+  return (int64_t)sums0[i0] + sums0[i1] + sums1[i0] + sums1[i1];
+}
 
-    const int64_t sum_a_x_sum_b = sum_a * sum_b;
+// Rows of 8x8 windows, split into bands by ParallelRows. 8 bit planes are
+// summed by SsimSums4x4 and planes of more bits by SsimSums4x4_16.
+struct SsimArgs {
+  const uint8_t* src_a;
+  int stride_a;  // In bytes.
+  const uint8_t* src_b;
+  int stride_b;
+  int num_cols;     // Windows in a row.
+  int num_rows;     // Rows of windows.
+  double* totals;   // Sum of the SSIM of each row of windows, or NULL.
+  float* map;       // Mean SSIM of the windows of each block, or NULL.
+  int map_stride;   // In floats.
+  int map_windows;  // Windows per side of a block of the map.
+  void (*SsimSums4x4)(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width);
+  void (*SsimSums4x4_16)(const uint16_t* src_a,
+                         int stride_a,
+                         const uint16_t* src_b,
+                         int stride_b,
+                         uint32_t* sums,
+                         int width);
+  int simd_mask;  // Widths the SIMD version can not do.
+  double c1;      // Constants of Ssim8x8_16.
+  double c2;
+};
 
-    const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
-                           (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+// Sums of the 4x4 blocks of a row of blocks. The blocks of the windows of
+// the row start at each 4 pixels, up to and including block num_cols.
+static void SsimBlockRow(const SsimArgs* args, int row, uint32_t* sums) {
+  const uint8_t* src_a = args->src_a + row * 4 * args->stride_a;
+  const uint8_t* src_b = args->src_b + row * 4 * args->stride_b;
+  const int width = (args->num_cols + 1) * 4;
+  const int simd_width = width & ~args->simd_mask;
+  uint32_t* sums_c = sums + (simd_width >> 4) * 20;
+  if (args->SsimSums4x4_16) {
+    const uint16_t* src_a_16 = (const uint16_t*)(src_a);
+    const uint16_t* src_b_16 = (const uint16_t*)(src_b);
+    const int stride_a = args->stride_a >> 1;
+    const int stride_b = args->stride_b >> 1;
+    if (simd_width > 0) {
+      args->SsimSums4x4_16(src_a_16, stride_a, src_b_16, stride_b, sums,
+                           simd_width);
+    }
+    if (width > simd_width) {
+      SsimSums4x4_16_C(src_a_16 + simd_width, stride_a,
+                       src_b_16 + simd_width, stride_b, sums_c,
+                       width - simd_width);
+    }
+    return;
+  }
+  if (simd_width > 0) {
+    args->SsimSums4x4(src_a, args->stride_a, src_b, args->stride_b, sums,
+                      simd_width);
+  }
+  if (width > simd_width) {
+    SsimSums4x4_C(src_a + simd_width, args->stride_a, src_b + simd_width,
+                  args->stride_b, sums_c, width - simd_width);
+  }
+}
 
-    const int64_t sum_a_sq = sum_a * sum_a;
-    const int64_t sum_b_sq = sum_b * sum_b;
+// Each row of blocks is summed once and used by 2 rows of windows, and each
+// block by 4 windows. Bands of the map start on a row of blocks of the map.
+static void SsimRows(void* arg, int begin, int end) {
+  const SsimArgs* args = (const SsimArgs*)(arg);
+  const int num_cols = args->num_cols;
+  const int num_sums = ((num_cols + 4) >> 2) * 20;
+  const int n = args->map_windows;
+  const int map_width = args->map ? (num_cols + n - 1) / n : 0;
+  align_buffer_64(buf, num_sums * 2 * 4 + (num_cols + map_width) * 8);
+  uint32_t* sums0 = (uint32_t*)(buf);
+  uint32_t* sums1 = sums0 + num_sums;
+  double* ssim = (double*)(sums1 + num_sums);
+  double* block_ssim = ssim + num_cols;
+  int y;
+  SsimBlockRow(args, begin, sums0);
+  for (y = begin; y < end; ++y) {
+    uint32_t* swap;
+    int x;
+    SsimBlockRow(args, y + 1, sums1);
+    for (x = 0; x < num_cols; ++x) {
+      const int64_t sum_a = SsimWindowSum(sums0, sums1, x, 0);
+      const int64_t sum_b = SsimWindowSum(sums0, sums1, x, 1);
+      const int64_t sum_sq_a = SsimWindowSum(sums0, sums1, x, 2);
+      const int64_t sum_sq_b = SsimWindowSum(sums0, sums1, x, 3);
+      const int64_t sum_axb = SsimWindowSum(sums0, sums1, x, 4);
+      ssim[x] = args->SsimSums4x4_16
+                    ? Ssim8x8_16(sum_a, sum_b, sum_sq_a, sum_sq_b, sum_axb,
+                                 args->c1, args->c2)
+                    : Ssim8x8(sum_a, sum_b, sum_sq_a, sum_sq_b, sum_axb);
+    }
+    if (args->totals) {
+      double total = 0;
+      for (x = 0; x < num_cols; ++x) {
+        total += ssim[x];
+      }
+      args->totals[y] = total;
+    }
+    if (args->map) {
+      if (y % n == 0) {
+        memset(block_ssim, 0, map_width * 8);
+      }
+      for (x = 0; x < num_cols; ++x) {
+        block_ssim[x / n] += ssim[x];
+      }
+      if (y % n == n - 1 || y == args->num_rows - 1) {
+        float* map = args->map + (y / n) * args->map_stride;
+        const int rows = y % n + 1;
+        for (x = 0; x < map_width; ++x) {
+          const int cols = num_cols - x * n < n ? num_cols - x * n : n;
+          map[x] = (float)(block_ssim[x] / (rows * cols));
+        }
+      }
+    }
+    swap = sums0;
+    sums0 = sums1;
+    sums1 = swap;
+  }
+  free_aligned_buffer_64(buf);
+}
 
-    const int64_t ssim_d =
-        (sum_a_sq + sum_b_sq + c1) *
-        (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+// Windows of a plane start on the 4x4 pixel grid and lie within the plane.
+static void SsimInit(SsimArgs* args,
+                     const uint8_t* src_a,
+                     int stride_a,
+                     const uint8_t* src_b,
+                     int stride_b,
+                     int width,
+                     int height) {
+  memset(args, 0, sizeof(*args));
+  args->src_a = src_a;
+  args->stride_a = stride_a;
+  args->src_b = src_b;
+  args->stride_b = stride_b;
+  args->num_cols = width > 8 ? (width - 5) >> 2 : 0;
+  args->num_rows = height > 8 ? (height - 5) >> 2 : 0;
+  args->map_windows = 1;
+  args->SsimSums4x4 = SsimSums4x4_C;
+#if defined(HAS_SSIMSUMS4X4_SSE41)
+  if (TestCpuFlag(kCpuHasSSE41)) {
+    args->SsimSums4x4 = SsimSums4x4_SSE41;
+    args->simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SSIMSUMS4X4_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    args->SsimSums4x4 = SsimSums4x4_AVX2;
+    args->simd_mask = 31;
+  }
+#endif
+#if defined(HAS_SSIMSUMS4X4_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    args->SsimSums4x4 = SsimSums4x4_NEON;
+    args->simd_mask = 15;
+  }
+#endif
+}
 
-    if (ssim_d == 0.0) {
-      return DBL_MAX;
+// Samples of up to 12 bits keep the block sums of a * a in 32 bits.
+static int SsimInit_16(SsimArgs* args,
+                       const uint16_t* src_a,
+                       int stride_a,
+                       const uint16_t* src_b,
+                       int stride_b,
+                       int width,
+                       int height,
+                       int depth) {
+  const double peak = (double)((1 << depth) - 1);
+  if (depth < 8 || depth > 12) {
+    return -1;
+  }
+  SsimInit(args, (const uint8_t*)(src_a), stride_a * 2,
+           (const uint8_t*)(src_b), stride_b * 2, width, height);
+  args->SsimSums4x4 = NULL;
+  args->SsimSums4x4_16 = SsimSums4x4_16_C;
+  args->simd_mask = 0;
+  // (.01 * peak)^2 and (.03 * peak)^2 scaled by 64 pixels.
+  args->c1 = .01 * .01 * peak * peak * 64 * 64;
+  args->c2 = .03 * .03 * peak * peak * 64 * 64;
+#if defined(HAS_SSIMSUMS4X4_16_SSE41)
+  if (TestCpuFlag(kCpuHasSSE41)) {
+    args->SsimSums4x4_16 = SsimSums4x4_16_SSE41;
+    args->simd_mask = 15;
+  }
+#endif
+#if defined(HAS_SSIMSUMS4X4_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    args->SsimSums4x4_16 = SsimSums4x4_16_NEON;
+    args->simd_mask = 15;
+  }
+#endif
+  return 0;
+}
+
+static void SsimRun(SsimArgs* args) {
+  if (ParallelRows((args->num_cols + 1) * 16, args->num_rows,
+                   args->map_windows, SsimRows, args) != 0) {
+    SsimRows(args, 0, args->num_rows);
+  }
+}
+
+// Mean SSIM of the windows. The SSIM of the rows of windows are added last.
+static double SsimFrame(SsimArgs* args) {
+  const int samples = args->num_rows * args->num_cols;
+  double ssim_total = 0;
+  int y;
+  if (samples <= 0) {
+    return ssim_total / samples;
+  }
+  {
+    align_buffer_64(totals, args->num_rows * sizeof(double));
+    args->totals = (double*)(totals);
+    SsimRun(args);
+    for (y = 0; y < args->num_rows; ++y) {
+      ssim_total += args->totals[y];
     }
-    return ssim_n * 1.0 / ssim_d;
+    free_aligned_buffer_64(totals);
   }
+  ssim_total /= samples;
+  return ssim_total;
+}
+
+// Windows belong to the block of the map their top left pixel is in. Blocks
+// at the right and bottom edges that no window starts in repeat the block
+// next to them.
+static int SsimMap(SsimArgs* args,
+                   int width,
+                   int height,
+                   int block_size,
+                   float* dst_ssim,
+                   int dst_stride_ssim) {
+  const int dst_width = (width + block_size - 1) / block_size;
+  const int dst_height = (height + block_size - 1) / block_size;
+  const int n = block_size >> 2;
+  int map_width;
+  int map_height;
+  int x;
+  int y;
+  if (!dst_ssim || block_size < 4 || (block_size & 3) || args->num_rows <= 0 ||
+      args->num_cols <= 0) {
+    return -1;
+  }
+  map_width = (args->num_cols + n - 1) / n;
+  map_height = (args->num_rows + n - 1) / n;
+  args->map = dst_ssim;
+  args->map_stride = dst_stride_ssim;
+  args->map_windows = n;
+  SsimRun(args);
+  for (y = 0; y < map_height; ++y) {
+    float* map = dst_ssim + y * dst_stride_ssim;
+    for (x = map_width; x < dst_width; ++x) {
+      map[x] = map[map_width - 1];
+    }
+  }
+  for (y = map_height; y < dst_height; ++y) {
+    memcpy(dst_ssim + y * dst_stride_ssim,
+           dst_ssim + (map_height - 1) * dst_stride_ssim,
+           dst_width * sizeof(float));
+  }
+  return 0;
 }
 
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
+// Windows are summed from the sums of 4x4 blocks, which are exact, so each
+// window has the same SSIM as summing its 64 pixels. The SSIM of the rows
+// of windows are added last, so the frame SSIM can differ from adding the
+// windows in one sequence by rounding, under 1e-12.
 LIBYUV_API
 double CalcFrameSsim(const uint8_t* src_a,
                      int stride_a,
@@ -386,26 +985,59 @@ double CalcFrameSsim(const uint8_t* src_a,
                      int stride_b,
                      int width,
                      int height) {
-  int samples = 0;
-  double ssim_total = 0;
-  double (*Ssim8x8)(const uint8_t* src_a, int stride_a, const uint8_t* src_b,
-                    int stride_b) = Ssim8x8_C;
-
-  // sample point start with each 4x4 location
-  int i;
-  for (i = 0; i < height - 8; i += 4) {
-    int j;
-    for (j = 0; j < width - 8; j += 4) {
-      ssim_total += Ssim8x8(src_a + j, stride_a, src_b + j, stride_b);
-      samples++;
-    }
+  SsimArgs args;
+  SsimInit(&args, src_a, stride_a, src_b, stride_b, width, height);
+  return SsimFrame(&args);
+}
 
-    src_a += stride_a * 4;
-    src_b += stride_b * 4;
+LIBYUV_API
+double CalcFrameSsim_16(const uint16_t* src_a,
+                        int stride_a,
+                        const uint16_t* src_b,
+                        int stride_b,
+                        int width,
+                        int height,
+                        int depth) {
+  SsimArgs args;
+  if (SsimInit_16(&args, src_a, stride_a, src_b, stride_b, width, height,
+                  depth) != 0) {
+    return 0.0;
   }
+  return SsimFrame(&args);
+}
 
-  ssim_total /= samples;
-  return ssim_total;
+LIBYUV_API
+int CalcSsimMap(const uint8_t* src_a,
+                int stride_a,
+                const uint8_t* src_b,
+                int stride_b,
+                int width,
+                int height,
+                int block_size,
+                float* dst_ssim,
+                int dst_stride_ssim) {
+  SsimArgs args;
+  SsimInit(&args, src_a, stride_a, src_b, stride_b, width, height);
+  return SsimMap(&args, width, height, block_size, dst_ssim, dst_stride_ssim);
+}
+
+LIBYUV_API
+int CalcSsimMap_16(const uint16_t* src_a,
+                   int stride_a,
+                   const uint16_t* src_b,
+                   int stride_b,
+                   int width,
+                   int height,
+                   int depth,
+                   int block_size,
+                   float* dst_ssim,
+                   int dst_stride_ssim) {
+  SsimArgs args;
+  if (SsimInit_16(&args, src_a, stride_a, src_b, stride_b, width, height,
+                  depth) != 0) {
+    return -1;
+  }
+  return SsimMap(&args, width, height, block_size, dst_ssim, dst_stride_ssim);
 }
 
 LIBYUV_API
@@ -434,6 +1066,32 @@ double I420Ssim(const uint8_t* src_y_a,
   return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
 }
 
+LIBYUV_API
+double I010Ssim(const uint16_t* src_y_a,
+                int stride_y_a,
+                const uint16_t* src_u_a,
+                int stride_u_a,
+                const uint16_t* src_v_a,
+                int stride_v_a,
+                const uint16_t* src_y_b,
+                int stride_y_b,
+                const uint16_t* src_u_b,
+                int stride_u_b,
+                const uint16_t* src_v_b,
+                int stride_v_b,
+                int width,
+                int height) {
+  const double ssim_y = CalcFrameSsim_16(src_y_a, stride_y_a, src_y_b,
+                                         stride_y_b, width, height, 10);
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const double ssim_u = CalcFrameSsim_16(src_u_a, stride_u_a, src_u_b,
+                                         stride_u_b, width_uv, height_uv, 10);
+  const double ssim_v = CalcFrameSsim_16(src_v_a, stride_v_a, src_v_b,
+                                         stride_v_b, width_uv, height_uv, 10);
+  return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
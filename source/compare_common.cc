@@ -87,6 +87,88 @@ uint32_t SumSquareError_C(const uint8_t* src_a,
   return sse;
 }
 
+uint64_t SumSquareError_16_C(const uint16_t* src_a,
+                             const uint16_t* src_b,
+                             int count) {
+  uint64_t sse = 0u;
+  int i;
+  for (i = 0; i < count; ++i) {
+    int64_t diff = src_a[i] - src_b[i];
+    sse += (uint64_t)(diff * diff);
+  }
+  return sse;
+}
+
+void SsimSums4x4_C(const uint8_t* src_a,
+                   int stride_a,
+                   const uint8_t* src_b,
+                   int stride_b,
+                   uint32_t* sums,
+                   int width) {
+  int x;
+  for (x = 0; x < width; x += 4) {
+    uint32_t* block = sums + (x >> 4) * 20 + ((x >> 2) & 3);
+    uint32_t sum_a = 0u;
+    uint32_t sum_b = 0u;
+    uint32_t sum_sq_a = 0u;
+    uint32_t sum_sq_b = 0u;
+    uint32_t sum_axb = 0u;
+    int i;
+    for (i = 0; i < 4; ++i) {
+      const uint8_t* a = src_a + i * stride_a + x;
+      const uint8_t* b = src_b + i * stride_b + x;
+      int j;
+      for (j = 0; j < 4; ++j) {
+        sum_a += a[j];
+        sum_b += b[j];
+        sum_sq_a += a[j] * a[j];
+        sum_sq_b += b[j] * b[j];
+        sum_axb += a[j] * b[j];
+      }
+    }
+    block[0] = sum_a;
+    block[4] = sum_b;
+    block[8] = sum_sq_a;
+    block[12] = sum_sq_b;
+    block[16] = sum_axb;
+  }
+}
+
+void SsimSums4x4_16_C(const uint16_t* src_a,
+                      int stride_a,
+                      const uint16_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width) {
+  int x;
+  for (x = 0; x < width; x += 4) {
+    uint32_t* block = sums + (x >> 4) * 20 + ((x >> 2) & 3);
+    uint32_t sum_a = 0u;
+    uint32_t sum_b = 0u;
+    uint32_t sum_sq_a = 0u;
+    uint32_t sum_sq_b = 0u;
+    uint32_t sum_axb = 0u;
+    int i;
+    for (i = 0; i < 4; ++i) {
+      const uint16_t* a = src_a + i * stride_a + x;
+      const uint16_t* b = src_b + i * stride_b + x;
+      int j;
+      for (j = 0; j < 4; ++j) {
+        sum_a += a[j];
+        sum_b += b[j];
+        sum_sq_a += (uint32_t)a[j] * a[j];
+        sum_sq_b += (uint32_t)b[j] * b[j];
+        sum_axb += (uint32_t)a[j] * b[j];
+      }
+    }
+    block[0] = sum_a;
+    block[4] = sum_b;
+    block[8] = sum_sq_a;
+    block[12] = sum_sq_b;
+    block[16] = sum_axb;
+  }
+}
+
 // hash seed of 5381 recommended.
 // Internal C version of HashDjb2 with int sized count for efficiency.
 uint32_t HashDjb2_C(const uint8_t* src, int count, uint32_t seed) {
@@ -352,6 +352,444 @@ uint32_t HashDjb2_SSE41(const uint8_t* src, int count, uint32_t seed) {
         "xmm7");
   return hash;
 }
+
+#ifdef HAS_SUMSQUAREERROR_16_SSE2
+// Differences are squared unsigned with pmullw and pmulhuw, interleaved into
+// dwords and widened to qwords before adding, so all 16 bits are supported.
+uint64_t SumSquareError_16_SSE2(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count) {
+  uint64_t sse;
+  asm volatile(
+      "pxor       %%xmm0,%%xmm0                  \n"
+      "pxor       %%xmm5,%%xmm5                  \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu     (%0),%%xmm1                    \n"
+      "movdqu     0x10(%0),%%xmm2                \n"
+      "lea        0x20(%0),%0                    \n"
+      "movdqu     (%1),%%xmm3                    \n"
+      "movdqu     0x10(%1),%%xmm4                \n"
+      "lea        0x20(%1),%1                    \n"
+      "movdqa     %%xmm1,%%xmm6                  \n"
+      "psubusw    %%xmm3,%%xmm1                  \n"
+      "psubusw    %%xmm6,%%xmm3                  \n"
+      "por        %%xmm3,%%xmm1                  \n"
+      "movdqa     %%xmm2,%%xmm6                  \n"
+      "psubusw    %%xmm4,%%xmm2                  \n"
+      "psubusw    %%xmm6,%%xmm4                  \n"
+      "por        %%xmm4,%%xmm2                  \n"
+      "movdqa     %%xmm1,%%xmm6                  \n"
+      "pmullw     %%xmm1,%%xmm1                  \n"
+      "pmulhuw    %%xmm6,%%xmm6                  \n"
+      "movdqa     %%xmm1,%%xmm3                  \n"
+      "punpcklwd  %%xmm6,%%xmm1                  \n"
+      "punpckhwd  %%xmm6,%%xmm3                  \n"
+      "movdqa     %%xmm2,%%xmm6                  \n"
+      "pmullw     %%xmm2,%%xmm2                  \n"
+      "pmulhuw    %%xmm6,%%xmm6                  \n"
+      "movdqa     %%xmm2,%%xmm4                  \n"
+      "punpcklwd  %%xmm6,%%xmm2                  \n"
+      "punpckhwd  %%xmm6,%%xmm4                  \n"
+      "movdqa     %%xmm1,%%xmm6                  \n"
+      "punpckldq  %%xmm5,%%xmm1                  \n"
+      "punpckhdq  %%xmm5,%%xmm6                  \n"
+      "paddq      %%xmm1,%%xmm0                  \n"
+      "paddq      %%xmm6,%%xmm0                  \n"
+      "movdqa     %%xmm3,%%xmm6                  \n"
+      "punpckldq  %%xmm5,%%xmm3                  \n"
+      "punpckhdq  %%xmm5,%%xmm6                  \n"
+      "paddq      %%xmm3,%%xmm0                  \n"
+      "paddq      %%xmm6,%%xmm0                  \n"
+      "movdqa     %%xmm2,%%xmm6                  \n"
+      "punpckldq  %%xmm5,%%xmm2                  \n"
+      "punpckhdq  %%xmm5,%%xmm6                  \n"
+      "paddq      %%xmm2,%%xmm0                  \n"
+      "paddq      %%xmm6,%%xmm0                  \n"
+      "movdqa     %%xmm4,%%xmm6                  \n"
+      "punpckldq  %%xmm5,%%xmm4                  \n"
+      "punpckhdq  %%xmm5,%%xmm6                  \n"
+      "paddq      %%xmm4,%%xmm0                  \n"
+      "paddq      %%xmm6,%%xmm0                  \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+
+      "pshufd     $0xee,%%xmm0,%%xmm1            \n"
+      "paddq      %%xmm1,%%xmm0                  \n"
+      "movq       %%xmm0,%3                      \n"
+      : "+r"(src_a),  // %0
+        "+r"(src_b),  // %1
+        "+r"(count),  // %2
+        "=r"(sse)     // %3
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
+  return sse;
+}
+#endif  // HAS_SUMSQUAREERROR_16_SSE2
+
+#ifdef HAS_SUMSQUAREERROR_16_AVX2
+uint64_t SumSquareError_16_AVX2(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count) {
+  uint64_t sse;
+  asm volatile(
+      "vpxor      %%ymm0,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm5,%%ymm5,%%ymm5           \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu    (%0),%%ymm1                    \n"
+      "vmovdqu    0x20(%0),%%ymm2                \n"
+      "lea        0x40(%0),%0                    \n"
+      "vmovdqu    (%1),%%ymm3                    \n"
+      "vmovdqu    0x20(%1),%%ymm4                \n"
+      "lea        0x40(%1),%1                    \n"
+      "vpsubusw   %%ymm3,%%ymm1,%%ymm6           \n"
+      "vpsubusw   %%ymm1,%%ymm3,%%ymm1           \n"
+      "vpor       %%ymm6,%%ymm1,%%ymm1           \n"
+      "vpsubusw   %%ymm4,%%ymm2,%%ymm6           \n"
+      "vpsubusw   %%ymm2,%%ymm4,%%ymm2           \n"
+      "vpor       %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpmullw    %%ymm1,%%ymm1,%%ymm6           \n"
+      "vpmulhuw   %%ymm1,%%ymm1,%%ymm1           \n"
+      "vpunpckhwd %%ymm1,%%ymm6,%%ymm3           \n"
+      "vpunpcklwd %%ymm1,%%ymm6,%%ymm1           \n"
+      "vpmullw    %%ymm2,%%ymm2,%%ymm6           \n"
+      "vpmulhuw   %%ymm2,%%ymm2,%%ymm2           \n"
+      "vpunpckhwd %%ymm2,%%ymm6,%%ymm4           \n"
+      "vpunpcklwd %%ymm2,%%ymm6,%%ymm2           \n"
+      "vpunpckhdq %%ymm5,%%ymm1,%%ymm6           \n"
+      "vpunpckldq %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpaddq     %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpaddq     %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpunpckhdq %%ymm5,%%ymm3,%%ymm6           \n"
+      "vpunpckldq %%ymm5,%%ymm3,%%ymm3           \n"
+      "vpaddq     %%ymm3,%%ymm0,%%ymm0           \n"
+      "vpaddq     %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpunpckhdq %%ymm5,%%ymm2,%%ymm6           \n"
+      "vpunpckldq %%ymm5,%%ymm2,%%ymm2           \n"
+      "vpaddq     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpaddq     %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpunpckhdq %%ymm5,%%ymm4,%%ymm6           \n"
+      "vpunpckldq %%ymm5,%%ymm4,%%ymm4           \n"
+      "vpaddq     %%ymm4,%%ymm0,%%ymm0           \n"
+      "vpaddq     %%ymm6,%%ymm0,%%ymm0           \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+
+      "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+      "vpaddq     %%xmm1,%%xmm0,%%xmm0           \n"
+      "vpshufd    $0xee,%%xmm0,%%xmm1            \n"
+      "vpaddq     %%xmm1,%%xmm0,%%xmm0           \n"
+      "vmovq      %%xmm0,%3                      \n"
+      "vzeroupper                                \n"
+      : "+r"(src_a),  // %0
+        "+r"(src_b),  // %1
+        "+r"(count),  // %2
+        "=r"(sse)     // %3
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
+  return sse;
+}
+#endif  // HAS_SUMSQUAREERROR_16_AVX2
+
+#ifdef HAS_SSIMSUMS4X4_SSE41
+// Add 16 pixels of a row of a and b to the sums of 4 blocks.
+#define SSIMSUMS4X4ROW_SSE41                                      \
+  "pmovzxbw   (%4),%%xmm10                                    \n" \
+  "pmovzxbw   0x8(%4),%%xmm11                                 \n" \
+  "pmovzxbw   (%5),%%xmm12                                    \n" \
+  "pmovzxbw   0x8(%5),%%xmm13                                 \n" \
+  "paddw      %%xmm10,%%xmm0                                  \n" \
+  "paddw      %%xmm11,%%xmm1                                  \n" \
+  "paddw      %%xmm12,%%xmm2                                  \n" \
+  "paddw      %%xmm13,%%xmm3                                  \n" \
+  "movdqa     %%xmm10,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm10,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm4                                  \n" \
+  "movdqa     %%xmm11,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm11,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm5                                  \n" \
+  "movdqa     %%xmm12,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm12,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm6                                  \n" \
+  "movdqa     %%xmm13,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm13,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm7                                  \n" \
+  "pmaddwd    %%xmm12,%%xmm10                                 \n" \
+  "paddd      %%xmm10,%%xmm8                                  \n" \
+  "pmaddwd    %%xmm13,%%xmm11                                 \n" \
+  "paddd      %%xmm11,%%xmm9                                  \n" \
+  "add        %6,%4                                           \n" \
+  "add        %7,%5                                           \n"
+
+// Sums of 4 blocks of 4x4 pixels per loop.
+void SsimSums4x4_SSE41(const uint8_t* src_a,
+                       int stride_a,
+                       const uint8_t* src_b,
+                       int stride_b,
+                       uint32_t* sums,
+                       int width) {
+  const uint8_t* src_row_a;
+  const uint8_t* src_row_b;
+  asm volatile(
+      "pcmpeqw    %%xmm15,%%xmm15                \n"
+      "psrlw      $0xf,%%xmm15                   \n"  // 1 in each word
+
+      LABELALIGN
+      "1:                                        \n"
+      "mov        %0,%4                          \n"
+      "mov        %1,%5                          \n"
+      "pxor       %%xmm0,%%xmm0                  \n"
+      "pxor       %%xmm1,%%xmm1                  \n"
+      "pxor       %%xmm2,%%xmm2                  \n"
+      "pxor       %%xmm3,%%xmm3                  \n"
+      "pxor       %%xmm4,%%xmm4                  \n"
+      "pxor       %%xmm5,%%xmm5                  \n"
+      "pxor       %%xmm6,%%xmm6                  \n"
+      "pxor       %%xmm7,%%xmm7                  \n"
+      "pxor       %%xmm8,%%xmm8                  \n"
+      "pxor       %%xmm9,%%xmm9                  \n"
+      SSIMSUMS4X4ROW_SSE41
+      SSIMSUMS4X4ROW_SSE41
+      SSIMSUMS4X4ROW_SSE41
+      SSIMSUMS4X4ROW_SSE41
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+
+      // Add pairs of words, then pairs of dwords, to the sums of blocks.
+      "pmaddwd    %%xmm15,%%xmm0                 \n"
+      "pmaddwd    %%xmm15,%%xmm1                 \n"
+      "pmaddwd    %%xmm15,%%xmm2                 \n"
+      "pmaddwd    %%xmm15,%%xmm3                 \n"
+      "phaddd     %%xmm1,%%xmm0                  \n"
+      "phaddd     %%xmm3,%%xmm2                  \n"
+      "phaddd     %%xmm5,%%xmm4                  \n"
+      "phaddd     %%xmm7,%%xmm6                  \n"
+      "phaddd     %%xmm9,%%xmm8                  \n"
+      "movdqu     %%xmm0,(%2)                    \n"
+      "movdqu     %%xmm2,0x10(%2)                \n"
+      "movdqu     %%xmm4,0x20(%2)                \n"
+      "movdqu     %%xmm6,0x30(%2)                \n"
+      "movdqu     %%xmm8,0x40(%2)                \n"
+      "lea        0x50(%2),%2                    \n"
+      "sub        $0x10,%3                       \n"
+      "jg         1b                             \n"
+      : "+r"(src_a),       // %0
+        "+r"(src_b),       // %1
+        "+r"(sums),        // %2
+        "+r"(width),       // %3
+        "=&r"(src_row_a),  // %4
+        "=&r"(src_row_b)   // %5
+      : "r"((intptr_t)(stride_a)),  // %6
+        "r"((intptr_t)(stride_b))   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // HAS_SSIMSUMS4X4_SSE41
+
+#ifdef HAS_SSIMSUMS4X4_16_SSE41
+// Add 16 pixels of a row of a and b to the sums of 4 blocks. Words of up to
+// 12 bits are summed and squared with pmaddwd like the 8 bit version.
+#define SSIMSUMS4X4ROW_16_SSE41                                   \
+  "movdqu     (%4),%%xmm10                                    \n" \
+  "movdqu     0x10(%4),%%xmm11                                \n" \
+  "movdqu     (%5),%%xmm12                                    \n" \
+  "movdqu     0x10(%5),%%xmm13                                \n" \
+  "paddw      %%xmm10,%%xmm0                                  \n" \
+  "paddw      %%xmm11,%%xmm1                                  \n" \
+  "paddw      %%xmm12,%%xmm2                                  \n" \
+  "paddw      %%xmm13,%%xmm3                                  \n" \
+  "movdqa     %%xmm10,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm10,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm4                                  \n" \
+  "movdqa     %%xmm11,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm11,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm5                                  \n" \
+  "movdqa     %%xmm12,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm12,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm6                                  \n" \
+  "movdqa     %%xmm13,%%xmm14                                 \n" \
+  "pmaddwd    %%xmm13,%%xmm14                                 \n" \
+  "paddd      %%xmm14,%%xmm7                                  \n" \
+  "pmaddwd    %%xmm12,%%xmm10                                 \n" \
+  "paddd      %%xmm10,%%xmm8                                  \n" \
+  "pmaddwd    %%xmm13,%%xmm11                                 \n" \
+  "paddd      %%xmm11,%%xmm9                                  \n" \
+  "add        %6,%4                                           \n" \
+  "add        %7,%5                                           \n"
+
+// Sums of 4 blocks of 4x4 pixels per loop.
+void SsimSums4x4_16_SSE41(const uint16_t* src_a,
+                          int stride_a,
+                          const uint16_t* src_b,
+                          int stride_b,
+                          uint32_t* sums,
+                          int width) {
+  const uint8_t* src_row_a;
+  const uint8_t* src_row_b;
+  asm volatile(
+      "pcmpeqw    %%xmm15,%%xmm15                \n"
+      "psrlw      $0xf,%%xmm15                   \n"  // 1 in each word
+
+      LABELALIGN
+      "1:                                        \n"
+      "mov        %0,%4                          \n"
+      "mov        %1,%5                          \n"
+      "pxor       %%xmm0,%%xmm0                  \n"
+      "pxor       %%xmm1,%%xmm1                  \n"
+      "pxor       %%xmm2,%%xmm2                  \n"
+      "pxor       %%xmm3,%%xmm3                  \n"
+      "pxor       %%xmm4,%%xmm4                  \n"
+      "pxor       %%xmm5,%%xmm5                  \n"
+      "pxor       %%xmm6,%%xmm6                  \n"
+      "pxor       %%xmm7,%%xmm7                  \n"
+      "pxor       %%xmm8,%%xmm8                  \n"
+      "pxor       %%xmm9,%%xmm9                  \n"
+      SSIMSUMS4X4ROW_16_SSE41
+      SSIMSUMS4X4ROW_16_SSE41
+      SSIMSUMS4X4ROW_16_SSE41
+      SSIMSUMS4X4ROW_16_SSE41
+      "lea        0x20(%0),%0                    \n"
+      "lea        0x20(%1),%1                    \n"
+
+      // Add pairs of words, then pairs of dwords, to the sums of blocks.
+      "pmaddwd    %%xmm15,%%xmm0                 \n"
+      "pmaddwd    %%xmm15,%%xmm1                 \n"
+      "pmaddwd    %%xmm15,%%xmm2                 \n"
+      "pmaddwd    %%xmm15,%%xmm3                 \n"
+      "phaddd     %%xmm1,%%xmm0                  \n"
+      "phaddd     %%xmm3,%%xmm2                  \n"
+      "phaddd     %%xmm5,%%xmm4                  \n"
+      "phaddd     %%xmm7,%%xmm6                  \n"
+      "phaddd     %%xmm9,%%xmm8                  \n"
+      "movdqu     %%xmm0,(%2)                    \n"
+      "movdqu     %%xmm2,0x10(%2)                \n"
+      "movdqu     %%xmm4,0x20(%2)                \n"
+      "movdqu     %%xmm6,0x30(%2)                \n"
+      "movdqu     %%xmm8,0x40(%2)                \n"
+      "lea        0x50(%2),%2                    \n"
+      "sub        $0x10,%3                       \n"
+      "jg         1b                             \n"
+      : "+r"(src_a),       // %0
+        "+r"(src_b),       // %1
+        "+r"(sums),        // %2
+        "+r"(width),       // %3
+        "=&r"(src_row_a),  // %4
+        "=&r"(src_row_b)   // %5
+      : "r"((intptr_t)(stride_a)*2),  // %6
+        "r"((intptr_t)(stride_b)*2)   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // HAS_SSIMSUMS4X4_16_SSE41
+
+#ifdef HAS_SSIMSUMS4X4_AVX2
+// Add 32 pixels of a row of a and b to the sums of 8 blocks.
+#define SSIMSUMS4X4ROW_AVX2                                       \
+  "vpmovzxbw  (%4),%%ymm10                                    \n" \
+  "vpmovzxbw  0x10(%4),%%ymm11                                \n" \
+  "vpmovzxbw  (%5),%%ymm12                                    \n" \
+  "vpmovzxbw  0x10(%5),%%ymm13                                \n" \
+  "vpaddw     %%ymm10,%%ymm0,%%ymm0                           \n" \
+  "vpaddw     %%ymm11,%%ymm1,%%ymm1                           \n" \
+  "vpaddw     %%ymm12,%%ymm2,%%ymm2                           \n" \
+  "vpaddw     %%ymm13,%%ymm3,%%ymm3                           \n" \
+  "vpmaddwd   %%ymm10,%%ymm10,%%ymm14                         \n" \
+  "vpaddd     %%ymm14,%%ymm4,%%ymm4                           \n" \
+  "vpmaddwd   %%ymm11,%%ymm11,%%ymm14                         \n" \
+  "vpaddd     %%ymm14,%%ymm5,%%ymm5                           \n" \
+  "vpmaddwd   %%ymm12,%%ymm12,%%ymm14                         \n" \
+  "vpaddd     %%ymm14,%%ymm6,%%ymm6                           \n" \
+  "vpmaddwd   %%ymm13,%%ymm13,%%ymm14                         \n" \
+  "vpaddd     %%ymm14,%%ymm7,%%ymm7                           \n" \
+  "vpmaddwd   %%ymm12,%%ymm10,%%ymm10                         \n" \
+  "vpaddd     %%ymm10,%%ymm8,%%ymm8                           \n" \
+  "vpmaddwd   %%ymm13,%%ymm11,%%ymm11                         \n" \
+  "vpaddd     %%ymm11,%%ymm9,%%ymm9                           \n" \
+  "add        %6,%4                                           \n" \
+  "add        %7,%5                                           \n"
+
+// Sums of 8 blocks of 4x4 pixels per loop. vphaddd adds within 128 bit
+// lanes, so vpermq puts the blocks back in order.
+void SsimSums4x4_AVX2(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width) {
+  const uint8_t* src_row_a;
+  const uint8_t* src_row_b;
+  asm volatile(
+      "vpcmpeqw   %%ymm15,%%ymm15,%%ymm15        \n"
+      "vpsrlw     $0xf,%%ymm15,%%ymm15           \n"  // 1 in each word
+
+      LABELALIGN
+      "1:                                        \n"
+      "mov        %0,%4                          \n"
+      "mov        %1,%5                          \n"
+      "vpxor      %%ymm0,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm1,%%ymm1,%%ymm1           \n"
+      "vpxor      %%ymm2,%%ymm2,%%ymm2           \n"
+      "vpxor      %%ymm3,%%ymm3,%%ymm3           \n"
+      "vpxor      %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpxor      %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpxor      %%ymm6,%%ymm6,%%ymm6           \n"
+      "vpxor      %%ymm7,%%ymm7,%%ymm7           \n"
+      "vpxor      %%ymm8,%%ymm8,%%ymm8           \n"
+      "vpxor      %%ymm9,%%ymm9,%%ymm9           \n"
+      SSIMSUMS4X4ROW_AVX2
+      SSIMSUMS4X4ROW_AVX2
+      SSIMSUMS4X4ROW_AVX2
+      SSIMSUMS4X4ROW_AVX2
+      "lea        0x20(%0),%0                    \n"
+      "lea        0x20(%1),%1                    \n"
+
+      // Add pairs of words, then pairs of dwords, to the sums of blocks.
+      "vpmaddwd   %%ymm15,%%ymm0,%%ymm0          \n"
+      "vpmaddwd   %%ymm15,%%ymm1,%%ymm1          \n"
+      "vpmaddwd   %%ymm15,%%ymm2,%%ymm2          \n"
+      "vpmaddwd   %%ymm15,%%ymm3,%%ymm3          \n"
+      "vphaddd    %%ymm1,%%ymm0,%%ymm0           \n"
+      "vphaddd    %%ymm3,%%ymm2,%%ymm2           \n"
+      "vphaddd    %%ymm5,%%ymm4,%%ymm4           \n"
+      "vphaddd    %%ymm7,%%ymm6,%%ymm6           \n"
+      "vphaddd    %%ymm9,%%ymm8,%%ymm8           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vpermq     $0xd8,%%ymm2,%%ymm2            \n"
+      "vpermq     $0xd8,%%ymm4,%%ymm4            \n"
+      "vpermq     $0xd8,%%ymm6,%%ymm6            \n"
+      "vpermq     $0xd8,%%ymm8,%%ymm8            \n"
+      "vmovdqu    %%xmm0,(%2)                    \n"
+      "vmovdqu    %%xmm2,0x10(%2)                \n"
+      "vmovdqu    %%xmm4,0x20(%2)                \n"
+      "vmovdqu    %%xmm6,0x30(%2)                \n"
+      "vmovdqu    %%xmm8,0x40(%2)                \n"
+      "vextracti128 $0x1,%%ymm0,0x50(%2)         \n"
+      "vextracti128 $0x1,%%ymm2,0x60(%2)         \n"
+      "vextracti128 $0x1,%%ymm4,0x70(%2)         \n"
+      "vextracti128 $0x1,%%ymm6,0x80(%2)         \n"
+      "vextracti128 $0x1,%%ymm8,0x90(%2)         \n"
+      "lea        0xa0(%2),%2                    \n"
+      "sub        $0x20,%3                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_a),       // %0
+        "+r"(src_b),       // %1
+        "+r"(sums),        // %2
+        "+r"(width),       // %3
+        "=&r"(src_row_a),  // %4
+        "=&r"(src_row_b)   // %5
+      : "r"((intptr_t)(stride_a)),  // %6
+        "r"((intptr_t)(stride_b))   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // HAS_SSIMSUMS4X4_AVX2
 #endif  // defined(__x86_64__) || (defined(__i386__) && !defined(__pic__)))
 
 #ifdef __cplusplus
@@ -82,6 +82,214 @@ uint32_t SumSquareError_NEON(const uint8_t* src_a,
   return sse;
 }
 
+// Absolute differences of up to 16 bits are squared in 32 bits and added
+// in pairs to 64 bit sums.
+uint64_t SumSquareError_16_NEON(const uint16_t* src_a,
+                                const uint16_t* src_b,
+                                int count) {
+  uint64_t sse;
+  asm volatile(
+      "eor        v16.16b, v16.16b, v16.16b      \n"
+      "eor        v17.16b, v17.16b, v17.16b      \n"
+      "eor        v18.16b, v18.16b, v18.16b      \n"
+      "eor        v19.16b, v19.16b, v19.16b      \n"
+
+      "1:                                        \n"
+      "ld1        {v0.8h, v1.8h}, [%0], #32      \n"
+      "ld1        {v2.8h, v3.8h}, [%1], #32      \n"
+      "subs       %w2, %w2, #16                  \n"
+      "uabd       v0.8h, v0.8h, v2.8h            \n"
+      "uabd       v1.8h, v1.8h, v3.8h            \n"
+      "umull      v4.4s, v0.4h, v0.4h            \n"
+      "umull2     v5.4s, v0.8h, v0.8h            \n"
+      "umull      v6.4s, v1.4h, v1.4h            \n"
+      "umull2     v7.4s, v1.8h, v1.8h            \n"
+      "uadalp     v16.2d, v4.4s                  \n"
+      "uadalp     v17.2d, v5.4s                  \n"
+      "uadalp     v18.2d, v6.4s                  \n"
+      "uadalp     v19.2d, v7.4s                  \n"
+      "b.gt       1b                             \n"
+
+      "add        v16.2d, v16.2d, v17.2d         \n"
+      "add        v18.2d, v18.2d, v19.2d         \n"
+      "add        v19.2d, v16.2d, v18.2d         \n"
+      "addp       d0, v19.2d                     \n"
+      "fmov       %3, d0                         \n"
+      : "+r"(src_a), "+r"(src_b), "+r"(count), "=r"(sse)
+      :
+      : "cc", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v16", "v17",
+        "v18", "v19");
+  return sse;
+}
+
+// Add 16 pixels of a row of a and b to the sums of 4 blocks.
+#define SSIMSUMS4X4ROW_NEON                                       \
+  "ld1        {v0.16b}, [%4], %6                              \n" \
+  "ld1        {v1.16b}, [%5], %7                              \n" \
+  "uaddw      v16.8h, v16.8h, v0.8b                           \n" \
+  "uaddw2     v17.8h, v17.8h, v0.16b                          \n" \
+  "uaddw      v18.8h, v18.8h, v1.8b                           \n" \
+  "uaddw2     v19.8h, v19.8h, v1.16b                          \n" \
+  "umull      v2.8h, v0.8b, v0.8b                             \n" \
+  "umull2     v3.8h, v0.16b, v0.16b                           \n" \
+  "uadalp     v20.4s, v2.8h                                   \n" \
+  "uadalp     v21.4s, v3.8h                                   \n" \
+  "umull      v2.8h, v1.8b, v1.8b                             \n" \
+  "umull2     v3.8h, v1.16b, v1.16b                           \n" \
+  "uadalp     v22.4s, v2.8h                                   \n" \
+  "uadalp     v23.4s, v3.8h                                   \n" \
+  "umull      v2.8h, v0.8b, v1.8b                             \n" \
+  "umull2     v3.8h, v0.16b, v1.16b                           \n" \
+  "uadalp     v24.4s, v2.8h                                   \n" \
+  "uadalp     v25.4s, v3.8h                                   \n"
+
+// Sums of 4 blocks of 4x4 pixels per loop.
+void SsimSums4x4_NEON(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      uint32_t* sums,
+                      int width) {
+  const uint8_t* src_row_a;
+  const uint8_t* src_row_b;
+  asm volatile(
+      "1:                                        \n"
+      "mov        %4, %0                         \n"
+      "mov        %5, %1                         \n"
+      "movi       v16.8h, #0                     \n"
+      "movi       v17.8h, #0                     \n"
+      "movi       v18.8h, #0                     \n"
+      "movi       v19.8h, #0                     \n"
+      "movi       v20.4s, #0                     \n"
+      "movi       v21.4s, #0                     \n"
+      "movi       v22.4s, #0                     \n"
+      "movi       v23.4s, #0                     \n"
+      "movi       v24.4s, #0                     \n"
+      "movi       v25.4s, #0                     \n"
+      SSIMSUMS4X4ROW_NEON
+      SSIMSUMS4X4ROW_NEON
+      SSIMSUMS4X4ROW_NEON
+      SSIMSUMS4X4ROW_NEON
+      "add        %0, %0, #16                    \n"
+      "add        %1, %1, #16                    \n"
+
+      // Add pairs of words, then pairs of dwords, to the sums of blocks.
+      "uaddlp     v16.4s, v16.8h                 \n"
+      "uaddlp     v17.4s, v17.8h                 \n"
+      "uaddlp     v18.4s, v18.8h                 \n"
+      "uaddlp     v19.4s, v19.8h                 \n"
+      "addp       v26.4s, v16.4s, v17.4s         \n"
+      "addp       v27.4s, v18.4s, v19.4s         \n"
+      "addp       v28.4s, v20.4s, v21.4s         \n"
+      "addp       v29.4s, v22.4s, v23.4s         \n"
+      "addp       v30.4s, v24.4s, v25.4s         \n"
+      "subs       %w3, %w3, #16                  \n"
+      "st1        {v26.4s, v27.4s, v28.4s, v29.4s}, [%2], #64 \n"
+      "st1        {v30.4s}, [%2], #16            \n"
+      "b.gt       1b                             \n"
+      : "+r"(src_a),       // %0
+        "+r"(src_b),       // %1
+        "+r"(sums),        // %2
+        "+r"(width),       // %3
+        "=&r"(src_row_a),  // %4
+        "=&r"(src_row_b)   // %5
+      : "r"((intptr_t)(stride_a)),  // %6
+        "r"((intptr_t)(stride_b))   // %7
+      : "memory", "cc", "v0", "v1", "v2", "v3", "v16", "v17", "v18", "v19",
+        "v20", "v21", "v22", "v23", "v24", "v25", "v26", "v27", "v28", "v29",
+        "v30");
+}
+
+// Add 16 pixels of a row of a and b to the sums of 4 blocks. Words are
+// summed in pairs and squares in dwords.
+#define SSIMSUMS4X4ROW_16_NEON                                    \
+  "ld1        {v0.8h, v1.8h}, [%4], %6                        \n" \
+  "ld1        {v2.8h, v3.8h}, [%5], %7                        \n" \
+  "uadalp     v16.4s, v0.8h                                   \n" \
+  "uadalp     v17.4s, v1.8h                                   \n" \
+  "uadalp     v18.4s, v2.8h                                   \n" \
+  "uadalp     v19.4s, v3.8h                                   \n" \
+  "umlal      v20.4s, v0.4h, v0.4h                            \n" \
+  "umlal2     v21.4s, v0.8h, v0.8h                            \n" \
+  "umlal      v22.4s, v1.4h, v1.4h                            \n" \
+  "umlal2     v23.4s, v1.8h, v1.8h                            \n" \
+  "umlal      v24.4s, v2.4h, v2.4h                            \n" \
+  "umlal2     v25.4s, v2.8h, v2.8h                            \n" \
+  "umlal      v26.4s, v3.4h, v3.4h                            \n" \
+  "umlal2     v27.4s, v3.8h, v3.8h                            \n" \
+  "umlal      v28.4s, v0.4h, v2.4h                            \n" \
+  "umlal2     v29.4s, v0.8h, v2.8h                            \n" \
+  "umlal      v30.4s, v1.4h, v3.4h                            \n" \
+  "umlal2     v31.4s, v1.8h, v3.8h                            \n"
+
+// Sums of 4 blocks of 4x4 pixels of up to 12 bits per loop.
+void SsimSums4x4_16_NEON(const uint16_t* src_a,
+                         int stride_a,
+                         const uint16_t* src_b,
+                         int stride_b,
+                         uint32_t* sums,
+                         int width) {
+  const uint16_t* src_row_a;
+  const uint16_t* src_row_b;
+  asm volatile(
+      "1:                                        \n"
+      "mov        %4, %0                         \n"
+      "mov        %5, %1                         \n"
+      "movi       v16.4s, #0                     \n"
+      "movi       v17.4s, #0                     \n"
+      "movi       v18.4s, #0                     \n"
+      "movi       v19.4s, #0                     \n"
+      "movi       v20.4s, #0                     \n"
+      "movi       v21.4s, #0                     \n"
+      "movi       v22.4s, #0                     \n"
+      "movi       v23.4s, #0                     \n"
+      "movi       v24.4s, #0                     \n"
+      "movi       v25.4s, #0                     \n"
+      "movi       v26.4s, #0                     \n"
+      "movi       v27.4s, #0                     \n"
+      "movi       v28.4s, #0                     \n"
+      "movi       v29.4s, #0                     \n"
+      "movi       v30.4s, #0                     \n"
+      "movi       v31.4s, #0                     \n"
+      SSIMSUMS4X4ROW_16_NEON
+      SSIMSUMS4X4ROW_16_NEON
+      SSIMSUMS4X4ROW_16_NEON
+      SSIMSUMS4X4ROW_16_NEON
+      "add        %0, %0, #32                    \n"
+      "add        %1, %1, #32                    \n"
+
+      // Add pairs of words, then pairs of dwords, to the sums of blocks.
+      "addp       v16.4s, v16.4s, v17.4s         \n"
+      "addp       v18.4s, v18.4s, v19.4s         \n"
+      "addp       v20.4s, v20.4s, v21.4s         \n"
+      "addp       v22.4s, v22.4s, v23.4s         \n"
+      "addp       v20.4s, v20.4s, v22.4s         \n"
+      "addp       v24.4s, v24.4s, v25.4s         \n"
+      "addp       v26.4s, v26.4s, v27.4s         \n"
+      "addp       v24.4s, v24.4s, v26.4s         \n"
+      "addp       v28.4s, v28.4s, v29.4s         \n"
+      "addp       v30.4s, v30.4s, v31.4s         \n"
+      "addp       v28.4s, v28.4s, v30.4s         \n"
+      "subs       %w3, %w3, #16                  \n"
+      "st1        {v16.4s}, [%2], #16            \n"
+      "st1        {v18.4s}, [%2], #16            \n"
+      "st1        {v20.4s}, [%2], #16            \n"
+      "st1        {v24.4s}, [%2], #16            \n"
+      "st1        {v28.4s}, [%2], #16            \n"
+      "b.gt       1b                             \n"
+      : "+r"(src_a),       // %0
+        "+r"(src_b),       // %1
+        "+r"(sums),        // %2
+        "+r"(width),       // %3
+        "=&r"(src_row_a),  // %4
+        "=&r"(src_row_b)   // %5
+      : "r"((intptr_t)(stride_a * 2)),  // %6
+        "r"((intptr_t)(stride_b * 2))   // %7
+      : "memory", "cc", "v0", "v1", "v2", "v3", "v16", "v17", "v18", "v19",
+        "v20", "v21", "v22", "v23", "v24", "v25", "v26", "v27", "v28", "v29",
+        "v30", "v31");
+}
+
 #endif  // !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
 
 #ifdef __cplusplus
@@ -10,12 +10,14 @@
 
 #include "libyuv/convert.h"
 
+#include "executor_internal.h"
 #include "libyuv/basic_types.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
 #include "libyuv/row.h"
 #include "libyuv/scale.h"  // For ScalePlane()
+#include "stats_internal.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -192,6 +194,166 @@ int I010ToI420(const uint16_t* src_y,
   return 0;
 }
 
+// Convert P010 to I010.
+LIBYUV_API
+int P010ToI010(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint16_t* dst_y,
+               int dst_stride_y,
+               uint16_t* dst_u,
+               int dst_stride_u,
+               uint16_t* dst_v,
+               int dst_stride_v,
+               int width,
+               int height) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  if (!src_uv || !dst_u || !dst_v || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (height - 1) * src_stride_y;
+    src_uv = src_uv + (halfheight - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+
+  if (dst_y) {
+    ConvertToLSBPlane_16(src_y, src_stride_y, dst_y, dst_stride_y, width,
+                         height, 10);
+  }
+  SplitUVPlane_16(src_uv, src_stride_uv, dst_u, dst_stride_u, dst_v,
+                  dst_stride_v, halfwidth, halfheight, 10);
+  return 0;
+}
+
+// Convert I010 to P010.
+LIBYUV_API
+int I010ToP010(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_u,
+               int src_stride_u,
+               const uint16_t* src_v,
+               int src_stride_v,
+               uint16_t* dst_y,
+               int dst_stride_y,
+               uint16_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  if (!src_u || !src_v || !dst_uv || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (height - 1) * src_stride_y;
+    src_u = src_u + (halfheight - 1) * src_stride_u;
+    src_v = src_v + (halfheight - 1) * src_stride_v;
+    src_stride_y = -src_stride_y;
+    src_stride_u = -src_stride_u;
+    src_stride_v = -src_stride_v;
+  }
+
+  if (dst_y) {
+    ConvertToMSBPlane_16(src_y, src_stride_y, dst_y, dst_stride_y, width,
+                         height, 10);
+  }
+  MergeUVPlane_16(src_u, src_stride_u, src_v, src_stride_v, dst_uv,
+                  dst_stride_uv, halfwidth, halfheight, 10);
+  return 0;
+}
+
+// Round a plane of 16 bit msb data to 8 bits.
+static void Round16To8Plane(const uint16_t* src_y,
+                            int src_stride_y,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            int width,
+                            int height) {
+  int y;
+  void (*Round16To8Row)(const uint16_t* src_y, uint8_t* dst_y, int width) =
+      Round16To8Row_C;
+  // Coalesce rows.
+  if (src_stride_y == width && dst_stride_y == width) {
+    width *= height;
+    height = 1;
+    src_stride_y = dst_stride_y = 0;
+  }
+#if defined(HAS_ROUND16TO8ROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    Round16To8Row = Round16To8Row_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      Round16To8Row = Round16To8Row_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_ROUND16TO8ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    Round16To8Row = Round16To8Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      Round16To8Row = Round16To8Row_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ROUND16TO8ROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    Round16To8Row = Round16To8Row_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      Round16To8Row = Round16To8Row_NEON;
+    }
+  }
+#endif
+  for (y = 0; y < height; ++y) {
+    Round16To8Row(src_y, dst_y, width);
+    src_y += src_stride_y;
+    dst_y += dst_stride_y;
+  }
+}
+
+// Convert P010 to NV12, rounding each sample to the nearest 8 bit value.
+LIBYUV_API
+int P010ToNV12(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  if (!src_uv || !dst_uv || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (height - 1) * src_stride_y;
+    src_uv = src_uv + (halfheight - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+
+  if (dst_y) {
+    Round16To8Plane(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+  }
+  Round16To8Plane(src_uv, src_stride_uv, dst_uv, dst_stride_uv, halfwidth * 2,
+                  halfheight);
+  return 0;
+}
+
 // 422 chroma is 1/2 width, 1x height
 // 420 chroma is 1/2 width, 1/2 height
 LIBYUV_API
@@ -312,6 +474,14 @@ int I422ToNV21(const uint8_t* src_y,
     }
   }
 #endif
+#if defined(HAS_MERGEUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    MergeUVRow = MergeUVRow_Any_AVX512BW;
+    if (IS_ALIGNED(halfwidth, 32)) {
+      MergeUVRow = MergeUVRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_MERGEUVROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     MergeUVRow = MergeUVRow_Any_NEON;
@@ -551,6 +721,11 @@ static void CopyPlane2(const uint8_t* src,
     CopyRow = CopyRow_ERMS;
   }
 #endif
+#if defined(HAS_COPYROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW) && IS_ALIGNED(width, 128)) {
+    CopyRow = CopyRow_AVX512BW;
+  }
+#endif
 #if defined(HAS_COPYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     CopyRow = IS_ALIGNED(width, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
@@ -572,6 +747,24 @@ static void CopyPlane2(const uint8_t* src,
 // Support converting from FOURCC_M420
 // Useful for bandwidth constrained transports like USB 1.0 and 2.0 and for
 // easy conversion to I420.
+// Arguments of X420ToI420 for converting bands of rows with ParallelRows.
+struct X420ToI420Args {
+  const uint8_t* src_y;
+  int src_stride_y0;
+  int src_stride_y1;
+  const uint8_t* src_uv;
+  int src_stride_uv;
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+  int width;
+};
+
+static void X420ToI420Rows(void* arg, int begin, int end);
+
 // M420 format description:
 // M420 is row biplanar 420: 2 rows of Y and 1 row of UV.
 // Chroma is half width / half height. (420)
@@ -609,6 +802,15 @@ static int X420ToI420(const uint8_t* src_y,
     dst_stride_u = -dst_stride_u;
     dst_stride_v = -dst_stride_v;
   }
+  {
+    X420ToI420Args args = {src_y,        src_stride_y0, src_stride_y1,
+                           src_uv,       src_stride_uv, dst_y,
+                           dst_stride_y, dst_u,         dst_stride_u,
+                           dst_v,        dst_stride_v,  width};
+    if (ParallelRows(width, height, 2, X420ToI420Rows, &args) == 0) {
+      return 0;
+    }
+  }
   // Coalesce rows.
   if (src_stride_y0 == width && src_stride_y1 == width &&
       dst_stride_y == width) {
@@ -640,6 +842,20 @@ static int X420ToI420(const uint8_t* src_y,
   return 0;
 }
 
+// Rows are in pairs so the Y stride alternates from src_stride_y0.
+static void X420ToI420Rows(void* arg, int begin, int end) {
+  const X420ToI420Args* a = static_cast<const X420ToI420Args*>(arg);
+  int uv_begin = begin >> 1;
+  X420ToI420(
+      a->src_y + uv_begin * (intptr_t)(a->src_stride_y0 + a->src_stride_y1),
+      a->src_stride_y0, a->src_stride_y1,
+      a->src_uv + uv_begin * (intptr_t)a->src_stride_uv, a->src_stride_uv,
+      a->dst_y ? a->dst_y + begin * (intptr_t)a->dst_stride_y : NULL,
+      a->dst_stride_y, a->dst_u + uv_begin * (intptr_t)a->dst_stride_u,
+      a->dst_stride_u, a->dst_v + uv_begin * (intptr_t)a->dst_stride_v,
+      a->dst_stride_v, a->width, end - begin);
+}
+
 // Convert NV12 to I420.
 LIBYUV_API
 int NV12ToI420(const uint8_t* src_y,
@@ -1018,6 +1234,30 @@ int AYUVToNV21(const uint8_t* src_ayuv,
   return 0;
 }
 
+// Arguments of ARGBToI420 for converting bands of rows with ParallelRows.
+struct ARGBToI420Args {
+  const uint8_t* src_argb;
+  int src_stride_argb;
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+  int width;
+};
+
+static void ARGBToI420Rows(void* arg, int begin, int end) {
+  const ARGBToI420Args* a = static_cast<const ARGBToI420Args*>(arg);
+  ARGBToI420(a->src_argb + begin * (intptr_t)a->src_stride_argb,
+             a->src_stride_argb, a->dst_y + begin * (intptr_t)a->dst_stride_y,
+             a->dst_stride_y,
+             a->dst_u + (begin >> 1) * (intptr_t)a->dst_stride_u,
+             a->dst_stride_u,
+             a->dst_v + (begin >> 1) * (intptr_t)a->dst_stride_v,
+             a->dst_stride_v, a->width, end - begin);
+}
+
 // Convert ARGB to I420.
 LIBYUV_API
 int ARGBToI420(const uint8_t* src_argb,
@@ -1045,6 +1285,14 @@ int ARGBToI420(const uint8_t* src_argb,
     src_argb = src_argb + (height - 1) * src_stride_argb;
     src_stride_argb = -src_stride_argb;
   }
+  {
+    ARGBToI420Args args = {src_argb,     src_stride_argb, dst_y,
+                           dst_stride_y, dst_u,           dst_stride_u,
+                           dst_v,        dst_stride_v,    width};
+    if (ParallelRows(width, height, 2, ARGBToI420Rows, &args) == 0) {
+      return 0;
+    }
+  }
 #if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     ARGBToUVRow = ARGBToUVRow_Any_SSSE3;
@@ -1065,6 +1313,16 @@ int ARGBToI420(const uint8_t* src_argb,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_ARGBTOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     ARGBToYRow = ARGBToYRow_Any_NEON;
@@ -1114,19 +1372,28 @@ int ARGBToI420(const uint8_t* src_argb,
   }
 #endif
 
+  LIBYUV_STATS_BEGIN(stats_start);
+  LIBYUV_STATS_ROW_DECLARE(stats_y);
+  LIBYUV_STATS_ROW_DECLARE(stats_uv);
   for (y = 0; y < height - 1; y += 2) {
-    ARGBToUVRow(src_argb, src_stride_argb, dst_u, dst_v, width);
-    ARGBToYRow(src_argb, dst_y, width);
-    ARGBToYRow(src_argb + src_stride_argb, dst_y + dst_stride_y, width);
+    LIBYUV_STATS_ROW(stats_uv, ARGBToUVRow(src_argb, src_stride_argb, dst_u,
+                                           dst_v, width));
+    LIBYUV_STATS_ROW(stats_y, ARGBToYRow(src_argb, dst_y, width));
+    LIBYUV_STATS_ROW(stats_y, ARGBToYRow(src_argb + src_stride_argb,
+                                         dst_y + dst_stride_y, width));
     src_argb += src_stride_argb * 2;
     dst_y += dst_stride_y * 2;
     dst_u += dst_stride_u;
     dst_v += dst_stride_v;
   }
   if (height & 1) {
-    ARGBToUVRow(src_argb, 0, dst_u, dst_v, width);
-    ARGBToYRow(src_argb, dst_y, width);
+    LIBYUV_STATS_ROW(stats_uv, ARGBToUVRow(src_argb, 0, dst_u, dst_v, width));
+    LIBYUV_STATS_ROW(stats_y, ARGBToYRow(src_argb, dst_y, width));
   }
+  LIBYUV_STATS_ROW_RECORD(stats_y, kStatsARGBToYRow, ARGBToYRow, width);
+  LIBYUV_STATS_ROW_RECORD(stats_uv, kStatsARGBToUVRow, ARGBToUVRow,
+                          (width + 1) >> 1);
+  LIBYUV_STATS_END(stats_start, kStatsARGBToI420, (uint64_t)width * height);
   return 0;
 }
 
@@ -1537,6 +1804,16 @@ int RGB24ToI420(const uint8_t* src_rgb24,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #endif
 
   {
@@ -1684,6 +1961,16 @@ int RAWToI420(const uint8_t* src_raw,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #endif
 
   {
@@ -1840,6 +2127,16 @@ int RGB565ToI420(const uint8_t* src_rgb565,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #endif
   {
 #if !(defined(HAS_RGB565TOYROW_NEON) || defined(HAS_RGB565TOYROW_MSA) || \
@@ -1995,6 +2292,16 @@ int ARGB1555ToI420(const uint8_t* src_argb1555,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #endif
   {
 #if !(defined(HAS_ARGB1555TOYROW_NEON) || defined(HAS_ARGB1555TOYROW_MSA) || \
@@ -2151,6 +2458,16 @@ int ARGB4444ToI420(const uint8_t* src_argb4444,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_ARGBTOYROW_MSA)
   if (TestCpuFlag(kCpuHasMSA)) {
     ARGBToUVRow = ARGBToUVRow_Any_MSA;
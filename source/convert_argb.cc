@@ -10,6 +10,7 @@
 
 #include "libyuv/convert_argb.h"
 
+#include "executor_internal.h"
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
@@ -18,6 +19,7 @@
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
 #include "libyuv/video_common.h"
+#include "stats_internal.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -47,18 +49,126 @@ int ARGBCopy(const uint8_t* src_argb,
   return 0;
 }
 
-// Convert I420 to ARGB with matrix
-static int I420ToARGBMatrix(const uint8_t* src_y,
+// Planar YUV to ARGB conversion, split into bands of rows by ParallelRows.
+typedef int (*YUVToARGBMatrixFunc)(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint8_t* dst_argb,
+                                   int dst_stride_argb,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width,
+                                   int height);
+
+struct YUVToARGBArgs {
+  YUVToARGBMatrixFunc convert;
+  const uint8_t* src_y;
+  int src_stride_y;
+  const uint8_t* src_u;
+  int src_stride_u;
+  const uint8_t* src_v;
+  int src_stride_v;
+  uint8_t* dst_argb;
+  int dst_stride_argb;
+  const struct YuvConstants* yuvconstants;
+  int width;
+  int uv_shift;  // 1 if UV is vertically subsampled.
+};
+
+static void YUVToARGBRows(void* arg, int begin, int end) {
+  const YUVToARGBArgs* a = static_cast<const YUVToARGBArgs*>(arg);
+  int uv_begin = begin >> a->uv_shift;
+  a->convert(a->src_y + begin * (intptr_t)a->src_stride_y, a->src_stride_y,
+             a->src_u + uv_begin * (intptr_t)a->src_stride_u, a->src_stride_u,
+             a->src_v + uv_begin * (intptr_t)a->src_stride_v, a->src_stride_v,
+             a->dst_argb + begin * (intptr_t)a->dst_stride_argb,
+             a->dst_stride_argb, a->yuvconstants, a->width, end - begin);
+}
+
+// Returns 0 if the executor of the calling thread did the conversion.
+static int ParallelYUVToARGB(YUVToARGBMatrixFunc convert,
+                             const uint8_t* src_y,
+                             int src_stride_y,
+                             const uint8_t* src_u,
+                             int src_stride_u,
+                             const uint8_t* src_v,
+                             int src_stride_v,
+                             uint8_t* dst_argb,
+                             int dst_stride_argb,
+                             const struct YuvConstants* yuvconstants,
+                             int width,
+                             int height,
+                             int uv_shift) {
+  YUVToARGBArgs args = {convert,         src_y,        src_stride_y,
+                        src_u,           src_stride_u, src_v,
+                        src_stride_v,    dst_argb,     dst_stride_argb,
+                        yuvconstants,    width,        uv_shift};
+  return ParallelRows(width, height, 1 << uv_shift, YUVToARGBRows, &args);
+}
+
+// Biplanar YUV to ARGB conversion, split into bands of rows by ParallelRows.
+typedef int (*NVToARGBMatrixFunc)(const uint8_t* src_y,
+                                  int src_stride_y,
+                                  const uint8_t* src_uv,
+                                  int src_stride_uv,
+                                  uint8_t* dst_argb,
+                                  int dst_stride_argb,
+                                  const struct YuvConstants* yuvconstants,
+                                  int width,
+                                  int height);
+
+struct NVToARGBArgs {
+  NVToARGBMatrixFunc convert;
+  const uint8_t* src_y;
+  int src_stride_y;
+  const uint8_t* src_uv;
+  int src_stride_uv;
+  uint8_t* dst_argb;
+  int dst_stride_argb;
+  const struct YuvConstants* yuvconstants;
+  int width;
+};
+
+static void NVToARGBRows(void* arg, int begin, int end) {
+  const NVToARGBArgs* a = static_cast<const NVToARGBArgs*>(arg);
+  a->convert(a->src_y + begin * (intptr_t)a->src_stride_y, a->src_stride_y,
+             a->src_uv + (begin >> 1) * (intptr_t)a->src_stride_uv,
+             a->src_stride_uv,
+             a->dst_argb + begin * (intptr_t)a->dst_stride_argb,
+             a->dst_stride_argb, a->yuvconstants, a->width, end - begin);
+}
+
+static int ParallelNVToARGB(NVToARGBMatrixFunc convert,
+                            const uint8_t* src_y,
                             int src_stride_y,
-                            const uint8_t* src_u,
-                            int src_stride_u,
-                            const uint8_t* src_v,
-                            int src_stride_v,
+                            const uint8_t* src_uv,
+                            int src_stride_uv,
                             uint8_t* dst_argb,
                             int dst_stride_argb,
                             const struct YuvConstants* yuvconstants,
                             int width,
                             int height) {
+  NVToARGBArgs args = {convert,         src_y,        src_stride_y,
+                       src_uv,          src_stride_uv, dst_argb,
+                       dst_stride_argb, yuvconstants, width};
+  return ParallelRows(width, height, 2, NVToARGBRows, &args);
+}
+
+// Convert I420 to ARGB with matrix
+LIBYUV_API
+int I420ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*I422ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -73,6 +183,12 @@ static int I420ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
+  if (ParallelYUVToARGB(I420ToARGBMatrix, src_y, src_stride_y, src_u,
+                        src_stride_u, src_v, src_stride_v, dst_argb,
+                        dst_stride_argb, yuvconstants, width, height,
+                        1) == 0) {
+    return 0;
+  }
 #if defined(HAS_I422TOARGBROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
@@ -89,6 +205,14 @@ static int I420ToARGBMatrix(const uint8_t* src_y,
     }
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_I422TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     I422ToARGBRow = I422ToARGBRow_Any_NEON;
@@ -106,8 +230,11 @@ static int I420ToARGBMatrix(const uint8_t* src_y,
   }
 #endif
 
+  LIBYUV_STATS_BEGIN(stats_start);
+  LIBYUV_STATS_ROW_DECLARE(stats_row);
   for (y = 0; y < height; ++y) {
-    I422ToARGBRow(src_y, src_u, src_v, dst_argb, yuvconstants, width);
+    LIBYUV_STATS_ROW(stats_row, I422ToARGBRow(src_y, src_u, src_v, dst_argb,
+                                              yuvconstants, width));
     dst_argb += dst_stride_argb;
     src_y += src_stride_y;
     if (y & 1) {
@@ -115,6 +242,10 @@ static int I420ToARGBMatrix(const uint8_t* src_y,
       src_v += src_stride_v;
     }
   }
+  LIBYUV_STATS_ROW_RECORD(stats_row, kStatsI422ToARGBRow, I422ToARGBRow,
+                          width);
+  LIBYUV_STATS_END(stats_start, kStatsI420ToARGBMatrix,
+                   (uint64_t)width * height);
   return 0;
 }
 
@@ -227,17 +358,18 @@ int H420ToABGR(const uint8_t* src_y,
 }
 
 // Convert I422 to ARGB with matrix
-static int I422ToARGBMatrix(const uint8_t* src_y,
-                            int src_stride_y,
-                            const uint8_t* src_u,
-                            int src_stride_u,
-                            const uint8_t* src_v,
-                            int src_stride_v,
-                            uint8_t* dst_argb,
-                            int dst_stride_argb,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int I422ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*I422ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -252,6 +384,12 @@ static int I422ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
+  if (ParallelYUVToARGB(I422ToARGBMatrix, src_y, src_stride_y, src_u,
+                        src_stride_u, src_v, src_stride_v, dst_argb,
+                        dst_stride_argb, yuvconstants, width, height,
+                        0) == 0) {
+    return 0;
+  }
   // Coalesce rows.
   if (src_stride_y == width && src_stride_u * 2 == width &&
       src_stride_v * 2 == width && dst_stride_argb == width * 4) {
@@ -275,6 +413,14 @@ static int I422ToARGBMatrix(const uint8_t* src_y,
     }
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_I422TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     I422ToARGBRow = I422ToARGBRow_Any_NEON;
@@ -413,17 +559,18 @@ int H422ToABGR(const uint8_t* src_y,
 // Convert 10 bit YUV to ARGB with matrix
 // TODO(fbarchard): Consider passing scale multiplier to I210ToARGB to
 // multiply 10 bit yuv into high bits to allow any number of bits.
-static int I010ToAR30Matrix(const uint16_t* src_y,
-                            int src_stride_y,
-                            const uint16_t* src_u,
-                            int src_stride_u,
-                            const uint16_t* src_v,
-                            int src_stride_v,
-                            uint8_t* dst_ar30,
-                            int dst_stride_ar30,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int I010ToAR30Matrix(const uint16_t* src_y,
+                     int src_stride_y,
+                     const uint16_t* src_u,
+                     int src_stride_u,
+                     const uint16_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_ar30,
+                     int dst_stride_ar30,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*I210ToAR30Row)(const uint16_t* y_buf, const uint16_t* u_buf,
                         const uint16_t* v_buf, uint8_t* rgb_buf,
@@ -535,17 +682,18 @@ int H010ToAB30(const uint16_t* src_y,
 }
 
 // Convert 10 bit YUV to ARGB with matrix
-static int I010ToARGBMatrix(const uint16_t* src_y,
-                            int src_stride_y,
-                            const uint16_t* src_u,
-                            int src_stride_u,
-                            const uint16_t* src_v,
-                            int src_stride_v,
-                            uint8_t* dst_argb,
-                            int dst_stride_argb,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int I010ToARGBMatrix(const uint16_t* src_y,
+                     int src_stride_y,
+                     const uint16_t* src_u,
+                     int src_stride_u,
+                     const uint16_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*I210ToARGBRow)(const uint16_t* y_buf, const uint16_t* u_buf,
                         const uint16_t* v_buf, uint8_t* rgb_buf,
@@ -660,18 +808,169 @@ int H010ToABGR(const uint16_t* src_y,
                           width, height);
 }
 
+// Convert P010 to ARGB with matrix
+LIBYUV_API
+int P010ToARGBMatrix(const uint16_t* src_y,
+                     int src_stride_y,
+                     const uint16_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
+  int y;
+  void (*P210ToARGBRow)(const uint16_t* y_buf, const uint16_t* uv_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants, int width) =
+      P210ToARGBRow_C;
+  if (!src_y || !src_uv || !dst_argb || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+#if defined(HAS_P210TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    P210ToARGBRow = P210ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 8)) {
+      P210ToARGBRow = P210ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_P210TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    P210ToARGBRow = P210ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      P210ToARGBRow = P210ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_P210TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    P210ToARGBRow = P210ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      P210ToARGBRow = P210ToARGBRow_NEON;
+    }
+  }
+#endif
+  for (y = 0; y < height; ++y) {
+    P210ToARGBRow(src_y, src_uv, dst_argb, yuvconstants, width);
+    dst_argb += dst_stride_argb;
+    src_y += src_stride_y;
+    if (y & 1) {
+      src_uv += src_stride_uv;
+    }
+  }
+  return 0;
+}
+
+// Convert P010 to AR30 with matrix
+LIBYUV_API
+int P010ToAR30Matrix(const uint16_t* src_y,
+                     int src_stride_y,
+                     const uint16_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_ar30,
+                     int dst_stride_ar30,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
+  int y;
+  void (*P210ToAR30Row)(const uint16_t* y_buf, const uint16_t* uv_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants, int width) =
+      P210ToAR30Row_C;
+  if (!src_y || !src_uv || !dst_ar30 || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_ar30 = dst_ar30 + (height - 1) * dst_stride_ar30;
+    dst_stride_ar30 = -dst_stride_ar30;
+  }
+#if defined(HAS_P210TOAR30ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    P210ToAR30Row = P210ToAR30Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 8)) {
+      P210ToAR30Row = P210ToAR30Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_P210TOAR30ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    P210ToAR30Row = P210ToAR30Row_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      P210ToAR30Row = P210ToAR30Row_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_P210TOAR30ROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    P210ToAR30Row = P210ToAR30Row_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      P210ToAR30Row = P210ToAR30Row_NEON;
+    }
+  }
+#endif
+  for (y = 0; y < height; ++y) {
+    P210ToAR30Row(src_y, src_uv, dst_ar30, yuvconstants, width);
+    dst_ar30 += dst_stride_ar30;
+    src_y += src_stride_y;
+    if (y & 1) {
+      src_uv += src_stride_uv;
+    }
+  }
+  return 0;
+}
+
+// Convert P010 to ARGB.
+LIBYUV_API
+int P010ToARGB(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_argb,
+               int dst_stride_argb,
+               int width,
+               int height) {
+  return P010ToARGBMatrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                          dst_argb, dst_stride_argb, &kYuvI601Constants, width,
+                          height);
+}
+
+// Convert P010 to AR30.
+LIBYUV_API
+int P010ToAR30(const uint16_t* src_y,
+               int src_stride_y,
+               const uint16_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_ar30,
+               int dst_stride_ar30,
+               int width,
+               int height) {
+  return P010ToAR30Matrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                          dst_ar30, dst_stride_ar30, &kYuvI601Constants, width,
+                          height);
+}
+
 // Convert I444 to ARGB with matrix
-static int I444ToARGBMatrix(const uint8_t* src_y,
-                            int src_stride_y,
-                            const uint8_t* src_u,
-                            int src_stride_u,
-                            const uint8_t* src_v,
-                            int src_stride_v,
-                            uint8_t* dst_argb,
-                            int dst_stride_argb,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int I444ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*I444ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -686,6 +985,12 @@ static int I444ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
+  if (ParallelYUVToARGB(I444ToARGBMatrix, src_y, src_stride_y, src_u,
+                        src_stride_u, src_v, src_stride_v, dst_argb,
+                        dst_stride_argb, yuvconstants, width, height,
+                        0) == 0) {
+    return 0;
+  }
   // Coalesce rows.
   if (src_stride_y == width && src_stride_u == width && src_stride_v == width &&
       dst_stride_argb == width * 4) {
@@ -790,20 +1095,21 @@ int J444ToARGB(const uint8_t* src_y,
 }
 
 // Convert I420 with Alpha to preattenuated ARGB.
-static int I420AlphaToARGBMatrix(const uint8_t* src_y,
-                                 int src_stride_y,
-                                 const uint8_t* src_u,
-                                 int src_stride_u,
-                                 const uint8_t* src_v,
-                                 int src_stride_v,
-                                 const uint8_t* src_a,
-                                 int src_stride_a,
-                                 uint8_t* dst_argb,
-                                 int dst_stride_argb,
-                                 const struct YuvConstants* yuvconstants,
-                                 int width,
-                                 int height,
-                                 int attenuate) {
+LIBYUV_API
+int I420AlphaToARGBMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          const uint8_t* src_a,
+                          int src_stride_a,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int width,
+                          int height,
+                          int attenuate) {
   int y;
   void (*I422AlphaToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                              const uint8_t* v_buf, const uint8_t* a_buf,
@@ -1631,15 +1937,16 @@ int AR30ToAB30(const uint8_t* src_ar30,
 }
 
 // Convert NV12 to ARGB with matrix
-static int NV12ToARGBMatrix(const uint8_t* src_y,
-                            int src_stride_y,
-                            const uint8_t* src_uv,
-                            int src_stride_uv,
-                            uint8_t* dst_argb,
-                            int dst_stride_argb,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int NV12ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*NV12ToARGBRow)(
       const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
@@ -1653,6 +1960,11 @@ static int NV12ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
+  if (ParallelNVToARGB(NV12ToARGBMatrix, src_y, src_stride_y, src_uv,
+                       src_stride_uv, dst_argb, dst_stride_argb,
+                       yuvconstants, width, height) == 0) {
+    return 0;
+  }
 #if defined(HAS_NV12TOARGBROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
@@ -1669,6 +1981,14 @@ static int NV12ToARGBMatrix(const uint8_t* src_y,
     }
   }
 #endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_NV12TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
@@ -1698,15 +2018,16 @@ static int NV12ToARGBMatrix(const uint8_t* src_y,
 }
 
 // Convert NV21 to ARGB with matrix
-static int NV21ToARGBMatrix(const uint8_t* src_y,
-                            int src_stride_y,
-                            const uint8_t* src_vu,
-                            int src_stride_vu,
-                            uint8_t* dst_argb,
-                            int dst_stride_argb,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int NV21ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_vu,
+                     int src_stride_vu,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*NV21ToARGBRow)(
       const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
@@ -1720,6 +2041,11 @@ static int NV21ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
+  if (ParallelNVToARGB(NV21ToARGBMatrix, src_y, src_stride_y, src_vu,
+                       src_stride_vu, dst_argb, dst_stride_argb,
+                       yuvconstants, width, height) == 0) {
+    return 0;
+  }
 #if defined(HAS_NV21TOARGBROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     NV21ToARGBRow = NV21ToARGBRow_Any_SSSE3;
@@ -1823,15 +2149,16 @@ int NV21ToABGR(const uint8_t* src_y,
 
 // TODO(fbarchard): Consider SSSE3 2 step conversion.
 // Convert NV12 to RGB24 with matrix
-static int NV12ToRGB24Matrix(const uint8_t* src_y,
-                             int src_stride_y,
-                             const uint8_t* src_uv,
-                             int src_stride_uv,
-                             uint8_t* dst_rgb24,
-                             int dst_stride_rgb24,
-                             const struct YuvConstants* yuvconstants,
-                             int width,
-                             int height) {
+LIBYUV_API
+int NV12ToRGB24Matrix(const uint8_t* src_y,
+                      int src_stride_y,
+                      const uint8_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_rgb24,
+                      int dst_stride_rgb24,
+                      const struct YuvConstants* yuvconstants,
+                      int width,
+                      int height) {
   int y;
   void (*NV12ToRGB24Row)(
       const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
@@ -1882,15 +2209,16 @@ static int NV12ToRGB24Matrix(const uint8_t* src_y,
 }
 
 // Convert NV21 to RGB24 with matrix
-static int NV21ToRGB24Matrix(const uint8_t* src_y,
-                             int src_stride_y,
-                             const uint8_t* src_vu,
-                             int src_stride_vu,
-                             uint8_t* dst_rgb24,
-                             int dst_stride_rgb24,
-                             const struct YuvConstants* yuvconstants,
-                             int width,
-                             int height) {
+LIBYUV_API
+int NV21ToRGB24Matrix(const uint8_t* src_y,
+                      int src_stride_y,
+                      const uint8_t* src_vu,
+                      int src_stride_vu,
+                      uint8_t* dst_rgb24,
+                      int dst_stride_rgb24,
+                      const struct YuvConstants* yuvconstants,
+                      int width,
+                      int height) {
   int y;
   void (*NV21ToRGB24Row)(
       const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
@@ -2083,6 +2411,14 @@ int M420ToARGB(const uint8_t* src_m420,
     }
   }
 #endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_NV12TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
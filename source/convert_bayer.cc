@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+
+#include "executor_internal.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/row.h"
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Returns the kind of the first row of a Bayer fourcc for BayerRowToARGBRow,
+// or -1 if the fourcc is not Bayer.
+static int BayerFirstRow(uint32_t fourcc) {
+  switch (CanonicalFourCC(fourcc)) {
+    case FOURCC_RGGB:
+      return 0;
+    case FOURCC_GRBG:
+      return 1;
+    case FOURCC_BGGR:
+      return 2;
+    case FOURCC_GBRG:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+typedef void (*BayerRowToARGBRowFunc)(const uint8_t* src_bayer0,
+                                      const uint8_t* src_bayer1,
+                                      const uint8_t* src_bayer2,
+                                      uint8_t* dst_argb,
+                                      int bayer_row,
+                                      int width);
+
+static BayerRowToARGBRowFunc GetBayerRowToARGBRow(int width) {
+  // The row function does the pixels between the first and the last.
+  BayerRowToARGBRowFunc BayerRowToARGBRow = BayerRowToARGBRow_C;
+#if defined(HAS_BAYERROWTOARGBROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    BayerRowToARGBRow = BayerRowToARGBRow_Any_SSE2;
+    if (IS_ALIGNED(width - 2, 16)) {
+      BayerRowToARGBRow = BayerRowToARGBRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_BAYERROWTOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    BayerRowToARGBRow = BayerRowToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width - 2, 32)) {
+      BayerRowToARGBRow = BayerRowToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_BAYERROWTOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    BayerRowToARGBRow = BayerRowToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width - 2, 16)) {
+      BayerRowToARGBRow = BayerRowToARGBRow_NEON;
+    }
+  }
+#endif
+  return BayerRowToARGBRow;
+}
+
+// Demosaic row y of a Bayer image.  The rows above the first and below the
+// last are mirrored from the same color 1 row inside, like the pixels left
+// and right of a row.
+static void BayerToARGBImageRow(BayerRowToARGBRowFunc BayerRowToARGBRow,
+                                const uint8_t* src_bayer,
+                                int src_stride_bayer,
+                                uint8_t* dst_argb,
+                                int width,
+                                int height,
+                                int first_row,
+                                int y) {
+  const uint8_t* src_bayer1 = src_bayer + y * (intptr_t)src_stride_bayer;
+  const uint8_t* src_bayer0 = src_bayer1 - src_stride_bayer;
+  const uint8_t* src_bayer2 = src_bayer1 + src_stride_bayer;
+  // Odd rows swap green with the other color.
+  int bayer_row = first_row ^ ((y & 1) * 3);
+  if (height == 1) {
+    src_bayer0 = src_bayer2 = src_bayer1;
+  } else if (y == 0) {
+    src_bayer0 = src_bayer2;
+  } else if (y == height - 1) {
+    src_bayer2 = src_bayer0;
+  }
+  BayerEdgesToARGBRow_C(src_bayer0, src_bayer1, src_bayer2, dst_argb,
+                        bayer_row, width);
+  if (width > 2) {
+    // The second pixel is the other color of the row.
+    BayerRowToARGBRow(src_bayer0 + 1, src_bayer1 + 1, src_bayer2 + 1,
+                      dst_argb + 4, bayer_row ^ 1, width - 2);
+  }
+}
+
+// Arguments of BayerToARGB and BayerToI420 for converting bands of rows with
+// ParallelRows.  Rows are relative to the whole image, as the first and last
+// row of a band read the rows next to it.
+struct BayerArgs {
+  const uint8_t* src_bayer;
+  int src_stride_bayer;
+  uint8_t* dst_argb;
+  int dst_stride_argb;
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+  int width;
+  int height;
+  int first_row;
+};
+
+static void BayerToARGBRows(void* arg, int begin, int end) {
+  const BayerArgs* a = static_cast<const BayerArgs*>(arg);
+  BayerRowToARGBRowFunc BayerRowToARGBRow = GetBayerRowToARGBRow(a->width);
+  int y;
+  for (y = begin; y < end; ++y) {
+    BayerToARGBImageRow(BayerRowToARGBRow, a->src_bayer, a->src_stride_bayer,
+                        a->dst_argb + y * (intptr_t)a->dst_stride_argb,
+                        a->width, a->height, a->first_row, y);
+  }
+}
+
+// Convert Bayer to ARGB.
+LIBYUV_API
+int BayerToARGB(const uint8_t* src_bayer,
+                int src_stride_bayer,
+                uint8_t* dst_argb,
+                int dst_stride_argb,
+                int width,
+                int height,
+                uint32_t fourcc) {
+  int first_row = BayerFirstRow(fourcc);
+  if (!src_bayer || !dst_argb || width <= 0 || height == 0 || first_row < 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+  {
+    BayerArgs args = {src_bayer, src_stride_bayer, dst_argb, dst_stride_argb,
+                      NULL,      0,                NULL,     0,
+                      NULL,      0,                width,    height,
+                      first_row};
+    if (ParallelRows(width, height, 1, BayerToARGBRows, &args) != 0) {
+      BayerToARGBRows(&args, 0, height);
+    }
+  }
+  return 0;
+}
+
+static void BayerToI420Rows(void* arg, int begin, int end) {
+  const BayerArgs* a = static_cast<const BayerArgs*>(arg);
+  BayerRowToARGBRowFunc BayerRowToARGBRow = GetBayerRowToARGBRow(a->width);
+  int width = a->width;
+  uint8_t* dst_y = a->dst_y + begin * (intptr_t)a->dst_stride_y;
+  uint8_t* dst_u = a->dst_u + (begin >> 1) * (intptr_t)a->dst_stride_u;
+  uint8_t* dst_v = a->dst_v + (begin >> 1) * (intptr_t)a->dst_stride_v;
+  int y;
+  void (*ARGBToUVRow)(const uint8_t* src_argb0, int src_stride_argb,
+                      uint8_t* dst_u, uint8_t* dst_v, int width) =
+      ARGBToUVRow_C;
+  void (*ARGBToYRow)(const uint8_t* src_argb, uint8_t* dst_y, int width) =
+      ARGBToYRow_C;
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToUVRow = ARGBToUVRow_Any_SSSE3;
+    ARGBToYRow = ARGBToYRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToUVRow = ARGBToUVRow_SSSE3;
+      ARGBToYRow = ARGBToYRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX2;
+    ARGBToYRow = ARGBToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX2;
+      ARGBToYRow = ARGBToYRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToYRow = ARGBToYRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToYRow = ARGBToYRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToUVRow = ARGBToUVRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToUVRow = ARGBToUVRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    ARGBToYRow = ARGBToYRow_Any_MSA;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToYRow = ARGBToYRow_MSA;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOUVROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    ARGBToUVRow = ARGBToUVRow_Any_MSA;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_MSA;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    ARGBToYRow = ARGBToYRow_Any_MMI;
+    if (IS_ALIGNED(width, 8)) {
+      ARGBToYRow = ARGBToYRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOUVROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    ARGBToUVRow = ARGBToUVRow_Any_MMI;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToUVRow = ARGBToUVRow_MMI;
+    }
+  }
+#endif
+
+  {
+    // Allocate 2 rows of ARGB.
+    const int kRowSize = (width * 4 + 31) & ~31;
+    align_buffer_64(row, kRowSize * 2);
+
+    for (y = begin; y < end - 1; y += 2) {
+      BayerToARGBImageRow(BayerRowToARGBRow, a->src_bayer, a->src_stride_bayer,
+                          row, width, a->height, a->first_row, y);
+      BayerToARGBImageRow(BayerRowToARGBRow, a->src_bayer, a->src_stride_bayer,
+                          row + kRowSize, width, a->height, a->first_row,
+                          y + 1);
+      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+      ARGBToYRow(row, dst_y, width);
+      ARGBToYRow(row + kRowSize, dst_y + a->dst_stride_y, width);
+      dst_y += a->dst_stride_y * 2;
+      dst_u += a->dst_stride_u;
+      dst_v += a->dst_stride_v;
+    }
+    if (y < end) {
+      BayerToARGBImageRow(BayerRowToARGBRow, a->src_bayer, a->src_stride_bayer,
+                          row, width, a->height, a->first_row, y);
+      ARGBToUVRow(row, 0, dst_u, dst_v, width);
+      ARGBToYRow(row, dst_y, width);
+    }
+    free_aligned_buffer_64(row);
+  }
+}
+
+// Convert Bayer to I420.  Rows are demosaiced into a 2 row ARGB buffer.
+LIBYUV_API
+int BayerToI420(const uint8_t* src_bayer,
+                int src_stride_bayer,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_u,
+                int dst_stride_u,
+                uint8_t* dst_v,
+                int dst_stride_v,
+                int width,
+                int height,
+                uint32_t fourcc) {
+  int first_row = BayerFirstRow(fourcc);
+  if (!src_bayer || !dst_y || !dst_u || !dst_v || width <= 0 || height == 0 ||
+      first_row < 0) {
+    return -1;
+  }
+  // Negative height means invert the image.  The first row read is then the
+  // last row of the Bayer pattern.
+  if (height < 0) {
+    height = -height;
+    src_bayer = src_bayer + (height - 1) * src_stride_bayer;
+    src_stride_bayer = -src_stride_bayer;
+    first_row ^= ((height - 1) & 1) * 3;
+  }
+  {
+    BayerArgs args = {src_bayer, src_stride_bayer, NULL,  0,
+                      dst_y,     dst_stride_y,     dst_u, dst_stride_u,
+                      dst_v,     dst_stride_v,     width, height,
+                      first_row};
+    if (ParallelRows(width, height, 2, BayerToI420Rows, &args) != 0) {
+      BayerToI420Rows(&args, 0, height);
+    }
+  }
+  return 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -13,6 +13,9 @@
 
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/row.h"
+#include "libyuv/scale.h"
 #endif
 
 #ifdef __cplusplus
@@ -460,6 +463,264 @@ int MJPGToARGB(const uint8_t* src_mjpg,
   return ret ? 0 : 1;
 }
 
+// Largest scale of the DCT that decodes at least dst_width x dst_height.
+static int MJpegScaleDenom(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height) {
+  int scale_denom = 8;
+  while (scale_denom > 1 &&
+         ((src_width + scale_denom - 1) / scale_denom < dst_width ||
+          (src_height + scale_denom - 1) / scale_denom < dst_height)) {
+    scale_denom >>= 1;
+  }
+  return scale_denom;
+}
+
+// Decode a scaled frame with the callback for its subsampling. Scaling may
+// decode chroma with less subsampling than the frame has, so the decoded
+// subsampling is checked rather than the sample factors.
+static LIBYUV_BOOL MJpegDecodeScaled(MJpegDecoder* mjpeg_decoder,
+                                     MJpegDecoder::CallbackFunction fn420,
+                                     MJpegDecoder::CallbackFunction fn422,
+                                     MJpegDecoder::CallbackFunction fn444,
+                                     MJpegDecoder::CallbackFunction fn400,
+                                     void* opaque) {
+  const int width = mjpeg_decoder->GetWidth();
+  const int height = mjpeg_decoder->GetHeight();
+  if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+      mjpeg_decoder->GetNumComponents() == 3 &&
+      mjpeg_decoder->GetHorizSubSampFactor(0) == 1 &&
+      mjpeg_decoder->GetVertSubSampFactor(0) == 1 &&
+      mjpeg_decoder->GetHorizSubSampFactor(1) ==
+          mjpeg_decoder->GetHorizSubSampFactor(2) &&
+      mjpeg_decoder->GetVertSubSampFactor(1) ==
+          mjpeg_decoder->GetVertSubSampFactor(2)) {
+    const int subsample_x = mjpeg_decoder->GetHorizSubSampFactor(1);
+    const int subsample_y = mjpeg_decoder->GetVertSubSampFactor(1);
+    // YUV420
+    if (subsample_x == 2 && subsample_y == 2) {
+      return mjpeg_decoder->DecodeToCallback(fn420, opaque, width, height);
+    }
+    // YUV422
+    if (subsample_x == 2 && subsample_y == 1) {
+      return mjpeg_decoder->DecodeToCallback(fn422, opaque, width, height);
+    }
+    // YUV444
+    if (subsample_x == 1 && subsample_y == 1) {
+      return mjpeg_decoder->DecodeToCallback(fn444, opaque, width, height);
+    }
+    // YUV400
+  } else if (mjpeg_decoder->GetColorSpace() ==
+                 MJpegDecoder::kColorSpaceGrayscale &&
+             mjpeg_decoder->GetNumComponents() == 1 &&
+             mjpeg_decoder->GetHorizSubSampFactor(0) == 1 &&
+             mjpeg_decoder->GetVertSubSampFactor(0) == 1) {
+    return mjpeg_decoder->DecodeToCallback(fn400, opaque, width, height);
+  }
+  // ERROR: Unable to convert MJPEG frame because format is not supported
+  mjpeg_decoder->UnloadFrame();
+  return LIBYUV_FALSE;
+}
+
+// Load a frame and set the scale of the DCT for dst_width x dst_height.
+// Returns 0 if the frame is valid.
+static int MJpegLoadScaled(MJpegDecoder* mjpeg_decoder,
+                           const uint8_t* src_mjpg,
+                           size_t src_size_mjpg,
+                           int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height) {
+  if (src_size_mjpg == kUnknownDataSize) {
+    // ERROR: MJPEG frame size unknown
+    return -1;
+  }
+  if (dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  if (!mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg)) {
+    return 1;
+  }
+  if (mjpeg_decoder->GetWidth() != src_width ||
+      mjpeg_decoder->GetHeight() != src_height) {
+    // ERROR: MJPEG frame has unexpected dimensions
+    mjpeg_decoder->UnloadFrame();
+    return 1;  // runtime failure
+  }
+  int scale_denom =
+      MJpegScaleDenom(src_width, src_height, dst_width, dst_height);
+  // The callbacks subsample pairs of rows, so decode an even number of rows
+  // per call.
+  while (scale_denom > 1 &&
+         (mjpeg_decoder->GetImageScanlinesPerImcuRow() / scale_denom) & 1) {
+    scale_denom >>= 1;
+  }
+  if (!mjpeg_decoder->SetScaleDenom(scale_denom)) {
+    mjpeg_decoder->UnloadFrame();
+    return 1;
+  }
+  return 0;
+}
+
+// Decode the loaded frame to I420, scaling the decoded frame to dst_width x
+// dst_height if the DCT could not scale to that size.
+static int MJpegDecodeI420Scaled(MJpegDecoder* mjpeg_decoder,
+                                 uint8_t* dst_y,
+                                 int dst_stride_y,
+                                 uint8_t* dst_u,
+                                 int dst_stride_u,
+                                 uint8_t* dst_v,
+                                 int dst_stride_v,
+                                 int dst_width,
+                                 int dst_height,
+                                 enum FilterMode filtering) {
+  const int scaled_width = mjpeg_decoder->GetWidth();
+  const int scaled_height = mjpeg_decoder->GetHeight();
+  if (scaled_width == dst_width && scaled_height == dst_height) {
+    I420Buffers bufs = {dst_y, dst_stride_y, dst_u,     dst_stride_u,
+                        dst_v, dst_stride_v, dst_width, dst_height};
+    return MJpegDecodeScaled(mjpeg_decoder, &JpegCopyI420, &JpegI422ToI420,
+                             &JpegI444ToI420, &JpegI400ToI420, &bufs)
+               ? 0
+               : 1;
+  }
+  const int scaled_halfwidth = (scaled_width + 1) >> 1;
+  const int scaled_halfheight = (scaled_height + 1) >> 1;
+  align_buffer_64(scaled_y, scaled_width * scaled_height +
+                                scaled_halfwidth * scaled_halfheight * 2);
+  uint8_t* scaled_u = scaled_y + scaled_width * scaled_height;
+  uint8_t* scaled_v = scaled_u + scaled_halfwidth * scaled_halfheight;
+  I420Buffers bufs = {scaled_y,         scaled_width, scaled_u,
+                      scaled_halfwidth, scaled_v,     scaled_halfwidth,
+                      scaled_width,     scaled_height};
+  int ret = MJpegDecodeScaled(mjpeg_decoder, &JpegCopyI420, &JpegI422ToI420,
+                              &JpegI444ToI420, &JpegI400ToI420, &bufs)
+                ? 0
+                : 1;
+  if (ret == 0) {
+    ret = I420Scale(scaled_y, scaled_width, scaled_u, scaled_halfwidth,
+                    scaled_v, scaled_halfwidth, scaled_width, scaled_height,
+                    dst_y, dst_stride_y, dst_u, dst_stride_u, dst_v,
+                    dst_stride_v, dst_width, dst_height, filtering);
+  }
+  free_aligned_buffer_64(scaled_y);
+  return ret;
+}
+
+// MJPG (Motion JPeg) to I420 at dst_width x dst_height.
+LIBYUV_API
+int MJPGToI420Scaled(const uint8_t* src_mjpg,
+                     size_t src_size_mjpg,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering) {
+  MJpegDecoder mjpeg_decoder;
+  int ret = MJpegLoadScaled(&mjpeg_decoder, src_mjpg, src_size_mjpg,
+                            src_width, src_height, dst_width, dst_height);
+  if (ret == 0) {
+    ret = MJpegDecodeI420Scaled(&mjpeg_decoder, dst_y, dst_stride_y, dst_u,
+                                dst_stride_u, dst_v, dst_stride_v, dst_width,
+                                dst_height, filtering);
+  }
+  return ret;
+}
+
+// MJPG (Motion JPeg) to NV21 at dst_width x dst_height.
+LIBYUV_API
+int MJPGToNV21Scaled(const uint8_t* src_mjpg,
+                     size_t src_size_mjpg,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_vu,
+                     int dst_stride_vu,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering) {
+  MJpegDecoder mjpeg_decoder;
+  int ret = MJpegLoadScaled(&mjpeg_decoder, src_mjpg, src_size_mjpg,
+                            src_width, src_height, dst_width, dst_height);
+  if (ret != 0) {
+    return ret;
+  }
+  if (mjpeg_decoder.GetWidth() == dst_width &&
+      mjpeg_decoder.GetHeight() == dst_height) {
+    NV21Buffers bufs = {dst_y,         dst_stride_y, dst_vu,
+                        dst_stride_vu, dst_width,    dst_height};
+    return MJpegDecodeScaled(&mjpeg_decoder, &JpegI420ToNV21, &JpegI422ToNV21,
+                             &JpegI444ToNV21, &JpegI400ToNV21, &bufs)
+               ? 0
+               : 1;
+  }
+  // Scale Y to dst_y and UV to planes that are then interleaved.
+  const int halfwidth = (dst_width + 1) >> 1;
+  const int halfheight = (dst_height + 1) >> 1;
+  align_buffer_64(plane_u, halfwidth * halfheight * 2);
+  uint8_t* plane_v = plane_u + halfwidth * halfheight;
+  ret = MJpegDecodeI420Scaled(&mjpeg_decoder, dst_y, dst_stride_y, plane_u,
+                              halfwidth, plane_v, halfwidth, dst_width,
+                              dst_height, filtering);
+  if (ret == 0) {
+    MergeUVPlane(plane_v, halfwidth, plane_u, halfwidth, dst_vu, dst_stride_vu,
+                 halfwidth, halfheight);
+  }
+  free_aligned_buffer_64(plane_u);
+  return ret;
+}
+
+// MJPG (Motion JPeg) to ARGB at dst_width x dst_height.
+LIBYUV_API
+int MJPGToARGBScaled(const uint8_t* src_mjpg,
+                     size_t src_size_mjpg,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     int src_width,
+                     int src_height,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering) {
+  MJpegDecoder mjpeg_decoder;
+  int ret = MJpegLoadScaled(&mjpeg_decoder, src_mjpg, src_size_mjpg,
+                            src_width, src_height, dst_width, dst_height);
+  if (ret != 0) {
+    return ret;
+  }
+  if (mjpeg_decoder.GetWidth() == dst_width &&
+      mjpeg_decoder.GetHeight() == dst_height) {
+    ARGBBuffers bufs = {dst_argb, dst_stride_argb, dst_width, dst_height};
+    return MJpegDecodeScaled(&mjpeg_decoder, &JpegI420ToARGB, &JpegI422ToARGB,
+                             &JpegI444ToARGB, &JpegI400ToARGB, &bufs)
+               ? 0
+               : 1;
+  }
+  // Scale as I420, which is less to scale than ARGB, then convert.
+  const int halfwidth = (dst_width + 1) >> 1;
+  const int halfheight = (dst_height + 1) >> 1;
+  align_buffer_64(plane_y, dst_width * dst_height + halfwidth * halfheight * 2);
+  uint8_t* plane_u = plane_y + dst_width * dst_height;
+  uint8_t* plane_v = plane_u + halfwidth * halfheight;
+  ret = MJpegDecodeI420Scaled(&mjpeg_decoder, plane_y, dst_width, plane_u,
+                              halfwidth, plane_v, halfwidth, dst_width,
+                              dst_height, filtering);
+  if (ret == 0) {
+    ret = I420ToARGB(plane_y, dst_width, plane_u, halfwidth, plane_v,
+                     halfwidth, dst_argb, dst_stride_argb, dst_width,
+                     dst_height);
+  }
+  free_aligned_buffer_64(plane_y);
+  return ret;
+}
+
 #endif  // HAVE_JPEG
 
 #ifdef __cplusplus
@@ -79,7 +79,7 @@ int ConvertToARGB(const uint8_t* sample,
 
   if (need_buf) {
     int argb_size = crop_width * 4 * abs_crop_height;
-    rotate_buffer = (uint8_t*)malloc(argb_size); /* NOLINT */
+    rotate_buffer = (uint8_t*)ScratchAlloc(argb_size); /* NOLINT */
     if (!rotate_buffer) {
       return 1;  // Out of memory runtime error.
     }
@@ -161,6 +161,14 @@ int ConvertToARGB(const uint8_t* sample,
       r = I400ToARGB(src, src_width, dst_argb, dst_stride_argb, crop_width,
                      inv_crop_height);
       break;
+    case FOURCC_RGGB:
+    case FOURCC_BGGR:
+    case FOURCC_GRBG:
+    case FOURCC_GBRG:
+      src = sample + src_width * crop_y + crop_x;
+      r = BayerToARGB(src, src_width, dst_argb, dst_stride_argb, crop_width,
+                      inv_crop_height, CropBayerFourCC(format, crop_x, crop_y));
+      break;
 
     // Biplanar formats
     case FOURCC_NV12:
@@ -299,7 +307,7 @@ int ConvertToARGB(const uint8_t* sample,
       r = ARGBRotate(dst_argb, dst_stride_argb, dest_argb, dest_dst_stride_argb,
                      crop_width, abs_crop_height, rotation);
     }
-    free(rotate_buffer);
+    ScratchFree(rotate_buffer);
   } else if (rotation) {
     src = sample + (src_width * crop_y + crop_x) * 4;
     r = ARGBRotate(src, src_width * 4, dst_argb, dst_stride_argb, crop_width,
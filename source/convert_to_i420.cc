@@ -11,6 +11,7 @@
 #include <stdlib.h>
 
 #include "libyuv/convert.h"
+#include "libyuv/scratch.h"
 
 #include "libyuv/video_common.h"
 
@@ -76,7 +77,7 @@ int ConvertToI420(const uint8_t* sample,
   if (need_buf) {
     int y_size = crop_width * abs_crop_height;
     int uv_size = ((crop_width + 1) / 2) * ((abs_crop_height + 1) / 2);
-    rotate_buffer = (uint8_t*)malloc(y_size + uv_size * 2); /* NOLINT */
+    rotate_buffer = (uint8_t*)ScratchAlloc(y_size + uv_size * 2); /* NOLINT */
     if (!rotate_buffer) {
       return 1;  // Out of memory runtime error.
     }
@@ -161,6 +162,15 @@ int ConvertToI420(const uint8_t* sample,
       r = I400ToI420(src, src_width, dst_y, dst_stride_y, dst_u, dst_stride_u,
                      dst_v, dst_stride_v, crop_width, inv_crop_height);
       break;
+    case FOURCC_RGGB:
+    case FOURCC_BGGR:
+    case FOURCC_GRBG:
+    case FOURCC_GBRG:
+      src = sample + src_width * crop_y + crop_x;
+      r = BayerToI420(src, src_width, dst_y, dst_stride_y, dst_u, dst_stride_u,
+                      dst_v, dst_stride_v, crop_width, inv_crop_height,
+                      CropBayerFourCC(format, crop_x, crop_y));
+      break;
     // Biplanar formats
     case FOURCC_NV12:
       src = sample + (src_width * crop_y + crop_x);
@@ -265,7 +275,7 @@ int ConvertToI420(const uint8_t* sample,
                      tmp_v, tmp_v_stride, crop_width, abs_crop_height,
                      rotation);
     }
-    free(rotate_buffer);
+    ScratchFree(rotate_buffer);
   }
 
   return r;
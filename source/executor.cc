@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/executor.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "executor_internal.h"
+#include "libyuv/scratch.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Minimum pixels per band. Smaller images are not worth waking threads for.
+static const int kMinBandPixels = 16384;
+
+static thread_local const ParallelExecutor* thread_executor = NULL;
+
+// A parallel_for call in progress. Lives on the stack of the caller.
+struct PoolJob {
+  ParallelRangeFunc func;
+  void* arg;
+  int count;
+  int next;  // Next index to run.
+  int done;  // Number of indexes finished.
+};
+
+struct ThreadPool {
+  ParallelExecutor executor;
+  std::mutex mutex;
+  std::condition_variable work_cv;
+  std::condition_variable done_cv;
+  std::deque<PoolJob*> jobs;
+  std::vector<std::thread> threads;
+  bool stop;
+};
+
+// Take the next index of the job at the front of the queue, run it and mark
+// it done. Called with the pool locked and returns with it locked.
+static void PoolRunOne(ThreadPool* pool,
+                       PoolJob* job,
+                       std::unique_lock<std::mutex>* lock) {
+  int index = job->next++;
+  if (job->next == job->count) {
+    pool->jobs.pop_front();
+  }
+  lock->unlock();
+  job->func(job->arg, index, index + 1);
+  lock->lock();
+  if (++job->done == job->count) {
+    pool->done_cv.notify_all();
+  }
+}
+
+// Each worker has its own scratch arena, so bands do not allocate row buffers
+// once the arena has grown to fit them.
+static void PoolWorker(ThreadPool* pool) {
+  LibyuvScratch* scratch = CreateScratch(0);
+  std::unique_lock<std::mutex> lock(pool->mutex);
+  SetThreadScratch(scratch);
+  for (;;) {
+    pool->work_cv.wait(lock,
+                       [pool] { return pool->stop || !pool->jobs.empty(); });
+    if (pool->stop) {
+      break;
+    }
+    PoolRunOne(pool, pool->jobs.front(), &lock);
+  }
+  SetThreadScratch(NULL);
+  DestroyScratch(scratch);
+}
+
+// The caller queues the job for the workers and then runs indexes of its own
+// job until none are left, so nested or concurrent calls always progress.
+static void PoolParallelFor(void* opaque,
+                            int count,
+                            ParallelRangeFunc func,
+                            void* arg) {
+  ThreadPool* pool = static_cast<ThreadPool*>(opaque);
+  PoolJob job = {func, arg, count, 0, 0};
+  if (count <= 0) {
+    return;
+  }
+  if (count == 1 || pool->threads.empty()) {
+    func(arg, 0, count);
+    return;
+  }
+  std::unique_lock<std::mutex> lock(pool->mutex);
+  pool->jobs.push_back(&job);
+  pool->work_cv.notify_all();
+  while (job.next < job.count) {
+    // Other jobs may be ahead of this one; remove from wherever it is.
+    int index = job.next++;
+    if (job.next == job.count) {
+      for (std::deque<PoolJob*>::iterator it = pool->jobs.begin();
+           it != pool->jobs.end(); ++it) {
+        if (*it == &job) {
+          pool->jobs.erase(it);
+          break;
+        }
+      }
+    }
+    lock.unlock();
+    func(arg, index, index + 1);
+    lock.lock();
+    ++job.done;
+  }
+  pool->done_cv.wait(lock, [&job] { return job.done == job.count; });
+}
+
+LIBYUV_API
+ParallelExecutor* CreateThreadPool(int num_threads) {
+  ThreadPool* pool = new ThreadPool;
+  int i;
+  if (num_threads < 1) {
+    num_threads = 1;
+  }
+  pool->executor.parallel_for = PoolParallelFor;
+  pool->executor.opaque = pool;
+  pool->executor.concurrency = num_threads;
+  pool->stop = false;
+  pool->threads.reserve(num_threads - 1);
+  for (i = 1; i < num_threads; ++i) {
+    pool->threads.emplace_back(PoolWorker, pool);
+  }
+  return &pool->executor;
+}
+
+LIBYUV_API
+void DestroyThreadPool(ParallelExecutor* executor) {
+  ThreadPool* pool;
+  if (!executor) {
+    return;
+  }
+  pool = static_cast<ThreadPool*>(executor->opaque);
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->stop = true;
+  }
+  pool->work_cv.notify_all();
+  for (std::thread& thread : pool->threads) {
+    thread.join();
+  }
+  delete pool;
+}
+
+LIBYUV_API
+void SetThreadExecutor(const ParallelExecutor* executor) {
+  thread_executor = executor;
+}
+
+LIBYUV_API
+const ParallelExecutor* GetThreadExecutor(void) {
+  return thread_executor;
+}
+
+struct RowBands {
+  ParallelRangeFunc rows;
+  void* arg;
+  int height;
+  int band_height;
+};
+
+static void RunRowBands(void* arg, int begin, int end) {
+  const RowBands* bands = static_cast<const RowBands*>(arg);
+  const ParallelExecutor* executor = thread_executor;
+  int y0 = begin * bands->band_height;
+  int y1 = end * bands->band_height;
+  if (y1 > bands->height) {
+    y1 = bands->height;
+  }
+  thread_executor = NULL;
+  bands->rows(bands->arg, y0, y1);
+  thread_executor = executor;
+}
+
+int ParallelRows(int width,
+                 int height,
+                 int row_align,
+                 ParallelRangeFunc rows,
+                 void* arg) {
+  const ParallelExecutor* executor = thread_executor;
+  RowBands bands;
+  int num_bands;
+  if (!executor || executor->concurrency < 2 || width <= 0 || height <= 0) {
+    return -1;
+  }
+  if (row_align < 1) {
+    row_align = 1;
+  }
+  num_bands = executor->concurrency;
+  if (num_bands > height / row_align) {
+    num_bands = height / row_align;
+  }
+  if (num_bands > (int)((int64_t)width * height / kMinBandPixels)) {
+    num_bands = (int)((int64_t)width * height / kMinBandPixels);
+  }
+  if (num_bands < 2) {
+    return -1;
+  }
+  bands.rows = rows;
+  bands.arg = arg;
+  bands.height = height;
+  bands.band_height = (height + num_bands - 1) / num_bands;
+  bands.band_height =
+      (bands.band_height + row_align - 1) / row_align * row_align;
+  num_bands = (height + bands.band_height - 1) / bands.band_height;
+  executor->parallel_for(executor->opaque, num_bands, RunRowBands, &bands);
+  return 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -0,0 +1,40 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Internal to libyuv. Not installed with the public headers.
+
+#ifndef SOURCE_EXECUTOR_INTERNAL_H_
+#define SOURCE_EXECUTOR_INTERNAL_H_
+
+#include "libyuv/executor.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Call rows(arg, begin, end) for bands of rows that together cover
+// [0, height) using the executor of the calling thread. Band boundaries are
+// multiples of row_align. While a band runs, its thread has no executor, so
+// rows may call the entry point again to process the band.
+// Returns 0 if the rows were processed, or -1 if there is no executor or the
+// image is too small to split, in which case the caller processes the rows.
+int ParallelRows(int width,
+                 int height,
+                 int row_align,
+                 ParallelRangeFunc rows,
+                 void* arg);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // SOURCE_EXECUTOR_INTERNAL_H_
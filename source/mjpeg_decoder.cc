@@ -40,6 +40,19 @@ extern "C" {
 
 #include "libyuv/planar_functions.h"  // For CopyPlane().
 
+// libjpeg 7 and later scale the IDCT separately horizontally and vertically.
+#if JPEG_LIB_VERSION >= 70
+#define MIN_DCT_H_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_h_scaled_size)
+#define MIN_DCT_V_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_v_scaled_size)
+#define DCT_H_SCALED_SIZE(comp) ((comp)->DCT_h_scaled_size)
+#define DCT_V_SCALED_SIZE(comp) ((comp)->DCT_v_scaled_size)
+#else
+#define MIN_DCT_H_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_scaled_size)
+#define MIN_DCT_V_SCALED_SIZE(cinfo) ((cinfo)->min_DCT_scaled_size)
+#define DCT_H_SCALED_SIZE(comp) ((comp)->DCT_scaled_size)
+#define DCT_V_SCALED_SIZE(comp) ((comp)->DCT_scaled_size)
+#endif
+
 namespace libyuv {
 
 #ifdef HAVE_SETJMP
@@ -65,7 +78,8 @@ void ErrorHandler(jpeg_common_struct* cinfo);
 void OutputHandler(jpeg_common_struct* cinfo);
 
 MJpegDecoder::MJpegDecoder()
-    : has_scanline_padding_(LIBYUV_FALSE),
+    : scale_denom_(1),
+      has_scanline_padding_(LIBYUV_FALSE),
       num_outbufs_(0),
       scanlines_(NULL),
       scanlines_sizes_(NULL),
@@ -122,13 +136,43 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
     // ERROR: Bad MJPEG header
     return LIBYUV_FALSE;
   }
+  // jpeg_read_header resets the scale to 1.
+  scale_denom_ = 1;
   AllocOutputBuffers(GetNumComponents());
+  AllocScanlineBuffers();
+  return LIBYUV_TRUE;
+}
+
+LIBYUV_BOOL MJpegDecoder::SetScaleDenom(int scale_denom) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 &&
+      scale_denom != 8) {
+    return LIBYUV_FALSE;
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    // We called jpeg_calc_output_dimensions, it experienced an error, and we
+    // called longjmp() and rewound the stack to here. Return error.
+    return LIBYUV_FALSE;
+  }
+#endif
+  decompress_struct_->scale_num = 1;
+  decompress_struct_->scale_denom = scale_denom;
+  // Compute the DCT size of each component as StartDecode will. Chroma may
+  // be given a larger DCT size than luma, which lowers its subsampling.
+  decompress_struct_->raw_data_out = TRUE;
+  jpeg_calc_output_dimensions(decompress_struct_);
+  scale_denom_ = scale_denom;
+  AllocScanlineBuffers();
+  return LIBYUV_TRUE;
+}
+
+void MJpegDecoder::AllocScanlineBuffers() {
+  has_scanline_padding_ = LIBYUV_FALSE;
   for (int i = 0; i < num_outbufs_; ++i) {
     int scanlines_size = GetComponentScanlinesPerImcuRow(i);
-    if (scanlines_sizes_[i] != scanlines_size) {
-      if (scanlines_[i]) {
-        delete scanlines_[i];
-      }
+    LIBYUV_BOOL scanlines_changed = scanlines_sizes_[i] != scanlines_size;
+    if (scanlines_changed) {
+      delete[] scanlines_[i];
       scanlines_[i] = new uint8_t*[scanlines_size];
       scanlines_sizes_[i] = scanlines_size;
     }
@@ -141,10 +185,8 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
     // next scanline.
     int databuf_stride = GetComponentStride(i);
     int databuf_size = scanlines_size * databuf_stride;
-    if (databuf_strides_[i] != databuf_stride) {
-      if (databuf_[i]) {
-        delete databuf_[i];
-      }
+    if (scanlines_changed || databuf_strides_[i] != databuf_stride) {
+      delete[] databuf_[i];
       databuf_[i] = new uint8_t[databuf_size];
       databuf_strides_[i] = databuf_stride;
     }
@@ -153,7 +195,6 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
       has_scanline_padding_ = LIBYUV_TRUE;
     }
   }
-  return LIBYUV_TRUE;
 }
 
 static int DivideAndRoundUp(int numerator, int denominator) {
@@ -166,12 +207,12 @@ static int DivideAndRoundDown(int numerator, int denominator) {
 
 // Returns width of the last loaded frame.
 int MJpegDecoder::GetWidth() {
-  return decompress_struct_->image_width;
+  return DivideAndRoundUp(decompress_struct_->image_width, scale_denom_);
 }
 
 // Returns height of the last loaded frame.
 int MJpegDecoder::GetHeight() {
-  return decompress_struct_->image_height;
+  return DivideAndRoundUp(decompress_struct_->image_height, scale_denom_);
 }
 
 // Returns format of the last loaded frame. The return value is one of the
@@ -194,16 +235,25 @@ int MJpegDecoder::GetVertSampFactor(int component) {
   return decompress_struct_->comp_info[component].v_samp_factor;
 }
 
+// Subsampling of the decoded component, which is less than the subsampling
+// in the frame when the component is scaled less than luma.
 int MJpegDecoder::GetHorizSubSampFactor(int component) {
-  return decompress_struct_->max_h_samp_factor / GetHorizSampFactor(component);
+  return decompress_struct_->max_h_samp_factor *
+         MIN_DCT_H_SCALED_SIZE(decompress_struct_) /
+         (GetHorizSampFactor(component) *
+          DCT_H_SCALED_SIZE(&decompress_struct_->comp_info[component]));
 }
 
 int MJpegDecoder::GetVertSubSampFactor(int component) {
-  return decompress_struct_->max_v_samp_factor / GetVertSampFactor(component);
+  return decompress_struct_->max_v_samp_factor *
+         MIN_DCT_V_SCALED_SIZE(decompress_struct_) /
+         (GetVertSampFactor(component) *
+          DCT_V_SCALED_SIZE(&decompress_struct_->comp_info[component]));
 }
 
 int MJpegDecoder::GetImageScanlinesPerImcuRow() {
-  return decompress_struct_->max_v_samp_factor * DCTSIZE;
+  return decompress_struct_->max_v_samp_factor *
+         MIN_DCT_V_SCALED_SIZE(decompress_struct_);
 }
 
 int MJpegDecoder::GetComponentScanlinesPerImcuRow(int component) {
@@ -12,6 +12,7 @@
 
 #include <string.h>  // for memset()
 
+#include "executor_internal.h"
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
@@ -24,6 +25,43 @@ namespace libyuv {
 extern "C" {
 #endif
 
+// Arguments of plane functions for processing bands of rows with
+// ParallelRows. Unused planes are NULL.
+struct PlaneArgs {
+  const uint8_t* src0;
+  int src_stride0;
+  const uint8_t* src1;
+  int src_stride1;
+  uint8_t* dst0;
+  int dst_stride0;
+  uint8_t* dst1;
+  int dst_stride1;
+  int width;
+};
+
+static void CopyPlaneRows(void* arg, int begin, int end) {
+  const PlaneArgs* a = static_cast<const PlaneArgs*>(arg);
+  CopyPlane(a->src0 + begin * (intptr_t)a->src_stride0, a->src_stride0,
+            a->dst0 + begin * (intptr_t)a->dst_stride0, a->dst_stride0,
+            a->width, end - begin);
+}
+
+static void SplitUVPlaneRows(void* arg, int begin, int end) {
+  const PlaneArgs* a = static_cast<const PlaneArgs*>(arg);
+  SplitUVPlane(a->src0 + begin * (intptr_t)a->src_stride0, a->src_stride0,
+               a->dst0 + begin * (intptr_t)a->dst_stride0, a->dst_stride0,
+               a->dst1 + begin * (intptr_t)a->dst_stride1, a->dst_stride1,
+               a->width, end - begin);
+}
+
+static void MergeUVPlaneRows(void* arg, int begin, int end) {
+  const PlaneArgs* a = static_cast<const PlaneArgs*>(arg);
+  MergeUVPlane(a->src0 + begin * (intptr_t)a->src_stride0, a->src_stride0,
+               a->src1 + begin * (intptr_t)a->src_stride1, a->src_stride1,
+               a->dst0 + begin * (intptr_t)a->dst_stride0, a->dst_stride0,
+               a->width, end - begin);
+}
+
 // Copy a plane of data
 LIBYUV_API
 void CopyPlane(const uint8_t* src_y,
@@ -40,6 +78,13 @@ void CopyPlane(const uint8_t* src_y,
     dst_y = dst_y + (height - 1) * dst_stride_y;
     dst_stride_y = -dst_stride_y;
   }
+  {
+    PlaneArgs args = {src_y, src_stride_y, NULL, 0, dst_y,
+                      dst_stride_y, NULL, 0, width};
+    if (ParallelRows(width, height, 1, CopyPlaneRows, &args) == 0) {
+      return;
+    }
+  }
   // Coalesce rows.
   if (src_stride_y == width && dst_stride_y == width) {
     width *= height;
@@ -66,6 +111,11 @@ void CopyPlane(const uint8_t* src_y,
     CopyRow = CopyRow_ERMS;
   }
 #endif
+#if defined(HAS_COPYROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW) && IS_ALIGNED(width, 128)) {
+    CopyRow = CopyRow_AVX512BW;
+  }
+#endif
 #if defined(HAS_COPYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     CopyRow = IS_ALIGNED(width, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
@@ -371,6 +421,13 @@ void SplitUVPlane(const uint8_t* src_uv,
     dst_stride_u = -dst_stride_u;
     dst_stride_v = -dst_stride_v;
   }
+  {
+    PlaneArgs args = {src_uv, src_stride_uv, NULL, 0, dst_u,
+                      dst_stride_u, dst_v, dst_stride_v, width};
+    if (ParallelRows(width, height, 1, SplitUVPlaneRows, &args) == 0) {
+      return;
+    }
+  }
   // Coalesce rows.
   if (src_stride_uv == width * 2 && dst_stride_u == width &&
       dst_stride_v == width) {
@@ -394,6 +451,14 @@ void SplitUVPlane(const uint8_t* src_uv,
     }
   }
 #endif
+#if defined(HAS_SPLITUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    SplitUVRow = SplitUVRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 64)) {
+      SplitUVRow = SplitUVRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_SPLITUVROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     SplitUVRow = SplitUVRow_Any_NEON;
@@ -446,6 +511,13 @@ void MergeUVPlane(const uint8_t* src_u,
     dst_uv = dst_uv + (height - 1) * dst_stride_uv;
     dst_stride_uv = -dst_stride_uv;
   }
+  {
+    PlaneArgs args = {src_u, src_stride_u, src_v, src_stride_v, dst_uv,
+                      dst_stride_uv, NULL, 0, width};
+    if (ParallelRows(width, height, 1, MergeUVPlaneRows, &args) == 0) {
+      return;
+    }
+  }
   // Coalesce rows.
   if (src_stride_u == width && src_stride_v == width &&
       dst_stride_uv == width * 2) {
@@ -469,6 +541,14 @@ void MergeUVPlane(const uint8_t* src_u,
     }
   }
 #endif
+#if defined(HAS_MERGEUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    MergeUVRow = MergeUVRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      MergeUVRow = MergeUVRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_MERGEUVROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     MergeUVRow = MergeUVRow_Any_NEON;
@@ -560,6 +640,237 @@ int NV21ToNV12(const uint8_t* src_y,
   return 0;
 }
 
+// Split a 16 bit interleaved UV plane with msb data, as found in P010,
+// into separate U and V planes with lsb data.
+LIBYUV_API
+void SplitUVPlane_16(const uint16_t* src_uv,
+                     int src_stride_uv,
+                     uint16_t* dst_u,
+                     int dst_stride_u,
+                     uint16_t* dst_v,
+                     int dst_stride_v,
+                     int width,
+                     int height,
+                     int depth) {
+  int y;
+  void (*SplitUVRow_16)(const uint16_t* src_uv, uint16_t* dst_u,
+                        uint16_t* dst_v, int depth, int width) =
+      SplitUVRow_16_C;
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_u = dst_u + (height - 1) * dst_stride_u;
+    dst_v = dst_v + (height - 1) * dst_stride_v;
+    dst_stride_u = -dst_stride_u;
+    dst_stride_v = -dst_stride_v;
+  }
+  // Coalesce rows.
+  if (src_stride_uv == width * 2 && dst_stride_u == width &&
+      dst_stride_v == width) {
+    width *= height;
+    height = 1;
+    src_stride_uv = dst_stride_u = dst_stride_v = 0;
+  }
+#if defined(HAS_SPLITUVROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SplitUVRow_16 = SplitUVRow_16_Any_SSE2;
+    if (IS_ALIGNED(width, 8)) {
+      SplitUVRow_16 = SplitUVRow_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SplitUVRow_16 = SplitUVRow_16_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      SplitUVRow_16 = SplitUVRow_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SplitUVRow_16 = SplitUVRow_16_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      SplitUVRow_16 = SplitUVRow_16_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    // Split a row of UV.
+    SplitUVRow_16(src_uv, dst_u, dst_v, depth, width);
+    dst_u += dst_stride_u;
+    dst_v += dst_stride_v;
+    src_uv += src_stride_uv;
+  }
+}
+
+// Merge separate U and V planes with lsb data into a 16 bit interleaved UV
+// plane with msb data, as found in P010.
+LIBYUV_API
+void MergeUVPlane_16(const uint16_t* src_u,
+                     int src_stride_u,
+                     const uint16_t* src_v,
+                     int src_stride_v,
+                     uint16_t* dst_uv,
+                     int dst_stride_uv,
+                     int width,
+                     int height,
+                     int depth) {
+  int y;
+  int scale = 1 << (16 - depth);
+  void (*MergeUVRow_16)(const uint16_t* src_u, const uint16_t* src_v,
+                        uint16_t* dst_uv, int scale, int width) =
+      MergeUVRow_16_C;
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_uv = dst_uv + (height - 1) * dst_stride_uv;
+    dst_stride_uv = -dst_stride_uv;
+  }
+  // Coalesce rows.
+  if (src_stride_u == width && src_stride_v == width &&
+      dst_stride_uv == width * 2) {
+    width *= height;
+    height = 1;
+    src_stride_u = src_stride_v = dst_stride_uv = 0;
+  }
+#if defined(HAS_MERGEUVROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MergeUVRow_16 = MergeUVRow_16_Any_SSE2;
+    if (IS_ALIGNED(width, 8)) {
+      MergeUVRow_16 = MergeUVRow_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MergeUVRow_16 = MergeUVRow_16_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      MergeUVRow_16 = MergeUVRow_16_AVX2;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    // Merge a row of U and V into a row of UV.
+    MergeUVRow_16(src_u, src_v, dst_uv, scale, width);
+    src_u += src_stride_u;
+    src_v += src_stride_v;
+    dst_uv += dst_stride_uv;
+  }
+}
+
+// Convert a plane of 16 bit lsb data to msb data.
+LIBYUV_API
+void ConvertToMSBPlane_16(const uint16_t* src_y,
+                          int src_stride_y,
+                          uint16_t* dst_y,
+                          int dst_stride_y,
+                          int width,
+                          int height,
+                          int depth) {
+  int y;
+  int scale = 1 << (16 - depth);
+  void (*MultiplyRow_16)(const uint16_t* src_y, uint16_t* dst_y, int scale,
+                         int width) = MultiplyRow_16_C;
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_y = dst_y + (height - 1) * dst_stride_y;
+    dst_stride_y = -dst_stride_y;
+  }
+  // Coalesce rows.
+  if (src_stride_y == width && dst_stride_y == width) {
+    width *= height;
+    height = 1;
+    src_stride_y = dst_stride_y = 0;
+  }
+#if defined(HAS_MULTIPLYROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MultiplyRow_16 = MultiplyRow_16_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      MultiplyRow_16 = MultiplyRow_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MULTIPLYROW_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MultiplyRow_16 = MultiplyRow_16_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      MultiplyRow_16 = MultiplyRow_16_AVX2;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    MultiplyRow_16(src_y, dst_y, scale, width);
+    src_y += src_stride_y;
+    dst_y += dst_stride_y;
+  }
+}
+
+// Convert a plane of 16 bit msb data to lsb data.
+LIBYUV_API
+void ConvertToLSBPlane_16(const uint16_t* src_y,
+                          int src_stride_y,
+                          uint16_t* dst_y,
+                          int dst_stride_y,
+                          int width,
+                          int height,
+                          int depth) {
+  int y;
+  int scale = 1 << depth;
+  void (*DivideRow_16)(const uint16_t* src_y, uint16_t* dst_y, int scale,
+                       int width) = DivideRow_16_C;
+  if (depth >= 16) {
+    CopyPlane_16(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+    return;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_y = dst_y + (height - 1) * dst_stride_y;
+    dst_stride_y = -dst_stride_y;
+  }
+  // Coalesce rows.
+  if (src_stride_y == width && dst_stride_y == width) {
+    width *= height;
+    height = 1;
+    src_stride_y = dst_stride_y = 0;
+  }
+#if defined(HAS_DIVIDEROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    DivideRow_16 = DivideRow_16_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      DivideRow_16 = DivideRow_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_DIVIDEROW_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    DivideRow_16 = DivideRow_16_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      DivideRow_16 = DivideRow_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_DIVIDEROW_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    DivideRow_16 = DivideRow_16_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      DivideRow_16 = DivideRow_16_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    DivideRow_16(src_y, dst_y, scale, width);
+    src_y += src_stride_y;
+    dst_y += dst_stride_y;
+  }
+}
+
 // Support function for NV12 etc RGB channels.
 // Width and height are plane sizes (typically half pixel width).
 LIBYUV_API
@@ -1405,6 +1716,17 @@ int I420Blend(const uint8_t* src_y0,
     }
   }
 #endif
+#if defined(HAS_SCALEROWDOWN2_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ScaleRowDown2 = ScaleRowDown2Box_Odd_AVX512BW;
+    if (IS_ALIGNED(width, 2)) {
+      ScaleRowDown2 = ScaleRowDown2Box_Any_AVX512BW;
+      if (IS_ALIGNED(halfwidth, 64)) {
+        ScaleRowDown2 = ScaleRowDown2Box_AVX512BW;
+      }
+    }
+  }
+#endif
 #if defined(HAS_SCALEROWDOWN2_MMI)
   if (TestCpuFlag(kCpuHasMMI)) {
     ScaleRowDown2 = ScaleRowDown2Box_Odd_MMI;
@@ -1685,17 +2007,18 @@ int ARGBSubtract(const uint8_t* src_argb0,
   return 0;
 }
 // Convert I422 to RGBA with matrix
-static int I422ToRGBAMatrix(const uint8_t* src_y,
-                            int src_stride_y,
-                            const uint8_t* src_u,
-                            int src_stride_u,
-                            const uint8_t* src_v,
-                            int src_stride_v,
-                            uint8_t* dst_rgba,
-                            int dst_stride_rgba,
-                            const struct YuvConstants* yuvconstants,
-                            int width,
-                            int height) {
+LIBYUV_API
+int I422ToRGBAMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_rgba,
+                     int dst_stride_rgba,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
   int y;
   void (*I422ToRGBARow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -3710,6 +4033,14 @@ int YUY2ToNV12(const uint8_t* src_yuy2,
     }
   }
 #endif
+#if defined(HAS_SPLITUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    SplitUVRow = SplitUVRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 64)) {
+      SplitUVRow = SplitUVRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_SPLITUVROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     SplitUVRow = SplitUVRow_Any_NEON;
@@ -3842,6 +4173,14 @@ int UYVYToNV12(const uint8_t* src_uyvy,
     }
   }
 #endif
+#if defined(HAS_SPLITUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    SplitUVRow = SplitUVRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 64)) {
+      SplitUVRow = SplitUVRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_SPLITUVROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     SplitUVRow = SplitUVRow_Any_NEON;
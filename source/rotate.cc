@@ -10,17 +10,39 @@
 
 #include "libyuv/rotate.h"
 
+#include "executor_internal.h"
 #include "libyuv/convert.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate_row.h"
 #include "libyuv/row.h"
+#include "libyuv/scale_row.h"
+#include "stats_internal.h"
 
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
 #endif
 
+#define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
+
+// Arguments of TransposePlane for transposing bands of destination rows,
+// which are source columns, with ParallelRows.
+struct TransposePlaneArgs {
+  const uint8_t* src;
+  int src_stride;
+  uint8_t* dst;
+  int dst_stride;
+  int height;
+};
+
+static void TransposePlaneRows(void* arg, int begin, int end) {
+  const TransposePlaneArgs* a = static_cast<const TransposePlaneArgs*>(arg);
+  TransposePlane(a->src + begin, a->src_stride,
+                 a->dst + begin * (intptr_t)a->dst_stride, a->dst_stride,
+                 end - begin, a->height);
+}
+
 LIBYUV_API
 void TransposePlane(const uint8_t* src,
                     int src_stride,
@@ -29,13 +51,11 @@ void TransposePlane(const uint8_t* src,
                     int width,
                     int height) {
   int i = height;
-#if defined(HAS_TRANSPOSEWX16_MSA)
-  void (*TransposeWx16)(const uint8_t* src, int src_stride, uint8_t* dst,
-                        int dst_stride, int width) = TransposeWx16_C;
-#else
   void (*TransposeWx8)(const uint8_t* src, int src_stride, uint8_t* dst,
                        int dst_stride, int width) = TransposeWx8_C;
-#endif
+  // 16 row tiles are used when a 16 row kernel is available.
+  void (*TransposeWx16)(const uint8_t* src, int src_stride, uint8_t* dst,
+                        int dst_stride, int width) = NULL;
 #if defined(HAS_TRANSPOSEWX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     TransposeWx8 = TransposeWx8_NEON;
@@ -70,16 +90,31 @@ void TransposePlane(const uint8_t* src,
     }
   }
 #endif
+#if defined(HAS_TRANSPOSEWX16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    TransposeWx16 = TransposeWx16_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      TransposeWx16 = TransposeWx16_AVX2;
+    }
+  }
+#endif
+  {
+    TransposePlaneArgs args = {src, src_stride, dst, dst_stride, height};
+    if (ParallelRows(height, width, 16, TransposePlaneRows, &args) == 0) {
+      return;
+    }
+  }
 
-#if defined(HAS_TRANSPOSEWX16_MSA)
   // Work across the source in 16x16 tiles
-  while (i >= 16) {
-    TransposeWx16(src, src_stride, dst, dst_stride, width);
-    src += 16 * src_stride;  // Go down 16 rows.
-    dst += 16;               // Move over 16 columns.
-    i -= 16;
+  if (TransposeWx16) {
+    while (i >= 16) {
+      TransposeWx16(src, src_stride, dst, dst_stride, width);
+      src += 16 * src_stride;  // Go down 16 rows.
+      dst += 16;               // Move over 16 columns.
+      i -= 16;
+    }
   }
-#else
+
   // Work across the source in 8x8 tiles
   while (i >= 8) {
     TransposeWx8(src, src_stride, dst, dst_stride, width);
@@ -87,7 +122,6 @@ void TransposePlane(const uint8_t* src,
     dst += 8;               // Move over 8 columns.
     i -= 8;
   }
-#endif
 
   if (i > 0) {
     TransposeWxH_C(src, src_stride, dst, dst_stride, width, i);
@@ -194,6 +228,11 @@ void RotatePlane180(const uint8_t* src,
     CopyRow = CopyRow_ERMS;
   }
 #endif
+#if defined(HAS_COPYROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW) && IS_ALIGNED(width, 128)) {
+    CopyRow = CopyRow_AVX512BW;
+  }
+#endif
 #if defined(HAS_COPYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     CopyRow = IS_ALIGNED(width, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
@@ -228,15 +267,13 @@ void TransposeUV(const uint8_t* src,
                  int width,
                  int height) {
   int i = height;
-#if defined(HAS_TRANSPOSEUVWX16_MSA)
-  void (*TransposeUVWx16)(const uint8_t* src, int src_stride, uint8_t* dst_a,
-                          int dst_stride_a, uint8_t* dst_b, int dst_stride_b,
-                          int width) = TransposeUVWx16_C;
-#else
   void (*TransposeUVWx8)(const uint8_t* src, int src_stride, uint8_t* dst_a,
                          int dst_stride_a, uint8_t* dst_b, int dst_stride_b,
                          int width) = TransposeUVWx8_C;
-#endif
+  // 16 row tiles are used when a 16 row kernel is available.
+  void (*TransposeUVWx16)(const uint8_t* src, int src_stride, uint8_t* dst_a,
+                          int dst_stride_a, uint8_t* dst_b, int dst_stride_b,
+                          int width) = NULL;
 #if defined(HAS_TRANSPOSEUVWX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     TransposeUVWx8 = TransposeUVWx8_NEON;
@@ -266,18 +303,27 @@ void TransposeUV(const uint8_t* src,
     }
   }
 #endif
+#if defined(HAS_TRANSPOSEUVWX16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    TransposeUVWx16 = TransposeUVWx16_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      TransposeUVWx16 = TransposeUVWx16_AVX2;
+    }
+  }
+#endif
+
+  // Work through the source in 16x8 tiles.
+  if (TransposeUVWx16) {
+    while (i >= 16) {
+      TransposeUVWx16(src, src_stride, dst_a, dst_stride_a, dst_b,
+                      dst_stride_b, width);
+      src += 16 * src_stride;  // Go down 16 rows.
+      dst_a += 16;             // Move over 16 columns.
+      dst_b += 16;             // Move over 16 columns.
+      i -= 16;
+    }
+  }
 
-#if defined(HAS_TRANSPOSEUVWX16_MSA)
-  // Work through the source in 8x8 tiles.
-  while (i >= 16) {
-    TransposeUVWx16(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
-                    width);
-    src += 16 * src_stride;  // Go down 16 rows.
-    dst_a += 16;             // Move over 8 columns.
-    dst_b += 16;             // Move over 8 columns.
-    i -= 16;
-  }
-#else
   // Work through the source in 8x8 tiles.
   while (i >= 8) {
     TransposeUVWx8(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
@@ -287,7 +333,6 @@ void TransposeUV(const uint8_t* src,
     dst_b += 8;             // Move over 8 columns.
     i -= 8;
   }
-#endif
 
   if (i > 0) {
     TransposeUVWxH_C(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
@@ -413,6 +458,100 @@ int RotatePlane(const uint8_t* src,
   return -1;
 }
 
+LIBYUV_API
+void TransposePlane_16(const uint16_t* src,
+                       int src_stride,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int width,
+                       int height) {
+  int i = height;
+  void (*TransposeWx8_16)(const uint16_t* src, int src_stride, uint16_t* dst,
+                          int dst_stride, int width) = TransposeWx8_16_C;
+#if defined(HAS_TRANSPOSEWX8_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    TransposeWx8_16 = TransposeWx8_16_Any_SSE2;
+    if (IS_ALIGNED(width, 8)) {
+      TransposeWx8_16 = TransposeWx8_16_SSE2;
+    }
+  }
+#endif
+
+  // Work across the source in 8x8 tiles
+  while (i >= 8) {
+    TransposeWx8_16(src, src_stride, dst, dst_stride, width);
+    src += 8 * src_stride;  // Go down 8 rows.
+    dst += 8;               // Move over 8 columns.
+    i -= 8;
+  }
+
+  if (i > 0) {
+    TransposeWxH_16_C(src, src_stride, dst, dst_stride, width, i);
+  }
+}
+
+static void RotatePlane180_16(const uint16_t* src,
+                              int src_stride,
+                              uint16_t* dst,
+                              int dst_stride,
+                              int width,
+                              int height) {
+  int x;
+  int y;
+  // Read rows from the top and write them mirrored from the bottom.
+  dst += dst_stride * (height - 1);
+  for (y = 0; y < height; ++y) {
+    for (x = 0; x < width; ++x) {
+      dst[width - 1 - x] = src[x];
+    }
+    src += src_stride;
+    dst -= dst_stride;
+  }
+}
+
+LIBYUV_API
+int RotatePlane_16(const uint16_t* src,
+                   int src_stride,
+                   uint16_t* dst,
+                   int dst_stride,
+                   int width,
+                   int height,
+                   enum RotationMode mode) {
+  if (!src || width <= 0 || height == 0 || !dst) {
+    return -1;
+  }
+
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src = src + (height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+
+  switch (mode) {
+    case kRotate0:
+      // copy frame
+      CopyPlane_16(src, src_stride, dst, dst_stride, width, height);
+      return 0;
+    case kRotate90:
+      // Transpose with the source read from bottom to top.
+      TransposePlane_16(src + src_stride * (height - 1), -src_stride, dst,
+                        dst_stride, width, height);
+      return 0;
+    case kRotate270:
+      // Transpose with the destination written from bottom to top.
+      TransposePlane_16(src, src_stride, dst + dst_stride * (width - 1),
+                        -dst_stride, width, height);
+      return 0;
+    case kRotate180:
+      RotatePlane180_16(src, src_stride, dst, dst_stride, width, height);
+      return 0;
+    default:
+      break;
+  }
+  return -1;
+}
+
 LIBYUV_API
 int I420Rotate(const uint8_t* src_y,
                int src_stride_y,
@@ -448,6 +587,7 @@ int I420Rotate(const uint8_t* src_y,
     src_stride_v = -src_stride_v;
   }
 
+  LIBYUV_STATS_BEGIN(stats_start);
   switch (mode) {
     case kRotate0:
       // copy frame
@@ -460,25 +600,26 @@ int I420Rotate(const uint8_t* src_y,
                     halfheight);
       RotatePlane90(src_v, src_stride_v, dst_v, dst_stride_v, halfwidth,
                     halfheight);
-      return 0;
+      break;
     case kRotate270:
       RotatePlane270(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
       RotatePlane270(src_u, src_stride_u, dst_u, dst_stride_u, halfwidth,
                      halfheight);
       RotatePlane270(src_v, src_stride_v, dst_v, dst_stride_v, halfwidth,
                      halfheight);
-      return 0;
+      break;
     case kRotate180:
       RotatePlane180(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
       RotatePlane180(src_u, src_stride_u, dst_u, dst_stride_u, halfwidth,
                      halfheight);
       RotatePlane180(src_v, src_stride_v, dst_v, dst_stride_v, halfwidth,
                      halfheight);
-      return 0;
-    default:
       break;
+    default:
+      return -1;
   }
-  return -1;
+  LIBYUV_STATS_END(stats_start, kStatsI420Rotate, (uint64_t)width * height);
+  return 0;
 }
 
 LIBYUV_API
@@ -539,6 +680,261 @@ int NV12ToI420Rotate(const uint8_t* src_y,
   return -1;
 }
 
+// Destination rows per strip of the fused scale and rotate. A multiple of
+// 16 and 3, so strips of the Y plane and the half height chroma planes are
+// whole tiles of TransposeWx8 and whole row groups of the 3/4 and 3/8
+// scalers.
+static const int kScaleRotateStripRows = 48;
+
+// Scaled rows are rotated from a strip buffer that stays in cache, so the
+// full size frame is read once and the destination written once.
+typedef struct {
+  const uint8_t* src_y;
+  int src_stride_y;
+  const uint8_t* src_u;  // Interleaved UV if src_v is NULL.
+  int src_stride_u;
+  const uint8_t* src_v;
+  int src_stride_v;
+  int src_width;
+  int src_height;
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+  int width;  // Size of the scaled image before rotation.
+  int height;
+  enum RotationMode mode;
+  enum FilterMode filtering;
+} ScaleRotateJob;
+
+// Rotate rows [y, y + rows) of a width by height image from a strip buffer
+// to their place in dst.
+static void RotatePlaneStrip(const uint8_t* strip,
+                             int strip_stride,
+                             uint8_t* dst,
+                             int dst_stride,
+                             int width,
+                             int height,
+                             int y,
+                             int rows,
+                             enum RotationMode mode) {
+  switch (mode) {
+    case kRotate90:
+      RotatePlane90(strip, strip_stride, dst + height - y - rows, dst_stride,
+                    width, rows);
+      break;
+    case kRotate270:
+      RotatePlane270(strip, strip_stride, dst + y, dst_stride, width, rows);
+      break;
+    case kRotate180:
+      RotatePlane180(strip, strip_stride,
+                     dst + (height - y - rows) * dst_stride, dst_stride, width,
+                     rows);
+      break;
+    default:
+      CopyPlane(strip, strip_stride, dst + y * dst_stride, dst_stride, width,
+                rows);
+      break;
+  }
+}
+
+// Rotate and split rows [y, y + rows) of interleaved UV from a strip buffer.
+static void RotateUVStrip(const uint8_t* strip,
+                          int strip_stride,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int width,
+                          int height,
+                          int y,
+                          int rows,
+                          enum RotationMode mode) {
+  switch (mode) {
+    case kRotate90:
+      RotateUV90(strip, strip_stride, dst_u + height - y - rows, dst_stride_u,
+                 dst_v + height - y - rows, dst_stride_v, width, rows);
+      break;
+    case kRotate270:
+      RotateUV270(strip, strip_stride, dst_u + y, dst_stride_u, dst_v + y,
+                  dst_stride_v, width, rows);
+      break;
+    case kRotate180:
+      RotateUV180(strip, strip_stride,
+                  dst_u + (height - y - rows) * dst_stride_u, dst_stride_u,
+                  dst_v + (height - y - rows) * dst_stride_v, dst_stride_v,
+                  width, rows);
+      break;
+    default:
+      SplitUVPlane(strip, strip_stride, dst_u + y * dst_stride_u, dst_stride_u,
+                   dst_v + y * dst_stride_v, dst_stride_v, width, rows);
+      break;
+  }
+}
+
+// Scale and rotate strips of rows [begin, end) of the scaled image.
+static void ScaleRotateRows(void* arg, int begin, int end) {
+  const ScaleRotateJob* job = static_cast<const ScaleRotateJob*>(arg);
+  const int width = job->width;
+  const int height = job->height;
+  const int halfwidth = (width + 1) >> 1;
+  const int halfheight = (height + 1) >> 1;
+  const int src_halfwidth = SUBSAMPLE(job->src_width, 1, 1);
+  const int src_halfheight = SUBSAMPLE(job->src_height, 1, 1);
+  int y;
+  align_buffer_64(strip, (width + halfwidth * 2) * kScaleRotateStripRows);
+  uint8_t* strip_y = strip;
+  uint8_t* strip_u = strip_y + width * kScaleRotateStripRows;
+  uint8_t* strip_v = strip_u + halfwidth * kScaleRotateStripRows;
+
+  for (y = begin; y < end; y += kScaleRotateStripRows) {
+    int rows =
+        end - y < kScaleRotateStripRows ? end - y : kScaleRotateStripRows;
+    int uv_y = y >> 1;
+    int uv_rows = ((y + rows - 1) >> 1) - uv_y + 1;
+    ScalePlaneBand(job->src_y, job->src_stride_y, job->src_width,
+                   job->src_height, strip_y, width, width, height, y, rows,
+                   job->filtering);
+    RotatePlaneStrip(strip_y, width, job->dst_y, job->dst_stride_y, width,
+                     height, y, rows, job->mode);
+    if (!job->src_v) {
+      ScaleUVBand(job->src_u, job->src_stride_u, src_halfwidth,
+                  src_halfheight, strip_u, halfwidth * 2, halfwidth,
+                  halfheight, uv_y, uv_rows, job->filtering);
+      RotateUVStrip(strip_u, halfwidth * 2, job->dst_u, job->dst_stride_u,
+                    job->dst_v, job->dst_stride_v, halfwidth, halfheight, uv_y,
+                    uv_rows, job->mode);
+    } else {
+      ScalePlaneBand(job->src_u, job->src_stride_u, src_halfwidth,
+                     src_halfheight, strip_u, halfwidth, halfwidth, halfheight,
+                     uv_y, uv_rows, job->filtering);
+      ScalePlaneBand(job->src_v, job->src_stride_v, src_halfwidth,
+                     src_halfheight, strip_v, halfwidth, halfwidth, halfheight,
+                     uv_y, uv_rows, job->filtering);
+      RotatePlaneStrip(strip_u, halfwidth, job->dst_u, job->dst_stride_u,
+                       halfwidth, halfheight, uv_y, uv_rows, job->mode);
+      RotatePlaneStrip(strip_v, halfwidth, job->dst_v, job->dst_stride_v,
+                       halfwidth, halfheight, uv_y, uv_rows, job->mode);
+    }
+  }
+  free_aligned_buffer_64(strip);
+}
+
+// Scale and rotate a frame with I420 or, if src_v is NULL, NV12 chroma.
+static int ScaleRotate(const uint8_t* src_y,
+                       int src_stride_y,
+                       const uint8_t* src_u,
+                       int src_stride_u,
+                       const uint8_t* src_v,
+                       int src_stride_v,
+                       int src_width,
+                       int src_height,
+                       uint8_t* dst_y,
+                       int dst_stride_y,
+                       uint8_t* dst_u,
+                       int dst_stride_u,
+                       uint8_t* dst_v,
+                       int dst_stride_v,
+                       int dst_width,
+                       int dst_height,
+                       enum RotationMode mode,
+                       enum FilterMode filtering) {
+  ScaleRotateJob job;
+  if (!src_y || !src_u || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  switch (mode) {
+    case kRotate0:
+    case kRotate180:
+      job.width = dst_width;
+      job.height = dst_height;
+      break;
+    case kRotate90:
+    case kRotate270:
+      job.width = dst_height;
+      job.height = dst_width;
+      break;
+    default:
+      return -1;
+  }
+  job.src_y = src_y;
+  job.src_stride_y = src_stride_y;
+  job.src_u = src_u;
+  job.src_stride_u = src_stride_u;
+  job.src_v = src_v;
+  job.src_stride_v = src_stride_v;
+  job.src_width = src_width;
+  job.src_height = src_height;
+  job.dst_y = dst_y;
+  job.dst_stride_y = dst_stride_y;
+  job.dst_u = dst_u;
+  job.dst_stride_u = dst_stride_u;
+  job.dst_v = dst_v;
+  job.dst_stride_v = dst_stride_v;
+  job.mode = mode;
+  job.filtering = filtering;
+  if (ParallelRows(job.width, job.height, kScaleRotateStripRows,
+                   ScaleRotateRows, &job) != 0) {
+    ScaleRotateRows(&job, 0, job.height);
+  }
+  return 0;
+}
+
+LIBYUV_API
+int I420ScaleRotate(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_y,
+                    int dst_stride_y,
+                    uint8_t* dst_u,
+                    int dst_stride_u,
+                    uint8_t* dst_v,
+                    int dst_stride_v,
+                    int dst_width,
+                    int dst_height,
+                    enum RotationMode mode,
+                    enum FilterMode filtering) {
+  if (!src_v) {
+    return -1;
+  }
+  return ScaleRotate(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                     src_stride_v, src_width, src_height, dst_y, dst_stride_y,
+                     dst_u, dst_stride_u, dst_v, dst_stride_v, dst_width,
+                     dst_height, mode, filtering);
+}
+
+LIBYUV_API
+int NV12ToI420ScaleRotate(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum RotationMode mode,
+                          enum FilterMode filtering) {
+  return ScaleRotate(src_y, src_stride_y, src_uv, src_stride_uv, NULL, 0,
+                     src_width, src_height, dst_y, dst_stride_y, dst_u,
+                     dst_stride_u, dst_v, dst_stride_v, dst_width, dst_height,
+                     mode, filtering);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
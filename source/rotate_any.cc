@@ -18,35 +18,42 @@ namespace libyuv {
 extern "C" {
 #endif
 
-#define TANY(NAMEANY, TPOS_SIMD, MASK)                                        \
-  void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst,              \
-               int dst_stride, int width) {                                   \
-    int r = width & MASK;                                                     \
-    int n = width - r;                                                        \
-    if (n > 0) {                                                              \
-      TPOS_SIMD(src, src_stride, dst, dst_stride, n);                         \
-    }                                                                         \
-    TransposeWx8_C(src + n, src_stride, dst + n * dst_stride, dst_stride, r); \
+#define TANY(NAMEANY, TPOS_SIMD, TPOS_C, MASK)                        \
+  void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst,      \
+               int dst_stride, int width) {                           \
+    int r = width & MASK;                                             \
+    int n = width - r;                                                \
+    if (n > 0) {                                                      \
+      TPOS_SIMD(src, src_stride, dst, dst_stride, n);                 \
+    }                                                                 \
+    TPOS_C(src + n, src_stride, dst + n * dst_stride, dst_stride, r); \
   }
 
 #ifdef HAS_TRANSPOSEWX8_NEON
-TANY(TransposeWx8_Any_NEON, TransposeWx8_NEON, 7)
+TANY(TransposeWx8_Any_NEON, TransposeWx8_NEON, TransposeWx8_C, 7)
 #endif
 #ifdef HAS_TRANSPOSEWX8_SSSE3
-TANY(TransposeWx8_Any_SSSE3, TransposeWx8_SSSE3, 7)
+TANY(TransposeWx8_Any_SSSE3, TransposeWx8_SSSE3, TransposeWx8_C, 7)
 #endif
 #ifdef HAS_TRANSPOSEWX8_MMI
-TANY(TransposeWx8_Any_MMI, TransposeWx8_MMI, 7)
+TANY(TransposeWx8_Any_MMI, TransposeWx8_MMI, TransposeWx8_C, 7)
 #endif
 #ifdef HAS_TRANSPOSEWX8_FAST_SSSE3
-TANY(TransposeWx8_Fast_Any_SSSE3, TransposeWx8_Fast_SSSE3, 15)
+TANY(TransposeWx8_Fast_Any_SSSE3, TransposeWx8_Fast_SSSE3, TransposeWx8_C, 15)
 #endif
 #ifdef HAS_TRANSPOSEWX16_MSA
-TANY(TransposeWx16_Any_MSA, TransposeWx16_MSA, 15)
+TANY(TransposeWx16_Any_MSA, TransposeWx16_MSA, TransposeWx16_C, 15)
+#endif
+#ifdef HAS_TRANSPOSEWX16_AVX2
+TANY(TransposeWx16_Any_AVX2, TransposeWx16_AVX2, TransposeWx16_C, 15)
+#endif
+#ifdef HAS_TRANSPOSEWX16_AVX512VBMI
+TANY(TransposeWx16_Any_AVX512VBMI, TransposeWx16_AVX512VBMI, TransposeWx16_C,
+     15)
 #endif
 #undef TANY
 
-#define TUVANY(NAMEANY, TPOS_SIMD, MASK)                                       \
+#define TUVANY(NAMEANY, TPOS_SIMD, TPOS_C, MASK)                               \
   void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst_a,             \
                int dst_stride_a, uint8_t* dst_b, int dst_stride_b,             \
                int width) {                                                    \
@@ -55,24 +62,73 @@ TANY(TransposeWx16_Any_MSA, TransposeWx16_MSA, 15)
     if (n > 0) {                                                               \
       TPOS_SIMD(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b, n); \
     }                                                                          \
-    TransposeUVWx8_C(src + n * 2, src_stride, dst_a + n * dst_stride_a,        \
-                     dst_stride_a, dst_b + n * dst_stride_b, dst_stride_b, r); \
+    TPOS_C(src + n * 2, src_stride, dst_a + n * dst_stride_a, dst_stride_a,    \
+           dst_b + n * dst_stride_b, dst_stride_b, r);                         \
   }
 
 #ifdef HAS_TRANSPOSEUVWX8_NEON
-TUVANY(TransposeUVWx8_Any_NEON, TransposeUVWx8_NEON, 7)
+TUVANY(TransposeUVWx8_Any_NEON, TransposeUVWx8_NEON, TransposeUVWx8_C, 7)
 #endif
 #ifdef HAS_TRANSPOSEUVWX8_SSE2
-TUVANY(TransposeUVWx8_Any_SSE2, TransposeUVWx8_SSE2, 7)
+TUVANY(TransposeUVWx8_Any_SSE2, TransposeUVWx8_SSE2, TransposeUVWx8_C, 7)
 #endif
 #ifdef HAS_TRANSPOSEUVWX8_MMI
-TUVANY(TransposeUVWx8_Any_MMI, TransposeUVWx8_MMI, 7)
+TUVANY(TransposeUVWx8_Any_MMI, TransposeUVWx8_MMI, TransposeUVWx8_C, 7)
 #endif
 #ifdef HAS_TRANSPOSEUVWX16_MSA
-TUVANY(TransposeUVWx16_Any_MSA, TransposeUVWx16_MSA, 7)
+TUVANY(TransposeUVWx16_Any_MSA, TransposeUVWx16_MSA, TransposeUVWx16_C, 7)
+#endif
+#ifdef HAS_TRANSPOSEUVWX16_AVX2
+TUVANY(TransposeUVWx16_Any_AVX2, TransposeUVWx16_AVX2, TransposeUVWx16_C, 7)
+#endif
+#ifdef HAS_TRANSPOSEUVWX16_AVX512VBMI
+TUVANY(TransposeUVWx16_Any_AVX512VBMI, TransposeUVWx16_AVX512VBMI,
+       TransposeUVWx16_C, 7)
 #endif
 #undef TUVANY
 
+#define TANY_16(NAMEANY, TPOS_SIMD, TPOS_C, MASK)                     \
+  void NAMEANY(const uint16_t* src, int src_stride, uint16_t* dst,    \
+               int dst_stride, int width) {                           \
+    int r = width & MASK;                                             \
+    int n = width - r;                                                \
+    if (n > 0) {                                                      \
+      TPOS_SIMD(src, src_stride, dst, dst_stride, n);                 \
+    }                                                                 \
+    TPOS_C(src + n, src_stride, dst + n * dst_stride, dst_stride, r); \
+  }
+
+#ifdef HAS_TRANSPOSEWX8_16_SSE2
+TANY_16(TransposeWx8_16_Any_SSE2, TransposeWx8_16_SSE2, TransposeWx8_16_C, 7)
+#endif
+#undef TANY_16
+
+// Any 4 byte pixel transpose. The remaining source columns use C.
+#define TARGBANY(NAMEANY, TPOS_SIMD, TPOS_C, MASK)                        \
+  void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst,          \
+               int dst_stride, int width) {                               \
+    int r = width & MASK;                                                 \
+    int n = width - r;                                                    \
+    if (n > 0) {                                                          \
+      TPOS_SIMD(src, src_stride, dst, dst_stride, n);                     \
+    }                                                                     \
+    TPOS_C(src + n * 4, src_stride, dst + n * dst_stride, dst_stride, r); \
+  }
+
+#ifdef HAS_TRANSPOSEARGBWX4_SSE2
+TARGBANY(TransposeARGBWx4_Any_SSE2, TransposeARGBWx4_SSE2, TransposeARGBWx4_C,
+         3)
+#endif
+#ifdef HAS_TRANSPOSEARGBWX8_AVX2
+TARGBANY(TransposeARGBWx8_Any_AVX2, TransposeARGBWx8_AVX2, TransposeARGBWx8_C,
+         7)
+#endif
+#ifdef HAS_TRANSPOSEARGBWX4_NEON
+TARGBANY(TransposeARGBWx4_Any_NEON, TransposeARGBWx4_NEON, TransposeARGBWx4_C,
+         3)
+#endif
+#undef TARGBANY
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
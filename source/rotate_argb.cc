@@ -13,62 +13,74 @@
 #include "libyuv/convert.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/rotate_row.h"
 #include "libyuv/row.h"
-#include "libyuv/scale_row.h" /* for ScaleARGBRowDownEven_ */
 
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
 #endif
 
+// Source columns transposed per block. 16 pixels is one cache line of each
+// source row, and the 16 destination rows are written sequentially while
+// the tiles walk down the source.
+static const int kARGBTransposeBlock = 16;
+
 static void ARGBTranspose(const uint8_t* src_argb,
                           int src_stride_argb,
                           uint8_t* dst_argb,
                           int dst_stride_argb,
                           int width,
                           int height) {
-  int i;
-  int src_pixel_step = src_stride_argb >> 2;
-  void (*ScaleARGBRowDownEven)(
-      const uint8_t* src_argb, ptrdiff_t src_stride_argb, int src_step,
-      uint8_t* dst_argb, int dst_width) = ScaleARGBRowDownEven_C;
-#if defined(HAS_SCALEARGBROWDOWNEVEN_SSE2)
+  int x;
+  int tile_height = 4;
+  void (*TransposeARGBTile)(const uint8_t* src, int src_stride, uint8_t* dst,
+                            int dst_stride, int width) = TransposeARGBWx4_C;
+#if defined(HAS_TRANSPOSEARGBWX4_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
-    ScaleARGBRowDownEven = ScaleARGBRowDownEven_Any_SSE2;
-    if (IS_ALIGNED(height, 4)) {  // Width of dest.
-      ScaleARGBRowDownEven = ScaleARGBRowDownEven_SSE2;
-    }
-  }
-#endif
-#if defined(HAS_SCALEARGBROWDOWNEVEN_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ScaleARGBRowDownEven = ScaleARGBRowDownEven_Any_NEON;
-    if (IS_ALIGNED(height, 4)) {  // Width of dest.
-      ScaleARGBRowDownEven = ScaleARGBRowDownEven_NEON;
+    TransposeARGBTile = TransposeARGBWx4_Any_SSE2;
+    if (IS_ALIGNED(width, 4)) {
+      TransposeARGBTile = TransposeARGBWx4_SSE2;
     }
   }
 #endif
-#if defined(HAS_SCALEARGBROWDOWNEVEN_MSA)
-  if (TestCpuFlag(kCpuHasMSA)) {
-    ScaleARGBRowDownEven = ScaleARGBRowDownEven_Any_MSA;
-    if (IS_ALIGNED(height, 4)) {  // Width of dest.
-      ScaleARGBRowDownEven = ScaleARGBRowDownEven_MSA;
+#if defined(HAS_TRANSPOSEARGBWX8_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    TransposeARGBTile = TransposeARGBWx8_Any_AVX2;
+    tile_height = 8;
+    if (IS_ALIGNED(width, 8)) {
+      TransposeARGBTile = TransposeARGBWx8_AVX2;
     }
   }
 #endif
-#if defined(HAS_SCALEARGBROWDOWNEVEN_MMI)
-  if (TestCpuFlag(kCpuHasMMI)) {
-    ScaleARGBRowDownEven = ScaleARGBRowDownEven_Any_MMI;
-    if (IS_ALIGNED(height, 4)) {  // Width of dest.
-      ScaleARGBRowDownEven = ScaleARGBRowDownEven_MMI;
+#if defined(HAS_TRANSPOSEARGBWX4_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    TransposeARGBTile = TransposeARGBWx4_Any_NEON;
+    if (IS_ALIGNED(width, 4)) {
+      TransposeARGBTile = TransposeARGBWx4_NEON;
     }
   }
 #endif
 
-  for (i = 0; i < width; ++i) {  // column of source to row of dest.
-    ScaleARGBRowDownEven(src_argb, 0, src_pixel_step, dst_argb, height);
-    dst_argb += dst_stride_argb;
-    src_argb += 4;
+  // Each block of source columns becomes a block of destination rows.
+  for (x = 0; x < width; x += kARGBTransposeBlock) {
+    int block_width = width - x;
+    const uint8_t* src = src_argb + x * 4;
+    uint8_t* dst = dst_argb + x * dst_stride_argb;
+    int y;
+    if (block_width > kARGBTransposeBlock) {
+      block_width = kARGBTransposeBlock;
+    }
+    for (y = 0; y <= height - tile_height; y += tile_height) {
+      TransposeARGBTile(src, src_stride_argb, dst, dst_stride_argb,
+                        block_width);
+      src += src_stride_argb * tile_height;
+      dst += tile_height * 4;
+    }
+    if (y < height) {
+      TransposeARGBWxH_C(src, src_stride_argb, dst, dst_stride_argb,
+                         block_width, height - y);
+    }
   }
 }
 
@@ -173,6 +185,11 @@ void ARGBRotate180(const uint8_t* src_argb,
     CopyRow = CopyRow_ERMS;
   }
 #endif
+#if defined(HAS_COPYROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW) && IS_ALIGNED(width * 4, 128)) {
+    CopyRow = CopyRow_AVX512BW;
+  }
+#endif
 #if defined(HAS_COPYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     CopyRow = IS_ALIGNED(width * 4, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
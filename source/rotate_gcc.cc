@@ -366,6 +366,666 @@ void TransposeUVWx8_SSE2(const uint8_t* src,
         "xmm7", "xmm8", "xmm9");
 }
 #endif  // defined(HAS_TRANSPOSEUVWX8_SSE2)
+
+#if defined(HAS_TRANSPOSEWX16_AVX2)
+// Transpose 16x16 bytes. Rows 0-7 and 8-15 are transposed as 8 rows in
+// each lane, which gives 2 columns of 8 rows per lane, and vpermq joins the
+// halves of each column.
+void TransposeWx16_AVX2(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width) {
+  const uint8_t* src4 = src + src_stride * 4;
+  const uint8_t* src8 = src + src_stride * 8;
+  const uint8_t* src12 = src + src_stride * 12;
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      // Read 16 rows of 16 bytes. Rows 0-7 are in low lanes, 8-15 in high.
+      "vmovdqu    (%0),%%xmm0                    \n"
+      "vinserti128 $0x1,(%2),%%ymm0,%%ymm0       \n"
+      "vmovdqu    (%0,%6),%%xmm1                 \n"
+      "vinserti128 $0x1,(%2,%6),%%ymm1,%%ymm1    \n"
+      "vmovdqu    (%0,%6,2),%%xmm2               \n"
+      "vinserti128 $0x1,(%2,%6,2),%%ymm2,%%ymm2  \n"
+      "vmovdqu    (%0,%7),%%xmm3                 \n"
+      "vinserti128 $0x1,(%2,%7),%%ymm3,%%ymm3    \n"
+      "vmovdqu    (%1),%%xmm4                    \n"
+      "vinserti128 $0x1,(%3),%%ymm4,%%ymm4       \n"
+      "vmovdqu    (%1,%6),%%xmm5                 \n"
+      "vinserti128 $0x1,(%3,%6),%%ymm5,%%ymm5    \n"
+      "vmovdqu    (%1,%6,2),%%xmm6               \n"
+      "vinserti128 $0x1,(%3,%6,2),%%ymm6,%%ymm6  \n"
+      "vmovdqu    (%1,%7),%%xmm7                 \n"
+      "vinserti128 $0x1,(%3,%7),%%ymm7,%%ymm7    \n"
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+      "lea        0x10(%2),%2                    \n"
+      "lea        0x10(%3),%3                    \n"
+      // Unpack bytes, words and dwords within each lane.
+      "vpunpcklbw %%ymm1,%%ymm0,%%ymm8           \n"
+      "vpunpckhbw %%ymm1,%%ymm0,%%ymm9           \n"
+      "vpunpcklbw %%ymm3,%%ymm2,%%ymm10          \n"
+      "vpunpckhbw %%ymm3,%%ymm2,%%ymm11          \n"
+      "vpunpcklbw %%ymm5,%%ymm4,%%ymm12          \n"
+      "vpunpckhbw %%ymm5,%%ymm4,%%ymm13          \n"
+      "vpunpcklbw %%ymm7,%%ymm6,%%ymm14          \n"
+      "vpunpckhbw %%ymm7,%%ymm6,%%ymm15          \n"
+      "vpunpcklwd %%ymm10,%%ymm8,%%ymm0          \n"
+      "vpunpckhwd %%ymm10,%%ymm8,%%ymm1          \n"
+      "vpunpcklwd %%ymm11,%%ymm9,%%ymm2          \n"
+      "vpunpckhwd %%ymm11,%%ymm9,%%ymm3          \n"
+      "vpunpcklwd %%ymm14,%%ymm12,%%ymm4         \n"
+      "vpunpckhwd %%ymm14,%%ymm12,%%ymm5         \n"
+      "vpunpcklwd %%ymm15,%%ymm13,%%ymm6         \n"
+      "vpunpckhwd %%ymm15,%%ymm13,%%ymm7         \n"
+      "vpunpckldq %%ymm4,%%ymm0,%%ymm8           \n"
+      "vpunpckhdq %%ymm4,%%ymm0,%%ymm9           \n"
+      "vpunpckldq %%ymm5,%%ymm1,%%ymm10          \n"
+      "vpunpckhdq %%ymm5,%%ymm1,%%ymm11          \n"
+      "vpunpckldq %%ymm6,%%ymm2,%%ymm12          \n"
+      "vpunpckhdq %%ymm6,%%ymm2,%%ymm13          \n"
+      "vpunpckldq %%ymm7,%%ymm3,%%ymm14          \n"
+      "vpunpckhdq %%ymm7,%%ymm3,%%ymm15          \n"
+      // Each lane holds 2 columns of 8 rows. Swap to 2 columns of 16 rows.
+      "vpermq     $0xd8,%%ymm8,%%ymm8            \n"
+      "vpermq     $0xd8,%%ymm9,%%ymm9            \n"
+      "vpermq     $0xd8,%%ymm10,%%ymm10          \n"
+      "vpermq     $0xd8,%%ymm11,%%ymm11          \n"
+      "vpermq     $0xd8,%%ymm12,%%ymm12          \n"
+      "vpermq     $0xd8,%%ymm13,%%ymm13          \n"
+      "vpermq     $0xd8,%%ymm14,%%ymm14          \n"
+      "vpermq     $0xd8,%%ymm15,%%ymm15          \n"
+      "vmovdqu    %%xmm8,(%4)                    \n"
+      "vextracti128 $0x1,%%ymm8,(%4,%8)          \n"
+      "vmovdqu    %%xmm9,(%4,%8,2)               \n"
+      "vextracti128 $0x1,%%ymm9,(%4,%9)          \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "vmovdqu    %%xmm10,(%4)                   \n"
+      "vextracti128 $0x1,%%ymm10,(%4,%8)         \n"
+      "vmovdqu    %%xmm11,(%4,%8,2)              \n"
+      "vextracti128 $0x1,%%ymm11,(%4,%9)         \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "vmovdqu    %%xmm12,(%4)                   \n"
+      "vextracti128 $0x1,%%ymm12,(%4,%8)         \n"
+      "vmovdqu    %%xmm13,(%4,%8,2)              \n"
+      "vextracti128 $0x1,%%ymm13,(%4,%9)         \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "vmovdqu    %%xmm14,(%4)                   \n"
+      "vextracti128 $0x1,%%ymm14,(%4,%8)         \n"
+      "vmovdqu    %%xmm15,(%4,%8,2)              \n"
+      "vextracti128 $0x1,%%ymm15,(%4,%9)         \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "sub        $0x10,%5                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src),                        // %0
+        "+r"(src4),                       // %1
+        "+r"(src8),                       // %2
+        "+r"(src12),                      // %3
+        "+r"(dst),                        // %4
+        "+r"(width)                       // %5
+      : "r"((intptr_t)(src_stride)),      // %6
+        "r"((intptr_t)(src_stride * 3)),  // %7
+        "r"((intptr_t)(dst_stride)),      // %8
+        "r"((intptr_t)(dst_stride * 3))   // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // defined(HAS_TRANSPOSEWX16_AVX2)
+
+#if defined(HAS_TRANSPOSEUVWX16_AVX2)
+// Transpose 16 rows of 8 UV pairs. U and V are the even and odd columns of
+// the byte transpose, so each lane pair is a row of U and a row of V.
+void TransposeUVWx16_AVX2(const uint8_t* src,
+                          int src_stride,
+                          uint8_t* dst_a,
+                          int dst_stride_a,
+                          uint8_t* dst_b,
+                          int dst_stride_b,
+                          int width) {
+  const uint8_t* src4 = src + src_stride * 4;
+  const uint8_t* src8 = src + src_stride * 8;
+  const uint8_t* src12 = src + src_stride * 12;
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      // Read 16 rows of 8 UV. Rows 0-7 are in low lanes, 8-15 in high.
+      "vmovdqu    (%0),%%xmm0                    \n"
+      "vinserti128 $0x1,(%2),%%ymm0,%%ymm0       \n"
+      "vmovdqu    (%0,%7),%%xmm1                 \n"
+      "vinserti128 $0x1,(%2,%7),%%ymm1,%%ymm1    \n"
+      "vmovdqu    (%0,%7,2),%%xmm2               \n"
+      "vinserti128 $0x1,(%2,%7,2),%%ymm2,%%ymm2  \n"
+      "vmovdqu    (%0,%8),%%xmm3                 \n"
+      "vinserti128 $0x1,(%2,%8),%%ymm3,%%ymm3    \n"
+      "vmovdqu    (%1),%%xmm4                    \n"
+      "vinserti128 $0x1,(%3),%%ymm4,%%ymm4       \n"
+      "vmovdqu    (%1,%7),%%xmm5                 \n"
+      "vinserti128 $0x1,(%3,%7),%%ymm5,%%ymm5    \n"
+      "vmovdqu    (%1,%7,2),%%xmm6               \n"
+      "vinserti128 $0x1,(%3,%7,2),%%ymm6,%%ymm6  \n"
+      "vmovdqu    (%1,%8),%%xmm7                 \n"
+      "vinserti128 $0x1,(%3,%8),%%ymm7,%%ymm7    \n"
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+      "lea        0x10(%2),%2                    \n"
+      "lea        0x10(%3),%3                    \n"
+      // Unpack bytes, words and dwords within each lane.
+      "vpunpcklbw %%ymm1,%%ymm0,%%ymm8           \n"
+      "vpunpckhbw %%ymm1,%%ymm0,%%ymm9           \n"
+      "vpunpcklbw %%ymm3,%%ymm2,%%ymm10          \n"
+      "vpunpckhbw %%ymm3,%%ymm2,%%ymm11          \n"
+      "vpunpcklbw %%ymm5,%%ymm4,%%ymm12          \n"
+      "vpunpckhbw %%ymm5,%%ymm4,%%ymm13          \n"
+      "vpunpcklbw %%ymm7,%%ymm6,%%ymm14          \n"
+      "vpunpckhbw %%ymm7,%%ymm6,%%ymm15          \n"
+      "vpunpcklwd %%ymm10,%%ymm8,%%ymm0          \n"
+      "vpunpckhwd %%ymm10,%%ymm8,%%ymm1          \n"
+      "vpunpcklwd %%ymm11,%%ymm9,%%ymm2          \n"
+      "vpunpckhwd %%ymm11,%%ymm9,%%ymm3          \n"
+      "vpunpcklwd %%ymm14,%%ymm12,%%ymm4         \n"
+      "vpunpckhwd %%ymm14,%%ymm12,%%ymm5         \n"
+      "vpunpcklwd %%ymm15,%%ymm13,%%ymm6         \n"
+      "vpunpckhwd %%ymm15,%%ymm13,%%ymm7         \n"
+      "vpunpckldq %%ymm4,%%ymm0,%%ymm8           \n"
+      "vpunpckhdq %%ymm4,%%ymm0,%%ymm9           \n"
+      "vpunpckldq %%ymm5,%%ymm1,%%ymm10          \n"
+      "vpunpckhdq %%ymm5,%%ymm1,%%ymm11          \n"
+      "vpunpckldq %%ymm6,%%ymm2,%%ymm12          \n"
+      "vpunpckhdq %%ymm6,%%ymm2,%%ymm13          \n"
+      "vpunpckldq %%ymm7,%%ymm3,%%ymm14          \n"
+      "vpunpckhdq %%ymm7,%%ymm3,%%ymm15          \n"
+      // Each lane holds 2 columns of 8 rows. Swap to 2 columns of 16 rows.
+      "vpermq     $0xd8,%%ymm8,%%ymm8            \n"
+      "vpermq     $0xd8,%%ymm9,%%ymm9            \n"
+      "vpermq     $0xd8,%%ymm10,%%ymm10          \n"
+      "vpermq     $0xd8,%%ymm11,%%ymm11          \n"
+      "vpermq     $0xd8,%%ymm12,%%ymm12          \n"
+      "vpermq     $0xd8,%%ymm13,%%ymm13          \n"
+      "vpermq     $0xd8,%%ymm14,%%ymm14          \n"
+      "vpermq     $0xd8,%%ymm15,%%ymm15          \n"
+      // Low lanes are U and high lanes are V.
+      "vmovdqu    %%xmm8,(%4)                    \n"
+      "vextracti128 $0x1,%%ymm8,(%5)             \n"
+      "vmovdqu    %%xmm9,(%4,%9)                 \n"
+      "vextracti128 $0x1,%%ymm9,(%5,%10)         \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "vmovdqu    %%xmm10,(%4)                   \n"
+      "vextracti128 $0x1,%%ymm10,(%5)            \n"
+      "vmovdqu    %%xmm11,(%4,%9)                \n"
+      "vextracti128 $0x1,%%ymm11,(%5,%10)        \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "vmovdqu    %%xmm12,(%4)                   \n"
+      "vextracti128 $0x1,%%ymm12,(%5)            \n"
+      "vmovdqu    %%xmm13,(%4,%9)                \n"
+      "vextracti128 $0x1,%%ymm13,(%5,%10)        \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "vmovdqu    %%xmm14,(%4)                   \n"
+      "vextracti128 $0x1,%%ymm14,(%5)            \n"
+      "vmovdqu    %%xmm15,(%4,%9)                \n"
+      "vextracti128 $0x1,%%ymm15,(%5,%10)        \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "sub        $0x8,%6                        \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src),                        // %0
+        "+r"(src4),                       // %1
+        "+r"(src8),                       // %2
+        "+r"(src12),                      // %3
+        "+r"(dst_a),                      // %4
+        "+r"(dst_b),                      // %5
+        "+r"(width)                       // %6
+      : "r"((intptr_t)(src_stride)),      // %7
+        "r"((intptr_t)(src_stride * 3)),  // %8
+        "r"((intptr_t)(dst_stride_a)),    // %9
+        "r"((intptr_t)(dst_stride_b))     // %10
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // defined(HAS_TRANSPOSEUVWX16_AVX2)
+
+#if defined(HAS_TRANSPOSEWX16_AVX512VBMI)
+// vpermi2b indices to transpose 8x8 bytes from 8 rows of 16 bytes. The
+// byte for column c of row r is at 16 * r + c.
+static const uint8_t kTransposeLo_AVX512[64] = {
+    0u,   16u,  32u,  48u,  64u,  80u,  96u,  112u, 1u,   17u,  33u,  49u,
+    65u,  81u,  97u,  113u, 2u,   18u,  34u,  50u,  66u,  82u,  98u,  114u,
+    3u,   19u,  35u,  51u,  67u,  83u,  99u,  115u, 4u,   20u,  36u,  52u,
+    68u,  84u,  100u, 116u, 5u,   21u,  37u,  53u,  69u,  85u,  101u, 117u,
+    6u,   22u,  38u,  54u,  70u,  86u,  102u, 118u, 7u,   23u,  39u,  55u,
+    71u,  87u,  103u, 119u};
+static const uint8_t kTransposeHi_AVX512[64] = {
+    8u,   24u,  40u,  56u,  72u,  88u,  104u, 120u, 9u,   25u,  41u,  57u,
+    73u,  89u,  105u, 121u, 10u,  26u,  42u,  58u,  74u,  90u,  106u, 122u,
+    11u,  27u,  43u,  59u,  75u,  91u,  107u, 123u, 12u,  28u,  44u,  60u,
+    76u,  92u,  108u, 124u, 13u,  29u,  45u,  61u,  77u,  93u,  109u, 125u,
+    14u,  30u,  46u,  62u,  78u,  94u,  110u, 126u, 15u,  31u,  47u,  63u,
+    79u,  95u,  111u, 127u};
+
+// vpermi2q indices to interleave columns of rows 0-7 and rows 8-15.
+static const uint64_t kTransposeQLo_AVX512[8] = {0, 8, 1, 9, 2, 10, 3, 11};
+static const uint64_t kTransposeQHi_AVX512[8] = {4, 12, 5, 13, 6, 14, 7, 15};
+
+// Transpose 16x16 bytes with 2 permutes: vpermi2b gathers 8x8 blocks from
+// pairs of registers holding 4 rows each, and vpermi2q interleaves the
+// blocks of rows 0-7 and 8-15 into 4 columns of 16 rows per register.
+void TransposeWx16_AVX512VBMI(const uint8_t* src,
+                              int src_stride,
+                              uint8_t* dst,
+                              int dst_stride,
+                              int width) {
+  const uint8_t* src4 = src + src_stride * 4;
+  const uint8_t* src8 = src + src_stride * 8;
+  const uint8_t* src12 = src + src_stride * 12;
+  asm volatile(
+      "vmovdqu64  %10,%%zmm12                    \n"
+      "vmovdqu64  %11,%%zmm13                    \n"
+      "vmovdqu64  %12,%%zmm14                    \n"
+      "vmovdqu64  %13,%%zmm15                    \n"
+      LABELALIGN
+      "1:                                        \n"
+      // Read 16 rows of 16 bytes, 4 rows per register.
+      "vmovdqu    (%0),%%xmm0                    \n"
+      "vinserti32x4 $0x1,(%0,%6),%%zmm0,%%zmm0   \n"
+      "vinserti32x4 $0x2,(%0,%6,2),%%zmm0,%%zmm0 \n"
+      "vinserti32x4 $0x3,(%0,%7),%%zmm0,%%zmm0   \n"
+      "vmovdqu    (%1),%%xmm1                    \n"
+      "vinserti32x4 $0x1,(%1,%6),%%zmm1,%%zmm1   \n"
+      "vinserti32x4 $0x2,(%1,%6,2),%%zmm1,%%zmm1 \n"
+      "vinserti32x4 $0x3,(%1,%7),%%zmm1,%%zmm1   \n"
+      "vmovdqu    (%2),%%xmm2                    \n"
+      "vinserti32x4 $0x1,(%2,%6),%%zmm2,%%zmm2   \n"
+      "vinserti32x4 $0x2,(%2,%6,2),%%zmm2,%%zmm2 \n"
+      "vinserti32x4 $0x3,(%2,%7),%%zmm2,%%zmm2   \n"
+      "vmovdqu    (%3),%%xmm3                    \n"
+      "vinserti32x4 $0x1,(%3,%6),%%zmm3,%%zmm3   \n"
+      "vinserti32x4 $0x2,(%3,%6,2),%%zmm3,%%zmm3 \n"
+      "vinserti32x4 $0x3,(%3,%7),%%zmm3,%%zmm3   \n"
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+      "lea        0x10(%2),%2                    \n"
+      "lea        0x10(%3),%3                    \n"
+      // 8x8 blocks of bytes: columns 0-7 and 8-15 of rows 0-7 and 8-15.
+      "vmovdqa64  %%zmm12,%%zmm4                 \n"
+      "vpermi2b   %%zmm1,%%zmm0,%%zmm4           \n"
+      "vmovdqa64  %%zmm13,%%zmm5                 \n"
+      "vpermi2b   %%zmm1,%%zmm0,%%zmm5           \n"
+      "vmovdqa64  %%zmm12,%%zmm6                 \n"
+      "vpermi2b   %%zmm3,%%zmm2,%%zmm6           \n"
+      "vmovdqa64  %%zmm13,%%zmm7                 \n"
+      "vpermi2b   %%zmm3,%%zmm2,%%zmm7           \n"
+      // Interleave the blocks into 4 columns of 16 rows.
+      "vmovdqa64  %%zmm14,%%zmm8                 \n"
+      "vpermi2q   %%zmm6,%%zmm4,%%zmm8           \n"
+      "vmovdqa64  %%zmm15,%%zmm9                 \n"
+      "vpermi2q   %%zmm6,%%zmm4,%%zmm9           \n"
+      "vmovdqa64  %%zmm14,%%zmm10                \n"
+      "vpermi2q   %%zmm7,%%zmm5,%%zmm10          \n"
+      "vmovdqa64  %%zmm15,%%zmm11                \n"
+      "vpermi2q   %%zmm7,%%zmm5,%%zmm11          \n"
+      "vmovdqu    %%xmm8,(%4)                    \n"
+      "vextracti32x4 $0x1,%%zmm8,(%4,%8)         \n"
+      "vextracti32x4 $0x2,%%zmm8,(%4,%8,2)       \n"
+      "vextracti32x4 $0x3,%%zmm8,(%4,%9)         \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "vmovdqu    %%xmm9,(%4)                    \n"
+      "vextracti32x4 $0x1,%%zmm9,(%4,%8)         \n"
+      "vextracti32x4 $0x2,%%zmm9,(%4,%8,2)       \n"
+      "vextracti32x4 $0x3,%%zmm9,(%4,%9)         \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "vmovdqu    %%xmm10,(%4)                   \n"
+      "vextracti32x4 $0x1,%%zmm10,(%4,%8)        \n"
+      "vextracti32x4 $0x2,%%zmm10,(%4,%8,2)      \n"
+      "vextracti32x4 $0x3,%%zmm10,(%4,%9)        \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "vmovdqu    %%xmm11,(%4)                   \n"
+      "vextracti32x4 $0x1,%%zmm11,(%4,%8)        \n"
+      "vextracti32x4 $0x2,%%zmm11,(%4,%8,2)      \n"
+      "vextracti32x4 $0x3,%%zmm11,(%4,%9)        \n"
+      "lea        (%4,%8,4),%4                   \n"
+      "sub        $0x10,%5                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src),                        // %0
+        "+r"(src4),                       // %1
+        "+r"(src8),                       // %2
+        "+r"(src12),                      // %3
+        "+r"(dst),                        // %4
+        "+r"(width)                       // %5
+      : "r"((intptr_t)(src_stride)),      // %6
+        "r"((intptr_t)(src_stride * 3)),  // %7
+        "r"((intptr_t)(dst_stride)),      // %8
+        "r"((intptr_t)(dst_stride * 3)),  // %9
+        "m"(kTransposeLo_AVX512),         // %10
+        "m"(kTransposeHi_AVX512),         // %11
+        "m"(kTransposeQLo_AVX512),        // %12
+        "m"(kTransposeQHi_AVX512)         // %13
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // defined(HAS_TRANSPOSEWX16_AVX512VBMI)
+
+#if defined(HAS_TRANSPOSEUVWX16_AVX512VBMI)
+// Transpose 16 rows of 8 UV pairs. Columns of the byte transpose alternate
+// between U and V.
+void TransposeUVWx16_AVX512VBMI(const uint8_t* src,
+                                int src_stride,
+                                uint8_t* dst_a,
+                                int dst_stride_a,
+                                uint8_t* dst_b,
+                                int dst_stride_b,
+                                int width) {
+  const uint8_t* src4 = src + src_stride * 4;
+  const uint8_t* src8 = src + src_stride * 8;
+  const uint8_t* src12 = src + src_stride * 12;
+  asm volatile(
+      "vmovdqu64  %11,%%zmm12                    \n"
+      "vmovdqu64  %12,%%zmm13                    \n"
+      "vmovdqu64  %13,%%zmm14                    \n"
+      "vmovdqu64  %14,%%zmm15                    \n"
+      LABELALIGN
+      "1:                                        \n"
+      // Read 16 rows of 8 UV, 4 rows per register.
+      "vmovdqu    (%0),%%xmm0                    \n"
+      "vinserti32x4 $0x1,(%0,%7),%%zmm0,%%zmm0   \n"
+      "vinserti32x4 $0x2,(%0,%7,2),%%zmm0,%%zmm0 \n"
+      "vinserti32x4 $0x3,(%0,%8),%%zmm0,%%zmm0   \n"
+      "vmovdqu    (%1),%%xmm1                    \n"
+      "vinserti32x4 $0x1,(%1,%7),%%zmm1,%%zmm1   \n"
+      "vinserti32x4 $0x2,(%1,%7,2),%%zmm1,%%zmm1 \n"
+      "vinserti32x4 $0x3,(%1,%8),%%zmm1,%%zmm1   \n"
+      "vmovdqu    (%2),%%xmm2                    \n"
+      "vinserti32x4 $0x1,(%2,%7),%%zmm2,%%zmm2   \n"
+      "vinserti32x4 $0x2,(%2,%7,2),%%zmm2,%%zmm2 \n"
+      "vinserti32x4 $0x3,(%2,%8),%%zmm2,%%zmm2   \n"
+      "vmovdqu    (%3),%%xmm3                    \n"
+      "vinserti32x4 $0x1,(%3,%7),%%zmm3,%%zmm3   \n"
+      "vinserti32x4 $0x2,(%3,%7,2),%%zmm3,%%zmm3 \n"
+      "vinserti32x4 $0x3,(%3,%8),%%zmm3,%%zmm3   \n"
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+      "lea        0x10(%2),%2                    \n"
+      "lea        0x10(%3),%3                    \n"
+      // 8x8 blocks of bytes: columns 0-7 and 8-15 of rows 0-7 and 8-15.
+      "vmovdqa64  %%zmm12,%%zmm4                 \n"
+      "vpermi2b   %%zmm1,%%zmm0,%%zmm4           \n"
+      "vmovdqa64  %%zmm13,%%zmm5                 \n"
+      "vpermi2b   %%zmm1,%%zmm0,%%zmm5           \n"
+      "vmovdqa64  %%zmm12,%%zmm6                 \n"
+      "vpermi2b   %%zmm3,%%zmm2,%%zmm6           \n"
+      "vmovdqa64  %%zmm13,%%zmm7                 \n"
+      "vpermi2b   %%zmm3,%%zmm2,%%zmm7           \n"
+      // Interleave the blocks into 4 columns of 16 rows.
+      "vmovdqa64  %%zmm14,%%zmm8                 \n"
+      "vpermi2q   %%zmm6,%%zmm4,%%zmm8           \n"
+      "vmovdqa64  %%zmm15,%%zmm9                 \n"
+      "vpermi2q   %%zmm6,%%zmm4,%%zmm9           \n"
+      "vmovdqa64  %%zmm14,%%zmm10                \n"
+      "vpermi2q   %%zmm7,%%zmm5,%%zmm10          \n"
+      "vmovdqa64  %%zmm15,%%zmm11                \n"
+      "vpermi2q   %%zmm7,%%zmm5,%%zmm11          \n"
+      // Columns alternate U and V.
+      "vmovdqu    %%xmm8,(%4)                    \n"
+      "vextracti32x4 $0x1,%%zmm8,(%5)            \n"
+      "vextracti32x4 $0x2,%%zmm8,(%4,%9)         \n"
+      "vextracti32x4 $0x3,%%zmm8,(%5,%10)        \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "vmovdqu    %%xmm9,(%4)                    \n"
+      "vextracti32x4 $0x1,%%zmm9,(%5)            \n"
+      "vextracti32x4 $0x2,%%zmm9,(%4,%9)         \n"
+      "vextracti32x4 $0x3,%%zmm9,(%5,%10)        \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "vmovdqu    %%xmm10,(%4)                   \n"
+      "vextracti32x4 $0x1,%%zmm10,(%5)           \n"
+      "vextracti32x4 $0x2,%%zmm10,(%4,%9)        \n"
+      "vextracti32x4 $0x3,%%zmm10,(%5,%10)       \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "vmovdqu    %%xmm11,(%4)                   \n"
+      "vextracti32x4 $0x1,%%zmm11,(%5)           \n"
+      "vextracti32x4 $0x2,%%zmm11,(%4,%9)        \n"
+      "vextracti32x4 $0x3,%%zmm11,(%5,%10)       \n"
+      "lea        (%4,%9,2),%4                   \n"
+      "lea        (%5,%10,2),%5                  \n"
+      "sub        $0x8,%6                        \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src),                        // %0
+        "+r"(src4),                       // %1
+        "+r"(src8),                       // %2
+        "+r"(src12),                      // %3
+        "+r"(dst_a),                      // %4
+        "+r"(dst_b),                      // %5
+        "+r"(width)                       // %6
+      : "r"((intptr_t)(src_stride)),      // %7
+        "r"((intptr_t)(src_stride * 3)),  // %8
+        "r"((intptr_t)(dst_stride_a)),    // %9
+        "r"((intptr_t)(dst_stride_b)),    // %10
+        "m"(kTransposeLo_AVX512),         // %11
+        "m"(kTransposeHi_AVX512),         // %12
+        "m"(kTransposeQLo_AVX512),        // %13
+        "m"(kTransposeQHi_AVX512)         // %14
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // defined(HAS_TRANSPOSEUVWX16_AVX512VBMI)
+
+#if defined(HAS_TRANSPOSEWX8_16_SSE2)
+// Transpose 8x8 shorts. Strides are in shorts.
+void TransposeWx8_16_SSE2(const uint16_t* src,
+                          int src_stride,
+                          uint16_t* dst,
+                          int dst_stride,
+                          int width) {
+  const uint16_t* src4 = src + src_stride * 4;
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      // Read 8 rows of 8 shorts.
+      "movdqu     (%0),%%xmm0                    \n"
+      "movdqu     (%0,%4),%%xmm1                 \n"
+      "movdqu     (%0,%4,2),%%xmm2               \n"
+      "movdqu     (%0,%5),%%xmm3                 \n"
+      "movdqu     (%1),%%xmm4                    \n"
+      "movdqu     (%1,%4),%%xmm5                 \n"
+      "movdqu     (%1,%4,2),%%xmm6               \n"
+      "movdqu     (%1,%5),%%xmm7                 \n"
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+      // Unpack words, dwords and qwords.
+      "movdqa     %%xmm0,%%xmm8                  \n"
+      "punpcklwd  %%xmm1,%%xmm0                  \n"
+      "punpckhwd  %%xmm1,%%xmm8                  \n"
+      "movdqa     %%xmm2,%%xmm9                  \n"
+      "punpcklwd  %%xmm3,%%xmm2                  \n"
+      "punpckhwd  %%xmm3,%%xmm9                  \n"
+      "movdqa     %%xmm4,%%xmm10                 \n"
+      "punpcklwd  %%xmm5,%%xmm4                  \n"
+      "punpckhwd  %%xmm5,%%xmm10                 \n"
+      "movdqa     %%xmm6,%%xmm11                 \n"
+      "punpcklwd  %%xmm7,%%xmm6                  \n"
+      "punpckhwd  %%xmm7,%%xmm11                 \n"
+      "movdqa     %%xmm0,%%xmm1                  \n"
+      "punpckldq  %%xmm2,%%xmm0                  \n"
+      "punpckhdq  %%xmm2,%%xmm1                  \n"
+      "movdqa     %%xmm8,%%xmm3                  \n"
+      "punpckldq  %%xmm9,%%xmm8                  \n"
+      "punpckhdq  %%xmm9,%%xmm3                  \n"
+      "movdqa     %%xmm4,%%xmm5                  \n"
+      "punpckldq  %%xmm6,%%xmm4                  \n"
+      "punpckhdq  %%xmm6,%%xmm5                  \n"
+      "movdqa     %%xmm10,%%xmm7                 \n"
+      "punpckldq  %%xmm11,%%xmm10                \n"
+      "punpckhdq  %%xmm11,%%xmm7                 \n"
+      "movdqa     %%xmm0,%%xmm2                  \n"
+      "punpcklqdq %%xmm4,%%xmm0                  \n"
+      "punpckhqdq %%xmm4,%%xmm2                  \n"
+      "movdqa     %%xmm1,%%xmm6                  \n"
+      "punpcklqdq %%xmm5,%%xmm1                  \n"
+      "punpckhqdq %%xmm5,%%xmm6                  \n"
+      "movdqa     %%xmm8,%%xmm9                  \n"
+      "punpcklqdq %%xmm10,%%xmm8                 \n"
+      "punpckhqdq %%xmm10,%%xmm9                 \n"
+      "movdqa     %%xmm3,%%xmm11                 \n"
+      "punpcklqdq %%xmm7,%%xmm3                  \n"
+      "punpckhqdq %%xmm7,%%xmm11                 \n"
+      "movdqu     %%xmm0,(%2)                    \n"
+      "movdqu     %%xmm2,(%2,%6)                 \n"
+      "movdqu     %%xmm1,(%2,%6,2)               \n"
+      "movdqu     %%xmm6,(%2,%7)                 \n"
+      "lea        (%2,%6,4),%2                   \n"
+      "movdqu     %%xmm8,(%2)                    \n"
+      "movdqu     %%xmm9,(%2,%6)                 \n"
+      "movdqu     %%xmm3,(%2,%6,2)               \n"
+      "movdqu     %%xmm11,(%2,%7)                \n"
+      "lea        (%2,%6,4),%2                   \n"
+      "sub        $0x8,%3                        \n"
+      "jg         1b                             \n"
+      : "+r"(src),                        // %0
+        "+r"(src4),                       // %1
+        "+r"(dst),                        // %2
+        "+r"(width)                       // %3
+      : "r"((intptr_t)(src_stride * 2)),  // %4
+        "r"((intptr_t)(src_stride * 6)),  // %5
+        "r"((intptr_t)(dst_stride * 2)),  // %6
+        "r"((intptr_t)(dst_stride * 6))   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11");
+}
+#endif  // defined(HAS_TRANSPOSEWX8_16_SSE2)
+
+#if defined(HAS_TRANSPOSEARGBWX4_SSE2)
+// Transpose 4 rows of ARGB pixels. Each loop reads a 4x4 block of pixels
+// and writes it as 4 rows of 4 pixels.
+void TransposeARGBWx4_SSE2(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width) {
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu     (%0),%%xmm0                    \n"
+      "movdqu     (%0,%3),%%xmm1                 \n"
+      "lea        (%0,%3,2),%0                   \n"
+      "movdqu     (%0),%%xmm2                    \n"
+      "movdqu     (%0,%3),%%xmm3                 \n"
+      "sub        %3,%0                          \n"
+      "sub        %3,%0                          \n"
+      "lea        0x10(%0),%0                    \n"
+      "movdqa     %%xmm0,%%xmm4                  \n"
+      "punpckldq  %%xmm1,%%xmm0                  \n"
+      "punpckhdq  %%xmm1,%%xmm4                  \n"
+      "movdqa     %%xmm2,%%xmm5                  \n"
+      "punpckldq  %%xmm3,%%xmm2                  \n"
+      "punpckhdq  %%xmm3,%%xmm5                  \n"
+      "movdqa     %%xmm0,%%xmm1                  \n"
+      "punpcklqdq %%xmm2,%%xmm0                  \n"
+      "punpckhqdq %%xmm2,%%xmm1                  \n"
+      "movdqa     %%xmm4,%%xmm3                  \n"
+      "punpcklqdq %%xmm5,%%xmm4                  \n"
+      "punpckhqdq %%xmm5,%%xmm3                  \n"
+      "movdqu     %%xmm0,(%1)                    \n"
+      "movdqu     %%xmm1,(%1,%4)                 \n"
+      "lea        (%1,%4,2),%1                   \n"
+      "movdqu     %%xmm4,(%1)                    \n"
+      "movdqu     %%xmm3,(%1,%4)                 \n"
+      "lea        (%1,%4,2),%1                   \n"
+      "sub        $0x4,%2                        \n"
+      "jg         1b                             \n"
+      : "+r"(src),                    // %0
+        "+r"(dst),                    // %1
+        "+r"(width)                   // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "r"((intptr_t)(dst_stride))   // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // defined(HAS_TRANSPOSEARGBWX4_SSE2)
+
+#if defined(HAS_TRANSPOSEARGBWX8_AVX2)
+// Transpose 8 rows of ARGB pixels. Each lane is transposed as two 4x4
+// blocks and the lanes are then swapped to form 8x8 pixels.
+void TransposeARGBWx8_AVX2(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width) {
+  const uint8_t* src4 = src + src_stride * 4;
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu    (%0),%%ymm0                    \n"
+      "vmovdqu    (%0,%4),%%ymm1                 \n"
+      "vmovdqu    (%0,%4,2),%%ymm2               \n"
+      "vmovdqu    (%0,%6),%%ymm3                 \n"
+      "vmovdqu    (%1),%%ymm4                    \n"
+      "vmovdqu    (%1,%4),%%ymm5                 \n"
+      "vmovdqu    (%1,%4,2),%%ymm6               \n"
+      "vmovdqu    (%1,%6),%%ymm7                 \n"
+      "lea        0x20(%0),%0                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "vpunpckldq %%ymm1,%%ymm0,%%ymm8           \n"
+      "vpunpckhdq %%ymm1,%%ymm0,%%ymm9           \n"
+      "vpunpckldq %%ymm3,%%ymm2,%%ymm10          \n"
+      "vpunpckhdq %%ymm3,%%ymm2,%%ymm11          \n"
+      "vpunpcklqdq %%ymm10,%%ymm8,%%ymm0         \n"
+      "vpunpckhqdq %%ymm10,%%ymm8,%%ymm1         \n"
+      "vpunpcklqdq %%ymm11,%%ymm9,%%ymm2         \n"
+      "vpunpckhqdq %%ymm11,%%ymm9,%%ymm3         \n"
+      "vpunpckldq %%ymm5,%%ymm4,%%ymm8           \n"
+      "vpunpckhdq %%ymm5,%%ymm4,%%ymm9           \n"
+      "vpunpckldq %%ymm7,%%ymm6,%%ymm10          \n"
+      "vpunpckhdq %%ymm7,%%ymm6,%%ymm11          \n"
+      "vpunpcklqdq %%ymm10,%%ymm8,%%ymm4         \n"
+      "vpunpckhqdq %%ymm10,%%ymm8,%%ymm5         \n"
+      "vpunpcklqdq %%ymm11,%%ymm9,%%ymm6         \n"
+      "vpunpckhqdq %%ymm11,%%ymm9,%%ymm7         \n"
+      "vperm2i128 $0x20,%%ymm4,%%ymm0,%%ymm8     \n"
+      "vperm2i128 $0x20,%%ymm5,%%ymm1,%%ymm9     \n"
+      "vperm2i128 $0x20,%%ymm6,%%ymm2,%%ymm10    \n"
+      "vperm2i128 $0x20,%%ymm7,%%ymm3,%%ymm11    \n"
+      "vperm2i128 $0x31,%%ymm4,%%ymm0,%%ymm12    \n"
+      "vperm2i128 $0x31,%%ymm5,%%ymm1,%%ymm13    \n"
+      "vperm2i128 $0x31,%%ymm6,%%ymm2,%%ymm14    \n"
+      "vperm2i128 $0x31,%%ymm7,%%ymm3,%%ymm15    \n"
+      "vmovdqu    %%ymm8,(%2)                    \n"
+      "vmovdqu    %%ymm9,(%2,%5)                 \n"
+      "vmovdqu    %%ymm10,(%2,%5,2)              \n"
+      "vmovdqu    %%ymm11,(%2,%7)                \n"
+      "lea        (%2,%5,4),%2                   \n"
+      "vmovdqu    %%ymm12,(%2)                   \n"
+      "vmovdqu    %%ymm13,(%2,%5)                \n"
+      "vmovdqu    %%ymm14,(%2,%5,2)              \n"
+      "vmovdqu    %%ymm15,(%2,%7)                \n"
+      "lea        (%2,%5,4),%2                   \n"
+      "sub        $0x8,%3                        \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src),                        // %0
+        "+r"(src4),                       // %1
+        "+r"(dst),                        // %2
+        "+r"(width)                       // %3
+      : "r"((intptr_t)(src_stride)),      // %4
+        "r"((intptr_t)(dst_stride)),      // %5
+        "r"((intptr_t)(src_stride * 3)),  // %6
+        "r"((intptr_t)(dst_stride * 3))   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+        "xmm15");
+}
+#endif  // defined(HAS_TRANSPOSEARGBWX8_AVX2)
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
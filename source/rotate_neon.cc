@@ -408,6 +408,41 @@ void TransposeUVWx8_NEON(const uint8_t* src,
       : "r"(&kVTbl4x4TransposeDi)  // %8
       : "memory", "cc", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11");
 }
+
+// Transpose 4 rows of ARGB pixels. Each loop reads a 4x4 block of pixels
+// and writes it as 4 rows of 4 pixels.
+void TransposeARGBWx4_NEON(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width) {
+  const uint8_t* src_temp;
+  asm volatile(
+      "1:                                        \n"
+      "mov         %0, %1                        \n"
+      "vld1.32     {q0}, [%0], %4                \n"
+      "vld1.32     {q1}, [%0], %4                \n"
+      "vld1.32     {q2}, [%0], %4                \n"
+      "vld1.32     {q3}, [%0]                    \n"
+      "add         %1, #16                       \n"
+      "vtrn.32     q0, q1                        \n"  // a0b0a2b2 a1b1a3b3
+      "vtrn.32     q2, q3                        \n"  // c0d0c2d2 c1d1c3d3
+      "vswp        d1, d4                        \n"  // a0b0c0d0 a2b2c2d2
+      "vswp        d3, d6                        \n"  // a1b1c1d1 a3b3c3d3
+      "subs        %3, #4                        \n"
+      "vst1.32     {q0}, [%2], %5                \n"
+      "vst1.32     {q1}, [%2], %5                \n"
+      "vst1.32     {q2}, [%2], %5                \n"
+      "vst1.32     {q3}, [%2], %5                \n"
+      "bgt         1b                            \n"
+      : "=&r"(src_temp),  // %0
+        "+r"(src),        // %1
+        "+r"(dst),        // %2
+        "+r"(width)       // %3
+      : "r"(src_stride),  // %4
+        "r"(dst_stride)   // %5
+      : "memory", "cc", "q0", "q1", "q2", "q3");
+}
 #endif  // defined(__ARM_NEON__) && !defined(__aarch64__)
 
 #ifdef __cplusplus
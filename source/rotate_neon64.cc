@@ -418,6 +418,45 @@ void TransposeUVWx8_NEON(const uint8_t* src,
       : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v16",
         "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v30", "v31");
 }
+
+// Transpose 4 rows of ARGB pixels. Each loop reads a 4x4 block of pixels
+// and writes it as 4 rows of 4 pixels.
+void TransposeARGBWx4_NEON(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride,
+                           int width) {
+  const uint8_t* src_temp;
+  asm volatile(
+      "1:                                        \n"
+      "mov       %0, %1                          \n"
+      "ld1       {v0.4s}, [%0], %4               \n"
+      "ld1       {v1.4s}, [%0], %4               \n"
+      "ld1       {v2.4s}, [%0], %4               \n"
+      "ld1       {v3.4s}, [%0]                   \n"
+      "add       %1, %1, #16                     \n"
+      "trn1      v4.4s, v0.4s, v1.4s             \n"  // a0 b0 a2 b2
+      "trn2      v5.4s, v0.4s, v1.4s             \n"  // a1 b1 a3 b3
+      "trn1      v6.4s, v2.4s, v3.4s             \n"  // c0 d0 c2 d2
+      "trn2      v7.4s, v2.4s, v3.4s             \n"  // c1 d1 c3 d3
+      "trn1      v0.2d, v4.2d, v6.2d             \n"  // a0 b0 c0 d0
+      "trn1      v1.2d, v5.2d, v7.2d             \n"  // a1 b1 c1 d1
+      "trn2      v2.2d, v4.2d, v6.2d             \n"  // a2 b2 c2 d2
+      "trn2      v3.2d, v5.2d, v7.2d             \n"  // a3 b3 c3 d3
+      "subs      %w3, %w3, #4                    \n"
+      "st1       {v0.4s}, [%2], %5               \n"
+      "st1       {v1.4s}, [%2], %5               \n"
+      "st1       {v2.4s}, [%2], %5               \n"
+      "st1       {v3.4s}, [%2], %5               \n"
+      "b.gt      1b                              \n"
+      : "=&r"(src_temp),                          // %0
+        "+r"(src),                                // %1
+        "+r"(dst),                                // %2
+        "+r"(width)                               // %3
+      : "r"(static_cast<ptrdiff_t>(src_stride)),  // %4
+        "r"(static_cast<ptrdiff_t>(dst_stride))   // %5
+      : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7");
+}
 #endif  // !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
 
 #ifdef __cplusplus
@@ -132,6 +132,37 @@ ANY31(BlendPlaneRow_Any_MMI, BlendPlaneRow_MMI, 0, 0, 1, 7)
 #endif
 #undef ANY31
 
+// Any 3 Bayer rows to ARGB.  Reads 1 pixel left and right of each row.
+#define ANY31B(NAMEANY, ANY_SIMD, MASK)                                     \
+  void NAMEANY(const uint8_t* src_bayer0, const uint8_t* src_bayer1,        \
+               const uint8_t* src_bayer2, uint8_t* dst_ptr, int bayer_row,  \
+               int width) {                                                 \
+    SIMD_ALIGNED(uint8_t temp[64 * 5]);                                     \
+    memset(temp, 0, 64 * 3); /* for msan */                                 \
+    int r = width & MASK;                                                   \
+    int n = width & ~MASK;                                                  \
+    if (n > 0) {                                                            \
+      ANY_SIMD(src_bayer0, src_bayer1, src_bayer2, dst_ptr, bayer_row, n);  \
+    }                                                                       \
+    memcpy(temp, src_bayer0 + n - 1, r + 2);                                \
+    memcpy(temp + 64, src_bayer1 + n - 1, r + 2);                           \
+    memcpy(temp + 128, src_bayer2 + n - 1, r + 2);                          \
+    ANY_SIMD(temp + 1, temp + 65, temp + 129, temp + 192, bayer_row,        \
+             MASK + 1);                                                     \
+    memcpy(dst_ptr + n * 4, temp + 192, r * 4);                             \
+  }
+
+#ifdef HAS_BAYERROWTOARGBROW_SSE2
+ANY31B(BayerRowToARGBRow_Any_SSE2, BayerRowToARGBRow_SSE2, 15)
+#endif
+#ifdef HAS_BAYERROWTOARGBROW_AVX2
+ANY31B(BayerRowToARGBRow_Any_AVX2, BayerRowToARGBRow_AVX2, 31)
+#endif
+#ifdef HAS_BAYERROWTOARGBROW_NEON
+ANY31B(BayerRowToARGBRow_Any_NEON, BayerRowToARGBRow_NEON, 15)
+#endif
+#undef ANY31B
+
 // Note that odd width replication includes 444 due to implementation
 // on arm that subsamples 444 to 422 internally.
 // Any 3 planes to 1 with yuvconstants
@@ -182,6 +213,9 @@ ANY31C(I422ToRGB24Row_Any_AVX2, I422ToRGB24Row_AVX2, 1, 0, 3, 31)
 #ifdef HAS_I422TOARGBROW_AVX2
 ANY31C(I422ToARGBRow_Any_AVX2, I422ToARGBRow_AVX2, 1, 0, 4, 15)
 #endif
+#ifdef HAS_I422TOARGBROW_AVX512BW
+ANY31C(I422ToARGBRow_Any_AVX512BW, I422ToARGBRow_AVX512BW, 1, 0, 4, 31)
+#endif
 #ifdef HAS_I422TORGBAROW_AVX2
 ANY31C(I422ToRGBARow_Any_AVX2, I422ToRGBARow_AVX2, 1, 0, 4, 15)
 #endif
@@ -277,6 +311,9 @@ ANY21(MergeUVRow_Any_SSE2, MergeUVRow_SSE2, 0, 1, 1, 2, 15)
 #ifdef HAS_MERGEUVROW_AVX2
 ANY21(MergeUVRow_Any_AVX2, MergeUVRow_AVX2, 0, 1, 1, 2, 31)
 #endif
+#ifdef HAS_MERGEUVROW_AVX512BW
+ANY21(MergeUVRow_Any_AVX512BW, MergeUVRow_AVX512BW, 0, 1, 1, 2, 31)
+#endif
 #ifdef HAS_MERGEUVROW_NEON
 ANY21(MergeUVRow_Any_NEON, MergeUVRow_NEON, 0, 1, 1, 2, 15)
 #endif
@@ -376,6 +413,31 @@ ANY21(SobelXYRow_Any_MMI, SobelXYRow_MMI, 0, 1, 1, 4, 7)
 #endif
 #undef ANY21
 
+// Any 2 planes of 16 bit to 1 interleaved plane with parameter.
+#define ANY21PT(NAMEANY, ANY_SIMD, T, BPP, MASK)                     \
+  void NAMEANY(const T* src_u, const T* src_v, T* dst_uv, int scale, \
+               int width) {                                          \
+    SIMD_ALIGNED(T temp[16 * 4]);                                    \
+    memset(temp, 0, 16 * 4 * BPP); /* for msan */                    \
+    int r = width & MASK;                                            \
+    int n = width & ~MASK;                                           \
+    if (n > 0) {                                                     \
+      ANY_SIMD(src_u, src_v, dst_uv, scale, n);                      \
+    }                                                                \
+    memcpy(temp, src_u + n, r * BPP);                                \
+    memcpy(temp + 16, src_v + n, r * BPP);                           \
+    ANY_SIMD(temp, temp + 16, temp + 32, scale, MASK + 1);           \
+    memcpy(dst_uv + n * 2, temp + 32, r * BPP * 2);                  \
+  }
+
+#ifdef HAS_MERGEUVROW_16_SSE2
+ANY21PT(MergeUVRow_16_Any_SSE2, MergeUVRow_16_SSE2, uint16_t, 2, 7)
+#endif
+#ifdef HAS_MERGEUVROW_16_AVX2
+ANY21PT(MergeUVRow_16_Any_AVX2, MergeUVRow_16_AVX2, uint16_t, 2, 15)
+#endif
+#undef ANY21PT
+
 // Any 2 planes to 1 with yuvconstants
 #define ANY21C(NAMEANY, ANY_SIMD, UVSHIFT, SBPP, SBPP2, BPP, MASK)            \
   void NAMEANY(const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* dst_ptr, \
@@ -401,6 +463,9 @@ ANY21C(NV12ToARGBRow_Any_SSSE3, NV12ToARGBRow_SSSE3, 1, 1, 2, 4, 7)
 #ifdef HAS_NV12TOARGBROW_AVX2
 ANY21C(NV12ToARGBRow_Any_AVX2, NV12ToARGBRow_AVX2, 1, 1, 2, 4, 15)
 #endif
+#ifdef HAS_NV12TOARGBROW_AVX512BW
+ANY21C(NV12ToARGBRow_Any_AVX512BW, NV12ToARGBRow_AVX512BW, 1, 1, 2, 4, 31)
+#endif
 #ifdef HAS_NV12TOARGBROW_NEON
 ANY21C(NV12ToARGBRow_Any_NEON, NV12ToARGBRow_NEON, 1, 1, 2, 4, 7)
 #endif
@@ -451,6 +516,45 @@ ANY21C(NV12ToRGB565Row_Any_MSA, NV12ToRGB565Row_MSA, 1, 1, 2, 2, 7)
 #endif
 #undef ANY21C
 
+// Any 2 planes of 16 bit YUV, with interleaved UV, to 1 with yuvconstants.
+#define ANY21CT(NAMEANY, ANY_SIMD, UVSHIFT, DUVSHIFT, T, SBPP, BPP, MASK) \
+  void NAMEANY(const T* y_buf, const T* uv_buf, uint8_t* dst_ptr,         \
+               const struct YuvConstants* yuvconstants, int width) {      \
+    SIMD_ALIGNED(T temp[16 * 3]);                                         \
+    SIMD_ALIGNED(uint8_t out[64]);                                        \
+    memset(temp, 0, 16 * 3 * SBPP); /* for msan */                        \
+    int r = width & MASK;                                                 \
+    int n = width & ~MASK;                                                \
+    if (n > 0) {                                                          \
+      ANY_SIMD(y_buf, uv_buf, dst_ptr, yuvconstants, n);                  \
+    }                                                                     \
+    memcpy(temp, y_buf + n, r * SBPP);                                    \
+    memcpy(temp + 16, uv_buf + 2 * (n >> UVSHIFT),                        \
+           SS(r, UVSHIFT) * SBPP * 2);                                    \
+    ANY_SIMD(temp, temp + 16, out, yuvconstants, MASK + 1);               \
+    memcpy(dst_ptr + (n >> DUVSHIFT) * BPP, out, SS(r, DUVSHIFT) * BPP);  \
+  }
+
+#ifdef HAS_P210TOAR30ROW_SSSE3
+ANY21CT(P210ToAR30Row_Any_SSSE3, P210ToAR30Row_SSSE3, 1, 0, uint16_t, 2, 4, 7)
+#endif
+#ifdef HAS_P210TOARGBROW_SSSE3
+ANY21CT(P210ToARGBRow_Any_SSSE3, P210ToARGBRow_SSSE3, 1, 0, uint16_t, 2, 4, 7)
+#endif
+#ifdef HAS_P210TOARGBROW_AVX2
+ANY21CT(P210ToARGBRow_Any_AVX2, P210ToARGBRow_AVX2, 1, 0, uint16_t, 2, 4, 15)
+#endif
+#ifdef HAS_P210TOAR30ROW_AVX2
+ANY21CT(P210ToAR30Row_Any_AVX2, P210ToAR30Row_AVX2, 1, 0, uint16_t, 2, 4, 15)
+#endif
+#ifdef HAS_P210TOARGBROW_NEON
+ANY21CT(P210ToARGBRow_Any_NEON, P210ToARGBRow_NEON, 1, 0, uint16_t, 2, 4, 7)
+#endif
+#ifdef HAS_P210TOAR30ROW_NEON
+ANY21CT(P210ToAR30Row_Any_NEON, P210ToAR30Row_NEON, 1, 0, uint16_t, 2, 4, 7)
+#endif
+#undef ANY21CT
+
 // Any 1 to 1.
 #define ANY11(NAMEANY, ANY_SIMD, UVSHIFT, SBPP, BPP, MASK)                \
   void NAMEANY(const uint8_t* src_ptr, uint8_t* dst_ptr, int width) {     \
@@ -469,6 +573,9 @@ ANY21C(NV12ToRGB565Row_Any_MSA, NV12ToRGB565Row_MSA, 1, 1, 2, 2, 7)
 #ifdef HAS_COPYROW_AVX
 ANY11(CopyRow_Any_AVX, CopyRow_AVX, 0, 1, 1, 63)
 #endif
+#ifdef HAS_COPYROW_AVX512BW
+ANY11(CopyRow_Any_AVX512BW, CopyRow_AVX512BW, 0, 1, 1, 127)
+#endif
 #ifdef HAS_COPYROW_SSE2
 ANY11(CopyRow_Any_SSE2, CopyRow_SSE2, 0, 1, 1, 31)
 #endif
@@ -580,6 +687,9 @@ ANY11(RAWToRGB24Row_Any_MMI, RAWToRGB24Row_MMI, 0, 3, 3, 3)
 #ifdef HAS_ARGBTOYROW_AVX2
 ANY11(ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, 0, 4, 1, 31)
 #endif
+#ifdef HAS_ARGBTOYROW_AVX512BW
+ANY11(ARGBToYRow_Any_AVX512BW, ARGBToYRow_AVX512BW, 0, 4, 1, 31)
+#endif
 #ifdef HAS_ARGBTOYJROW_AVX2
 ANY11(ARGBToYJRow_Any_AVX2, ARGBToYJRow_AVX2, 0, 4, 1, 31)
 #endif
@@ -939,6 +1049,33 @@ ANY11C(Convert16To8Row_Any_AVX2,
        uint8_t,
        31)
 #endif
+#ifdef HAS_MULTIPLYROW_16_SSE2
+ANY11C(MultiplyRow_16_Any_SSE2,
+       MultiplyRow_16_SSE2,
+       2,
+       2,
+       uint16_t,
+       uint16_t,
+       15)
+#endif
+#ifdef HAS_MULTIPLYROW_16_AVX2
+ANY11C(MultiplyRow_16_Any_AVX2,
+       MultiplyRow_16_AVX2,
+       2,
+       2,
+       uint16_t,
+       uint16_t,
+       31)
+#endif
+#ifdef HAS_DIVIDEROW_16_SSE2
+ANY11C(DivideRow_16_Any_SSE2, DivideRow_16_SSE2, 2, 2, uint16_t, uint16_t, 15)
+#endif
+#ifdef HAS_DIVIDEROW_16_AVX2
+ANY11C(DivideRow_16_Any_AVX2, DivideRow_16_AVX2, 2, 2, uint16_t, uint16_t, 31)
+#endif
+#ifdef HAS_DIVIDEROW_16_NEON
+ANY11C(DivideRow_16_Any_NEON, DivideRow_16_NEON, 2, 2, uint16_t, uint16_t, 15)
+#endif
 #ifdef HAS_CONVERT8TO16ROW_SSE2
 ANY11C(Convert8To16Row_Any_SSE2,
        Convert8To16Row_SSE2,
@@ -959,6 +1096,33 @@ ANY11C(Convert8To16Row_Any_AVX2,
 #endif
 #undef ANY11C
 
+// Any 1 to 1 of 16 bit to 8 bit.
+#define ANY11R16(NAMEANY, ANY_SIMD, MASK)                              \
+  void NAMEANY(const uint16_t* src_ptr, uint8_t* dst_ptr, int width) { \
+    SIMD_ALIGNED(uint16_t temp[32]);                                   \
+    SIMD_ALIGNED(uint8_t out[32]);                                     \
+    memset(temp, 0, 32 * 2); /* for msan */                            \
+    int r = width & MASK;                                              \
+    int n = width & ~MASK;                                             \
+    if (n > 0) {                                                       \
+      ANY_SIMD(src_ptr, dst_ptr, n);                                   \
+    }                                                                  \
+    memcpy(temp, src_ptr + n, r * 2);                                  \
+    ANY_SIMD(temp, out, MASK + 1);                                     \
+    memcpy(dst_ptr + n, out, r);                                       \
+  }
+
+#ifdef HAS_ROUND16TO8ROW_SSE2
+ANY11R16(Round16To8Row_Any_SSE2, Round16To8Row_SSE2, 15)
+#endif
+#ifdef HAS_ROUND16TO8ROW_AVX2
+ANY11R16(Round16To8Row_Any_AVX2, Round16To8Row_AVX2, 31)
+#endif
+#ifdef HAS_ROUND16TO8ROW_NEON
+ANY11R16(Round16To8Row_Any_NEON, Round16To8Row_NEON, 15)
+#endif
+#undef ANY11R16
+
 // Any 1 to 1 with parameter and shorts to byte.  BPP measures in shorts.
 #define ANY11P16(NAMEANY, ANY_SIMD, ST, T, SBPP, BPP, MASK)             \
   void NAMEANY(const ST* src_ptr, T* dst_ptr, float param, int width) { \
@@ -1076,6 +1240,34 @@ ANY11T(InterpolateRow_Any_MMI, InterpolateRow_MMI, 1, 1, 7)
 #endif
 #undef ANY11T
 
+// Any 1 to 1 interpolate of 16 bit pixels.  Takes 2 rows of source via stride.
+#define ANY11T16(NAMEANY, ANY_SIMD, MASK)                                     \
+  void NAMEANY(uint16_t* dst_ptr, const uint16_t* src_ptr,                   \
+               ptrdiff_t src_stride_ptr, int width, int source_y_fraction) { \
+    SIMD_ALIGNED(uint16_t temp[64 * 3]);                                     \
+    memset(temp, 0, 64 * 2 * 2); /* for msan */                              \
+    int r = width & MASK;                                                    \
+    int n = width & ~MASK;                                                   \
+    if (n > 0) {                                                             \
+      ANY_SIMD(dst_ptr, src_ptr, src_stride_ptr, n, source_y_fraction);      \
+    }                                                                        \
+    memcpy(temp, src_ptr + n, r * 2);                                        \
+    memcpy(temp + 64, src_ptr + src_stride_ptr + n, r * 2);                  \
+    ANY_SIMD(temp + 128, temp, 64, MASK + 1, source_y_fraction);             \
+    memcpy(dst_ptr + n, temp + 128, r * 2);                                  \
+  }
+
+#ifdef HAS_INTERPOLATEROW_16_SSE2
+ANY11T16(InterpolateRow_Any_16_SSE2, InterpolateRow_16_SSE2, 7)
+#endif
+#ifdef HAS_INTERPOLATEROW_16_AVX2
+ANY11T16(InterpolateRow_Any_16_AVX2, InterpolateRow_16_AVX2, 15)
+#endif
+#ifdef HAS_INTERPOLATEROW_16_AVX512BW
+ANY11T16(InterpolateRow_Any_16_AVX512BW, InterpolateRow_16_AVX512BW, 31)
+#endif
+#undef ANY11T16
+
 // Any 1 to 1 mirror.
 #define ANY11M(NAMEANY, ANY_SIMD, BPP, MASK)                              \
   void NAMEANY(const uint8_t* src_ptr, uint8_t* dst_ptr, int width) {     \
@@ -1173,6 +1365,9 @@ ANY12(SplitUVRow_Any_SSE2, SplitUVRow_SSE2, 0, 2, 0, 15)
 #ifdef HAS_SPLITUVROW_AVX2
 ANY12(SplitUVRow_Any_AVX2, SplitUVRow_AVX2, 0, 2, 0, 31)
 #endif
+#ifdef HAS_SPLITUVROW_AVX512BW
+ANY12(SplitUVRow_Any_AVX512BW, SplitUVRow_AVX512BW, 0, 2, 0, 63)
+#endif
 #ifdef HAS_SPLITUVROW_NEON
 ANY12(SplitUVRow_Any_NEON, SplitUVRow_NEON, 0, 2, 0, 15)
 #endif
@@ -1210,6 +1405,33 @@ ANY12(YUY2ToUV422Row_Any_MMI, YUY2ToUV422Row_MMI, 1, 4, 1, 15)
 #endif
 #undef ANY12
 
+// Any 1 interleaved plane of 16 bit to 2 planes with parameter.
+#define ANY12PT(NAMEANY, ANY_SIMD, T, BPP, MASK)                            \
+  void NAMEANY(const T* src_uv, T* dst_u, T* dst_v, int depth, int width) { \
+    SIMD_ALIGNED(T temp[16 * 4]);                                           \
+    memset(temp, 0, 16 * 4 * BPP); /* for msan */                           \
+    int r = width & MASK;                                                   \
+    int n = width & ~MASK;                                                  \
+    if (n > 0) {                                                            \
+      ANY_SIMD(src_uv, dst_u, dst_v, depth, n);                             \
+    }                                                                       \
+    memcpy(temp, src_uv + n * 2, r * BPP * 2);                              \
+    ANY_SIMD(temp, temp + 32, temp + 48, depth, MASK + 1);                  \
+    memcpy(dst_u + n, temp + 32, r * BPP);                                  \
+    memcpy(dst_v + n, temp + 48, r * BPP);                                  \
+  }
+
+#ifdef HAS_SPLITUVROW_16_SSE2
+ANY12PT(SplitUVRow_16_Any_SSE2, SplitUVRow_16_SSE2, uint16_t, 2, 7)
+#endif
+#ifdef HAS_SPLITUVROW_16_AVX2
+ANY12PT(SplitUVRow_16_Any_AVX2, SplitUVRow_16_AVX2, uint16_t, 2, 15)
+#endif
+#ifdef HAS_SPLITUVROW_16_NEON
+ANY12PT(SplitUVRow_16_Any_NEON, SplitUVRow_16_NEON, uint16_t, 2, 7)
+#endif
+#undef ANY12PT
+
 // Any 1 to 3.  Outputs RGB planes.
 #define ANY13(NAMEANY, ANY_SIMD, BPP, MASK)                                \
   void NAMEANY(const uint8_t* src_ptr, uint8_t* dst_r, uint8_t* dst_g,     \
@@ -1267,6 +1489,9 @@ ANY13(SplitRGBRow_Any_MMI, SplitRGBRow_MMI, 3, 3)
 #ifdef HAS_ARGBTOUVROW_AVX2
 ANY12S(ARGBToUVRow_Any_AVX2, ARGBToUVRow_AVX2, 0, 4, 31)
 #endif
+#ifdef HAS_ARGBTOUVROW_AVX512BW
+ANY12S(ARGBToUVRow_Any_AVX512BW, ARGBToUVRow_AVX512BW, 0, 4, 31)
+#endif
 #ifdef HAS_ARGBTOUVJROW_AVX2
 ANY12S(ARGBToUVJRow_Any_AVX2, ARGBToUVJRow_AVX2, 0, 4, 31)
 #endif
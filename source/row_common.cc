@@ -1058,253 +1058,243 @@ void J400ToARGBRow_C(const uint8_t* src_y, uint8_t* dst_argb, int width) {
   }
 }
 
+// Bilinear demosaic.  A red or blue pixel takes green from the average of its
+// 4 neighbours and the other of red or blue from its 4 diagonals.  A green
+// pixel takes the color of its row from left and right, and the other color
+// from above and below.  Averages are rounded in pairs, like pavgb.
+void BayerRowToARGBRow_C(const uint8_t* src_bayer0,
+                         const uint8_t* src_bayer1,
+                         const uint8_t* src_bayer2,
+                         uint8_t* dst_argb,
+                         int bayer_row,
+                         int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    uint8_t h = AVGB(src_bayer1[x - 1], src_bayer1[x + 1]);
+    uint8_t v = AVGB(src_bayer0[x], src_bayer2[x]);
+    uint8_t rb, g, br;
+    if ((x ^ bayer_row) & 1) {  // green
+      rb = h;
+      g = src_bayer1[x];
+      br = v;
+    } else {
+      rb = src_bayer1[x];
+      g = AVGB(h, v);
+      br = AVGB(AVGB(src_bayer0[x - 1], src_bayer0[x + 1]),
+                AVGB(src_bayer2[x - 1], src_bayer2[x + 1]));
+    }
+    if (bayer_row & 2) {  // blue row
+      dst_argb[0] = rb;
+      dst_argb[2] = br;
+    } else {
+      dst_argb[0] = br;
+      dst_argb[2] = rb;
+    }
+    dst_argb[1] = g;
+    dst_argb[3] = 255u;
+    dst_argb += 4;
+  }
+}
+
+// Demosaic the first and last pixel of a row.  The missing pixel outside the
+// row is mirrored from the same color 1 pixel inside.
+void BayerEdgesToARGBRow_C(const uint8_t* src_bayer0,
+                           const uint8_t* src_bayer1,
+                           const uint8_t* src_bayer2,
+                           uint8_t* dst_argb,
+                           int bayer_row,
+                           int width) {
+  const uint8_t* src_rows[3] = {src_bayer0, src_bayer1, src_bayer2};
+  uint8_t edge[3][3];
+  int i;
+  for (i = 0; i < 3; ++i) {
+    edge[i][0] = src_rows[i][width > 1 ? 1 : 0];
+    edge[i][1] = src_rows[i][0];
+    edge[i][2] = edge[i][0];
+  }
+  BayerRowToARGBRow_C(edge[0] + 1, edge[1] + 1, edge[2] + 1, dst_argb,
+                      bayer_row, 1);
+  if (width > 1) {
+    int x = width - 1;
+    for (i = 0; i < 3; ++i) {
+      edge[i][0] = src_rows[i][x - 1];
+      edge[i][1] = src_rows[i][x];
+      edge[i][2] = edge[i][0];
+    }
+    BayerRowToARGBRow_C(edge[0] + 1, edge[1] + 1, edge[2] + 1,
+                        dst_argb + x * 4, bayer_row ^ (x & 1), 1);
+  }
+}
+
 // TODO(fbarchard): Unify these structures to be platform independent.
 // TODO(fbarchard): Generate SIMD structures from float matrix.
 
-// BT.601 YUV to RGB reference
-//  R = (Y - 16) * 1.164              - V * -1.596
-//  G = (Y - 16) * 1.164 - U *  0.391 - V *  0.813
-//  B = (Y - 16) * 1.164 - U * -2.018
+// Each matrix is described by the Y scale and bias, YG and YGB, and by the
+// U and V contributions to R, G and B in 6 bit fixed point.
+// The bias values subtract 128 from U and V, and for limited range also
+// 16 from Y, and round.
+// MAKEYUVCONSTANTS defines kYuv<name>Constants, and the mirror
+// kYvu<name>Constants that swaps U and V for YVU to BGR.
+#define BB(YGB, UB) ((UB)*128 + (YGB))
+#define BG(YGB, UG, VG) ((UG)*128 + (VG)*128 + (YGB))
+#define BR(YGB, VR) ((VR)*128 + (YGB))
+
+#if defined(__aarch64__)  // 64 bit arm
+#define MAKEYUVCONSTANTS(name, YG, YGB, UB, UG, VG, VR)             \
+  const struct YuvConstants SIMD_ALIGNED(kYuv##name##Constants) = { \
+      {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},                     \
+      {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},                     \
+      {UG, VG, UG, VG, UG, VG, UG, VG},                             \
+      {UG, VG, UG, VG, UG, VG, UG, VG},                             \
+      {BB(YGB, UB), BG(YGB, UG, VG), BR(YGB, VR), 0, 0, 0, 0, 0},   \
+      {0x0101 * YG, 0, 0, 0}};                                      \
+  const struct YuvConstants SIMD_ALIGNED(kYvu##name##Constants) = { \
+      {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},                     \
+      {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},                     \
+      {VG, UG, VG, UG, VG, UG, VG, UG},                             \
+      {VG, UG, VG, UG, VG, UG, VG, UG},                             \
+      {BR(YGB, VR), BG(YGB, UG, VG), BB(YGB, UB), 0, 0, 0, 0, 0},   \
+      {0x0101 * YG, 0, 0, 0}};
+#elif defined(__arm__)  // 32 bit arm
+#define MAKEYUVCONSTANTS(name, YG, YGB, UB, UG, VG, VR)                 \
+  const struct YuvConstants SIMD_ALIGNED(kYuv##name##Constants) = {     \
+      {-UB, -UB, -UB, -UB, -VR, -VR, -VR, -VR, 0, 0, 0, 0, 0, 0, 0, 0}, \
+      {UG, UG, UG, UG, VG, VG, VG, VG, 0, 0, 0, 0, 0, 0, 0, 0},         \
+      {BB(YGB, UB), BG(YGB, UG, VG), BR(YGB, VR), 0, 0, 0, 0, 0},       \
+      {0x0101 * YG, 0, 0, 0}};                                          \
+  const struct YuvConstants SIMD_ALIGNED(kYvu##name##Constants) = {     \
+      {-VR, -VR, -VR, -VR, -UB, -UB, -UB, -UB, 0, 0, 0, 0, 0, 0, 0, 0}, \
+      {VG, VG, VG, VG, UG, UG, UG, UG, 0, 0, 0, 0, 0, 0, 0, 0},         \
+      {BR(YGB, VR), BG(YGB, UG, VG), BB(YGB, UB), 0, 0, 0, 0, 0},       \
+      {0x0101 * YG, 0, 0, 0}};
+#else
+#define UVCOEFF16(a, b) a, b, a, b, a, b, a, b, a, b, a, b, a, b, a, b
+#define BIAS16(a) a, a, a, a, a, a, a, a, a, a, a, a, a, a, a, a
+#define MAKEYUVCONSTANTS(name, YG, YGB, UB, UG, VG, VR)             \
+  const struct YuvConstants SIMD_ALIGNED(kYuv##name##Constants) = { \
+      {UVCOEFF16(UB, 0), UVCOEFF16(UB, 0)},                         \
+      {UVCOEFF16(UG, VG), UVCOEFF16(UG, VG)},                       \
+      {UVCOEFF16(0, VR), UVCOEFF16(0, VR)},                         \
+      {BIAS16(BB(YGB, UB))},                                        \
+      {BIAS16(BG(YGB, UG, VG))},                                    \
+      {BIAS16(BR(YGB, VR))},                                        \
+      {BIAS16(YG)}};                                                \
+  const struct YuvConstants SIMD_ALIGNED(kYvu##name##Constants) = { \
+      {UVCOEFF16(VR, 0), UVCOEFF16(VR, 0)},                         \
+      {UVCOEFF16(VG, UG), UVCOEFF16(VG, UG)},                       \
+      {UVCOEFF16(0, UB), UVCOEFF16(0, UB)},                         \
+      {BIAS16(BR(YGB, VR))},                                        \
+      {BIAS16(BG(YGB, UG, VG))},                                    \
+      {BIAS16(BB(YGB, UB))},                                        \
+      {BIAS16(YG)}};
+#endif
 
 // Y contribution to R,G,B.  Scale and bias.
+// Limited range Y is 16 to 235.
 #define YG 18997  /* round(1.164 * 64 * 256 * 256 / 257) */
 #define YGB -1160 /* 1.164 * 64 * -16 + 64 / 2 */
+// Full range Y is 0 to 255.
+#define YGF 16320 /* round(1.000 * 64 * 256 * 256 / 257) */
+#define YGBF 32   /* 64 / 2 */
 
+// BT.601 YUV to RGB reference
+//  R = (Y - 16) * 1.164              - V * -1.596
+//  G = (Y - 16) * 1.164 - U *  0.391 - V *  0.813
+//  B = (Y - 16) * 1.164 - U * -2.018
 // U and V contributions to R,G,B.
 #define UB -128 /* max(-128, round(-2.018 * 64)) */
 #define UG 25   /* round(0.391 * 64) */
 #define VG 52   /* round(0.813 * 64) */
 #define VR -102 /* round(-1.596 * 64) */
-
-// Bias values to subtract 16 from Y and 128 from U and V.
-#define BB (UB * 128 + YGB)
-#define BG (UG * 128 + VG * 128 + YGB)
-#define BR (VR * 128 + YGB)
-
-#if defined(__aarch64__)  // 64 bit arm
-const struct YuvConstants SIMD_ALIGNED(kYuvI601Constants) = {
-    {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},
-    {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},
-    {UG, VG, UG, VG, UG, VG, UG, VG},
-    {UG, VG, UG, VG, UG, VG, UG, VG},
-    {BB, BG, BR, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-const struct YuvConstants SIMD_ALIGNED(kYvuI601Constants) = {
-    {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},
-    {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},
-    {VG, UG, VG, UG, VG, UG, VG, UG},
-    {VG, UG, VG, UG, VG, UG, VG, UG},
-    {BR, BG, BB, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-#elif defined(__arm__)  // 32 bit arm
-const struct YuvConstants SIMD_ALIGNED(kYuvI601Constants) = {
-    {-UB, -UB, -UB, -UB, -VR, -VR, -VR, -VR, 0, 0, 0, 0, 0, 0, 0, 0},
-    {UG, UG, UG, UG, VG, VG, VG, VG, 0, 0, 0, 0, 0, 0, 0, 0},
-    {BB, BG, BR, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-const struct YuvConstants SIMD_ALIGNED(kYvuI601Constants) = {
-    {-VR, -VR, -VR, -VR, -UB, -UB, -UB, -UB, 0, 0, 0, 0, 0, 0, 0, 0},
-    {VG, VG, VG, VG, UG, UG, UG, UG, 0, 0, 0, 0, 0, 0, 0, 0},
-    {BR, BG, BB, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-#else
-const struct YuvConstants SIMD_ALIGNED(kYuvI601Constants) = {
-    {UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0,
-     UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0},
-    {UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG,
-     UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG},
-    {0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR,
-     0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR},
-    {BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB},
-    {BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG},
-    {BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR},
-    {YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG}};
-const struct YuvConstants SIMD_ALIGNED(kYvuI601Constants) = {
-    {VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0,
-     VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0},
-    {VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG,
-     VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG},
-    {0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB,
-     0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB},
-    {BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR},
-    {BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG},
-    {BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB},
-    {YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG}};
-#endif
-
-#undef BB
-#undef BG
-#undef BR
-#undef YGB
+MAKEYUVCONSTANTS(I601, YG, YGB, UB, UG, VG, VR)
 #undef UB
 #undef UG
 #undef VG
 #undef VR
-#undef YG
 
-// JPEG YUV to RGB reference
+// JPEG YUV to RGB reference.  This is full range BT.601.
 // *  R = Y                - V * -1.40200
 // *  G = Y - U *  0.34414 - V *  0.71414
 // *  B = Y - U * -1.77200
-
-// Y contribution to R,G,B.  Scale and bias.
-#define YG 16320 /* round(1.000 * 64 * 256 * 256 / 257) */
-#define YGB 32   /* 64 / 2 */
-
-// U and V contributions to R,G,B.
 #define UB -113 /* round(-1.77200 * 64) */
 #define UG 22   /* round(0.34414 * 64) */
 #define VG 46   /* round(0.71414  * 64) */
 #define VR -90  /* round(-1.40200 * 64) */
-
-// Bias values to round, and subtract 128 from U and V.
-#define BB (UB * 128 + YGB)
-#define BG (UG * 128 + VG * 128 + YGB)
-#define BR (VR * 128 + YGB)
-
-#if defined(__aarch64__)
-const struct YuvConstants SIMD_ALIGNED(kYuvJPEGConstants) = {
-    {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},
-    {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},
-    {UG, VG, UG, VG, UG, VG, UG, VG},
-    {UG, VG, UG, VG, UG, VG, UG, VG},
-    {BB, BG, BR, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-const struct YuvConstants SIMD_ALIGNED(kYvuJPEGConstants) = {
-    {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},
-    {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},
-    {VG, UG, VG, UG, VG, UG, VG, UG},
-    {VG, UG, VG, UG, VG, UG, VG, UG},
-    {BR, BG, BB, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-#elif defined(__arm__)
-const struct YuvConstants SIMD_ALIGNED(kYuvJPEGConstants) = {
-    {-UB, -UB, -UB, -UB, -VR, -VR, -VR, -VR, 0, 0, 0, 0, 0, 0, 0, 0},
-    {UG, UG, UG, UG, VG, VG, VG, VG, 0, 0, 0, 0, 0, 0, 0, 0},
-    {BB, BG, BR, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-const struct YuvConstants SIMD_ALIGNED(kYvuJPEGConstants) = {
-    {-VR, -VR, -VR, -VR, -UB, -UB, -UB, -UB, 0, 0, 0, 0, 0, 0, 0, 0},
-    {VG, VG, VG, VG, UG, UG, UG, UG, 0, 0, 0, 0, 0, 0, 0, 0},
-    {BR, BG, BB, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-#else
-const struct YuvConstants SIMD_ALIGNED(kYuvJPEGConstants) = {
-    {UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0,
-     UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0},
-    {UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG,
-     UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG},
-    {0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR,
-     0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR},
-    {BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB},
-    {BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG},
-    {BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR},
-    {YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG}};
-const struct YuvConstants SIMD_ALIGNED(kYvuJPEGConstants) = {
-    {VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0,
-     VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0},
-    {VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG,
-     VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG},
-    {0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB,
-     0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB},
-    {BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR},
-    {BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG},
-    {BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB},
-    {YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG}};
-#endif
-
-#undef BB
-#undef BG
-#undef BR
-#undef YGB
+MAKEYUVCONSTANTS(JPEG, YGF, YGBF, UB, UG, VG, VR)
 #undef UB
 #undef UG
 #undef VG
 #undef VR
-#undef YG
 
 // BT.709 YUV to RGB reference
 //  R = (Y - 16) * 1.164              - V * -1.793
 //  G = (Y - 16) * 1.164 - U *  0.213 - V *  0.533
 //  B = (Y - 16) * 1.164 - U * -2.112
 // See also http://www.equasys.de/colorconversion.html
-
-// Y contribution to R,G,B.  Scale and bias.
-#define YG 18997  /* round(1.164 * 64 * 256 * 256 / 257) */
-#define YGB -1160 /* 1.164 * 64 * -16 + 64 / 2 */
-
 // TODO(fbarchard): Find way to express 2.112 instead of 2.0.
-// U and V contributions to R,G,B.
 #define UB -128 /* max(-128, round(-2.112 * 64)) */
 #define UG 14   /* round(0.213 * 64) */
 #define VG 34   /* round(0.533  * 64) */
 #define VR -115 /* round(-1.793 * 64) */
+MAKEYUVCONSTANTS(H709, YG, YGB, UB, UG, VG, VR)
+#undef UB
+#undef UG
+#undef VG
+#undef VR
 
-// Bias values to round, and subtract 128 from U and V.
-#define BB (UB * 128 + YGB)
-#define BG (UG * 128 + VG * 128 + YGB)
-#define BR (VR * 128 + YGB)
+// BT.709 full range YUV to RGB reference
+//  R = Y               - V * -1.5748
+//  G = Y - U * 0.18732 - V *  0.46812
+//  B = Y - U * -1.8556
+#define UB -119 /* round(-1.8556 * 64) */
+#define UG 12   /* round(0.18732 * 64) */
+#define VG 30   /* round(0.46812 * 64) */
+#define VR -101 /* round(-1.5748 * 64) */
+MAKEYUVCONSTANTS(F709, YGF, YGBF, UB, UG, VG, VR)
+#undef UB
+#undef UG
+#undef VG
+#undef VR
 
-#if defined(__aarch64__)
-const struct YuvConstants SIMD_ALIGNED(kYuvH709Constants) = {
-    {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},
-    {-UB, -VR, -UB, -VR, -UB, -VR, -UB, -VR},
-    {UG, VG, UG, VG, UG, VG, UG, VG},
-    {UG, VG, UG, VG, UG, VG, UG, VG},
-    {BB, BG, BR, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-const struct YuvConstants SIMD_ALIGNED(kYvuH709Constants) = {
-    {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},
-    {-VR, -UB, -VR, -UB, -VR, -UB, -VR, -UB},
-    {VG, UG, VG, UG, VG, UG, VG, UG},
-    {VG, UG, VG, UG, VG, UG, VG, UG},
-    {BR, BG, BB, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-#elif defined(__arm__)
-const struct YuvConstants SIMD_ALIGNED(kYuvH709Constants) = {
-    {-UB, -UB, -UB, -UB, -VR, -VR, -VR, -VR, 0, 0, 0, 0, 0, 0, 0, 0},
-    {UG, UG, UG, UG, VG, VG, VG, VG, 0, 0, 0, 0, 0, 0, 0, 0},
-    {BB, BG, BR, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-const struct YuvConstants SIMD_ALIGNED(kYvuH709Constants) = {
-    {-VR, -VR, -VR, -VR, -UB, -UB, -UB, -UB, 0, 0, 0, 0, 0, 0, 0, 0},
-    {VG, VG, VG, VG, UG, UG, UG, UG, 0, 0, 0, 0, 0, 0, 0, 0},
-    {BR, BG, BB, 0, 0, 0, 0, 0},
-    {0x0101 * YG, 0, 0, 0}};
-#else
-const struct YuvConstants SIMD_ALIGNED(kYuvH709Constants) = {
-    {UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0,
-     UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0},
-    {UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG,
-     UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG},
-    {0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR,
-     0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR},
-    {BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB},
-    {BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG},
-    {BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR},
-    {YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG}};
-const struct YuvConstants SIMD_ALIGNED(kYvuH709Constants) = {
-    {VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0,
-     VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0},
-    {VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG,
-     VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG},
-    {0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB,
-     0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB},
-    {BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR, BR},
-    {BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG, BG},
-    {BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB, BB},
-    {YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG}};
-#endif
+// BT.2020 YUV to RGB reference
+//  R = (Y - 16) * 1.164              - V * -1.679
+//  G = (Y - 16) * 1.164 - U *  0.187 - V *  0.650
+//  B = (Y - 16) * 1.164 - U * -2.142
+// TODO(fbarchard): Find way to express 2.142 instead of 2.0.
+#define UB -128 /* max(-128, round(-2.142 * 64)) */
+#define UG 12   /* round(0.187326 * 64) */
+#define VG 42   /* round(0.65042 * 64) */
+#define VR -107 /* round(-1.67867 * 64) */
+MAKEYUVCONSTANTS(2020, YG, YGB, UB, UG, VG, VR)
+#undef UB
+#undef UG
+#undef VG
+#undef VR
 
-#undef BB
-#undef BG
-#undef BR
-#undef YGB
+// BT.2020 full range YUV to RGB reference
+//  R = Y                 - V * -1.474600
+//  G = Y - U *  0.164553 - V *  0.571353
+//  B = Y - U * -1.881400
+#define UB -120 /* round(-1.881400 * 64) */
+#define UG 11   /* round(0.164553 * 64) */
+#define VG 37   /* round(0.571353 * 64) */
+#define VR -94  /* round(-1.474600 * 64) */
+MAKEYUVCONSTANTS(V2020, YGF, YGBF, UB, UG, VG, VR)
 #undef UB
 #undef UG
 #undef VG
 #undef VR
+
 #undef YG
+#undef YGB
+#undef YGF
+#undef YGBF
+#undef BB
+#undef BG
+#undef BR
+#undef UVCOEFF16
+#undef BIAS16
+#undef MAKEYUVCONSTANTS
 
 // C reference code that mimics the YUV assembly.
 // Reads 8 bit YUV and leaves result as 16 bit.
@@ -1617,6 +1607,60 @@ void I210ToAR30Row_C(const uint16_t* src_y,
   }
 }
 
+// 16 bit msb YUV with interleaved UV, as found in P010 and P016, to ARGB.
+// The upper 10 bits of Y and upper 8 bits of UV are used.
+void P210ToARGBRow_C(const uint16_t* src_y,
+                     const uint16_t* src_uv,
+                     uint8_t* rgb_buf,
+                     const struct YuvConstants* yuvconstants,
+                     int width) {
+  int x;
+  for (x = 0; x < width - 1; x += 2) {
+    YuvPixel10(src_y[0] >> 6, src_uv[0] >> 6, src_uv[1] >> 6, rgb_buf + 0,
+               rgb_buf + 1, rgb_buf + 2, yuvconstants);
+    rgb_buf[3] = 255;
+    YuvPixel10(src_y[1] >> 6, src_uv[0] >> 6, src_uv[1] >> 6, rgb_buf + 4,
+               rgb_buf + 5, rgb_buf + 6, yuvconstants);
+    rgb_buf[7] = 255;
+    src_y += 2;
+    src_uv += 2;
+    rgb_buf += 8;  // Advance 2 pixels.
+  }
+  if (width & 1) {
+    YuvPixel10(src_y[0] >> 6, src_uv[0] >> 6, src_uv[1] >> 6, rgb_buf + 0,
+               rgb_buf + 1, rgb_buf + 2, yuvconstants);
+    rgb_buf[3] = 255;
+  }
+}
+
+// 16 bit msb YUV with interleaved UV to 10 bit AR30
+void P210ToAR30Row_C(const uint16_t* src_y,
+                     const uint16_t* src_uv,
+                     uint8_t* rgb_buf,
+                     const struct YuvConstants* yuvconstants,
+                     int width) {
+  int x;
+  int b;
+  int g;
+  int r;
+  for (x = 0; x < width - 1; x += 2) {
+    YuvPixel16(src_y[0] >> 6, src_uv[0] >> 6, src_uv[1] >> 6, &b, &g, &r,
+               yuvconstants);
+    StoreAR30(rgb_buf, b, g, r);
+    YuvPixel16(src_y[1] >> 6, src_uv[0] >> 6, src_uv[1] >> 6, &b, &g, &r,
+               yuvconstants);
+    StoreAR30(rgb_buf + 4, b, g, r);
+    src_y += 2;
+    src_uv += 2;
+    rgb_buf += 8;  // Advance 2 pixels.
+  }
+  if (width & 1) {
+    YuvPixel16(src_y[0] >> 6, src_uv[0] >> 6, src_uv[1] >> 6, &b, &g, &r,
+               yuvconstants);
+    StoreAR30(rgb_buf, b, g, r);
+  }
+}
+
 // 8 bit YUV to 10 bit AR30
 // Uses same code as 10 bit YUV bit shifts the 8 bit values up to 10 bits.
 void I422ToAR30Row_C(const uint8_t* src_y,
@@ -2133,6 +2177,23 @@ void MergeRGBRow_C(const uint8_t* src_r,
   }
 }
 
+// Use depth to convert msb formats to lsb, depending how many bits there are:
+// 10 = P010
+// 16 = P016
+void SplitUVRow_16_C(const uint16_t* src_uv,
+                     uint16_t* dst_u,
+                     uint16_t* dst_v,
+                     int depth,
+                     int width) {
+  int shift = 16 - depth;
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_u[x] = src_uv[0] >> shift;
+    dst_v[x] = src_uv[1] >> shift;
+    src_uv += 2;
+  }
+}
+
 // Use scale to convert lsb formats to msb, depending how many bits there are:
 // 128 = 9 bits
 // 64 = 10 bits
@@ -2167,6 +2228,28 @@ void MultiplyRow_16_C(const uint16_t* src_y,
   }
 }
 
+// Use scale to convert msb formats to lsb, depending how many bits there are:
+// 512 = 9 bits
+// 1024 = 10 bits
+// 4096 = 12 bits
+void DivideRow_16_C(const uint16_t* src_y,
+                    uint16_t* dst_y,
+                    int scale,
+                    int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_y[x] = (src_y[x] * scale) >> 16;
+  }
+}
+
+// Round msb formats to 8 bits.
+void Round16To8Row_C(const uint16_t* src_y, uint8_t* dst_y, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_y[x] = clamp255((src_y[x] + 128) >> 8);
+  }
+}
+
 // Use scale to convert lsb formats to msb, depending how many bits there are:
 // 32768 = 9 bits
 // 16384 = 10 bits
@@ -180,6 +180,205 @@ void J400ToARGBRow_SSE2(const uint8_t* src_y, uint8_t* dst_argb, int width) {
 }
 #endif  // HAS_J400TOARGBROW_SSE2
 
+#if defined(HAS_BAYERROWTOARGBROW_SSE2) || defined(HAS_BAYERROWTOARGBROW_AVX2)
+// Masks for BayerRowToARGBRow, by kind of row.  The first selects the red or
+// blue pixels and the second is set for rows with blue instead of red.
+static const ulvec8 kBayerRowMasks[4][2] = {
+    {{255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0,
+      255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0},
+     {0}},
+    {{0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255,
+      0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255},
+     {0}},
+    {{255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0,
+      255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0},
+     {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      255, 255, 255, 255, 255, 255, 255, 255, 255, 255}},
+    {{0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255,
+      0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255, 0, 255},
+     {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      255, 255, 255, 255, 255, 255, 255, 255, 255, 255}},
+};
+#endif
+
+#ifdef HAS_BAYERROWTOARGBROW_SSE2
+// Same as BayerRowToARGBRow_C.  The averages h, v, avg(h, v) and the diagonal
+// are computed for every pixel, then the masks pick the ones for red or blue
+// pixels and green pixels, and swap red and blue on blue rows.
+void BayerRowToARGBRow_SSE2(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width) {
+  // clang-format off
+  asm volatile (
+    "movdqa    %[site],%%xmm6                  \n"
+    "movdqa    %[blue],%%xmm7                  \n"
+
+    // 16 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "movdqu    -0x1(%[src1]),%%xmm0            \n"
+    "movdqu    0x1(%[src1]),%%xmm1             \n"
+    "pavgb     %%xmm1,%%xmm0                   \n"  // h
+    "movdqu    (%[src0]),%%xmm1                \n"
+    "movdqu    (%[src2]),%%xmm2                \n"
+    "pavgb     %%xmm2,%%xmm1                   \n"  // v
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "pavgb     %%xmm1,%%xmm2                   \n"  // avg(h, v)
+    "movdqu    -0x1(%[src0]),%%xmm3            \n"
+    "movdqu    0x1(%[src0]),%%xmm4             \n"
+    "pavgb     %%xmm4,%%xmm3                   \n"
+    "movdqu    -0x1(%[src2]),%%xmm4            \n"
+    "movdqu    0x1(%[src2]),%%xmm5             \n"
+    "pavgb     %%xmm5,%%xmm4                   \n"
+    "pavgb     %%xmm4,%%xmm3                   \n"  // diagonal
+    "movdqu    (%[src1]),%%xmm4                \n"
+    "lea       0x10(%[src0]),%[src0]           \n"
+    "lea       0x10(%[src1]),%[src1]           \n"
+    "lea       0x10(%[src2]),%[src2]           \n"
+
+    "movdqa    %%xmm4,%%xmm5                   \n"
+    "pxor      %%xmm0,%%xmm5                   \n"
+    "pand      %%xmm6,%%xmm5                   \n"
+    "pxor      %%xmm5,%%xmm0                   \n"  // color of the row
+    "pxor      %%xmm4,%%xmm2                   \n"
+    "pand      %%xmm6,%%xmm2                   \n"
+    "pxor      %%xmm4,%%xmm2                   \n"  // G
+    "pxor      %%xmm1,%%xmm3                   \n"
+    "pand      %%xmm6,%%xmm3                   \n"
+    "pxor      %%xmm3,%%xmm1                   \n"  // other color
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "pxor      %%xmm1,%%xmm3                   \n"
+    "pand      %%xmm7,%%xmm3                   \n"
+    "pxor      %%xmm3,%%xmm0                   \n"  // R
+    "pxor      %%xmm3,%%xmm1                   \n"  // B
+
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"  // A
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "punpcklbw %%xmm2,%%xmm3                   \n"  // BG
+    "punpckhbw %%xmm2,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm4                   \n"
+    "punpcklbw %%xmm5,%%xmm4                   \n"  // RA
+    "punpckhbw %%xmm5,%%xmm0                   \n"
+    "movdqa    %%xmm3,%%xmm2                   \n"
+    "punpcklwd %%xmm4,%%xmm2                   \n"  // BGRA
+    "punpckhwd %%xmm4,%%xmm3                   \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "punpcklwd %%xmm0,%%xmm4                   \n"
+    "punpckhwd %%xmm0,%%xmm1                   \n"
+    "movdqu    %%xmm2,(%[dst_argb])            \n"
+    "movdqu    %%xmm3,0x10(%[dst_argb])        \n"
+    "movdqu    %%xmm4,0x20(%[dst_argb])        \n"
+    "movdqu    %%xmm1,0x30(%[dst_argb])        \n"
+    "lea       0x40(%[dst_argb]),%[dst_argb]   \n"
+    "sub       $0x10,%[width]                  \n"
+    "jg        1b                              \n"
+  : [src0]"+r"(src_bayer0),    // %[src0]
+    [src1]"+r"(src_bayer1),    // %[src1]
+    [src2]"+r"(src_bayer2),    // %[src2]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+#if defined(__i386__)
+    [width]"+m"(width)         // %[width]
+#else
+    [width]"+rm"(width)        // %[width]
+#endif
+  : [site]"m"(kBayerRowMasks[bayer_row][0]),  // %[site]
+    [blue]"m"(kBayerRowMasks[bayer_row][1])   // %[blue]
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7");
+  // clang-format on
+}
+#endif  // HAS_BAYERROWTOARGBROW_SSE2
+
+#ifdef HAS_BAYERROWTOARGBROW_AVX2
+void BayerRowToARGBRow_AVX2(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width) {
+  // clang-format off
+  asm volatile (
+    "vmovdqu   %[site],%%ymm6                  \n"
+    "vmovdqu   %[blue],%%ymm7                  \n"
+
+    // 32 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "vmovdqu   -0x1(%[src1]),%%ymm0            \n"
+    "vpavgb    0x1(%[src1]),%%ymm0,%%ymm0      \n"  // h
+    "vmovdqu   (%[src0]),%%ymm1                \n"
+    "vpavgb    (%[src2]),%%ymm1,%%ymm1         \n"  // v
+    "vpavgb    %%ymm1,%%ymm0,%%ymm2            \n"  // avg(h, v)
+    "vmovdqu   -0x1(%[src0]),%%ymm3            \n"
+    "vpavgb    0x1(%[src0]),%%ymm3,%%ymm3      \n"
+    "vmovdqu   -0x1(%[src2]),%%ymm4            \n"
+    "vpavgb    0x1(%[src2]),%%ymm4,%%ymm4      \n"
+    "vpavgb    %%ymm4,%%ymm3,%%ymm3            \n"  // diagonal
+    "vmovdqu   (%[src1]),%%ymm4                \n"
+    "lea       0x20(%[src0]),%[src0]           \n"
+    "lea       0x20(%[src1]),%[src1]           \n"
+    "lea       0x20(%[src2]),%[src2]           \n"
+
+    "vpxor     %%ymm0,%%ymm4,%%ymm5            \n"
+    "vpand     %%ymm6,%%ymm5,%%ymm5            \n"
+    "vpxor     %%ymm5,%%ymm0,%%ymm0            \n"  // color of the row
+    "vpxor     %%ymm4,%%ymm2,%%ymm2            \n"
+    "vpand     %%ymm6,%%ymm2,%%ymm2            \n"
+    "vpxor     %%ymm4,%%ymm2,%%ymm2            \n"  // G
+    "vpxor     %%ymm1,%%ymm3,%%ymm3            \n"
+    "vpand     %%ymm6,%%ymm3,%%ymm3            \n"
+    "vpxor     %%ymm3,%%ymm1,%%ymm1            \n"  // other color
+    "vpxor     %%ymm1,%%ymm0,%%ymm3            \n"
+    "vpand     %%ymm7,%%ymm3,%%ymm3            \n"
+    "vpxor     %%ymm3,%%ymm0,%%ymm0            \n"  // R
+    "vpxor     %%ymm3,%%ymm1,%%ymm1            \n"  // B
+
+    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"  // A
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
+    "vpermq    $0xd8,%%ymm2,%%ymm2             \n"
+    "vpunpcklbw %%ymm2,%%ymm1,%%ymm3           \n"  // BG
+    "vpunpckhbw %%ymm2,%%ymm1,%%ymm1           \n"
+    "vpunpcklbw %%ymm5,%%ymm0,%%ymm4           \n"  // RA
+    "vpunpckhbw %%ymm5,%%ymm0,%%ymm0           \n"
+    "vpermq    $0xd8,%%ymm3,%%ymm3             \n"
+    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
+    "vpermq    $0xd8,%%ymm4,%%ymm4             \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpunpcklwd %%ymm4,%%ymm3,%%ymm2           \n"  // BGRA
+    "vpunpckhwd %%ymm4,%%ymm3,%%ymm3           \n"
+    "vpunpcklwd %%ymm0,%%ymm1,%%ymm4           \n"
+    "vpunpckhwd %%ymm0,%%ymm1,%%ymm1           \n"
+    "vmovdqu   %%ymm2,(%[dst_argb])            \n"
+    "vmovdqu   %%ymm3,0x20(%[dst_argb])        \n"
+    "vmovdqu   %%ymm4,0x40(%[dst_argb])        \n"
+    "vmovdqu   %%ymm1,0x60(%[dst_argb])        \n"
+    "lea       0x80(%[dst_argb]),%[dst_argb]   \n"
+    "sub       $0x20,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [src0]"+r"(src_bayer0),    // %[src0]
+    [src1]"+r"(src_bayer1),    // %[src1]
+    [src2]"+r"(src_bayer2),    // %[src2]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+#if defined(__i386__)
+    [width]"+m"(width)         // %[width]
+#else
+    [width]"+rm"(width)        // %[width]
+#endif
+  : [site]"m"(kBayerRowMasks[bayer_row][0]),  // %[site]
+    [blue]"m"(kBayerRowMasks[bayer_row][1])   // %[blue]
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7");
+  // clang-format on
+}
+#endif  // HAS_BAYERROWTOARGBROW_AVX2
+
 #ifdef HAS_RGB24TOARGBROW_SSSE3
 void RGB24ToARGBRow_SSSE3(const uint8_t* src_rgb24,
                           uint8_t* dst_argb,
@@ -1196,6 +1395,50 @@ void ARGBToYJRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width) {
 }
 #endif  // HAS_ARGBTOYJROW_AVX2
 
+#ifdef HAS_ARGBTOYROW_AVX512BW
+// vpermd for vpackssdw + vpackuswb.
+static const uint32_t kPermdARGBToY_AVX512[16] = {0, 4, 8,  12, 1, 5, 9,  13,
+                                                  2, 6, 10, 14, 3, 7, 11, 15};
+
+// Convert 32 ARGB pixels (128 bytes) to 32 Y values.
+// vpmaddwd with 1 replaces vphaddw, which has no 512 bit form.
+void ARGBToYRow_AVX512BW(const uint8_t* src_argb, uint8_t* dst_y, int width) {
+  asm volatile(
+      "vbroadcasti32x4 %3,%%zmm4                 \n"
+      "vbroadcastf128 %4,%%ymm5                  \n"
+      "vmovdqu64  %5,%%zmm6                      \n"
+      "vpternlogd $0xff,%%zmm7,%%zmm7,%%zmm7     \n"
+      "vpsrlw     $0xf,%%zmm7,%%zmm7             \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpmaddubsw %%zmm4,%%zmm0,%%zmm0           \n"
+      "vpmaddubsw %%zmm4,%%zmm1,%%zmm1           \n"
+      "vpmaddwd   %%zmm7,%%zmm0,%%zmm0           \n"
+      "vpmaddwd   %%zmm7,%%zmm1,%%zmm1           \n"
+      "vpackssdw  %%zmm1,%%zmm0,%%zmm0           \n"  // mutates.
+      "vpsrlw     $0x7,%%zmm0,%%zmm0             \n"
+      "vpackuswb  %%zmm0,%%zmm0,%%zmm0           \n"
+      "vpermd     %%zmm0,%%zmm6,%%zmm0           \n"  // unmutate.
+      "vpaddb     %%ymm5,%%ymm0,%%ymm0           \n"  // add 16 for Y
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_argb),            // %0
+        "+r"(dst_y),               // %1
+        "+r"(width)                // %2
+      : "m"(kARGBToY),             // %3
+        "m"(kAddY16),              // %4
+        "m"(kPermdARGBToY_AVX512)  // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5", "xmm6", "xmm7");
+}
+#endif  // HAS_ARGBTOYROW_AVX512BW
+
 #ifdef HAS_ARGBTOUVROW_SSSE3
 void ARGBToUVRow_SSSE3(const uint8_t* src_argb0,
                        int src_stride_argb,
@@ -1328,6 +1571,68 @@ void ARGBToUVRow_AVX2(const uint8_t* src_argb0,
 }
 #endif  // HAS_ARGBTOUVROW_AVX2
 
+#ifdef HAS_ARGBTOUVROW_AVX512BW
+// vpermw for vpackssdw + vpacksswb packed to 16 U then 16 V.
+static const uint16_t kPermwARGBToUV_AVX512[32] = {
+    0, 8, 16, 24, 1, 9, 17, 25, 2, 10, 18, 26, 3, 11, 19, 27,
+    0, 8, 16, 24, 1, 9, 17, 25, 2, 10, 18, 26, 3, 11, 19, 27};
+
+// Convert 32 ARGB pixels from 2 rows to 16 U and 16 V values.
+void ARGBToUVRow_AVX512BW(const uint8_t* src_argb0,
+                          int src_stride_argb,
+                          uint8_t* dst_u,
+                          uint8_t* dst_v,
+                          int width) {
+  asm volatile(
+      "vbroadcastf128 %5,%%ymm5                  \n"
+      "vbroadcasti32x4 %6,%%zmm6                 \n"
+      "vbroadcasti32x4 %7,%%zmm7                 \n"
+      "vmovdqu64  %8,%%zmm3                      \n"
+      "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+      "vpsrlw     $0xf,%%zmm4,%%zmm4             \n"  // 1
+      "sub        %1,%2                          \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "vpavgb     0x00(%0,%4,1),%%zmm0,%%zmm0    \n"
+      "vpavgb     0x40(%0,%4,1),%%zmm1,%%zmm1    \n"
+      "lea        0x80(%0),%0                    \n"
+      "vshufps    $0x88,%%zmm1,%%zmm0,%%zmm2     \n"
+      "vshufps    $0xdd,%%zmm1,%%zmm0,%%zmm0     \n"
+      "vpavgb     %%zmm2,%%zmm0,%%zmm0           \n"
+
+      "vpmaddubsw %%zmm7,%%zmm0,%%zmm1           \n"
+      "vpmaddubsw %%zmm6,%%zmm0,%%zmm0           \n"
+      "vpmaddwd   %%zmm4,%%zmm1,%%zmm1           \n"
+      "vpmaddwd   %%zmm4,%%zmm0,%%zmm0           \n"
+      "vpackssdw  %%zmm0,%%zmm1,%%zmm0           \n"
+      "vpsraw     $0x8,%%zmm0,%%zmm0             \n"
+      "vpacksswb  %%zmm0,%%zmm0,%%zmm0           \n"
+      "vpermw     %%zmm0,%%zmm3,%%zmm0           \n"
+      "vpaddb     %%ymm5,%%ymm0,%%ymm0           \n"
+
+      "vextractf128 $0x0,%%ymm0,(%1)             \n"
+      "vextractf128 $0x1,%%ymm0,0x0(%1,%2,1)     \n"
+      "lea        0x10(%1),%1                    \n"
+      "sub        $0x20,%3                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_argb0),                   // %0
+        "+r"(dst_u),                       // %1
+        "+r"(dst_v),                       // %2
+        "+rm"(width)                       // %3
+      : "r"((intptr_t)(src_stride_argb)),  // %4
+        "m"(kAddUV128),                    // %5
+        "m"(kARGBToV),                     // %6
+        "m"(kARGBToU),                     // %7
+        "m"(kPermwARGBToUV_AVX512)         // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOUVROW_AVX512BW
+
 #ifdef HAS_ARGBTOUVJROW_AVX2
 void ARGBToUVJRow_AVX2(const uint8_t* src_argb0,
                        int src_stride_argb,
@@ -1846,6 +2151,19 @@ void RGBAToUVRow_SSSE3(const uint8_t* src_rgba0,
   "psllw      $0x6,%%xmm4                                     \n" \
   "lea        0x10(%[y_buf]),%[y_buf]                         \n"
 
+// Read 4 UV from P210, upsample to 8 UV.  Uses the upper 8 bits of UV and
+// the upper 10 bits of Y, the same as READYUV210 does for 10 bit lsb.
+#define READP210                                                  \
+  "movdqu     (%[uv_buf]),%%xmm0                              \n" \
+  "lea        0x10(%[uv_buf]),%[uv_buf]                       \n" \
+  "psrlw      $0x8,%%xmm0                                     \n" \
+  "packuswb   %%xmm0,%%xmm0                                   \n" \
+  "punpcklwd  %%xmm0,%%xmm0                                   \n" \
+  "movdqu     (%[y_buf]),%%xmm4                               \n" \
+  "psrlw      $0x6,%%xmm4                                     \n" \
+  "psllw      $0x6,%%xmm4                                     \n" \
+  "lea        0x10(%[y_buf]),%[y_buf]                         \n"
+
 // Read 4 UV from 422, upsample to 8 UV.  With 8 Alpha.
 #define READYUVA422                                               \
   "movd       (%[u_buf]),%%xmm0                               \n" \
@@ -2207,6 +2525,69 @@ void OMITFP I210ToAR30Row_SSSE3(const uint16_t* y_buf,
   );
 }
 
+#ifdef HAS_P210TOARGBROW_SSSE3
+// 16 bit msb YUV with interleaved UV to ARGB
+void OMITFP P210ToARGBRow_SSSE3(const uint16_t* y_buf,
+                                const uint16_t* uv_buf,
+                                uint8_t* dst_argb,
+                                const struct YuvConstants* yuvconstants,
+                                int width) {
+  asm volatile (
+    YUVTORGB_SETUP(yuvconstants)
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+
+    LABELALIGN
+    "1:                                        \n"
+    READP210
+    YUVTORGB(yuvconstants)
+    STOREARGB
+    "sub       $0x8,%[width]                   \n"
+    "jg        1b                              \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),  // %[uv_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+  : "memory", "cc", YUVTORGB_REGS
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_P210TOARGBROW_SSSE3
+
+#ifdef HAS_P210TOAR30ROW_SSSE3
+// 16 bit msb YUV with interleaved UV to AR30
+void OMITFP P210ToAR30Row_SSSE3(const uint16_t* y_buf,
+                                const uint16_t* uv_buf,
+                                uint8_t* dst_ar30,
+                                const struct YuvConstants* yuvconstants,
+                                int width) {
+  asm volatile (
+    YUVTORGB_SETUP(yuvconstants)
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    "psrlw     $14,%%xmm5                      \n"
+    "psllw     $4,%%xmm5                       \n"  // 2 alpha bits
+    "pxor      %%xmm6,%%xmm6                   \n"
+    "pcmpeqb   %%xmm7,%%xmm7                   \n"  // 0 for min
+    "psrlw     $6,%%xmm7                       \n"  // 1023 for max
+
+    LABELALIGN
+    "1:                                        \n"
+    READP210
+    YUVTORGB16(yuvconstants)
+    STOREAR30
+    "sub       $0x8,%[width]                   \n"
+    "jg        1b                              \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),  // %[uv_buf]
+    [dst_ar30]"+r"(dst_ar30),  // %[dst_ar30]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+  : "memory", "cc", YUVTORGB_REGS
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_P210TOAR30ROW_SSSE3
+
 #ifdef HAS_I422ALPHATOARGBROW_SSSE3
 void OMITFP I422AlphaToARGBRow_SSSE3(const uint8_t* y_buf,
                                      const uint8_t* u_buf,
@@ -2432,6 +2813,18 @@ void OMITFP I422ToRGBARow_SSSE3(const uint8_t* y_buf,
   "vpsllw     $0x6,%%ymm4,%%ymm4                               \n" \
   "lea        0x20(%[y_buf]),%[y_buf]                          \n"
 
+// Read 8 UV from P210, upsample to 16 UV
+#define READP210_AVX2                                              \
+  "vmovdqu    (%[uv_buf]),%%ymm0                               \n" \
+  "lea        0x20(%[uv_buf]),%[uv_buf]                        \n" \
+  "vpsrlw     $0x8,%%ymm0,%%ymm0                               \n" \
+  "vpackuswb  %%ymm0,%%ymm0,%%ymm0                             \n" \
+  "vpunpcklwd %%ymm0,%%ymm0,%%ymm0                             \n" \
+  "vmovdqu    (%[y_buf]),%%ymm4                                \n" \
+  "vpsrlw     $0x6,%%ymm4,%%ymm4                               \n" \
+  "vpsllw     $0x6,%%ymm4,%%ymm4                               \n" \
+  "lea        0x20(%[y_buf]),%[y_buf]                          \n"
+
 // Read 8 UV from 422, upsample to 16 UV.  With 16 Alpha.
 #define READYUVA422_AVX2                                              \
   "vmovq      (%[u_buf]),%%xmm0                                   \n" \
@@ -2648,6 +3041,119 @@ void OMITFP I422ToARGBRow_AVX2(const uint8_t* y_buf,
 }
 #endif  // HAS_I422TOARGBROW_AVX2
 
+#if defined(HAS_I422TOARGBROW_AVX512BW) || defined(HAS_NV12TOARGBROW_AVX512BW)
+// vpermq that places the quarters of 32 values in the low half of each lane,
+// and reorders the unpacked ARGB so the lanes are stored in order.
+static const uint64_t kPermqYUVToARGB_AVX512[8] = {0, 4, 1, 5, 2, 6, 3, 7};
+
+// Read 16 UV from 422, upsample to 32 UV.
+#define READYUV422_AVX512BW                                           \
+  "vmovdqu    (%[u_buf]),%%xmm0                                   \n" \
+  "vmovdqu    0x00(%[u_buf],%[v_buf],1),%%xmm1                    \n" \
+  "lea        0x10(%[u_buf]),%[u_buf]                             \n" \
+  "vpunpckhbw %%xmm1,%%xmm0,%%xmm2                                \n" \
+  "vpunpcklbw %%xmm1,%%xmm0,%%xmm0                                \n" \
+  "vinserti128 $0x1,%%xmm2,%%ymm0,%%ymm0                          \n" \
+  "vpermq     %%zmm0,%%zmm6,%%zmm0                                \n" \
+  "vpunpcklwd %%zmm0,%%zmm0,%%zmm0                                \n" \
+  "vmovdqu    (%[y_buf]),%%ymm4                                   \n" \
+  "vpermq     %%zmm4,%%zmm6,%%zmm4                                \n" \
+  "vpunpcklbw %%zmm4,%%zmm4,%%zmm4                                \n" \
+  "lea        0x20(%[y_buf]),%[y_buf]                             \n"
+
+// Read 16 UV from NV12, upsample to 32 UV.
+#define READNV12_AVX512BW                                             \
+  "vmovdqu    (%[uv_buf]),%%ymm0                                  \n" \
+  "lea        0x20(%[uv_buf]),%[uv_buf]                           \n" \
+  "vpermq     %%zmm0,%%zmm6,%%zmm0                                \n" \
+  "vpunpcklwd %%zmm0,%%zmm0,%%zmm0                                \n" \
+  "vmovdqu    (%[y_buf]),%%ymm4                                   \n" \
+  "vpermq     %%zmm4,%%zmm6,%%zmm4                                \n" \
+  "vpunpcklbw %%zmm4,%%zmm4,%%zmm4                                \n" \
+  "lea        0x20(%[y_buf]),%[y_buf]                             \n"
+
+// The YuvConstants are 256 bits, so broadcast them to both halves.
+#define YUVTORGB_SETUP_AVX512BW(yuvconstants)                        \
+  "vbroadcasti64x4 (%[yuvconstants]),%%zmm8                      \n" \
+  "vbroadcasti64x4 32(%[yuvconstants]),%%zmm9                    \n" \
+  "vbroadcasti64x4 64(%[yuvconstants]),%%zmm10                   \n" \
+  "vbroadcasti64x4 96(%[yuvconstants]),%%zmm11                   \n" \
+  "vbroadcasti64x4 128(%[yuvconstants]),%%zmm12                  \n" \
+  "vbroadcasti64x4 160(%[yuvconstants]),%%zmm13                  \n" \
+  "vbroadcasti64x4 192(%[yuvconstants]),%%zmm14                  \n" \
+  "vmovdqu64   %[kPermqYUVToARGB],%%zmm6                         \n"
+
+// Convert 32 pixels: 32 UV and 32 Y.
+#define YUVTORGB_AVX512BW(yuvconstants)                               \
+  "vpmaddubsw  %%zmm10,%%zmm0,%%zmm2                              \n" \
+  "vpmaddubsw  %%zmm9,%%zmm0,%%zmm1                               \n" \
+  "vpmaddubsw  %%zmm8,%%zmm0,%%zmm0                               \n" \
+  "vpsubw      %%zmm2,%%zmm13,%%zmm2                              \n" \
+  "vpsubw      %%zmm1,%%zmm12,%%zmm1                              \n" \
+  "vpsubw      %%zmm0,%%zmm11,%%zmm0                              \n" \
+  "vpmulhuw    %%zmm14,%%zmm4,%%zmm4                              \n" \
+  "vpaddsw     %%zmm4,%%zmm0,%%zmm0                               \n" \
+  "vpaddsw     %%zmm4,%%zmm1,%%zmm1                               \n" \
+  "vpaddsw     %%zmm4,%%zmm2,%%zmm2                               \n" \
+  "vpsraw      $0x6,%%zmm0,%%zmm0                                 \n" \
+  "vpsraw      $0x6,%%zmm1,%%zmm1                                 \n" \
+  "vpsraw      $0x6,%%zmm2,%%zmm2                                 \n" \
+  "vpackuswb   %%zmm0,%%zmm0,%%zmm0                               \n" \
+  "vpackuswb   %%zmm1,%%zmm1,%%zmm1                               \n" \
+  "vpackuswb   %%zmm2,%%zmm2,%%zmm2                               \n"
+
+#define YUVTORGB_REGS_AVX512BW \
+  "xmm6", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+
+// Store 32 ARGB values.
+#define STOREARGB_AVX512BW                                            \
+  "vpunpcklbw %%zmm1,%%zmm0,%%zmm0                                \n" \
+  "vpermq     %%zmm0,%%zmm6,%%zmm0                                \n" \
+  "vpunpcklbw %%zmm5,%%zmm2,%%zmm2                                \n" \
+  "vpermq     %%zmm2,%%zmm6,%%zmm2                                \n" \
+  "vpunpcklwd %%zmm2,%%zmm0,%%zmm1                                \n" \
+  "vpunpckhwd %%zmm2,%%zmm0,%%zmm0                                \n" \
+  "vmovdqu64  %%zmm1,(%[dst_argb])                                \n" \
+  "vmovdqu64  %%zmm0,0x40(%[dst_argb])                            \n" \
+  "lea        0x80(%[dst_argb]),%[dst_argb]                       \n"
+#endif
+
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+// 32 pixels
+// 16 UV values upsampled to 32 UV, mixed with 32 Y producing 32 ARGB.
+void OMITFP I422ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                                   const uint8_t* u_buf,
+                                   const uint8_t* v_buf,
+                                   uint8_t* dst_argb,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width) {
+  asm volatile (
+    YUVTORGB_SETUP_AVX512BW(yuvconstants)
+    "sub       %[u_buf],%[v_buf]               \n"
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+
+    LABELALIGN
+    "1:                                        \n"
+    READYUV422_AVX512BW
+    YUVTORGB_AVX512BW(yuvconstants)
+    STOREARGB_AVX512BW
+    "sub       $0x20,%[width]                  \n"
+    "jg        1b                              \n"
+
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kPermqYUVToARGB]"m"(kPermqYUVToARGB_AVX512)  // %[kPermqYUVToARGB]
+  : "memory", "cc", YUVTORGB_REGS_AVX512BW
+    "xmm0", "xmm1", "xmm2", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_I422TOARGBROW_AVX512BW
+
 #if defined(HAS_I422TOAR30ROW_AVX2)
 // 16 pixels
 // 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 AR30 (64 bytes).
@@ -2763,6 +3269,75 @@ void OMITFP I210ToAR30Row_AVX2(const uint16_t* y_buf,
 }
 #endif  // HAS_I210TOAR30ROW_AVX2
 
+#if defined(HAS_P210TOARGBROW_AVX2)
+// 16 pixels
+// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 ARGB (64 bytes).
+void OMITFP P210ToARGBRow_AVX2(const uint16_t* y_buf,
+                               const uint16_t* uv_buf,
+                               uint8_t* dst_argb,
+                               const struct YuvConstants* yuvconstants,
+                               int width) {
+  asm volatile (
+    YUVTORGB_SETUP_AVX2(yuvconstants)
+    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"
+
+    LABELALIGN
+    "1:                                        \n"
+    READP210_AVX2
+    YUVTORGB_AVX2(yuvconstants)
+    STOREARGB_AVX2
+    "sub       $0x10,%[width]                  \n"
+    "jg        1b                              \n"
+
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),  // %[uv_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+  : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_P210TOARGBROW_AVX2
+
+#if defined(HAS_P210TOAR30ROW_AVX2)
+// 16 pixels
+// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 AR30 (64 bytes).
+void OMITFP P210ToAR30Row_AVX2(const uint16_t* y_buf,
+                               const uint16_t* uv_buf,
+                               uint8_t* dst_ar30,
+                               const struct YuvConstants* yuvconstants,
+                               int width) {
+  asm volatile (
+    YUVTORGB_SETUP_AVX2(yuvconstants)
+    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"  // AR30 constants
+    "vpsrlw    $14,%%ymm5,%%ymm5               \n"
+    "vpsllw    $4,%%ymm5,%%ymm5                \n"  // 2 alpha bits
+    "vpxor     %%ymm6,%%ymm6,%%ymm6            \n"  // 0 for min
+    "vpcmpeqb  %%ymm7,%%ymm7,%%ymm7            \n"  // 1023 for max
+    "vpsrlw    $6,%%ymm7,%%ymm7                \n"
+
+    LABELALIGN
+    "1:                                        \n"
+    READP210_AVX2
+    YUVTORGB16_AVX2(yuvconstants)
+    STOREAR30_AVX2
+    "sub       $0x10,%[width]                  \n"
+    "jg        1b                              \n"
+
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),  // %[uv_buf]
+    [dst_ar30]"+r"(dst_ar30),  // %[dst_ar30]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+  : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_P210TOAR30ROW_AVX2
+
 #if defined(HAS_I422ALPHATOARGBROW_AVX2)
 // 16 pixels
 // 8 UV values upsampled to 16 UV, mixed with 16 Y and 16 A producing 16 ARGB.
@@ -2881,6 +3456,40 @@ void OMITFP NV12ToARGBRow_AVX2(const uint8_t* y_buf,
 }
 #endif  // HAS_NV12TOARGBROW_AVX2
 
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+// 32 pixels.
+// 16 UV values upsampled to 32 UV, mixed with 32 Y producing 32 ARGB.
+void OMITFP NV12ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                                   const uint8_t* uv_buf,
+                                   uint8_t* dst_argb,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width) {
+  // clang-format off
+  asm volatile (
+    YUVTORGB_SETUP_AVX512BW(yuvconstants)
+    "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+
+    LABELALIGN
+    "1:                                        \n"
+    READNV12_AVX512BW
+    YUVTORGB_AVX512BW(yuvconstants)
+    STOREARGB_AVX512BW
+    "sub       $0x20,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),    // %[uv_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kPermqYUVToARGB]"m"(kPermqYUVToARGB_AVX512)  // %[kPermqYUVToARGB]
+  : "memory", "cc", YUVTORGB_REGS_AVX512BW
+    "xmm0", "xmm1", "xmm2", "xmm4", "xmm5"
+  );
+  // clang-format on
+}
+#endif  // HAS_NV12TOARGBROW_AVX512BW
+
 #if defined(HAS_NV21TOARGBROW_AVX2)
 // 16 pixels.
 // 8 VU values upsampled to 16 UV, mixed with 16 Y producing 16 ARGB (64 bytes).
@@ -3245,20 +3854,62 @@ void SplitUVRow_AVX2(const uint8_t* src_uv,
 }
 #endif  // HAS_SPLITUVROW_AVX2
 
-#ifdef HAS_SPLITUVROW_SSE2
-void SplitUVRow_SSE2(const uint8_t* src_uv,
-                     uint8_t* dst_u,
-                     uint8_t* dst_v,
-                     int width) {
+#ifdef HAS_SPLITUVROW_AVX512BW
+// vpermq for vpackuswb.
+static const uint64_t kPermqPack_AVX512[8] = {0, 2, 4, 6, 1, 3, 5, 7};
+
+void SplitUVRow_AVX512BW(const uint8_t* src_uv,
+                         uint8_t* dst_u,
+                         uint8_t* dst_v,
+                         int width) {
   asm volatile(
-      "pcmpeqb    %%xmm5,%%xmm5                  \n"
-      "psrlw      $0x8,%%xmm5                    \n"
+      "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+      "vpsrlw     $0x8,%%zmm5,%%zmm5             \n"
+      "vmovdqu64  %4,%%zmm4                      \n"
       "sub        %1,%2                          \n"
 
       LABELALIGN
       "1:                                        \n"
-      "movdqu     (%0),%%xmm0                    \n"
-      "movdqu     0x10(%0),%%xmm1                \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpsrlw     $0x8,%%zmm0,%%zmm2             \n"
+      "vpsrlw     $0x8,%%zmm1,%%zmm3             \n"
+      "vpandq     %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpandq     %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpackuswb  %%zmm1,%%zmm0,%%zmm0           \n"
+      "vpackuswb  %%zmm3,%%zmm2,%%zmm2           \n"
+      "vpermq     %%zmm0,%%zmm4,%%zmm0           \n"
+      "vpermq     %%zmm2,%%zmm4,%%zmm2           \n"
+      "vmovdqu64  %%zmm0,(%1)                    \n"
+      "vmovdqu64  %%zmm2,0x00(%1,%2,1)           \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x40,%3                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_uv),             // %0
+        "+r"(dst_u),              // %1
+        "+r"(dst_v),              // %2
+        "+r"(width)               // %3
+      : "m"(kPermqPack_AVX512)    // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5");
+}
+#endif  // HAS_SPLITUVROW_AVX512BW
+
+#ifdef HAS_SPLITUVROW_SSE2
+void SplitUVRow_SSE2(const uint8_t* src_uv,
+                     uint8_t* dst_u,
+                     uint8_t* dst_v,
+                     int width) {
+  asm volatile(
+      "pcmpeqb    %%xmm5,%%xmm5                  \n"
+      "psrlw      $0x8,%%xmm5                    \n"
+      "sub        %1,%2                          \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu     (%0),%%xmm0                    \n"
+      "movdqu     0x10(%0),%%xmm1                \n"
       "lea        0x20(%0),%0                    \n"
       "movdqa     %%xmm0,%%xmm2                  \n"
       "movdqa     %%xmm1,%%xmm3                  \n"
@@ -3315,6 +3966,36 @@ void MergeUVRow_AVX2(const uint8_t* src_u,
 }
 #endif  // HAS_MERGEUVROW_AVX2
 
+#ifdef HAS_MERGEUVROW_AVX512BW
+void MergeUVRow_AVX512BW(const uint8_t* src_u,
+                         const uint8_t* src_v,
+                         uint8_t* dst_uv,
+                         int width) {
+  asm volatile(
+
+      "sub       %0,%1                           \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpmovzxbw  (%0),%%zmm0                    \n"
+      "vpmovzxbw  0x00(%0,%1,1),%%zmm1           \n"
+      "lea        0x20(%0),%0                    \n"
+      "vpsllw     $0x8,%%zmm1,%%zmm1             \n"
+      "vporq      %%zmm0,%%zmm1,%%zmm0           \n"
+      "vmovdqu64  %%zmm0,(%2)                    \n"
+      "lea        0x40(%2),%2                    \n"
+      "sub        $0x20,%3                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_u),   // %0
+        "+r"(src_v),   // %1
+        "+r"(dst_uv),  // %2
+        "+r"(width)    // %3
+      :
+      : "memory", "cc", "xmm0", "xmm1");
+}
+#endif  // HAS_MERGEUVROW_AVX512BW
+
 #ifdef HAS_MERGEUVROW_SSE2
 void MergeUVRow_SSE2(const uint8_t* src_u,
                      const uint8_t* src_v,
@@ -3346,6 +4027,145 @@ void MergeUVRow_SSE2(const uint8_t* src_u,
 }
 #endif  // HAS_MERGEUVROW_SSE2
 
+// Use depth to convert msb formats to lsb, depending how many bits there are:
+// 10 = P010
+// 16 = P016
+// Values are shifted down before the pack, so packssdw can not saturate.
+#ifdef HAS_SPLITUVROW_16_SSE2
+void SplitUVRow_16_SSE2(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width) {
+  depth = 16 - depth;
+  // clang-format off
+  asm volatile (
+    "movd      %4,%%xmm4                       \n"
+    "sub       %1,%2                           \n"
+
+    // 8 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "movdqu    (%0),%%xmm0                     \n"
+    "movdqu    0x10(%0),%%xmm1                 \n"
+    "add       $0x20,%0                        \n"
+    "psrlw     %%xmm4,%%xmm0                   \n"
+    "psrlw     %%xmm4,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "pslld     $0x10,%%xmm0                    \n"
+    "pslld     $0x10,%%xmm1                    \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "psrad     $0x10,%%xmm1                    \n"
+    "psrad     $0x10,%%xmm2                    \n"
+    "psrad     $0x10,%%xmm3                    \n"
+    "packssdw  %%xmm1,%%xmm0                   \n"
+    "packssdw  %%xmm3,%%xmm2                   \n"
+    "movdqu    %%xmm0,(%1)                     \n"
+    "movdqu    %%xmm2,0x00(%1,%2,1)            \n"
+    "add       $0x10,%1                        \n"
+    "sub       $0x8,%3                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_uv),  // %0
+    "+r"(dst_u),   // %1
+    "+r"(dst_v),   // %2
+    "+r"(width)    // %3
+  : "r"(depth)     // %4
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4");
+  // clang-format on
+}
+#endif  // HAS_SPLITUVROW_16_SSE2
+
+#ifdef HAS_SPLITUVROW_16_AVX2
+void SplitUVRow_16_AVX2(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width) {
+  depth = 16 - depth;
+  // clang-format off
+  asm volatile (
+    "vmovd      %4,%%xmm4                      \n"
+    "sub       %1,%2                           \n"
+
+    // 16 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "vmovdqu   (%0),%%ymm0                     \n"
+    "vmovdqu   0x20(%0),%%ymm1                 \n"
+    "add       $0x40,%0                        \n"
+    "vpsrlw    %%xmm4,%%ymm0,%%ymm0            \n"
+    "vpsrlw    %%xmm4,%%ymm1,%%ymm1            \n"
+    "vpslld    $0x10,%%ymm0,%%ymm2             \n"
+    "vpslld    $0x10,%%ymm1,%%ymm3             \n"
+    "vpsrad    $0x10,%%ymm2,%%ymm2             \n"
+    "vpsrad    $0x10,%%ymm3,%%ymm3             \n"
+    "vpsrad    $0x10,%%ymm0,%%ymm0             \n"
+    "vpsrad    $0x10,%%ymm1,%%ymm1             \n"
+    "vpackssdw %%ymm3,%%ymm2,%%ymm2            \n"  // mutates
+    "vpackssdw %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm2,%%ymm2             \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vmovdqu   %%ymm2,(%1)                     \n"
+    "vmovdqu   %%ymm0,0x00(%1,%2,1)            \n"
+    "add       $0x20,%1                        \n"
+    "sub       $0x10,%3                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_uv),  // %0
+    "+r"(dst_u),   // %1
+    "+r"(dst_v),   // %2
+    "+r"(width)    // %3
+  : "r"(depth)     // %4
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4");
+  // clang-format on
+}
+#endif  // HAS_SPLITUVROW_16_AVX2
+
+// Use scale to convert lsb formats to msb, depending how many bits there are:
+// 128 = 9 bits
+// 64 = 10 bits
+// 16 = 12 bits
+// 1 = 16 bits
+#ifdef HAS_MERGEUVROW_16_SSE2
+void MergeUVRow_16_SSE2(const uint16_t* src_u,
+                        const uint16_t* src_v,
+                        uint16_t* dst_uv,
+                        int scale,
+                        int width) {
+  // clang-format off
+  asm volatile (
+    "movd      %4,%%xmm3                       \n"
+    "punpcklwd %%xmm3,%%xmm3                   \n"
+    "pshufd    $0x0,%%xmm3,%%xmm3              \n"
+    "sub       %0,%1                           \n"
+
+    // 8 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "movdqu    (%0),%%xmm0                     \n"
+    "movdqu    (%0,%1,1),%%xmm1                \n"
+    "add       $0x10,%0                        \n"
+    "pmullw    %%xmm3,%%xmm0                   \n"
+    "pmullw    %%xmm3,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "punpcklwd %%xmm1,%%xmm0                   \n"
+    "punpckhwd %%xmm1,%%xmm2                   \n"
+    "movdqu    %%xmm0,(%2)                     \n"
+    "movdqu    %%xmm2,0x10(%2)                 \n"
+    "add       $0x20,%2                        \n"
+    "sub       $0x8,%3                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_u),   // %0
+    "+r"(src_v),   // %1
+    "+r"(dst_uv),  // %2
+    "+r"(width)    // %3
+  : "r"(scale)     // %4
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+  // clang-format on
+}
+#endif  // HAS_MERGEUVROW_16_SSE2
+
 // Use scale to convert lsb formats to msb, depending how many bits there are:
 // 128 = 9 bits
 // 64 = 10 bits
@@ -3398,6 +4218,39 @@ void MergeUVRow_16_AVX2(const uint16_t* src_u,
 // 64 = 10 bits
 // 16 = 12 bits
 // 1 = 16 bits
+#ifdef HAS_MULTIPLYROW_16_SSE2
+void MultiplyRow_16_SSE2(const uint16_t* src_y,
+                         uint16_t* dst_y,
+                         int scale,
+                         int width) {
+  // clang-format off
+  asm volatile (
+    "movd      %3,%%xmm3                       \n"
+    "punpcklwd %%xmm3,%%xmm3                   \n"
+    "pshufd    $0x0,%%xmm3,%%xmm3              \n"
+    "sub       %0,%1                           \n"
+
+    // 16 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "movdqu    (%0),%%xmm0                     \n"
+    "movdqu    0x10(%0),%%xmm1                 \n"
+    "pmullw    %%xmm3,%%xmm0                   \n"
+    "pmullw    %%xmm3,%%xmm1                   \n"
+    "movdqu    %%xmm0,(%0,%1)                  \n"
+    "movdqu    %%xmm1,0x10(%0,%1)              \n"
+    "add       $0x20,%0                        \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_y),   // %0
+    "+r"(dst_y),   // %1
+    "+r"(width)    // %2
+  : "r"(scale)     // %3
+  : "memory", "cc", "xmm0", "xmm1", "xmm3");
+  // clang-format on
+}
+#endif  // HAS_MULTIPLYROW_16_SSE2
+
 #ifdef HAS_MULTIPLYROW_16_AVX2
 void MultiplyRow_16_AVX2(const uint16_t* src_y,
                          uint16_t* dst_y,
@@ -3432,6 +4285,144 @@ void MultiplyRow_16_AVX2(const uint16_t* src_y,
 }
 #endif  // HAS_MULTIPLYROW_16_AVX2
 
+// Use scale to convert msb formats to lsb, depending how many bits there are:
+// 512 = 9 bits
+// 1024 = 10 bits
+// 4096 = 12 bits
+#ifdef HAS_DIVIDEROW_16_SSE2
+void DivideRow_16_SSE2(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width) {
+  // clang-format off
+  asm volatile (
+    "movd      %3,%%xmm3                       \n"
+    "punpcklwd %%xmm3,%%xmm3                   \n"
+    "pshufd    $0x0,%%xmm3,%%xmm3              \n"
+    "sub       %0,%1                           \n"
+
+    // 16 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "movdqu    (%0),%%xmm0                     \n"
+    "movdqu    0x10(%0),%%xmm1                 \n"
+    "pmulhuw   %%xmm3,%%xmm0                   \n"
+    "pmulhuw   %%xmm3,%%xmm1                   \n"
+    "movdqu    %%xmm0,(%0,%1)                  \n"
+    "movdqu    %%xmm1,0x10(%0,%1)              \n"
+    "add       $0x20,%0                        \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_y),   // %0
+    "+r"(dst_y),   // %1
+    "+r"(width)    // %2
+  : "r"(scale)     // %3
+  : "memory", "cc", "xmm0", "xmm1", "xmm3");
+  // clang-format on
+}
+#endif  // HAS_DIVIDEROW_16_SSE2
+
+#ifdef HAS_DIVIDEROW_16_AVX2
+void DivideRow_16_AVX2(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width) {
+  // clang-format off
+  asm volatile (
+    "vmovd      %3,%%xmm3                      \n"
+    "vpunpcklwd %%xmm3,%%xmm3,%%xmm3           \n"
+    "vbroadcastss %%xmm3,%%ymm3                \n"
+    "sub       %0,%1                           \n"
+
+    // 32 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "vmovdqu   (%0),%%ymm0                     \n"
+    "vmovdqu   0x20(%0),%%ymm1                 \n"
+    "vpmulhuw  %%ymm3,%%ymm0,%%ymm0            \n"
+    "vpmulhuw  %%ymm3,%%ymm1,%%ymm1            \n"
+    "vmovdqu   %%ymm0,(%0,%1)                  \n"
+    "vmovdqu   %%ymm1,0x20(%0,%1)              \n"
+    "add        $0x40,%0                       \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_y),   // %0
+    "+r"(dst_y),   // %1
+    "+r"(width)    // %2
+  : "r"(scale)     // %3
+  : "memory", "cc", "xmm0", "xmm1", "xmm3");
+  // clang-format on
+}
+#endif  // HAS_DIVIDEROW_16_AVX2
+
+// Round msb formats to 8 bits.  paddusw saturates so 0xffff rounds to 255.
+#ifdef HAS_ROUND16TO8ROW_SSE2
+void Round16To8Row_SSE2(const uint16_t* src_y, uint8_t* dst_y, int width) {
+  // clang-format off
+  asm volatile (
+    "pcmpeqb   %%xmm2,%%xmm2                   \n"
+    "psrlw     $15,%%xmm2                      \n"
+    "psllw     $7,%%xmm2                       \n"  // 128 for rounding
+
+    // 16 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "movdqu    (%0),%%xmm0                     \n"
+    "movdqu    0x10(%0),%%xmm1                 \n"
+    "add       $0x20,%0                        \n"
+    "paddusw   %%xmm2,%%xmm0                   \n"
+    "paddusw   %%xmm2,%%xmm1                   \n"
+    "psrlw     $8,%%xmm0                       \n"
+    "psrlw     $8,%%xmm1                       \n"
+    "packuswb  %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0,(%1)                     \n"
+    "add       $0x10,%1                        \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_y),   // %0
+    "+r"(dst_y),   // %1
+    "+r"(width)    // %2
+  :
+  : "memory", "cc", "xmm0", "xmm1", "xmm2");
+  // clang-format on
+}
+#endif  // HAS_ROUND16TO8ROW_SSE2
+
+#ifdef HAS_ROUND16TO8ROW_AVX2
+void Round16To8Row_AVX2(const uint16_t* src_y, uint8_t* dst_y, int width) {
+  // clang-format off
+  asm volatile (
+    "vpcmpeqb  %%ymm2,%%ymm2,%%ymm2            \n"
+    "vpsrlw    $15,%%ymm2,%%ymm2               \n"
+    "vpsllw    $7,%%ymm2,%%ymm2                \n"  // 128 for rounding
+
+    // 32 pixels per loop.
+    LABELALIGN
+    "1:                                        \n"
+    "vmovdqu   (%0),%%ymm0                     \n"
+    "vmovdqu   0x20(%0),%%ymm1                 \n"
+    "add       $0x40,%0                        \n"
+    "vpaddusw  %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpaddusw  %%ymm2,%%ymm1,%%ymm1            \n"
+    "vpsrlw    $8,%%ymm0,%%ymm0                \n"
+    "vpsrlw    $8,%%ymm1,%%ymm1                \n"
+    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"  // mutates
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vmovdqu   %%ymm0,(%1)                     \n"
+    "add       $0x20,%1                        \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_y),   // %0
+    "+r"(dst_y),   // %1
+    "+r"(width)    // %2
+  :
+  : "memory", "cc", "xmm0", "xmm1", "xmm2");
+  // clang-format on
+}
+#endif  // HAS_ROUND16TO8ROW_AVX2
+
 // Use scale to convert lsb formats to msb, depending how many bits there are:
 // 32768 = 9 bits
 // 16384 = 10 bits
@@ -3830,6 +4821,29 @@ void CopyRow_AVX(const uint8_t* src, uint8_t* dst, int width) {
 }
 #endif  // HAS_COPYROW_AVX
 
+#ifdef HAS_COPYROW_AVX512BW
+void CopyRow_AVX512BW(const uint8_t* src, uint8_t* dst, int width) {
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64 (%0),%%zmm0                     \n"
+      "vmovdqu64 0x40(%0),%%zmm1                 \n"
+      "lea       0x80(%0),%0                     \n"
+      "vmovdqu64 %%zmm0,(%1)                     \n"
+      "vmovdqu64 %%zmm1,0x40(%1)                 \n"
+      "lea       0x80(%1),%1                     \n"
+      "sub       $0x80,%2                        \n"
+      "jg        1b                              \n"
+      "vzeroupper                                \n"
+      : "+r"(src),   // %0
+        "+r"(dst),   // %1
+        "+r"(width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1");
+}
+#endif  // HAS_COPYROW_AVX512BW
+
 #ifdef HAS_COPYROW_ERMS
 // Multiple of 1.
 void CopyRow_ERMS(const uint8_t* src, uint8_t* dst, int width) {
@@ -6051,6 +7065,229 @@ void InterpolateRow_AVX2(uint8_t* dst_ptr,
 }
 #endif  // HAS_INTERPOLATEROW_AVX2
 
+#ifdef HAS_INTERPOLATEROW_16_SSE2
+// Bilinear filter 8x2 -> 8x1 for 16 bit pixels.
+// Pixels are made signed so pmaddwd can blend 2 rows with 8 bit fractions.
+void InterpolateRow_16_SSE2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int dst_width,
+                            int source_y_fraction) {
+  asm volatile(
+      "sub       %1,%0                           \n"
+      "cmp       $0x0,%3                         \n"
+      "je        100f                            \n"
+      "cmp       $0x80,%3                        \n"
+      "je        50f                             \n"
+
+      "movd      %3,%%xmm0                       \n"
+      "neg       %3                              \n"
+      "add       $0x100,%3                       \n"
+      "movd      %3,%%xmm5                       \n"
+      "punpcklwd %%xmm0,%%xmm5                   \n"
+      "pshufd    $0x0,%%xmm5,%%xmm5              \n"
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"
+      "psllw     $0xf,%%xmm4                     \n"  // 0x8000
+
+      // General purpose row blend.
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%1),%%xmm0                     \n"
+      "movdqu    0x00(%1,%4,2),%%xmm2            \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm2                   \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "punpcklwd %%xmm2,%%xmm0                   \n"
+      "punpckhwd %%xmm2,%%xmm1                   \n"
+      "pmaddwd   %%xmm5,%%xmm0                   \n"
+      "pmaddwd   %%xmm5,%%xmm1                   \n"
+      "psrad     $0x8,%%xmm0                     \n"
+      "psrad     $0x8,%%xmm1                     \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "movdqu    %%xmm0,0x00(%1,%0,1)            \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      "jmp       99f                             \n"
+
+      // Blend 50 / 50.
+      LABELALIGN
+      "50:                                       \n"
+      "movdqu    (%1),%%xmm0                     \n"
+      "movdqu    0x00(%1,%4,2),%%xmm1            \n"
+      "pavgw     %%xmm1,%%xmm0                   \n"
+      "movdqu    %%xmm0,0x00(%1,%0,1)            \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        50b                             \n"
+      "jmp       99f                             \n"
+
+      // Blend 100 / 0 - Copy row unchanged.
+      LABELALIGN
+      "100:                                      \n"
+      "movdqu    (%1),%%xmm0                     \n"
+      "movdqu    %%xmm0,0x00(%1,%0,1)            \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        100b                            \n"
+
+      "99:                                       \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(src_ptr),               // %1
+        "+rm"(dst_width),            // %2
+        "+r"(source_y_fraction)      // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5");
+}
+#endif  // HAS_INTERPOLATEROW_16_SSE2
+
+#ifdef HAS_INTERPOLATEROW_16_AVX2
+// Bilinear filter 16x2 -> 16x1 for 16 bit pixels.
+void InterpolateRow_16_AVX2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int dst_width,
+                            int source_y_fraction) {
+  asm volatile(
+      "sub        %1,%0                          \n"
+      "cmp        $0x0,%3                        \n"
+      "je         100f                           \n"
+      "cmp        $0x80,%3                       \n"
+      "je         50f                            \n"
+
+      "vmovd      %3,%%xmm0                      \n"
+      "neg        %3                             \n"
+      "add        $0x100,%3                      \n"
+      "vmovd      %3,%%xmm5                      \n"
+      "vpunpcklwd %%xmm0,%%xmm5,%%xmm5           \n"
+      "vbroadcastss %%xmm5,%%ymm5                \n"
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpsllw     $0xf,%%ymm4,%%ymm4             \n"  // 0x8000
+
+      // General purpose row blend.
+      LABELALIGN
+      "1:                                        \n"
+      "vpxor      (%1),%%ymm4,%%ymm0             \n"
+      "vpxor      0x00(%1,%4,2),%%ymm4,%%ymm2    \n"
+      "vpunpckhwd %%ymm2,%%ymm0,%%ymm1           \n"
+      "vpunpcklwd %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpmaddwd   %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpsrad     $0x8,%%ymm1,%%ymm1             \n"
+      "vpsrad     $0x8,%%ymm0,%%ymm0             \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,0x00(%1,%0,1)           \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "jmp        99f                            \n"
+
+      // Blend 50 / 50.
+      LABELALIGN
+      "50:                                       \n"
+      "vmovdqu    (%1),%%ymm0                    \n"
+      "vpavgw     0x00(%1,%4,2),%%ymm0,%%ymm0    \n"
+      "vmovdqu    %%ymm0,0x00(%1,%0,1)           \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         50b                            \n"
+      "jmp        99f                            \n"
+
+      // Blend 100 / 0 - Copy row unchanged.
+      LABELALIGN
+      "100:                                      \n"
+      "vmovdqu    (%1),%%ymm0                    \n"
+      "vmovdqu    %%ymm0,0x00(%1,%0,1)           \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         100b                           \n"
+
+      "99:                                       \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(src_ptr),               // %1
+        "+rm"(dst_width),            // %2
+        "+r"(source_y_fraction)      // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5");
+}
+#endif  // HAS_INTERPOLATEROW_16_AVX2
+
+#ifdef HAS_INTERPOLATEROW_16_AVX512BW
+// Bilinear filter 32x2 -> 32x1 for 16 bit pixels.
+void InterpolateRow_16_AVX512BW(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int dst_width,
+                                int source_y_fraction) {
+  asm volatile(
+      "sub        %1,%0                          \n"
+      "cmp        $0x0,%3                        \n"
+      "je         100f                           \n"
+      "cmp        $0x80,%3                       \n"
+      "je         50f                            \n"
+
+      "vmovd      %3,%%xmm0                      \n"
+      "neg        %3                             \n"
+      "add        $0x100,%3                      \n"
+      "vmovd      %3,%%xmm5                      \n"
+      "vpunpcklwd %%xmm0,%%xmm5,%%xmm5           \n"
+      "vpbroadcastd %%xmm5,%%zmm5                \n"
+      "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+      "vpsllw     $0xf,%%zmm4,%%zmm4             \n"  // 0x8000
+
+      // General purpose row blend.
+      LABELALIGN
+      "1:                                        \n"
+      "vpxord     (%1),%%zmm4,%%zmm0             \n"
+      "vpxord     0x00(%1,%4,2),%%zmm4,%%zmm2    \n"
+      "vpunpckhwd %%zmm2,%%zmm0,%%zmm1           \n"
+      "vpunpcklwd %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpmaddwd   %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpmaddwd   %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpsrad     $0x8,%%zmm1,%%zmm1             \n"
+      "vpsrad     $0x8,%%zmm0,%%zmm0             \n"
+      "vpackssdw  %%zmm1,%%zmm0,%%zmm0           \n"
+      "vpxord     %%zmm4,%%zmm0,%%zmm0           \n"
+      "vmovdqu64  %%zmm0,0x00(%1,%0,1)           \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "jmp        99f                            \n"
+
+      // Blend 50 / 50.
+      LABELALIGN
+      "50:                                       \n"
+      "vmovdqu64  (%1),%%zmm0                    \n"
+      "vpavgw     0x00(%1,%4,2),%%zmm0,%%zmm0    \n"
+      "vmovdqu64  %%zmm0,0x00(%1,%0,1)           \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         50b                            \n"
+      "jmp        99f                            \n"
+
+      // Blend 100 / 0 - Copy row unchanged.
+      LABELALIGN
+      "100:                                      \n"
+      "vmovdqu64  (%1),%%zmm0                    \n"
+      "vmovdqu64  %%zmm0,0x00(%1,%0,1)           \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         100b                           \n"
+
+      "99:                                       \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(src_ptr),               // %1
+        "+rm"(dst_width),            // %2
+        "+r"(source_y_fraction)      // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5");
+}
+#endif  // HAS_INTERPOLATEROW_16_AVX512BW
+
 #ifdef HAS_ARGBSHUFFLEROW_SSSE3
 // For BGRAToARGB, ABGRToARGB, RGBAToARGB, and ARGBToRGBA.
 void ARGBShuffleRow_SSSE3(const uint8_t* src_argb,
@@ -378,6 +378,65 @@ void J400ToARGBRow_NEON(const uint8_t* src_y, uint8_t* dst_argb, int width) {
       : "cc", "memory", "d20", "d21", "d22", "d23");
 }
 
+// Same as BayerRowToARGBRow_C.  The averages h, v, avg(h, v) and the diagonal
+// are computed for every pixel, then the site mask picks the ones for red or
+// blue pixels and green pixels, and the blue mask swaps red and blue.
+// Each row is read at x - 1, x and x + 1 by stepping the pointer 1, 1 and 14.
+void BayerRowToARGBRow_NEON(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width) {
+  const int site = (bayer_row & 1) ? 0xff00 : 0x00ff;
+  const int blue = (bayer_row & 2) ? 0xff : 0;
+  src_bayer0 -= 1;
+  src_bayer1 -= 1;
+  src_bayer2 -= 1;
+  asm volatile(
+      "vdup.16    q14, %5                        \n"  // red or blue pixels
+      "vdup.8     q15, %6                        \n"  // blue row
+      "vmov.u8    q11, #255                      \n"  // A
+      "1:                                        \n"
+      "vld1.8     {q0}, [%1], %7                 \n"  // src_bayer1[x - 1]
+      "vld1.8     {q2}, [%1], %7                 \n"  // src_bayer1[x]
+      "vld1.8     {q12}, [%1], %8                \n"  // src_bayer1[x + 1]
+      "vrhadd.u8  q0, q0, q12                    \n"  // h
+      "vld1.8     {q3}, [%0], %7                 \n"
+      "vld1.8     {q1}, [%0], %7                 \n"
+      "vld1.8     {q12}, [%0], %8                \n"
+      "vrhadd.u8  q3, q3, q12                    \n"
+      "vld1.8     {q12}, [%2], %7                \n"
+      "vld1.8     {q13}, [%2], %7                \n"
+      "vrhadd.u8  q1, q1, q13                    \n"  // v
+      "vld1.8     {q13}, [%2], %8                \n"
+      "vrhadd.u8  q12, q12, q13                  \n"
+      "vrhadd.u8  q3, q3, q12                    \n"  // diagonal
+      "vrhadd.u8  q9, q0, q1                     \n"  // avg(h, v)
+      "vbit       q0, q2, q14                    \n"  // color of the row
+      "vbif       q9, q2, q14                    \n"  // G
+      "vbit       q1, q3, q14                    \n"  // other color
+      "vmov       q10, q15                       \n"
+      "vbsl       q10, q1, q0                    \n"  // R
+      "vmov       q8, q15                        \n"
+      "vbsl       q8, q0, q1                     \n"  // B
+      "subs       %4, %4, #16                    \n"  // 16 pixels per loop
+      "vst4.8     {d16, d18, d20, d22}, [%3]!    \n"
+      "vst4.8     {d17, d19, d21, d23}, [%3]!    \n"
+      "bgt        1b                             \n"
+      : "+r"(src_bayer0),  // %0
+        "+r"(src_bayer1),  // %1
+        "+r"(src_bayer2),  // %2
+        "+r"(dst_argb),    // %3
+        "+r"(width)        // %4
+      : "r"(site),         // %5
+        "r"(blue),         // %6
+        "r"(1),            // %7
+        "r"(14)            // %8
+      : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11",
+        "q12", "q13", "q14", "q15");
+}
+
 void NV12ToARGBRow_NEON(const uint8_t* src_y,
                         const uint8_t* src_uv,
                         uint8_t* dst_argb,
@@ -543,6 +602,114 @@ void UYVYToARGBRow_NEON(const uint8_t* src_uyvy,
                  "q10", "q11", "q12", "q13", "q14", "q15");
 }
 
+// Read 8 Y and 4 UV from P210.  Y keeps its upper 10 bits and UV its upper
+// 8 bits, as in the C version.
+#define READP210                                 \
+  "vld1.16    {q0}, [%0]!                    \n" \
+  "vld1.16    {q1}, [%1]!                    \n" \
+  "vbic.i16   q0, #0x3f                      \n" \
+  "vshrn.u16  d2, q1, #8                     \n" \
+  "vmov.u8    d3, d2                         \n" \
+  "vuzp.u8    d2, d3                         \n" \
+  "vtrn.u32   d2, d3                         \n"
+
+// Same as YUVTORGB but for 16 bit Y, which is multiplied by YG in d30, and
+// the results are left in q8, q0 and q9 as 16 bit B, G and R scaled by 64
+// like YuvPixel16.
+#define P210TORGB16                                                           \
+  "vmull.u8   q8, d2, d24                    \n" /* u/v B/R component      */ \
+  "vmull.u8   q9, d2, d25                    \n" /* u/v G component        */ \
+  "vmull.u16  q10, d1, d30                   \n" /* Y * YG                 */ \
+  "vmull.u16  q0, d0, d30                    \n"                              \
+  "vshrn.u32  d0, q0, #16                    \n"                              \
+  "vshrn.u32  d1, q10, #16                   \n" /* Y                      */ \
+  "vadd.s16   d18, d19                       \n"                              \
+  "vshll.u16  q1, d16, #16                   \n" /* Replicate u * UB       */ \
+  "vshll.u16  q10, d17, #16                  \n" /* Replicate v * VR       */ \
+  "vshll.u16  q3, d18, #16                   \n" /* Replicate (v*VG + u*UG)*/ \
+  "vaddw.u16  q1, q1, d16                    \n"                              \
+  "vaddw.u16  q10, q10, d17                  \n"                              \
+  "vaddw.u16  q3, q3, d18                    \n"                              \
+  "vqadd.s16  q8, q0, q13                    \n" /* B */                      \
+  "vqadd.s16  q9, q0, q14                    \n" /* R */                      \
+  "vqadd.s16  q0, q0, q4                     \n" /* G */                      \
+  "vqadd.s16  q8, q8, q1                     \n" /* B */                      \
+  "vqadd.s16  q9, q9, q10                    \n" /* R */                      \
+  "vqsub.s16  q0, q0, q3                     \n" /* G */
+
+void P210ToARGBRow_NEON(const uint16_t* src_y,
+                        const uint16_t* src_uv,
+                        uint8_t* dst_argb,
+                        const struct YuvConstants* yuvconstants,
+                        int width) {
+  const int yg = yuvconstants->kYToRgb[0] / 0x0101;
+  asm volatile(
+      YUVTORGB_SETUP
+      "vdup.16    d30, %[kYG]                    \n"  // YG for 16 bit Y
+      "vmov.u8    d23, #255                      \n"
+      "1:                                        \n" READP210 P210TORGB16
+      "vqshrun.s16 d20, q8, #6                   \n"  // B
+      "vqshrun.s16 d22, q9, #6                   \n"  // R
+      "vqshrun.s16 d21, q0, #6                   \n"  // G
+      "subs       %3, %3, #8                     \n"
+      "vst4.8     {d20, d21, d22, d23}, [%2]!    \n"
+      "bgt        1b                             \n"
+      : "+r"(src_y),     // %0
+        "+r"(src_uv),    // %1
+        "+r"(dst_argb),  // %2
+        "+r"(width)      // %3
+      : [kUVToRB] "r"(&yuvconstants->kUVToRB),
+        [kUVToG] "r"(&yuvconstants->kUVToG),
+        [kUVBiasBGR] "r"(&yuvconstants->kUVBiasBGR),
+        [kYToRgb] "r"(&yuvconstants->kYToRgb), [kYG] "r"(yg)
+      : "cc", "memory", "q0", "q1", "q2", "q3", "q4", "q8", "q9", "q10", "q11",
+        "q12", "q13", "q14", "q15");
+}
+
+void P210ToAR30Row_NEON(const uint16_t* src_y,
+                        const uint16_t* src_uv,
+                        uint8_t* dst_ar30,
+                        const struct YuvConstants* yuvconstants,
+                        int width) {
+  const int yg = yuvconstants->kYToRgb[0] / 0x0101;
+  asm volatile(
+      YUVTORGB_SETUP
+      "vdup.16    d30, %[kYG]                    \n"  // YG for 16 bit Y
+      "1:                                        \n" READP210 P210TORGB16
+      // Saturating x << 2 to 0..65535 then >> 6 clamps x >> 4 to 10 bits.
+      "vqshlu.s16 q8, q8, #2                     \n"  // B
+      "vqshlu.s16 q0, q0, #2                     \n"  // G
+      "vqshlu.s16 q9, q9, #2                     \n"  // R
+      "vshr.u16   q8, q8, #6                     \n"
+      "vshr.u16   q0, q0, #6                     \n"
+      "vshr.u16   q9, q9, #6                     \n"
+      "vmovl.u16  q2, d16                        \n"  // B
+      "vmovl.u16  q3, d17                        \n"
+      "vmovl.u16  q10, d0                        \n"  // G
+      "vmovl.u16  q11, d1                        \n"
+      "vsli.32    q2, q10, #10                   \n"
+      "vsli.32    q3, q11, #10                   \n"
+      "vmovl.u16  q10, d18                       \n"  // R
+      "vmovl.u16  q11, d19                       \n"
+      "vsli.32    q2, q10, #20                   \n"
+      "vsli.32    q3, q11, #20                   \n"
+      "vorr.i32   q2, #0xc0000000                \n"  // A
+      "vorr.i32   q3, #0xc0000000                \n"
+      "subs       %3, %3, #8                     \n"
+      "vst1.32    {q2, q3}, [%2]!                \n"
+      "bgt        1b                             \n"
+      : "+r"(src_y),     // %0
+        "+r"(src_uv),    // %1
+        "+r"(dst_ar30),  // %2
+        "+r"(width)      // %3
+      : [kUVToRB] "r"(&yuvconstants->kUVToRB),
+        [kUVToG] "r"(&yuvconstants->kUVToG),
+        [kUVBiasBGR] "r"(&yuvconstants->kUVBiasBGR),
+        [kYToRgb] "r"(&yuvconstants->kYToRgb), [kYG] "r"(yg)
+      : "cc", "memory", "q0", "q1", "q2", "q3", "q4", "q8", "q9", "q10", "q11",
+        "q12", "q13", "q14", "q15");
+}
+
 // Reads 16 pairs of UV and write even values to dst_u and odd to dst_v.
 void SplitUVRow_NEON(const uint8_t* src_uv,
                      uint8_t* dst_u,
@@ -585,6 +752,75 @@ void MergeUVRow_NEON(const uint8_t* src_u,
   );
 }
 
+// Reads 8 pairs of 16 bit UV and writes U and V shifted down to depth bits.
+void SplitUVRow_16_NEON(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width) {
+  int shift = depth - 16;  // Negative shifts right.
+  asm volatile(
+      "vdup.16    q2, %4                         \n"
+      "1:                                        \n"
+      "vld2.16    {q0, q1}, [%0]!                \n"  // load 8 pairs of UV
+      "subs       %3, %3, #8                     \n"  // 8 processed per loop
+      "vshl.u16   q0, q0, q2                     \n"
+      "vshl.u16   q1, q1, q2                     \n"
+      "vst1.16    {q0}, [%1]!                    \n"  // store U
+      "vst1.16    {q1}, [%2]!                    \n"  // store V
+      "bgt        1b                             \n"
+      : "+r"(src_uv),  // %0
+        "+r"(dst_u),   // %1
+        "+r"(dst_v),   // %2
+        "+r"(width)    // %3
+      : "r"(shift)     // %4
+      : "cc", "memory", "q0", "q1", "q2");
+}
+
+// Use scale to convert msb formats to lsb.  scale is 1 << depth.
+void DivideRow_16_NEON(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width) {
+  asm volatile(
+      "vdup.16    q2, %3                         \n"
+      "1:                                        \n"
+      "vld1.16    {q0, q1}, [%0]!                \n"  // load 16 shorts
+      "subs       %2, %2, #16                    \n"  // 16 processed per loop
+      "vmull.u16  q3, d0, d4                     \n"
+      "vmull.u16  q8, d1, d4                     \n"
+      "vmull.u16  q9, d2, d4                     \n"
+      "vmull.u16  q10, d3, d4                    \n"
+      "vshrn.u32  d0, q3, #16                    \n"  // upper 16 bits
+      "vshrn.u32  d1, q8, #16                    \n"
+      "vshrn.u32  d2, q9, #16                    \n"
+      "vshrn.u32  d3, q10, #16                   \n"
+      "vst1.16    {q0, q1}, [%1]!                \n"  // store 16 shorts
+      "bgt        1b                             \n"
+      : "+r"(src_y),  // %0
+        "+r"(dst_y),  // %1
+        "+r"(width)   // %2
+      : "r"(scale)    // %3
+      : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10");
+}
+
+// Round msb formats to 8 bits.
+void Round16To8Row_NEON(const uint16_t* src_y, uint8_t* dst_y, int width) {
+  asm volatile(
+      "1:                                        \n"
+      "vld1.16    {q0, q1}, [%0]!                \n"  // load 16 shorts
+      "subs       %2, %2, #16                    \n"  // 16 processed per loop
+      "vqrshrn.u16 d0, q0, #8                    \n"  // round and saturate
+      "vqrshrn.u16 d1, q1, #8                    \n"
+      "vst1.8     {q0}, [%1]!                    \n"  // store 16 bytes
+      "bgt        1b                             \n"
+      : "+r"(src_y),  // %0
+        "+r"(dst_y),  // %1
+        "+r"(width)   // %2
+      :
+      : "cc", "memory", "q0", "q1");
+}
+
 // Reads 16 packed RGB and write to planar dst_r, dst_g, dst_b.
 void SplitRGBRow_NEON(const uint8_t* src_rgb,
                       uint8_t* dst_r,
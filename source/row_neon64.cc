@@ -409,6 +409,58 @@ void J400ToARGBRow_NEON(const uint8_t* src_y, uint8_t* dst_argb, int width) {
       : "cc", "memory", "v20", "v21", "v22", "v23");
 }
 
+// Same as BayerRowToARGBRow_C.  The averages h, v, avg(h, v) and the diagonal
+// are computed for every pixel, then the site mask picks the ones for red or
+// blue pixels and green pixels, and the blue mask swaps red and blue.
+void BayerRowToARGBRow_NEON(const uint8_t* src_bayer0,
+                            const uint8_t* src_bayer1,
+                            const uint8_t* src_bayer2,
+                            uint8_t* dst_argb,
+                            int bayer_row,
+                            int width) {
+  const int site = (bayer_row & 1) ? 0xff00 : 0x00ff;
+  const int blue = (bayer_row & 2) ? 0xff : 0;
+  asm volatile(
+      "dup        v6.8h, %w5                     \n"  // red or blue pixels
+      "dup        v7.16b, %w6                    \n"  // blue row
+      "movi       v23.16b, #255                  \n"  // A
+      "1:                                        \n"
+      "ldur       q0, [%1, #-1]                  \n"  // src_bayer1[x - 1]
+      "ldur       q1, [%1, #1]                   \n"  // src_bayer1[x + 1]
+      "ld1        {v4.16b}, [%1], #16            \n"  // src_bayer1[x]
+      "urhadd     v0.16b, v0.16b, v1.16b         \n"  // h
+      "ldur       q2, [%0, #-1]                  \n"
+      "ldur       q3, [%0, #1]                   \n"
+      "ld1        {v1.16b}, [%0], #16            \n"
+      "urhadd     v3.16b, v2.16b, v3.16b         \n"
+      "ldur       q2, [%2, #-1]                  \n"
+      "ldur       q5, [%2, #1]                   \n"
+      "urhadd     v2.16b, v2.16b, v5.16b         \n"
+      "urhadd     v3.16b, v3.16b, v2.16b         \n"  // diagonal
+      "ld1        {v2.16b}, [%2], #16            \n"
+      "urhadd     v1.16b, v1.16b, v2.16b         \n"  // v
+      "urhadd     v21.16b, v0.16b, v1.16b        \n"  // avg(h, v)
+      "bit        v0.16b, v4.16b, v6.16b         \n"  // color of the row
+      "bif        v21.16b, v4.16b, v6.16b        \n"  // G
+      "bit        v1.16b, v3.16b, v6.16b         \n"  // other color
+      "mov        v22.16b, v7.16b                \n"
+      "bsl        v22.16b, v1.16b, v0.16b        \n"  // R
+      "mov        v20.16b, v7.16b                \n"
+      "bsl        v20.16b, v0.16b, v1.16b        \n"  // B
+      "subs       %w4, %w4, #16                  \n"  // 16 pixels per loop
+      "st4        {v20.16b,v21.16b,v22.16b,v23.16b}, [%3], #64 \n"
+      "b.gt       1b                             \n"
+      : "+r"(src_bayer0),  // %0
+        "+r"(src_bayer1),  // %1
+        "+r"(src_bayer2),  // %2
+        "+r"(dst_argb),    // %3
+        "+r"(width)        // %4
+      : "r"(site),         // %5
+        "r"(blue)          // %6
+      : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v20",
+        "v21", "v22", "v23");
+}
+
 void NV12ToARGBRow_NEON(const uint8_t* src_y,
                         const uint8_t* src_uv,
                         uint8_t* dst_argb,
@@ -590,6 +642,128 @@ void UYVYToARGBRow_NEON(const uint8_t* src_uyvy,
   );
 }
 
+// Read 8 Y and 4 UV from P210.  Y keeps its upper 10 bits and UV its upper
+// 8 bits, as in the C version.
+#define READP210                                 \
+  "ld1        {v0.8h}, [%0], #16             \n" \
+  "ld1        {v2.8h}, [%1], #16             \n" \
+  "bic        v0.8h, #0x3f                   \n" \
+  "shrn       v2.8b, v2.8h, #8               \n" \
+  "uzp1       v1.8b, v2.8b, v2.8b            \n" \
+  "uzp2       v3.8b, v2.8b, v2.8b            \n" \
+  "ins        v1.s[1], v3.s[0]               \n"
+
+// Same as YUVTORGB but for 16 bit Y, which is multiplied by YG in v31, and
+// the results are left as 16 bit values scaled by 64 like YuvPixel16.
+#define P210TORGB16(vR, vG, vB)                                     \
+  "umull2     v3.4s, v0.8h, v31.8h           \n" /* Y * YG */       \
+  "umull      v0.4s, v0.4h, v31.4h           \n"                    \
+  "shrn       v0.4h, v0.4s, #16              \n"                    \
+  "shrn2      v0.8h, v3.4s, #16              \n" /* Y */            \
+  "shll       v2.8h, v1.8b, #8               \n" /* Replicate UV */ \
+  "uaddw      v1.8h, v2.8h, v1.8b            \n"                    \
+  "mov        v2.d[0], v1.d[1]               \n" /* Extract V */    \
+  "uxtl       v2.8h, v2.8b                   \n"                    \
+  "uxtl       v1.8h, v1.8b                   \n" /* Extract U */    \
+  "mul        v3.8h, v1.8h, v27.8h           \n"                    \
+  "mul        v5.8h, v1.8h, v29.8h           \n"                    \
+  "mul        v6.8h, v2.8h, v30.8h           \n"                    \
+  "mul        v7.8h, v2.8h, v28.8h           \n"                    \
+  "sqadd      v6.8h, v6.8h, v5.8h            \n"                    \
+  "sqadd      " #vB                                                 \
+  ".8h, v24.8h, v0.8h      \n" /* B */                              \
+  "sqadd      " #vG                                                 \
+  ".8h, v25.8h, v0.8h      \n" /* G */                              \
+  "sqadd      " #vR                                                 \
+  ".8h, v26.8h, v0.8h      \n" /* R */                              \
+  "sqadd      " #vB ".8h, " #vB                                     \
+  ".8h, v3.8h  \n" /* B */                                          \
+  "sqsub      " #vG ".8h, " #vG                                     \
+  ".8h, v6.8h  \n" /* G */                                          \
+  "sqadd      " #vR ".8h, " #vR ".8h, v7.8h  \n" /* R */
+
+void P210ToARGBRow_NEON(const uint16_t* src_y,
+                        const uint16_t* src_uv,
+                        uint8_t* dst_argb,
+                        const struct YuvConstants* yuvconstants,
+                        int width) {
+  const int yg = yuvconstants->kYToRgb[0] / 0x0101;
+  asm volatile (
+    YUVTORGB_SETUP
+    "dup        v31.8h, %w[kYG]                \n" /* YG for 16 bit Y */
+    "movi       v23.8b, #255                   \n" /* A */
+  "1:                                          \n"
+    READP210
+    P210TORGB16(v22, v21, v20)
+    "sqshrun    v20.8b, v20.8h, #6             \n" /* B */
+    "sqshrun    v21.8b, v21.8h, #6             \n" /* G */
+    "sqshrun    v22.8b, v22.8h, #6             \n" /* R */
+    "subs       %w3, %w3, #8                   \n"
+    "st4        {v20.8b,v21.8b,v22.8b,v23.8b}, [%2], #32     \n"
+    "b.gt       1b                             \n"
+    : "+r"(src_y),     // %0
+      "+r"(src_uv),    // %1
+      "+r"(dst_argb),  // %2
+      "+r"(width)      // %3
+    : [kUVToRB]"r"(&yuvconstants->kUVToRB),
+      [kUVToG]"r"(&yuvconstants->kUVToG),
+      [kUVBiasBGR]"r"(&yuvconstants->kUVBiasBGR),
+      [kYToRgb]"r"(&yuvconstants->kYToRgb),
+      [kYG]"r"(yg)
+    : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v20",
+      "v21", "v22", "v23", "v24", "v25", "v26", "v27", "v28", "v29", "v30",
+      "v31"
+  );
+}
+
+void P210ToAR30Row_NEON(const uint16_t* src_y,
+                        const uint16_t* src_uv,
+                        uint8_t* dst_ar30,
+                        const struct YuvConstants* yuvconstants,
+                        int width) {
+  const int yg = yuvconstants->kYToRgb[0] / 0x0101;
+  asm volatile (
+    YUVTORGB_SETUP
+    "dup        v31.8h, %w[kYG]                \n" /* YG for 16 bit Y */
+  "1:                                          \n"
+    READP210
+    P210TORGB16(v22, v21, v20)
+    // Saturating x << 2 to 0..65535 then >> 6 clamps x >> 4 to 10 bits.
+    "sqshlu     v20.8h, v20.8h, #2             \n" /* B */
+    "sqshlu     v21.8h, v21.8h, #2             \n" /* G */
+    "sqshlu     v22.8h, v22.8h, #2             \n" /* R */
+    "ushr       v20.8h, v20.8h, #6             \n"
+    "ushr       v21.8h, v21.8h, #6             \n"
+    "ushr       v22.8h, v22.8h, #6             \n"
+    "uxtl       v4.4s, v20.4h                  \n" /* B */
+    "uxtl2      v5.4s, v20.8h                  \n"
+    "uxtl       v6.4s, v21.4h                  \n" /* G */
+    "uxtl2      v7.4s, v21.8h                  \n"
+    "sli        v4.4s, v6.4s, #10              \n"
+    "sli        v5.4s, v7.4s, #10              \n"
+    "uxtl       v6.4s, v22.4h                  \n" /* R */
+    "uxtl2      v7.4s, v22.8h                  \n"
+    "sli        v4.4s, v6.4s, #20              \n"
+    "sli        v5.4s, v7.4s, #20              \n"
+    "orr        v4.4s, #0xc0, lsl #24          \n" /* A */
+    "orr        v5.4s, #0xc0, lsl #24          \n"
+    "subs       %w3, %w3, #8                   \n"
+    "st1        {v4.4s, v5.4s}, [%2], #32      \n"
+    "b.gt       1b                             \n"
+    : "+r"(src_y),     // %0
+      "+r"(src_uv),    // %1
+      "+r"(dst_ar30),  // %2
+      "+r"(width)      // %3
+    : [kUVToRB]"r"(&yuvconstants->kUVToRB),
+      [kUVToG]"r"(&yuvconstants->kUVToG),
+      [kUVBiasBGR]"r"(&yuvconstants->kUVBiasBGR),
+      [kYToRgb]"r"(&yuvconstants->kYToRgb),
+      [kYG]"r"(yg)
+    : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v20",
+      "v21", "v22", "v24", "v25", "v26", "v27", "v28", "v29", "v30", "v31"
+  );
+}
+
 // Reads 16 pairs of UV and write even values to dst_u and odd to dst_v.
 void SplitUVRow_NEON(const uint8_t* src_uv,
                      uint8_t* dst_u,
@@ -632,6 +806,73 @@ void MergeUVRow_NEON(const uint8_t* src_u,
   );
 }
 
+// Reads 8 pairs of 16 bit UV and writes U and V shifted down to depth bits.
+void SplitUVRow_16_NEON(const uint16_t* src_uv,
+                        uint16_t* dst_u,
+                        uint16_t* dst_v,
+                        int depth,
+                        int width) {
+  int shift = depth - 16;  // Negative shifts right.
+  asm volatile(
+      "dup        v2.8h, %w4                     \n"
+      "1:                                        \n"
+      "ld2        {v0.8h, v1.8h}, [%0], #32      \n"  // load 8 pairs of UV
+      "subs       %w3, %w3, #8                   \n"  // 8 processed per loop
+      "ushl       v0.8h, v0.8h, v2.8h            \n"
+      "ushl       v1.8h, v1.8h, v2.8h            \n"
+      "st1        {v0.8h}, [%1], #16             \n"  // store U
+      "st1        {v1.8h}, [%2], #16             \n"  // store V
+      "b.gt       1b                             \n"
+      : "+r"(src_uv),  // %0
+        "+r"(dst_u),   // %1
+        "+r"(dst_v),   // %2
+        "+r"(width)    // %3
+      : "r"(shift)     // %4
+      : "cc", "memory", "v0", "v1", "v2");
+}
+
+// Use scale to convert msb formats to lsb.  scale is 1 << depth.
+void DivideRow_16_NEON(const uint16_t* src_y,
+                       uint16_t* dst_y,
+                       int scale,
+                       int width) {
+  asm volatile(
+      "dup        v4.8h, %w3                     \n"
+      "1:                                        \n"
+      "ld1        {v0.8h, v1.8h}, [%0], #32      \n"  // load 16 shorts
+      "subs       %w2, %w2, #16                  \n"  // 16 processed per loop
+      "umull      v2.4s, v0.4h, v4.4h            \n"
+      "umull2     v3.4s, v0.8h, v4.8h            \n"
+      "umull      v5.4s, v1.4h, v4.4h            \n"
+      "umull2     v6.4s, v1.8h, v4.8h            \n"
+      "uzp2       v0.8h, v2.8h, v3.8h            \n"  // upper 16 bits
+      "uzp2       v1.8h, v5.8h, v6.8h            \n"
+      "st1        {v0.8h, v1.8h}, [%1], #32      \n"  // store 16 shorts
+      "b.gt       1b                             \n"
+      : "+r"(src_y),  // %0
+        "+r"(dst_y),  // %1
+        "+r"(width)   // %2
+      : "r"(scale)    // %3
+      : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6");
+}
+
+// Round msb formats to 8 bits.
+void Round16To8Row_NEON(const uint16_t* src_y, uint8_t* dst_y, int width) {
+  asm volatile(
+      "1:                                        \n"
+      "ld1        {v0.8h, v1.8h}, [%0], #32      \n"  // load 16 shorts
+      "subs       %w2, %w2, #16                  \n"  // 16 processed per loop
+      "uqrshrn    v0.8b, v0.8h, #8               \n"  // round and saturate
+      "uqrshrn2   v0.16b, v1.8h, #8              \n"
+      "st1        {v0.16b}, [%1], #16            \n"  // store 16 bytes
+      "b.gt       1b                             \n"
+      : "+r"(src_y),  // %0
+        "+r"(dst_y),  // %1
+        "+r"(width)   // %2
+      :
+      : "cc", "memory", "v0", "v1");
+}
+
 // Reads 16 packed RGB and write to planar dst_r, dst_g, dst_b.
 void SplitRGBRow_NEON(const uint8_t* src_rgb,
                       uint8_t* dst_r,
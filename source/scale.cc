@@ -13,10 +13,12 @@
 #include <assert.h>
 #include <string.h>
 
+#include "executor_internal.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyPlane
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
+#include "stats_internal.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -103,6 +105,22 @@ static void ScalePlaneDown2(int src_width,
     }
   }
 #endif
+#if defined(HAS_SCALEROWDOWN2_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ScaleRowDown2 =
+        filtering == kFilterNone
+            ? ScaleRowDown2_Any_AVX512BW
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_AVX512BW
+                                          : ScaleRowDown2Box_Any_AVX512BW);
+    if (IS_ALIGNED(dst_width, 64)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_AVX512BW
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_AVX512BW
+                                            : ScaleRowDown2Box_AVX512BW);
+    }
+  }
+#endif
 #if defined(HAS_SCALEROWDOWN2_MSA)
   if (TestCpuFlag(kCpuHasMSA)) {
     ScaleRowDown2 =
@@ -138,11 +156,15 @@ static void ScalePlaneDown2(int src_width,
     src_stride = 0;
   }
   // TODO(fbarchard): Loop through source height to allow odd height.
+  LIBYUV_STATS_ROW_DECLARE(stats_row);
   for (y = 0; y < dst_height; ++y) {
-    ScaleRowDown2(src_ptr, src_stride, dst_ptr, dst_width);
+    LIBYUV_STATS_ROW(stats_row,
+                     ScaleRowDown2(src_ptr, src_stride, dst_ptr, dst_width));
     src_ptr += row_stride;
     dst_ptr += dst_stride;
   }
+  LIBYUV_STATS_ROW_RECORD(stats_row, kStatsScaleRowDown2, ScaleRowDown2,
+                          dst_width);
 }
 
 static void ScalePlaneDown2_16(int src_width,
@@ -176,12 +198,51 @@ static void ScalePlaneDown2_16(int src_width,
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 16)) {
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleRowDown2 =
+        filtering == kFilterNone
+            ? ScaleRowDown2_Any_16_SSE2
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_16_SSE2
+                                          : ScaleRowDown2Box_Any_16_SSE2);
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_16_SSE2
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2
+                                            : ScaleRowDown2Box_16_SSE2);
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleRowDown2 =
+        filtering == kFilterNone
+            ? ScaleRowDown2_Any_16_AVX2
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_16_AVX2
+                                          : ScaleRowDown2Box_Any_16_AVX2);
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_16_AVX2
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_AVX2
+                                            : ScaleRowDown2Box_16_AVX2);
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
     ScaleRowDown2 =
         filtering == kFilterNone
-            ? ScaleRowDown2_16_SSE2
-            : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2
-                                          : ScaleRowDown2Box_16_SSE2);
+            ? ScaleRowDown2_Any_16_AVX512BW
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_16_AVX512BW
+                                          : ScaleRowDown2Box_Any_16_AVX512BW);
+    if (IS_ALIGNED(dst_width, 32)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_16_AVX512BW
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_AVX512BW
+                                            : ScaleRowDown2Box_16_AVX512BW);
+    }
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_MMI)
@@ -277,11 +338,15 @@ static void ScalePlaneDown4(int src_width,
   if (filtering == kFilterLinear) {
     src_stride = 0;
   }
+  LIBYUV_STATS_ROW_DECLARE(stats_row);
   for (y = 0; y < dst_height; ++y) {
-    ScaleRowDown4(src_ptr, src_stride, dst_ptr, dst_width);
+    LIBYUV_STATS_ROW(stats_row,
+                     ScaleRowDown4(src_ptr, src_stride, dst_ptr, dst_width));
     src_ptr += row_stride;
     dst_ptr += dst_stride;
   }
+  LIBYUV_STATS_ROW_RECORD(stats_row, kStatsScaleRowDown4, ScaleRowDown4,
+                          dst_width);
 }
 
 static void ScalePlaneDown4_16(int src_width,
@@ -311,9 +376,33 @@ static void ScalePlaneDown4_16(int src_width,
   }
 #endif
 #if defined(HAS_SCALEROWDOWN4_16_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+  if (TestCpuFlag(kCpuHasSSE2)) {
     ScaleRowDown4 =
-        filtering ? ScaleRowDown4Box_16_SSE2 : ScaleRowDown4_16_SSE2;
+        filtering ? ScaleRowDown4Box_Any_16_SSE2 : ScaleRowDown4_Any_16_SSE2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleRowDown4 =
+          filtering ? ScaleRowDown4Box_16_SSE2 : ScaleRowDown4_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN4_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleRowDown4 =
+        filtering ? ScaleRowDown4Box_Any_16_AVX2 : ScaleRowDown4_Any_16_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleRowDown4 =
+          filtering ? ScaleRowDown4Box_16_AVX2 : ScaleRowDown4_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN4_16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ScaleRowDown4 = filtering ? ScaleRowDown4Box_Any_16_AVX512BW
+                              : ScaleRowDown4_Any_16_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleRowDown4 =
+          filtering ? ScaleRowDown4Box_16_AVX512BW : ScaleRowDown4_16_AVX512BW;
+    }
   }
 #endif
 #if defined(HAS_SCALEROWDOWN4_16_MMI)
@@ -479,13 +568,22 @@ static void ScalePlaneDown34_16(int src_width,
   }
 #endif
 #if defined(HAS_SCALEROWDOWN34_16_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && (dst_width % 24 == 0)) {
+  if (TestCpuFlag(kCpuHasSSSE3)) {
     if (!filtering) {
-      ScaleRowDown34_0 = ScaleRowDown34_16_SSSE3;
-      ScaleRowDown34_1 = ScaleRowDown34_16_SSSE3;
+      ScaleRowDown34_0 = ScaleRowDown34_Any_16_SSSE3;
+      ScaleRowDown34_1 = ScaleRowDown34_Any_16_SSSE3;
     } else {
-      ScaleRowDown34_0 = ScaleRowDown34_0_Box_16_SSSE3;
-      ScaleRowDown34_1 = ScaleRowDown34_1_Box_16_SSSE3;
+      ScaleRowDown34_0 = ScaleRowDown34_0_Box_Any_16_SSSE3;
+      ScaleRowDown34_1 = ScaleRowDown34_1_Box_Any_16_SSSE3;
+    }
+    if (dst_width % 12 == 0) {
+      if (!filtering) {
+        ScaleRowDown34_0 = ScaleRowDown34_16_SSSE3;
+        ScaleRowDown34_1 = ScaleRowDown34_16_SSSE3;
+      } else {
+        ScaleRowDown34_0 = ScaleRowDown34_0_Box_16_SSSE3;
+        ScaleRowDown34_1 = ScaleRowDown34_1_Box_16_SSSE3;
+      }
     }
   }
 #endif
@@ -674,13 +772,22 @@ static void ScalePlaneDown38_16(int src_width,
   }
 #endif
 #if defined(HAS_SCALEROWDOWN38_16_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && (dst_width % 24 == 0)) {
+  if (TestCpuFlag(kCpuHasSSSE3)) {
     if (!filtering) {
-      ScaleRowDown38_3 = ScaleRowDown38_16_SSSE3;
-      ScaleRowDown38_2 = ScaleRowDown38_16_SSSE3;
+      ScaleRowDown38_3 = ScaleRowDown38_Any_16_SSSE3;
+      ScaleRowDown38_2 = ScaleRowDown38_Any_16_SSSE3;
     } else {
-      ScaleRowDown38_3 = ScaleRowDown38_3_Box_16_SSSE3;
-      ScaleRowDown38_2 = ScaleRowDown38_2_Box_16_SSSE3;
+      ScaleRowDown38_3 = ScaleRowDown38_3_Box_Any_16_SSSE3;
+      ScaleRowDown38_2 = ScaleRowDown38_2_Box_Any_16_SSSE3;
+    }
+    if (dst_width % 6 == 0) {
+      if (!filtering) {
+        ScaleRowDown38_3 = ScaleRowDown38_16_SSSE3;
+        ScaleRowDown38_2 = ScaleRowDown38_16_SSSE3;
+      } else {
+        ScaleRowDown38_3 = ScaleRowDown38_3_Box_16_SSSE3;
+        ScaleRowDown38_2 = ScaleRowDown38_2_Box_16_SSSE3;
+      }
     }
   }
 #endif
@@ -814,12 +921,32 @@ static void ScaleAddCols1_16_C(int dst_width,
   int boxwidth = MIN1(dx >> 16);
   int scaleval = 65536 / (boxwidth * boxheight);
   int i;
+  x >>= 16;
   for (i = 0; i < dst_width; ++i) {
     *dst_ptr++ = SumPixels_16(boxwidth, src_ptr + x) * scaleval >> 16;
     x += boxwidth;
   }
 }
 
+// Reverse a row in place, for box scaling with a negative step (mirror).
+static void ReverseRow(uint8_t* row, int width) {
+  int i;
+  for (i = 0; i < width / 2; ++i) {
+    uint8_t t = row[i];
+    row[i] = row[width - 1 - i];
+    row[width - 1 - i] = t;
+  }
+}
+
+static void ReverseRow_16(uint16_t* row, int width) {
+  int i;
+  for (i = 0; i < width / 2; ++i) {
+    uint16_t t = row[i];
+    row[i] = row[width - 1 - i];
+    row[width - 1 - i] = t;
+  }
+}
+
 // Scale plane down to any dimensions, with interpolation.
 // (boxfilter).
 //
@@ -834,17 +961,20 @@ static void ScalePlaneBox(int src_width,
                           int src_stride,
                           int dst_stride,
                           const uint8_t* src_ptr,
-                          uint8_t* dst_ptr) {
+                          uint8_t* dst_ptr,
+                          int x,
+                          int dx,
+                          int y,
+                          int dy) {
   int j, k;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   const int max_y = (src_height << 16);
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
+  // A negative dx mirrors. Step the same boxes left to right and reverse
+  // each destination row.
+  const int mirror = dx < 0;
+  if (mirror) {
+    x = (int)(x + (int64_t)(dst_width - 1) * dx);
+    dx = -dx;
+  }
   {
     // Allocate a row buffer of uint16_t.
     align_buffer_64(row16, src_width * 2);
@@ -895,6 +1025,7 @@ static void ScalePlaneBox(int src_width,
     }
 #endif
 
+    LIBYUV_STATS_ROW_DECLARE(stats_add);
     for (j = 0; j < dst_height; ++j) {
       int boxheight;
       int iy = y >> 16;
@@ -906,12 +1037,18 @@ static void ScalePlaneBox(int src_width,
       boxheight = MIN1((y >> 16) - iy);
       memset(row16, 0, src_width * 2);
       for (k = 0; k < boxheight; ++k) {
-        ScaleAddRow(src, (uint16_t*)(row16), src_width);
+        LIBYUV_STATS_ROW(stats_add,
+                         ScaleAddRow(src, (uint16_t*)(row16), src_width));
         src += src_stride;
       }
       ScaleAddCols(dst_width, boxheight, x, dx, (uint16_t*)(row16), dst_ptr);
+      if (mirror) {
+        ReverseRow(dst_ptr, dst_width);
+      }
       dst_ptr += dst_stride;
     }
+    LIBYUV_STATS_ROW_RECORD(stats_add, kStatsScaleAddRow, ScaleAddRow,
+                            src_width);
     free_aligned_buffer_64(row16);
   }
 }
@@ -923,17 +1060,18 @@ static void ScalePlaneBox_16(int src_width,
                              int src_stride,
                              int dst_stride,
                              const uint16_t* src_ptr,
-                             uint16_t* dst_ptr) {
+                             uint16_t* dst_ptr,
+                             int x,
+                             int dx,
+                             int y,
+                             int dy) {
   int j, k;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   const int max_y = (src_height << 16);
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
+  const int mirror = dx < 0;
+  if (mirror) {
+    x = (int)(x + (int64_t)(dst_width - 1) * dx);
+    dx = -dx;
+  }
   {
     // Allocate a row buffer of uint32_t.
     align_buffer_64(row32, src_width * 4);
@@ -944,8 +1082,27 @@ static void ScalePlaneBox_16(int src_width,
                         int src_width) = ScaleAddRow_16_C;
 
 #if defined(HAS_SCALEADDROW_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(src_width, 16)) {
-      ScaleAddRow = ScaleAddRow_16_SSE2;
+    if (TestCpuFlag(kCpuHasSSE2)) {
+      ScaleAddRow = ScaleAddRow_Any_16_SSE2;
+      if (IS_ALIGNED(src_width, 8)) {
+        ScaleAddRow = ScaleAddRow_16_SSE2;
+      }
+    }
+#endif
+#if defined(HAS_SCALEADDROW_16_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      ScaleAddRow = ScaleAddRow_Any_16_AVX2;
+      if (IS_ALIGNED(src_width, 16)) {
+        ScaleAddRow = ScaleAddRow_16_AVX2;
+      }
+    }
+#endif
+#if defined(HAS_SCALEADDROW_16_AVX512BW)
+    if (TestCpuFlag(kCpuHasAVX512BW)) {
+      ScaleAddRow = ScaleAddRow_Any_16_AVX512BW;
+      if (IS_ALIGNED(src_width, 32)) {
+        ScaleAddRow = ScaleAddRow_16_AVX512BW;
+      }
     }
 #endif
 
@@ -969,6 +1126,9 @@ static void ScalePlaneBox_16(int src_width,
         src += src_stride;
       }
       ScaleAddCols(dst_width, boxheight, x, dx, (uint32_t*)(row32), dst_ptr);
+      if (mirror) {
+        ReverseRow_16(dst_ptr, dst_width);
+      }
       dst_ptr += dst_stride;
     }
     free_aligned_buffer_64(row32);
@@ -984,12 +1144,11 @@ void ScalePlaneBilinearDown(int src_width,
                             int dst_stride,
                             const uint8_t* src_ptr,
                             uint8_t* dst_ptr,
+                            int x,
+                            int dx,
+                            int y,
+                            int dy,
                             enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row buffer.
   align_buffer_64(row, src_width);
@@ -1002,9 +1161,6 @@ void ScalePlaneBilinearDown(int src_width,
   void (*InterpolateRow)(uint8_t * dst_ptr, const uint8_t* src_ptr,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
 
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
@@ -1072,15 +1228,20 @@ void ScalePlaneBilinearDown(int src_width,
     y = max_y;
   }
 
+  LIBYUV_STATS_ROW_DECLARE(stats_interpolate);
+  LIBYUV_STATS_ROW_DECLARE(stats_cols);
   for (j = 0; j < dst_height; ++j) {
     int yi = y >> 16;
     const uint8_t* src = src_ptr + yi * src_stride;
     if (filtering == kFilterLinear) {
-      ScaleFilterCols(dst_ptr, src, dst_width, x, dx);
+      LIBYUV_STATS_ROW(stats_cols,
+                       ScaleFilterCols(dst_ptr, src, dst_width, x, dx));
     } else {
       int yf = (y >> 8) & 255;
-      InterpolateRow(row, src, src_stride, src_width, yf);
-      ScaleFilterCols(dst_ptr, row, dst_width, x, dx);
+      LIBYUV_STATS_ROW(stats_interpolate,
+                       InterpolateRow(row, src, src_stride, src_width, yf));
+      LIBYUV_STATS_ROW(stats_cols,
+                       ScaleFilterCols(dst_ptr, row, dst_width, x, dx));
     }
     dst_ptr += dst_stride;
     y += dy;
@@ -1088,6 +1249,10 @@ void ScalePlaneBilinearDown(int src_width,
       y = max_y;
     }
   }
+  LIBYUV_STATS_ROW_RECORD(stats_interpolate, kStatsInterpolateRow,
+                          InterpolateRow, src_width);
+  LIBYUV_STATS_ROW_RECORD(stats_cols, kStatsScaleFilterCols, ScaleFilterCols,
+                          dst_width);
   free_aligned_buffer_64(row);
 }
 
@@ -1099,12 +1264,11 @@ void ScalePlaneBilinearDown_16(int src_width,
                                int dst_stride,
                                const uint16_t* src_ptr,
                                uint16_t* dst_ptr,
+                               int x,
+                               int dx,
+                               int y,
+                               int dy,
                                enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row buffer.
   align_buffer_64(row, src_width * 2);
@@ -1117,14 +1281,11 @@ void ScalePlaneBilinearDown_16(int src_width,
   void (*InterpolateRow)(uint16_t * dst_ptr, const uint16_t* src_ptr,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_16_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
 
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(src_width, 16)) {
+    if (IS_ALIGNED(src_width, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
@@ -1140,11 +1301,19 @@ void ScalePlaneBilinearDown_16(int src_width,
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(src_width, 32)) {
+    if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    InterpolateRow = InterpolateRow_Any_16_AVX512BW;
+    if (IS_ALIGNED(src_width, 32)) {
+      InterpolateRow = InterpolateRow_16_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     InterpolateRow = InterpolateRow_Any_16_NEON;
@@ -1158,6 +1327,14 @@ void ScalePlaneBilinearDown_16(int src_width,
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
     ScaleFilterCols = ScaleFilterCols_16_SSSE3;
   }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleFilterCols = ScaleFilterCols_Any_16_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleFilterCols = ScaleFilterCols_16_AVX2;
+    }
+  }
 #endif
   if (y > max_y) {
     y = max_y;
@@ -1191,13 +1368,12 @@ void ScalePlaneBilinearUp(int src_width,
                           int dst_stride,
                           const uint8_t* src_ptr,
                           uint8_t* dst_ptr,
+                          int x,
+                          int dx,
+                          int y,
+                          int dy,
                           enum FilterMode filtering) {
   int j;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   const int max_y = (src_height - 1) << 16;
   void (*InterpolateRow)(uint8_t * dst_ptr, const uint8_t* src_ptr,
                          ptrdiff_t src_stride, int dst_width,
@@ -1205,9 +1381,6 @@ void ScalePlaneBilinearUp(int src_width,
   void (*ScaleFilterCols)(uint8_t * dst_ptr, const uint8_t* src_ptr,
                           int dst_width, int x, int dx) =
       filtering ? ScaleFilterCols_C : ScaleCols_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
 
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
@@ -1286,12 +1459,17 @@ void ScalePlaneBilinearUp(int src_width,
     uint8_t* rowptr = row;
     int rowstride = kRowSize;
     int lasty = yi;
+    LIBYUV_STATS_ROW_DECLARE(stats_interpolate);
+    LIBYUV_STATS_ROW_DECLARE(stats_cols);
 
-    ScaleFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
+    LIBYUV_STATS_ROW(stats_cols,
+                     ScaleFilterCols(rowptr, src, dst_width, x, dx));
+    // A band may start on the last source row; do not read past it.
+    if (yi < src_height - 1) {
       src += src_stride;
     }
-    ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
+    LIBYUV_STATS_ROW(stats_cols, ScaleFilterCols(rowptr + rowstride, src,
+                                                 dst_width, x, dx));
     src += src_stride;
 
     for (j = 0; j < dst_height; ++j) {
@@ -1303,7 +1481,8 @@ void ScalePlaneBilinearUp(int src_width,
           src = src_ptr + yi * src_stride;
         }
         if (yi != lasty) {
-          ScaleFilterCols(rowptr, src, dst_width, x, dx);
+          LIBYUV_STATS_ROW(stats_cols,
+                           ScaleFilterCols(rowptr, src, dst_width, x, dx));
           rowptr += rowstride;
           rowstride = -rowstride;
           lasty = yi;
@@ -1311,14 +1490,21 @@ void ScalePlaneBilinearUp(int src_width,
         }
       }
       if (filtering == kFilterLinear) {
-        InterpolateRow(dst_ptr, rowptr, 0, dst_width, 0);
+        LIBYUV_STATS_ROW(stats_interpolate,
+                         InterpolateRow(dst_ptr, rowptr, 0, dst_width, 0));
       } else {
         int yf = (y >> 8) & 255;
-        InterpolateRow(dst_ptr, rowptr, rowstride, dst_width, yf);
+        LIBYUV_STATS_ROW(stats_interpolate, InterpolateRow(dst_ptr, rowptr,
+                                                           rowstride,
+                                                           dst_width, yf));
       }
       dst_ptr += dst_stride;
       y += dy;
     }
+    LIBYUV_STATS_ROW_RECORD(stats_interpolate, kStatsInterpolateRow,
+                            InterpolateRow, dst_width);
+    LIBYUV_STATS_ROW_RECORD(stats_cols, kStatsScaleFilterCols,
+                            ScaleFilterCols, dst_width);
     free_aligned_buffer_64(row);
   }
 }
@@ -1331,13 +1517,12 @@ void ScalePlaneBilinearUp_16(int src_width,
                              int dst_stride,
                              const uint16_t* src_ptr,
                              uint16_t* dst_ptr,
+                             int x,
+                             int dx,
+                             int y,
+                             int dy,
                              enum FilterMode filtering) {
   int j;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   const int max_y = (src_height - 1) << 16;
   void (*InterpolateRow)(uint16_t * dst_ptr, const uint16_t* src_ptr,
                          ptrdiff_t src_stride, int dst_width,
@@ -1345,14 +1530,11 @@ void ScalePlaneBilinearUp_16(int src_width,
   void (*ScaleFilterCols)(uint16_t * dst_ptr, const uint16_t* src_ptr,
                           int dst_width, int x, int dx) =
       filtering ? ScaleFilterCols_16_C : ScaleCols_16_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
 
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(dst_width, 16)) {
+    if (IS_ALIGNED(dst_width, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
@@ -1368,11 +1550,19 @@ void ScalePlaneBilinearUp_16(int src_width,
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(dst_width, 32)) {
+    if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    InterpolateRow = InterpolateRow_Any_16_AVX512BW;
+    if (IS_ALIGNED(dst_width, 32)) {
+      InterpolateRow = InterpolateRow_16_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     InterpolateRow = InterpolateRow_Any_16_NEON;
@@ -1389,11 +1579,19 @@ void ScalePlaneBilinearUp_16(int src_width,
   if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
     ScaleFilterCols = ScaleFilterCols_16_SSSE3;
   }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_16_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleFilterCols = ScaleFilterCols_Any_16_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleFilterCols = ScaleFilterCols_16_AVX2;
+    }
+  }
 #endif
   if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
     ScaleFilterCols = ScaleColsUp2_16_C;
 #if defined(HAS_SCALECOLS_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 16)) {
       ScaleFilterCols = ScaleColsUp2_16_SSE2;
     }
 #endif
@@ -1420,7 +1618,8 @@ void ScalePlaneBilinearUp_16(int src_width,
     int lasty = yi;
 
     ScaleFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
+    // A band may start on the last source row; do not read past it.
+    if (yi < src_height - 1) {
       src += src_stride;
     }
     ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
@@ -1467,18 +1666,15 @@ static void ScalePlaneSimple(int src_width,
                              int src_stride,
                              int dst_stride,
                              const uint8_t* src_ptr,
-                             uint8_t* dst_ptr) {
+                             uint8_t* dst_ptr,
+                             int x,
+                             int dx,
+                             int y,
+                             int dy) {
   int i;
   void (*ScaleCols)(uint8_t * dst_ptr, const uint8_t* src_ptr, int dst_width,
                     int x, int dx) = ScaleCols_C;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterNone, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
+  (void)src_height;
 
   if (src_width * 2 == dst_width && x < 0x8000) {
     ScaleCols = ScaleColsUp2_C;
@@ -1494,11 +1690,15 @@ static void ScalePlaneSimple(int src_width,
 #endif
   }
 
+  LIBYUV_STATS_ROW_DECLARE(stats_row);
   for (i = 0; i < dst_height; ++i) {
-    ScaleCols(dst_ptr, src_ptr + (y >> 16) * src_stride, dst_width, x, dx);
+    LIBYUV_STATS_ROW(stats_row, ScaleCols(dst_ptr,
+                                          src_ptr + (y >> 16) * src_stride,
+                                          dst_width, x, dx));
     dst_ptr += dst_stride;
     y += dy;
   }
+  LIBYUV_STATS_ROW_RECORD(stats_row, kStatsScaleCols, ScaleCols, dst_width);
 }
 
 static void ScalePlaneSimple_16(int src_width,
@@ -1508,23 +1708,25 @@ static void ScalePlaneSimple_16(int src_width,
                                 int src_stride,
                                 int dst_stride,
                                 const uint16_t* src_ptr,
-                                uint16_t* dst_ptr) {
+                                uint16_t* dst_ptr,
+                                int x,
+                                int dx,
+                                int y,
+                                int dy) {
   int i;
   void (*ScaleCols)(uint16_t * dst_ptr, const uint16_t* src_ptr, int dst_width,
                     int x, int dx) = ScaleCols_16_C;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterNone, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
+  (void)src_height;
 
+#if defined(HAS_SCALECOLS_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
+    ScaleCols = ScaleCols_16_SSE2;
+  }
+#endif
   if (src_width * 2 == dst_width && x < 0x8000) {
     ScaleCols = ScaleColsUp2_16_C;
 #if defined(HAS_SCALECOLS_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
+    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 16)) {
       ScaleCols = ScaleColsUp2_16_SSE2;
     }
 #endif
@@ -1542,105 +1744,171 @@ static void ScalePlaneSimple_16(int src_width,
   }
 }
 
-// Scale a plane.
-// This function dispatches to a specialized scaler based on scale factor.
+// Scale columns [clip_x, clip_x + clip_width) of rows [band_y, band_y +
+// band_height) with a polyphase filter.
+static void ScalePlanePolyphase_16(int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   int clip_x,
+                                   int clip_width,
+                                   int band_y,
+                                   int band_height,
+                                   int src_stride,
+                                   int dst_stride,
+                                   const uint16_t* src_ptr,
+                                   uint16_t* dst_ptr,
+                                   enum FilterMode filtering) {
+  const int taps_x = ScalePolyphaseTaps(src_width, dst_width, filtering);
+  const int taps_y = ScalePolyphaseTaps(src_height, dst_height, filtering);
+  int j;
+  align_buffer_64(row, Abs(src_width) * 2);
+  align_buffer_64(offsets_x, clip_width * sizeof(int));
+  align_buffer_64(filter_x, clip_width * taps_x * sizeof(int16_t));
+  align_buffer_64(offsets_y, band_height * sizeof(int));
+  align_buffer_64(filter_y, band_height * taps_y * sizeof(int16_t));
+  ScalePolyphaseCoeffs(src_width, dst_width, clip_x, clip_width, filtering,
+                       taps_x, taps_x, (int*)(offsets_x),
+                       (int16_t*)(filter_x));
+  ScalePolyphaseCoeffs(src_height, dst_height, band_y, band_height, filtering,
+                       taps_y, taps_y, (int*)(offsets_y), (int16_t*)(filter_y));
+  src_width = Abs(src_width);
 
-LIBYUV_API
-void ScalePlane(const uint8_t* src,
-                int src_stride,
-                int src_width,
-                int src_height,
-                uint8_t* dst,
-                int dst_stride,
-                int dst_width,
-                int dst_height,
-                enum FilterMode filtering) {
+  for (j = 0; j < band_height; ++j) {
+    ScalePolyphaseRows_16_C(
+        src_ptr + ((const int*)(offsets_y))[j] * (intptr_t)(src_stride),
+        src_stride, (const int16_t*)(filter_y) + j * taps_y, taps_y,
+        (uint16_t*)(row), src_width);
+    ScalePolyphaseCols_16_C(dst_ptr, (const uint16_t*)(row), clip_width,
+                            (const int*)(offsets_x),
+                            (const int16_t*)(filter_x), taps_x);
+    dst_ptr += dst_stride;
+  }
+  free_aligned_buffer_64(filter_y);
+  free_aligned_buffer_64(offsets_y);
+  free_aligned_buffer_64(filter_x);
+  free_aligned_buffer_64(offsets_x);
+  free_aligned_buffer_64(row);
+}
+
+// Scalers of ScalePlaneSetup.
+enum {
+  kScalePlaneCopy,
+  kScalePlanePolyphase,
+  kScalePlaneVertical,
+  kScalePlaneDown34,
+  kScalePlaneDown2,
+  kScalePlaneDown38,
+  kScalePlaneDown4,
+  kScalePlaneBox,
+  kScalePlaneBilinearUp,
+  kScalePlaneBilinearDown,
+  kScalePlaneSimple
+};
+
+void ScalePlaneSetupInit(ScalePlaneSetup* setup,
+                         int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering) {
+  // Polyphase filters have their own scaler for all scale factors.
+  const enum FilterMode polyphase =
+      (filtering == kFilterBicubic || filtering == kFilterLanczos) ? filtering
+                                                                  : kFilterNone;
+  const int abs_src_height = Abs(src_height);
+  memset(setup, 0, sizeof(*setup));
+  setup->src_width = src_width;
+  setup->src_height = src_height;
+  setup->dst_width = dst_width;
+  setup->dst_height = dst_height;
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
-
-  // Negative height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * src_stride;
-    src_stride = -src_stride;
-  }
+  setup->filtering = filtering;
+  setup->row_align = 1;
+  src_height = abs_src_height;
 
   // Use specialized scales to improve performance for common resolutions.
   // For example, all the 1/2 scalings will use ScalePlaneDown2()
   if (dst_width == src_width && dst_height == src_height) {
     // Straight copy.
-    CopyPlane(src, src_stride, dst, dst_stride, dst_width, dst_height);
+    setup->scaler = kScalePlaneCopy;
+    return;
+  }
+  if (polyphase) {
+    setup->filtering = polyphase;
+    setup->scaler = kScalePlanePolyphase;
     return;
   }
   if (dst_width == src_width && filtering != kFilterBox) {
-    int dy = FixedDiv(src_height, dst_height);
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, 0, 0, dy, 1, filtering);
+    setup->dy = FixedDiv(src_height, dst_height);
+    setup->scaler = kScalePlaneVertical;
     return;
   }
   if (dst_width <= Abs(src_width) && dst_height <= src_height) {
     // Scale down.
     if (4 * dst_width == 3 * src_width && 4 * dst_height == 3 * src_height) {
       // optimized, 3/4
-      ScalePlaneDown34(src_width, src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, filtering);
+      setup->scaler = kScalePlaneDown34;
+      setup->row_align = 3;
       return;
     }
     if (2 * dst_width == src_width && 2 * dst_height == src_height) {
       // optimized, 1/2
-      ScalePlaneDown2(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst, filtering);
+      setup->scaler = kScalePlaneDown2;
       return;
     }
     // 3/8 rounded up for odd sized chroma height.
     if (8 * dst_width == 3 * src_width && 8 * dst_height == 3 * src_height) {
       // optimized, 3/8
-      ScalePlaneDown38(src_width, src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, filtering);
+      setup->scaler = kScalePlaneDown38;
+      setup->row_align = 3;
       return;
     }
     if (4 * dst_width == src_width && 4 * dst_height == src_height &&
         (filtering == kFilterBox || filtering == kFilterNone)) {
       // optimized, 1/4
-      ScalePlaneDown4(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst, filtering);
+      setup->scaler = kScalePlaneDown4;
       return;
     }
   }
+
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering,
+             &setup->x, &setup->y, &setup->dx, &setup->dy);
   if (filtering == kFilterBox && dst_height * 2 < src_height) {
-    ScalePlaneBox(src_width, src_height, dst_width, dst_height, src_stride,
-                  dst_stride, src, dst);
-    return;
-  }
-  if (filtering && dst_height > src_height) {
-    ScalePlaneBilinearUp(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst, filtering);
-    return;
-  }
-  if (filtering) {
-    ScalePlaneBilinearDown(src_width, src_height, dst_width, dst_height,
-                           src_stride, dst_stride, src, dst, filtering);
-    return;
+    setup->scaler = kScalePlaneBox;
+  } else if (filtering && dst_height > src_height) {
+    setup->scaler = kScalePlaneBilinearUp;
+  } else if (filtering) {
+    setup->scaler = kScalePlaneBilinearDown;
+  } else {
+    setup->scaler = kScalePlaneSimple;
   }
-  ScalePlaneSimple(src_width, src_height, dst_width, dst_height, src_stride,
-                   dst_stride, src, dst);
 }
 
-LIBYUV_API
-void ScalePlane_16(const uint16_t* src,
-                   int src_stride,
-                   int src_width,
-                   int src_height,
-                   uint16_t* dst,
-                   int dst_stride,
-                   int dst_width,
-                   int dst_height,
-                   enum FilterMode filtering) {
-  // Simplify filtering when possible.
-  filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
-                                filtering);
+LIBYUV_BOOL ScalePlaneSetupPolyphase(const ScalePlaneSetup* setup) {
+  return setup->scaler == kScalePlanePolyphase;
+}
+
+// The 3/4 and 3/8 scalers produce rows and columns in groups of 3, so for
+// those band_y, clip_x and clip_width must be multiples of 3.
+void ScalePlaneSetupRunClip(const ScalePlaneSetup* setup,
+                            const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int clip_x,
+                            int clip_width,
+                            int band_y,
+                            int band_height) {
+  const int src_width = setup->src_width;
+  const enum FilterMode filtering = setup->filtering;
+  int src_height = setup->src_height;
+  int x;
+  int y;
 
   // Negative height means invert the image.
   if (src_height < 0) {
@@ -1649,66 +1917,397 @@ void ScalePlane_16(const uint16_t* src,
     src_stride = -src_stride;
   }
 
-  // Use specialized scales to improve performance for common resolutions.
-  // For example, all the 1/2 scalings will use ScalePlaneDown2()
-  if (dst_width == src_width && dst_height == src_height) {
-    // Straight copy.
-    CopyPlane_16(src, src_stride, dst, dst_stride, dst_width, dst_height);
-    return;
-  }
-  if (dst_width == src_width && filtering != kFilterBox) {
-    int dy = FixedDiv(src_height, dst_height);
-    // Arbitrary scale vertically, but unscaled vertically.
-    ScalePlaneVertical_16(src_height, dst_width, dst_height, src_stride,
-                          dst_stride, src, dst, 0, 0, dy, 1, filtering);
-    return;
-  }
-  if (dst_width <= Abs(src_width) && dst_height <= src_height) {
-    // Scale down.
-    if (4 * dst_width == 3 * src_width && 4 * dst_height == 3 * src_height) {
-      // optimized, 3/4
-      ScalePlaneDown34_16(src_width, src_height, dst_width, dst_height,
-                          src_stride, dst_stride, src, dst, filtering);
+  switch (setup->scaler) {
+    case kScalePlaneCopy:
+      CopyPlane(src + band_y * (intptr_t)src_stride + clip_x, src_stride, dst,
+                dst_stride, clip_width, band_height);
       return;
-    }
-    if (2 * dst_width == src_width && 2 * dst_height == src_height) {
-      // optimized, 1/2
-      ScalePlaneDown2_16(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst, filtering);
+    case kScalePlanePolyphase:
+      // The columns are those of the polyphase tables.
+      assert(setup->polyphase.count_x == clip_width);
+      ScalePolyphaseRun(&setup->polyphase, src, src_stride, dst, dst_stride,
+                        band_y, band_height);
       return;
-    }
-    // 3/8 rounded up for odd sized chroma height.
-    if (8 * dst_width == 3 * src_width && 8 * dst_height == 3 * src_height) {
-      // optimized, 3/8
-      ScalePlaneDown38_16(src_width, src_height, dst_width, dst_height,
-                          src_stride, dst_stride, src, dst, filtering);
+    case kScalePlaneVertical:
+      ScalePlaneVertical(src_height, clip_width, band_height, src_stride,
+                         dst_stride, src, dst, clip_x << 16,
+                         (int)((int64_t)(band_y)*setup->dy), setup->dy, 1,
+                         filtering);
       return;
-    }
-    if (4 * dst_width == src_width && 4 * dst_height == src_height &&
-        (filtering == kFilterBox || filtering == kFilterNone)) {
-      // optimized, 1/4
-      ScalePlaneDown4_16(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst, filtering);
+    case kScalePlaneDown34:
+      assert(band_y % 3 == 0 && clip_x % 3 == 0 && clip_width % 3 == 0);
+      ScalePlaneDown34(src_width, src_height, clip_width, band_height,
+                       src_stride, dst_stride,
+                       src + band_y / 3 * 4 * (intptr_t)src_stride +
+                           clip_x / 3 * 4,
+                       dst, filtering);
+      return;
+    case kScalePlaneDown2:
+      ScalePlaneDown2(src_width, src_height, clip_width, band_height,
+                      src_stride, dst_stride,
+                      src + band_y * 2 * (intptr_t)src_stride + clip_x * 2, dst,
+                      filtering);
+      return;
+    case kScalePlaneDown38:
+      assert(band_y % 3 == 0 && clip_x % 3 == 0 && clip_width % 3 == 0);
+      ScalePlaneDown38(src_width, src_height, clip_width, band_height,
+                       src_stride, dst_stride,
+                       src + band_y / 3 * 8 * (intptr_t)src_stride +
+                           clip_x / 3 * 8,
+                       dst, filtering);
+      return;
+    case kScalePlaneDown4:
+      ScalePlaneDown4(src_width, src_height, clip_width, band_height,
+                      src_stride, dst_stride,
+                      src + band_y * 4 * (intptr_t)src_stride + clip_x * 4, dst,
+                      filtering);
+      return;
+    default:
+      break;
+  }
+
+  // Step the source position to the first row and column of the clip. The
+  // column position wraps like stepping it one column at a time.
+  x = (int)(setup->x + (int64_t)(clip_x)*setup->dx);
+  y = setup->y + (int)((int64_t)(band_y)*setup->dy);
+  switch (setup->scaler) {
+    case kScalePlaneBox:
+      ScalePlaneBox(Abs(src_width), src_height, clip_width, band_height,
+                    src_stride, dst_stride, src, dst, x, setup->dx, y,
+                    setup->dy);
+      return;
+    case kScalePlaneBilinearUp:
+      ScalePlaneBilinearUp(Abs(src_width), src_height, clip_width,
+                           band_height, src_stride, dst_stride, src, dst, x,
+                           setup->dx, y, setup->dy, filtering);
+      return;
+    case kScalePlaneBilinearDown:
+      ScalePlaneBilinearDown(Abs(src_width), src_height, clip_width,
+                             band_height, src_stride, dst_stride, src, dst, x,
+                             setup->dx, y, setup->dy, filtering);
       return;
+    default:
+      ScalePlaneSimple(Abs(src_width), src_height, clip_width, band_height,
+                       src_stride, dst_stride, src, dst, x, setup->dx, y,
+                       setup->dy);
+      return;
+  }
+}
+
+void ScalePlaneSetupRun(const ScalePlaneSetup* setup,
+                        const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int band_y,
+                        int band_height) {
+  ScalePlaneSetupRunClip(setup, src, src_stride, dst, dst_stride, 0,
+                         setup->dst_width, band_y, band_height);
+}
+
+void ScalePlaneSetupSrcRows(const ScalePlaneSetup* setup,
+                            int band_y,
+                            int band_height,
+                            int* src_begin,
+                            int* src_end) {
+  const int src_height = setup->src_height;
+  const int last_y = band_y + band_height - 1;
+  int begin;
+  int end;
+  assert(src_height > 0);
+  switch (setup->scaler) {
+    case kScalePlaneCopy:
+      begin = band_y;
+      end = last_y + 1;
+      break;
+    case kScalePlanePolyphase: {
+      const ScalePolyphase* polyphase = &setup->polyphase;
+      begin = polyphase->offsets_y[band_y - polyphase->begin_y];
+      end = polyphase->offsets_y[last_y - polyphase->begin_y] +
+            polyphase->taps_y;
+      break;
+    }
+    case kScalePlaneDown34:
+      begin = band_y / 3 * 4;
+      end = (last_y / 3 + 1) * 4;
+      break;
+    case kScalePlaneDown2:
+      begin = band_y * 2;
+      end = (last_y + 1) * 2;
+      break;
+    case kScalePlaneDown38:
+      begin = band_y / 3 * 8;
+      end = (last_y / 3 + 1) * 8;
+      break;
+    case kScalePlaneDown4:
+      begin = band_y * 4;
+      end = (last_y + 1) * 4;
+      break;
+    default: {
+      // Bilinear filters also read the row after the source position, and
+      // box filters read the rows up to the position of the next row.
+      const int y = setup->scaler == kScalePlaneVertical ? 0 : setup->y;
+      int64_t last = y + (int64_t)(last_y)*setup->dy;
+      if (setup->scaler == kScalePlaneBox) {
+        last += setup->dy;
+      }
+      begin = (int)((y + (int64_t)(band_y)*setup->dy) >> 16);
+      end = (int)(last >> 16) + 2;
+      break;
     }
   }
-  if (filtering == kFilterBox && dst_height * 2 < src_height) {
-    ScalePlaneBox_16(src_width, src_height, dst_width, dst_height, src_stride,
-                     dst_stride, src, dst);
+  *src_begin = begin < 0 ? 0 : (begin > src_height ? src_height : begin);
+  *src_end = end < *src_begin ? *src_begin : (end > src_height ? src_height
+                                                               : end);
+}
+
+// Scale rows [band_y, band_y + band_height) of the destination plane into
+// dst, which points to row band_y. The source position of the first row is
+// computed from band_y, so bands can be scaled independently with results
+// identical to scaling the whole plane.
+// The 3/4 and 3/8 scalers produce rows in groups of 3, so for those band_y
+// must be a multiple of 3.
+void ScalePlaneBand(const uint8_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    int band_y,
+                    int band_height,
+                    enum FilterMode filtering) {
+  ScalePlaneSetup setup;
+  ScalePlaneSetupInit(&setup, src_width, src_height, dst_width, dst_height,
+                      filtering);
+  if (ScalePlaneSetupPolyphase(&setup)) {
+    // Only the filters of the rows of the band are computed.
+    src_height = Abs(src_height);
+    align_buffer_64(tables,
+                    ScalePolyphaseSize(src_width, src_height, dst_width,
+                                       dst_height, dst_width, band_height, 1,
+                                       setup.filtering));
+    ScalePolyphaseInit(&setup.polyphase, tables, src_width, src_height,
+                       dst_width, dst_height, 0, dst_width, band_y,
+                       band_height, 1, setup.filtering);
+    ScalePlaneSetupRun(&setup, src, src_stride, dst, dst_stride, band_y,
+                       band_height);
+    free_aligned_buffer_64(tables);
     return;
   }
-  if (filtering && dst_height > src_height) {
-    ScalePlaneBilinearUp_16(src_width, src_height, dst_width, dst_height,
-                            src_stride, dst_stride, src, dst, filtering);
-    return;
+  ScalePlaneSetupRun(&setup, src, src_stride, dst, dst_stride, band_y,
+                     band_height);
+}
+
+// 16 bit version of ScalePlaneSetupRunClip. Polyphase filters are computed
+// for each call, so the setup has no polyphase tables.
+void ScalePlaneSetupRunClip_16(const ScalePlaneSetup* setup,
+                               const uint16_t* src,
+                               int src_stride,
+                               uint16_t* dst,
+                               int dst_stride,
+                               int clip_x,
+                               int clip_width,
+                               int band_y,
+                               int band_height) {
+  const int src_width = setup->src_width;
+  const enum FilterMode filtering = setup->filtering;
+  int src_height = setup->src_height;
+  int x;
+  int y;
+
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src = src + (src_height - 1) * src_stride;
+    src_stride = -src_stride;
   }
-  if (filtering) {
-    ScalePlaneBilinearDown_16(src_width, src_height, dst_width, dst_height,
-                              src_stride, dst_stride, src, dst, filtering);
-    return;
+
+  switch (setup->scaler) {
+    case kScalePlaneCopy:
+      CopyPlane_16(src + band_y * (intptr_t)src_stride + clip_x, src_stride,
+                   dst, dst_stride, clip_width, band_height);
+      return;
+    case kScalePlanePolyphase:
+      ScalePlanePolyphase_16(src_width, src_height, setup->dst_width,
+                             setup->dst_height, clip_x, clip_width, band_y,
+                             band_height, src_stride, dst_stride, src, dst,
+                             filtering);
+      return;
+    case kScalePlaneVertical:
+      ScalePlaneVertical_16(src_height, clip_width, band_height, src_stride,
+                            dst_stride, src, dst, clip_x << 16,
+                            (int)((int64_t)(band_y)*setup->dy), setup->dy, 1,
+                            filtering);
+      return;
+    case kScalePlaneDown34:
+      assert(band_y % 3 == 0 && clip_x % 3 == 0 && clip_width % 3 == 0);
+      ScalePlaneDown34_16(src_width, src_height, clip_width, band_height,
+                          src_stride, dst_stride,
+                          src + band_y / 3 * 4 * (intptr_t)src_stride +
+                              clip_x / 3 * 4,
+                          dst, filtering);
+      return;
+    case kScalePlaneDown2:
+      ScalePlaneDown2_16(src_width, src_height, clip_width, band_height,
+                         src_stride, dst_stride,
+                         src + band_y * 2 * (intptr_t)src_stride + clip_x * 2,
+                         dst, filtering);
+      return;
+    case kScalePlaneDown38:
+      assert(band_y % 3 == 0 && clip_x % 3 == 0 && clip_width % 3 == 0);
+      ScalePlaneDown38_16(src_width, src_height, clip_width, band_height,
+                          src_stride, dst_stride,
+                          src + band_y / 3 * 8 * (intptr_t)src_stride +
+                              clip_x / 3 * 8,
+                          dst, filtering);
+      return;
+    case kScalePlaneDown4:
+      ScalePlaneDown4_16(src_width, src_height, clip_width, band_height,
+                         src_stride, dst_stride,
+                         src + band_y * 4 * (intptr_t)src_stride + clip_x * 4,
+                         dst, filtering);
+      return;
+    default:
+      break;
+  }
+
+  x = (int)(setup->x + (int64_t)(clip_x)*setup->dx);
+  y = setup->y + (int)((int64_t)(band_y)*setup->dy);
+  switch (setup->scaler) {
+    case kScalePlaneBox:
+      ScalePlaneBox_16(Abs(src_width), src_height, clip_width, band_height,
+                       src_stride, dst_stride, src, dst, x, setup->dx, y,
+                       setup->dy);
+      return;
+    case kScalePlaneBilinearUp:
+      ScalePlaneBilinearUp_16(Abs(src_width), src_height, clip_width,
+                              band_height, src_stride, dst_stride, src, dst,
+                              x, setup->dx, y, setup->dy, filtering);
+      return;
+    case kScalePlaneBilinearDown:
+      ScalePlaneBilinearDown_16(Abs(src_width), src_height, clip_width,
+                                band_height, src_stride, dst_stride, src, dst,
+                                x, setup->dx, y, setup->dy, filtering);
+      return;
+    default:
+      ScalePlaneSimple_16(Abs(src_width), src_height, clip_width, band_height,
+                          src_stride, dst_stride, src, dst, x, setup->dx, y,
+                          setup->dy);
+      return;
   }
-  ScalePlaneSimple_16(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst);
+}
+
+void ScalePlaneBand_16(const uint16_t* src,
+                       int src_stride,
+                       int src_width,
+                       int src_height,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int dst_width,
+                       int dst_height,
+                       int band_y,
+                       int band_height,
+                       enum FilterMode filtering) {
+  ScalePlaneSetup setup;
+  ScalePlaneSetupInit(&setup, src_width, src_height, dst_width, dst_height,
+                      filtering);
+  ScalePlaneSetupRunClip_16(&setup, src, src_stride, dst, dst_stride, 0,
+                            dst_width, band_y, band_height);
+}
+
+// Describes a plane to be scaled in bands of destination rows.
+// band_height is the rows per band when the number of bands is fixed.
+typedef struct {
+  const uint8_t* src;
+  int src_stride;
+  int src_width;
+  int src_height;
+  uint8_t* dst;
+  int dst_stride;
+  int dst_width;
+  int dst_height;
+  int band_height;
+  enum FilterMode filtering;
+} ScalePlaneJob;
+
+typedef struct {
+  const uint16_t* src;
+  int src_stride;
+  int src_width;
+  int src_height;
+  uint16_t* dst;
+  int dst_stride;
+  int dst_width;
+  int dst_height;
+  int band_height;
+  enum FilterMode filtering;
+} ScalePlaneJob_16;
+
+static void ScalePlaneRows(void* arg, int begin, int end) {
+  const ScalePlaneJob* job = static_cast<const ScalePlaneJob*>(arg);
+  ScalePlaneBand(job->src, job->src_stride, job->src_width, job->src_height,
+                 job->dst + begin * (intptr_t)job->dst_stride, job->dst_stride,
+                 job->dst_width, job->dst_height, begin, end - begin,
+                 job->filtering);
+}
+
+static void ScalePlaneRows_16(void* arg, int begin, int end) {
+  const ScalePlaneJob_16* job = static_cast<const ScalePlaneJob_16*>(arg);
+  ScalePlaneBand_16(job->src, job->src_stride, job->src_width, job->src_height,
+                    job->dst + begin * (intptr_t)job->dst_stride,
+                    job->dst_stride, job->dst_width, job->dst_height, begin,
+                    end - begin, job->filtering);
+}
+
+// Scale a plane.
+// This function dispatches to a specialized scaler based on scale factor.
+// Bands of rows are scaled on the threads of the executor if there is one.
+
+LIBYUV_API
+void ScalePlane(const uint8_t* src,
+                int src_stride,
+                int src_width,
+                int src_height,
+                uint8_t* dst,
+                int dst_stride,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering) {
+  ScalePlaneJob job = {src,        src_stride, src_width,  src_height,
+                       dst,        dst_stride, dst_width,  dst_height,
+                       0,          filtering};
+  LIBYUV_STATS_BEGIN(stats_start);
+  // Bands start on a row group of the 3/4 and 3/8 scalers.
+  if (ParallelRows(dst_width, dst_height, 3, ScalePlaneRows, &job) != 0) {
+    ScalePlaneBand(src, src_stride, src_width, src_height, dst, dst_stride,
+                   dst_width, dst_height, 0, dst_height, filtering);
+  }
+  LIBYUV_STATS_END(stats_start, kStatsScalePlane,
+                   (uint64_t)dst_width * dst_height);
+}
+
+LIBYUV_API
+void ScalePlane_16(const uint16_t* src,
+                   int src_stride,
+                   int src_width,
+                   int src_height,
+                   uint16_t* dst,
+                   int dst_stride,
+                   int dst_width,
+                   int dst_height,
+                   enum FilterMode filtering) {
+  ScalePlaneJob_16 job = {src,        src_stride, src_width,  src_height,
+                          dst,        dst_stride, dst_width,  dst_height,
+                          0,          filtering};
+  LIBYUV_STATS_BEGIN(stats_start);
+  if (ParallelRows(dst_width, dst_height, 3, ScalePlaneRows_16, &job) != 0) {
+    ScalePlaneBand_16(src, src_stride, src_width, src_height, dst, dst_stride,
+                      dst_width, dst_height, 0, dst_height, filtering);
+  }
+  LIBYUV_STATS_END(stats_start, kStatsScalePlane_16,
+                   (uint64_t)dst_width * dst_height);
 }
 
 // Scale an I420 image.
@@ -1742,12 +2341,15 @@ int I420Scale(const uint8_t* src_y,
     return -1;
   }
 
+  LIBYUV_STATS_BEGIN(stats_start);
   ScalePlane(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
              dst_width, dst_height, filtering);
   ScalePlane(src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
              dst_stride_u, dst_halfwidth, dst_halfheight, filtering);
   ScalePlane(src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
              dst_stride_v, dst_halfwidth, dst_halfheight, filtering);
+  LIBYUV_STATS_END(stats_start, kStatsI420Scale,
+                   (uint64_t)dst_width * dst_height);
   return 0;
 }
 
@@ -1788,6 +2390,437 @@ int I420Scale_16(const uint16_t* src_y,
   return 0;
 }
 
+// Round a clip rectangle out to the groups of 3 rows of the 3/4 and 3/8
+// scalers. Their row functions are chosen by width and do not all round the
+// same, so whole rows are scaled to match the full plane.
+// Returns true if the rectangle changed.
+static LIBYUV_BOOL ScaleClipGroups(const ScalePlaneSetup* setup,
+                                   int clip_x,
+                                   int clip_y,
+                                   int clip_width,
+                                   int clip_height,
+                                   int* group_x,
+                                   int* group_y,
+                                   int* group_width,
+                                   int* group_height) {
+  int y1 = clip_y + clip_height;
+  if (setup->row_align == 1) {
+    return LIBYUV_FALSE;
+  }
+  *group_x = 0;
+  *group_y = clip_y / 3 * 3;
+  y1 = (y1 + 2) / 3 * 3;
+  if (y1 > setup->dst_height) {
+    y1 = setup->dst_height;
+  }
+  *group_width = setup->dst_width;
+  *group_height = y1 - *group_y;
+  return *group_x != clip_x || *group_y != clip_y ||
+         *group_width != clip_width || *group_height != clip_height;
+}
+
+// Scale a rectangle of the destination plane.
+// Only the filters of the rectangle are computed, and its pixels are the
+// same as those of scaling the whole plane.
+LIBYUV_API
+int ScalePlaneClip(const uint8_t* src,
+                   int src_stride,
+                   int src_width,
+                   int src_height,
+                   uint8_t* dst,
+                   int dst_stride,
+                   int dst_width,
+                   int dst_height,
+                   int clip_x,
+                   int clip_y,
+                   int clip_width,
+                   int clip_height,
+                   enum FilterMode filtering) {
+  ScalePlaneSetup setup;
+  int group_x, group_y, group_width, group_height;
+  if (!src || src_width == 0 || src_height == 0 || src_width > 32768 ||
+      src_height > 32768 || !dst || dst_width <= 0 || dst_height <= 0 ||
+      clip_x < 0 || clip_y < 0 || clip_width <= 0 || clip_height <= 0 ||
+      (clip_x + clip_width) > dst_width ||
+      (clip_y + clip_height) > dst_height) {
+    return -1;
+  }
+  ScalePlaneSetupInit(&setup, src_width, src_height, dst_width, dst_height,
+                      filtering);
+  dst += clip_y * (intptr_t)(dst_stride) + clip_x;
+  if (ScalePlaneSetupPolyphase(&setup)) {
+    align_buffer_64(tables, ScalePolyphaseSize(src_width, Abs(src_height),
+                                               dst_width, dst_height,
+                                               clip_width, clip_height, 1,
+                                               setup.filtering));
+    ScalePolyphaseInit(&setup.polyphase, tables, src_width, Abs(src_height),
+                       dst_width, dst_height, clip_x, clip_width, clip_y,
+                       clip_height, 1, setup.filtering);
+    ScalePlaneSetupRunClip(&setup, src, src_stride, dst, dst_stride, clip_x,
+                           clip_width, clip_y, clip_height);
+    free_aligned_buffer_64(tables);
+    return 0;
+  }
+  if (ScaleClipGroups(&setup, clip_x, clip_y, clip_width, clip_height,
+                      &group_x, &group_y, &group_width, &group_height)) {
+    // Scale whole groups and copy the rectangle out of them.
+    align_buffer_64(group, group_width * group_height);
+    ScalePlaneSetupRunClip(&setup, src, src_stride, group, group_width,
+                           group_x, group_width, group_y, group_height);
+    CopyPlane(group + (clip_y - group_y) * group_width + (clip_x - group_x),
+              group_width, dst, dst_stride, clip_width, clip_height);
+    free_aligned_buffer_64(group);
+    return 0;
+  }
+  ScalePlaneSetupRunClip(&setup, src, src_stride, dst, dst_stride, clip_x,
+                         clip_width, clip_y, clip_height);
+  return 0;
+}
+
+LIBYUV_API
+int ScalePlaneClip_16(const uint16_t* src,
+                      int src_stride,
+                      int src_width,
+                      int src_height,
+                      uint16_t* dst,
+                      int dst_stride,
+                      int dst_width,
+                      int dst_height,
+                      int clip_x,
+                      int clip_y,
+                      int clip_width,
+                      int clip_height,
+                      enum FilterMode filtering) {
+  ScalePlaneSetup setup;
+  int group_x, group_y, group_width, group_height;
+  if (!src || src_width == 0 || src_height == 0 || src_width > 32768 ||
+      src_height > 32768 || !dst || dst_width <= 0 || dst_height <= 0 ||
+      clip_x < 0 || clip_y < 0 || clip_width <= 0 || clip_height <= 0 ||
+      (clip_x + clip_width) > dst_width ||
+      (clip_y + clip_height) > dst_height) {
+    return -1;
+  }
+  ScalePlaneSetupInit(&setup, src_width, src_height, dst_width, dst_height,
+                      filtering);
+  dst += clip_y * (intptr_t)(dst_stride) + clip_x;
+  if (ScaleClipGroups(&setup, clip_x, clip_y, clip_width, clip_height,
+                      &group_x, &group_y, &group_width, &group_height)) {
+    align_buffer_64(group, group_width * group_height * 2);
+    ScalePlaneSetupRunClip_16(&setup, src, src_stride, (uint16_t*)(group),
+                              group_width, group_x, group_width, group_y,
+                              group_height);
+    CopyPlane_16((const uint16_t*)(group) +
+                     (clip_y - group_y) * group_width + (clip_x - group_x),
+                 group_width, dst, dst_stride, clip_width, clip_height);
+    free_aligned_buffer_64(group);
+    return 0;
+  }
+  ScalePlaneSetupRunClip_16(&setup, src, src_stride, dst, dst_stride, clip_x,
+                            clip_width, clip_y, clip_height);
+  return 0;
+}
+
+// Scale a rectangle of an I420 image. The chroma planes are scaled for the
+// chroma samples of the rectangle, so tiles with odd edges share a chroma
+// sample with their neighbour, which both write with the same value.
+LIBYUV_API
+int I420ScaleClip(const uint8_t* src_y,
+                  int src_stride_y,
+                  const uint8_t* src_u,
+                  int src_stride_u,
+                  const uint8_t* src_v,
+                  int src_stride_v,
+                  int src_width,
+                  int src_height,
+                  uint8_t* dst_y,
+                  int dst_stride_y,
+                  uint8_t* dst_u,
+                  int dst_stride_u,
+                  uint8_t* dst_v,
+                  int dst_stride_v,
+                  int dst_width,
+                  int dst_height,
+                  int clip_x,
+                  int clip_y,
+                  int clip_width,
+                  int clip_height,
+                  enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int clip_halfx = clip_x >> 1;
+  int clip_halfy = clip_y >> 1;
+  int clip_halfwidth = ((clip_x + clip_width + 1) >> 1) - clip_halfx;
+  int clip_halfheight = ((clip_y + clip_height + 1) >> 1) - clip_halfy;
+  if (!src_u || !src_v || !dst_u || !dst_v) {
+    return -1;
+  }
+  if (ScalePlaneClip(src_y, src_stride_y, src_width, src_height, dst_y,
+                     dst_stride_y, dst_width, dst_height, clip_x, clip_y,
+                     clip_width, clip_height, filtering) != 0) {
+    return -1;
+  }
+  ScalePlaneClip(src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
+                 dst_stride_u, dst_halfwidth, dst_halfheight, clip_halfx,
+                 clip_halfy, clip_halfwidth, clip_halfheight, filtering);
+  ScalePlaneClip(src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
+                 dst_stride_v, dst_halfwidth, dst_halfheight, clip_halfx,
+                 clip_halfy, clip_halfwidth, clip_halfheight, filtering);
+  return 0;
+}
+
+// Rows per band when splitting dst_height rows between num_bands threads.
+// Rounded up to a multiple of 3 so every band starts on a row group of the
+// 3/4 and 3/8 scalers.
+static int ScaleBandHeight(int dst_height, int num_bands) {
+  int band_height = (dst_height + num_bands - 1) / num_bands;
+  return (band_height + 2) / 3 * 3;
+}
+
+static void ScalePlaneJobBand(const ScalePlaneJob* job, int band) {
+  int band_y = band * job->band_height;
+  int band_height = job->dst_height - band_y;
+  if (band_height > job->band_height) {
+    band_height = job->band_height;
+  }
+  if (band_height > 0) {
+    ScalePlaneBand(job->src, job->src_stride, job->src_width, job->src_height,
+                   job->dst + band_y * (intptr_t)job->dst_stride,
+                   job->dst_stride, job->dst_width, job->dst_height, band_y,
+                   band_height, job->filtering);
+  }
+}
+
+static void ScalePlaneJobBand_16(const ScalePlaneJob_16* job, int band) {
+  int band_y = band * job->band_height;
+  int band_height = job->dst_height - band_y;
+  if (band_height > job->band_height) {
+    band_height = job->band_height;
+  }
+  if (band_height > 0) {
+    ScalePlaneBand_16(job->src, job->src_stride, job->src_width,
+                      job->src_height,
+                      job->dst + band_y * (intptr_t)job->dst_stride,
+                      job->dst_stride, job->dst_width, job->dst_height, band_y,
+                      band_height, job->filtering);
+  }
+}
+
+// Bands of a job are scaled in parallel by the executor. Jobs are arrays of
+// planes and a band scales the same band of every plane in the array.
+typedef struct {
+  const void* jobs;
+  int num_jobs;
+  void (*run)(const void* jobs, int num_jobs, int band);
+} ScaleBandTask;
+
+static void ScalePlaneJobsBand(const void* jobs, int num_jobs, int band) {
+  int i;
+  for (i = 0; i < num_jobs; ++i) {
+    ScalePlaneJobBand((const ScalePlaneJob*)(jobs) + i, band);
+  }
+}
+
+static void ScalePlaneJobsBand_16(const void* jobs, int num_jobs, int band) {
+  int i;
+  for (i = 0; i < num_jobs; ++i) {
+    ScalePlaneJobBand_16((const ScalePlaneJob_16*)(jobs) + i, band);
+  }
+}
+
+static void ScaleBandTaskRange(void* arg, int begin, int end) {
+  const ScaleBandTask* task = static_cast<const ScaleBandTask*>(arg);
+  int band;
+  for (band = begin; band < end; ++band) {
+    task->run(task->jobs, task->num_jobs, band);
+  }
+}
+
+// Run the bands on the threads of the executor, including the caller.
+static void ScaleRunBands(const ParallelExecutor* executor,
+                          const ScaleBandTask* task,
+                          int num_bands) {
+  executor->parallel_for(executor->opaque, num_bands, ScaleBandTaskRange,
+                         const_cast<ScaleBandTask*>(task));
+}
+
+// One band per thread of the executor, of at least 3 rows.
+static int ScaleNumBands(int dst_height, const ParallelExecutor* executor) {
+  int max_bands = (dst_height + 2) / 3;
+  int num_bands = executor ? executor->concurrency : 1;
+  if (num_bands > max_bands) {
+    num_bands = max_bands;
+  }
+  return num_bands < 1 ? 1 : num_bands;
+}
+
+LIBYUV_API
+void ScalePlaneMT(const uint8_t* src,
+                  int src_stride,
+                  int src_width,
+                  int src_height,
+                  uint8_t* dst,
+                  int dst_stride,
+                  int dst_width,
+                  int dst_height,
+                  enum FilterMode filtering,
+                  const ParallelExecutor* executor) {
+  int num_bands = ScaleNumBands(dst_height, executor);
+  if (num_bands <= 1) {
+    ScalePlane(src, src_stride, src_width, src_height, dst, dst_stride,
+               dst_width, dst_height, filtering);
+    return;
+  }
+  {
+    const int band_height = ScaleBandHeight(dst_height, num_bands);
+    ScalePlaneJob job = {src, src_stride, src_width, src_height, dst,
+                         dst_stride, dst_width, dst_height, band_height,
+                         filtering};
+    ScaleBandTask task = {&job, 1, ScalePlaneJobsBand};
+    ScaleRunBands(executor, &task, num_bands);
+  }
+}
+
+LIBYUV_API
+void ScalePlaneMT_16(const uint16_t* src,
+                     int src_stride,
+                     int src_width,
+                     int src_height,
+                     uint16_t* dst,
+                     int dst_stride,
+                     int dst_width,
+                     int dst_height,
+                     enum FilterMode filtering,
+                     const ParallelExecutor* executor) {
+  int num_bands = ScaleNumBands(dst_height, executor);
+  if (num_bands <= 1) {
+    ScalePlane_16(src, src_stride, src_width, src_height, dst, dst_stride,
+                  dst_width, dst_height, filtering);
+    return;
+  }
+  {
+    const int band_height = ScaleBandHeight(dst_height, num_bands);
+    ScalePlaneJob_16 job = {src, src_stride, src_width, src_height, dst,
+                            dst_stride, dst_width, dst_height, band_height,
+                            filtering};
+    ScaleBandTask task = {&job, 1, ScalePlaneJobsBand_16};
+    ScaleRunBands(executor, &task, num_bands);
+  }
+}
+
+// Scale an I420 image using the threads of an executor.
+// Each band scales rows of the Y plane and the matching rows of the U and V
+// planes.
+
+LIBYUV_API
+int I420ScaleMT(const uint8_t* src_y,
+                int src_stride_y,
+                const uint8_t* src_u,
+                int src_stride_u,
+                const uint8_t* src_v,
+                int src_stride_v,
+                int src_width,
+                int src_height,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_u,
+                int dst_stride_u,
+                uint8_t* dst_v,
+                int dst_stride_v,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering,
+                const ParallelExecutor* executor) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int num_bands;
+  if (!src_y || !src_u || !src_v || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  num_bands = ScaleNumBands(dst_halfheight, executor);
+  if (num_bands <= 1) {
+    return I420Scale(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                     src_stride_v, src_width, src_height, dst_y, dst_stride_y,
+                     dst_u, dst_stride_u, dst_v, dst_stride_v, dst_width,
+                     dst_height, filtering);
+  }
+  {
+    const int band_height = ScaleBandHeight(dst_height, num_bands);
+    const int band_halfheight = ScaleBandHeight(dst_halfheight, num_bands);
+    ScalePlaneJob jobs[3] = {
+        {src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
+         dst_width, dst_height, band_height, filtering},
+        {src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
+         dst_stride_u, dst_halfwidth, dst_halfheight, band_halfheight,
+         filtering},
+        {src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
+         dst_stride_v, dst_halfwidth, dst_halfheight, band_halfheight,
+         filtering}};
+    ScaleBandTask task = {jobs, 3, ScalePlaneJobsBand};
+    ScaleRunBands(executor, &task, num_bands);
+  }
+  return 0;
+}
+
+LIBYUV_API
+int I420ScaleMT_16(const uint16_t* src_y,
+                   int src_stride_y,
+                   const uint16_t* src_u,
+                   int src_stride_u,
+                   const uint16_t* src_v,
+                   int src_stride_v,
+                   int src_width,
+                   int src_height,
+                   uint16_t* dst_y,
+                   int dst_stride_y,
+                   uint16_t* dst_u,
+                   int dst_stride_u,
+                   uint16_t* dst_v,
+                   int dst_stride_v,
+                   int dst_width,
+                   int dst_height,
+                   enum FilterMode filtering,
+                   const ParallelExecutor* executor) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int num_bands;
+  if (!src_y || !src_u || !src_v || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  num_bands = ScaleNumBands(dst_halfheight, executor);
+  if (num_bands <= 1) {
+    return I420Scale_16(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                        src_stride_v, src_width, src_height, dst_y,
+                        dst_stride_y, dst_u, dst_stride_u, dst_v, dst_stride_v,
+                        dst_width, dst_height, filtering);
+  }
+  {
+    const int band_height = ScaleBandHeight(dst_height, num_bands);
+    const int band_halfheight = ScaleBandHeight(dst_halfheight, num_bands);
+    ScalePlaneJob_16 jobs[3] = {
+        {src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
+         dst_width, dst_height, band_height, filtering},
+        {src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
+         dst_stride_u, dst_halfwidth, dst_halfheight, band_halfheight,
+         filtering},
+        {src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
+         dst_stride_v, dst_halfwidth, dst_halfheight, band_halfheight,
+         filtering}};
+    ScaleBandTask task = {jobs, 3, ScalePlaneJobsBand_16};
+    ScaleRunBands(executor, &task, num_bands);
+  }
+  return 0;
+}
+
 // Deprecated api
 LIBYUV_API
 int Scale(const uint8_t* src_y,
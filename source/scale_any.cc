@@ -63,6 +63,26 @@ CANY(ScaleARGBFilterCols_Any_MSA,
 #endif
 #undef CANY
 
+// Scale up horizontally for 16 bit pixels.
+#define CANY16(NAMEANY, TERP_SIMD, TERP_C, MASK)                          \
+  void NAMEANY(uint16_t* dst_ptr, const uint16_t* src_ptr, int dst_width, \
+               int x, int dx) {                                          \
+    int r = dst_width & MASK;                                             \
+    int n = dst_width & ~MASK;                                            \
+    if (n > 0) {                                                          \
+      TERP_SIMD(dst_ptr, src_ptr, n, x, dx);                              \
+    }                                                                     \
+    TERP_C(dst_ptr + n, src_ptr, r, x + n * dx, dx);                      \
+  }
+
+#ifdef HAS_SCALEFILTERCOLS_16_AVX2
+CANY16(ScaleFilterCols_Any_16_AVX2,
+       ScaleFilterCols_16_AVX2,
+       ScaleFilterCols_16_C,
+       7)
+#endif
+#undef CANY16
+
 // Fixed scale down.
 // Mask may be non-power of 2, so use MOD
 #define SDANY(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, FACTOR, BPP, MASK)   \
@@ -134,6 +154,32 @@ SDODD(ScaleRowDown2Box_Odd_AVX2,
       1,
       31)
 #endif
+#ifdef HAS_SCALEROWDOWN2_AVX512BW
+SDANY(ScaleRowDown2_Any_AVX512BW,
+      ScaleRowDown2_AVX512BW,
+      ScaleRowDown2_C,
+      2,
+      1,
+      63)
+SDANY(ScaleRowDown2Linear_Any_AVX512BW,
+      ScaleRowDown2Linear_AVX512BW,
+      ScaleRowDown2Linear_C,
+      2,
+      1,
+      63)
+SDANY(ScaleRowDown2Box_Any_AVX512BW,
+      ScaleRowDown2Box_AVX512BW,
+      ScaleRowDown2Box_C,
+      2,
+      1,
+      63)
+SDODD(ScaleRowDown2Box_Odd_AVX512BW,
+      ScaleRowDown2Box_AVX512BW,
+      ScaleRowDown2Box_Odd_C,
+      2,
+      1,
+      63)
+#endif
 #ifdef HAS_SCALEROWDOWN2_NEON
 SDANY(ScaleRowDown2_Any_NEON, ScaleRowDown2_NEON, ScaleRowDown2_C, 2, 1, 15)
 SDANY(ScaleRowDown2Linear_Any_NEON,
@@ -437,8 +483,210 @@ SDANY(ScaleARGBRowDown2Box_Any_MMI,
       4,
       1)
 #endif
+#ifdef HAS_SCALEUVROWDOWN2_SSSE3
+SDANY(ScaleUVRowDown2_Any_SSSE3,
+      ScaleUVRowDown2_SSSE3,
+      ScaleUVRowDown2_C,
+      2,
+      2,
+      7)
+SDANY(ScaleUVRowDown2Linear_Any_SSSE3,
+      ScaleUVRowDown2Linear_SSSE3,
+      ScaleUVRowDown2Linear_C,
+      2,
+      2,
+      7)
+SDANY(ScaleUVRowDown2Box_Any_SSSE3,
+      ScaleUVRowDown2Box_SSSE3,
+      ScaleUVRowDown2Box_C,
+      2,
+      2,
+      7)
+#endif
+#ifdef HAS_SCALEUVROWDOWN2BOX_AVX2
+SDANY(ScaleUVRowDown2Box_Any_AVX2,
+      ScaleUVRowDown2Box_AVX2,
+      ScaleUVRowDown2Box_C,
+      2,
+      2,
+      15)
+#endif
 #undef SDANY
 
+// Fixed scale down for 16 bit pixels.
+#define SDANY16(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, FACTOR, MASK) \
+  void NAMEANY(const uint16_t* src_ptr, ptrdiff_t src_stride,             \
+               uint16_t* dst_ptr, int dst_width) {                        \
+    int r = (int)((unsigned int)dst_width % (MASK + 1)); /* NOLINT */     \
+    int n = dst_width - r;                                                \
+    if (n > 0) {                                                          \
+      SCALEROWDOWN_SIMD(src_ptr, src_stride, dst_ptr, n);                 \
+    }                                                                     \
+    SCALEROWDOWN_C(src_ptr + (n * FACTOR), src_stride, dst_ptr + n, r);   \
+  }
+
+#ifdef HAS_SCALEROWDOWN2_16_SSE2
+SDANY16(ScaleRowDown2_Any_16_SSE2,
+        ScaleRowDown2_16_SSE2,
+        ScaleRowDown2_16_C,
+        2,
+        7)
+SDANY16(ScaleRowDown2Linear_Any_16_SSE2,
+        ScaleRowDown2Linear_16_SSE2,
+        ScaleRowDown2Linear_16_C,
+        2,
+        7)
+SDANY16(ScaleRowDown2Box_Any_16_SSE2,
+        ScaleRowDown2Box_16_SSE2,
+        ScaleRowDown2Box_16_C,
+        2,
+        7)
+#endif
+#ifdef HAS_SCALEROWDOWN2_16_AVX2
+SDANY16(ScaleRowDown2_Any_16_AVX2,
+        ScaleRowDown2_16_AVX2,
+        ScaleRowDown2_16_C,
+        2,
+        15)
+SDANY16(ScaleRowDown2Linear_Any_16_AVX2,
+        ScaleRowDown2Linear_16_AVX2,
+        ScaleRowDown2Linear_16_C,
+        2,
+        15)
+SDANY16(ScaleRowDown2Box_Any_16_AVX2,
+        ScaleRowDown2Box_16_AVX2,
+        ScaleRowDown2Box_16_C,
+        2,
+        15)
+#endif
+#ifdef HAS_SCALEROWDOWN2_16_AVX512BW
+SDANY16(ScaleRowDown2_Any_16_AVX512BW,
+        ScaleRowDown2_16_AVX512BW,
+        ScaleRowDown2_16_C,
+        2,
+        31)
+SDANY16(ScaleRowDown2Linear_Any_16_AVX512BW,
+        ScaleRowDown2Linear_16_AVX512BW,
+        ScaleRowDown2Linear_16_C,
+        2,
+        31)
+SDANY16(ScaleRowDown2Box_Any_16_AVX512BW,
+        ScaleRowDown2Box_16_AVX512BW,
+        ScaleRowDown2Box_16_C,
+        2,
+        31)
+#endif
+#ifdef HAS_SCALEROWDOWN4_16_SSE2
+SDANY16(ScaleRowDown4_Any_16_SSE2,
+        ScaleRowDown4_16_SSE2,
+        ScaleRowDown4_16_C,
+        4,
+        7)
+SDANY16(ScaleRowDown4Box_Any_16_SSE2,
+        ScaleRowDown4Box_16_SSE2,
+        ScaleRowDown4Box_16_C,
+        4,
+        7)
+#endif
+#ifdef HAS_SCALEROWDOWN4_16_AVX2
+SDANY16(ScaleRowDown4_Any_16_AVX2,
+        ScaleRowDown4_16_AVX2,
+        ScaleRowDown4_16_C,
+        4,
+        15)
+SDANY16(ScaleRowDown4Box_Any_16_AVX2,
+        ScaleRowDown4Box_16_AVX2,
+        ScaleRowDown4Box_16_C,
+        4,
+        15)
+#endif
+#ifdef HAS_SCALEROWDOWN4_16_AVX512BW
+SDANY16(ScaleRowDown4_Any_16_AVX512BW,
+        ScaleRowDown4_16_AVX512BW,
+        ScaleRowDown4_16_C,
+        4,
+        15)
+SDANY16(ScaleRowDown4Box_Any_16_AVX512BW,
+        ScaleRowDown4Box_16_AVX512BW,
+        ScaleRowDown4Box_16_C,
+        4,
+        15)
+#endif
+#ifdef HAS_SCALEROWDOWN34_16_SSSE3
+SDANY16(ScaleRowDown34_Any_16_SSSE3,
+        ScaleRowDown34_16_SSSE3,
+        ScaleRowDown34_16_C,
+        4 / 3,
+        11)
+SDANY16(ScaleRowDown34_0_Box_Any_16_SSSE3,
+        ScaleRowDown34_0_Box_16_SSSE3,
+        ScaleRowDown34_0_Box_16_C,
+        4 / 3,
+        11)
+SDANY16(ScaleRowDown34_1_Box_Any_16_SSSE3,
+        ScaleRowDown34_1_Box_16_SSSE3,
+        ScaleRowDown34_1_Box_16_C,
+        4 / 3,
+        11)
+#endif
+#ifdef HAS_SCALEROWDOWN38_16_SSSE3
+SDANY16(ScaleRowDown38_Any_16_SSSE3,
+        ScaleRowDown38_16_SSSE3,
+        ScaleRowDown38_16_C,
+        8 / 3,
+        5)
+SDANY16(ScaleRowDown38_3_Box_Any_16_SSSE3,
+        ScaleRowDown38_3_Box_16_SSSE3,
+        ScaleRowDown38_3_Box_16_C,
+        8 / 3,
+        5)
+SDANY16(ScaleRowDown38_2_Box_Any_16_SSSE3,
+        ScaleRowDown38_2_Box_16_SSSE3,
+        ScaleRowDown38_2_Box_16_C,
+        8 / 3,
+        5)
+#endif
+#undef SDANY16
+
+// Fixed scale down for 16 bit UV pairs.
+#define SDUVANY16(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, FACTOR, MASK)   \
+  void NAMEANY(const uint16_t* src_ptr, ptrdiff_t src_stride,                \
+               uint16_t* dst_ptr, int dst_width) {                           \
+    int r = dst_width & MASK;                                                \
+    int n = dst_width & ~MASK;                                               \
+    if (n > 0) {                                                             \
+      SCALEROWDOWN_SIMD(src_ptr, src_stride, dst_ptr, n);                    \
+    }                                                                        \
+    SCALEROWDOWN_C(src_ptr + (n * FACTOR) * 2, src_stride, dst_ptr + n * 2, \
+                   r);                                                       \
+  }
+
+#ifdef HAS_SCALEUVROWDOWN2_16_SSE2
+SDUVANY16(ScaleUVRowDown2Linear_Any_16_SSE2,
+          ScaleUVRowDown2Linear_16_SSE2,
+          ScaleUVRowDown2Linear_16_C,
+          2,
+          3)
+SDUVANY16(ScaleUVRowDown2Box_Any_16_SSE2,
+          ScaleUVRowDown2Box_16_SSE2,
+          ScaleUVRowDown2Box_16_C,
+          2,
+          3)
+#endif
+#ifdef HAS_SCALEUVROWDOWN2_16_AVX2
+SDUVANY16(ScaleUVRowDown2Linear_Any_16_AVX2,
+          ScaleUVRowDown2Linear_16_AVX2,
+          ScaleUVRowDown2Linear_16_C,
+          2,
+          7)
+SDUVANY16(ScaleUVRowDown2Box_Any_16_AVX2,
+          ScaleUVRowDown2Box_16_AVX2,
+          ScaleUVRowDown2Box_16_C,
+          2,
+          7)
+#endif
+#undef SDUVANY16
+
 // Scale down by even scale factor.
 #define SDAANY(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, BPP, MASK)       \
   void NAMEANY(const uint8_t* src_ptr, ptrdiff_t src_stride, int src_stepx, \
@@ -501,6 +749,27 @@ SDAANY(ScaleARGBRowDownEvenBox_Any_MMI,
        1)
 #endif
 
+// Scale 16 bit UV pairs down by even scale factor.
+#define SDAUVANY16(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, MASK)          \
+  void NAMEANY(const uint16_t* src_ptr, ptrdiff_t src_stride, int src_stepx, \
+               uint16_t* dst_ptr, int dst_width) {                           \
+    int r = dst_width & MASK;                                                \
+    int n = dst_width & ~MASK;                                               \
+    if (n > 0) {                                                             \
+      SCALEROWDOWN_SIMD(src_ptr, src_stride, src_stepx, dst_ptr, n);         \
+    }                                                                        \
+    SCALEROWDOWN_C(src_ptr + (n * src_stepx) * 2, src_stride, src_stepx,     \
+                   dst_ptr + n * 2, r);                                      \
+  }
+
+#ifdef HAS_SCALEUVROWDOWNEVENBOX_16_SSE2
+SDAUVANY16(ScaleUVRowDownEvenBox_Any_16_SSE2,
+           ScaleUVRowDownEvenBox_16_SSE2,
+           ScaleUVRowDownEvenBox_16_C,
+           3)
+#endif
+#undef SDAUVANY16
+
 #ifdef SASIMDONLY
 // This also works and uses memcpy and SIMD instead of C, but is slower on ARM
 
@@ -569,6 +838,79 @@ SAANY(ScaleAddRow_Any_MMI, ScaleAddRow_MMI, ScaleAddRow_C, 7)
 
 #endif  // SASIMDONLY
 
+// Add rows box filter scale down for 16 bit pixels.
+#define SAANY16(NAMEANY, SCALEADDROW_SIMD, SCALEADDROW_C, MASK)              \
+  void NAMEANY(const uint16_t* src_ptr, uint32_t* dst_ptr, int src_width) { \
+    int n = src_width & ~MASK;                                              \
+    if (n > 0) {                                                            \
+      SCALEADDROW_SIMD(src_ptr, dst_ptr, n);                                \
+    }                                                                       \
+    SCALEADDROW_C(src_ptr + n, dst_ptr + n, src_width & MASK);              \
+  }
+
+#ifdef HAS_SCALEADDROW_16_SSE2
+SAANY16(ScaleAddRow_Any_16_SSE2, ScaleAddRow_16_SSE2, ScaleAddRow_16_C, 7)
+#endif
+#ifdef HAS_SCALEADDROW_16_AVX2
+SAANY16(ScaleAddRow_Any_16_AVX2, ScaleAddRow_16_AVX2, ScaleAddRow_16_C, 15)
+#endif
+#ifdef HAS_SCALEADDROW_16_AVX512BW
+SAANY16(ScaleAddRow_Any_16_AVX512BW,
+        ScaleAddRow_16_AVX512BW,
+        ScaleAddRow_16_C,
+        31)
+#endif
+#undef SAANY16
+
+// Polyphase vertical filter.
+#define SPANY(NAMEANY, SCALEPOLYPHASEROWS_SIMD, SCALEPOLYPHASEROWS_C, MASK) \
+  void NAMEANY(const uint8_t* src_ptr, ptrdiff_t src_stride,               \
+               const int16_t* filter, int filter_taps, uint8_t* dst_ptr,   \
+               int dst_width) {                                            \
+    int n = dst_width & ~MASK;                                             \
+    if (n > 0) {                                                           \
+      SCALEPOLYPHASEROWS_SIMD(src_ptr, src_stride, filter, filter_taps,    \
+                              dst_ptr, n);                                 \
+    }                                                                      \
+    SCALEPOLYPHASEROWS_C(src_ptr + n, src_stride, filter, filter_taps,     \
+                         dst_ptr + n, dst_width & MASK);                   \
+  }
+
+#ifdef HAS_SCALEPOLYPHASEROWS_SSE2
+SPANY(ScalePolyphaseRows_Any_SSE2,
+      ScalePolyphaseRows_SSE2,
+      ScalePolyphaseRows_C,
+      15)
+#endif
+#ifdef HAS_SCALEPOLYPHASEROWS_AVX2
+SPANY(ScalePolyphaseRows_Any_AVX2,
+      ScalePolyphaseRows_AVX2,
+      ScalePolyphaseRows_C,
+      31)
+#endif
+#undef SPANY
+
+// Polyphase horizontal filter.
+#define SPCANY(NAMEANY, SCALEPOLYPHASECOLS_SIMD, SCALEPOLYPHASECOLS_C, MASK)  \
+  void NAMEANY(uint8_t* dst_ptr, const uint8_t* src_ptr, int dst_width,       \
+               const int* offsets, const int16_t* filter, int filter_taps) {  \
+    int n = dst_width & ~MASK;                                                \
+    if (n > 0) {                                                              \
+      SCALEPOLYPHASECOLS_SIMD(dst_ptr, src_ptr, n, offsets, filter,           \
+                              filter_taps);                                   \
+    }                                                                         \
+    SCALEPOLYPHASECOLS_C(dst_ptr + n, src_ptr, dst_width & MASK, offsets + n, \
+                         filter + n * filter_taps, filter_taps);              \
+  }
+
+#ifdef HAS_SCALEPOLYPHASECOLS_SSSE3
+SPCANY(ScalePolyphaseCols_Any_SSSE3,
+       ScalePolyphaseCols_SSSE3,
+       ScalePolyphaseCols_C,
+       3)
+#endif
+#undef SPCANY
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -13,10 +13,14 @@
 #include <assert.h>
 #include <string.h>
 
+#include "executor_internal.h"
+#include "libyuv/convert_argb.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyARGB
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
+#include "libyuv/video_common.h"
+#include "stats_internal.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -27,6 +31,8 @@ static __inline int Abs(int v) {
   return v >= 0 ? v : -v;
 }
 
+#define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
+
 // ScaleARGB ARGB, 1/2
 // This is an optimized version for scaling down a ARGB to 1/2 of
 // its original size.
@@ -611,6 +617,14 @@ static void ScaleYUVToARGBBilinearUp(int src_width,
     }
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(src_width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_I422TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     I422ToARGBRow = I422ToARGBRow_Any_NEON;
@@ -887,27 +901,39 @@ static void ScaleARGBSimple(int src_width,
   }
 }
 
-// ScaleARGB a ARGB.
-// This function in turn calls a scaling function
-// suitable for handling the desired resolutions.
-static void ScaleARGB(const uint8_t* src,
-                      int src_stride,
-                      int src_width,
-                      int src_height,
-                      uint8_t* dst,
-                      int dst_stride,
-                      int dst_width,
-                      int dst_height,
-                      int clip_x,
-                      int clip_y,
-                      int clip_width,
-                      int clip_height,
-                      enum FilterMode filtering) {
+// Scalers of ScaleARGBSetup.
+enum {
+  kScaleARGBPolyphase,
+  kScaleARGBDown2,
+  kScaleARGBDown4Box,
+  kScaleARGBDownEven,
+  kScaleARGBCopy,
+  kScaleARGBVertical,
+  kScaleARGBBilinearUp,
+  kScaleARGBBilinearDown,
+  kScaleARGBSimple
+};
+
+void ScaleARGBSetupInit(ScaleARGBSetup* setup,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        int clip_x,
+                        int clip_y,
+                        int clip_width,
+                        int clip_height,
+                        enum FilterMode filtering) {
   // Initial source x/y coordinate and step values as 16.16 fixed point.
   int x = 0;
   int y = 0;
   int dx = 0;
   int dy = 0;
+  // Polyphase filters have their own scaler for all scale factors.
+  const enum FilterMode polyphase =
+      (filtering == kFilterBicubic || filtering == kFilterLanczos) ? filtering
+                                                                  : kFilterNone;
+  memset(setup, 0, sizeof(*setup));
   // ARGB does not support box filter yet, but allow the user to pass it.
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
@@ -916,24 +942,35 @@ static void ScaleARGB(const uint8_t* src,
   // Negative src_height means invert the image.
   if (src_height < 0) {
     src_height = -src_height;
-    src = src + (src_height - 1) * src_stride;
-    src_stride = -src_stride;
+    setup->invert = 1;
+  }
+  setup->src_width = src_width;
+  setup->src_height = src_height;
+  setup->clip_x = clip_x;
+  setup->clip_y = clip_y;
+  setup->clip_width = clip_width;
+  setup->clip_height = clip_height;
+  if (polyphase && (Abs(src_width) != dst_width || src_height != dst_height)) {
+    setup->filtering = polyphase;
+    setup->scaler = kScaleARGBPolyphase;
+    return;
   }
   ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
              &dx, &dy);
-  src_width = Abs(src_width);
   if (clip_x) {
     int64_t clipf = (int64_t)(clip_x)*dx;
     x += (clipf & 0xffff);
-    src += (clipf >> 16) * 4;
-    dst += clip_x * 4;
+    setup->src_x = (int)(clipf >> 16);
   }
   if (clip_y) {
     int64_t clipf = (int64_t)(clip_y)*dy;
     y += (clipf & 0xffff);
-    src += (clipf >> 16) * src_stride;
-    dst += clip_y * dst_stride;
+    setup->src_y = (int)(clipf >> 16);
   }
+  setup->x = x;
+  setup->y = y;
+  setup->dx = dx;
+  setup->dy = dy;
 
   // Special case for integer step values.
   if (((dx | dy) & 0xffff) == 0) {
@@ -942,22 +979,16 @@ static void ScaleARGB(const uint8_t* src,
     } else {
       // Optimized even scale down. ie 2, 4, 6, 8, 10x.
       if (!(dx & 0x10000) && !(dy & 0x10000)) {
+        setup->filtering = filtering;
         if (dx == 0x20000) {
           // Optimized 1/2 downsample.
-          ScaleARGBDown2(src_width, src_height, clip_width, clip_height,
-                         src_stride, dst_stride, src, dst, x, dx, y, dy,
-                         filtering);
-          return;
-        }
-        if (dx == 0x40000 && filtering == kFilterBox) {
+          setup->scaler = kScaleARGBDown2;
+        } else if (dx == 0x40000 && filtering == kFilterBox) {
           // Optimized 1/4 box downsample.
-          ScaleARGBDown4Box(src_width, src_height, clip_width, clip_height,
-                            src_stride, dst_stride, src, dst, x, dx, y, dy);
-          return;
+          setup->scaler = kScaleARGBDown4Box;
+        } else {
+          setup->scaler = kScaleARGBDownEven;
         }
-        ScaleARGBDownEven(src_width, src_height, clip_width, clip_height,
-                          src_stride, dst_stride, src, dst, x, dx, y, dy,
-                          filtering);
         return;
       }
       // Optimized odd scale down. ie 3, 5, 7, 9x.
@@ -965,33 +996,130 @@ static void ScaleARGB(const uint8_t* src,
         filtering = kFilterNone;
         if (dx == 0x10000 && dy == 0x10000) {
           // Straight copy.
-          ARGBCopy(src + (y >> 16) * src_stride + (x >> 16) * 4, src_stride,
-                   dst, dst_stride, clip_width, clip_height);
+          setup->scaler = kScaleARGBCopy;
           return;
         }
       }
     }
   }
+  setup->filtering = filtering;
   if (dx == 0x10000 && (x & 0xffff) == 0) {
     // Arbitrary scale vertically, but unscaled vertically.
-    ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
-                       dst_stride, src, dst, x, y, dy, 4, filtering);
+    setup->scaler = kScaleARGBVertical;
+  } else if (filtering && dy < 65536) {
+    setup->scaler = kScaleARGBBilinearUp;
+  } else if (filtering) {
+    setup->scaler = kScaleARGBBilinearDown;
+  } else {
+    setup->scaler = kScaleARGBSimple;
+  }
+}
+
+LIBYUV_BOOL ScaleARGBSetupPolyphase(const ScaleARGBSetup* setup) {
+  return setup->scaler == kScaleARGBPolyphase;
+}
+
+void ScaleARGBSetupRun(const ScaleARGBSetup* setup,
+                       const uint8_t* src,
+                       int src_stride,
+                       uint8_t* dst,
+                       int dst_stride) {
+  const int src_width = Abs(setup->src_width);
+  const int src_height = setup->src_height;
+  const int clip_width = setup->clip_width;
+  const int clip_height = setup->clip_height;
+  const int x = setup->x;
+  const int y = setup->y;
+  const int dx = setup->dx;
+  const int dy = setup->dy;
+  const enum FilterMode filtering = setup->filtering;
+
+  if (setup->invert) {
+    src = src + (src_height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+  dst += setup->clip_y * dst_stride + setup->clip_x * 4;
+  if (setup->scaler == kScaleARGBPolyphase) {
+    ScalePolyphaseRun(&setup->polyphase, src, src_stride, dst, dst_stride,
+                      setup->clip_y, clip_height);
     return;
   }
-  if (filtering && dy < 65536) {
-    ScaleARGBBilinearUp(src_width, src_height, clip_width, clip_height,
+  src += setup->src_y * src_stride + setup->src_x * 4;
+
+  switch (setup->scaler) {
+    case kScaleARGBDown2:
+      ScaleARGBDown2(src_width, src_height, clip_width, clip_height,
+                     src_stride, dst_stride, src, dst, x, dx, y, dy,
+                     filtering);
+      return;
+    case kScaleARGBDown4Box:
+      ScaleARGBDown4Box(src_width, src_height, clip_width, clip_height,
+                        src_stride, dst_stride, src, dst, x, dx, y, dy);
+      return;
+    case kScaleARGBDownEven:
+      ScaleARGBDownEven(src_width, src_height, clip_width, clip_height,
                         src_stride, dst_stride, src, dst, x, dx, y, dy,
                         filtering);
-    return;
-  }
-  if (filtering) {
-    ScaleARGBBilinearDown(src_width, src_height, clip_width, clip_height,
+      return;
+    case kScaleARGBCopy:
+      ARGBCopy(src + (y >> 16) * src_stride + (x >> 16) * 4, src_stride, dst,
+               dst_stride, clip_width, clip_height);
+      return;
+    case kScaleARGBVertical:
+      ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
+                         dst_stride, src, dst, x, y, dy, 4, filtering);
+      return;
+    case kScaleARGBBilinearUp:
+      ScaleARGBBilinearUp(src_width, src_height, clip_width, clip_height,
                           src_stride, dst_stride, src, dst, x, dx, y, dy,
                           filtering);
+      return;
+    case kScaleARGBBilinearDown:
+      ScaleARGBBilinearDown(src_width, src_height, clip_width, clip_height,
+                            src_stride, dst_stride, src, dst, x, dx, y, dy,
+                            filtering);
+      return;
+    default:
+      ScaleARGBSimple(src_width, src_height, clip_width, clip_height,
+                      src_stride, dst_stride, src, dst, x, dx, y, dy);
+      return;
+  }
+}
+
+// ScaleARGB a ARGB.
+// This function in turn calls a scaling function
+// suitable for handling the desired resolutions.
+static void ScaleARGB(const uint8_t* src,
+                      int src_stride,
+                      int src_width,
+                      int src_height,
+                      uint8_t* dst,
+                      int dst_stride,
+                      int dst_width,
+                      int dst_height,
+                      int clip_x,
+                      int clip_y,
+                      int clip_width,
+                      int clip_height,
+                      enum FilterMode filtering) {
+  ScaleARGBSetup setup;
+  ScaleARGBSetupInit(&setup, src_width, src_height, dst_width, dst_height,
+                     clip_x, clip_y, clip_width, clip_height, filtering);
+  if (ScaleARGBSetupPolyphase(&setup)) {
+    // Only the filters of the clip rectangle are computed.
+    src_height = Abs(src_height);
+    align_buffer_64(tables,
+                    ScalePolyphaseSize(src_width, src_height, dst_width,
+                                       dst_height, clip_width, clip_height, 4,
+                                       setup.filtering));
+    ScalePolyphaseInit(&setup.polyphase, tables, src_width, src_height,
+                       dst_width, dst_height, clip_x, clip_width, clip_y,
+                       clip_height, 4, setup.filtering);
+    ScaleARGBSetupRun(&setup, src, src_stride, dst, dst_stride);
+    free_aligned_buffer_64(tables);
     return;
   }
-  ScaleARGBSimple(src_width, src_height, clip_width, clip_height, src_stride,
-                  dst_stride, src, dst, x, dx, y, dy);
+  ScaleARGBSetupRun(&setup, src, src_stride, dst, dst_stride);
 }
 
 LIBYUV_API
@@ -1036,13 +1164,111 @@ int ARGBScale(const uint8_t* src_argb,
       src_height > 32768 || !dst_argb || dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
+  LIBYUV_STATS_BEGIN(stats_start);
   ScaleARGB(src_argb, src_stride_argb, src_width, src_height, dst_argb,
             dst_stride_argb, dst_width, dst_height, 0, 0, dst_width, dst_height,
             filtering);
+  LIBYUV_STATS_END(stats_start, kStatsARGBScale,
+                   (uint64_t)dst_width * dst_height);
   return 0;
 }
 
+// Planar and biplanar YUV to ARGB conversions used by YUVToARGBScaleClip.
+typedef int (*YUVToARGBFunc)(const uint8_t* src_y,
+                             int src_stride_y,
+                             const uint8_t* src_u,
+                             int src_stride_u,
+                             const uint8_t* src_v,
+                             int src_stride_v,
+                             uint8_t* dst_argb,
+                             int dst_stride_argb,
+                             int width,
+                             int height);
+typedef int (*NVToARGBFunc)(const uint8_t* src_y,
+                            int src_stride_y,
+                            const uint8_t* src_uv,
+                            int src_stride_uv,
+                            uint8_t* dst_argb,
+                            int dst_stride_argb,
+                            int width,
+                            int height);
+
+// Rows of ARGB produced per strip by the fused scaler. A multiple of 6, so
+// every strip starts on an even row and on a row group of the 3/4 and 3/8
+// scalers in both the Y and the half height chroma planes.
+static const int kYUVScaleStripRows = 48;
+
+typedef struct {
+  YUVToARGBFunc convert;    // Planar source, or NULL.
+  NVToARGBFunc convert_nv;  // Biplanar source, or NULL.
+  const uint8_t* src_y;
+  int src_stride_y;
+  const uint8_t* src_u;
+  int src_stride_u;
+  const uint8_t* src_v;
+  int src_stride_v;
+  int src_width;
+  int src_height;
+  int src_uv_width;
+  int src_uv_height;
+  uint8_t* dst_argb;  // Row clip_y of the destination.
+  int dst_stride_argb;
+  int dst_width;
+  int dst_height;
+  int dst_uv_width;
+  int dst_uv_height;
+  int clip_y;
+  int uv_shift;  // 1 if chroma is vertically subsampled.
+  enum FilterMode filtering;
+} YUVToARGBScaleJob;
+
+// Scale destination rows [begin, end) of the clip rectangle. Each strip of
+// rows is scaled in YUV into a small buffer and then converted, so the source
+// is never converted at full size.
+static void YUVToARGBScaleRows(void* arg, int begin, int end) {
+  const YUVToARGBScaleJob* job = static_cast<const YUVToARGBScaleJob*>(arg);
+  const int dst_width = job->dst_width;
+  const int uv_width =
+      job->convert_nv ? job->dst_uv_width * 2 : job->dst_uv_width;
+  int y;
+  align_buffer_64(strip, (dst_width + uv_width * 2) * kYUVScaleStripRows);
+  uint8_t* strip_y = strip;
+  uint8_t* strip_u = strip_y + dst_width * kYUVScaleStripRows;
+  uint8_t* strip_v = strip_u + uv_width * kYUVScaleStripRows;
+
+  for (y = begin; y < end; y += kYUVScaleStripRows) {
+    int rows = end - y < kYUVScaleStripRows ? end - y : kYUVScaleStripRows;
+    int band_y = job->clip_y + y;
+    int uv_band_y = band_y >> job->uv_shift;
+    int uv_rows = ((band_y + rows - 1) >> job->uv_shift) - uv_band_y + 1;
+    uint8_t* dst_argb = job->dst_argb + y * (intptr_t)job->dst_stride_argb;
+    ScalePlaneBand(job->src_y, job->src_stride_y, job->src_width,
+                   job->src_height, strip_y, dst_width, dst_width,
+                   job->dst_height, band_y, rows, job->filtering);
+    if (job->convert_nv) {
+      ScaleUVBand(job->src_u, job->src_stride_u, job->src_uv_width,
+                  job->src_uv_height, strip_u, uv_width, job->dst_uv_width,
+                  job->dst_uv_height, uv_band_y, uv_rows, job->filtering);
+      job->convert_nv(strip_y, dst_width, strip_u, uv_width, dst_argb,
+                      job->dst_stride_argb, dst_width, rows);
+    } else {
+      ScalePlaneBand(job->src_u, job->src_stride_u, job->src_uv_width,
+                     job->src_uv_height, strip_u, uv_width, uv_width,
+                     job->dst_uv_height, uv_band_y, uv_rows, job->filtering);
+      ScalePlaneBand(job->src_v, job->src_stride_v, job->src_uv_width,
+                     job->src_uv_height, strip_v, uv_width, uv_width,
+                     job->dst_uv_height, uv_band_y, uv_rows, job->filtering);
+      job->convert(strip_y, dst_width, strip_u, uv_width, strip_v, uv_width,
+                   dst_argb, job->dst_stride_argb, dst_width, rows);
+    }
+  }
+  free_aligned_buffer_64(strip);
+}
+
 // Scale with YUV conversion to ARGB and clipping.
+// When the clip rectangle spans the full destination width, the Y and chroma
+// planes are scaled a strip at a time and only destination rows are
+// converted. Otherwise the source is converted to ARGB and then scaled.
 LIBYUV_API
 int YUVToARGBScaleClip(const uint8_t* src_y,
                        int src_stride_y,
@@ -1063,18 +1289,79 @@ int YUVToARGBScaleClip(const uint8_t* src_y,
                        int clip_width,
                        int clip_height,
                        enum FilterMode filtering) {
-  uint8_t* argb_buffer = (uint8_t*)malloc(src_width * src_height * 4);
+  const int abgr = CanonicalFourCC(dst_fourcc) == FOURCC_ABGR;
+  YUVToARGBScaleJob job;
   int r;
-  (void)src_fourcc;  // TODO(fbarchard): implement and/or assert.
-  (void)dst_fourcc;
-  I420ToARGB(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-             argb_buffer, src_width * 4, src_width, src_height);
+  if (!src_y || !src_u || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_argb || dst_width <= 0 ||
+      dst_height <= 0 || clip_x < 0 || clip_y < 0 || clip_width > 32768 ||
+      clip_height > 32768 || (clip_x + clip_width) > dst_width ||
+      (clip_y + clip_height) > dst_height) {
+    return -1;
+  }
+  memset(&job, 0, sizeof(job));
+  job.uv_shift = 1;
+  switch (CanonicalFourCC(src_fourcc)) {
+    case FOURCC_NV12:
+      job.convert_nv = abgr ? NV12ToABGR : NV12ToARGB;
+      break;
+    case FOURCC_NV21:
+      job.convert_nv = abgr ? NV21ToABGR : NV21ToARGB;
+      break;
+    case FOURCC_I444:
+      job.convert = abgr ? I444ToABGR : I444ToARGB;
+      job.uv_shift = 0;
+      break;
+    default:
+      job.convert = abgr ? I420ToABGR : I420ToARGB;
+      break;
+  }
+  if (job.convert && !src_v) {
+    return -1;
+  }
+
+  if (clip_x != 0 || clip_width != dst_width || clip_y % 6 != 0) {
+    uint8_t* argb_buffer =
+        (uint8_t*)ScratchAlloc(Abs(src_width) * Abs(src_height) * 4);
+    if (job.convert_nv) {
+      job.convert_nv(src_y, src_stride_y, src_u, src_stride_u, argb_buffer,
+                     Abs(src_width) * 4, Abs(src_width), src_height);
+    } else {
+      job.convert(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                  src_stride_v, argb_buffer, Abs(src_width) * 4,
+                  Abs(src_width), src_height);
+    }
+    r = ARGBScaleClip(argb_buffer, Abs(src_width) * 4, src_width,
+                      Abs(src_height), dst_argb, dst_stride_argb, dst_width,
+                      dst_height, clip_x, clip_y, clip_width, clip_height,
+                      filtering);
+    ScratchFree(argb_buffer);
+    return r;
+  }
 
-  r = ARGBScaleClip(argb_buffer, src_width * 4, src_width, src_height, dst_argb,
-                    dst_stride_argb, dst_width, dst_height, clip_x, clip_y,
-                    clip_width, clip_height, filtering);
-  free(argb_buffer);
-  return r;
+  job.src_y = src_y;
+  job.src_stride_y = src_stride_y;
+  job.src_u = src_u;
+  job.src_stride_u = src_stride_u;
+  job.src_v = src_v;
+  job.src_stride_v = src_stride_v;
+  job.src_width = src_width;
+  job.src_height = src_height;
+  job.src_uv_width = job.uv_shift ? SUBSAMPLE(src_width, 1, 1) : src_width;
+  job.src_uv_height = job.uv_shift ? SUBSAMPLE(src_height, 1, 1) : src_height;
+  job.dst_argb = dst_argb + clip_y * dst_stride_argb;
+  job.dst_stride_argb = dst_stride_argb;
+  job.dst_width = dst_width;
+  job.dst_height = dst_height;
+  job.dst_uv_width = job.uv_shift ? SUBSAMPLE(dst_width, 1, 1) : dst_width;
+  job.dst_uv_height = job.uv_shift ? SUBSAMPLE(dst_height, 1, 1) : dst_height;
+  job.clip_y = clip_y;
+  job.filtering = filtering;
+  if (ParallelRows(dst_width, clip_height, kYUVScaleStripRows,
+                   YUVToARGBScaleRows, &job) != 0) {
+    YUVToARGBScaleRows(&job, 0, clip_height);
+  }
+  return 0;
 }
 
 #ifdef __cplusplus
@@ -11,6 +11,7 @@
 #include "libyuv/scale.h"
 
 #include <assert.h>
+#include <math.h>
 #include <string.h>
 
 #include "libyuv/cpu_id.h"
@@ -776,6 +777,108 @@ void ScaleAddRow_16_C(const uint16_t* src_ptr,
   }
 }
 
+static __inline int32_t clamp255(int32_t v) {
+  return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+static __inline int64_t clamp65535(int64_t v) {
+  return v < 0 ? 0 : (v > 65535 ? 65535 : v);
+}
+
+// Polyphase filter weights are 2.14 fixed point.
+void ScalePolyphaseRows_C(const uint8_t* src_ptr,
+                          ptrdiff_t src_stride,
+                          const int16_t* filter,
+                          int filter_taps,
+                          uint8_t* dst_ptr,
+                          int dst_width) {
+  int x, i;
+  for (x = 0; x < dst_width; ++x) {
+    const uint8_t* src = src_ptr + x;
+    int32_t sum = 1 << 13;
+    for (i = 0; i < filter_taps; ++i) {
+      sum += src[0] * filter[i];
+      src += src_stride;
+    }
+    dst_ptr[x] = (uint8_t)clamp255(sum >> 14);
+  }
+}
+
+void ScalePolyphaseRows_16_C(const uint16_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint16_t* dst_ptr,
+                             int dst_width) {
+  int x, i;
+  for (x = 0; x < dst_width; ++x) {
+    const uint16_t* src = src_ptr + x;
+    int64_t sum = 1 << 13;
+    for (i = 0; i < filter_taps; ++i) {
+      sum += src[0] * filter[i];
+      src += src_stride;
+    }
+    dst_ptr[x] = (uint16_t)clamp65535(sum >> 14);
+  }
+}
+
+void ScalePolyphaseCols_C(uint8_t* dst_ptr,
+                          const uint8_t* src_ptr,
+                          int dst_width,
+                          const int* offsets,
+                          const int16_t* filter,
+                          int filter_taps) {
+  int x, i;
+  for (x = 0; x < dst_width; ++x) {
+    const uint8_t* src = src_ptr + offsets[x];
+    int32_t sum = 1 << 13;
+    for (i = 0; i < filter_taps; ++i) {
+      sum += src[i] * filter[i];
+    }
+    dst_ptr[x] = (uint8_t)clamp255(sum >> 14);
+    filter += filter_taps;
+  }
+}
+
+void ScalePolyphaseCols_16_C(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             const int* offsets,
+                             const int16_t* filter,
+                             int filter_taps) {
+  int x, i;
+  for (x = 0; x < dst_width; ++x) {
+    const uint16_t* src = src_ptr + offsets[x];
+    int64_t sum = 1 << 13;
+    for (i = 0; i < filter_taps; ++i) {
+      sum += src[i] * filter[i];
+    }
+    dst_ptr[x] = (uint16_t)clamp65535(sum >> 14);
+    filter += filter_taps;
+  }
+}
+
+void ScaleARGBPolyphaseCols_C(uint8_t* dst_argb,
+                              const uint8_t* src_argb,
+                              int dst_width,
+                              const int* offsets,
+                              const int16_t* filter,
+                              int filter_taps) {
+  int x, i, c;
+  for (x = 0; x < dst_width; ++x) {
+    const uint8_t* src = src_argb + offsets[x] * 4;
+    for (c = 0; c < 4; ++c) {
+      int32_t sum = 1 << 13;
+      for (i = 0; i < filter_taps; ++i) {
+        sum += src[i * 4 + c] * filter[i];
+      }
+      dst_argb[c] = (uint8_t)clamp255(sum >> 14);
+    }
+    dst_argb += 4;
+    filter += filter_taps;
+  }
+}
+
 void ScaleARGBRowDown2_C(const uint8_t* src_argb,
                          ptrdiff_t src_stride,
                          uint8_t* dst_argb,
@@ -1018,6 +1121,325 @@ void ScaleARGBFilterCols64_C(uint8_t* dst_argb,
 #undef BLENDERC
 #undef BLENDER
 
+// UV scalers treat an interleaved UV pair as one uint16_t pixel, the way the
+// ARGB scalers treat an ARGB pixel as a uint32_t.
+void ScaleUVRowDown2_C(const uint8_t* src_uv,
+                       ptrdiff_t src_stride,
+                       uint8_t* dst_uv,
+                       int dst_width) {
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  int x;
+  (void)src_stride;
+  for (x = 0; x < dst_width - 1; x += 2) {
+    dst[0] = src[1];
+    dst[1] = src[3];
+    src += 4;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    dst[0] = src[1];
+  }
+}
+
+void ScaleUVRowDown2Linear_C(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_uv,
+                             int dst_width) {
+  int x;
+  (void)src_stride;
+  for (x = 0; x < dst_width; ++x) {
+    dst_uv[0] = (src_uv[0] + src_uv[2] + 1) >> 1;
+    dst_uv[1] = (src_uv[1] + src_uv[3] + 1) >> 1;
+    src_uv += 4;
+    dst_uv += 2;
+  }
+}
+
+void ScaleUVRowDown2Box_C(const uint8_t* src_uv,
+                          ptrdiff_t src_stride,
+                          uint8_t* dst_uv,
+                          int dst_width) {
+  int x;
+  for (x = 0; x < dst_width; ++x) {
+    dst_uv[0] = (src_uv[0] + src_uv[2] + src_uv[src_stride] +
+                 src_uv[src_stride + 2] + 2) >>
+                2;
+    dst_uv[1] = (src_uv[1] + src_uv[3] + src_uv[src_stride + 1] +
+                 src_uv[src_stride + 3] + 2) >>
+                2;
+    src_uv += 4;
+    dst_uv += 2;
+  }
+}
+
+void ScaleUVRowDownEven_C(const uint8_t* src_uv,
+                          ptrdiff_t src_stride,
+                          int src_stepx,
+                          uint8_t* dst_uv,
+                          int dst_width) {
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  (void)src_stride;
+  int x;
+  for (x = 0; x < dst_width - 1; x += 2) {
+    dst[0] = src[0];
+    dst[1] = src[src_stepx];
+    src += src_stepx * 2;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    dst[0] = src[0];
+  }
+}
+
+void ScaleUVRowDownEvenBox_C(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             int src_stepx,
+                             uint8_t* dst_uv,
+                             int dst_width) {
+  int x;
+  for (x = 0; x < dst_width; ++x) {
+    dst_uv[0] = (src_uv[0] + src_uv[2] + src_uv[src_stride] +
+                 src_uv[src_stride + 2] + 2) >>
+                2;
+    dst_uv[1] = (src_uv[1] + src_uv[3] + src_uv[src_stride + 1] +
+                 src_uv[src_stride + 3] + 2) >>
+                2;
+    src_uv += src_stepx * 2;
+    dst_uv += 2;
+  }
+}
+
+// Scales a single row of UV pixels using point sampling.
+void ScaleUVCols_C(uint8_t* dst_uv,
+                   const uint8_t* src_uv,
+                   int dst_width,
+                   int x,
+                   int dx) {
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  int j;
+  for (j = 0; j < dst_width - 1; j += 2) {
+    dst[0] = src[x >> 16];
+    x += dx;
+    dst[1] = src[x >> 16];
+    x += dx;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    dst[0] = src[x >> 16];
+  }
+}
+
+void ScaleUVCols64_C(uint8_t* dst_uv,
+                     const uint8_t* src_uv,
+                     int dst_width,
+                     int x32,
+                     int dx) {
+  int64_t x = (int64_t)(x32);
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  int j;
+  for (j = 0; j < dst_width - 1; j += 2) {
+    dst[0] = src[x >> 16];
+    x += dx;
+    dst[1] = src[x >> 16];
+    x += dx;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    dst[0] = src[x >> 16];
+  }
+}
+
+// Scales a single row of UV pixels up by 2x using point sampling.
+void ScaleUVColsUp2_C(uint8_t* dst_uv,
+                      const uint8_t* src_uv,
+                      int dst_width,
+                      int x,
+                      int dx) {
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  int j;
+  (void)x;
+  (void)dx;
+  for (j = 0; j < dst_width - 1; j += 2) {
+    dst[1] = dst[0] = src[0];
+    src += 1;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    dst[0] = src[0];
+  }
+}
+
+// Mimics SSSE3 blender, as the ARGB blender does.
+#define BLENDER1(a, b, f) ((a) * (0x7f ^ f) + (b)*f) >> 7
+#define BLENDERC(a, b, f, s) \
+  (uint16_t)(BLENDER1(((a) >> s) & 255, ((b) >> s) & 255, f) << s)
+#define BLENDER(a, b, f) (uint16_t)(BLENDERC(a, b, f, 8) | BLENDERC(a, b, f, 0))
+
+void ScaleUVFilterCols_C(uint8_t* dst_uv,
+                         const uint8_t* src_uv,
+                         int dst_width,
+                         int x,
+                         int dx) {
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  int j;
+  for (j = 0; j < dst_width - 1; j += 2) {
+    int xi = x >> 16;
+    int xf = (x >> 9) & 0x7f;
+    uint16_t a = src[xi];
+    uint16_t b = src[xi + 1];
+    dst[0] = BLENDER(a, b, xf);
+    x += dx;
+    xi = x >> 16;
+    xf = (x >> 9) & 0x7f;
+    a = src[xi];
+    b = src[xi + 1];
+    dst[1] = BLENDER(a, b, xf);
+    x += dx;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    int xi = x >> 16;
+    int xf = (x >> 9) & 0x7f;
+    uint16_t a = src[xi];
+    uint16_t b = src[xi + 1];
+    dst[0] = BLENDER(a, b, xf);
+  }
+}
+
+void ScaleUVFilterCols64_C(uint8_t* dst_uv,
+                           const uint8_t* src_uv,
+                           int dst_width,
+                           int x32,
+                           int dx) {
+  int64_t x = (int64_t)(x32);
+  const uint16_t* src = (const uint16_t*)(src_uv);
+  uint16_t* dst = (uint16_t*)(dst_uv);
+  int j;
+  for (j = 0; j < dst_width - 1; j += 2) {
+    int64_t xi = x >> 16;
+    int xf = (x >> 9) & 0x7f;
+    uint16_t a = src[xi];
+    uint16_t b = src[xi + 1];
+    dst[0] = BLENDER(a, b, xf);
+    x += dx;
+    xi = x >> 16;
+    xf = (x >> 9) & 0x7f;
+    a = src[xi];
+    b = src[xi + 1];
+    dst[1] = BLENDER(a, b, xf);
+    x += dx;
+    dst += 2;
+  }
+  if (dst_width & 1) {
+    int64_t xi = x >> 16;
+    int xf = (x >> 9) & 0x7f;
+    uint16_t a = src[xi];
+    uint16_t b = src[xi + 1];
+    dst[0] = BLENDER(a, b, xf);
+  }
+}
+#undef BLENDER1
+#undef BLENDERC
+#undef BLENDER
+
+// 16 bit UV pairs are 4 bytes, so point sampling uses the ARGB scalers.
+void ScaleUVRowDown2Linear_16_C(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                uint16_t* dst_uv,
+                                int dst_width) {
+  int x;
+  (void)src_stride;
+  for (x = 0; x < dst_width; ++x) {
+    dst_uv[0] = (src_uv[0] + src_uv[2] + 1) >> 1;
+    dst_uv[1] = (src_uv[1] + src_uv[3] + 1) >> 1;
+    src_uv += 4;
+    dst_uv += 2;
+  }
+}
+
+void ScaleUVRowDown2Box_16_C(const uint16_t* src_uv,
+                             ptrdiff_t src_stride,
+                             uint16_t* dst_uv,
+                             int dst_width) {
+  int x;
+  for (x = 0; x < dst_width; ++x) {
+    dst_uv[0] = (src_uv[0] + src_uv[2] + src_uv[src_stride] +
+                 src_uv[src_stride + 2] + 2) >>
+                2;
+    dst_uv[1] = (src_uv[1] + src_uv[3] + src_uv[src_stride + 1] +
+                 src_uv[src_stride + 3] + 2) >>
+                2;
+    src_uv += 4;
+    dst_uv += 2;
+  }
+}
+
+void ScaleUVRowDownEvenBox_16_C(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                int src_stepx,
+                                uint16_t* dst_uv,
+                                int dst_width) {
+  int x;
+  for (x = 0; x < dst_width; ++x) {
+    dst_uv[0] = (src_uv[0] + src_uv[2] + src_uv[src_stride] +
+                 src_uv[src_stride + 2] + 2) >>
+                2;
+    dst_uv[1] = (src_uv[1] + src_uv[3] + src_uv[src_stride + 1] +
+                 src_uv[src_stride + 3] + 2) >>
+                2;
+    src_uv += src_stepx * 2;
+    dst_uv += 2;
+  }
+}
+
+// Same blender as ScaleFilterCols_16_C.
+#define BLENDER(a, b, f) \
+  (uint16_t)(            \
+      (int)(a) +         \
+      (int)((((int64_t)((f)) * ((int64_t)(b) - (int)(a))) + 0x8000) >> 16))
+
+void ScaleUVFilterCols_16_C(uint16_t* dst_uv,
+                            const uint16_t* src_uv,
+                            int dst_width,
+                            int x,
+                            int dx) {
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    int xi = x >> 16;
+    int xf = x & 0xffff;
+    const uint16_t* a = src_uv + xi * 2;
+    dst_uv[0] = BLENDER(a[0], a[2], xf);
+    dst_uv[1] = BLENDER(a[1], a[3], xf);
+    x += dx;
+    dst_uv += 2;
+  }
+}
+
+void ScaleUVFilterCols64_16_C(uint16_t* dst_uv,
+                              const uint16_t* src_uv,
+                              int dst_width,
+                              int x32,
+                              int dx) {
+  int64_t x = (int64_t)(x32);
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    int64_t xi = x >> 16;
+    int xf = (int)(x & 0xffff);
+    const uint16_t* a = src_uv + xi * 2;
+    dst_uv[0] = BLENDER(a[0], a[2], xf);
+    dst_uv[1] = BLENDER(a[1], a[3], xf);
+    x += dx;
+    dst_uv += 2;
+  }
+}
+#undef BLENDER
+
 // Scale plane vertically with bilinear interpolation.
 void ScalePlaneVertical(int src_height,
                         int dst_width,
@@ -1124,7 +1546,7 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    if (IS_ALIGNED(dst_width_words, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
@@ -1132,7 +1554,7 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_16_SSSE3;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
     }
   }
@@ -1140,15 +1562,23 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(dst_width_bytes, 32)) {
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
 #endif
+#if defined(HAS_INTERPOLATEROW_16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    InterpolateRow = InterpolateRow_Any_16_AVX512BW;
+    if (IS_ALIGNED(dst_width_words, 32)) {
+      InterpolateRow = InterpolateRow_16_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     InterpolateRow = InterpolateRow_Any_16_NEON;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_NEON;
     }
   }
@@ -1180,6 +1610,10 @@ enum FilterMode ScaleFilterReduce(int src_width,
   if (src_height < 0) {
     src_height = -src_height;
   }
+  // Scalers without a polyphase filter use box filtering instead.
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    filtering = kFilterBox;
+  }
   if (filtering == kFilterBox) {
     // If scaling both axis to 0.5 or larger, switch from Box to Bilinear.
     if (dst_width * 2 >= src_width && dst_height * 2 >= src_height) {
@@ -1212,6 +1646,291 @@ enum FilterMode ScaleFilterReduce(int src_width,
   return filtering;
 }
 
+// Catmull-Rom cubic convolution, which is 0 at all integers other than 0.
+static double BicubicWeight(double x) {
+  x = fabs(x);
+  if (x < 1.0) {
+    return (1.5 * x - 2.5) * x * x + 1.0;
+  }
+  if (x < 2.0) {
+    return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+  }
+  return 0.0;
+}
+
+// Windowed sinc with 3 lobes.
+static double LanczosWeight(double x) {
+  const double kPi = 3.14159265358979323846;
+  x = fabs(x);
+  if (x < 1e-8) {
+    return 1.0;
+  }
+  if (x >= 3.0) {
+    return 0.0;
+  }
+  x *= kPi;
+  return 3.0 * sin(x) * sin(x / 3.0) / (x * x);
+}
+
+static int GreatestCommonDivisor(int a, int b) {
+  while (b) {
+    int t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// Half width of the filter kernel in source pixels. Scaling down stretches the
+// kernel by the scale factor so every source pixel contributes.
+static double ScalePolyphaseSupport(int src_size,
+                                    int dst_size,
+                                    enum FilterMode filtering) {
+  double scale = (double)(src_size) / dst_size;
+  double radius = filtering == kFilterLanczos ? 3.0 : 2.0;
+  return radius * (scale > 1.0 ? scale : 1.0);
+}
+
+int ScalePolyphaseTaps(int src_size,
+                       int dst_size,
+                       enum FilterMode filtering) {
+  int taps;
+  src_size = Abs(src_size);
+  if (src_size == dst_size) {
+    return 1;
+  }
+  taps = (int)(ceil(2.0 * ScalePolyphaseSupport(src_size, dst_size,
+                                                filtering)));
+  return taps < src_size ? taps : src_size;
+}
+
+// The filter of a destination pixel is the kernel centered on its position in
+// the source, with the weights of pixels past either edge folded onto the edge
+// pixel. Destination pixels dst_size / gcd apart are at the same phase, so
+// away from the edges their weights are copied instead of evaluated again.
+void ScalePolyphaseCoeffs(int src_size,
+                          int dst_size,
+                          int dst_begin,
+                          int dst_count,
+                          enum FilterMode filtering,
+                          int taps,
+                          int filter_taps,
+                          int* offsets,
+                          int16_t* coeffs) {
+  const int mirror = src_size < 0;
+  const double scale = (double)(Abs(src_size)) / dst_size;
+  const double filter_scale = scale > 1.0 ? scale : 1.0;
+  double support;
+  int period, period_step, window;
+  int i, j, k;
+  align_buffer_64(weights_mem, taps * sizeof(double));
+  double* weights = (double*)(weights_mem);
+  src_size = Abs(src_size);
+  assert(taps > 0 && taps <= src_size);
+  assert(filter_taps >= taps);
+  support = ScalePolyphaseSupport(src_size, dst_size, filtering);
+  period = dst_size / GreatestCommonDivisor(src_size, dst_size);
+  period_step = src_size / GreatestCommonDivisor(src_size, dst_size);
+  window = (int)(ceil(2.0 * support));
+
+  for (i = 0; i < dst_count; ++i) {
+    const int dst = dst_begin + i;
+    const double center = (dst + 0.5) * scale - 0.5;
+    const int left = (int)(floor(center - support)) + 1;
+    const int start = left < 0 ? 0 : (left > src_size - taps ? src_size - taps
+                                                              : left);
+    int16_t* coeff = coeffs + i * filter_taps;
+    if (src_size == dst_size) {
+      offsets[i] = mirror ? src_size - 1 - dst : dst;
+      memset(coeff, 0, filter_taps * sizeof(int16_t));
+      coeff[0] = 1 << 14;
+      continue;
+    }
+    if (i >= period && !mirror && window == taps && left >= 0 &&
+        left + taps <= src_size) {
+      // Interior pixels share the weights of the previous period.
+      const int prev_left =
+          (int)(floor((dst - period + 0.5) * scale - 0.5 - support)) + 1;
+      if (prev_left >= 0 && prev_left + taps <= src_size) {
+        offsets[i] = offsets[i - period] + period_step;
+        memcpy(coeff, coeff - period * filter_taps,
+               filter_taps * sizeof(int16_t));
+        continue;
+      }
+    }
+    {
+      double sum = 0.0;
+      int total = 0;
+      int biggest = 0;
+      memset(weights, 0, taps * sizeof(double));
+      for (j = left; j < center + support; ++j) {
+        const double x = (j - center) / filter_scale;
+        const double w =
+            filtering == kFilterLanczos ? LanczosWeight(x) : BicubicWeight(x);
+        k = (j < 0 ? 0 : (j >= src_size ? src_size - 1 : j)) - start;
+        if (k >= 0 && k < taps) {
+          weights[k] += w;
+          sum += w;
+        }
+      }
+      for (k = 0; k < taps; ++k) {
+        int c = (int)(floor(weights[k] / sum * (1 << 14) + 0.5));
+        coeff[k] = (int16_t)(c);
+        total += c;
+        if (c > coeff[biggest]) {
+          biggest = k;
+        }
+      }
+      // Weights sum to exactly 1.0 so flat areas are unchanged.
+      coeff[biggest] += (int16_t)((1 << 14) - total);
+      for (k = taps; k < filter_taps; ++k) {
+        coeff[k] = 0;
+      }
+      offsets[i] = start;
+    }
+    if (mirror) {
+      for (k = 0; k < taps / 2; ++k) {
+        int16_t t = coeff[k];
+        coeff[k] = coeff[taps - 1 - k];
+        coeff[taps - 1 - k] = t;
+      }
+      offsets[i] = src_size - taps - offsets[i];
+    }
+  }
+  free_aligned_buffer_64(weights_mem);
+}
+
+// Plane columns are filtered 8 taps at a time, ARGB columns and rows 2 at a
+// time.
+static int ScalePolyphaseFilterTapsX(int taps, int bpp) {
+  return bpp == 1 ? (taps + 7) & ~7 : (taps + 1) & ~1;
+}
+
+static int ScalePolyphaseFilterTapsY(int taps) {
+  return (taps + 1) & ~1;
+}
+
+size_t ScalePolyphaseSize(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          int count_x,
+                          int count_y,
+                          int bpp,
+                          enum FilterMode filtering) {
+  const int filter_x_taps = ScalePolyphaseFilterTapsX(
+      ScalePolyphaseTaps(src_width, dst_width, filtering), bpp);
+  const int filter_y_taps = ScalePolyphaseFilterTapsY(
+      ScalePolyphaseTaps(src_height, dst_height, filtering));
+  return (size_t)(count_x) * (filter_x_taps * sizeof(int16_t) + sizeof(int)) +
+         (size_t)(count_y) * (filter_y_taps * sizeof(int16_t) + sizeof(int));
+}
+
+void ScalePolyphaseInit(ScalePolyphase* polyphase,
+                        uint8_t* mem,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        int begin_x,
+                        int count_x,
+                        int begin_y,
+                        int count_y,
+                        int bpp,
+                        enum FilterMode filtering) {
+  const int taps_x = ScalePolyphaseTaps(src_width, dst_width, filtering);
+  const int taps_y = ScalePolyphaseTaps(src_height, dst_height, filtering);
+  const int filter_x_taps = ScalePolyphaseFilterTapsX(taps_x, bpp);
+  const int filter_y_taps = ScalePolyphaseFilterTapsY(taps_y);
+  const int row_bytes = Abs(src_width) * bpp;
+  assert(bpp == 1 || bpp == 4);
+  // The column filters come first so their rows stay 16 byte aligned.
+  polyphase->filter_x = (int16_t*)(mem);
+  mem += count_x * filter_x_taps * sizeof(int16_t);
+  polyphase->filter_y = (int16_t*)(mem);
+  mem += count_y * filter_y_taps * sizeof(int16_t);
+  polyphase->offsets_x = (int*)(mem);
+  mem += count_x * sizeof(int);
+  polyphase->offsets_y = (int*)(mem);
+  ScalePolyphaseCoeffs(src_width, dst_width, begin_x, count_x, filtering,
+                       taps_x, filter_x_taps, polyphase->offsets_x,
+                       polyphase->filter_x);
+  ScalePolyphaseCoeffs(src_height, dst_height, begin_y, count_y, filtering,
+                       taps_y, filter_y_taps, polyphase->offsets_y,
+                       polyphase->filter_y);
+  polyphase->src_width = Abs(src_width);
+  polyphase->bpp = bpp;
+  polyphase->count_x = count_x;
+  polyphase->begin_y = begin_y;
+  polyphase->taps_y = taps_y;
+  polyphase->filter_x_taps = filter_x_taps;
+  polyphase->filter_y_taps = filter_y_taps;
+
+  polyphase->ScalePolyphaseRows = ScalePolyphaseRows_C;
+  polyphase->ScalePolyphaseCols =
+      bpp == 1 ? ScalePolyphaseCols_C : ScaleARGBPolyphaseCols_C;
+#if defined(HAS_SCALEPOLYPHASEROWS_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    polyphase->ScalePolyphaseRows = ScalePolyphaseRows_Any_SSE2;
+    if (IS_ALIGNED(row_bytes, 16)) {
+      polyphase->ScalePolyphaseRows = ScalePolyphaseRows_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEPOLYPHASEROWS_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    polyphase->ScalePolyphaseRows = ScalePolyphaseRows_Any_AVX2;
+    if (IS_ALIGNED(row_bytes, 32)) {
+      polyphase->ScalePolyphaseRows = ScalePolyphaseRows_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEPOLYPHASECOLS_SSSE3)
+  if (bpp == 1 && TestCpuFlag(kCpuHasSSSE3)) {
+    polyphase->ScalePolyphaseCols = ScalePolyphaseCols_Any_SSSE3;
+    if (IS_ALIGNED(count_x, 4)) {
+      polyphase->ScalePolyphaseCols = ScalePolyphaseCols_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBPOLYPHASECOLS_SSSE3)
+  if (bpp == 4 && TestCpuFlag(kCpuHasSSSE3)) {
+    polyphase->ScalePolyphaseCols = ScaleARGBPolyphaseCols_SSSE3;
+  }
+#endif
+  (void)row_bytes;
+}
+
+// Each destination row is filtered vertically from a window of source rows
+// into a row buffer, and then filtered horizontally.
+void ScalePolyphaseRun(const ScalePolyphase* polyphase,
+                       const uint8_t* src_ptr,
+                       int src_stride,
+                       uint8_t* dst_ptr,
+                       int dst_stride,
+                       int y,
+                       int height) {
+  const int row_bytes = polyphase->src_width * polyphase->bpp;
+  const int* offsets_y = polyphase->offsets_y + (y - polyphase->begin_y);
+  const int16_t* filter_y =
+      polyphase->filter_y + (y - polyphase->begin_y) * polyphase->filter_y_taps;
+  int j;
+  // The row is padded for the zero weighted taps past the last pixel.
+  align_buffer_64(row, row_bytes + 8);
+  memset(row + row_bytes, 0, 8);
+  for (j = 0; j < height; ++j) {
+    polyphase->ScalePolyphaseRows(
+        src_ptr + offsets_y[j] * (intptr_t)(src_stride), src_stride,
+        filter_y + j * polyphase->filter_y_taps, polyphase->taps_y, row,
+        row_bytes);
+    polyphase->ScalePolyphaseCols(dst_ptr, row, polyphase->count_x,
+                                  polyphase->offsets_x, polyphase->filter_x,
+                                  polyphase->filter_x_taps);
+    dst_ptr += dst_stride;
+  }
+  free_aligned_buffer_64(row);
+}
+
 // Divide num by div and return as 16.16 fixed point result.
 int FixedDiv_C(int num, int div) {
   return (int)(((int64_t)(num) << 16) / div);
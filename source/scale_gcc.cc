@@ -295,6 +295,119 @@ void ScaleRowDown2Box_AVX2(const uint8_t* src_ptr,
 }
 #endif  // HAS_SCALEROWDOWN2_AVX2
 
+#ifdef HAS_SCALEROWDOWN2_AVX512BW
+// vpermq for vpackuswb.
+static const uint64_t kPermqPack_AVX512[8] = {0, 2, 4, 6, 1, 3, 5, 7};
+
+void ScaleRowDown2_AVX512BW(const uint8_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            uint8_t* dst_ptr,
+                            int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vmovdqu64  %3,%%zmm5                      \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpsrlw     $0x8,%%zmm0,%%zmm0             \n"
+      "vpsrlw     $0x8,%%zmm1,%%zmm1             \n"
+      "vpackuswb  %%zmm1,%%zmm0,%%zmm0           \n"
+      "vpermq     %%zmm0,%%zmm5,%%zmm0           \n"
+      "vmovdqu64  %%zmm0,(%1)                    \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x40,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),          // %0
+        "+r"(dst_ptr),          // %1
+        "+r"(dst_width)         // %2
+      : "m"(kPermqPack_AVX512)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm5");
+}
+
+void ScaleRowDown2Linear_AVX512BW(const uint8_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint8_t* dst_ptr,
+                                  int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+      "vpsrlw     $0xf,%%zmm4,%%zmm4             \n"
+      "vpackuswb  %%zmm4,%%zmm4,%%zmm4           \n"
+      "vpxord     %%zmm5,%%zmm5,%%zmm5           \n"
+      "vmovdqu64  %3,%%zmm6                      \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpmaddubsw %%zmm4,%%zmm0,%%zmm0           \n"
+      "vpmaddubsw %%zmm4,%%zmm1,%%zmm1           \n"
+      "vpavgw     %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpavgw     %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpackuswb  %%zmm1,%%zmm0,%%zmm0           \n"
+      "vpermq     %%zmm0,%%zmm6,%%zmm0           \n"
+      "vmovdqu64  %%zmm0,(%1)                    \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x40,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),          // %0
+        "+r"(dst_ptr),          // %1
+        "+r"(dst_width)         // %2
+      : "m"(kPermqPack_AVX512)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5", "xmm6");
+}
+
+void ScaleRowDown2Box_AVX512BW(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width) {
+  asm volatile(
+      "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+      "vpsrlw     $0xf,%%zmm4,%%zmm4             \n"
+      "vpackuswb  %%zmm4,%%zmm4,%%zmm4           \n"
+      "vpxord     %%zmm5,%%zmm5,%%zmm5           \n"
+      "vmovdqu64  %4,%%zmm6                      \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "vmovdqu64  0x00(%0,%3,1),%%zmm2           \n"
+      "vmovdqu64  0x40(%0,%3,1),%%zmm3           \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpmaddubsw %%zmm4,%%zmm0,%%zmm0           \n"
+      "vpmaddubsw %%zmm4,%%zmm1,%%zmm1           \n"
+      "vpmaddubsw %%zmm4,%%zmm2,%%zmm2           \n"
+      "vpmaddubsw %%zmm4,%%zmm3,%%zmm3           \n"
+      "vpaddw     %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpaddw     %%zmm3,%%zmm1,%%zmm1           \n"
+      "vpsrlw     $0x1,%%zmm0,%%zmm0             \n"
+      "vpsrlw     $0x1,%%zmm1,%%zmm1             \n"
+      "vpavgw     %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpavgw     %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpackuswb  %%zmm1,%%zmm0,%%zmm0           \n"
+      "vpermq     %%zmm0,%%zmm6,%%zmm0           \n"
+      "vmovdqu64  %%zmm0,(%1)                    \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x40,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kPermqPack_AVX512)        // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEROWDOWN2_AVX512BW
+
 void ScaleRowDown4_SSSE3(const uint8_t* src_ptr,
                          ptrdiff_t src_stride,
                          uint8_t* dst_ptr,
@@ -1366,6 +1479,2563 @@ int FixedDiv1_X86(int num, int div) {
   return num;
 }
 
+#ifdef HAS_SCALEROWDOWN2_16_SSE2
+void ScaleRowDown2_16_SSE2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "psrad     $0x10,%%xmm0                    \n"
+      "psrad     $0x10,%%xmm1                    \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1");
+}
+
+// 16 bit pixels are biased by 0x8000 to make them signed so pmaddwd can sum
+// pairs. The bias divides evenly by the box size, so after the shift the
+// result only needs the bias removed again.
+void ScaleRowDown2Linear_16_SSE2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst_ptr,
+                                 int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"
+      "psllw     $0xf,%%xmm4                     \n"  // 0x8000
+      "pcmpeqb   %%xmm5,%%xmm5                   \n"
+      "psrlw     $0xf,%%xmm5                     \n"  // 0x00010001
+      "movdqa    %%xmm5,%%xmm3                   \n"
+      "psrld     $0x10,%%xmm3                    \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm1                   \n"
+      "pmaddwd   %%xmm5,%%xmm0                   \n"
+      "pmaddwd   %%xmm5,%%xmm1                   \n"
+      "paddd     %%xmm3,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm1                   \n"
+      "psrad     $0x1,%%xmm0                     \n"
+      "psrad     $0x1,%%xmm1                     \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5");
+}
+
+void ScaleRowDown2Box_16_SSE2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"
+      "psllw     $0xf,%%xmm4                     \n"  // 0x8000
+      "pcmpeqb   %%xmm5,%%xmm5                   \n"
+      "psrlw     $0xf,%%xmm5                     \n"  // 0x00010001
+      "movdqa    %%xmm5,%%xmm6                   \n"
+      "psrld     $0xf,%%xmm6                     \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "movdqu    0x00(%0,%3,2),%%xmm2            \n"
+      "movdqu    0x10(%0,%3,2),%%xmm3            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm1                   \n"
+      "pxor      %%xmm4,%%xmm2                   \n"
+      "pxor      %%xmm4,%%xmm3                   \n"
+      "pmaddwd   %%xmm5,%%xmm0                   \n"
+      "pmaddwd   %%xmm5,%%xmm1                   \n"
+      "pmaddwd   %%xmm5,%%xmm2                   \n"
+      "pmaddwd   %%xmm5,%%xmm3                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm1                   \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst_ptr),               // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEROWDOWN2_16_SSE2
+
+#ifdef HAS_SCALEROWDOWN2_16_AVX2
+void ScaleRowDown2_16_AVX2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu    (%0),%%ymm0                    \n"
+      "vmovdqu    0x20(%0),%%ymm1                \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpsrad     $0x10,%%ymm0,%%ymm0            \n"
+      "vpsrad     $0x10,%%ymm1,%%ymm1            \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1");
+}
+
+void ScaleRowDown2Linear_16_AVX2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst_ptr,
+                                 int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpsllw     $0xf,%%ymm4,%%ymm4             \n"  // 0x8000
+      "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpsrlw     $0xf,%%ymm5,%%ymm5             \n"  // 0x00010001
+      "vpsrld     $0x10,%%ymm5,%%ymm3            \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxor      (%0),%%ymm4,%%ymm0             \n"
+      "vpxor      0x20(%0),%%ymm4,%%ymm1         \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpmaddwd   %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpaddd     %%ymm3,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm3,%%ymm1,%%ymm1           \n"
+      "vpsrad     $0x1,%%ymm0,%%ymm0             \n"
+      "vpsrad     $0x1,%%ymm1,%%ymm1             \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5");
+}
+
+void ScaleRowDown2Box_16_AVX2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width) {
+  asm volatile(
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpsllw     $0xf,%%ymm4,%%ymm4             \n"  // 0x8000
+      "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpsrlw     $0xf,%%ymm5,%%ymm5             \n"  // 0x00010001
+      "vpsrld     $0xf,%%ymm5,%%ymm6             \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxor      (%0),%%ymm4,%%ymm0             \n"
+      "vpxor      0x20(%0),%%ymm4,%%ymm1         \n"
+      "vpxor      0x00(%0,%3,2),%%ymm4,%%ymm2    \n"
+      "vpxor      0x20(%0,%3,2),%%ymm4,%%ymm3    \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpmaddwd   %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpmaddwd   %%ymm5,%%ymm2,%%ymm2           \n"
+      "vpmaddwd   %%ymm5,%%ymm3,%%ymm3           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm3,%%ymm1,%%ymm1           \n"
+      "vpaddd     %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm6,%%ymm1,%%ymm1           \n"
+      "vpsrad     $0x2,%%ymm0,%%ymm0             \n"
+      "vpsrad     $0x2,%%ymm1,%%ymm1             \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst_ptr),               // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEROWDOWN2_16_AVX2
+
+#ifdef HAS_SCALEROWDOWN2_16_AVX512BW
+void ScaleRowDown2_16_AVX512BW(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width) {
+  (void)src_stride;
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64  (%0),%%zmm0                    \n"
+      "vmovdqu64  0x40(%0),%%zmm1                \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpsrld     $0x10,%%zmm0,%%zmm0            \n"
+      "vpsrld     $0x10,%%zmm1,%%zmm1            \n"
+      "vpmovdw    %%zmm0,(%1)                    \n"
+      "vpmovdw    %%zmm1,0x20(%1)                \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1");
+}
+
+void ScaleRowDown2Linear_16_AVX512BW(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst_ptr,
+                                     int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+      "vpsllw     $0xf,%%zmm4,%%zmm4             \n"  // 0x8000
+      "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+      "vpsrlw     $0xf,%%zmm5,%%zmm5             \n"  // 0x00010001
+      "vpsrld     $0x10,%%zmm5,%%zmm3            \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxord     (%0),%%zmm4,%%zmm0             \n"
+      "vpxord     0x40(%0),%%zmm4,%%zmm1         \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpmaddwd   %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpmaddwd   %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpaddd     %%zmm3,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm3,%%zmm1,%%zmm1           \n"
+      "vpsrad     $0x1,%%zmm0,%%zmm0             \n"
+      "vpsrad     $0x1,%%zmm1,%%zmm1             \n"
+      "vpmovdw    %%zmm0,%%ymm0                  \n"
+      "vpmovdw    %%zmm1,%%ymm1                  \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm4,%%ymm1,%%ymm1           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "vmovdqu    %%ymm1,0x20(%1)                \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5");
+}
+
+void ScaleRowDown2Box_16_AVX512BW(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width) {
+  asm volatile(
+      "vpternlogd $0xff,%%zmm4,%%zmm4,%%zmm4     \n"
+      "vpsllw     $0xf,%%zmm4,%%zmm4             \n"  // 0x8000
+      "vpternlogd $0xff,%%zmm5,%%zmm5,%%zmm5     \n"
+      "vpsrlw     $0xf,%%zmm5,%%zmm5             \n"  // 0x00010001
+      "vpsrld     $0xf,%%zmm5,%%zmm6             \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxord     (%0),%%zmm4,%%zmm0             \n"
+      "vpxord     0x40(%0),%%zmm4,%%zmm1         \n"
+      "vpxord     0x00(%0,%3,2),%%zmm4,%%zmm2    \n"
+      "vpxord     0x40(%0,%3,2),%%zmm4,%%zmm3    \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpmaddwd   %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpmaddwd   %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpmaddwd   %%zmm5,%%zmm2,%%zmm2           \n"
+      "vpmaddwd   %%zmm5,%%zmm3,%%zmm3           \n"
+      "vpaddd     %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm3,%%zmm1,%%zmm1           \n"
+      "vpaddd     %%zmm6,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm6,%%zmm1,%%zmm1           \n"
+      "vpsrad     $0x2,%%zmm0,%%zmm0             \n"
+      "vpsrad     $0x2,%%zmm1,%%zmm1             \n"
+      "vpmovdw    %%zmm0,%%ymm0                  \n"
+      "vpmovdw    %%zmm1,%%ymm1                  \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm4,%%ymm1,%%ymm1           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "vmovdqu    %%ymm1,0x20(%1)                \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst_ptr),               // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEROWDOWN2_16_AVX512BW
+
+#ifdef HAS_SCALEROWDOWN4_16_SSE2
+void ScaleRowDown4_16_SSE2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "movdqu    0x20(%0),%%xmm2                 \n"
+      "movdqu    0x30(%0),%%xmm3                 \n"
+      "lea       0x40(%0),%0                     \n"
+      "pslld     $0x10,%%xmm0                    \n"
+      "pslld     $0x10,%%xmm1                    \n"
+      "pslld     $0x10,%%xmm2                    \n"
+      "pslld     $0x10,%%xmm3                    \n"
+      "psrad     $0x10,%%xmm0                    \n"
+      "psrad     $0x10,%%xmm1                    \n"
+      "psrad     $0x10,%%xmm2                    \n"
+      "psrad     $0x10,%%xmm3                    \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "packssdw  %%xmm3,%%xmm2                   \n"
+      "psrad     $0x10,%%xmm0                    \n"
+      "psrad     $0x10,%%xmm2                    \n"
+      "packssdw  %%xmm2,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+}
+
+void ScaleRowDown4Box_16_SSE2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width) {
+  intptr_t stridex3;
+  asm volatile(
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psllw     $0xf,%%xmm7                     \n"  // 0x8000
+      "pcmpeqb   %%xmm6,%%xmm6                   \n"
+      "psrlw     $0xf,%%xmm6                     \n"  // 0x00010001
+      "movdqa    %%xmm6,%%xmm5                   \n"
+      "psrld     $0xd,%%xmm5                     \n"  // 8
+      "lea       0x00(%4,%4,2),%3                \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm0                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "movdqu    0x00(%0,%4,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x10(%0,%4,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm1                   \n"
+      "movdqu    0x00(%0,%4,4),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x10(%0,%4,4),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm1                   \n"
+      "movdqu    0x00(%0,%3,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x10(%0,%3,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm1                   \n"
+      "movdqa    %%xmm0,%%xmm3                   \n"
+      "shufps    $0x88,%%xmm1,%%xmm3             \n"
+      "shufps    $0xdd,%%xmm1,%%xmm0             \n"
+      "paddd     %%xmm0,%%xmm3                   \n"
+
+      "movdqu    0x20(%0),%%xmm0                 \n"
+      "movdqu    0x30(%0),%%xmm1                 \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm0                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "movdqu    0x20(%0,%4,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x30(%0,%4,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm1                   \n"
+      "movdqu    0x20(%0,%4,4),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x30(%0,%4,4),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm1                   \n"
+      "movdqu    0x20(%0,%3,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x30(%0,%3,2),%%xmm2            \n"
+      "pxor      %%xmm7,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm2,%%xmm1                   \n"
+      "lea       0x40(%0),%0                     \n"
+      "movdqa    %%xmm0,%%xmm2                   \n"
+      "shufps    $0x88,%%xmm1,%%xmm2             \n"
+      "shufps    $0xdd,%%xmm1,%%xmm0             \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+
+      "paddd     %%xmm5,%%xmm3                   \n"
+      "paddd     %%xmm5,%%xmm0                   \n"
+      "psrad     $0x4,%%xmm3                     \n"
+      "psrad     $0x4,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm3                   \n"
+      "pxor      %%xmm7,%%xmm3                   \n"
+      "movdqu    %%xmm3,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst_ptr),               // %1
+        "+r"(dst_width),             // %2
+        "=&r"(stridex3)              // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEROWDOWN4_16_SSE2
+
+#ifdef HAS_SCALEROWDOWN4_16_AVX2
+// Puts the dwords of two in-lane packs back in order.
+static const lvec32 kPermdDown4_16 = {0, 4, 1, 5, 2, 6, 3, 7};
+
+void ScaleRowDown4_16_AVX2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst_ptr,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vmovdqu    %3,%%ymm5                      \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu    (%0),%%ymm0                    \n"
+      "vmovdqu    0x20(%0),%%ymm1                \n"
+      "vmovdqu    0x40(%0),%%ymm2                \n"
+      "vmovdqu    0x60(%0),%%ymm3                \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpslld     $0x10,%%ymm0,%%ymm0            \n"
+      "vpslld     $0x10,%%ymm1,%%ymm1            \n"
+      "vpslld     $0x10,%%ymm2,%%ymm2            \n"
+      "vpslld     $0x10,%%ymm3,%%ymm3            \n"
+      "vpsrad     $0x10,%%ymm0,%%ymm0            \n"
+      "vpsrad     $0x10,%%ymm1,%%ymm1            \n"
+      "vpsrad     $0x10,%%ymm2,%%ymm2            \n"
+      "vpsrad     $0x10,%%ymm3,%%ymm3            \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpackssdw  %%ymm3,%%ymm2,%%ymm2           \n"
+      "vpsrad     $0x10,%%ymm0,%%ymm0            \n"
+      "vpsrad     $0x10,%%ymm2,%%ymm2            \n"
+      "vpackssdw  %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpermd     %%ymm0,%%ymm5,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),       // %0
+        "+r"(dst_ptr),       // %1
+        "+r"(dst_width)      // %2
+      : "m"(kPermdDown4_16)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5");
+}
+
+void ScaleRowDown4Box_16_AVX2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst_ptr,
+                              int dst_width) {
+  intptr_t stridex3;
+  asm volatile(
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpsllw     $0xf,%%ymm4,%%ymm4             \n"  // 0x8000
+      "vpcmpeqb   %%ymm6,%%ymm6,%%ymm6           \n"
+      "vpsrlw     $0xf,%%ymm6,%%ymm6             \n"  // 0x00010001
+      "vpsrld     $0xd,%%ymm6,%%ymm5             \n"  // 8
+      "vmovdqu    %5,%%ymm7                      \n"
+      "lea        0x00(%4,%4,2),%3               \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxor      (%0),%%ymm4,%%ymm0             \n"
+      "vpxor      0x20(%0),%%ymm4,%%ymm1         \n"
+      "vpmaddwd   %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm6,%%ymm1,%%ymm1           \n"
+      "vpxor      0x00(%0,%4,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpxor      0x20(%0,%4,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm1,%%ymm1           \n"
+      "vpxor      0x00(%0,%4,4),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpxor      0x20(%0,%4,4),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm1,%%ymm1           \n"
+      "vpxor      0x00(%0,%3,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpxor      0x20(%0,%3,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm1,%%ymm1           \n"
+      "vphaddd    %%ymm1,%%ymm0,%%ymm3           \n"
+
+      "vpxor      0x40(%0),%%ymm4,%%ymm0         \n"
+      "vpxor      0x60(%0),%%ymm4,%%ymm1         \n"
+      "vpmaddwd   %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm6,%%ymm1,%%ymm1           \n"
+      "vpxor      0x40(%0,%4,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpxor      0x60(%0,%4,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm1,%%ymm1           \n"
+      "vpxor      0x40(%0,%4,4),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpxor      0x60(%0,%4,4),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm1,%%ymm1           \n"
+      "vpxor      0x40(%0,%3,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpxor      0x60(%0,%3,2),%%ymm4,%%ymm2    \n"
+      "vpmaddwd   %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm2,%%ymm1,%%ymm1           \n"
+      "lea        0x80(%0),%0                    \n"
+      "vphaddd    %%ymm1,%%ymm0,%%ymm0           \n"
+
+      "vpaddd     %%ymm5,%%ymm3,%%ymm3           \n"
+      "vpaddd     %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpsrad     $0x4,%%ymm3,%%ymm3             \n"
+      "vpsrad     $0x4,%%ymm0,%%ymm0             \n"
+      "vpackssdw  %%ymm0,%%ymm3,%%ymm0           \n"
+      "vpermd     %%ymm0,%%ymm7,%%ymm0           \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width),              // %2
+        "=&r"(stridex3)               // %3
+      : "r"((intptr_t)(src_stride)),  // %4
+        "m"(kPermdDown4_16)           // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEROWDOWN4_16_AVX2
+
+#ifdef HAS_SCALEROWDOWN4_16_AVX512BW
+void ScaleRowDown4_16_AVX512BW(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst_ptr,
+                               int dst_width) {
+  (void)src_stride;
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrlq     $0x20,(%0),%%zmm0              \n"
+      "vpsrlq     $0x20,0x40(%0),%%zmm1          \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpmovqw    %%zmm0,(%1)                    \n"
+      "vpmovqw    %%zmm1,0x10(%1)                \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1");
+}
+
+void ScaleRowDown4Box_16_AVX512BW(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst_ptr,
+                                  int dst_width) {
+  intptr_t stridex3;
+  asm volatile(
+      "vpternlogd $0xff,%%zmm7,%%zmm7,%%zmm7     \n"
+      "vpsllw     $0xf,%%zmm7,%%zmm7             \n"  // 0x8000
+      "vpternlogd $0xff,%%zmm6,%%zmm6,%%zmm6     \n"
+      "vpsrlw     $0xf,%%zmm6,%%zmm6             \n"  // 0x00010001
+      "vpsrld     $0xd,%%zmm6,%%zmm5             \n"  // 8
+      "lea        0x00(%4,%4,2),%3               \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxord     (%0),%%zmm7,%%zmm0             \n"
+      "vpxord     0x40(%0),%%zmm7,%%zmm1         \n"
+      "vpmaddwd   %%zmm6,%%zmm0,%%zmm0           \n"
+      "vpmaddwd   %%zmm6,%%zmm1,%%zmm1           \n"
+      "vpxord     0x00(%0,%4,2),%%zmm7,%%zmm2    \n"
+      "vpxord     0x40(%0,%4,2),%%zmm7,%%zmm3    \n"
+      "vpmaddwd   %%zmm6,%%zmm2,%%zmm2           \n"
+      "vpmaddwd   %%zmm6,%%zmm3,%%zmm3           \n"
+      "vpaddd     %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm3,%%zmm1,%%zmm1           \n"
+      "vpxord     0x00(%0,%4,4),%%zmm7,%%zmm2    \n"
+      "vpxord     0x40(%0,%4,4),%%zmm7,%%zmm3    \n"
+      "vpmaddwd   %%zmm6,%%zmm2,%%zmm2           \n"
+      "vpmaddwd   %%zmm6,%%zmm3,%%zmm3           \n"
+      "vpaddd     %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm3,%%zmm1,%%zmm1           \n"
+      "vpxord     0x00(%0,%3,2),%%zmm7,%%zmm2    \n"
+      "vpxord     0x40(%0,%3,2),%%zmm7,%%zmm3    \n"
+      "vpmaddwd   %%zmm6,%%zmm2,%%zmm2           \n"
+      "vpmaddwd   %%zmm6,%%zmm3,%%zmm3           \n"
+      "vpaddd     %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm3,%%zmm1,%%zmm1           \n"
+      "lea        0x80(%0),%0                    \n"
+      "vpsrlq     $0x20,%%zmm0,%%zmm2            \n"
+      "vpsrlq     $0x20,%%zmm1,%%zmm3            \n"
+      "vpaddd     %%zmm2,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm3,%%zmm1,%%zmm1           \n"
+      "vpaddd     %%zmm5,%%zmm0,%%zmm0           \n"
+      "vpaddd     %%zmm5,%%zmm1,%%zmm1           \n"
+      "vpsrad     $0x4,%%zmm0,%%zmm0             \n"
+      "vpsrad     $0x4,%%zmm1,%%zmm1             \n"
+      "vpmovqw    %%zmm0,%%xmm0                  \n"
+      "vpmovqw    %%zmm1,%%xmm1                  \n"
+      "vpxor      %%xmm7,%%xmm0,%%xmm0           \n"
+      "vpxor      %%xmm7,%%xmm1,%%xmm1           \n"
+      "vmovdqu    %%xmm0,(%1)                    \n"
+      "vmovdqu    %%xmm1,0x10(%1)                \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst_ptr),               // %1
+        "+r"(dst_width),             // %2
+        "=&r"(stridex3)              // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEROWDOWN4_16_AVX512BW
+
+#ifdef HAS_SCALEROWDOWN34_16_SSSE3
+// Shuffle source pixels 0, 1, 3, 4, 5 and 7 to the first 6 words.
+static const uvec8 kShuf34_16 = {0,  1,  2,  3,  6,   7,   8,   9,
+                                 10, 11, 14, 15, 128, 128, 128, 128};
+
+// Shuffle the pairs of pixels that are filtered for 3/4 from source pixels
+// 0 to 7, 4 to 11 and 8 to 15.
+static const uvec8 kShuf34a_16 = {0, 1, 2, 3, 2,  3,  4,  5,
+                                  4, 5, 6, 7, 8, 9, 10, 11};
+static const uvec8 kShuf34b_16 = {2, 3,  4,  5,  4,  5,  6,  7,
+                                  8, 9, 10, 11, 10, 11, 12, 13};
+static const uvec8 kShuf34c_16 = {4,  5,  6,  7,  8,  9,  10, 11,
+                                  10, 11, 12, 13, 12, 13, 14, 15};
+
+// Weights for the pairs. 1:1 is 2:2 so all pairs round the same way.
+static const vec16 kMadd34a_16 = {3, 1, 2, 2, 1, 3, 3, 1};
+static const vec16 kMadd34b_16 = {2, 2, 1, 3, 3, 1, 2, 2};
+static const vec16 kMadd34c_16 = {1, 3, 3, 1, 2, 2, 1, 3};
+
+void ScaleRowDown34_16_SSSE3(const uint16_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint16_t* dst_ptr,
+                             int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "movdqa    %3,%%xmm5                       \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshufb    %%xmm5,%%xmm0                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "movq      %%xmm0,(%1)                     \n"
+      "psrldq    $0x8,%%xmm0                     \n"
+      "movd      %%xmm0,0x8(%1)                  \n"
+      "movq      %%xmm1,0xc(%1)                  \n"
+      "psrldq    $0x8,%%xmm1                     \n"
+      "movd      %%xmm1,0x14(%1)                 \n"
+      "lea       0x18(%1),%1                     \n"
+      "sub       $0xc,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+      : "m"(kShuf34_16)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm5");
+}
+
+// Filter rows 0 and 1 together, 3 : 1
+void ScaleRowDown34_0_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psllw     $0xf,%%xmm7                     \n"  // 0x8000
+      "pcmpeqb   %%xmm6,%%xmm6                   \n"
+      "psrld     $0x1f,%%xmm6                    \n"
+      "pslld     $0x1,%%xmm6                     \n"  // 2
+      :
+      :
+      : "xmm6", "xmm7");
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x00(%0,%3,2),%%xmm1            \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pshufb    %4,%%xmm0                       \n"
+      "pshufb    %4,%%xmm1                       \n"
+      "pmaddwd   %7,%%xmm0                       \n"
+      "pmaddwd   %7,%%xmm1                       \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "movdqa    %%xmm0,%%xmm2                   \n"
+      "paddd     %%xmm0,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movq      %%xmm0,(%1)                     \n"
+
+      "movdqu    0x8(%0),%%xmm0                  \n"
+      "movdqu    0x8(%0,%3,2),%%xmm1             \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pshufb    %5,%%xmm0                       \n"
+      "pshufb    %5,%%xmm1                       \n"
+      "pmaddwd   %8,%%xmm0                       \n"
+      "pmaddwd   %8,%%xmm1                       \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "movdqa    %%xmm0,%%xmm2                   \n"
+      "paddd     %%xmm0,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movq      %%xmm0,0x8(%1)                  \n"
+
+      "movdqu    0x10(%0),%%xmm0                 \n"
+      "movdqu    0x10(%0,%3,2),%%xmm1            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pshufb    %6,%%xmm0                       \n"
+      "pshufb    %6,%%xmm1                       \n"
+      "pmaddwd   %9,%%xmm0                       \n"
+      "pmaddwd   %9,%%xmm1                       \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "movdqa    %%xmm0,%%xmm2                   \n"
+      "paddd     %%xmm0,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movq      %%xmm0,0x10(%1)                 \n"
+      "lea       0x18(%1),%1                     \n"
+      "sub       $0xc,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShuf34a_16),             // %4
+        "m"(kShuf34b_16),             // %5
+        "m"(kShuf34c_16),             // %6
+        "m"(kMadd34a_16),             // %7
+        "m"(kMadd34b_16),             // %8
+        "m"(kMadd34c_16)              // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm6", "xmm7");
+}
+
+// Filter rows 1 and 2 together, 1 : 1
+void ScaleRowDown34_1_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psllw     $0xf,%%xmm7                     \n"  // 0x8000
+      "pcmpeqb   %%xmm5,%%xmm5                   \n"
+      "psrld     $0x1f,%%xmm5                    \n"  // 1
+      "movdqa    %%xmm5,%%xmm6                   \n"
+      "pslld     $0x1,%%xmm6                     \n"  // 2
+      :
+      :
+      : "xmm5", "xmm6", "xmm7");
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x00(%0,%3,2),%%xmm1            \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pshufb    %4,%%xmm0                       \n"
+      "pshufb    %4,%%xmm1                       \n"
+      "pmaddwd   %7,%%xmm0                       \n"
+      "pmaddwd   %7,%%xmm1                       \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm5,%%xmm0                   \n"
+      "psrad     $0x1,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movq      %%xmm0,(%1)                     \n"
+
+      "movdqu    0x8(%0),%%xmm0                  \n"
+      "movdqu    0x8(%0,%3,2),%%xmm1             \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pshufb    %5,%%xmm0                       \n"
+      "pshufb    %5,%%xmm1                       \n"
+      "pmaddwd   %8,%%xmm0                       \n"
+      "pmaddwd   %8,%%xmm1                       \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm5,%%xmm0                   \n"
+      "psrad     $0x1,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movq      %%xmm0,0x8(%1)                  \n"
+
+      "movdqu    0x10(%0),%%xmm0                 \n"
+      "movdqu    0x10(%0,%3,2),%%xmm1            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "pshufb    %6,%%xmm0                       \n"
+      "pshufb    %6,%%xmm1                       \n"
+      "pmaddwd   %9,%%xmm0                       \n"
+      "pmaddwd   %9,%%xmm1                       \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm5,%%xmm0                   \n"
+      "psrad     $0x1,%%xmm0                     \n"
+      "packssdw  %%xmm0,%%xmm0                   \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movq      %%xmm0,0x10(%1)                 \n"
+      "lea       0x18(%1),%1                     \n"
+      "sub       $0xc,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShuf34a_16),             // %4
+        "m"(kShuf34b_16),             // %5
+        "m"(kShuf34c_16),             // %6
+        "m"(kMadd34a_16),             // %7
+        "m"(kMadd34b_16),             // %8
+        "m"(kMadd34c_16)              // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm5", "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEROWDOWN34_16_SSSE3
+
+#ifdef HAS_SCALEROWDOWN38_16_SSSE3
+// Shuffle the 3 and 3 and 2 pixels summed for 3/8. pmaddwd adds the first
+// table's pairs and the second table adds the middle pixel of each 3.
+static const uvec8 kShuf38Box0_16 = {0,  1,  2,  3,  6,   7,   8,   9,
+                                     12, 13, 14, 15, 128, 128, 128, 128};
+static const uvec8 kShuf38Box1_16 = {4,   5,   128, 128, 10,  11,  128, 128,
+                                     128, 128, 128, 128, 128, 128, 128, 128};
+
+// Shuffle the low word of the first 3 dwords to words 0 to 2 and 3 to 5.
+static const uvec8 kShuf38Lo_16 = {0,   1,   4,   5,   8,   9,   128, 128,
+                                   128, 128, 128, 128, 128, 128, 128, 128};
+static const uvec8 kShuf38Hi_16 = {128, 128, 128, 128, 128, 128, 0,   1,
+                                   4,   5,   8,   9,   128, 128, 128, 128};
+
+// Bias added back to the sums of 9, 9 and 6 or 6, 6 and 4 biased pixels.
+static const uvec32 kBias38Box3_16 = {9 * 32768, 9 * 32768, 6 * 32768, 0};
+static const uvec32 kBias38Box2_16 = {6 * 32768, 6 * 32768, 4 * 32768, 0};
+
+// Scale factors for the sums, as in the C version.
+static const uvec16 kScale38Box3_16 = {65536 / 9, 65536 / 9, 65536 / 9,
+                                       65536 / 9, 65536 / 6, 65536 / 6,
+                                       0,         0};
+static const uvec16 kScale38Box2_16 = {65536 / 6, 65536 / 6, 65536 / 6,
+                                       65536 / 6, 65536 / 4, 65536 / 4,
+                                       0,         0};
+
+void ScaleRowDown38_16_SSSE3(const uint16_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint16_t* dst_ptr,
+                             int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "movdqa    %3,%%xmm4                       \n"
+      "movdqa    %4,%%xmm5                       \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshufb    %%xmm4,%%xmm0                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "por       %%xmm1,%%xmm0                   \n"
+      "movq      %%xmm0,(%1)                     \n"
+      "psrldq    $0x8,%%xmm0                     \n"
+      "movd      %%xmm0,0x8(%1)                  \n"
+      "lea       0xc(%1),%1                      \n"
+      "sub       $0x6,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(dst_width)  // %2
+      : "m"(kShufAc),    // %3
+        "m"(kShufAc3)    // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5");
+}
+
+// The sums of biased pixels are made unsigned again and scaled with the
+// same 32 bit math as the C version, which keeps bits 16 to 31 of
+// sum * scale. With sum = hi * 65536 + lo that is the low word of
+// hi * scale + ((lo * scale) >> 16).
+void ScaleRowDown38_3_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psllw     $0xf,%%xmm7                     \n"  // 0x8000
+      "pcmpeqb   %%xmm6,%%xmm6                   \n"
+      "psrlw     $0xf,%%xmm6                     \n"  // 0x00010001
+      "movdqa    %0,%%xmm5                       \n"
+      "movdqa    %1,%%xmm4                       \n"
+      :
+      : "m"(kShuf38Box0_16),  // %0
+        "m"(kShuf38Box1_16)   // %1
+      : "xmm4", "xmm5", "xmm6", "xmm7");
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pshufb    %%xmm5,%%xmm0                   \n"
+      "pshufb    %%xmm4,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm0                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "movdqu    0x00(%0,%3,2),%%xmm1            \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm2                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "pshufb    %%xmm4,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x00(%0,%3,4),%%xmm1            \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm2                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "pshufb    %%xmm4,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %4,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pmulhuw   %5,%%xmm0                       \n"
+      "pmullw    %5,%%xmm1                       \n"
+      "psrld     $0x10,%%xmm1                    \n"
+      "paddw     %%xmm1,%%xmm0                   \n"
+      "pshufb    %6,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm3                   \n"
+
+      "movdqu    0x10(%0),%%xmm0                 \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pshufb    %%xmm5,%%xmm0                   \n"
+      "pshufb    %%xmm4,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm0                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "movdqu    0x10(%0,%3,2),%%xmm1            \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm2                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "pshufb    %%xmm4,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "movdqu    0x10(%0,%3,4),%%xmm1            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm2                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "pshufb    %%xmm4,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %4,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pmulhuw   %5,%%xmm0                       \n"
+      "pmullw    %5,%%xmm1                       \n"
+      "psrld     $0x10,%%xmm1                    \n"
+      "paddw     %%xmm1,%%xmm0                   \n"
+      "pshufb    %7,%%xmm0                       \n"
+      "por       %%xmm0,%%xmm3                   \n"
+
+      "movq      %%xmm3,(%1)                     \n"
+      "psrldq    $0x8,%%xmm3                     \n"
+      "movd      %%xmm3,0x8(%1)                  \n"
+      "lea       0xc(%1),%1                      \n"
+      "sub       $0x6,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kBias38Box3_16),          // %4
+        "m"(kScale38Box3_16),         // %5
+        "m"(kShuf38Lo_16),            // %6
+        "m"(kShuf38Hi_16)             // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+
+void ScaleRowDown38_2_Box_16_SSSE3(const uint16_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_ptr,
+                                   int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psllw     $0xf,%%xmm7                     \n"  // 0x8000
+      "pcmpeqb   %%xmm6,%%xmm6                   \n"
+      "psrlw     $0xf,%%xmm6                     \n"  // 0x00010001
+      "movdqa    %0,%%xmm5                       \n"
+      "movdqa    %1,%%xmm4                       \n"
+      :
+      : "m"(kShuf38Box0_16),  // %0
+        "m"(kShuf38Box1_16)   // %1
+      : "xmm4", "xmm5", "xmm6", "xmm7");
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pshufb    %%xmm5,%%xmm0                   \n"
+      "pshufb    %%xmm4,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm0                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "movdqu    0x00(%0,%3,2),%%xmm1            \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm2                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "pshufb    %%xmm4,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %4,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pmulhuw   %5,%%xmm0                       \n"
+      "pmullw    %5,%%xmm1                       \n"
+      "psrld     $0x10,%%xmm1                    \n"
+      "paddw     %%xmm1,%%xmm0                   \n"
+      "pshufb    %6,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm3                   \n"
+
+      "movdqu    0x10(%0),%%xmm0                 \n"
+      "pxor      %%xmm7,%%xmm0                   \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pshufb    %%xmm5,%%xmm0                   \n"
+      "pshufb    %%xmm4,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm0                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "movdqu    0x10(%0,%3,2),%%xmm1            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pxor      %%xmm7,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm2                   \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "pshufb    %%xmm4,%%xmm2                   \n"
+      "pmaddwd   %%xmm6,%%xmm1                   \n"
+      "pmaddwd   %%xmm6,%%xmm2                   \n"
+      "paddd     %%xmm1,%%xmm0                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %4,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "pmulhuw   %5,%%xmm0                       \n"
+      "pmullw    %5,%%xmm1                       \n"
+      "psrld     $0x10,%%xmm1                    \n"
+      "paddw     %%xmm1,%%xmm0                   \n"
+      "pshufb    %7,%%xmm0                       \n"
+      "por       %%xmm0,%%xmm3                   \n"
+
+      "movq      %%xmm3,(%1)                     \n"
+      "psrldq    $0x8,%%xmm3                     \n"
+      "movd      %%xmm3,0x8(%1)                  \n"
+      "lea       0xc(%1),%1                      \n"
+      "sub       $0x6,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kBias38Box2_16),          // %4
+        "m"(kScale38Box2_16),         // %5
+        "m"(kShuf38Lo_16),            // %6
+        "m"(kShuf38Hi_16)             // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEROWDOWN38_16_SSSE3
+
+#ifdef HAS_SCALEADDROW_16_SSE2
+// Reads 8 pixels at a time.
+void ScaleAddRow_16_SSE2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width) {
+  asm volatile(
+      "pxor      %%xmm5,%%xmm5                   \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm2                     \n"
+      "lea       0x10(%0),%0                     \n"
+      "movdqu    (%1),%%xmm0                     \n"
+      "movdqu    0x10(%1),%%xmm1                 \n"
+      "movdqa    %%xmm2,%%xmm3                   \n"
+      "punpcklwd %%xmm5,%%xmm2                   \n"
+      "punpckhwd %%xmm5,%%xmm3                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm1                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "movdqu    %%xmm1,0x10(%1)                 \n"
+      "lea       0x20(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(src_width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5");
+}
+#endif  // HAS_SCALEADDROW_16_SSE2
+
+#ifdef HAS_SCALEADDROW_16_AVX2
+// Reads 16 pixels at a time.
+void ScaleAddRow_16_AVX2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width) {
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpmovzxwd  (%0),%%ymm0                    \n"
+      "vpmovzxwd  0x10(%0),%%ymm1                \n"
+      "lea        0x20(%0),%0                    \n"
+      "vpaddd     (%1),%%ymm0,%%ymm0             \n"
+      "vpaddd     0x20(%1),%%ymm1,%%ymm1         \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "vmovdqu    %%ymm1,0x20(%1)                \n"
+      "lea        0x40(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(src_width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1");
+}
+#endif  // HAS_SCALEADDROW_16_AVX2
+
+#ifdef HAS_SCALEADDROW_16_AVX512BW
+// Reads 32 pixels at a time.
+void ScaleAddRow_16_AVX512BW(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width) {
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpmovzxwd  (%0),%%zmm0                    \n"
+      "vpmovzxwd  0x20(%0),%%zmm1                \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpaddd     (%1),%%zmm0,%%zmm0             \n"
+      "vpaddd     0x40(%1),%%zmm1,%%zmm1         \n"
+      "vmovdqu64  %%zmm0,(%1)                    \n"
+      "vmovdqu64  %%zmm1,0x40(%1)                \n"
+      "lea        0x80(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(src_width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1");
+}
+#endif  // HAS_SCALEADDROW_16_AVX512BW
+
+#ifdef HAS_SCALECOLS_16_SSE2
+// Reads 4 pixels at a time.
+void ScaleCols_16_SSE2(uint16_t* dst_ptr,
+                       const uint16_t* src_ptr,
+                       int dst_width,
+                       int x,
+                       int dx) {
+  intptr_t x0, x1;
+  asm volatile(
+      "movd      %5,%%xmm2                       \n"
+      "movd      %6,%%xmm3                       \n"
+      "pshufd    $0x0,%%xmm2,%%xmm2              \n"
+      "pshufd    $0x11,%%xmm3,%%xmm0             \n"
+      "paddd     %%xmm0,%%xmm2                   \n"
+      "paddd     %%xmm3,%%xmm3                   \n"
+      "pshufd    $0x5,%%xmm3,%%xmm0              \n"
+      "paddd     %%xmm0,%%xmm2                   \n"
+      "paddd     %%xmm3,%%xmm3                   \n"
+      "pshufd    $0x0,%%xmm3,%%xmm3              \n"
+      "pextrw    $0x1,%%xmm2,%k0                 \n"
+      "pextrw    $0x3,%%xmm2,%k1                 \n"
+      "cmp       $0x0,%4                         \n"
+      "jl        99f                             \n"
+      "sub       $0x4,%4                         \n"
+      "jl        49f                             \n"
+
+      LABELALIGN
+      "40:                                       \n"
+      "pinsrw    $0x0,0x00(%3,%0,2),%%xmm0       \n"
+      "pinsrw    $0x1,0x00(%3,%1,2),%%xmm0       \n"
+      "pextrw    $0x5,%%xmm2,%k0                 \n"
+      "pextrw    $0x7,%%xmm2,%k1                 \n"
+      "paddd     %%xmm3,%%xmm2                   \n"
+      "pinsrw    $0x2,0x00(%3,%0,2),%%xmm0       \n"
+      "pinsrw    $0x3,0x00(%3,%1,2),%%xmm0       \n"
+      "pextrw    $0x1,%%xmm2,%k0                 \n"
+      "pextrw    $0x3,%%xmm2,%k1                 \n"
+      "movq      %%xmm0,(%2)                     \n"
+      "lea       0x8(%2),%2                      \n"
+      "sub       $0x4,%4                         \n"
+      "jge       40b                             \n"
+
+      "49:                                       \n"
+      "test      $0x2,%4                         \n"
+      "je        29f                             \n"
+      "pinsrw    $0x0,0x00(%3,%0,2),%%xmm0       \n"
+      "pinsrw    $0x1,0x00(%3,%1,2),%%xmm0       \n"
+      "pextrw    $0x5,%%xmm2,%k0                 \n"
+      "movd      %%xmm0,(%2)                     \n"
+      "lea       0x4(%2),%2                      \n"
+      "29:                                       \n"
+      "test      $0x1,%4                         \n"
+      "je        99f                             \n"
+      "movzwl    0x00(%3,%0,2),%k1               \n"
+      "mov       %w1,(%2)                        \n"
+      "99:                                       \n"
+      : "=&a"(x0),       // %0
+        "=&d"(x1),       // %1
+        "+r"(dst_ptr),   // %2
+        "+r"(src_ptr),   // %3
+        "+r"(dst_width)  // %4
+      : "rm"(x),         // %5
+        "rm"(dx)         // %6
+      : "memory", "cc", "xmm0", "xmm2", "xmm3");
+}
+
+// Reads 8 pixels, duplicates them and writes 16 pixels.
+void ScaleColsUp2_16_SSE2(uint16_t* dst_ptr,
+                          const uint16_t* src_ptr,
+                          int dst_width,
+                          int x,
+                          int dx) {
+  (void)x;
+  (void)dx;
+  asm volatile(
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%1),%%xmm0                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "movdqa    %%xmm0,%%xmm1                   \n"
+      "punpcklwd %%xmm0,%%xmm0                   \n"
+      "punpckhwd %%xmm1,%%xmm1                   \n"
+      "movdqu    %%xmm0,(%0)                     \n"
+      "movdqu    %%xmm1,0x10(%0)                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "sub       $0x10,%2                        \n"
+      "jg        1b                              \n"
+
+      : "+r"(dst_ptr),   // %0
+        "+r"(src_ptr),   // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1");
+}
+#endif  // HAS_SCALECOLS_16_SSE2
+
+#ifdef HAS_SCALEFILTERCOLS_16_SSSE3
+// Shuffle the fractions of 2 x positions next to their pixel pairs.
+static const uvec8 kShufFrac_16 = {0,   1,   0,   1,   4,   5,   4,   5,
+                                   128, 128, 128, 128, 128, 128, 128, 128};
+
+// Shuffle words 0 and 4 to the low dword.
+static const uvec8 kShufBlend_16 = {0,   1,   8,   9,   128, 128, 128, 128,
+                                    128, 128, 128, 128, 128, 128, 128, 128};
+
+// Bilinear column filtering of 2 pixels at a time. f * b - f * a is formed
+// with 16x16 bit multiplies and only bits 16 to 31 of the rounded result are
+// kept, which is what the C version keeps when it casts to uint16_t.
+void ScaleFilterCols_16_SSSE3(uint16_t* dst_ptr,
+                              const uint16_t* src_ptr,
+                              int dst_width,
+                              int x,
+                              int dx) {
+  intptr_t x0, x1, temp_pixel;
+  asm volatile(
+      "movd      %6,%%xmm2                       \n"
+      "movd      %7,%%xmm3                       \n"
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psrld     $0x1f,%%xmm7                    \n"
+      "pslld     $0xf,%%xmm7                     \n"  // 0x8000
+      "movdqa    %8,%%xmm5                       \n"
+      "movdqa    %9,%%xmm6                       \n"
+
+      "pextrw    $0x1,%%xmm2,%k3                 \n"
+      "subl      $0x2,%5                         \n"
+      "jl        29f                             \n"
+      "movdqa    %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm0                   \n"
+      "punpckldq %%xmm0,%%xmm2                   \n"
+      "punpckldq %%xmm3,%%xmm3                   \n"
+      "paddd     %%xmm3,%%xmm3                   \n"
+      "pextrw    $0x3,%%xmm2,%k4                 \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movd      0x00(%1,%3,2),%%xmm0            \n"
+      "movd      0x00(%1,%4,2),%%xmm4            \n"
+      "movdqa    %%xmm2,%%xmm1                   \n"
+      "paddd     %%xmm3,%%xmm2                   \n"
+      "punpckldq %%xmm4,%%xmm0                   \n"  // a0 b0 a1 b1
+      "pshufb    %%xmm5,%%xmm1                   \n"  // f0 f0 f1 f1
+      "movdqa    %%xmm0,%%xmm4                   \n"
+      "pmulhuw   %%xmm1,%%xmm4                   \n"
+      "pmullw    %%xmm0,%%xmm1                   \n"
+      "punpcklwd %%xmm4,%%xmm1                   \n"  // f * a0, f * b0 ...
+      "pshufd    $0xb1,%%xmm1,%%xmm4             \n"
+      "psubd     %%xmm1,%%xmm4                   \n"  // f * (b - a)
+      "paddd     %%xmm7,%%xmm4                   \n"
+      "psrld     $0x10,%%xmm4                    \n"
+      "pshufd    $0x10,%%xmm0,%%xmm1             \n"  // a0 at word 0, a1 at 4
+      "paddw     %%xmm1,%%xmm4                   \n"
+      "pshufb    %%xmm6,%%xmm4                   \n"
+      "pextrw    $0x1,%%xmm2,%k3                 \n"
+      "pextrw    $0x3,%%xmm2,%k4                 \n"
+      "movd      %%xmm4,(%0)                     \n"
+      "lea       0x4(%0),%0                      \n"
+      "subl      $0x2,%5                         \n"
+      "jge       2b                              \n"
+
+      LABELALIGN
+      "29:                                       \n"
+      "addl      $0x1,%5                         \n"
+      "jl        99f                             \n"
+      "movd      0x00(%1,%3,2),%%xmm0            \n"
+      "pshufb    %%xmm5,%%xmm2                   \n"
+      "movdqa    %%xmm0,%%xmm4                   \n"
+      "pmulhuw   %%xmm2,%%xmm4                   \n"
+      "pmullw    %%xmm0,%%xmm2                   \n"
+      "punpcklwd %%xmm4,%%xmm2                   \n"
+      "pshufd    $0xb1,%%xmm2,%%xmm4             \n"
+      "psubd     %%xmm2,%%xmm4                   \n"
+      "paddd     %%xmm7,%%xmm4                   \n"
+      "psrld     $0x10,%%xmm4                    \n"
+      "paddw     %%xmm0,%%xmm4                   \n"
+      "movd      %%xmm4,%k2                      \n"
+      "mov       %w2,(%0)                        \n"
+      "99:                                       \n"
+      : "+r"(dst_ptr),      // %0
+        "+r"(src_ptr),      // %1
+        "=&a"(temp_pixel),  // %2
+        "=&r"(x0),          // %3
+        "=&r"(x1),          // %4
+#if defined(__x86_64__)
+        "+rm"(dst_width)  // %5
+#else
+        "+m"(dst_width)  // %5
+#endif
+      : "rm"(x),            // %6
+        "rm"(dx),           // %7
+        "m"(kShufFrac_16),  // %8
+        "m"(kShufBlend_16)  // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEFILTERCOLS_16_SSSE3
+
+#ifdef HAS_SCALEFILTERCOLS_16_AVX2
+static const lvec32 kIndex07_16 = {0, 1, 2, 3, 4, 5, 6, 7};
+
+// Bilinear column filtering of 8 pixels at a time. Each pixel pair is
+// gathered as a dword, so no more source is read than the C version reads.
+void ScaleFilterCols_16_AVX2(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx) {
+  asm volatile(
+      "vmovd      %3,%%xmm2                      \n"
+      "vmovd      %4,%%xmm3                      \n"
+      "vpbroadcastd %%xmm2,%%ymm2                \n"
+      "vpbroadcastd %%xmm3,%%ymm3                \n"
+      "vpmulld    %5,%%ymm3,%%ymm0               \n"
+      "vpaddd     %%ymm0,%%ymm2,%%ymm2           \n"  // x + dx * 0..7
+      "vpslld     $0x3,%%ymm3,%%ymm3             \n"  // dx * 8
+      "vpcmpeqb   %%ymm6,%%ymm6,%%ymm6           \n"
+      "vpsrld     $0x1f,%%ymm6,%%ymm7            \n"
+      "vpslld     $0xf,%%ymm7,%%ymm7             \n"  // 0x8000
+      "vpsrld     $0x10,%%ymm6,%%ymm6            \n"  // 0xffff
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrld     $0x10,%%ymm2,%%ymm1            \n"
+      "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpgatherdd %%ymm5,0x00(%1,%%ymm1,2),%%ymm0 \n"  // a | b << 16
+      "vpand      %%ymm6,%%ymm2,%%ymm4           \n"   // f
+      "vpaddd     %%ymm3,%%ymm2,%%ymm2           \n"
+      "vpand      %%ymm6,%%ymm0,%%ymm1           \n"   // a
+      "vpsrld     $0x10,%%ymm0,%%ymm0            \n"   // b
+      "vpsubd     %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpmulld    %%ymm4,%%ymm0,%%ymm0           \n"   // f * (b - a)
+      "vpaddd     %%ymm7,%%ymm0,%%ymm0           \n"
+      "vpsrld     $0x10,%%ymm0,%%ymm0            \n"
+      "vpaddd     %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpand      %%ymm6,%%ymm0,%%ymm0           \n"
+      "vextracti128 $0x1,%%ymm0,%%xmm1           \n"
+      "vpackusdw  %%xmm1,%%xmm0,%%xmm0           \n"
+      "vmovdqu    %%xmm0,(%0)                    \n"
+      "lea        0x10(%0),%0                    \n"
+      "sub        $0x8,%2                        \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),    // %0
+        "+r"(src_ptr),    // %1
+        "+r"(dst_width)   // %2
+      : "rm"(x),          // %3
+        "rm"(dx),         // %4
+        "m"(kIndex07_16)  // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEFILTERCOLS_16_AVX2
+
+#ifdef HAS_SCALEUVROWDOWN2_SSSE3
+// Shuffle table for reading the odd UV pairs of 8 UV pairs.
+static const uvec8 kShuffleOddUV = {2u,   3u,   6u,   7u,   10u,  11u,
+                                    14u,  15u,  128u, 128u, 128u, 128u,
+                                    128u, 128u, 128u, 128u};
+
+// Shuffle table for arranging 2 UV pairs as UUVV, so pmaddubsw sums the U
+// and V of adjacent pairs.
+static const uvec8 kShuffleSplitUV = {0u, 2u, 1u,  3u,  4u,  6u,  5u,  7u,
+                                      8u, 10u, 9u, 11u, 12u, 14u, 13u, 15u};
+
+void ScaleUVRowDown2_SSSE3(const uint8_t* src_uv,
+                           ptrdiff_t src_stride,
+                           uint8_t* dst_uv,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "movdqa    %3,%%xmm4                       \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshufb    %%xmm4,%%xmm0                   \n"
+      "pshufb    %%xmm4,%%xmm1                   \n"
+      "punpcklqdq %%xmm1,%%xmm0                  \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_uv),       // %0
+        "+r"(dst_uv),       // %1
+        "+r"(dst_width)     // %2
+      : "m"(kShuffleOddUV)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm4");
+}
+
+void ScaleUVRowDown2Linear_SSSE3(const uint8_t* src_uv,
+                                 ptrdiff_t src_stride,
+                                 uint8_t* dst_uv,
+                                 int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"  // 01010101
+      "psrlw     $0xf,%%xmm4                     \n"
+      "packuswb  %%xmm4,%%xmm4                   \n"
+      "pxor      %%xmm5,%%xmm5                   \n"
+      "movdqa    %3,%%xmm6                       \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshufb    %%xmm6,%%xmm0                   \n"
+      "pshufb    %%xmm6,%%xmm1                   \n"
+      "pmaddubsw %%xmm4,%%xmm0                   \n"
+      "pmaddubsw %%xmm4,%%xmm1                   \n"
+      "pavgw     %%xmm5,%%xmm0                   \n"
+      "pavgw     %%xmm5,%%xmm1                   \n"
+      "packuswb  %%xmm1,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_uv),         // %0
+        "+r"(dst_uv),         // %1
+        "+r"(dst_width)       // %2
+      : "m"(kShuffleSplitUV)  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5", "xmm6");
+}
+
+void ScaleUVRowDown2Box_SSSE3(const uint8_t* src_uv,
+                              ptrdiff_t src_stride,
+                              uint8_t* dst_uv,
+                              int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"  // 01010101
+      "psrlw     $0xf,%%xmm4                     \n"
+      "packuswb  %%xmm4,%%xmm4                   \n"
+      "pxor      %%xmm5,%%xmm5                   \n"
+      "movdqa    %4,%%xmm6                       \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "movdqu    0x00(%0,%3,1),%%xmm2            \n"
+      "movdqu    0x10(%0,%3,1),%%xmm3            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshufb    %%xmm6,%%xmm0                   \n"
+      "pshufb    %%xmm6,%%xmm1                   \n"
+      "pshufb    %%xmm6,%%xmm2                   \n"
+      "pshufb    %%xmm6,%%xmm3                   \n"
+      "pmaddubsw %%xmm4,%%xmm0                   \n"
+      "pmaddubsw %%xmm4,%%xmm1                   \n"
+      "pmaddubsw %%xmm4,%%xmm2                   \n"
+      "pmaddubsw %%xmm4,%%xmm3                   \n"
+      "paddw     %%xmm2,%%xmm0                   \n"
+      "paddw     %%xmm3,%%xmm1                   \n"
+      "psrlw     $0x1,%%xmm0                     \n"
+      "psrlw     $0x1,%%xmm1                     \n"
+      "pavgw     %%xmm5,%%xmm0                   \n"
+      "pavgw     %%xmm5,%%xmm1                   \n"
+      "packuswb  %%xmm1,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x8,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_uv),                 // %0
+        "+r"(dst_uv),                 // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShuffleSplitUV)          // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEUVROWDOWN2_SSSE3
+
+#ifdef HAS_SCALEUVROWDOWN2BOX_AVX2
+void ScaleUVRowDown2Box_AVX2(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_uv,
+                             int dst_width) {
+  asm volatile(
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"  // 01010101
+      "vpsrlw     $0xf,%%ymm4,%%ymm4             \n"
+      "vpackuswb  %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpxor      %%ymm5,%%ymm5,%%ymm5           \n"
+      "vbroadcastf128 %4,%%ymm6                  \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu    (%0),%%ymm0                    \n"
+      "vmovdqu    0x20(%0),%%ymm1                \n"
+      "vmovdqu    0x00(%0,%3,1),%%ymm2           \n"
+      "vmovdqu    0x20(%0,%3,1),%%ymm3           \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpshufb    %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpshufb    %%ymm6,%%ymm1,%%ymm1           \n"
+      "vpshufb    %%ymm6,%%ymm2,%%ymm2           \n"
+      "vpshufb    %%ymm6,%%ymm3,%%ymm3           \n"
+      "vpmaddubsw %%ymm4,%%ymm0,%%ymm0           \n"
+      "vpmaddubsw %%ymm4,%%ymm1,%%ymm1           \n"
+      "vpmaddubsw %%ymm4,%%ymm2,%%ymm2           \n"
+      "vpmaddubsw %%ymm4,%%ymm3,%%ymm3           \n"
+      "vpaddw     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpaddw     %%ymm3,%%ymm1,%%ymm1           \n"
+      "vpsrlw     $0x1,%%ymm0,%%ymm0             \n"
+      "vpsrlw     $0x1,%%ymm1,%%ymm1             \n"
+      "vpavgw     %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpavgw     %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpackuswb  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_uv),                 // %0
+        "+r"(dst_uv),                 // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShuffleSplitUV)          // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEUVROWDOWN2BOX_AVX2
+
+#ifdef HAS_SCALEUVCOLS_SSE2
+// A UV pair is a 16 bit pixel, so the 16 bit column scalers apply.
+void ScaleUVCols_SSE2(uint8_t* dst_uv,
+                      const uint8_t* src_uv,
+                      int dst_width,
+                      int x,
+                      int dx) {
+  ScaleCols_16_SSE2((uint16_t*)dst_uv, (const uint16_t*)src_uv, dst_width, x,
+                    dx);
+}
+
+void ScaleUVColsUp2_SSE2(uint8_t* dst_uv,
+                         const uint8_t* src_uv,
+                         int dst_width,
+                         int x,
+                         int dx) {
+  ScaleColsUp2_16_SSE2((uint16_t*)dst_uv, (const uint16_t*)src_uv, dst_width,
+                       x, dx);
+}
+#endif  // HAS_SCALEUVCOLS_SSE2
+
+#ifdef HAS_SCALEUVFILTERCOLS_SSSE3
+// Shuffle table for arranging 2 UV pairs as UUVV for pmaddubsw.
+static const uvec8 kShuffleColUV = {0u,   2u,   1u,   3u,   4u,   6u,
+                                    5u,   7u,   128u, 128u, 128u, 128u,
+                                    128u, 128u, 128u, 128u};
+
+// Shuffle table for duplicating 2 fractions into 4 bytes each.
+static const uvec8 kShuffleFractionsUV = {0u,   0u,   0u,   0u,   4u,   4u,
+                                          4u,   4u,   128u, 128u, 128u, 128u,
+                                          128u, 128u, 128u, 128u};
+
+// Bilinear column filtering of UV pairs. Same 7 bit blend as the ARGB
+// column filter.
+void ScaleUVFilterCols_SSSE3(uint8_t* dst_uv,
+                             const uint8_t* src_uv,
+                             int dst_width,
+                             int x,
+                             int dx) {
+  intptr_t x0, x1;
+  asm volatile(
+      "movdqa    %0,%%xmm4                       \n"
+      "movdqa    %1,%%xmm5                       \n"
+      :
+      : "m"(kShuffleColUV),       // %0
+        "m"(kShuffleFractionsUV)  // %1
+  );
+
+  asm volatile(
+      "movd      %5,%%xmm2                       \n"
+      "movd      %6,%%xmm3                       \n"
+      "pcmpeqb   %%xmm6,%%xmm6                   \n"
+      "psrlw     $0x9,%%xmm6                     \n"
+      "pextrw    $0x1,%%xmm2,%k3                 \n"
+      "sub       $0x2,%2                         \n"
+      "jl        29f                             \n"
+      "movdqa    %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm0                   \n"
+      "punpckldq %%xmm0,%%xmm2                   \n"
+      "punpckldq %%xmm3,%%xmm3                   \n"
+      "paddd     %%xmm3,%%xmm3                   \n"
+      "pextrw    $0x3,%%xmm2,%k4                 \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movdqa    %%xmm2,%%xmm1                   \n"
+      "paddd     %%xmm3,%%xmm2                   \n"
+      "movd      0x00(%1,%3,2),%%xmm0            \n"
+      "psrlw     $0x9,%%xmm1                     \n"
+      "movd      0x00(%1,%4,2),%%xmm7            \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"
+      "punpckldq %%xmm7,%%xmm0                   \n"
+      "pshufb    %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm6,%%xmm1                   \n"
+      "pmaddubsw %%xmm1,%%xmm0                   \n"
+      "psrlw     $0x7,%%xmm0                     \n"
+      "pextrw    $0x1,%%xmm2,%k3                 \n"
+      "pextrw    $0x3,%%xmm2,%k4                 \n"
+      "packuswb  %%xmm0,%%xmm0                   \n"
+      "movd      %%xmm0,(%0)                     \n"
+      "lea       0x4(%0),%0                      \n"
+      "sub       $0x2,%2                         \n"
+      "jge       2b                              \n"
+
+      LABELALIGN
+      "29:                                       \n"
+      "add       $0x1,%2                         \n"
+      "jl        99f                             \n"
+      "psrlw     $0x9,%%xmm2                     \n"
+      "movd      0x00(%1,%3,2),%%xmm0            \n"
+      "pshufb    %%xmm5,%%xmm2                   \n"
+      "pshufb    %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm6,%%xmm2                   \n"
+      "pmaddubsw %%xmm2,%%xmm0                   \n"
+      "psrlw     $0x7,%%xmm0                     \n"
+      "packuswb  %%xmm0,%%xmm0                   \n"
+      "movd      %%xmm0,%k3                      \n"
+      "mov       %w3,(%0)                        \n"
+
+      LABELALIGN "99:                            \n"  // clang-format error.
+
+      : "+r"(dst_uv),      // %0
+        "+r"(src_uv),      // %1
+        "+rm"(dst_width),  // %2
+        "=&r"(x0),         // %3
+        "=&r"(x1)          // %4
+      : "rm"(x),           // %5
+        "rm"(dx)           // %6
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEUVFILTERCOLS_SSSE3
+
+#ifdef HAS_SCALEUVROWDOWN2_16_SSE2
+// The 16 bit UV scalers reorder the words of 2 UV pairs from UVUV to UUVV so
+// pmaddwd adds the U and V channels of neighbouring pixels. Words are biased
+// by 0x8000 to be signed, as in ScaleRowDown2Box_16_SSE2.
+void ScaleUVRowDown2Linear_16_SSE2(const uint16_t* src_uv,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_uv,
+                                   int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"
+      "psllw     $0xf,%%xmm4                     \n"  // 0x8000
+      "pcmpeqb   %%xmm5,%%xmm5                   \n"
+      "psrlw     $0xf,%%xmm5                     \n"  // 0x00010001
+      "movdqa    %%xmm5,%%xmm3                   \n"
+      "psrld     $0x10,%%xmm3                    \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshuflw   $0xd8,%%xmm0,%%xmm0             \n"  // UUVV
+      "pshufhw   $0xd8,%%xmm0,%%xmm0             \n"
+      "pshuflw   $0xd8,%%xmm1,%%xmm1             \n"
+      "pshufhw   $0xd8,%%xmm1,%%xmm1             \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm1                   \n"
+      "pmaddwd   %%xmm5,%%xmm0                   \n"
+      "pmaddwd   %%xmm5,%%xmm1                   \n"
+      "paddd     %%xmm3,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm1                   \n"
+      "psrad     $0x1,%%xmm0                     \n"
+      "psrad     $0x1,%%xmm1                     \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x4,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_uv),    // %0
+        "+r"(dst_uv),    // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5");
+}
+
+void ScaleUVRowDown2Box_16_SSE2(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                uint16_t* dst_uv,
+                                int dst_width) {
+  asm volatile(
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"
+      "psllw     $0xf,%%xmm4                     \n"  // 0x8000
+      "pcmpeqb   %%xmm5,%%xmm5                   \n"
+      "psrlw     $0xf,%%xmm5                     \n"  // 0x00010001
+      "movdqa    %%xmm5,%%xmm6                   \n"
+      "psrld     $0xf,%%xmm6                     \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu    (%0),%%xmm0                     \n"
+      "movdqu    0x10(%0),%%xmm1                 \n"
+      "movdqu    0x00(%0,%3,2),%%xmm2            \n"
+      "movdqu    0x10(%0,%3,2),%%xmm3            \n"
+      "lea       0x20(%0),%0                     \n"
+      "pshuflw   $0xd8,%%xmm0,%%xmm0             \n"  // UUVV
+      "pshufhw   $0xd8,%%xmm0,%%xmm0             \n"
+      "pshuflw   $0xd8,%%xmm1,%%xmm1             \n"
+      "pshufhw   $0xd8,%%xmm1,%%xmm1             \n"
+      "pshuflw   $0xd8,%%xmm2,%%xmm2             \n"
+      "pshufhw   $0xd8,%%xmm2,%%xmm2             \n"
+      "pshuflw   $0xd8,%%xmm3,%%xmm3             \n"
+      "pshufhw   $0xd8,%%xmm3,%%xmm3             \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm1                   \n"
+      "pxor      %%xmm4,%%xmm2                   \n"
+      "pxor      %%xmm4,%%xmm3                   \n"
+      "pmaddwd   %%xmm5,%%xmm0                   \n"
+      "pmaddwd   %%xmm5,%%xmm1                   \n"
+      "pmaddwd   %%xmm5,%%xmm2                   \n"
+      "pmaddwd   %%xmm5,%%xmm3                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm1                   \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%1)                     \n"
+      "lea       0x10(%1),%1                     \n"
+      "sub       $0x4,%2                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_uv),                // %0
+        "+r"(dst_uv),                // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEUVROWDOWN2_16_SSE2
+
+#ifdef HAS_SCALEUVROWDOWN2_16_AVX2
+void ScaleUVRowDown2Linear_16_AVX2(const uint16_t* src_uv,
+                                   ptrdiff_t src_stride,
+                                   uint16_t* dst_uv,
+                                   int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpsllw     $0xf,%%ymm4,%%ymm4             \n"  // 0x8000
+      "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpsrlw     $0xf,%%ymm5,%%ymm5             \n"  // 0x00010001
+      "vpsrld     $0x10,%%ymm5,%%ymm3            \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpshuflw   $0xd8,(%0),%%ymm0              \n"  // UUVV
+      "vpshuflw   $0xd8,0x20(%0),%%ymm1          \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpshufhw   $0xd8,%%ymm0,%%ymm0            \n"
+      "vpshufhw   $0xd8,%%ymm1,%%ymm1            \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm4,%%ymm1,%%ymm1           \n"
+      "vpmaddwd   %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpaddd     %%ymm3,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm3,%%ymm1,%%ymm1           \n"
+      "vpsrad     $0x1,%%ymm0,%%ymm0             \n"
+      "vpsrad     $0x1,%%ymm1,%%ymm1             \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x8,%2                        \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_uv),    // %0
+        "+r"(dst_uv),    // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5");
+}
+
+void ScaleUVRowDown2Box_16_AVX2(const uint16_t* src_uv,
+                                ptrdiff_t src_stride,
+                                uint16_t* dst_uv,
+                                int dst_width) {
+  asm volatile(
+      "vpcmpeqb   %%ymm4,%%ymm4,%%ymm4           \n"
+      "vpsllw     $0xf,%%ymm4,%%ymm4             \n"  // 0x8000
+      "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpsrlw     $0xf,%%ymm5,%%ymm5             \n"  // 0x00010001
+      "vpsrld     $0xf,%%ymm5,%%ymm6             \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpshuflw   $0xd8,(%0),%%ymm0              \n"  // UUVV
+      "vpshuflw   $0xd8,0x20(%0),%%ymm1          \n"
+      "vpshuflw   $0xd8,0x00(%0,%3,2),%%ymm2     \n"
+      "vpshuflw   $0xd8,0x20(%0,%3,2),%%ymm3     \n"
+      "lea        0x40(%0),%0                    \n"
+      "vpshufhw   $0xd8,%%ymm0,%%ymm0            \n"
+      "vpshufhw   $0xd8,%%ymm1,%%ymm1            \n"
+      "vpshufhw   $0xd8,%%ymm2,%%ymm2            \n"
+      "vpshufhw   $0xd8,%%ymm3,%%ymm3            \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm4,%%ymm1,%%ymm1           \n"
+      "vpxor      %%ymm4,%%ymm2,%%ymm2           \n"
+      "vpxor      %%ymm4,%%ymm3,%%ymm3           \n"
+      "vpmaddwd   %%ymm5,%%ymm0,%%ymm0           \n"
+      "vpmaddwd   %%ymm5,%%ymm1,%%ymm1           \n"
+      "vpmaddwd   %%ymm5,%%ymm2,%%ymm2           \n"
+      "vpmaddwd   %%ymm5,%%ymm3,%%ymm3           \n"
+      "vpaddd     %%ymm2,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm3,%%ymm1,%%ymm1           \n"
+      "vpaddd     %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm6,%%ymm1,%%ymm1           \n"
+      "vpsrad     $0x2,%%ymm0,%%ymm0             \n"
+      "vpsrad     $0x2,%%ymm1,%%ymm1             \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"
+      "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+      "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x8,%2                        \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_uv),                // %0
+        "+r"(dst_uv),                // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEUVROWDOWN2_16_AVX2
+
+#ifdef HAS_SCALEUVROWDOWNEVENBOX_16_SSE2
+// Each destination pixel boxes 2 UV pairs, read as a qword, from 2 rows.
+void ScaleUVRowDownEvenBox_16_SSE2(const uint16_t* src_uv,
+                                   ptrdiff_t src_stride,
+                                   int src_stepx,
+                                   uint16_t* dst_uv,
+                                   int dst_width) {
+  intptr_t src_stepx_x4 = (intptr_t)(src_stepx);
+  intptr_t src_stepx_x12;
+  intptr_t row1 = (intptr_t)(src_stride);
+  asm volatile(
+      "lea       0x00(,%1,4),%1                  \n"
+      "lea       0x00(%1,%1,2),%4                \n"
+      "lea       0x00(%0,%5,2),%5                \n"
+      "pcmpeqb   %%xmm4,%%xmm4                   \n"
+      "psllw     $0xf,%%xmm4                     \n"  // 0x8000
+      "pcmpeqb   %%xmm5,%%xmm5                   \n"
+      "psrlw     $0xf,%%xmm5                     \n"  // 0x00010001
+      "movdqa    %%xmm5,%%xmm6                   \n"
+      "psrld     $0xf,%%xmm6                     \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "movq      (%0),%%xmm0                     \n"
+      "movhps    0x00(%0,%1,1),%%xmm0            \n"
+      "movq      0x00(%0,%1,2),%%xmm1            \n"
+      "movhps    0x00(%0,%4,1),%%xmm1            \n"
+      "lea       0x00(%0,%1,4),%0                \n"
+      "movq      (%5),%%xmm2                     \n"
+      "movhps    0x00(%5,%1,1),%%xmm2            \n"
+      "movq      0x00(%5,%1,2),%%xmm3            \n"
+      "movhps    0x00(%5,%4,1),%%xmm3            \n"
+      "lea       0x00(%5,%1,4),%5                \n"
+      "pshuflw   $0xd8,%%xmm0,%%xmm0             \n"  // UUVV
+      "pshufhw   $0xd8,%%xmm0,%%xmm0             \n"
+      "pshuflw   $0xd8,%%xmm1,%%xmm1             \n"
+      "pshufhw   $0xd8,%%xmm1,%%xmm1             \n"
+      "pshuflw   $0xd8,%%xmm2,%%xmm2             \n"
+      "pshufhw   $0xd8,%%xmm2,%%xmm2             \n"
+      "pshuflw   $0xd8,%%xmm3,%%xmm3             \n"
+      "pshufhw   $0xd8,%%xmm3,%%xmm3             \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm1                   \n"
+      "pxor      %%xmm4,%%xmm2                   \n"
+      "pxor      %%xmm4,%%xmm3                   \n"
+      "pmaddwd   %%xmm5,%%xmm0                   \n"
+      "pmaddwd   %%xmm5,%%xmm1                   \n"
+      "pmaddwd   %%xmm5,%%xmm2                   \n"
+      "pmaddwd   %%xmm5,%%xmm3                   \n"
+      "paddd     %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm1                   \n"
+      "paddd     %%xmm6,%%xmm0                   \n"
+      "paddd     %%xmm6,%%xmm1                   \n"
+      "psrad     $0x2,%%xmm0                     \n"
+      "psrad     $0x2,%%xmm1                     \n"
+      "packssdw  %%xmm1,%%xmm0                   \n"
+      "pxor      %%xmm4,%%xmm0                   \n"
+      "movdqu    %%xmm0,(%2)                     \n"
+      "lea       0x10(%2),%2                     \n"
+      "sub       $0x4,%3                         \n"
+      "jg        1b                              \n"
+      : "+r"(src_uv),          // %0
+        "+r"(src_stepx_x4),    // %1
+        "+r"(dst_uv),          // %2
+        "+rm"(dst_width),      // %3
+        "=&r"(src_stepx_x12),  // %4
+        "+r"(row1)             // %5
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
+}
+#endif  // HAS_SCALEUVROWDOWNEVENBOX_16_SSE2
+
+#ifdef HAS_SCALEUVFILTERCOLS_16_SSSE3
+// Shuffle table for arranging the 2 UV pairs a and b of 2 pixels as
+// Ua Ub Va Vb.
+static const uvec8 kShuffleColUV_16 = {0u, 1u, 4u,  5u,  2u,  3u,  6u,  7u,
+                                       8u, 9u, 12u, 13u, 10u, 11u, 14u, 15u};
+
+// Shuffle table for duplicating the fractions of 2 pixels into 4 words each.
+static const uvec8 kShuffleFractionsUV_16 = {0u, 1u, 0u, 1u, 0u, 1u, 0u, 1u,
+                                             4u, 5u, 4u, 5u, 4u, 5u, 4u, 5u};
+
+// Bilinear column filtering of 16 bit UV pairs. Same 16 bit blend as
+// ScaleFilterCols_16_SSSE3: f * b - f * a is exact modulo 2^32, so adding a
+// to the rounded top half gives the C result.
+void ScaleUVFilterCols_16_SSSE3(uint16_t* dst_uv,
+                                const uint16_t* src_uv,
+                                int dst_width,
+                                int x,
+                                int dx) {
+  intptr_t x0, x1;
+  asm volatile(
+      "movd      %5,%%xmm2                       \n"
+      "movd      %6,%%xmm3                       \n"
+      "pcmpeqb   %%xmm7,%%xmm7                   \n"
+      "psrld     $0x1f,%%xmm7                    \n"
+      "pslld     $0xf,%%xmm7                     \n"  // 0x8000
+      "movdqa    %8,%%xmm5                       \n"
+
+      "pextrw    $0x1,%%xmm2,%k2                 \n"
+      "subl      $0x2,%4                         \n"
+      "jl        29f                             \n"
+      "movdqa    %%xmm2,%%xmm0                   \n"
+      "paddd     %%xmm3,%%xmm0                   \n"
+      "punpckldq %%xmm0,%%xmm2                   \n"
+      "punpckldq %%xmm3,%%xmm3                   \n"
+      "paddd     %%xmm3,%%xmm3                   \n"
+      "pextrw    $0x3,%%xmm2,%k3                 \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movq      0x00(%1,%2,4),%%xmm0            \n"
+      "movq      0x00(%1,%3,4),%%xmm4            \n"
+      "movdqa    %%xmm2,%%xmm1                   \n"
+      "paddd     %%xmm3,%%xmm2                   \n"
+      "punpcklqdq %%xmm4,%%xmm0                  \n"
+      "pshufb    %%xmm5,%%xmm1                   \n"  // f0 x 4, f1 x 4
+      "pshufb    %7,%%xmm0                       \n"  // Ua Ub Va Vb
+      "movdqa    %%xmm0,%%xmm4                   \n"
+      "pmulhuw   %%xmm1,%%xmm4                   \n"
+      "pmullw    %%xmm0,%%xmm1                   \n"
+      "movdqa    %%xmm1,%%xmm6                   \n"
+      "punpcklwd %%xmm4,%%xmm1                   \n"  // f * Ua, f * Ub ...
+      "punpckhwd %%xmm4,%%xmm6                   \n"
+      "pshufd    $0xb1,%%xmm1,%%xmm4             \n"
+      "psubd     %%xmm1,%%xmm4                   \n"  // f * (b - a)
+      "pshufd    $0xb1,%%xmm6,%%xmm1             \n"
+      "psubd     %%xmm6,%%xmm1                   \n"
+      "shufps    $0x88,%%xmm1,%%xmm4             \n"  // U0 V0 U1 V1
+      "paddd     %%xmm7,%%xmm4                   \n"
+      "psrld     $0x10,%%xmm4                    \n"
+      "paddw     %%xmm0,%%xmm4                   \n"  // + a in the low words
+      "pslld     $0x10,%%xmm4                    \n"
+      "psrad     $0x10,%%xmm4                    \n"
+      "packssdw  %%xmm4,%%xmm4                   \n"
+      "pextrw    $0x1,%%xmm2,%k2                 \n"
+      "pextrw    $0x3,%%xmm2,%k3                 \n"
+      "movq      %%xmm4,(%0)                     \n"
+      "lea       0x8(%0),%0                      \n"
+      "subl      $0x2,%4                         \n"
+      "jge       2b                              \n"
+
+      LABELALIGN
+      "29:                                       \n"
+      "addl      $0x1,%4                         \n"
+      "jl        99f                             \n"
+      "movq      0x00(%1,%2,4),%%xmm0            \n"
+      "pshufb    %%xmm5,%%xmm2                   \n"
+      "pshufb    %7,%%xmm0                       \n"
+      "movdqa    %%xmm0,%%xmm4                   \n"
+      "pmulhuw   %%xmm2,%%xmm4                   \n"
+      "pmullw    %%xmm0,%%xmm2                   \n"
+      "punpcklwd %%xmm4,%%xmm2                   \n"
+      "pshufd    $0xb1,%%xmm2,%%xmm4             \n"
+      "psubd     %%xmm2,%%xmm4                   \n"
+      "paddd     %%xmm7,%%xmm4                   \n"
+      "psrld     $0x10,%%xmm4                    \n"
+      "pshufd    $0x8,%%xmm4,%%xmm4              \n"  // U V
+      "paddw     %%xmm0,%%xmm4                   \n"
+      "pslld     $0x10,%%xmm4                    \n"
+      "psrad     $0x10,%%xmm4                    \n"
+      "packssdw  %%xmm4,%%xmm4                   \n"
+      "movd      %%xmm4,(%0)                     \n"
+      "99:                                       \n"
+      : "+r"(dst_uv),  // %0
+        "+r"(src_uv),  // %1
+        "=&r"(x0),     // %2
+        "=&r"(x1),     // %3
+#if defined(__x86_64__)
+        "+rm"(dst_width)  // %4
+#else
+        "+m"(dst_width)  // %4
+#endif
+      : "rm"(x),                      // %5
+        "rm"(dx),                     // %6
+        "m"(kShuffleColUV_16),        // %7
+        "m"(kShuffleFractionsUV_16)   // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEUVFILTERCOLS_16_SSSE3
+
+#ifdef HAS_SCALEPOLYPHASEROWS_SSE2
+// Filter 16 pixels from 2 rows at a time. Bytes of the rows are interleaved
+// and pmaddwd with a pair of 2.14 weights sums them into 32 bits.
+// An odd last tap reads its row twice with a weight of 0 for the copy.
+void ScalePolyphaseRows_SSE2(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint8_t* dst_ptr,
+                             int dst_width) {
+  const uint8_t* src_tap;
+  const int16_t* filter_tap;
+  int taps;
+  asm volatile(
+      "pxor       %%xmm5,%%xmm5                  \n"
+      "pcmpeqb    %%xmm11,%%xmm11                \n"
+      "psrld      $0x1f,%%xmm11                  \n"
+      "pslld      $0xd,%%xmm11                   \n"  // 8192 to round
+
+      LABELALIGN
+      "1:                                        \n"
+      "mov        %0,%3                          \n"
+      "mov        %7,%4                          \n"
+      "mov        %8,%5                          \n"
+      "pxor       %%xmm0,%%xmm0                  \n"
+      "pxor       %%xmm1,%%xmm1                  \n"
+      "pxor       %%xmm2,%%xmm2                  \n"
+      "pxor       %%xmm3,%%xmm3                  \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movdqu     (%3),%%xmm6                    \n"
+      "movdqa     %%xmm6,%%xmm7                  \n"
+      "cmp        $0x1,%5                        \n"
+      "je         3f                             \n"
+      "movdqu     0x00(%3,%6,1),%%xmm7           \n"
+      "3:                                        \n"
+      "lea        0x00(%3,%6,2),%3               \n"
+      "movd       (%4),%%xmm4                    \n"
+      "pshufd     $0x0,%%xmm4,%%xmm4             \n"
+      "lea        0x4(%4),%4                     \n"
+      "movdqa     %%xmm6,%%xmm8                  \n"
+      "punpcklbw  %%xmm7,%%xmm6                  \n"
+      "punpckhbw  %%xmm7,%%xmm8                  \n"
+      "movdqa     %%xmm6,%%xmm9                  \n"
+      "punpcklbw  %%xmm5,%%xmm6                  \n"
+      "punpckhbw  %%xmm5,%%xmm9                  \n"
+      "movdqa     %%xmm8,%%xmm10                 \n"
+      "punpcklbw  %%xmm5,%%xmm8                  \n"
+      "punpckhbw  %%xmm5,%%xmm10                 \n"
+      "pmaddwd    %%xmm4,%%xmm6                  \n"
+      "pmaddwd    %%xmm4,%%xmm9                  \n"
+      "pmaddwd    %%xmm4,%%xmm8                  \n"
+      "pmaddwd    %%xmm4,%%xmm10                 \n"
+      "paddd      %%xmm6,%%xmm0                  \n"
+      "paddd      %%xmm9,%%xmm1                  \n"
+      "paddd      %%xmm8,%%xmm2                  \n"
+      "paddd      %%xmm10,%%xmm3                 \n"
+      "sub        $0x2,%5                        \n"
+      "jg         2b                             \n"
+
+      "paddd      %%xmm11,%%xmm0                 \n"
+      "paddd      %%xmm11,%%xmm1                 \n"
+      "paddd      %%xmm11,%%xmm2                 \n"
+      "paddd      %%xmm11,%%xmm3                 \n"
+      "psrad      $0xe,%%xmm0                    \n"
+      "psrad      $0xe,%%xmm1                    \n"
+      "psrad      $0xe,%%xmm2                    \n"
+      "psrad      $0xe,%%xmm3                    \n"
+      "packssdw   %%xmm1,%%xmm0                  \n"
+      "packssdw   %%xmm3,%%xmm2                  \n"
+      "packuswb   %%xmm2,%%xmm0                  \n"
+      "movdqu     %%xmm0,(%1)                    \n"
+      "lea        0x10(%0),%0                    \n"
+      "lea        0x10(%1),%1                    \n"
+      "sub        $0x10,%2                       \n"
+      "jg         1b                             \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width),              // %2
+        "=&r"(src_tap),               // %3
+        "=&r"(filter_tap),            // %4
+        "=&r"(taps)                   // %5
+      : "r"((intptr_t)(src_stride)),  // %6
+        "r"(filter),                  // %7
+        "rm"(filter_taps)             // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11");
+}
+#endif  // HAS_SCALEPOLYPHASEROWS_SSE2
+
+#ifdef HAS_SCALEPOLYPHASEROWS_AVX2
+void ScalePolyphaseRows_AVX2(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             const int16_t* filter,
+                             int filter_taps,
+                             uint8_t* dst_ptr,
+                             int dst_width) {
+  const uint8_t* src_tap;
+  const int16_t* filter_tap;
+  int taps;
+  asm volatile(
+      "vpxor      %%ymm5,%%ymm5,%%ymm5           \n"
+      "vpcmpeqb   %%ymm11,%%ymm11,%%ymm11        \n"
+      "vpsrld     $0x1f,%%ymm11,%%ymm11          \n"
+      "vpslld     $0xd,%%ymm11,%%ymm11           \n"  // 8192 to round
+
+      LABELALIGN
+      "1:                                        \n"
+      "mov        %0,%3                          \n"
+      "mov        %7,%4                          \n"
+      "mov        %8,%5                          \n"
+      "vpxor      %%ymm0,%%ymm0,%%ymm0           \n"
+      "vpxor      %%ymm1,%%ymm1,%%ymm1           \n"
+      "vpxor      %%ymm2,%%ymm2,%%ymm2           \n"
+      "vpxor      %%ymm3,%%ymm3,%%ymm3           \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "vmovdqu    (%3),%%ymm6                    \n"
+      "vmovdqa    %%ymm6,%%ymm7                  \n"
+      "cmp        $0x1,%5                        \n"
+      "je         3f                             \n"
+      "vmovdqu    0x00(%3,%6,1),%%ymm7           \n"
+      "3:                                        \n"
+      "lea        0x00(%3,%6,2),%3               \n"
+      "vpbroadcastd (%4),%%ymm4                  \n"
+      "lea        0x4(%4),%4                     \n"
+      "vpunpckhbw %%ymm7,%%ymm6,%%ymm8           \n"  // mutates
+      "vpunpcklbw %%ymm7,%%ymm6,%%ymm6           \n"
+      "vpunpckhbw %%ymm5,%%ymm6,%%ymm9           \n"
+      "vpunpcklbw %%ymm5,%%ymm6,%%ymm6           \n"
+      "vpunpckhbw %%ymm5,%%ymm8,%%ymm10          \n"
+      "vpunpcklbw %%ymm5,%%ymm8,%%ymm8           \n"
+      "vpmaddwd   %%ymm4,%%ymm6,%%ymm6           \n"
+      "vpmaddwd   %%ymm4,%%ymm9,%%ymm9           \n"
+      "vpmaddwd   %%ymm4,%%ymm8,%%ymm8           \n"
+      "vpmaddwd   %%ymm4,%%ymm10,%%ymm10         \n"
+      "vpaddd     %%ymm6,%%ymm0,%%ymm0           \n"
+      "vpaddd     %%ymm9,%%ymm1,%%ymm1           \n"
+      "vpaddd     %%ymm8,%%ymm2,%%ymm2           \n"
+      "vpaddd     %%ymm10,%%ymm3,%%ymm3          \n"
+      "sub        $0x2,%5                        \n"
+      "jg         2b                             \n"
+
+      "vpaddd     %%ymm11,%%ymm0,%%ymm0          \n"
+      "vpaddd     %%ymm11,%%ymm1,%%ymm1          \n"
+      "vpaddd     %%ymm11,%%ymm2,%%ymm2          \n"
+      "vpaddd     %%ymm11,%%ymm3,%%ymm3          \n"
+      "vpsrad     $0xe,%%ymm0,%%ymm0             \n"
+      "vpsrad     $0xe,%%ymm1,%%ymm1             \n"
+      "vpsrad     $0xe,%%ymm2,%%ymm2             \n"
+      "vpsrad     $0xe,%%ymm3,%%ymm3             \n"
+      "vpackssdw  %%ymm1,%%ymm0,%%ymm0           \n"  // unmutates
+      "vpackssdw  %%ymm3,%%ymm2,%%ymm2           \n"
+      "vpackuswb  %%ymm2,%%ymm0,%%ymm0           \n"
+      "vmovdqu    %%ymm0,(%1)                    \n"
+      "lea        0x20(%0),%0                    \n"
+      "lea        0x20(%1),%1                    \n"
+      "sub        $0x20,%2                       \n"
+      "jg         1b                             \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width),              // %2
+        "=&r"(src_tap),               // %3
+        "=&r"(filter_tap),            // %4
+        "=&r"(taps)                   // %5
+      : "r"((intptr_t)(src_stride)),  // %6
+        "r"(filter),                  // %7
+        "rm"(filter_taps)             // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11");
+}
+#endif  // HAS_SCALEPOLYPHASEROWS_AVX2
+
+#ifdef HAS_SCALEPOLYPHASECOLS_SSSE3
+// Filter 4 pixels at a time from 8 taps at a time, then phaddd the sums of
+// the 4 pixels together. filter_taps is a multiple of 8 and each row of
+// filter is 16 byte aligned.
+void ScalePolyphaseCols_SSSE3(uint8_t* dst_ptr,
+                              const uint8_t* src_ptr,
+                              int dst_width,
+                              const int* offsets,
+                              const int16_t* filter,
+                              int filter_taps) {
+  intptr_t src_tap0, src_tap1, src_tap2, src_tap3;
+  const int16_t* filter3;
+  int taps;
+  asm volatile(
+      "pxor       %%xmm7,%%xmm7                  \n"
+      "pcmpeqb    %%xmm6,%%xmm6                  \n"
+      "psrld      $0x1f,%%xmm6                   \n"
+      "pslld      $0xd,%%xmm6                    \n"  // 8192 to round
+
+      LABELALIGN
+      "1:                                        \n"
+      "movslq     (%1),%4                        \n"
+      "movslq     0x4(%1),%5                     \n"
+      "movslq     0x8(%1),%6                     \n"
+      "movslq     0xc(%1),%7                     \n"
+      "lea        0x10(%1),%1                    \n"
+      "add        %10,%4                         \n"
+      "add        %10,%5                         \n"
+      "add        %10,%6                         \n"
+      "add        %10,%7                         \n"
+      "lea        0x00(%2,%11,2),%9              \n"
+      "add        %11,%9                         \n"
+      "mov        %12,%8                         \n"
+      "pxor       %%xmm0,%%xmm0                  \n"
+      "pxor       %%xmm1,%%xmm1                  \n"
+      "pxor       %%xmm2,%%xmm2                  \n"
+      "pxor       %%xmm3,%%xmm3                  \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movq       (%4),%%xmm4                    \n"
+      "punpcklbw  %%xmm7,%%xmm4                  \n"
+      "pmaddwd    (%2),%%xmm4                    \n"
+      "paddd      %%xmm4,%%xmm0                  \n"
+      "movq       (%5),%%xmm5                    \n"
+      "punpcklbw  %%xmm7,%%xmm5                  \n"
+      "pmaddwd    0x00(%2,%11,1),%%xmm5          \n"
+      "paddd      %%xmm5,%%xmm1                  \n"
+      "movq       (%6),%%xmm4                    \n"
+      "punpcklbw  %%xmm7,%%xmm4                  \n"
+      "pmaddwd    0x00(%2,%11,2),%%xmm4          \n"
+      "paddd      %%xmm4,%%xmm2                  \n"
+      "movq       (%7),%%xmm5                    \n"
+      "punpcklbw  %%xmm7,%%xmm5                  \n"
+      "pmaddwd    (%9),%%xmm5                    \n"
+      "paddd      %%xmm5,%%xmm3                  \n"
+      "lea        0x8(%4),%4                     \n"
+      "lea        0x8(%5),%5                     \n"
+      "lea        0x8(%6),%6                     \n"
+      "lea        0x8(%7),%7                     \n"
+      "lea        0x10(%2),%2                    \n"
+      "lea        0x10(%9),%9                    \n"
+      "sub        $0x8,%8                        \n"
+      "jg         2b                             \n"
+
+      "phaddd     %%xmm1,%%xmm0                  \n"
+      "phaddd     %%xmm3,%%xmm2                  \n"
+      "phaddd     %%xmm2,%%xmm0                  \n"
+      "paddd      %%xmm6,%%xmm0                  \n"
+      "psrad      $0xe,%%xmm0                    \n"
+      "packssdw   %%xmm0,%%xmm0                  \n"
+      "packuswb   %%xmm0,%%xmm0                  \n"
+      "movd       %%xmm0,(%0)                    \n"
+      "mov        %9,%2                          \n"  // filter of next pixel
+      "lea        0x4(%0),%0                     \n"
+      "sub        $0x4,%3                        \n"
+      "jg         1b                             \n"
+      : "+r"(dst_ptr),                        // %0
+        "+r"(offsets),                        // %1
+        "+r"(filter),                         // %2
+        "+r"(dst_width),                      // %3
+        "=&r"(src_tap0),                      // %4
+        "=&r"(src_tap1),                      // %5
+        "=&r"(src_tap2),                      // %6
+        "=&r"(src_tap3),                      // %7
+        "=&r"(taps),                          // %8
+        "=&r"(filter3)                        // %9
+      : "r"(src_ptr),                         // %10
+        "r"((intptr_t)(filter_taps) * 2),     // %11
+        "m"(filter_taps)                      // %12
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEPOLYPHASECOLS_SSSE3
+
+#ifdef HAS_SCALEARGBPOLYPHASECOLS_SSSE3
+// Shuffle 2 ARGB pixels to words of B0 B1 G0 G1 R0 R1 A0 A1.
+static const uvec8 kShuffleARGBPolyphase = {0u, 128u, 4u, 128u, 1u, 128u,
+                                            5u, 128u, 2u, 128u, 6u, 128u,
+                                            3u, 128u, 7u, 128u};
+
+// Filter 1 ARGB pixel at a time from 2 taps at a time.
+void ScaleARGBPolyphaseCols_SSSE3(uint8_t* dst_argb,
+                                  const uint8_t* src_argb,
+                                  int dst_width,
+                                  const int* offsets,
+                                  const int16_t* filter,
+                                  int filter_taps) {
+  intptr_t src_tap;
+  int taps;
+  asm volatile(
+      "movdqa     %8,%%xmm5                      \n"
+      "pcmpeqb    %%xmm6,%%xmm6                  \n"
+      "psrld      $0x1f,%%xmm6                   \n"
+      "pslld      $0xd,%%xmm6                    \n"  // 8192 to round
+
+      LABELALIGN
+      "1:                                        \n"
+      "movslq     (%1),%4                        \n"
+      "lea        0x4(%1),%1                     \n"
+      "lea        0x00(%6,%4,4),%4               \n"
+      "mov        %7,%5                          \n"
+      "pxor       %%xmm0,%%xmm0                  \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movq       (%4),%%xmm1                    \n"
+      "pshufb     %%xmm5,%%xmm1                  \n"
+      "movd       (%2),%%xmm2                    \n"
+      "pshufd     $0x0,%%xmm2,%%xmm2             \n"
+      "pmaddwd    %%xmm2,%%xmm1                  \n"
+      "paddd      %%xmm1,%%xmm0                  \n"
+      "lea        0x8(%4),%4                     \n"
+      "lea        0x4(%2),%2                     \n"
+      "sub        $0x2,%5                        \n"
+      "jg         2b                             \n"
+
+      "paddd      %%xmm6,%%xmm0                  \n"
+      "psrad      $0xe,%%xmm0                    \n"
+      "packssdw   %%xmm0,%%xmm0                  \n"
+      "packuswb   %%xmm0,%%xmm0                  \n"
+      "movd       %%xmm0,(%0)                    \n"
+      "lea        0x4(%0),%0                     \n"
+      "sub        $0x1,%3                        \n"
+      "jg         1b                             \n"
+      : "+r"(dst_argb),              // %0
+        "+r"(offsets),               // %1
+        "+r"(filter),                // %2
+        "+r"(dst_width),             // %3
+        "=&r"(src_tap),              // %4
+        "=&r"(taps)                  // %5
+      : "r"(src_argb),               // %6
+        "rm"(filter_taps),           // %7
+        "m"(kShuffleARGBPolyphase)   // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm5", "xmm6");
+}
+#endif  // HAS_SCALEARGBPOLYPHASECOLS_SSSE3
+
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
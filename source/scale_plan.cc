@@ -0,0 +1,245 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/scale_plan.h"
+
+#include <stdlib.h>  // For malloc.
+
+#include "executor_internal.h"
+#include "libyuv/row.h"
+#include "libyuv/scale_row.h"
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+static __inline int Abs(int v) {
+  return v >= 0 ? v : -v;
+}
+
+#define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
+
+struct ScalePlan {
+  uint32_t fourcc;
+  int num_planes;
+  ScalePlaneSetup planes[3];
+  ScaleARGBSetup argb;
+  uint8_t* tables_mem[2];  // Polyphase tables, unaligned.
+};
+
+// Allocate polyphase tables for the life of the plan.
+static uint8_t* ScalePlanTables(ScalePlan* plan, int index, size_t size) {
+  plan->tables_mem[index] = (uint8_t*)malloc(size + 63); /* NOLINT */
+  if (!plan->tables_mem[index]) {
+    return NULL;
+  }
+  return (uint8_t*)(((intptr_t)(plan->tables_mem[index]) + 63) & ~63);
+}
+
+// The polyphase tables of a plane cover all rows so any band can be scaled.
+static int ScalePlanPlaneInit(ScalePlan* plan,
+                              int index,
+                              int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              enum FilterMode filtering) {
+  ScalePlaneSetup* setup = &plan->planes[index];
+  uint8_t* tables;
+  ScalePlaneSetupInit(setup, src_width, src_height, dst_width, dst_height,
+                      filtering);
+  if (!ScalePlaneSetupPolyphase(setup)) {
+    return 0;
+  }
+  src_height = Abs(src_height);
+  tables = ScalePlanTables(
+      plan, index,
+      ScalePolyphaseSize(src_width, src_height, dst_width, dst_height,
+                         dst_width, dst_height, 1, setup->filtering));
+  if (!tables) {
+    return -1;
+  }
+  ScalePolyphaseInit(&setup->polyphase, tables, src_width, src_height,
+                     dst_width, dst_height, 0, dst_width, 0, dst_height, 1,
+                     setup->filtering);
+  return 0;
+}
+
+static int ScalePlanARGBInit(ScalePlan* plan,
+                             int src_width,
+                             int src_height,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering) {
+  ScaleARGBSetup* setup = &plan->argb;
+  uint8_t* tables;
+  ScaleARGBSetupInit(setup, src_width, src_height, dst_width, dst_height, 0, 0,
+                     dst_width, dst_height, filtering);
+  if (!ScaleARGBSetupPolyphase(setup)) {
+    return 0;
+  }
+  src_height = Abs(src_height);
+  tables = ScalePlanTables(
+      plan, 0,
+      ScalePolyphaseSize(src_width, src_height, dst_width, dst_height,
+                         dst_width, dst_height, 4, setup->filtering));
+  if (!tables) {
+    return -1;
+  }
+  ScalePolyphaseInit(&setup->polyphase, tables, src_width, src_height,
+                     dst_width, dst_height, 0, dst_width, 0, dst_height, 4,
+                     setup->filtering);
+  return 0;
+}
+
+LIBYUV_API
+ScalePlan* CreateScalePlan(uint32_t fourcc,
+                           int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering) {
+  ScalePlan* plan;
+  int r = -1;
+  if (src_width == 0 || src_height == 0 || src_width > 32768 ||
+      src_height > 32768 || dst_width <= 0 || dst_height <= 0) {
+    return NULL;
+  }
+  if (fourcc != FOURCC_I400 && fourcc != FOURCC_I420 &&
+      fourcc != FOURCC_ARGB) {
+    return NULL;
+  }
+  plan = (ScalePlan*)calloc(1, sizeof(ScalePlan));
+  if (!plan) {
+    return NULL;
+  }
+  plan->fourcc = fourcc;
+  if (fourcc == FOURCC_ARGB) {
+    r = ScalePlanARGBInit(plan, src_width, src_height, dst_width, dst_height,
+                          filtering);
+  } else {
+    int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+    int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+    int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+    int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+    plan->num_planes = fourcc == FOURCC_I420 ? 3 : 1;
+    r = ScalePlanPlaneInit(plan, 0, src_width, src_height, dst_width,
+                           dst_height, filtering);
+    if (r == 0 && plan->num_planes == 3) {
+      r = ScalePlanPlaneInit(plan, 1, src_halfwidth, src_halfheight,
+                             dst_halfwidth, dst_halfheight, filtering);
+      // U and V share the setup and its tables.
+      plan->planes[2] = plan->planes[1];
+    }
+  }
+  if (r != 0) {
+    DestroyScalePlan(plan);
+    return NULL;
+  }
+  return plan;
+}
+
+LIBYUV_API
+void DestroyScalePlan(ScalePlan* plan) {
+  if (plan) {
+    free(plan->tables_mem[0]);
+    free(plan->tables_mem[1]);
+    free(plan);
+  }
+}
+
+// A plane of a frame scaled with a plan.
+typedef struct {
+  const ScalePlaneSetup* setup;
+  const uint8_t* src;
+  int src_stride;
+  uint8_t* dst;
+  int dst_stride;
+} ScalePlanJob;
+
+static void ScalePlanRows(void* arg, int begin, int end) {
+  const ScalePlanJob* job = static_cast<const ScalePlanJob*>(arg);
+  ScalePlaneSetupRun(job->setup, job->src, job->src_stride,
+                     job->dst + begin * (intptr_t)job->dst_stride,
+                     job->dst_stride, begin, end - begin);
+}
+
+static void ScalePlanPlane(const ScalePlaneSetup* setup,
+                           const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst,
+                           int dst_stride) {
+  ScalePlanJob job = {setup, src, src_stride, dst, dst_stride};
+  // Bands start on a row group of the 3/4 and 3/8 scalers.
+  if (ParallelRows(setup->dst_width, setup->dst_height, 3, ScalePlanRows,
+                   &job) == 0) {
+    return;
+  }
+  ScalePlaneSetupRun(setup, src, src_stride, dst, dst_stride, 0,
+                     setup->dst_height);
+}
+
+LIBYUV_API
+int ScalePlanI400(const ScalePlan* plan,
+                  const uint8_t* src_y,
+                  int src_stride_y,
+                  uint8_t* dst_y,
+                  int dst_stride_y) {
+  if (!plan || plan->fourcc != FOURCC_I400 || !src_y || !dst_y) {
+    return -1;
+  }
+  ScalePlanPlane(&plan->planes[0], src_y, src_stride_y, dst_y, dst_stride_y);
+  return 0;
+}
+
+LIBYUV_API
+int ScalePlanI420(const ScalePlan* plan,
+                  const uint8_t* src_y,
+                  int src_stride_y,
+                  const uint8_t* src_u,
+                  int src_stride_u,
+                  const uint8_t* src_v,
+                  int src_stride_v,
+                  uint8_t* dst_y,
+                  int dst_stride_y,
+                  uint8_t* dst_u,
+                  int dst_stride_u,
+                  uint8_t* dst_v,
+                  int dst_stride_v) {
+  if (!plan || plan->fourcc != FOURCC_I420 || !src_y || !src_u || !src_v ||
+      !dst_y || !dst_u || !dst_v) {
+    return -1;
+  }
+  ScalePlanPlane(&plan->planes[0], src_y, src_stride_y, dst_y, dst_stride_y);
+  ScalePlanPlane(&plan->planes[1], src_u, src_stride_u, dst_u, dst_stride_u);
+  ScalePlanPlane(&plan->planes[2], src_v, src_stride_v, dst_v, dst_stride_v);
+  return 0;
+}
+
+LIBYUV_API
+int ScalePlanARGB(const ScalePlan* plan,
+                  const uint8_t* src_argb,
+                  int src_stride_argb,
+                  uint8_t* dst_argb,
+                  int dst_stride_argb) {
+  if (!plan || plan->fourcc != FOURCC_ARGB || !src_argb || !dst_argb) {
+    return -1;
+  }
+  ScaleARGBSetupRun(&plan->argb, src_argb, src_stride_argb, dst_argb,
+                    dst_stride_argb);
+  return 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/scratch.h"
+
+#include <stdlib.h>  // For malloc.
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Buffers in the arena are 64 byte aligned.
+#define SCRATCH_ALIGN(size) (((size) + 63) & ~(size_t)63)
+
+struct LibyuvScratch {
+  uint8_t* mem;     // Allocated memory.
+  uint8_t* base;    // mem aligned to 64 bytes.
+  size_t size;      // Usable bytes at base.
+  size_t used;      // Bytes of the arena in use.
+  size_t needed;    // Bytes in use had every buffer fit in the arena.
+  size_t peak;      // Most bytes needed at once.
+  int num_buffers;  // Buffers in use in the arena.
+  // Buffers in use from malloc. Buffers allocated before the arena was set
+  // are freed without being counted, so this only resets needed.
+  int num_malloced;
+};
+
+static thread_local LibyuvScratch* thread_scratch = NULL;
+
+static void ScratchResize(LibyuvScratch* scratch, size_t size) {
+  free(scratch->mem);
+  scratch->mem = NULL;
+  scratch->base = NULL;
+  scratch->size = 0;
+  if (size) {
+    scratch->mem = (uint8_t*)malloc(size + 63); /* NOLINT */
+    if (scratch->mem) {
+      scratch->base = (uint8_t*)(((intptr_t)(scratch->mem) + 63) & ~63);
+      scratch->size = size;
+    }
+  }
+}
+
+LIBYUV_API
+LibyuvScratch* CreateScratch(size_t size) {
+  LibyuvScratch* scratch = (LibyuvScratch*)calloc(1, sizeof(LibyuvScratch));
+  if (scratch) {
+    ScratchResize(scratch, SCRATCH_ALIGN(size));
+  }
+  return scratch;
+}
+
+LIBYUV_API
+void DestroyScratch(LibyuvScratch* scratch) {
+  if (scratch) {
+    free(scratch->mem);
+    free(scratch);
+  }
+}
+
+LIBYUV_API
+void SetThreadScratch(LibyuvScratch* scratch) {
+  thread_scratch = scratch;
+}
+
+LIBYUV_API
+LibyuvScratch* GetThreadScratch(void) {
+  return thread_scratch;
+}
+
+LIBYUV_API
+size_t GetScratchPeak(const LibyuvScratch* scratch) {
+  return scratch ? scratch->peak : 0;
+}
+
+LIBYUV_API
+size_t GetScratchSize(const LibyuvScratch* scratch) {
+  return scratch ? scratch->size : 0;
+}
+
+LIBYUV_API
+void* ScratchAlloc(size_t size) {
+  LibyuvScratch* scratch = thread_scratch;
+  size_t aligned_size = SCRATCH_ALIGN(size);
+  if (!scratch) {
+    return malloc(size);
+  }
+  if (scratch->num_buffers == 0 && scratch->peak > scratch->size) {
+    ScratchResize(scratch, scratch->peak);
+  }
+  scratch->needed += aligned_size;
+  if (scratch->needed > scratch->peak) {
+    scratch->peak = scratch->needed;
+  }
+  if (scratch->used + aligned_size <= scratch->size) {
+    void* ptr = scratch->base + scratch->used;
+    scratch->used += aligned_size;
+    ++scratch->num_buffers;
+    return ptr;
+  }
+  {
+    void* ptr = malloc(size);
+    if (ptr) {
+      ++scratch->num_malloced;
+    } else {
+      scratch->needed -= aligned_size;
+    }
+    return ptr;
+  }
+}
+
+LIBYUV_API
+void ScratchFree(void* ptr) {
+  LibyuvScratch* scratch = thread_scratch;
+  if (!scratch) {
+    free(ptr);
+    return;
+  }
+  if (!ptr) {
+    return;
+  }
+  if ((uint8_t*)ptr < scratch->base ||
+      (uint8_t*)ptr >= scratch->base + scratch->size) {
+    free(ptr);
+    if (scratch->num_malloced > 0) {
+      --scratch->num_malloced;
+    }
+  } else if (--scratch->num_buffers == 0) {
+    // Buffers are freed in any order, so the arena is reused once all of its
+    // buffers are free.
+    scratch->used = 0;
+  }
+  if (scratch->num_buffers == 0 && scratch->num_malloced == 0) {
+    scratch->needed = 0;
+  }
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -0,0 +1,477 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/slice.h"
+
+#include <stdlib.h>  // For malloc.
+#include <string.h>
+
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/scale_row.h"
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+static __inline int Abs(int v) {
+  return v >= 0 ? v : -v;
+}
+
+#define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
+
+// A plane scaled from a window of the source rows received so far.
+typedef struct {
+  ScalePlaneSetup setup;
+  uint8_t* tables_mem;  // Polyphase tables, unaligned.
+  uint8_t* window_mem;
+  uint8_t* window;  // Source rows [window_y, window_y + window_rows).
+  int window_stride;
+  int window_capacity;  // Rows that fit in window.
+  int window_y;
+  int window_rows;
+  int dst_rows;  // Destination rows written.
+  uint8_t* dst;
+  int dst_stride;
+} SlicePlane;
+
+struct SliceConverter {
+  uint32_t src_fourcc;
+  uint32_t dst_fourcc;
+  int width;
+  int height;
+  int num_planes;  // Planes scaled, or 0 for conversions.
+  SlicePlane planes[3];
+  uint8_t* held;  // Source rows kept between slices by conversions.
+  int num_held;
+  int begun;
+  int src_rows;  // Source rows pushed.
+  int dst_rows;  // Destination rows written, for conversions.
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+};
+
+static int SlicePlaneInit(SlicePlane* plane,
+                          int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  ScalePlaneSetup* setup = &plane->setup;
+  ScalePlaneSetupInit(setup, src_width, src_height, dst_width, dst_height,
+                      filtering);
+  plane->window_stride = (Abs(src_width) + 63) & ~63;
+  if (ScalePlaneSetupPolyphase(setup)) {
+    size_t size =
+        ScalePolyphaseSize(src_width, src_height, dst_width, dst_height,
+                           dst_width, dst_height, 1, setup->filtering);
+    plane->tables_mem = (uint8_t*)malloc(size + 63); /* NOLINT */
+    if (!plane->tables_mem) {
+      return -1;
+    }
+    ScalePolyphaseInit(
+        &setup->polyphase,
+        (uint8_t*)(((intptr_t)(plane->tables_mem) + 63) & ~63), src_width,
+        src_height, dst_width, dst_height, 0, dst_width, 0, dst_height, 1,
+        setup->filtering);
+  }
+  return 0;
+}
+
+// Grow the window to hold rows. The window keeps its size between frames so
+// later frames do not allocate memory.
+static int SlicePlaneReserve(SlicePlane* plane, int rows) {
+  uint8_t* window_mem;
+  uint8_t* window;
+  if (rows <= plane->window_capacity) {
+    return 0;
+  }
+  rows = rows > plane->window_capacity * 2 ? rows : plane->window_capacity * 2;
+  // Row functions may read a vector past the end of the last row.
+  window_mem = (uint8_t*)malloc(rows * plane->window_stride + 64 + 63);
+  if (!window_mem) {
+    return -1;
+  }
+  window = (uint8_t*)(((intptr_t)(window_mem) + 63) & ~63);
+  memset(window + rows * plane->window_stride, 0, 64);
+  if (plane->window_rows) {
+    memcpy(window, plane->window, plane->window_rows * plane->window_stride);
+  }
+  free(plane->window_mem);
+  plane->window_mem = window_mem;
+  plane->window = window;
+  plane->window_capacity = rows;
+  return 0;
+}
+
+// Add source rows to the window of a plane and scale the destination rows
+// that can be computed from it.
+static int SlicePlanePush(SlicePlane* plane,
+                          const uint8_t* src,
+                          int src_stride,
+                          int num_rows) {
+  const ScalePlaneSetup* setup = &plane->setup;
+  const int stride = plane->window_stride;
+  const int next_y = plane->window_y + plane->window_rows;
+  int band_end = plane->dst_rows;
+  int src_begin = next_y + num_rows;
+  int src_end;
+  int drop;
+
+  // Drop the rows that the remaining destination rows do not read.
+  if (plane->dst_rows < setup->dst_height) {
+    ScalePlaneSetupSrcRows(setup, plane->dst_rows, 1, &src_begin, &src_end);
+  }
+  drop = src_begin - plane->window_y;
+  drop = drop < 0 ? 0 : (drop > plane->window_rows ? plane->window_rows : drop);
+  if (drop) {
+    plane->window_rows -= drop;
+    plane->window_y += drop;
+    memmove(plane->window, plane->window + drop * stride,
+            plane->window_rows * stride);
+  }
+  if (plane->window_rows == 0) {
+    // Rows skipped by a scale down are not copied.
+    int skip = src_begin - next_y;
+    skip = skip < 0 ? 0 : (skip > num_rows ? num_rows : skip);
+    src += skip * (intptr_t)(src_stride);
+    num_rows -= skip;
+    plane->window_y = next_y + skip;
+  }
+  if (num_rows > 0) {
+    if (SlicePlaneReserve(plane, plane->window_rows + num_rows) != 0) {
+      return -1;
+    }
+    CopyPlane(src, src_stride, plane->window + plane->window_rows * stride,
+              stride, Abs(setup->src_width), num_rows);
+    plane->window_rows += num_rows;
+  }
+
+  while (band_end < setup->dst_height) {
+    int next = band_end + setup->row_align < setup->dst_height
+                   ? band_end + setup->row_align
+                   : setup->dst_height;
+    ScalePlaneSetupSrcRows(setup, band_end, next - band_end, &src_begin,
+                           &src_end);
+    if (src_end > plane->window_y + plane->window_rows) {
+      break;
+    }
+    band_end = next;
+  }
+  if (band_end > plane->dst_rows) {
+    ScalePlaneSetupRun(setup, plane->window - plane->window_y * stride, stride,
+                       plane->dst + plane->dst_rows * plane->dst_stride,
+                       plane->dst_stride, plane->dst_rows,
+                       band_end - plane->dst_rows);
+    plane->dst_rows = band_end;
+  }
+  return 0;
+}
+
+LIBYUV_API
+SliceConverter* CreateSliceConverter(uint32_t src_fourcc,
+                                     uint32_t dst_fourcc,
+                                     int src_width,
+                                     int src_height,
+                                     int dst_width,
+                                     int dst_height,
+                                     enum FilterMode filtering) {
+  const int scale = src_fourcc == dst_fourcc;
+  SliceConverter* converter;
+  int r = 0;
+  if (src_width == 0 || src_width > 32768 || src_height <= 0 ||
+      src_height > 32768 || dst_width <= 0 || dst_height <= 0) {
+    return NULL;
+  }
+  if (scale) {
+    if (src_fourcc != FOURCC_I420 && src_fourcc != FOURCC_I400) {
+      return NULL;
+    }
+  } else {
+    if (!((src_fourcc == FOURCC_I420 && dst_fourcc == FOURCC_ARGB) ||
+          (src_fourcc == FOURCC_ARGB && dst_fourcc == FOURCC_I420) ||
+          (src_fourcc == FOURCC_NV12 && dst_fourcc == FOURCC_I420)) ||
+        src_width != dst_width || src_height != dst_height) {
+      return NULL;
+    }
+  }
+  converter = (SliceConverter*)calloc(1, sizeof(SliceConverter));
+  if (!converter) {
+    return NULL;
+  }
+  converter->src_fourcc = src_fourcc;
+  converter->dst_fourcc = dst_fourcc;
+  converter->width = src_width;
+  converter->height = src_height;
+  if (scale) {
+    converter->num_planes = src_fourcc == FOURCC_I420 ? 3 : 1;
+    r = SlicePlaneInit(&converter->planes[0], src_width, src_height,
+                       dst_width, dst_height, filtering);
+    if (r == 0 && converter->num_planes == 3) {
+      r = SlicePlaneInit(&converter->planes[1], SUBSAMPLE(src_width, 1, 1),
+                         SUBSAMPLE(src_height, 1, 1),
+                         SUBSAMPLE(dst_width, 1, 1),
+                         SUBSAMPLE(dst_height, 1, 1), filtering);
+      // U and V share the setup and its tables, but not the window.
+      converter->planes[2] = converter->planes[1];
+      converter->planes[2].tables_mem = NULL;
+    }
+  } else if (src_fourcc == FOURCC_I420) {
+    // The chroma row of the last row of a slice ending on an even row.
+    converter->held = (uint8_t*)malloc(((src_width + 1) >> 1) * 2);
+    r = converter->held ? 0 : -1;
+  } else if (src_fourcc == FOURCC_ARGB) {
+    // The last row of a slice ending on an even row and its pair.
+    converter->held = (uint8_t*)malloc(src_width * 4 * 2);
+    r = converter->held ? 0 : -1;
+  }
+  if (r != 0) {
+    DestroySliceConverter(converter);
+    return NULL;
+  }
+  return converter;
+}
+
+LIBYUV_API
+void DestroySliceConverter(SliceConverter* converter) {
+  if (converter) {
+    int i;
+    for (i = 0; i < 3; ++i) {
+      free(converter->planes[i].tables_mem);
+      free(converter->planes[i].window_mem);
+    }
+    free(converter->held);
+    free(converter);
+  }
+}
+
+LIBYUV_API
+int SliceConverterBegin(SliceConverter* converter,
+                        uint8_t* dst_y,
+                        int dst_stride_y,
+                        uint8_t* dst_u,
+                        int dst_stride_u,
+                        uint8_t* dst_v,
+                        int dst_stride_v) {
+  int i;
+  if (!converter || !dst_y ||
+      (converter->dst_fourcc == FOURCC_I420 && (!dst_u || !dst_v))) {
+    return -1;
+  }
+  converter->begun = 1;
+  converter->src_rows = 0;
+  converter->dst_rows = 0;
+  converter->num_held = 0;
+  converter->dst_y = dst_y;
+  converter->dst_stride_y = dst_stride_y;
+  converter->dst_u = dst_u;
+  converter->dst_stride_u = dst_stride_u;
+  converter->dst_v = dst_v;
+  converter->dst_stride_v = dst_stride_v;
+  for (i = 0; i < converter->num_planes; ++i) {
+    SlicePlane* plane = &converter->planes[i];
+    plane->window_y = 0;
+    plane->window_rows = 0;
+    plane->dst_rows = 0;
+    plane->dst = i == 0 ? dst_y : (i == 1 ? dst_u : dst_v);
+    plane->dst_stride =
+        i == 0 ? dst_stride_y : (i == 1 ? dst_stride_u : dst_stride_v);
+  }
+  return 0;
+}
+
+// Rows of a slice starting on an odd row use the chroma row of the previous
+// slice for their first row.
+static void SliceI420ToARGB(SliceConverter* converter,
+                            const uint8_t* src_y,
+                            int src_stride_y,
+                            const uint8_t* src_u,
+                            int src_stride_u,
+                            const uint8_t* src_v,
+                            int src_stride_v,
+                            int num_rows) {
+  const int y = converter->src_rows;
+  const int width = converter->width;
+  const int halfwidth = (width + 1) >> 1;
+  const int dst_stride = converter->dst_stride_y;
+  uint8_t* dst = converter->dst_y + y * (intptr_t)(dst_stride);
+  uint8_t* held_u = converter->held;
+  uint8_t* held_v = converter->held + halfwidth;
+  int j = 0;
+  if (y & 1) {
+    I420ToARGB(src_y, src_stride_y, held_u, 0, held_v, 0, dst, dst_stride,
+               width, 1);
+    j = 1;
+  }
+  if (num_rows > j) {
+    I420ToARGB(src_y + j * src_stride_y, src_stride_y, src_u, src_stride_u,
+               src_v, src_stride_v, dst + j * dst_stride, dst_stride, width,
+               num_rows - j);
+  }
+  if (((y + num_rows) & 1) && y + num_rows < converter->height) {
+    const int uv = (y + num_rows - 1) / 2 - (y + 1) / 2;
+    memcpy(held_u, src_u + uv * src_stride_u, halfwidth);
+    memcpy(held_v, src_v + uv * src_stride_v, halfwidth);
+  }
+  converter->dst_rows = y + num_rows;
+}
+
+// Rows are converted in pairs, so the last row of a slice ending on an even
+// row is held until the next slice.
+static void SliceARGBToI420(SliceConverter* converter,
+                            const uint8_t* src_argb,
+                            int src_stride_argb,
+                            int num_rows) {
+  const int y = converter->src_rows;
+  const int width = converter->width;
+  const int row_bytes = width * 4;
+  int j = 0;
+  int rows;
+  if (converter->num_held) {
+    const int held_y = y - 1;
+    memcpy(converter->held + row_bytes, src_argb, row_bytes);
+    ARGBToI420(converter->held, row_bytes,
+               converter->dst_y + held_y * converter->dst_stride_y,
+               converter->dst_stride_y,
+               converter->dst_u + held_y / 2 * converter->dst_stride_u,
+               converter->dst_stride_u,
+               converter->dst_v + held_y / 2 * converter->dst_stride_v,
+               converter->dst_stride_v, width, 2);
+    converter->num_held = 0;
+    j = 1;
+  }
+  rows = y + num_rows == converter->height ? num_rows - j
+                                             : (num_rows - j) & ~1;
+  if (rows) {
+    const int dst_y = y + j;
+    ARGBToI420(src_argb + j * src_stride_argb, src_stride_argb,
+               converter->dst_y + dst_y * converter->dst_stride_y,
+               converter->dst_stride_y,
+               converter->dst_u + dst_y / 2 * converter->dst_stride_u,
+               converter->dst_stride_u,
+               converter->dst_v + dst_y / 2 * converter->dst_stride_v,
+               converter->dst_stride_v, width, rows);
+  }
+  if (j + rows < num_rows) {
+    memcpy(converter->held, src_argb + (num_rows - 1) * src_stride_argb,
+           row_bytes);
+    converter->num_held = 1;
+  }
+  converter->dst_rows = y + j + rows;
+}
+
+static void SliceNV12ToI420(SliceConverter* converter,
+                            const uint8_t* src_y,
+                            int src_stride_y,
+                            const uint8_t* src_uv,
+                            int src_stride_uv,
+                            int num_rows) {
+  const int y = converter->src_rows;
+  const int uv_begin = (y + 1) >> 1;
+  const int uv_end = (y + num_rows + 1) >> 1;
+  CopyPlane(src_y, src_stride_y,
+            converter->dst_y + y * (intptr_t)converter->dst_stride_y,
+            converter->dst_stride_y, converter->width, num_rows);
+  if (uv_end > uv_begin) {
+    SplitUVPlane(src_uv, src_stride_uv,
+                 converter->dst_u +
+                     uv_begin * (intptr_t)converter->dst_stride_u,
+                 converter->dst_stride_u,
+                 converter->dst_v +
+                     uv_begin * (intptr_t)converter->dst_stride_v,
+                 converter->dst_stride_v, (converter->width + 1) >> 1,
+                 uv_end - uv_begin);
+  }
+  converter->dst_rows = y + num_rows;
+}
+
+// Destination rows written with their chroma.
+static int SliceScaledRows(const SliceConverter* converter) {
+  int rows = converter->planes[0].dst_rows;
+  int i;
+  for (i = 1; i < converter->num_planes; ++i) {
+    const int uv_rows = converter->planes[i].dst_rows * 2;
+    if (converter->planes[i].dst_rows < converter->planes[i].setup.dst_height &&
+        uv_rows < rows) {
+      rows = uv_rows;
+    }
+  }
+  return rows;
+}
+
+LIBYUV_API
+int SliceConverterPushRows(SliceConverter* converter,
+                           const uint8_t* src_y,
+                           int src_stride_y,
+                           const uint8_t* src_u,
+                           int src_stride_u,
+                           const uint8_t* src_v,
+                           int src_stride_v,
+                           int num_rows) {
+  const uint32_t src_fourcc = converter ? converter->src_fourcc : 0;
+  int uv_rows;
+  if (!converter || !converter->begun || num_rows < 0 ||
+      converter->src_rows + num_rows > converter->height || !src_y ||
+      ((src_fourcc == FOURCC_I420 || src_fourcc == FOURCC_NV12) && !src_u) ||
+      (src_fourcc == FOURCC_I420 && !src_v)) {
+    return -1;
+  }
+  uv_rows = ((converter->src_rows + num_rows + 1) >> 1) -
+            ((converter->src_rows + 1) >> 1);
+  if (num_rows == 0) {
+    return converter->num_planes ? SliceScaledRows(converter)
+                                 : converter->dst_rows;
+  }
+  if (converter->num_planes) {
+    if (SlicePlanePush(&converter->planes[0], src_y, src_stride_y,
+                       num_rows) != 0 ||
+        (converter->num_planes == 3 &&
+         (SlicePlanePush(&converter->planes[1], src_u, src_stride_u,
+                         uv_rows) != 0 ||
+          SlicePlanePush(&converter->planes[2], src_v, src_stride_v,
+                         uv_rows) != 0))) {
+      return -1;
+    }
+  } else if (src_fourcc == FOURCC_I420) {
+    SliceI420ToARGB(converter, src_y, src_stride_y, src_u, src_stride_u, src_v,
+                    src_stride_v, num_rows);
+  } else if (src_fourcc == FOURCC_ARGB) {
+    SliceARGBToI420(converter, src_y, src_stride_y, num_rows);
+  } else {
+    SliceNV12ToI420(converter, src_y, src_stride_y, src_u, src_stride_u,
+                    num_rows);
+  }
+  converter->src_rows += num_rows;
+  return converter->num_planes ? SliceScaledRows(converter)
+                               : converter->dst_rows;
+}
+
+LIBYUV_API
+int SliceConverterEnd(SliceConverter* converter) {
+  int complete;
+  if (!converter || !converter->begun) {
+    return -1;
+  }
+  complete = converter->src_rows == converter->height;
+  converter->begun = 0;
+  return complete ? 0 : -1;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
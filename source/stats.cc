@@ -0,0 +1,462 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/stats.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HAVE_RDTSC
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+#include <atomic>
+#include <chrono>
+
+#include "libyuv/row.h"
+#include "libyuv/scale_row.h"
+#include "stats_internal.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// A version of a row function and its name.
+struct StatsKernel {
+  void (*kernel)(void);
+  const char* name;
+};
+
+#define STATS_KERNEL(kernel) \
+  { (void (*)(void))(kernel), #kernel }
+
+// Versions of each row function family, as chosen by the functions that
+// record the family. The C versions come first. Versions that are not in the
+// table are counted as "unknown".
+static const StatsKernel kInterpolateRowKernels[] = {
+    STATS_KERNEL(InterpolateRow_C),
+#if defined(HAS_INTERPOLATEROW_SSSE3)
+    STATS_KERNEL(InterpolateRow_Any_SSSE3),
+    STATS_KERNEL(InterpolateRow_SSSE3),
+#endif
+#if defined(HAS_INTERPOLATEROW_AVX2)
+    STATS_KERNEL(InterpolateRow_Any_AVX2),
+    STATS_KERNEL(InterpolateRow_AVX2),
+#endif
+#if defined(HAS_INTERPOLATEROW_NEON)
+    STATS_KERNEL(InterpolateRow_Any_NEON),
+    STATS_KERNEL(InterpolateRow_NEON),
+#endif
+#if defined(HAS_INTERPOLATEROW_MSA)
+    STATS_KERNEL(InterpolateRow_Any_MSA),
+    STATS_KERNEL(InterpolateRow_MSA),
+#endif
+#if defined(HAS_INTERPOLATEROW_MMI)
+    STATS_KERNEL(InterpolateRow_Any_MMI),
+    STATS_KERNEL(InterpolateRow_MMI),
+#endif
+};
+
+static const StatsKernel kScaleFilterColsKernels[] = {
+    STATS_KERNEL(ScaleFilterCols_C),
+    STATS_KERNEL(ScaleFilterCols64_C),
+    STATS_KERNEL(ScaleCols_C),
+    STATS_KERNEL(ScaleColsUp2_C),
+#if defined(HAS_SCALEFILTERCOLS_SSSE3)
+    STATS_KERNEL(ScaleFilterCols_SSSE3),
+#endif
+#if defined(HAS_SCALEFILTERCOLS_NEON)
+    STATS_KERNEL(ScaleFilterCols_Any_NEON),
+    STATS_KERNEL(ScaleFilterCols_NEON),
+#endif
+#if defined(HAS_SCALEFILTERCOLS_MSA)
+    STATS_KERNEL(ScaleFilterCols_Any_MSA),
+    STATS_KERNEL(ScaleFilterCols_MSA),
+#endif
+#if defined(HAS_SCALECOLS_SSE2)
+    STATS_KERNEL(ScaleColsUp2_SSE2),
+#endif
+#if defined(HAS_SCALECOLS_MMI)
+    STATS_KERNEL(ScaleColsUp2_MMI),
+#endif
+};
+
+static const StatsKernel kScaleColsKernels[] = {
+    STATS_KERNEL(ScaleCols_C),
+    STATS_KERNEL(ScaleColsUp2_C),
+#if defined(HAS_SCALECOLS_SSE2)
+    STATS_KERNEL(ScaleColsUp2_SSE2),
+#endif
+#if defined(HAS_SCALECOLS_MMI)
+    STATS_KERNEL(ScaleColsUp2_MMI),
+#endif
+};
+
+static const StatsKernel kScaleRowDown2Kernels[] = {
+    STATS_KERNEL(ScaleRowDown2_C),
+    STATS_KERNEL(ScaleRowDown2Linear_C),
+    STATS_KERNEL(ScaleRowDown2Box_C),
+#if defined(HAS_SCALEROWDOWN2_NEON)
+    STATS_KERNEL(ScaleRowDown2Box_Any_NEON),
+    STATS_KERNEL(ScaleRowDown2Linear_Any_NEON),
+    STATS_KERNEL(ScaleRowDown2_Any_NEON),
+    STATS_KERNEL(ScaleRowDown2Box_NEON),
+    STATS_KERNEL(ScaleRowDown2Linear_NEON),
+    STATS_KERNEL(ScaleRowDown2_NEON),
+#endif
+#if defined(HAS_SCALEROWDOWN2_SSSE3)
+    STATS_KERNEL(ScaleRowDown2Box_Any_SSSE3),
+    STATS_KERNEL(ScaleRowDown2Linear_Any_SSSE3),
+    STATS_KERNEL(ScaleRowDown2_Any_SSSE3),
+    STATS_KERNEL(ScaleRowDown2Box_SSSE3),
+    STATS_KERNEL(ScaleRowDown2Linear_SSSE3),
+    STATS_KERNEL(ScaleRowDown2_SSSE3),
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX2)
+    STATS_KERNEL(ScaleRowDown2Box_Any_AVX2),
+    STATS_KERNEL(ScaleRowDown2Linear_Any_AVX2),
+    STATS_KERNEL(ScaleRowDown2_Any_AVX2),
+    STATS_KERNEL(ScaleRowDown2Box_AVX2),
+    STATS_KERNEL(ScaleRowDown2Linear_AVX2),
+    STATS_KERNEL(ScaleRowDown2_AVX2),
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX512BW)
+    STATS_KERNEL(ScaleRowDown2Box_Any_AVX512BW),
+    STATS_KERNEL(ScaleRowDown2Linear_Any_AVX512BW),
+    STATS_KERNEL(ScaleRowDown2_Any_AVX512BW),
+    STATS_KERNEL(ScaleRowDown2Box_AVX512BW),
+    STATS_KERNEL(ScaleRowDown2Linear_AVX512BW),
+    STATS_KERNEL(ScaleRowDown2_AVX512BW),
+#endif
+#if defined(HAS_SCALEROWDOWN2_MSA)
+    STATS_KERNEL(ScaleRowDown2Box_Any_MSA),
+    STATS_KERNEL(ScaleRowDown2Linear_Any_MSA),
+    STATS_KERNEL(ScaleRowDown2_Any_MSA),
+    STATS_KERNEL(ScaleRowDown2Box_MSA),
+    STATS_KERNEL(ScaleRowDown2Linear_MSA),
+    STATS_KERNEL(ScaleRowDown2_MSA),
+#endif
+#if defined(HAS_SCALEROWDOWN2_MMI)
+    STATS_KERNEL(ScaleRowDown2Box_Any_MMI),
+    STATS_KERNEL(ScaleRowDown2Linear_Any_MMI),
+    STATS_KERNEL(ScaleRowDown2_Any_MMI),
+    STATS_KERNEL(ScaleRowDown2Box_MMI),
+    STATS_KERNEL(ScaleRowDown2Linear_MMI),
+    STATS_KERNEL(ScaleRowDown2_MMI),
+#endif
+};
+
+static const StatsKernel kScaleRowDown4Kernels[] = {
+    STATS_KERNEL(ScaleRowDown4_C),
+    STATS_KERNEL(ScaleRowDown4Box_C),
+#if defined(HAS_SCALEROWDOWN4_NEON)
+    STATS_KERNEL(ScaleRowDown4Box_Any_NEON),
+    STATS_KERNEL(ScaleRowDown4_Any_NEON),
+    STATS_KERNEL(ScaleRowDown4Box_NEON),
+    STATS_KERNEL(ScaleRowDown4_NEON),
+#endif
+#if defined(HAS_SCALEROWDOWN4_SSSE3)
+    STATS_KERNEL(ScaleRowDown4Box_Any_SSSE3),
+    STATS_KERNEL(ScaleRowDown4_Any_SSSE3),
+    STATS_KERNEL(ScaleRowDown4Box_SSSE3),
+    STATS_KERNEL(ScaleRowDown4_SSSE3),
+#endif
+#if defined(HAS_SCALEROWDOWN4_AVX2)
+    STATS_KERNEL(ScaleRowDown4Box_Any_AVX2),
+    STATS_KERNEL(ScaleRowDown4_Any_AVX2),
+    STATS_KERNEL(ScaleRowDown4Box_AVX2),
+    STATS_KERNEL(ScaleRowDown4_AVX2),
+#endif
+#if defined(HAS_SCALEROWDOWN4_MSA)
+    STATS_KERNEL(ScaleRowDown4Box_Any_MSA),
+    STATS_KERNEL(ScaleRowDown4_Any_MSA),
+    STATS_KERNEL(ScaleRowDown4Box_MSA),
+    STATS_KERNEL(ScaleRowDown4_MSA),
+#endif
+#if defined(HAS_SCALEROWDOWN4_MMI)
+    STATS_KERNEL(ScaleRowDown4Box_Any_MMI),
+    STATS_KERNEL(ScaleRowDown4_Any_MMI),
+    STATS_KERNEL(ScaleRowDown4Box_MMI),
+    STATS_KERNEL(ScaleRowDown4_MMI),
+#endif
+};
+
+static const StatsKernel kScaleAddRowKernels[] = {
+    STATS_KERNEL(ScaleAddRow_C),
+#if defined(HAS_SCALEADDROW_SSE2)
+    STATS_KERNEL(ScaleAddRow_Any_SSE2),
+    STATS_KERNEL(ScaleAddRow_SSE2),
+#endif
+#if defined(HAS_SCALEADDROW_AVX2)
+    STATS_KERNEL(ScaleAddRow_Any_AVX2),
+    STATS_KERNEL(ScaleAddRow_AVX2),
+#endif
+#if defined(HAS_SCALEADDROW_NEON)
+    STATS_KERNEL(ScaleAddRow_Any_NEON),
+    STATS_KERNEL(ScaleAddRow_NEON),
+#endif
+#if defined(HAS_SCALEADDROW_MSA)
+    STATS_KERNEL(ScaleAddRow_Any_MSA),
+    STATS_KERNEL(ScaleAddRow_MSA),
+#endif
+#if defined(HAS_SCALEADDROW_MMI)
+    STATS_KERNEL(ScaleAddRow_Any_MMI),
+    STATS_KERNEL(ScaleAddRow_MMI),
+#endif
+};
+
+static const StatsKernel kI422ToARGBRowKernels[] = {
+    STATS_KERNEL(I422ToARGBRow_C),
+#if defined(HAS_I422TOARGBROW_SSSE3)
+    STATS_KERNEL(I422ToARGBRow_Any_SSSE3),
+    STATS_KERNEL(I422ToARGBRow_SSSE3),
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+    STATS_KERNEL(I422ToARGBRow_Any_AVX2),
+    STATS_KERNEL(I422ToARGBRow_AVX2),
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+    STATS_KERNEL(I422ToARGBRow_Any_AVX512BW),
+    STATS_KERNEL(I422ToARGBRow_AVX512BW),
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+    STATS_KERNEL(I422ToARGBRow_Any_NEON),
+    STATS_KERNEL(I422ToARGBRow_NEON),
+#endif
+#if defined(HAS_I422TOARGBROW_MSA)
+    STATS_KERNEL(I422ToARGBRow_Any_MSA),
+    STATS_KERNEL(I422ToARGBRow_MSA),
+#endif
+};
+
+static const StatsKernel kARGBToYRowKernels[] = {
+    STATS_KERNEL(ARGBToYRow_C),
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+    STATS_KERNEL(ARGBToYRow_Any_SSSE3),
+    STATS_KERNEL(ARGBToYRow_SSSE3),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+    STATS_KERNEL(ARGBToYRow_Any_AVX2),
+    STATS_KERNEL(ARGBToYRow_AVX2),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+    STATS_KERNEL(ARGBToYRow_Any_AVX512BW),
+    STATS_KERNEL(ARGBToYRow_AVX512BW),
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+    STATS_KERNEL(ARGBToYRow_Any_NEON),
+    STATS_KERNEL(ARGBToYRow_NEON),
+#endif
+#if defined(HAS_ARGBTOYROW_MSA)
+    STATS_KERNEL(ARGBToYRow_Any_MSA),
+    STATS_KERNEL(ARGBToYRow_MSA),
+#endif
+#if defined(HAS_ARGBTOYROW_MMI)
+    STATS_KERNEL(ARGBToYRow_Any_MMI),
+    STATS_KERNEL(ARGBToYRow_MMI),
+#endif
+};
+
+static const StatsKernel kARGBToUVRowKernels[] = {
+    STATS_KERNEL(ARGBToUVRow_C),
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+    STATS_KERNEL(ARGBToUVRow_Any_SSSE3),
+    STATS_KERNEL(ARGBToUVRow_SSSE3),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+    STATS_KERNEL(ARGBToUVRow_Any_AVX2),
+    STATS_KERNEL(ARGBToUVRow_AVX2),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+    STATS_KERNEL(ARGBToUVRow_Any_AVX512BW),
+    STATS_KERNEL(ARGBToUVRow_AVX512BW),
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+    STATS_KERNEL(ARGBToUVRow_Any_NEON),
+    STATS_KERNEL(ARGBToUVRow_NEON),
+#endif
+#if defined(HAS_ARGBTOUVROW_MSA)
+    STATS_KERNEL(ARGBToUVRow_Any_MSA),
+    STATS_KERNEL(ARGBToUVRow_MSA),
+#endif
+#if defined(HAS_ARGBTOUVROW_MMI)
+    STATS_KERNEL(ARGBToUVRow_Any_MMI),
+    STATS_KERNEL(ARGBToUVRow_MMI),
+#endif
+};
+
+struct StatsFamily {
+  const char* name;
+  const StatsKernel* kernels;
+  int num_kernels;
+};
+
+#define STATS_FAMILY(family)                     \
+  {                                              \
+    #family, k##family##Kernels,                 \
+        static_cast<int>(sizeof(k##family##Kernels) / sizeof(StatsKernel)) \
+  }
+
+// In the order of LibyuvStatsFamily.
+static const StatsFamily kFamilies[kStatsNumFamilies] = {
+    STATS_FAMILY(InterpolateRow), STATS_FAMILY(ScaleFilterCols),
+    STATS_FAMILY(ScaleCols),      STATS_FAMILY(ScaleRowDown2),
+    STATS_FAMILY(ScaleRowDown4),  STATS_FAMILY(ScaleAddRow),
+    STATS_FAMILY(I422ToARGBRow),  STATS_FAMILY(ARGBToYRow),
+    STATS_FAMILY(ARGBToUVRow),
+};
+
+// In the order of LibyuvStatsFunction.
+static const char* const kFunctionNames[kStatsNumFunctions] = {
+    "ScalePlane",       "ScalePlane_16",    "I420Scale", "ARGBScale",
+    "I420ToARGBMatrix", "ARGBToI420",       "I420Rotate",
+};
+
+// Most versions of a family, plus 1 for unknown versions.
+static const int kMaxKernels = 48;
+static_assert(sizeof(kScaleRowDown2Kernels) / sizeof(StatsKernel) <
+                  kMaxKernels,
+              "kMaxKernels is smaller than the largest family");
+
+struct StatsCounter {
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> pixels;
+  std::atomic<uint64_t> cycles;
+};
+
+static StatsCounter function_counters[kStatsNumFunctions];
+static StatsCounter row_counters[kStatsNumFamilies][kMaxKernels];
+
+static void StatsAdd(StatsCounter* counter,
+                     uint64_t calls,
+                     uint64_t pixels,
+                     uint64_t cycles) {
+  counter->calls.fetch_add(calls, std::memory_order_relaxed);
+  counter->pixels.fetch_add(pixels, std::memory_order_relaxed);
+  counter->cycles.fetch_add(cycles, std::memory_order_relaxed);
+}
+
+static void StatsClear(StatsCounter* counter) {
+  counter->calls.store(0, std::memory_order_relaxed);
+  counter->pixels.store(0, std::memory_order_relaxed);
+  counter->cycles.store(0, std::memory_order_relaxed);
+}
+
+// Copy a counter that was called to stats[index] if it fits.
+static int StatsCopy(const StatsCounter* counter,
+                     const char* name,
+                     const char* kernel,
+                     LibyuvStat* stats,
+                     int max_stats,
+                     int index) {
+  uint64_t calls = counter->calls.load(std::memory_order_relaxed);
+  if (calls == 0) {
+    return index;
+  }
+  if (index < max_stats) {
+    stats[index].name = name;
+    stats[index].kernel = kernel;
+    stats[index].calls = calls;
+    stats[index].pixels = counter->pixels.load(std::memory_order_relaxed);
+    stats[index].cycles = counter->cycles.load(std::memory_order_relaxed);
+  }
+  return index + 1;
+}
+
+LIBYUV_API
+int LibyuvStatsEnabled(void) {
+#if defined(LIBYUV_STATS)
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+LIBYUV_API
+int LibyuvGetStats(LibyuvStat* stats, int max_stats) {
+  int count = 0;
+  int i;
+  int k;
+  if (!stats) {
+    max_stats = 0;
+  }
+  for (i = 0; i < kStatsNumFunctions; ++i) {
+    count = StatsCopy(&function_counters[i], kFunctionNames[i], NULL, stats,
+                      max_stats, count);
+  }
+  for (i = 0; i < kStatsNumFamilies; ++i) {
+    const StatsFamily* family = &kFamilies[i];
+    for (k = 0; k < family->num_kernels; ++k) {
+      count = StatsCopy(&row_counters[i][k], family->name,
+                        family->kernels[k].name, stats, max_stats, count);
+    }
+    count = StatsCopy(&row_counters[i][kMaxKernels - 1], family->name,
+                      "unknown", stats, max_stats, count);
+  }
+  return count;
+}
+
+LIBYUV_API
+void LibyuvResetStats(void) {
+  int i;
+  int k;
+  for (i = 0; i < kStatsNumFunctions; ++i) {
+    StatsClear(&function_counters[i]);
+  }
+  for (i = 0; i < kStatsNumFamilies; ++i) {
+    for (k = 0; k < kMaxKernels; ++k) {
+      StatsClear(&row_counters[i][k]);
+    }
+  }
+}
+
+uint64_t StatsCycles(void) {
+#if defined(HAVE_RDTSC)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+void StatsRecordFunction(enum LibyuvStatsFunction function,
+                         uint64_t pixels,
+                         uint64_t start) {
+  StatsAdd(&function_counters[function], 1, pixels, StatsCycles() - start);
+}
+
+void StatsRecordRow(enum LibyuvStatsFamily family,
+                    void (*kernel)(void),
+                    uint64_t calls,
+                    uint64_t pixels,
+                    uint64_t cycles) {
+  const StatsFamily* f = &kFamilies[family];
+  int k;
+  if (calls == 0) {
+    return;
+  }
+  for (k = 0; k < f->num_kernels; ++k) {
+    if (f->kernels[k].kernel == kernel) {
+      break;
+    }
+  }
+  if (k == f->num_kernels) {
+    k = kMaxKernels - 1;
+  }
+  StatsAdd(&row_counters[family][k], calls, pixels, cycles);
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
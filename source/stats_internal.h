@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Internal to libyuv. Not installed with the public headers.
+
+#ifndef SOURCE_STATS_INTERNAL_H_
+#define SOURCE_STATS_INTERNAL_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Functions and row function families counted by the LIBYUV_STATS macros.
+// The counters are read with LibyuvGetStats in libyuv/stats.h.
+enum LibyuvStatsFunction {
+  kStatsScalePlane,
+  kStatsScalePlane_16,
+  kStatsI420Scale,
+  kStatsARGBScale,
+  kStatsI420ToARGBMatrix,
+  kStatsARGBToI420,
+  kStatsI420Rotate,
+  kStatsNumFunctions
+};
+
+enum LibyuvStatsFamily {
+  kStatsInterpolateRow,
+  kStatsScaleFilterCols,
+  kStatsScaleCols,
+  kStatsScaleRowDown2,
+  kStatsScaleRowDown4,
+  kStatsScaleAddRow,
+  kStatsI422ToARGBRow,
+  kStatsARGBToYRow,
+  kStatsARGBToUVRow,
+  kStatsNumFamilies
+};
+
+// Rows of a row function counted by a loop, recorded once after the loop.
+typedef struct LibyuvStatsRow {
+  uint64_t calls;
+  uint64_t cycles;
+} LibyuvStatsRow;
+
+uint64_t StatsCycles(void);
+
+void StatsRecordFunction(enum LibyuvStatsFunction function,
+                         uint64_t pixels,
+                         uint64_t start);
+
+void StatsRecordRow(enum LibyuvStatsFamily family,
+                    void (*kernel)(void),
+                    uint64_t calls,
+                    uint64_t pixels,
+                    uint64_t cycles);
+
+#if defined(LIBYUV_STATS)
+#define LIBYUV_STATS_BEGIN(start) uint64_t start = StatsCycles()
+#define LIBYUV_STATS_END(start, function, pixels) \
+  StatsRecordFunction(function, (uint64_t)(pixels), start)
+#define LIBYUV_STATS_ROW_DECLARE(row) LibyuvStatsRow row = {0, 0}
+#define LIBYUV_STATS_ROW(row, call)            \
+  do {                                         \
+    uint64_t row##_start = StatsCycles();      \
+    call;                                      \
+    row.cycles += StatsCycles() - row##_start; \
+    ++row.calls;                               \
+  } while (0)
+#define LIBYUV_STATS_ROW_RECORD(row, family, kernel, pixels_per_call) \
+  StatsRecordRow(family, (void (*)(void))(kernel), row.calls,         \
+                 row.calls * (uint64_t)(pixels_per_call), row.cycles)
+#else
+#define LIBYUV_STATS_BEGIN(start)
+#define LIBYUV_STATS_END(start, function, pixels)
+#define LIBYUV_STATS_ROW_DECLARE(row)
+#define LIBYUV_STATS_ROW(row, call) call
+#define LIBYUV_STATS_ROW_RECORD(row, family, kernel, pixels_per_call)
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // SOURCE_STATS_INTERNAL_H_
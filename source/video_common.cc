@@ -56,6 +56,21 @@ uint32_t CanonicalFourCC(uint32_t fourcc) {
   return fourcc;
 }
 
+LIBYUV_API
+uint32_t CropBayerFourCC(uint32_t fourcc, int crop_x, int crop_y) {
+  // An odd x swaps the 2 colors of each row, index ^ 1, and an odd y swaps
+  // the rows, index ^ 3.
+  static const uint32_t kBayerFourCC[4] = {FOURCC_RGGB, FOURCC_GRBG,
+                                           FOURCC_BGGR, FOURCC_GBRG};
+  int i;
+  for (i = 0; i < 4; ++i) {
+    if (kBayerFourCC[i] == fourcc) {
+      return kBayerFourCC[i ^ (crop_x & 1) ^ ((crop_y & 1) * 3)];
+    }
+  }
+  return fourcc;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
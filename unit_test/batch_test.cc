@@ -0,0 +1,270 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../unit_test/unit_test.h"
+#include "libyuv/batch.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/executor.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_uv.h"
+#include "libyuv/video_common.h"
+
+namespace libyuv {
+
+// Convert one frame of a batch with the individual functions.
+static void ConvertFrame(const YUVToARGBBatchFrame& f,
+                         uint32_t src_fourcc,
+                         uint32_t dst_fourcc,
+                         FilterMode filtering,
+                         uint8_t* dst_argb) {
+  const uint8_t* src_y = f.src_y;
+  const uint8_t* src_u = f.src_u;
+  const uint8_t* src_v = f.src_v;
+  int src_stride_y = f.src_stride_y;
+  int src_stride_u = f.src_stride_u;
+  int src_stride_v = f.src_stride_v;
+  int halfwidth = (f.dst_width + 1) / 2;
+  int halfheight = (f.dst_height + 1) / 2;
+  align_buffer_page_end(scaled, f.dst_width * f.dst_height +
+                                    halfwidth * halfheight * 2);
+  if (f.src_width != f.dst_width || f.src_height != f.dst_height) {
+    uint8_t* scaled_u = scaled + f.dst_width * f.dst_height;
+    uint8_t* scaled_v = scaled_u + halfwidth * halfheight;
+    if (src_fourcc == FOURCC_I420) {
+      I420Scale(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
+                f.src_width, f.src_height, scaled, f.dst_width, scaled_u,
+                halfwidth, scaled_v, halfwidth, f.dst_width, f.dst_height,
+                filtering);
+    } else {
+      NV12Scale(src_y, src_stride_y, src_u, src_stride_u, f.src_width,
+                f.src_height, scaled, f.dst_width, scaled_u, halfwidth * 2,
+                f.dst_width, f.dst_height, filtering);
+    }
+    src_y = scaled;
+    src_u = scaled_u;
+    src_v = scaled_v;
+    src_stride_y = f.dst_width;
+    src_stride_u = src_fourcc == FOURCC_I420 ? halfwidth : halfwidth * 2;
+    src_stride_v = halfwidth;
+  }
+  int dst_stride = f.dst_stride_argb;
+  int w = f.dst_width;
+  int h = f.dst_height;
+  bool abgr = dst_fourcc == FOURCC_ABGR;
+  if (src_fourcc == FOURCC_I420) {
+    if (abgr) {
+      I420ToABGR(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
+                 dst_argb, dst_stride, w, h);
+    } else {
+      I420ToARGB(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
+                 dst_argb, dst_stride, w, h);
+    }
+  } else if (src_fourcc == FOURCC_NV12) {
+    if (abgr) {
+      NV12ToABGR(src_y, src_stride_y, src_u, src_stride_u, dst_argb,
+                 dst_stride, w, h);
+    } else {
+      NV12ToARGB(src_y, src_stride_y, src_u, src_stride_u, dst_argb,
+                 dst_stride, w, h);
+    }
+  } else {
+    if (abgr) {
+      NV21ToABGR(src_y, src_stride_y, src_u, src_stride_u, dst_argb,
+                 dst_stride, w, h);
+    } else {
+      NV21ToARGB(src_y, src_stride_y, src_u, src_stride_u, dst_argb,
+                 dst_stride, w, h);
+    }
+  }
+  free_aligned_buffer_page_end(scaled);
+}
+
+// Frame sizes: source width and height, then destination width and height.
+// Frames of the same size share a scale plan.
+static const int kBatchSizes[][4] = {
+    {64, 48, 64, 48},   {33, 17, 33, 17},   {160, 90, 96, 54},
+    {31, 29, 64, 48},   {1, 1, 3, 3},       {127, 63, 40, 20},
+    {16, 2, 16, 2},     {320, 180, 80, 45}, {640, 360, 640, 360},
+    {160, 90, 96, 54},  {127, 63, 40, 20}};
+static const int kBatchFrames =
+    static_cast<int>(sizeof(kBatchSizes) / sizeof(kBatchSizes[0]));
+
+// Batch conversion matches converting each frame on its own.
+static void TestBatch(uint32_t src_fourcc,
+                      uint32_t dst_fourcc,
+                      FilterMode filtering,
+                      int num_threads) {
+  YUVToARGBBatchFrame frames[kBatchFrames];
+  uint8_t* src_mem[kBatchFrames];
+  uint8_t* dst_mem[kBatchFrames];
+  uint8_t* ref_mem[kBatchFrames];
+  bool biplanar = src_fourcc != FOURCC_I420;
+  for (int i = 0; i < kBatchFrames; ++i) {
+    YUVToARGBBatchFrame& f = frames[i];
+    int src_halfwidth = (kBatchSizes[i][0] + 1) / 2;
+    int src_halfheight = (kBatchSizes[i][1] + 1) / 2;
+    int src_y_size = kBatchSizes[i][0] * kBatchSizes[i][1];
+    int src_uv_size = src_halfwidth * src_halfheight;
+    int dst_size = kBatchSizes[i][2] * kBatchSizes[i][3] * 4;
+    src_mem[i] = static_cast<uint8_t*>(malloc(src_y_size + src_uv_size * 2));
+    dst_mem[i] = static_cast<uint8_t*>(malloc(dst_size));
+    ref_mem[i] = static_cast<uint8_t*>(malloc(dst_size));
+    MemRandomize(src_mem[i], src_y_size + src_uv_size * 2);
+    memset(dst_mem[i], 1, dst_size);
+    memset(ref_mem[i], 2, dst_size);
+    f.src_y = src_mem[i];
+    f.src_stride_y = kBatchSizes[i][0];
+    f.src_u = src_mem[i] + src_y_size;
+    f.src_stride_u = biplanar ? src_halfwidth * 2 : src_halfwidth;
+    f.src_v = biplanar ? NULL : f.src_u + src_uv_size;
+    f.src_stride_v = biplanar ? 0 : src_halfwidth;
+    f.src_width = kBatchSizes[i][0];
+    f.src_height = kBatchSizes[i][1];
+    f.dst_argb = dst_mem[i];
+    f.dst_stride_argb = kBatchSizes[i][2] * 4;
+    f.dst_width = kBatchSizes[i][2];
+    f.dst_height = kBatchSizes[i][3];
+  }
+
+  ParallelExecutor* pool = NULL;
+  if (num_threads > 1) {
+    pool = CreateThreadPool(num_threads);
+    SetThreadExecutor(pool);
+  }
+  EXPECT_EQ(0, YUVToARGBBatch(frames, kBatchFrames, src_fourcc, dst_fourcc,
+                              filtering));
+  SetThreadExecutor(NULL);
+  DestroyThreadPool(pool);
+
+  for (int i = 0; i < kBatchFrames; ++i) {
+    int dst_size = kBatchSizes[i][2] * kBatchSizes[i][3] * 4;
+    ConvertFrame(frames[i], src_fourcc, dst_fourcc, filtering, ref_mem[i]);
+    EXPECT_EQ(0, memcmp(ref_mem[i], dst_mem[i], dst_size)) << "frame " << i;
+    free(src_mem[i]);
+    free(dst_mem[i]);
+    free(ref_mem[i]);
+  }
+}
+
+TEST_F(LibYUVConvertTest, YUVToARGBBatch_I420) {
+  TestBatch(FOURCC_I420, FOURCC_ARGB, kFilterBox, 1);
+  TestBatch(FOURCC_I420, FOURCC_ABGR, kFilterBilinear, 1);
+  TestBatch(FOURCC_I420, FOURCC_ARGB, kFilterLanczos, 1);
+}
+
+TEST_F(LibYUVConvertTest, YUVToARGBBatch_NV12) {
+  TestBatch(FOURCC_NV12, FOURCC_ARGB, kFilterBilinear, 1);
+  TestBatch(FOURCC_NV12, FOURCC_ABGR, kFilterNone, 1);
+  TestBatch(FOURCC_NV12, FOURCC_ARGB, kFilterBicubic, 1);
+}
+
+TEST_F(LibYUVConvertTest, YUVToARGBBatch_NV21) {
+  TestBatch(FOURCC_NV21, FOURCC_ARGB, kFilterBox, 1);
+  TestBatch(FOURCC_NV21, FOURCC_ABGR, kFilterLinear, 1);
+}
+
+TEST_F(LibYUVConvertTest, YUVToARGBBatch_Threads) {
+  TestBatch(FOURCC_I420, FOURCC_ARGB, kFilterBox, 4);
+  TestBatch(FOURCC_NV12, FOURCC_ABGR, kFilterBilinear, 3);
+  TestBatch(FOURCC_I420, FOURCC_ABGR, kFilterLanczos, 4);
+}
+
+TEST_F(LibYUVConvertTest, YUVToARGBBatch_Invalid) {
+  uint8_t src[16 * 16 * 3 / 2] = {0};
+  uint8_t dst[16 * 16 * 4];
+  YUVToARGBBatchFrame frames[2] = {
+      {src, 16, src + 256, 8, src + 320, 8, 16, 16, dst, 64, 16, 16},
+      {src, 16, src + 256, 8, src + 320, 8, 16, 16, dst, 64, 16, 16}};
+  memset(dst, 1, sizeof(dst));
+  EXPECT_EQ(-1, YUVToARGBBatch(NULL, 2, FOURCC_I420, FOURCC_ARGB,
+                               kFilterBox));
+  EXPECT_EQ(-1, YUVToARGBBatch(frames, 2, FOURCC_YUY2, FOURCC_ARGB,
+                               kFilterBox));
+  EXPECT_EQ(-1, YUVToARGBBatch(frames, 2, FOURCC_I420, FOURCC_RGBA,
+                               kFilterBox));
+  // An invalid frame fails the batch before any frame is converted.
+  frames[1].dst_height = 0;
+  EXPECT_EQ(-1, YUVToARGBBatch(frames, 2, FOURCC_I420, FOURCC_ARGB,
+                               kFilterBox));
+  EXPECT_EQ(1, dst[0]);
+  frames[1].dst_height = 16;
+  frames[1].src_v = NULL;
+  EXPECT_EQ(-1, YUVToARGBBatch(frames, 2, FOURCC_I420, FOURCC_ARGB,
+                               kFilterBox));
+  EXPECT_EQ(0, YUVToARGBBatch(frames, 2, FOURCC_NV12, FOURCC_ARGB,
+                              kFilterBox));
+  EXPECT_EQ(0, YUVToARGBBatch(frames, 1, FOURCC_I420, FOURCC_ARGB,
+                              kFilterBox));
+}
+
+// Time converting 1000 thumbnails one at a time and as a batch.
+TEST_F(LibYUVConvertTest, YUVToARGBBatch_1000) {
+  const int kFrames = 1000;
+  const int kSrcWidth = 160;
+  const int kSrcHeight = 90;
+  const int kDstWidth = 120;
+  const int kDstHeight = 68;
+  const int kSrcHalfWidth = kSrcWidth / 2;
+  const int kSrcHalfHeight = kSrcHeight / 2;
+  const int kSrcSize = kSrcWidth * kSrcHeight * 3 / 2;
+  const int kDstSize = kDstWidth * kDstHeight * 4;
+  YUVToARGBBatchFrame* frames = static_cast<YUVToARGBBatchFrame*>(
+      malloc(kFrames * sizeof(YUVToARGBBatchFrame)));
+  align_buffer_page_end(src, kSrcSize * kFrames);
+  align_buffer_page_end(dst_single, kDstSize * kFrames);
+  align_buffer_page_end(dst_batch, kDstSize * kFrames);
+  MemRandomize(src, kSrcSize * kFrames);
+  memset(dst_single, 1, kDstSize * kFrames);
+  memset(dst_batch, 2, kDstSize * kFrames);
+  for (int i = 0; i < kFrames; ++i) {
+    YUVToARGBBatchFrame& f = frames[i];
+    f.src_y = src + i * kSrcSize;
+    f.src_stride_y = kSrcWidth;
+    f.src_u = f.src_y + kSrcWidth * kSrcHeight;
+    f.src_stride_u = kSrcHalfWidth;
+    f.src_v = f.src_u + kSrcHalfWidth * kSrcHalfHeight;
+    f.src_stride_v = kSrcHalfWidth;
+    f.src_width = kSrcWidth;
+    f.src_height = kSrcHeight;
+    f.dst_argb = dst_batch + i * kDstSize;
+    f.dst_stride_argb = kDstWidth * 4;
+    f.dst_width = kDstWidth;
+    f.dst_height = kDstHeight;
+  }
+
+  double single_time = get_time();
+  for (int i = 0; i < kFrames; ++i) {
+    ConvertFrame(frames[i], FOURCC_I420, FOURCC_ARGB, kFilterBilinear,
+                 dst_single + i * kDstSize);
+  }
+  single_time = get_time() - single_time;
+
+  double batch_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, YUVToARGBBatch(frames, kFrames, FOURCC_I420, FOURCC_ARGB,
+                                kFilterBilinear));
+  }
+  batch_time = (get_time() - batch_time) / benchmark_iterations_;
+
+  printf("%d frames %8d us single - %8d us batch\n", kFrames,
+         static_cast<int>(single_time * 1e6),
+         static_cast<int>(batch_time * 1e6));
+  EXPECT_EQ(0, memcmp(dst_single, dst_batch, kDstSize * kFrames));
+
+  free(frames);
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_single);
+  free_aligned_buffer_page_end(dst_batch);
+}
+
+}  // namespace libyuv
@@ -533,6 +533,107 @@ TEST_F(LibYUVColorTest, TestFullYUVJ) {
 }
 #undef FASTSTEP
 
+static void YUVMatrixToRGB(int y,
+                           int u,
+                           int v,
+                           const struct YuvConstants* yuvconstants,
+                           int* r,
+                           int* g,
+                           int* b) {
+  const int kWidth = 16;
+  const int kHeight = 1;
+  const int kPixels = kWidth * kHeight;
+  const int kHalfPixels = ((kWidth + 1) / 2) * ((kHeight + 1) / 2);
+
+  SIMD_ALIGNED(uint8_t orig_y[16]);
+  SIMD_ALIGNED(uint8_t orig_u[8]);
+  SIMD_ALIGNED(uint8_t orig_v[8]);
+  SIMD_ALIGNED(uint8_t orig_pixels[16 * 4]);
+  memset(orig_y, y, kPixels);
+  memset(orig_u, u, kHalfPixels);
+  memset(orig_v, v, kHalfPixels);
+
+  /* YUV converted to ARGB. */
+  I422ToARGBMatrix(orig_y, kWidth, orig_u, (kWidth + 1) / 2, orig_v,
+                   (kWidth + 1) / 2, orig_pixels, kWidth * 4, yuvconstants,
+                   kWidth, kHeight);
+
+  *b = orig_pixels[0];
+  *g = orig_pixels[1];
+  *r = orig_pixels[2];
+}
+
+static void YUVF709ToRGBReference(int y, int u, int v, int* r, int* g, int* b) {
+  *r = RoundToByte(y - (v - 128) * -1.5748);
+  *g = RoundToByte(y - (u - 128) * 0.18732 - (v - 128) * 0.46812);
+  *b = RoundToByte(y - (u - 128) * -1.8556);
+}
+
+static void YUV2020ToRGBReference(int y, int u, int v, int* r, int* g, int* b) {
+  *r = RoundToByte((y - 16) * 1.164384 - (v - 128) * -1.67867);
+  *g = RoundToByte((y - 16) * 1.164384 - (u - 128) * 0.187326 -
+                   (v - 128) * 0.65042);
+  *b = RoundToByte((y - 16) * 1.164384 - (u - 128) * -2.14177);
+}
+
+static void YUVV2020ToRGBReference(int y, int u, int v, int* r, int* g, int* b) {
+  *r = RoundToByte(y - (v - 128) * -1.474600);
+  *g = RoundToByte(y - (u - 128) * 0.164553 - (v - 128) * 0.571353);
+  *b = RoundToByte(y - (u - 128) * -1.881400);
+}
+
+// Compare a matrix against its float reference for all U and V.
+static void TestFullYUVMatrix(void (*reference)(int y,
+                                                int u,
+                                                int v,
+                                                int* r,
+                                                int* g,
+                                                int* b),
+                              const struct YuvConstants* yuvconstants,
+                              int error_r,
+                              int error_g,
+                              int error_b) {
+  int rh[256] = {
+      0,
+  };
+  int gh[256] = {
+      0,
+  };
+  int bh[256] = {
+      0,
+  };
+  for (int u = 0; u < 256; ++u) {
+    for (int v = 0; v < 256; ++v) {
+      for (int y2 = 0; y2 < 256; y2 += 5) {
+        int r0, g0, b0, r1, g1, b1;
+        int y = RANDOM256(y2);
+        reference(y, u, v, &r0, &g0, &b0);
+        YUVMatrixToRGB(y, u, v, yuvconstants, &r1, &g1, &b1);
+        EXPECT_NEAR(r0, r1, error_r);
+        EXPECT_NEAR(g0, g1, error_g);
+        EXPECT_NEAR(b0, b1, error_b);
+        ++rh[r1 - r0 + 128];
+        ++gh[g1 - g0 + 128];
+        ++bh[b1 - b0 + 128];
+      }
+    }
+  }
+  PrintHistogram(rh, gh, bh);
+}
+
+TEST_F(LibYUVColorTest, TestFullYUVF709) {
+  TestFullYUVMatrix(YUVF709ToRGBReference, &kYuvF709Constants, 1, 1, 1);
+}
+
+// Blue is off by up to 18 because UB is clamped to -128 (2.0 instead of 2.142).
+TEST_F(LibYUVColorTest, TestFullYUV2020) {
+  TestFullYUVMatrix(YUV2020ToRGBReference, &kYuv2020Constants, 1, 1, 18);
+}
+
+TEST_F(LibYUVColorTest, TestFullYUVV2020) {
+  TestFullYUVMatrix(YUVV2020ToRGBReference, &kYuvV2020Constants, 1, 2, 1);
+}
+
 TEST_F(LibYUVColorTest, TestGreyYUVJ) {
   int r0, g0, b0, r1, g1, b1, r2, g2, b2;
 
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <float.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -17,6 +19,7 @@
 #include "libyuv/compare.h"
 #include "libyuv/compare_row.h" /* For HammingDistance_C */
 #include "libyuv/cpu_id.h"
+#include "libyuv/executor.h"
 #include "libyuv/video_common.h"
 
 namespace libyuv {
@@ -620,6 +623,218 @@ TEST_F(LibYUVCompareTest, Psnr) {
   free_aligned_buffer_page_end(src_b);
 }
 
+TEST_F(LibYUVCompareTest, BenchmarkSumSquareError_16_Opt) {
+  const int kMaxWidth = 4096 * 3;
+  align_buffer_page_end(src_a, kMaxWidth * 2);
+  align_buffer_page_end(src_b, kMaxWidth * 2);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  for (int i = 0; i < kMaxWidth; ++i) {
+    src_a16[i] = i & 0x3ff;
+    src_b16[i] = i & 0x3ff;
+  }
+
+  uint64_t h1 = 1;
+  int count =
+      benchmark_iterations_ *
+      ((benchmark_width_ * benchmark_height_ + kMaxWidth - 1) / kMaxWidth);
+  for (int i = 0; i < count; ++i) {
+    h1 = ComputeSumSquareError_16(src_a16, src_b16, kMaxWidth);
+  }
+
+  EXPECT_EQ(0u, h1);
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
+TEST_F(LibYUVCompareTest, SumSquareError_16) {
+  const int kMaxWidth = 4096 * 3 + 13;
+  align_buffer_page_end(src_a, kMaxWidth * 2);
+  align_buffer_page_end(src_b, kMaxWidth * 2);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  memset(src_a, 0, kMaxWidth * 2);
+  memset(src_b, 0, kMaxWidth * 2);
+
+  uint64_t err;
+  err = ComputeSumSquareError_16(src_a16, src_b16, kMaxWidth);
+  EXPECT_EQ(0u, err);
+
+  // The largest difference of 16 bit samples, either way.
+  for (int i = 0; i < kMaxWidth; ++i) {
+    src_a16[i] = (i & 1) ? 65535 : 0;
+    src_b16[i] = (i & 1) ? 0 : 65535;
+  }
+  err = ComputeSumSquareError_16(src_a16, src_b16, kMaxWidth);
+  EXPECT_EQ(static_cast<uint64_t>(kMaxWidth) * 65535 * 65535, err);
+  for (int count = kMaxWidth - 40; count <= kMaxWidth; ++count) {
+    MaskCpuFlags(disable_cpu_flags_);
+    uint64_t c_err = ComputeSumSquareError_16(src_a16, src_b16, count);
+    MaskCpuFlags(benchmark_cpu_info_);
+    uint64_t opt_err = ComputeSumSquareError_16(src_a16, src_b16, count);
+    EXPECT_EQ(static_cast<uint64_t>(count) * 65535 * 65535, c_err);
+    EXPECT_EQ(c_err, opt_err);
+  }
+
+  for (int i = 0; i < kMaxWidth; ++i) {
+    src_a16[i] = (fastrand() & 0xffff);
+    src_b16[i] = (fastrand() & 0xffff);
+  }
+
+  for (int count = kMaxWidth - 40; count <= kMaxWidth; ++count) {
+    MaskCpuFlags(disable_cpu_flags_);
+    uint64_t c_err = ComputeSumSquareError_16(src_a16, src_b16, count);
+    MaskCpuFlags(benchmark_cpu_info_);
+    uint64_t opt_err = ComputeSumSquareError_16(src_a16, src_b16, count);
+    EXPECT_EQ(c_err, opt_err);
+  }
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
+TEST_F(LibYUVCompareTest, BenchmarkPsnr_16_Opt) {
+  const int kSize = benchmark_width_ * benchmark_height_;
+  align_buffer_page_end(src_a, kSize * 2);
+  align_buffer_page_end(src_b, kSize * 2);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  for (int i = 0; i < kSize; ++i) {
+    src_a16[i] = i & 0x3ff;
+    src_b16[i] = i & 0x3ff;
+  }
+
+  MaskCpuFlags(benchmark_cpu_info_);
+
+  double opt_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    CalcFramePsnr_16(src_a16, benchmark_width_, src_b16, benchmark_width_,
+                     benchmark_width_, benchmark_height_, 10);
+  }
+
+  opt_time = (get_time() - opt_time) / benchmark_iterations_;
+  printf("BenchmarkPsnr_16_Opt - %8.2f us opt\n", opt_time * 1e6);
+
+  EXPECT_EQ(0, 0);
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
+TEST_F(LibYUVCompareTest, Psnr_16) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kSize = kWidth * kHeight;
+  align_buffer_page_end(src_a, kSize * 2);
+  align_buffer_page_end(src_b, kSize * 2);
+  align_buffer_page_end(src_a8, kSize);
+  align_buffer_page_end(src_b8, kSize);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  for (int i = 0; i < kSize; ++i) {
+    src_a8[i] = (fastrand() & 0xff);
+    src_b8[i] = (fastrand() & 0xff);
+    src_a16[i] = src_a8[i];
+    src_b16[i] = src_b8[i];
+  }
+
+  // 8 bit samples in uint16_t match CalcFramePsnr.
+  EXPECT_EQ(CalcFramePsnr(src_a8, kWidth, src_b8, kWidth, kWidth, kHeight),
+            CalcFramePsnr_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                             kHeight, 8));
+
+  // The error of a 10 bit peak is 20 * log10(1023 / 255) dB less than the
+  // same error of an 8 bit peak.
+  EXPECT_NEAR(
+      20.0 * log10(1023.0 / 255.0),
+      SumSquareErrorToPsnr_16(1000, 100, 10) - SumSquareErrorToPsnr(1000, 100),
+      1e-9);
+  EXPECT_EQ(kMaxPsnr, SumSquareErrorToPsnr_16(0, 100, 12));
+
+  for (int i = 0; i < kSize; ++i) {
+    src_a16[i] = (fastrand() & 0x3ff);
+    src_b16[i] = (fastrand() & 0x3ff);
+  }
+  MaskCpuFlags(disable_cpu_flags_);
+  double c_err = CalcFramePsnr_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                                  kHeight, 10);
+  MaskCpuFlags(benchmark_cpu_info_);
+  double opt_err = CalcFramePsnr_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                                    kHeight, 10);
+  EXPECT_EQ(c_err, opt_err);
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+  free_aligned_buffer_page_end(src_a8);
+  free_aligned_buffer_page_end(src_b8);
+}
+
+// 8 bit frames scaled to 10 bits measure about the same.
+TEST_F(LibYUVCompareTest, I010PsnrSsim) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kSize = kWidth * kHeight + 2 * kHalfWidth * kHalfHeight;
+  align_buffer_page_end(src_a8, kSize);
+  align_buffer_page_end(src_b8, kSize);
+  align_buffer_page_end(src_a, kSize * 2);
+  align_buffer_page_end(src_b, kSize * 2);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  for (int i = 0; i < kSize; ++i) {
+    src_a8[i] = (fastrand() & 0xff);
+    src_b8[i] = (src_a8[i] + (fastrand() & 0xf)) & 0xff;
+    src_a16[i] = src_a8[i] * 1023 / 255;
+    src_b16[i] = src_b8[i] * 1023 / 255;
+  }
+  const int kOffsetU = kWidth * kHeight;
+  const int kOffsetV = kOffsetU + kHalfWidth * kHalfHeight;
+
+  double opt_time = get_time();
+  double psnr_16 = 0;
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    psnr_16 = I010Psnr(src_a16, kWidth, src_a16 + kOffsetU, kHalfWidth,
+                       src_a16 + kOffsetV, kHalfWidth, src_b16, kWidth,
+                       src_b16 + kOffsetU, kHalfWidth, src_b16 + kOffsetV,
+                       kHalfWidth, kWidth, kHeight);
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations_;
+  printf("I010Psnr - %8.2f us opt\n", opt_time * 1e6);
+
+  opt_time = get_time();
+  double ssim_16 = 0;
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ssim_16 = I010Ssim(src_a16, kWidth, src_a16 + kOffsetU, kHalfWidth,
+                       src_a16 + kOffsetV, kHalfWidth, src_b16, kWidth,
+                       src_b16 + kOffsetU, kHalfWidth, src_b16 + kOffsetV,
+                       kHalfWidth, kWidth, kHeight);
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations_;
+  printf("I010Ssim - %8.2f us opt\n", opt_time * 1e6);
+
+  const double psnr =
+      I420Psnr(src_a8, kWidth, src_a8 + kOffsetU, kHalfWidth,
+               src_a8 + kOffsetV, kHalfWidth, src_b8, kWidth,
+               src_b8 + kOffsetU, kHalfWidth, src_b8 + kOffsetV, kHalfWidth,
+               kWidth, kHeight);
+  EXPECT_NEAR(psnr, psnr_16, 0.1);
+  if (kWidth > 16 && kHeight > 16) {
+    const double ssim =
+        I420Ssim(src_a8, kWidth, src_a8 + kOffsetU, kHalfWidth,
+                 src_a8 + kOffsetV, kHalfWidth, src_b8, kWidth,
+                 src_b8 + kOffsetU, kHalfWidth, src_b8 + kOffsetV, kHalfWidth,
+                 kWidth, kHeight);
+    EXPECT_NEAR(ssim, ssim_16, 0.01);
+  }
+
+  free_aligned_buffer_page_end(src_a8);
+  free_aligned_buffer_page_end(src_b8);
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
 TEST_F(LibYUVCompareTest, DISABLED_BenchmarkSsim_Opt) {
   align_buffer_page_end(src_a, benchmark_width_ * benchmark_height_);
   align_buffer_page_end(src_b, benchmark_width_ * benchmark_height_);
@@ -731,4 +946,409 @@ TEST_F(LibYUVCompareTest, Ssim) {
   free_aligned_buffer_page_end(src_b);
 }
 
+TEST_F(LibYUVCompareTest, SumSquareErrorBlocks) {
+  static const int kBlockSizes[] = {16, 32, 7, 1};
+  const int kWidth = 131;
+  const int kHeight = 67;
+  const int kStride = kWidth + 5;
+  align_buffer_page_end(src_a, kStride * kHeight);
+  align_buffer_page_end(src_b, kStride * kHeight);
+  align_buffer_page_end(dst_c, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_opt, kWidth * kHeight * 4);
+  uint32_t* sse_c = reinterpret_cast<uint32_t*>(dst_c);
+  uint32_t* sse_opt = reinterpret_cast<uint32_t*>(dst_opt);
+  for (int i = 0; i < kStride * kHeight; ++i) {
+    src_a[i] = (fastrand() & 0xff);
+    src_b[i] = (fastrand() & 0xff);
+  }
+
+  for (size_t s = 0; s < sizeof(kBlockSizes) / sizeof(kBlockSizes[0]); ++s) {
+    const int kBlockSize = kBlockSizes[s];
+    const int kDstWidth = (kWidth + kBlockSize - 1) / kBlockSize;
+    const int kDstHeight = (kHeight + kBlockSize - 1) / kBlockSize;
+    MaskCpuFlags(disable_cpu_flags_);
+    EXPECT_EQ(0, ComputeSumSquareErrorBlocks(src_a, kStride, src_b, kStride,
+                                             kWidth, kHeight, kBlockSize,
+                                             sse_c, kDstWidth));
+    MaskCpuFlags(benchmark_cpu_info_);
+    EXPECT_EQ(0, ComputeSumSquareErrorBlocks(src_a, kStride, src_b, kStride,
+                                             kWidth, kHeight, kBlockSize,
+                                             sse_opt, kDstWidth));
+
+    uint64_t total = 0;
+    for (int y = 0; y < kDstHeight; ++y) {
+      for (int x = 0; x < kDstWidth; ++x) {
+        const int i = y * kBlockSize * kStride + x * kBlockSize;
+        const int w = kWidth - x * kBlockSize < kBlockSize
+                          ? kWidth - x * kBlockSize
+                          : kBlockSize;
+        const int h = kHeight - y * kBlockSize < kBlockSize
+                          ? kHeight - y * kBlockSize
+                          : kBlockSize;
+        EXPECT_EQ(ComputeSumSquareErrorPlane(src_a + i, kStride, src_b + i,
+                                             kStride, w, h),
+                  sse_c[y * kDstWidth + x]);
+        EXPECT_EQ(sse_c[y * kDstWidth + x], sse_opt[y * kDstWidth + x]);
+        total += sse_opt[y * kDstWidth + x];
+      }
+    }
+    EXPECT_EQ(ComputeSumSquareErrorPlane(src_a, kStride, src_b, kStride,
+                                         kWidth, kHeight),
+              total);
+  }
+
+  EXPECT_EQ(-1, ComputeSumSquareErrorBlocks(src_a, kStride, src_b, kStride,
+                                            kWidth, kHeight, 257, sse_c, 1));
+  EXPECT_EQ(-1, ComputeSumSquareErrorBlocks(src_a, kStride, src_b, kStride,
+                                            kWidth, kHeight, 0, sse_c, 1));
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
+TEST_F(LibYUVCompareTest, SumSquareErrorBlocks_16) {
+  const int kWidth = 67;
+  const int kHeight = 35;
+  const int kBlockSize = 16;
+  const int kDstWidth = (kWidth + kBlockSize - 1) / kBlockSize;
+  const int kDstHeight = (kHeight + kBlockSize - 1) / kBlockSize;
+  align_buffer_page_end(src_a, kWidth * kHeight * 2);
+  align_buffer_page_end(src_b, kWidth * kHeight * 2);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight * 8);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  uint64_t* sse = reinterpret_cast<uint64_t*>(dst);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a16[i] = (fastrand() & 0xffff);
+    src_b16[i] = (fastrand() & 0xffff);
+  }
+
+  EXPECT_EQ(0, ComputeSumSquareErrorBlocks_16(src_a16, kWidth, src_b16,
+                                              kWidth, kWidth, kHeight,
+                                              kBlockSize, sse, kDstWidth));
+  for (int y = 0; y < kDstHeight; ++y) {
+    for (int x = 0; x < kDstWidth; ++x) {
+      uint64_t ref = 0;
+      for (int j = y * kBlockSize; j < kHeight && j < (y + 1) * kBlockSize;
+           ++j) {
+        for (int i = x * kBlockSize; i < kWidth && i < (x + 1) * kBlockSize;
+             ++i) {
+          const int64_t diff =
+              src_a16[j * kWidth + i] - src_b16[j * kWidth + i];
+          ref += diff * diff;
+        }
+      }
+      EXPECT_EQ(ref, sse[y * kDstWidth + x]);
+    }
+  }
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+  free_aligned_buffer_page_end(dst);
+}
+
+// The 8x8 window SSIM that CalcFrameSsim computed before it used 4x4 block
+// sums.
+static double ReferenceSsim8x8(const uint8_t* src_a,
+                               int stride_a,
+                               const uint8_t* src_b,
+                               int stride_b) {
+  int64_t sum_a = 0;
+  int64_t sum_b = 0;
+  int64_t sum_sq_a = 0;
+  int64_t sum_sq_b = 0;
+  int64_t sum_axb = 0;
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      sum_a += src_a[j];
+      sum_b += src_b[j];
+      sum_sq_a += src_a[j] * src_a[j];
+      sum_sq_b += src_b[j] * src_b[j];
+      sum_axb += src_a[j] * src_b[j];
+    }
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  const int64_t count = 64;
+  const int64_t c1 = (26634 * count * count) >> 12;
+  const int64_t c2 = (239708 * count * count) >> 12;
+  const int64_t sum_a_x_sum_b = sum_a * sum_b;
+  const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
+                         (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+  const int64_t sum_a_sq = sum_a * sum_a;
+  const int64_t sum_b_sq = sum_b * sum_b;
+  const int64_t ssim_d =
+      (sum_a_sq + sum_b_sq + c1) *
+      (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+  if (ssim_d == 0) {
+    return DBL_MAX;
+  }
+  return ssim_n * 1.0 / ssim_d;
+}
+
+static double ReferenceFrameSsim(const uint8_t* src_a,
+                                 int stride_a,
+                                 const uint8_t* src_b,
+                                 int stride_b,
+                                 int width,
+                                 int height) {
+  double ssim_total = 0;
+  int samples = 0;
+  for (int i = 0; i < height - 8; i += 4) {
+    for (int j = 0; j < width - 8; j += 4) {
+      ssim_total += ReferenceSsim8x8(src_a + i * stride_a + j, stride_a,
+                                     src_b + i * stride_b + j, stride_b);
+      ++samples;
+    }
+  }
+  return ssim_total / samples;
+}
+
+// Block sums are exact, so only the order windows are added in differs from
+// the reference.
+TEST_F(LibYUVCompareTest, SsimReference) {
+  static const int kSizes[][2] = {{9, 9},   {13, 17},  {35, 21},   {68, 12},
+                                  {131, 67}, {197, 33}, {1280, 20}, {77, 301}};
+  for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+    const int kWidth = kSizes[s][0];
+    const int kHeight = kSizes[s][1];
+    const int kStride = kWidth + 3;
+    align_buffer_page_end(src_a, kStride * kHeight);
+    align_buffer_page_end(src_b, kStride * kHeight);
+    for (int i = 0; i < kStride * kHeight; ++i) {
+      src_a[i] = (fastrand() & 0xff);
+      src_b[i] = (src_a[i] + (fastrand() & 0x1f)) & 0xff;
+    }
+    const double ref_ssim =
+        ReferenceFrameSsim(src_a, kStride, src_b, kStride, kWidth, kHeight);
+
+    MaskCpuFlags(disable_cpu_flags_);
+    const double c_ssim =
+        CalcFrameSsim(src_a, kStride, src_b, kStride, kWidth, kHeight);
+    MaskCpuFlags(benchmark_cpu_info_);
+    const double opt_ssim =
+        CalcFrameSsim(src_a, kStride, src_b, kStride, kWidth, kHeight);
+
+    EXPECT_NEAR(ref_ssim, c_ssim, 1e-12) << kWidth << "x" << kHeight;
+    EXPECT_EQ(c_ssim, opt_ssim) << kWidth << "x" << kHeight;
+
+    free_aligned_buffer_page_end(src_a);
+    free_aligned_buffer_page_end(src_b);
+  }
+}
+
+// Bands of rows of windows on threads add up to the same SSIM.
+TEST_F(LibYUVCompareTest, SsimThreads) {
+  const int kWidth = 640;
+  const int kHeight = 360;
+  align_buffer_page_end(src_a, kWidth * kHeight);
+  align_buffer_page_end(src_b, kWidth * kHeight);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a[i] = (fastrand() & 0xff);
+    src_b[i] = (src_a[i] + (fastrand() & 0x1f)) & 0xff;
+  }
+  const double ssim =
+      CalcFrameSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight);
+
+  ParallelExecutor* pool = CreateThreadPool(4);
+  SetThreadExecutor(pool);
+  const double threads_ssim =
+      CalcFrameSsim(src_a, kWidth, src_b, kWidth, kWidth, kHeight);
+  SetThreadExecutor(NULL);
+  DestroyThreadPool(pool);
+  EXPECT_EQ(ssim, threads_ssim);
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
+TEST_F(LibYUVCompareTest, Ssim_16) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kSize = kWidth * kHeight * 2;
+  align_buffer_page_end(src_a, kSize);
+  align_buffer_page_end(src_b, kSize);
+  align_buffer_page_end(src_a8, kWidth * kHeight);
+  align_buffer_page_end(src_b8, kWidth * kHeight);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  double err;
+
+  if (kWidth <= 8 || kHeight <= 8) {
+    printf("warning - Ssim size too small.  Testing function executes.\n");
+  }
+
+  EXPECT_EQ(0.0, CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                                  kHeight, 7));
+  EXPECT_EQ(0.0, CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                                  kHeight, 13));
+
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a8[i] = (fastrand() & 0xff);
+    src_b8[i] = (src_a8[i] + (fastrand() & 0x1f)) & 0xff;
+    src_a16[i] = src_a8[i];
+    src_b16[i] = src_b8[i];
+  }
+
+  // 8 bit samples differ from CalcFrameSsim only by the rounding of the
+  // constants.
+  err = CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth, kHeight, 8);
+  if (kWidth > 8 && kHeight > 8) {
+    EXPECT_NEAR(
+        CalcFrameSsim(src_a8, kWidth, src_b8, kWidth, kWidth, kHeight), err,
+        1e-6);
+  }
+
+  // Shifting 8 bit samples to 10 bits scales the sums and constants alike.
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a16[i] = src_a8[i] * 1023 / 255;
+    src_b16[i] = src_b8[i] * 1023 / 255;
+  }
+  err = CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth, kHeight,
+                         10);
+  if (kWidth > 8 && kHeight > 8) {
+    EXPECT_NEAR(
+        CalcFrameSsim(src_a8, kWidth, src_b8, kWidth, kWidth, kHeight), err,
+        0.01);
+  }
+
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a16[i] = (fastrand() & 0xfff);
+    src_b16[i] = (fastrand() & 0xfff);
+  }
+  MaskCpuFlags(disable_cpu_flags_);
+  double c_err = CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                                  kHeight, 12);
+  MaskCpuFlags(benchmark_cpu_info_);
+  double opt_err = CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                                    kHeight, 12);
+  if (kWidth > 8 && kHeight > 8) {
+    EXPECT_EQ(opt_err, c_err);
+    EXPECT_LT(c_err, 0.1);
+  }
+
+  memcpy(src_b16, src_a16, kWidth * kHeight * 2);
+  err = CalcFrameSsim_16(src_a16, kWidth, src_b16, kWidth, kWidth, kHeight,
+                         12);
+  if (kWidth > 8 && kHeight > 8) {
+    EXPECT_NEAR(1.0, err, 1e-12);
+  }
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+  free_aligned_buffer_page_end(src_a8);
+  free_aligned_buffer_page_end(src_b8);
+}
+
+// Each block of the map is the mean of the reference SSIM of the windows
+// that start in it.
+TEST_F(LibYUVCompareTest, SsimMap) {
+  const int kWidth = 328;
+  const int kHeight = 168;
+  const int kBlockSize = 16;
+  const int kDstWidth = (kWidth + kBlockSize - 1) / kBlockSize;
+  const int kDstHeight = (kHeight + kBlockSize - 1) / kBlockSize;
+  align_buffer_page_end(src_a, kWidth * kHeight);
+  align_buffer_page_end(src_b, kWidth * kHeight);
+  // Large enough for a map of 4x4 blocks.
+  align_buffer_page_end(dst_c, kWidth * kHeight);
+  align_buffer_page_end(dst_opt, kWidth * kHeight);
+  float* ssim_c = reinterpret_cast<float*>(dst_c);
+  float* ssim_opt = reinterpret_cast<float*>(dst_opt);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a[i] = (fastrand() & 0xff);
+    src_b[i] = (src_a[i] + (fastrand() & 0x1f)) & 0xff;
+  }
+
+  MaskCpuFlags(disable_cpu_flags_);
+  EXPECT_EQ(0, CalcSsimMap(src_a, kWidth, src_b, kWidth, kWidth, kHeight,
+                           kBlockSize, ssim_c, kDstWidth));
+  MaskCpuFlags(benchmark_cpu_info_);
+  EXPECT_EQ(0, CalcSsimMap(src_a, kWidth, src_b, kWidth, kWidth, kHeight,
+                           kBlockSize, ssim_opt, kDstWidth));
+
+  for (int y = 0; y < kDstHeight; ++y) {
+    for (int x = 0; x < kDstWidth; ++x) {
+      // The last row and column have no windows. Windows start up to 8
+      // pixels before the edge.
+      const int by = y < kDstHeight - 1 ? y : y - 1;
+      const int bx = x < kDstWidth - 1 ? x : x - 1;
+      double ref = 0;
+      int count = 0;
+      for (int j = by * kBlockSize; j < (by + 1) * kBlockSize; j += 4) {
+        for (int i = bx * kBlockSize; i < (bx + 1) * kBlockSize; i += 4) {
+          if (j < kHeight - 8 && i < kWidth - 8) {
+            ref += ReferenceSsim8x8(src_a + j * kWidth + i, kWidth,
+                                    src_b + j * kWidth + i, kWidth);
+            ++count;
+          }
+        }
+      }
+      EXPECT_NEAR(ref / count, ssim_c[y * kDstWidth + x], 1e-6);
+      EXPECT_EQ(ssim_c[y * kDstWidth + x], ssim_opt[y * kDstWidth + x]);
+    }
+  }
+
+  ParallelExecutor* pool = CreateThreadPool(4);
+  SetThreadExecutor(pool);
+  EXPECT_EQ(0, CalcSsimMap(src_a, kWidth, src_b, kWidth, kWidth, kHeight, 4,
+                           ssim_opt, (kWidth + 3) / 4));
+  SetThreadExecutor(NULL);
+  DestroyThreadPool(pool);
+  EXPECT_EQ(0, CalcSsimMap(src_a, kWidth, src_b, kWidth, kWidth, kHeight, 4,
+                           ssim_c, (kWidth + 3) / 4));
+  for (int i = 0; i < (kWidth + 3) / 4 * ((kHeight + 3) / 4); ++i) {
+    EXPECT_EQ(ssim_c[i], ssim_opt[i]);
+  }
+
+  EXPECT_EQ(-1, CalcSsimMap(src_a, kWidth, src_b, kWidth, kWidth, kHeight, 6,
+                            ssim_c, kDstWidth));
+  EXPECT_EQ(-1, CalcSsimMap(src_a, kWidth, src_b, kWidth, 8, kHeight,
+                            kBlockSize, ssim_c, kDstWidth));
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
+TEST_F(LibYUVCompareTest, SsimMap_16) {
+  const int kWidth = 64;
+  const int kHeight = 48;
+  const int kBlockSize = 16;
+  const int kDstWidth = kWidth / kBlockSize;
+  const int kDstHeight = kHeight / kBlockSize;
+  align_buffer_page_end(src_a, kWidth * kHeight * 2);
+  align_buffer_page_end(src_b, kWidth * kHeight * 2);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight * 4);
+  uint16_t* src_a16 = reinterpret_cast<uint16_t*>(src_a);
+  uint16_t* src_b16 = reinterpret_cast<uint16_t*>(src_b);
+  float* ssim = reinterpret_cast<float*>(dst);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_a16[i] = (fastrand() & 0x3ff);
+    src_b16[i] = src_a16[i];
+  }
+  // Distort the top left block only.
+  for (int y = 0; y < kBlockSize; ++y) {
+    for (int x = 0; x < kBlockSize; ++x) {
+      src_b16[y * kWidth + x] = (fastrand() & 0x3ff);
+    }
+  }
+
+  EXPECT_EQ(0, CalcSsimMap_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                              kHeight, 10, kBlockSize, ssim, kDstWidth));
+  // Windows that start in the top left block reach 4 pixels into the next.
+  EXPECT_LT(ssim[0], 0.5f);
+  EXPECT_NEAR(1.0f, ssim[1], 1e-6f);
+  EXPECT_NEAR(1.0f, ssim[kDstWidth * kDstHeight - 1], 1e-6f);
+  EXPECT_EQ(-1, CalcSsimMap_16(src_a16, kWidth, src_b16, kWidth, kWidth,
+                               kHeight, 16, kBlockSize, ssim, kDstWidth));
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+  free_aligned_buffer_page_end(dst);
+}
+
 }  // namespace libyuv
@@ -2021,6 +2021,160 @@ TEST_F(LibYUVConvertTest, TestMJPGToARGB) {
   free_aligned_buffer_page_end(dst_argb);
 }
 
+// Decode with MJPGToI420Scaled and compare to a full size decode that is
+// scaled with a box filter. Returns the largest difference.
+static int TestMJPGToI420Scaled(const uint8_t* sample,
+                                size_t sample_size,
+                                int dst_width,
+                                int dst_height) {
+  int width = 0;
+  int height = 0;
+  EXPECT_EQ(0, MJPGSize(sample, sample_size, &width, &height));
+  const int half_width = (width + 1) / 2;
+  const int half_height = (height + 1) / 2;
+  const int dst_half_width = (dst_width + 1) / 2;
+  const int dst_half_height = (dst_height + 1) / 2;
+  const int dst_size = dst_width * dst_height +
+                       dst_half_width * dst_half_height * 2;
+
+  align_buffer_page_end(src_y, width * height);
+  align_buffer_page_end(src_u, half_width * half_height);
+  align_buffer_page_end(src_v, half_width * half_height);
+  align_buffer_page_end(dst_ref, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  uint8_t* dst_ref_u = dst_ref + dst_width * dst_height;
+  uint8_t* dst_ref_v = dst_ref_u + dst_half_width * dst_half_height;
+  uint8_t* dst_opt_u = dst_opt + dst_width * dst_height;
+  uint8_t* dst_opt_v = dst_opt_u + dst_half_width * dst_half_height;
+  memset(dst_opt, 0, dst_size);
+
+  EXPECT_EQ(0, MJPGToI420(sample, sample_size, src_y, width, src_u, half_width,
+                          src_v, half_width, width, height, width, height));
+  I420Scale(src_y, width, src_u, half_width, src_v, half_width, width, height,
+            dst_ref, dst_width, dst_ref_u, dst_half_width, dst_ref_v,
+            dst_half_width, dst_width, dst_height, kFilterBox);
+  EXPECT_EQ(0, MJPGToI420Scaled(sample, sample_size, dst_opt, dst_width,
+                                dst_opt_u, dst_half_width, dst_opt_v,
+                                dst_half_width, width, height, dst_width,
+                                dst_height, kFilterBox));
+
+  int max_diff = 0;
+  for (int i = 0; i < dst_size; ++i) {
+    int abs_diff = abs(static_cast<int>(dst_ref[i]) -
+                       static_cast<int>(dst_opt[i]));
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(dst_opt);
+  return max_diff;
+}
+
+TEST_F(LibYUVConvertTest, TestMJPGToI420Scaled) {
+  // J400, J444 and J420. A full size decode matches MJPGToI420, and the DCT
+  // scaled decodes are within rounding of a box filter.
+  const uint8_t* const kJpgs[3] = {kTest0Jpg, kTest1Jpg, kTest2Jpg};
+  const size_t kJpgLens[3] = {kTest0JpgLen, kTest1JpgLen, kTest2JpgLen};
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(0, TestMJPGToI420Scaled(kJpgs[i], kJpgLens[i], 32, 16));
+    EXPECT_LE(TestMJPGToI420Scaled(kJpgs[i], kJpgLens[i], 16, 8), 1);
+    EXPECT_LE(TestMJPGToI420Scaled(kJpgs[i], kJpgLens[i], 8, 4), 1);
+    EXPECT_LE(TestMJPGToI420Scaled(kJpgs[i], kJpgLens[i], 4, 2), 1);
+  }
+  // J422. I422ToI420 point samples chroma rows, so the full size reference
+  // takes every other chroma row where the DCT averages them.
+  EXPECT_EQ(0, TestMJPGToI420Scaled(kTest3Jpg, kTest3JpgLen, 32, 16));
+  EXPECT_LE(TestMJPGToI420Scaled(kTest3Jpg, kTest3JpgLen, 16, 8), 16);
+  EXPECT_LE(TestMJPGToI420Scaled(kTest3Jpg, kTest3JpgLen, 8, 4), 16);
+  EXPECT_LE(TestMJPGToI420Scaled(kTest3Jpg, kTest3JpgLen, 4, 2), 16);
+}
+
+// Sizes between DCT scales decode at the next larger scale and then scale.
+TEST_F(LibYUVConvertTest, TestMJPGToScaled_Filter) {
+  const int kWidth = 12;
+  const int kHeight = 6;
+  const int kHalfWidth = kWidth / 2;
+  const int kHalfHeight = kHeight / 2;
+  const int kSize = kWidth * kHeight + kHalfWidth * kHalfHeight * 2;
+  align_buffer_page_end(half, 16 * 8 + 8 * 4 * 2);
+  align_buffer_page_end(dst_ref, kSize);
+  align_buffer_page_end(dst_opt, kSize);
+  align_buffer_page_end(dst_nv21_ref, kSize);
+  align_buffer_page_end(dst_nv21_opt, kSize);
+  align_buffer_page_end(dst_argb_ref, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb_opt, kWidth * kHeight * 4);
+  uint8_t* half_u = half + 16 * 8;
+  uint8_t* half_v = half_u + 8 * 4;
+  uint8_t* dst_ref_u = dst_ref + kWidth * kHeight;
+  uint8_t* dst_ref_v = dst_ref_u + kHalfWidth * kHalfHeight;
+  uint8_t* dst_opt_u = dst_opt + kWidth * kHeight;
+  uint8_t* dst_opt_v = dst_opt_u + kHalfWidth * kHalfHeight;
+
+  EXPECT_EQ(0, MJPGToI420Scaled(kTest2Jpg, kTest2JpgLen, half, 16, half_u, 8,
+                                half_v, 8, 32, 16, 16, 8, kFilterBox));
+  I420Scale(half, 16, half_u, 8, half_v, 8, 16, 8, dst_ref, kWidth, dst_ref_u,
+            kHalfWidth, dst_ref_v, kHalfWidth, kWidth, kHeight, kFilterBox);
+  EXPECT_EQ(0, MJPGToI420Scaled(kTest2Jpg, kTest2JpgLen, dst_opt, kWidth,
+                                dst_opt_u, kHalfWidth, dst_opt_v, kHalfWidth,
+                                32, 16, kWidth, kHeight, kFilterBox));
+  for (int i = 0; i < kSize; ++i) {
+    EXPECT_EQ(dst_ref[i], dst_opt[i]);
+  }
+
+  I420ToNV21(dst_ref, kWidth, dst_ref_u, kHalfWidth, dst_ref_v, kHalfWidth,
+             dst_nv21_ref, kWidth, dst_nv21_ref + kWidth * kHeight,
+             kHalfWidth * 2, kWidth, kHeight);
+  EXPECT_EQ(0, MJPGToNV21Scaled(kTest2Jpg, kTest2JpgLen, dst_nv21_opt, kWidth,
+                                dst_nv21_opt + kWidth * kHeight,
+                                kHalfWidth * 2, 32, 16, kWidth, kHeight,
+                                kFilterBox));
+  for (int i = 0; i < kSize; ++i) {
+    EXPECT_EQ(dst_nv21_ref[i], dst_nv21_opt[i]);
+  }
+
+  I420ToARGB(dst_ref, kWidth, dst_ref_u, kHalfWidth, dst_ref_v, kHalfWidth,
+             dst_argb_ref, kWidth * 4, kWidth, kHeight);
+  EXPECT_EQ(0, MJPGToARGBScaled(kTest2Jpg, kTest2JpgLen, dst_argb_opt,
+                                kWidth * 4, 32, 16, kWidth, kHeight,
+                                kFilterBox));
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_argb_ref[i], dst_argb_opt[i]);
+  }
+
+  free_aligned_buffer_page_end(half);
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(dst_nv21_ref);
+  free_aligned_buffer_page_end(dst_nv21_opt);
+  free_aligned_buffer_page_end(dst_argb_ref);
+  free_aligned_buffer_page_end(dst_argb_opt);
+}
+
+// DCT scaled sizes write the destination directly.
+TEST_F(LibYUVConvertTest, TestMJPGToARGBScaled) {
+  align_buffer_page_end(dst_argb, 16 * 8 * 4);
+  align_buffer_page_end(dst_y, 16 * 8);
+  align_buffer_page_end(dst_vu, 8 * 4 * 2);
+  EXPECT_EQ(0, MJPGToARGBScaled(kTest3Jpg, kTest3JpgLen, dst_argb, 16 * 4, 32,
+                                16, 16, 8, kFilterBox));
+  EXPECT_EQ(0, MJPGToNV21Scaled(kTest3Jpg, kTest3JpgLen, dst_y, 16, dst_vu, 16,
+                                32, 16, 16, 8, kFilterBox));
+  // Unsupported subsampling and bad sizes fail.
+  EXPECT_EQ(1, MJPGToARGBScaled(kTest4Jpg, kTest4JpgLen, dst_argb, 16 * 4, 32,
+                                16, 16, 8, kFilterBox));
+  EXPECT_EQ(1, MJPGToARGBScaled(kTest3Jpg, kTest3JpgLen, dst_argb, 16 * 4, 64,
+                                16, 16, 8, kFilterBox));
+  EXPECT_EQ(-1, MJPGToARGBScaled(kTest3Jpg, kTest3JpgLen, dst_argb, 16 * 4, 32,
+                                 16, 0, 8, kFilterBox));
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(dst_y);
+  free_aligned_buffer_page_end(dst_vu);
+}
+
 static int ShowJPegInfo(const uint8_t* sample, size_t sample_size) {
   MJpegDecoder mjpeg_decoder;
   LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(sample, sample_size);
@@ -2716,6 +2870,153 @@ TEST_F(LibYUVConvertTest, RotateWithARGBSource) {
   EXPECT_EQ(dst[3], src[1]);
 }
 
+// Compare the optimized Bayer demosaic to C for each pattern.
+#define TESTBAYERTOARGBI(FOURCC, W1280, N, NEG)                              \
+  TEST_F(LibYUVConvertTest, Bayer##FOURCC##ToARGB##N) {                      \
+    const int kWidth = ((W1280) > 0) ? (W1280) : 1;                          \
+    const int kHeight = benchmark_height_;                                   \
+    align_buffer_page_end(src_bayer, kWidth* kHeight);                       \
+    align_buffer_page_end(dst_argb_c, kWidth* kHeight * 4);                  \
+    align_buffer_page_end(dst_argb_opt, kWidth* kHeight * 4);                \
+    for (int i = 0; i < kWidth * kHeight; ++i) {                             \
+      src_bayer[i] = (fastrand() & 0xff);                                    \
+    }                                                                        \
+    memset(dst_argb_c, 1, kWidth * kHeight * 4);                             \
+    memset(dst_argb_opt, 101, kWidth * kHeight * 4);                         \
+    MaskCpuFlags(disable_cpu_flags_);                                        \
+    EXPECT_EQ(0, BayerToARGB(src_bayer, kWidth, dst_argb_c, kWidth * 4,      \
+                             kWidth, NEG kHeight, FOURCC_##FOURCC));         \
+    MaskCpuFlags(benchmark_cpu_info_);                                       \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                        \
+      BayerToARGB(src_bayer, kWidth, dst_argb_opt, kWidth * 4, kWidth,       \
+                  NEG kHeight, FOURCC_##FOURCC);                             \
+    }                                                                        \
+    for (int i = 0; i < kWidth * kHeight * 4; ++i) {                         \
+      EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);                             \
+    }                                                                        \
+    free_aligned_buffer_page_end(src_bayer);                                 \
+    free_aligned_buffer_page_end(dst_argb_c);                                \
+    free_aligned_buffer_page_end(dst_argb_opt);                              \
+  }
+
+#define TESTBAYERTOARGB(FOURCC)                                     \
+  TESTBAYERTOARGBI(FOURCC, benchmark_width_ - 4, _Any, +)           \
+  TESTBAYERTOARGBI(FOURCC, benchmark_width_, _Invert, -)            \
+  TESTBAYERTOARGBI(FOURCC, benchmark_width_, _Opt, +)               \
+  TESTBAYERTOARGBI(FOURCC, benchmark_width_ + 2, _Interior_Opt, +)
+
+TESTBAYERTOARGB(RGGB)
+TESTBAYERTOARGB(BGGR)
+TESTBAYERTOARGB(GRBG)
+TESTBAYERTOARGB(GBRG)
+
+// A Bayer image of one color demosaics to that color, including the edges.
+TEST_F(LibYUVConvertTest, TestBayerToARGBFlat) {
+  const int kWidth = 37;
+  const int kHeight = 5;
+  const uint32_t kFourCC[4] = {FOURCC_RGGB, FOURCC_BGGR, FOURCC_GRBG,
+                               FOURCC_GBRG};
+  const uint8_t kR = 200, kG = 100, kB = 30;
+  uint8_t src_bayer[kWidth * kHeight];
+  uint8_t dst_argb[kWidth * kHeight * 4];
+  for (int f = 0; f < 4; ++f) {
+    // Name of the fourcc, first 2 rows, in memory order.
+    const char* colors = reinterpret_cast<const char*>(&kFourCC[f]);
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        char c = colors[(y & 1) * 2 + (x & 1)];
+        src_bayer[y * kWidth + x] = c == 'R' ? kR : c == 'G' ? kG : kB;
+      }
+    }
+    for (int height = 2; height <= kHeight; ++height) {
+      for (int width = 2; width <= kWidth; width += 3) {
+        memset(dst_argb, 0, sizeof(dst_argb));
+        EXPECT_EQ(0, BayerToARGB(src_bayer, kWidth, dst_argb, kWidth * 4,
+                                 width, height, kFourCC[f]));
+        for (int y = 0; y < height; ++y) {
+          for (int x = 0; x < width; ++x) {
+            const uint8_t* p = dst_argb + (y * kWidth + x) * 4;
+            EXPECT_EQ(kB, p[0]);
+            EXPECT_EQ(kG, p[1]);
+            EXPECT_EQ(kR, p[2]);
+            EXPECT_EQ(255, p[3]);
+          }
+        }
+      }
+    }
+  }
+}
+
+// BayerToI420 matches BayerToARGB followed by ARGBToI420.
+TEST_F(LibYUVConvertTest, TestBayerToI420) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  align_buffer_page_end(src_bayer, kWidth * kHeight);
+  align_buffer_page_end(argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_i420_a, kWidth * kHeight +
+                                        kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(dst_i420_b, kWidth * kHeight +
+                                        kHalfWidth * kHalfHeight * 2);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_bayer[i] = (fastrand() & 0xff);
+  }
+  BayerToARGB(src_bayer, kWidth, argb, kWidth * 4, kWidth, kHeight,
+              FOURCC_GRBG);
+  ARGBToI420(argb, kWidth * 4, dst_i420_a, kWidth,
+             dst_i420_a + kWidth * kHeight, kHalfWidth,
+             dst_i420_a + kWidth * kHeight + kHalfWidth * kHalfHeight,
+             kHalfWidth, kWidth, kHeight);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    BayerToI420(src_bayer, kWidth, dst_i420_b, kWidth,
+                dst_i420_b + kWidth * kHeight, kHalfWidth,
+                dst_i420_b + kWidth * kHeight + kHalfWidth * kHalfHeight,
+                kHalfWidth, kWidth, kHeight, FOURCC_GRBG);
+  }
+  for (int i = 0; i < kWidth * kHeight + kHalfWidth * kHalfHeight * 2; ++i) {
+    EXPECT_EQ(dst_i420_a[i], dst_i420_b[i]);
+  }
+  free_aligned_buffer_page_end(src_bayer);
+  free_aligned_buffer_page_end(argb);
+  free_aligned_buffer_page_end(dst_i420_a);
+  free_aligned_buffer_page_end(dst_i420_b);
+}
+
+// Cropping a Bayer sample at odd offsets keeps the colors.
+TEST_F(LibYUVConvertTest, TestBayerCrop) {
+  const int kWidth = 64;
+  const int kHeight = 16;
+  const int kCropWidth = 30;
+  const int kCropHeight = 10;
+  uint8_t src_bayer[kWidth * kHeight];
+  uint8_t dst_argb_crop[kCropWidth * kCropHeight * 4];
+  uint8_t dst_argb[kWidth * kHeight * 4];
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_bayer[i] = (fastrand() & 0xff);
+  }
+  EXPECT_EQ(FOURCC_RGGB, CropBayerFourCC(FOURCC_RGGB, 2, 4));
+  EXPECT_EQ(FOURCC_GRBG, CropBayerFourCC(FOURCC_RGGB, 1, 0));
+  EXPECT_EQ(FOURCC_GBRG, CropBayerFourCC(FOURCC_RGGB, 0, 1));
+  EXPECT_EQ(FOURCC_BGGR, CropBayerFourCC(FOURCC_RGGB, 1, 1));
+  EXPECT_EQ(FOURCC_I420, CropBayerFourCC(FOURCC_I420, 1, 1));
+
+  BayerToARGB(src_bayer, kWidth, dst_argb, kWidth * 4, kWidth, kHeight,
+              FOURCC_BGGR);
+  EXPECT_EQ(0, ConvertToARGB(src_bayer, kWidth * kHeight, dst_argb_crop,
+                             kCropWidth * 4, 3, 5, kWidth, kHeight,
+                             kCropWidth, kCropHeight, kRotate0, FOURCC_BGGR));
+  // Pixels away from the edges of the crop see the same neighbours.
+  for (int y = 1; y < kCropHeight - 1; ++y) {
+    for (int x = 1; x < kCropWidth - 1; ++x) {
+      for (int c = 0; c < 4; ++c) {
+        EXPECT_EQ(dst_argb[((y + 5) * kWidth + x + 3) * 4 + c],
+                  dst_argb_crop[(y * kCropWidth + x) * 4 + c]);
+      }
+    }
+  }
+}
+
 #ifdef HAS_ARGBTOAR30ROW_AVX2
 TEST_F(LibYUVConvertTest, ARGBToAR30Row_Opt) {
   // ARGBToAR30Row_AVX2 expects a multiple of 8 pixels.
@@ -2858,6 +3159,180 @@ TESTPLANAR16TOB(H010, 2, 2, ABGR, 4, 4, 1, 2)
 TESTPLANAR16TOB(H010, 2, 2, AR30, 4, 4, 1, 2)
 TESTPLANAR16TOB(H010, 2, 2, AB30, 4, 4, 1, 2)
 
+#define TESTBIPLANAR16TOBI(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B,  \
+                           ALIGN, YALIGN, W1280, DIFF, N, NEG, SOFF, DOFF)  \
+  TEST_F(LibYUVConvertTest, FMT_PLANAR##To##FMT_B##N) {                     \
+    const int kWidth = ((W1280) > 0) ? (W1280) : 1;                         \
+    const int kHeight = ALIGNINT(benchmark_height_, YALIGN);                \
+    const int kStrideB = ALIGNINT(kWidth * BPP_B, ALIGN);                   \
+    const int kStrideUV = SUBSAMPLE(kWidth, SUBSAMP_X) * 2;                 \
+    const int kSizeUV = kStrideUV * SUBSAMPLE(kHeight, SUBSAMP_Y);          \
+    const int kBpc = 2;                                                     \
+    align_buffer_page_end(src_y, kWidth* kHeight* kBpc + SOFF);             \
+    align_buffer_page_end(src_uv, kSizeUV* kBpc + SOFF);                    \
+    align_buffer_page_end(dst_argb_c, kStrideB* kHeight + DOFF);            \
+    align_buffer_page_end(dst_argb_opt, kStrideB* kHeight + DOFF);          \
+    for (int i = 0; i < kWidth * kHeight; ++i) {                            \
+      reinterpret_cast<uint16_t*>(src_y + SOFF)[i] = (fastrand() & 0xffc0); \
+    }                                                                       \
+    for (int i = 0; i < kSizeUV; ++i) {                                     \
+      reinterpret_cast<uint16_t*>(src_uv + SOFF)[i] =                       \
+          (fastrand() & 0xffc0);                                            \
+    }                                                                       \
+    memset(dst_argb_c + DOFF, 1, kStrideB * kHeight);                       \
+    memset(dst_argb_opt + DOFF, 101, kStrideB * kHeight);                   \
+    MaskCpuFlags(disable_cpu_flags_);                                       \
+    FMT_PLANAR##To##FMT_B(reinterpret_cast<uint16_t*>(src_y + SOFF),        \
+                          kWidth,                                           \
+                          reinterpret_cast<uint16_t*>(src_uv + SOFF),       \
+                          kStrideUV, dst_argb_c + DOFF, kStrideB, kWidth,   \
+                          NEG kHeight);                                     \
+    MaskCpuFlags(benchmark_cpu_info_);                                      \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                       \
+      FMT_PLANAR##To##FMT_B(reinterpret_cast<uint16_t*>(src_y + SOFF),      \
+                            kWidth,                                         \
+                            reinterpret_cast<uint16_t*>(src_uv + SOFF),     \
+                            kStrideUV, dst_argb_opt + DOFF, kStrideB,       \
+                            kWidth, NEG kHeight);                           \
+    }                                                                       \
+    int max_diff = 0;                                                       \
+    for (int i = 0; i < kWidth * BPP_B * kHeight; ++i) {                    \
+      int abs_diff = abs(static_cast<int>(dst_argb_c[i + DOFF]) -           \
+                         static_cast<int>(dst_argb_opt[i + DOFF]));         \
+      if (abs_diff > max_diff) {                                            \
+        max_diff = abs_diff;                                                \
+      }                                                                     \
+    }                                                                       \
+    EXPECT_LE(max_diff, DIFF);                                              \
+    free_aligned_buffer_page_end(src_y);                                    \
+    free_aligned_buffer_page_end(src_uv);                                   \
+    free_aligned_buffer_page_end(dst_argb_c);                               \
+    free_aligned_buffer_page_end(dst_argb_opt);                             \
+  }
+
+#define TESTBIPLANAR16TOB(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B,   \
+                          ALIGN, YALIGN, DIFF)                              \
+  TESTBIPLANAR16TOBI(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B, ALIGN, \
+                     YALIGN, benchmark_width_ - 4, DIFF, _Any, +, 0, 0)     \
+  TESTBIPLANAR16TOBI(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B, ALIGN, \
+                     YALIGN, benchmark_width_, DIFF, _Unaligned, +, 1, 1)   \
+  TESTBIPLANAR16TOBI(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B, ALIGN, \
+                     YALIGN, benchmark_width_, DIFF, _Invert, -, 0, 0)      \
+  TESTBIPLANAR16TOBI(FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y, FMT_B, BPP_B, ALIGN, \
+                     YALIGN, benchmark_width_, DIFF, _Opt, +, 0, 0)
+
+TESTBIPLANAR16TOB(P010, 2, 2, ARGB, 4, 4, 1, 0)
+TESTBIPLANAR16TOB(P010, 2, 2, AR30, 4, 4, 1, 0)
+
+// P010 holds I010 samples in the upper bits, so the conversion to P010 and
+// back is lossless.
+TEST_F(LibYUVConvertTest, I010ToP010ToI010) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);
+  const int kSizeUV = kHalfWidth * kHalfHeight;
+  align_buffer_page_end(src_y, kWidth * kHeight * 2);
+  align_buffer_page_end(src_u, kSizeUV * 2);
+  align_buffer_page_end(src_v, kSizeUV * 2);
+  align_buffer_page_end(p010_y, kWidth * kHeight * 2);
+  align_buffer_page_end(p010_uv, kSizeUV * 4);
+  align_buffer_page_end(dst_y, kWidth * kHeight * 2);
+  align_buffer_page_end(dst_u, kSizeUV * 2);
+  align_buffer_page_end(dst_v, kSizeUV * 2);
+  uint16_t* src_y16 = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* src_u16 = reinterpret_cast<uint16_t*>(src_u);
+  uint16_t* src_v16 = reinterpret_cast<uint16_t*>(src_v);
+  uint16_t* p010_y16 = reinterpret_cast<uint16_t*>(p010_y);
+  uint16_t* p010_uv16 = reinterpret_cast<uint16_t*>(p010_uv);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y16[i] = fastrand() & 0x3ff;
+  }
+  for (int i = 0; i < kSizeUV; ++i) {
+    src_u16[i] = fastrand() & 0x3ff;
+    src_v16[i] = fastrand() & 0x3ff;
+  }
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, I010ToP010(src_y16, kWidth, src_u16, kHalfWidth, src_v16,
+                            kHalfWidth, p010_y16, kWidth, p010_uv16,
+                            kHalfWidth * 2, kWidth, kHeight));
+  }
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(src_y16[i] << 6, p010_y16[i]);
+  }
+  for (int i = 0; i < kSizeUV; ++i) {
+    EXPECT_EQ(src_u16[i] << 6, p010_uv16[i * 2 + 0]);
+    EXPECT_EQ(src_v16[i] << 6, p010_uv16[i * 2 + 1]);
+  }
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, P010ToI010(p010_y16, kWidth, p010_uv16, kHalfWidth * 2,
+                            reinterpret_cast<uint16_t*>(dst_y), kWidth,
+                            reinterpret_cast<uint16_t*>(dst_u), kHalfWidth,
+                            reinterpret_cast<uint16_t*>(dst_v), kHalfWidth,
+                            kWidth, kHeight));
+  }
+  EXPECT_EQ(0, memcmp(src_y, dst_y, kWidth * kHeight * 2));
+  EXPECT_EQ(0, memcmp(src_u, dst_u, kSizeUV * 2));
+  EXPECT_EQ(0, memcmp(src_v, dst_v, kSizeUV * 2));
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(p010_y);
+  free_aligned_buffer_page_end(p010_uv);
+  free_aligned_buffer_page_end(dst_y);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_v);
+}
+
+TEST_F(LibYUVConvertTest, P010ToNV12) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kStrideUV = SUBSAMPLE(kWidth, 2) * 2;
+  const int kSizeUV = kStrideUV * SUBSAMPLE(kHeight, 2);
+  align_buffer_page_end(src_y, kWidth * kHeight * 2);
+  align_buffer_page_end(src_uv, kSizeUV * 2);
+  align_buffer_page_end(dst_y_c, kWidth * kHeight);
+  align_buffer_page_end(dst_uv_c, kSizeUV);
+  align_buffer_page_end(dst_y_opt, kWidth * kHeight);
+  align_buffer_page_end(dst_uv_opt, kSizeUV);
+  uint16_t* src_y16 = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* src_uv16 = reinterpret_cast<uint16_t*>(src_uv);
+  // Full range 16 bit values, as in P016, to test rounding of 0xffff.
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y16[i] = fastrand() & 0xffff;
+  }
+  for (int i = 0; i < kSizeUV; ++i) {
+    src_uv16[i] = fastrand() & 0xffff;
+  }
+  src_y16[0] = 0xffff;
+  src_y16[kWidth * kHeight - 1] = 0x017f;
+  MaskCpuFlags(disable_cpu_flags_);
+  P010ToNV12(src_y16, kWidth, src_uv16, kStrideUV, dst_y_c, kWidth, dst_uv_c,
+             kStrideUV, kWidth, kHeight);
+  MaskCpuFlags(benchmark_cpu_info_);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    P010ToNV12(src_y16, kWidth, src_uv16, kStrideUV, dst_y_opt, kWidth,
+               dst_uv_opt, kStrideUV, kWidth, kHeight);
+  }
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+    EXPECT_EQ(dst_y_c[i], (src_y16[i] + 128) >> 8 > 255
+                              ? 255
+                              : (src_y16[i] + 128) >> 8);
+  }
+  for (int i = 0; i < kSizeUV; ++i) {
+    EXPECT_EQ(dst_uv_c[i], dst_uv_opt[i]);
+  }
+  EXPECT_EQ(255, dst_y_opt[0]);
+  EXPECT_EQ(1, dst_y_opt[kWidth * kHeight - 1]);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_uv_opt);
+}
+
 static int Clamp(int y) {
   if (y < 0) {
     y = 0;
@@ -0,0 +1,286 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <thread>
+
+#include "../source/executor_internal.h"
+#include "../unit_test/unit_test.h"
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/convert_from_argb.h"
+#include "libyuv/executor.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/rotate.h"
+#include "libyuv/scale.h"
+
+namespace libyuv {
+
+static const int kThreads[] = {1, 2, 4, 8};
+static const int kNumThreads = sizeof(kThreads) / sizeof(kThreads[0]);
+
+static void CountRange(void* arg, int begin, int end) {
+  int* counts = static_cast<int*>(arg);
+  for (int i = begin; i < end; ++i) {
+    ++counts[i];
+  }
+}
+
+static void ParallelForCounts(const ParallelExecutor* executor, int* diff) {
+  for (int count = 0; count < 100; ++count) {
+    int counts[100] = {0};
+    executor->parallel_for(executor->opaque, count, CountRange, counts);
+    for (int i = 0; i < 100; ++i) {
+      if (counts[i] != (i < count ? 1 : 0)) {
+        ++*diff;
+      }
+    }
+  }
+}
+
+// Every index is run exactly once, including when several threads share the
+// pool.
+TEST_F(LibYUVBaseTest, ThreadPoolParallelFor) {
+  for (int t = 0; t < kNumThreads; ++t) {
+    ParallelExecutor* pool = CreateThreadPool(kThreads[t]);
+    int diff[3] = {0, 0, 0};
+    EXPECT_EQ(kThreads[t], pool->concurrency);
+    std::thread thread1(ParallelForCounts, pool, &diff[1]);
+    std::thread thread2(ParallelForCounts, pool, &diff[2]);
+    ParallelForCounts(pool, &diff[0]);
+    thread1.join();
+    thread2.join();
+    DestroyThreadPool(pool);
+    EXPECT_EQ(0, diff[0]);
+    EXPECT_EQ(0, diff[1]);
+    EXPECT_EQ(0, diff[2]);
+  }
+}
+
+TEST_F(LibYUVBaseTest, ThreadExecutor) {
+  ParallelExecutor* pool = CreateThreadPool(4);
+  int counts[720] = {0};
+  EXPECT_EQ(NULL, GetThreadExecutor());
+  EXPECT_EQ(-1, ParallelRows(1280, 720, 2, CountRange, counts));
+  SetThreadExecutor(pool);
+  EXPECT_EQ(pool, GetThreadExecutor());
+  // Too small to be worth splitting.
+  EXPECT_EQ(-1, ParallelRows(16, 16, 1, CountRange, counts));
+  EXPECT_EQ(0, ParallelRows(1280, 720, 2, CountRange, counts));
+  SetThreadExecutor(NULL);
+  DestroyThreadPool(pool);
+  for (int i = 0; i < 720; ++i) {
+    EXPECT_EQ(1, counts[i]);
+  }
+}
+
+// A conversion of a width by height image stored in buffers large enough for
+// any of the formats tested.
+typedef void (*ThreadsTestFunc)(const uint8_t* src,
+                                uint8_t* dst,
+                                int width,
+                                int height);
+
+// Convert with executors of each thread count and compare with the result of
+// converting on the calling thread.
+static int TestThreads(const char* name,
+                       ThreadsTestFunc func,
+                       int width,
+                       int height,
+                       int benchmark_iterations) {
+  const int kSize = width * height * 4;
+  int diff = 0;
+  align_buffer_page_end(src, kSize);
+  align_buffer_page_end(dst_c, kSize);
+  align_buffer_page_end(dst_opt, kSize);
+  MemRandomize(src, kSize);
+  memset(dst_c, 2, kSize);
+
+  double c_time = get_time();
+  func(src, dst_c, width, height);
+  c_time = (get_time() - c_time);
+
+  for (int t = 0; t < kNumThreads; ++t) {
+    ParallelExecutor* pool = CreateThreadPool(kThreads[t]);
+    memset(dst_opt, 2, kSize);
+    SetThreadExecutor(pool);
+    double opt_time = get_time();
+    for (int i = 0; i < benchmark_iterations; ++i) {
+      func(src, dst_opt, width, height);
+    }
+    opt_time = (get_time() - opt_time) / benchmark_iterations;
+    SetThreadExecutor(NULL);
+    DestroyThreadPool(pool);
+    printf("%s %d threads %8d us C - %8d us OPT\n", name, kThreads[t],
+           static_cast<int>(c_time * 1e6), static_cast<int>(opt_time * 1e6));
+    if (memcmp(dst_c, dst_opt, kSize) != 0) {
+      ++diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return diff;
+}
+
+#define TESTTHREADS(NAME)                                                 \
+  TEST_F(LibYUVBaseTest, NAME##_Threads) {                                \
+    EXPECT_EQ(0, TestThreads(#NAME, Threads##NAME, Abs(benchmark_width_), \
+                             Abs(benchmark_height_),                     \
+                             benchmark_iterations_));                    \
+  }
+
+static void ThreadsI420ToARGB(const uint8_t* src,
+                              uint8_t* dst,
+                              int width,
+                              int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  const uint8_t* src_u = src + width * height;
+  const uint8_t* src_v = src_u + halfwidth * halfheight;
+  I420ToARGB(src, width, src_u, halfwidth, src_v, halfwidth, dst, width * 4,
+             width, height);
+}
+TESTTHREADS(I420ToARGB)
+
+static void ThreadsI444ToARGB(const uint8_t* src,
+                              uint8_t* dst,
+                              int width,
+                              int height) {
+  const uint8_t* src_u = src + width * height;
+  const uint8_t* src_v = src_u + width * height;
+  I444ToARGB(src, width, src_u, width, src_v, width, dst, width * 4, width,
+             height);
+}
+TESTTHREADS(I444ToARGB)
+
+static void ThreadsNV12ToARGB(const uint8_t* src,
+                              uint8_t* dst,
+                              int width,
+                              int height) {
+  const int halfwidth = (width + 1) / 2;
+  NV12ToARGB(src, width, src + width * height, halfwidth * 2, dst, width * 4,
+             width, height);
+}
+TESTTHREADS(NV12ToARGB)
+
+static void ThreadsNV12ToI420(const uint8_t* src,
+                              uint8_t* dst,
+                              int width,
+                              int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  uint8_t* dst_u = dst + width * height;
+  uint8_t* dst_v = dst_u + halfwidth * halfheight;
+  NV12ToI420(src, width, src + width * height, halfwidth * 2, dst, width,
+             dst_u, halfwidth, dst_v, halfwidth, width, height);
+}
+TESTTHREADS(NV12ToI420)
+
+static void ThreadsARGBToI420(const uint8_t* src,
+                              uint8_t* dst,
+                              int width,
+                              int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  uint8_t* dst_u = dst + width * height;
+  uint8_t* dst_v = dst_u + halfwidth * halfheight;
+  ARGBToI420(src, width * 4, dst, width, dst_u, halfwidth, dst_v, halfwidth,
+             width, height);
+}
+TESTTHREADS(ARGBToI420)
+
+static void ThreadsARGBToNV12(const uint8_t* src,
+                              uint8_t* dst,
+                              int width,
+                              int height) {
+  const int halfwidth = (width + 1) / 2;
+  ARGBToNV12(src, width * 4, dst, width, dst + width * height, halfwidth * 2,
+             width, height);
+}
+TESTTHREADS(ARGBToNV12)
+
+static void ThreadsCopyPlane(const uint8_t* src,
+                             uint8_t* dst,
+                             int width,
+                             int height) {
+  CopyPlane(src, width, dst, width, width, height);
+}
+TESTTHREADS(CopyPlane)
+
+static void ThreadsSplitUVPlane(const uint8_t* src,
+                                uint8_t* dst,
+                                int width,
+                                int height) {
+  SplitUVPlane(src, width * 2, dst, width, dst + width * height, width, width,
+               height);
+}
+TESTTHREADS(SplitUVPlane)
+
+static void ThreadsMergeUVPlane(const uint8_t* src,
+                                uint8_t* dst,
+                                int width,
+                                int height) {
+  MergeUVPlane(src, width, src + width * height, width, dst, width * 2, width,
+               height);
+}
+TESTTHREADS(MergeUVPlane)
+
+static void ThreadsTransposePlane(const uint8_t* src,
+                                  uint8_t* dst,
+                                  int width,
+                                  int height) {
+  TransposePlane(src, width, dst, height, width, height);
+}
+TESTTHREADS(TransposePlane)
+
+// 3/4 scale exercises the scalers that produce rows in groups of 3.
+static void ThreadsI420Scale(const uint8_t* src,
+                             uint8_t* dst,
+                             int width,
+                             int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  const int dst_width = width * 3 / 4;
+  const int dst_height = height * 3 / 4;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  const uint8_t* src_u = src + width * height;
+  const uint8_t* src_v = src_u + halfwidth * halfheight;
+  uint8_t* dst_u = dst + dst_width * dst_height;
+  uint8_t* dst_v = dst_u + dst_halfwidth * dst_halfheight;
+  I420Scale(src, width, src_u, halfwidth, src_v, halfwidth, width, height, dst,
+            dst_width, dst_u, dst_halfwidth, dst_v, dst_halfwidth, dst_width,
+            dst_height, kFilterBilinear);
+}
+TESTTHREADS(I420Scale)
+
+static void ThreadsScalePlaneUp(const uint8_t* src,
+                                uint8_t* dst,
+                                int width,
+                                int height) {
+  ScalePlane(src, width, width, height, dst, width * 2, width * 2, height * 2,
+             kFilterBilinear);
+}
+TESTTHREADS(ScalePlaneUp)
+
+static void ThreadsScalePlaneBox(const uint8_t* src,
+                                 uint8_t* dst,
+                                 int width,
+                                 int height) {
+  ScalePlane(src, width, width, height, dst, width / 3, width / 3, height / 3,
+             kFilterBox);
+}
+TESTTHREADS(ScalePlaneBox)
+
+}  // namespace libyuv
@@ -2776,6 +2776,89 @@ TEST_F(LibYUVPlanarTest, Convert16To8Plane) {
   free_aligned_buffer_page_end(dst_pixels_y_c);
 }
 
+TEST_F(LibYUVPlanarTest, SplitUVPlane_16) {
+  const int kPixels = benchmark_width_ * benchmark_height_;
+  align_buffer_page_end(src_pixels_uv, kPixels * 2 * 2);
+  align_buffer_page_end(dst_pixels_u_opt, kPixels * 2);
+  align_buffer_page_end(dst_pixels_v_opt, kPixels * 2);
+  align_buffer_page_end(dst_pixels_u_c, kPixels * 2);
+  align_buffer_page_end(dst_pixels_v_c, kPixels * 2);
+
+  MemRandomize(src_pixels_uv, kPixels * 2 * 2);
+  memset(dst_pixels_u_opt, 0, kPixels * 2);
+  memset(dst_pixels_v_opt, 0, kPixels * 2);
+  memset(dst_pixels_u_c, 1, kPixels * 2);
+  memset(dst_pixels_v_c, 1, kPixels * 2);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  SplitUVPlane_16(reinterpret_cast<const uint16_t*>(src_pixels_uv),
+                  benchmark_width_ * 2,
+                  reinterpret_cast<uint16_t*>(dst_pixels_u_c), benchmark_width_,
+                  reinterpret_cast<uint16_t*>(dst_pixels_v_c), benchmark_width_,
+                  benchmark_width_, benchmark_height_, 10);
+  MaskCpuFlags(benchmark_cpu_info_);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    SplitUVPlane_16(reinterpret_cast<const uint16_t*>(src_pixels_uv),
+                    benchmark_width_ * 2,
+                    reinterpret_cast<uint16_t*>(dst_pixels_u_opt),
+                    benchmark_width_,
+                    reinterpret_cast<uint16_t*>(dst_pixels_v_opt),
+                    benchmark_width_, benchmark_width_, benchmark_height_, 10);
+  }
+
+  for (int i = 0; i < kPixels * 2; ++i) {
+    EXPECT_EQ(dst_pixels_u_opt[i], dst_pixels_u_c[i]);
+    EXPECT_EQ(dst_pixels_v_opt[i], dst_pixels_v_c[i]);
+  }
+  // 10 bit values are the upper bits of the source.
+  for (int i = 0; i < kPixels; ++i) {
+    EXPECT_EQ(reinterpret_cast<const uint16_t*>(src_pixels_uv)[i * 2] >> 6,
+              reinterpret_cast<const uint16_t*>(dst_pixels_u_opt)[i]);
+  }
+
+  free_aligned_buffer_page_end(src_pixels_uv);
+  free_aligned_buffer_page_end(dst_pixels_u_opt);
+  free_aligned_buffer_page_end(dst_pixels_v_opt);
+  free_aligned_buffer_page_end(dst_pixels_u_c);
+  free_aligned_buffer_page_end(dst_pixels_v_c);
+}
+
+TEST_F(LibYUVPlanarTest, ConvertToLSBPlane_16) {
+  const int kPixels = benchmark_width_ * benchmark_height_;
+  align_buffer_page_end(src_pixels_y, kPixels * 2);
+  align_buffer_page_end(dst_pixels_y_opt, kPixels * 2);
+  align_buffer_page_end(dst_pixels_y_c, kPixels * 2);
+
+  MemRandomize(src_pixels_y, kPixels * 2);
+  memset(dst_pixels_y_opt, 0, kPixels * 2);
+  memset(dst_pixels_y_c, 1, kPixels * 2);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  ConvertToLSBPlane_16(reinterpret_cast<const uint16_t*>(src_pixels_y),
+                       benchmark_width_,
+                       reinterpret_cast<uint16_t*>(dst_pixels_y_c),
+                       benchmark_width_, benchmark_width_, benchmark_height_,
+                       10);
+  MaskCpuFlags(benchmark_cpu_info_);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ConvertToLSBPlane_16(reinterpret_cast<const uint16_t*>(src_pixels_y),
+                         benchmark_width_,
+                         reinterpret_cast<uint16_t*>(dst_pixels_y_opt),
+                         benchmark_width_, benchmark_width_, benchmark_height_,
+                         10);
+  }
+
+  for (int i = 0; i < kPixels * 2; ++i) {
+    EXPECT_EQ(dst_pixels_y_opt[i], dst_pixels_y_c[i]);
+  }
+
+  free_aligned_buffer_page_end(src_pixels_y);
+  free_aligned_buffer_page_end(dst_pixels_y_opt);
+  free_aligned_buffer_page_end(dst_pixels_y_c);
+}
+
 // TODO(fbarchard): Improve test for more platforms.
 #ifdef HAS_CONVERT16TO8ROW_AVX2
 TEST_F(LibYUVPlanarTest, Convert16To8Row_Opt) {
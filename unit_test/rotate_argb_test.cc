@@ -119,6 +119,41 @@ TEST_F(LibYUVRotateTest, ARGBRotate270_Opt) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+TEST_F(LibYUVRotateTest, ARGBRotate90_Odd) {
+  ARGBTestRotate(benchmark_width_ - 3, benchmark_height_ - 1,
+                 benchmark_height_ - 1, benchmark_width_ - 3, kRotate90,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate270_Odd) {
+  ARGBTestRotate(benchmark_width_ - 3, benchmark_height_ - 1,
+                 benchmark_height_ - 1, benchmark_width_ - 3, kRotate270,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
+// Large frames where cache blocking of the transpose matters.
+TEST_F(LibYUVRotateTest, ARGBRotate90_1080p) {
+  ARGBTestRotate(1920, 1080, 1080, 1920, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate270_1080p) {
+  ARGBTestRotate(1920, 1080, 1080, 1920, kRotate270, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_4K) {
+  ARGBTestRotate(3840, 2160, 2160, 3840, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate270_4K) {
+  ARGBTestRotate(3840, 2160, 2160, 3840, kRotate270, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
 static void TestRotatePlane(int src_width,
                             int src_height,
                             int dst_width,
@@ -13,6 +13,8 @@
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/rotate.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_uv.h"
 
 namespace libyuv {
 
@@ -274,4 +276,230 @@ TEST_F(LibYUVRotateTest, NV12Rotate270_Invert) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+// Compare fused scale and rotate with scaling and then rotating.
+// dst_width and dst_height are the rotated size.
+static void TestScaleRotate(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            libyuv::RotationMode mode,
+                            libyuv::FilterMode filtering,
+                            bool nv12,
+                            int benchmark_iterations) {
+  const bool swap = mode == kRotate90 || mode == kRotate270;
+  const int scaled_width = swap ? dst_height : dst_width;
+  const int scaled_height = swap ? dst_width : dst_height;
+  const int src_halfwidth = (src_width + 1) / 2;
+  const int src_halfheight = (src_height + 1) / 2;
+  const int scaled_halfwidth = (scaled_width + 1) / 2;
+  const int scaled_halfheight = (scaled_height + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int src_y_size = src_width * src_height;
+  const int src_uv_size = src_halfwidth * src_halfheight;
+  const int dst_y_size = dst_width * dst_height;
+  const int dst_uv_size = dst_halfwidth * ((dst_height + 1) / 2);
+  const int dst_size = dst_y_size + dst_uv_size * 2;
+  align_buffer_page_end(src, src_y_size + src_uv_size * 2);
+  align_buffer_page_end(scaled, dst_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  MemRandomize(src, src_y_size + src_uv_size * 2);
+  memset(dst_c, 2, dst_size);
+  memset(dst_opt, 3, dst_size);
+  uint8_t* src_u = src + src_y_size;
+  uint8_t* src_v = src_u + src_uv_size;
+  // The scaled frame has the rotated size, so its planes are the same size
+  // as the destination planes.
+  uint8_t* scaled_u = scaled + scaled_width * scaled_height;
+  uint8_t* scaled_v = scaled_u + scaled_halfwidth * scaled_halfheight;
+
+  if (nv12) {
+    NV12Scale(src, src_width, src_u, src_halfwidth * 2, src_width, src_height,
+              scaled, scaled_width, scaled_u, scaled_halfwidth * 2,
+              scaled_width, scaled_height, filtering);
+    NV12ToI420Rotate(scaled, scaled_width, scaled_u, scaled_halfwidth * 2,
+                     dst_c, dst_width, dst_c + dst_y_size, dst_halfwidth,
+                     dst_c + dst_y_size + dst_uv_size, dst_halfwidth,
+                     scaled_width, scaled_height, mode);
+  } else {
+    I420Scale(src, src_width, src_u, src_halfwidth, src_v, src_halfwidth,
+              src_width, src_height, scaled, scaled_width, scaled_u,
+              scaled_halfwidth, scaled_v, scaled_halfwidth, scaled_width,
+              scaled_height, filtering);
+    I420Rotate(scaled, scaled_width, scaled_u, scaled_halfwidth, scaled_v,
+               scaled_halfwidth, dst_c, dst_width, dst_c + dst_y_size,
+               dst_halfwidth, dst_c + dst_y_size + dst_uv_size, dst_halfwidth,
+               scaled_width, scaled_height, mode);
+  }
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    if (nv12) {
+      EXPECT_EQ(0, NV12ToI420ScaleRotate(
+                       src, src_width, src_u, src_halfwidth * 2, src_width,
+                       src_height, dst_opt, dst_width, dst_opt + dst_y_size,
+                       dst_halfwidth, dst_opt + dst_y_size + dst_uv_size,
+                       dst_halfwidth, dst_width, dst_height, mode, filtering));
+    } else {
+      EXPECT_EQ(0, I420ScaleRotate(
+                       src, src_width, src_u, src_halfwidth, src_v,
+                       src_halfwidth, src_width, src_height, dst_opt,
+                       dst_width, dst_opt + dst_y_size, dst_halfwidth,
+                       dst_opt + dst_y_size + dst_uv_size, dst_halfwidth,
+                       dst_width, dst_height, mode, filtering));
+    }
+  }
+
+  for (int i = 0; i < dst_size; ++i) {
+    EXPECT_EQ(dst_c[i], dst_opt[i]);
+  }
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(scaled);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
+#define TEST_SCALEROTATE1(name, nv12, mode, filter)                         \
+  TEST_F(LibYUVRotateTest, name##ScaleRotate##mode##_##filter) {            \
+    const bool swap = mode == 90 || mode == 270;                            \
+    const int dst_width = (benchmark_width_ * 2 + 2) / 3;                   \
+    const int dst_height = (benchmark_height_ * 2 + 2) / 3;                 \
+    TestScaleRotate(benchmark_width_, benchmark_height_,                    \
+                    swap ? dst_height : dst_width,                          \
+                    swap ? dst_width : dst_height, kRotate##mode,           \
+                    kFilter##filter, nv12, benchmark_iterations_);          \
+  }
+
+#define TEST_SCALEROTATE(name, nv12)           \
+  TEST_SCALEROTATE1(name, nv12, 0, Bilinear)   \
+  TEST_SCALEROTATE1(name, nv12, 90, None)      \
+  TEST_SCALEROTATE1(name, nv12, 90, Bilinear)  \
+  TEST_SCALEROTATE1(name, nv12, 90, Box)       \
+  TEST_SCALEROTATE1(name, nv12, 180, Bilinear) \
+  TEST_SCALEROTATE1(name, nv12, 270, Bilinear)
+
+TEST_SCALEROTATE(I420, false)
+TEST_SCALEROTATE(NV12, true)
+#undef TEST_SCALEROTATE1
+#undef TEST_SCALEROTATE
+
+// 1080p landscape camera frame to 720p portrait.
+TEST_F(LibYUVRotateTest, NV12ScaleRotate90_1080pTo720p) {
+  TestScaleRotate(1920, 1080, 720, 1280, kRotate90, kFilterBilinear, true,
+                  benchmark_iterations_);
+}
+
+// 4K camera frames rotated to portrait.
+TEST_F(LibYUVRotateTest, I420Rotate90_4K) {
+  I420TestRotate(3840, 2160, 2160, 3840, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12Rotate90_4K) {
+  NV12TestRotate(3840, 2160, 2160, 3840, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+}
+
+static void TestRotatePlane_16(int src_width,
+                               int src_height,
+                               libyuv::RotationMode mode,
+                               int benchmark_iterations,
+                               int disable_cpu_flags,
+                               int benchmark_cpu_info) {
+  if (src_width < 1) {
+    src_width = 1;
+  }
+  if (src_height < 1) {
+    src_height = 1;
+  }
+  const bool transpose = mode == kRotate90 || mode == kRotate270;
+  const int dst_width = transpose ? src_height : src_width;
+  const int dst_height = transpose ? src_width : src_height;
+  const int kSize = src_width * src_height;
+  align_buffer_page_end(src, kSize * 2);
+  align_buffer_page_end(dst_c, kSize * 2);
+  align_buffer_page_end(dst_opt, kSize * 2);
+  align_buffer_page_end(dst_back, kSize * 2);
+  uint16_t* src16 = reinterpret_cast<uint16_t*>(src);
+  uint16_t* dst16_c = reinterpret_cast<uint16_t*>(dst_c);
+  uint16_t* dst16_opt = reinterpret_cast<uint16_t*>(dst_opt);
+  uint16_t* dst16_back = reinterpret_cast<uint16_t*>(dst_back);
+  for (int i = 0; i < kSize; ++i) {
+    src16[i] = fastrand() & 0x3ff;
+  }
+  memset(dst_c, 2, kSize * 2);
+  memset(dst_opt, 3, kSize * 2);
+
+  MaskCpuFlags(disable_cpu_flags);
+  EXPECT_EQ(0, RotatePlane_16(src16, src_width, dst16_c, dst_width, src_width,
+                              src_height, mode));
+  MaskCpuFlags(benchmark_cpu_info);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    RotatePlane_16(src16, src_width, dst16_opt, dst_width, src_width,
+                   src_height, mode);
+  }
+  for (int i = 0; i < kSize; ++i) {
+    EXPECT_EQ(dst16_c[i], dst16_opt[i]);
+  }
+
+  // Rotating back gives the source.
+  RotationMode inverse = mode;
+  if (mode == kRotate90) {
+    inverse = kRotate270;
+  } else if (mode == kRotate270) {
+    inverse = kRotate90;
+  }
+  RotatePlane_16(dst16_opt, dst_width, dst16_back, src_width, dst_width,
+                 dst_height, inverse);
+  for (int i = 0; i < kSize; ++i) {
+    EXPECT_EQ(src16[i], dst16_back[i]);
+  }
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(dst_back);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane0_16_Opt) {
+  TestRotatePlane_16(benchmark_width_, benchmark_height_, kRotate0,
+                     benchmark_iterations_, disable_cpu_flags_,
+                     benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_16_Opt) {
+  TestRotatePlane_16(benchmark_width_, benchmark_height_, kRotate90,
+                     benchmark_iterations_, disable_cpu_flags_,
+                     benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane180_16_Opt) {
+  TestRotatePlane_16(benchmark_width_, benchmark_height_, kRotate180,
+                     benchmark_iterations_, disable_cpu_flags_,
+                     benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane270_16_Opt) {
+  TestRotatePlane_16(benchmark_width_, benchmark_height_, kRotate270,
+                     benchmark_iterations_, disable_cpu_flags_,
+                     benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_16_Odd) {
+  TestRotatePlane_16(benchmark_width_ - 3, benchmark_height_ - 1, kRotate90,
+                     benchmark_iterations_, disable_cpu_flags_,
+                     benchmark_cpu_info_);
+}
+
+// A known 3x2 plane rotated by 90 degrees.
+TEST_F(LibYUVRotateTest, RotatePlane90_16_Values) {
+  const uint16_t kSrc[6] = {1, 2, 3, 4, 5, 6};
+  const uint16_t kExpected[6] = {4, 1, 5, 2, 6, 3};
+  uint16_t dst[6] = {0};
+  EXPECT_EQ(0, RotatePlane_16(kSrc, 3, dst, 2, 3, 2, kRotate90));
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(kExpected[i], dst[i]);
+  }
+}
+
 }  // namespace libyuv
@@ -14,7 +14,10 @@
 #include "../unit_test/unit_test.h"
 #include "libyuv/convert_argb.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/executor.h"
+#include "libyuv/scale.h"
 #include "libyuv/scale_argb.h"
+#include "libyuv/scale_uv.h"
 #include "libyuv/video_common.h"
 
 namespace libyuv {
@@ -255,7 +258,9 @@ static int ARGBClipTestFilter(int src_width,
   TEST_FACTOR1(name, None, nom, denom, 0)     \
   TEST_FACTOR1(name, Linear, nom, denom, 3)   \
   TEST_FACTOR1(name, Bilinear, nom, denom, 3) \
-  TEST_FACTOR1(name, Box, nom, denom, 3)
+  TEST_FACTOR1(name, Box, nom, denom, 3)      \
+  TEST_FACTOR1(name, Bicubic, nom, denom, 0)  \
+  TEST_FACTOR1(name, Lanczos, nom, denom, 0)
 
 TEST_FACTOR(2, 1, 2)
 TEST_FACTOR(4, 1, 4)
@@ -296,10 +301,12 @@ TEST_FACTOR(3, 1, 3)
   }
 
 /// Test scale to a specified size with all 4 filters.
-#define TEST_SCALETO(name, width, height)       \
-  TEST_SCALETO1(name, width, height, None, 0)   \
-  TEST_SCALETO1(name, width, height, Linear, 3) \
-  TEST_SCALETO1(name, width, height, Bilinear, 3)
+#define TEST_SCALETO(name, width, height)         \
+  TEST_SCALETO1(name, width, height, None, 0)     \
+  TEST_SCALETO1(name, width, height, Linear, 3)   \
+  TEST_SCALETO1(name, width, height, Bilinear, 3) \
+  TEST_SCALETO1(name, width, height, Bicubic, 0)  \
+  TEST_SCALETO1(name, width, height, Lanczos, 0)
 
 TEST_SCALETO(ARGBScale, 1, 1)
 TEST_SCALETO(ARGBScale, 320, 240)
@@ -311,7 +318,8 @@ TEST_SCALETO(ARGBScale, 1920, 1080)
 #undef TEST_SCALETO
 
 // Scale with YUV conversion to ARGB and clipping.
-// TODO(fbarchard): Add fourcc support.  All 4 ARGB formats is easy to support.
+// Scales the YUV planes and then converts, like YUVToARGBScaleClip does when
+// the clip rectangle is the full destination.
 LIBYUV_API
 int YUVToARGBScaleReference2(const uint8_t* src_y,
                              int src_stride_y,
@@ -332,16 +340,28 @@ int YUVToARGBScaleReference2(const uint8_t* src_y,
                              int clip_width,
                              int clip_height,
                              enum FilterMode filtering) {
-  uint8_t* argb_buffer =
-      static_cast<uint8_t*>(malloc(src_width * src_height * 4));
+  int dst_halfwidth = (dst_width + 1) / 2;
+  int dst_halfheight = (dst_height + 1) / 2;
+  uint8_t* yuv_buffer = static_cast<uint8_t*>(
+      malloc(dst_width * dst_height + dst_halfwidth * dst_halfheight * 2));
+  uint8_t* dst_y = yuv_buffer;
+  uint8_t* dst_u = dst_y + dst_width * dst_height;
+  uint8_t* dst_v = dst_u + dst_halfwidth * dst_halfheight;
   int r;
-  I420ToARGB(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
-             argb_buffer, src_width * 4, src_width, src_height);
-
-  r = ARGBScaleClip(argb_buffer, src_width * 4, src_width, src_height, dst_argb,
-                    dst_stride_argb, dst_width, dst_height, clip_x, clip_y,
-                    clip_width, clip_height, filtering);
-  free(argb_buffer);
+  if (clip_x != 0 || clip_y != 0 || clip_width != dst_width ||
+      clip_height != dst_height) {
+    free(yuv_buffer);
+    return -1;
+  }
+  r = I420Scale(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
+                src_width, src_height, dst_y, dst_width, dst_u, dst_halfwidth,
+                dst_v, dst_halfwidth, dst_width, dst_height, filtering);
+  if (r == 0) {
+    r = I420ToARGB(dst_y, dst_width, dst_u, dst_halfwidth, dst_v,
+                   dst_halfwidth, dst_argb, dst_stride_argb, dst_width,
+                   dst_height);
+  }
+  free(yuv_buffer);
   return r;
 }
 
@@ -454,4 +474,181 @@ TEST_F(LibYUVScaleTest, YUVToRGBScaleDown) {
   EXPECT_LE(diff, 10);
 }
 
+// Reference for the fused YUV scaler: scale the YUV planes, then convert.
+static void YUVScaleThenConvert(uint32_t src_fourcc,
+                                const uint8_t* src_y,
+                                const uint8_t* src_u,
+                                const uint8_t* src_v,
+                                int src_width,
+                                int src_height,
+                                int src_uv_width,
+                                int src_uv_height,
+                                uint8_t* dst_argb,
+                                uint32_t dst_fourcc,
+                                int dst_width,
+                                int dst_height,
+                                int dst_uv_width,
+                                int dst_uv_height,
+                                FilterMode f) {
+  const bool abgr = dst_fourcc == libyuv::FOURCC_ABGR;
+  align_buffer_page_end(y, dst_width * dst_height);
+  align_buffer_page_end(u, dst_uv_width * 2 * dst_uv_height);
+  align_buffer_page_end(v, dst_uv_width * dst_uv_height);
+  ScalePlane(src_y, src_width, src_width, src_height, y, dst_width, dst_width,
+             dst_height, f);
+  if (src_fourcc == libyuv::FOURCC_NV12 || src_fourcc == libyuv::FOURCC_NV21) {
+    UVScale(src_u, src_uv_width * 2, src_uv_width, src_uv_height, u,
+            dst_uv_width * 2, dst_uv_width, dst_uv_height, f);
+    if (src_fourcc == libyuv::FOURCC_NV12) {
+      (abgr ? NV12ToABGR : NV12ToARGB)(y, dst_width, u, dst_uv_width * 2,
+                                       dst_argb, dst_width * 4, dst_width,
+                                       dst_height);
+    } else {
+      (abgr ? NV21ToABGR : NV21ToARGB)(y, dst_width, u, dst_uv_width * 2,
+                                       dst_argb, dst_width * 4, dst_width,
+                                       dst_height);
+    }
+  } else {
+    ScalePlane(src_u, src_uv_width, src_uv_width, src_uv_height, u,
+               dst_uv_width, dst_uv_width, dst_uv_height, f);
+    ScalePlane(src_v, src_uv_width, src_uv_width, src_uv_height, v,
+               dst_uv_width, dst_uv_width, dst_uv_height, f);
+    if (src_fourcc == libyuv::FOURCC_I444) {
+      (abgr ? I444ToABGR : I444ToARGB)(y, dst_width, u, dst_uv_width, v,
+                                       dst_uv_width, dst_argb, dst_width * 4,
+                                       dst_width, dst_height);
+    } else {
+      (abgr ? I420ToABGR : I420ToARGB)(y, dst_width, u, dst_uv_width, v,
+                                       dst_uv_width, dst_argb, dst_width * 4,
+                                       dst_width, dst_height);
+    }
+  }
+  free_aligned_buffer_page_end(y);
+  free_aligned_buffer_page_end(u);
+  free_aligned_buffer_page_end(v);
+}
+
+// Test the fused YUV scaler against scaling the planes and then converting,
+// and return the maximum pixel difference. 0 = exact.
+static int YUVToARGBTestFused(uint32_t src_fourcc,
+                              uint32_t dst_fourcc,
+                              int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              int clip_y,
+                              FilterMode f,
+                              int num_threads,
+                              int benchmark_iterations) {
+  const bool biplanar =
+      src_fourcc == libyuv::FOURCC_NV12 || src_fourcc == libyuv::FOURCC_NV21;
+  const int sub = src_fourcc == libyuv::FOURCC_I444 ? 0 : 1;
+  const int src_uv_width = (src_width + sub) >> sub;
+  const int src_uv_height = (src_height + sub) >> sub;
+  const int dst_uv_width = (dst_width + sub) >> sub;
+  const int dst_uv_height = (dst_height + sub) >> sub;
+  const int64_t src_uv_plane_size = src_uv_width * src_uv_height;
+  const int64_t dst_argb_plane_size = dst_width * dst_height * 4LL;
+  const int clip_height = dst_height - clip_y;
+  align_buffer_page_end(src_y, src_width * src_height);
+  align_buffer_page_end(src_u, src_uv_plane_size * 2);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  align_buffer_page_end(dst_argb_c, dst_argb_plane_size);
+  align_buffer_page_end(dst_argb_opt, dst_argb_plane_size);
+  MemRandomize(src_y, src_width * src_height);
+  MemRandomize(src_u, src_uv_plane_size * 2);
+  MemRandomize(src_v, src_uv_plane_size);
+  memset(dst_argb_c, 2, dst_argb_plane_size);
+  memset(dst_argb_opt, 2, dst_argb_plane_size);
+
+  YUVScaleThenConvert(src_fourcc, src_y, src_u, src_v, src_width, src_height,
+                      src_uv_width, src_uv_height, dst_argb_c, dst_fourcc,
+                      dst_width, dst_height, dst_uv_width, dst_uv_height, f);
+  // Rows above the clip rectangle are not written.
+  memset(dst_argb_c, 2, clip_y * dst_width * 4);
+
+  ParallelExecutor* pool = num_threads > 1 ? CreateThreadPool(num_threads)
+                                           : NULL;
+  SetThreadExecutor(pool);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, YUVToARGBScaleClip(
+                     src_y, src_width, src_u,
+                     biplanar ? src_uv_width * 2 : src_uv_width, src_v,
+                     src_uv_width, src_fourcc, src_width, src_height,
+                     dst_argb_opt, dst_width * 4, dst_fourcc, dst_width,
+                     dst_height, 0, clip_y, dst_width, clip_height, f));
+  }
+  SetThreadExecutor(NULL);
+  DestroyThreadPool(pool);
+
+  int max_diff = 0;
+  for (int i = 0; i < dst_argb_plane_size; ++i) {
+    int abs_diff = Abs(dst_argb_c[i] - dst_argb_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  return max_diff;
+}
+
+#define TEST_YUVTOARGBSCALE1(FMT, DST, name, sw, sh, dw, dh, filter)        \
+  TEST_F(LibYUVScaleTest, FMT##To##DST##Scale##name##_##filter) {           \
+    int diff = YUVToARGBTestFused(                                          \
+        libyuv::FOURCC_##FMT, libyuv::FOURCC_##DST, sw, sh, dw, dh, 0,      \
+        kFilter##filter, 1, benchmark_iterations_);                         \
+    EXPECT_EQ(0, diff);                                                     \
+  }
+
+#define TEST_YUVTOARGBSCALE(FMT, DST)                                      \
+  TEST_YUVTOARGBSCALE1(FMT, DST, Down, benchmark_width_,                   \
+                       benchmark_height_, (benchmark_width_ + 2) / 3,      \
+                       (benchmark_height_ + 2) / 3, None)                  \
+  TEST_YUVTOARGBSCALE1(FMT, DST, Down, benchmark_width_,                   \
+                       benchmark_height_, (benchmark_width_ + 2) / 3,      \
+                       (benchmark_height_ + 2) / 3, Bilinear)              \
+  TEST_YUVTOARGBSCALE1(FMT, DST, Down, benchmark_width_,                   \
+                       benchmark_height_, (benchmark_width_ + 2) / 3,      \
+                       (benchmark_height_ + 2) / 3, Box)                   \
+  TEST_YUVTOARGBSCALE1(FMT, DST, Up, benchmark_width_, benchmark_height_,  \
+                       benchmark_width_ * 3 / 2, benchmark_height_ * 3 / 2, \
+                       Bilinear)
+
+TEST_YUVTOARGBSCALE(I420, ARGB)
+TEST_YUVTOARGBSCALE(I420, ABGR)
+TEST_YUVTOARGBSCALE(I444, ARGB)
+TEST_YUVTOARGBSCALE(NV12, ARGB)
+TEST_YUVTOARGBSCALE(NV12, ABGR)
+TEST_YUVTOARGBSCALE(NV21, ARGB)
+#undef TEST_YUVTOARGBSCALE1
+#undef TEST_YUVTOARGBSCALE
+
+// 1080p NV12 to a 320x180 thumbnail, as rows of the clip rectangle and on
+// several threads.
+TEST_F(LibYUVScaleTest, NV12ToARGBScale1080pTo180p_Box) {
+  int diff = YUVToARGBTestFused(libyuv::FOURCC_NV12, libyuv::FOURCC_ARGB, 1920,
+                                1080, 320, 180, 0, kFilterBox, 1,
+                                benchmark_iterations_);
+  EXPECT_EQ(0, diff);
+}
+
+TEST_F(LibYUVScaleTest, NV12ToARGBScaleClipY_Bilinear) {
+  int diff = YUVToARGBTestFused(libyuv::FOURCC_NV12, libyuv::FOURCC_ARGB, 1280,
+                                720, 480, 270, 102, kFilterBilinear, 1,
+                                benchmark_iterations_);
+  EXPECT_EQ(0, diff);
+}
+
+TEST_F(LibYUVScaleTest, I420ToARGBScale1080pTo180p_Box_MT4) {
+  int diff = YUVToARGBTestFused(libyuv::FOURCC_I420, libyuv::FOURCC_ARGB, 1920,
+                                1080, 320, 180, 0, kFilterBox, 4,
+                                benchmark_iterations_);
+  EXPECT_EQ(0, diff);
+}
+
 }  // namespace libyuv
@@ -0,0 +1,299 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <thread>
+
+#include "../unit_test/unit_test.h"
+#include "libyuv/executor.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scale_plan.h"
+#include "libyuv/video_common.h"
+
+namespace libyuv {
+
+static const FilterMode kPlanFilters[] = {kFilterNone,    kFilterLinear,
+                                          kFilterBilinear, kFilterBox,
+                                          kFilterBicubic, kFilterLanczos};
+
+// Sizes: source width and height, then destination width and height.
+// These cover the copy, vertical, 3/4, 1/2, 3/8, 1/4 and general scalers,
+// mirroring and inverting.
+static const int kPlanSizes[][4] = {
+    {64, 48, 64, 48},   {64, 48, 64, 30},    {64, 48, 48, 36},
+    {64, 48, 32, 24},   {64, 48, 24, 18},    {64, 48, 16, 12},
+    {33, 17, 80, 41},   {127, 63, 40, 20},   {-64, 48, 50, 20},
+    {64, -48, 50, 20},  {1, 1, 3, 3},        {320, 180, 83, 45}};
+
+// Scale I420 frames with a plan and with I420Scale and compare them.
+static void TestScalePlanI420(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode filtering,
+                              int num_threads) {
+  const int src_abs_width = abs(src_width);
+  const int src_abs_height = abs(src_height);
+  const int src_halfwidth = (src_abs_width + 1) / 2;
+  const int src_halfheight = (src_abs_height + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  const int src_y_size = src_abs_width * src_abs_height;
+  const int src_uv_size = src_halfwidth * src_halfheight;
+  const int dst_y_size = dst_width * dst_height;
+  const int dst_uv_size = dst_halfwidth * dst_halfheight;
+  align_buffer_page_end(src, src_y_size + src_uv_size * 2);
+  align_buffer_page_end(dst_plan, dst_y_size + dst_uv_size * 2);
+  align_buffer_page_end(dst_ref, dst_y_size + dst_uv_size * 2);
+  MemRandomize(src, src_y_size + src_uv_size * 2);
+  memset(dst_plan, 1, dst_y_size + dst_uv_size * 2);
+  memset(dst_ref, 2, dst_y_size + dst_uv_size * 2);
+
+  ParallelExecutor* pool = NULL;
+  if (num_threads > 1) {
+    pool = CreateThreadPool(num_threads);
+    SetThreadExecutor(pool);
+  }
+  ScalePlan* plan = CreateScalePlan(FOURCC_I420, src_width, src_height,
+                                    dst_width, dst_height, filtering);
+  ASSERT_TRUE(plan != NULL);
+  // A plan scales any number of frames.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(0, ScalePlanI420(plan, src, src_abs_width, src + src_y_size,
+                               src_halfwidth, src + src_y_size + src_uv_size,
+                               src_halfwidth, dst_plan, dst_width,
+                               dst_plan + dst_y_size, dst_halfwidth,
+                               dst_plan + dst_y_size + dst_uv_size,
+                               dst_halfwidth));
+  }
+  DestroyScalePlan(plan);
+  SetThreadExecutor(NULL);
+  DestroyThreadPool(pool);
+
+  I420Scale(src, src_abs_width, src + src_y_size, src_halfwidth,
+            src + src_y_size + src_uv_size, src_halfwidth, src_width,
+            src_height, dst_ref, dst_width, dst_ref + dst_y_size,
+            dst_halfwidth, dst_ref + dst_y_size + dst_uv_size, dst_halfwidth,
+            dst_width, dst_height, filtering);
+  EXPECT_EQ(0, memcmp(dst_ref, dst_plan, dst_y_size + dst_uv_size * 2))
+      << src_width << "x" << src_height << " to " << dst_width << "x"
+      << dst_height << " filter " << filtering;
+
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(dst_plan);
+  free_aligned_buffer_page_end(src);
+}
+
+static void TestScalePlanARGB(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode filtering) {
+  const int src_size = abs(src_width) * abs(src_height) * 4;
+  const int dst_size = dst_width * dst_height * 4;
+  align_buffer_page_end(src, src_size);
+  align_buffer_page_end(dst_plan, dst_size);
+  align_buffer_page_end(dst_ref, dst_size);
+  MemRandomize(src, src_size);
+  memset(dst_plan, 1, dst_size);
+  memset(dst_ref, 2, dst_size);
+
+  ScalePlan* plan = CreateScalePlan(FOURCC_ARGB, src_width, src_height,
+                                    dst_width, dst_height, filtering);
+  ASSERT_TRUE(plan != NULL);
+  EXPECT_EQ(0, ScalePlanARGB(plan, src, abs(src_width) * 4, dst_plan,
+                             dst_width * 4));
+  DestroyScalePlan(plan);
+
+  ARGBScale(src, abs(src_width) * 4, src_width, src_height, dst_ref,
+            dst_width * 4, dst_width, dst_height, filtering);
+  EXPECT_EQ(0, memcmp(dst_ref, dst_plan, dst_size))
+      << src_width << "x" << src_height << " to " << dst_width << "x"
+      << dst_height << " filter " << filtering;
+
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(dst_plan);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVScaleTest, ScalePlan_I420) {
+  for (size_t i = 0; i < sizeof(kPlanSizes) / sizeof(kPlanSizes[0]); ++i) {
+    for (size_t f = 0; f < sizeof(kPlanFilters) / sizeof(kPlanFilters[0]);
+         ++f) {
+      TestScalePlanI420(kPlanSizes[i][0], kPlanSizes[i][1], kPlanSizes[i][2],
+                        kPlanSizes[i][3], kPlanFilters[f], 1);
+    }
+  }
+}
+
+TEST_F(LibYUVScaleTest, ScalePlan_I420_Threads) {
+  TestScalePlanI420(320, 180, 83, 45, kFilterLanczos, 4);
+  TestScalePlanI420(640, 480, 480, 360, kFilterBox, 3);
+  TestScalePlanI420(200, 100, 500, 300, kFilterBilinear, 2);
+}
+
+TEST_F(LibYUVScaleTest, ScalePlan_ARGB) {
+  for (size_t i = 0; i < sizeof(kPlanSizes) / sizeof(kPlanSizes[0]); ++i) {
+    for (size_t f = 0; f < sizeof(kPlanFilters) / sizeof(kPlanFilters[0]);
+         ++f) {
+      TestScalePlanARGB(kPlanSizes[i][0], kPlanSizes[i][1], kPlanSizes[i][2],
+                        kPlanSizes[i][3], kPlanFilters[f]);
+    }
+  }
+}
+
+// One plan shared by threads that each scale their own frames.
+TEST_F(LibYUVScaleTest, ScalePlan_Shared) {
+  const int kSrcWidth = 160;
+  const int kSrcHeight = 90;
+  const int kDstWidth = 100;
+  const int kDstHeight = 56;
+  const int kThreads = 4;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight * kThreads);
+  align_buffer_page_end(dst_ref, kDstWidth * kDstHeight);
+  MemRandomize(src, kSrcWidth * kSrcHeight);
+  ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight, dst_ref, kDstWidth,
+             kDstWidth, kDstHeight, kFilterLanczos);
+
+  ScalePlan* plan = CreateScalePlan(FOURCC_I400, kSrcWidth, kSrcHeight,
+                                    kDstWidth, kDstHeight, kFilterLanczos);
+  ASSERT_TRUE(plan != NULL);
+  std::thread threads[kThreads];
+  for (int i = 0; i < kThreads; ++i) {
+    uint8_t* thread_dst = dst + i * kDstWidth * kDstHeight;
+    threads[i] = std::thread([plan, src, thread_dst] {
+      for (int j = 0; j < 10; ++j) {
+        ScalePlanI400(plan, src, kSrcWidth, thread_dst, kDstWidth);
+      }
+    });
+  }
+  for (int i = 0; i < kThreads; ++i) {
+    threads[i].join();
+    EXPECT_EQ(0, memcmp(dst_ref, dst + i * kDstWidth * kDstHeight,
+                        kDstWidth * kDstHeight));
+  }
+  DestroyScalePlan(plan);
+
+  free_aligned_buffer_page_end(dst_ref);
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+// A plan with a negative source width mirrors with every filter, including
+// box filtering.
+TEST_F(LibYUVScaleTest, ScalePlan_MirrorBox) {
+  const int kSrcWidth = 80;
+  const int kSrcHeight = 40;
+  const int kDstWidth = 32;
+  const int kDstHeight = 16;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight);
+  align_buffer_page_end(dst_mirror, kDstWidth * kDstHeight);
+  MemRandomize(src, kSrcWidth * kSrcHeight);
+  ScalePlan* plan = CreateScalePlan(FOURCC_I400, kSrcWidth, kSrcHeight,
+                                    kDstWidth, kDstHeight, kFilterBox);
+  ScalePlan* plan_mirror = CreateScalePlan(
+      FOURCC_I400, -kSrcWidth, kSrcHeight, kDstWidth, kDstHeight, kFilterBox);
+  ASSERT_TRUE(plan != NULL);
+  ASSERT_TRUE(plan_mirror != NULL);
+  EXPECT_EQ(0, ScalePlanI400(plan, src, kSrcWidth, dst, kDstWidth));
+  EXPECT_EQ(0, ScalePlanI400(plan_mirror, src, kSrcWidth, dst_mirror,
+                             kDstWidth));
+  for (int y = 0; y < kDstHeight; ++y) {
+    for (int x = 0; x < kDstWidth; ++x) {
+      EXPECT_EQ(dst[y * kDstWidth + x],
+                dst_mirror[y * kDstWidth + kDstWidth - 1 - x]);
+    }
+  }
+  DestroyScalePlan(plan_mirror);
+  DestroyScalePlan(plan);
+
+  free_aligned_buffer_page_end(dst_mirror);
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVScaleTest, ScalePlan_Invalid) {
+  uint8_t src[16 * 16 * 4] = {0};
+  uint8_t dst[8 * 8 * 4];
+  EXPECT_TRUE(NULL ==
+              CreateScalePlan(FOURCC_NV12, 16, 16, 8, 8, kFilterBox));
+  EXPECT_TRUE(NULL == CreateScalePlan(FOURCC_I420, 0, 16, 8, 8, kFilterBox));
+  EXPECT_TRUE(NULL == CreateScalePlan(FOURCC_I420, 16, 16, 8, 0, kFilterBox));
+  ScalePlan* plan = CreateScalePlan(FOURCC_ARGB, 16, 16, 8, 8, kFilterBox);
+  ASSERT_TRUE(plan != NULL);
+  // A plan only scales frames of its format.
+  EXPECT_EQ(-1, ScalePlanI400(plan, src, 16, dst, 8));
+  EXPECT_EQ(-1, ScalePlanARGB(plan, NULL, 64, dst, 32));
+  EXPECT_EQ(0, ScalePlanARGB(plan, src, 64, dst, 32));
+  DestroyScalePlan(plan);
+  EXPECT_EQ(-1, ScalePlanARGB(NULL, src, 64, dst, 32));
+  DestroyScalePlan(NULL);
+}
+
+// Time scaling frames with I420Scale and with a plan.
+TEST_F(LibYUVScaleTest, ScalePlan_Lanczos_Benchmark) {
+  const int kSrcWidth = benchmark_width_;
+  const int kSrcHeight = benchmark_height_;
+  const int kDstWidth = benchmark_width_ / 3;
+  const int kDstHeight = benchmark_height_ / 3;
+  const int kSrcHalfWidth = (kSrcWidth + 1) / 2;
+  const int kSrcHalfHeight = (kSrcHeight + 1) / 2;
+  const int kDstHalfWidth = (kDstWidth + 1) / 2;
+  const int kDstHalfHeight = (kDstHeight + 1) / 2;
+  const int kSrcSize = kSrcWidth * kSrcHeight;
+  const int kSrcUVSize = kSrcHalfWidth * kSrcHalfHeight;
+  const int kDstSize = kDstWidth * kDstHeight;
+  const int kDstUVSize = kDstHalfWidth * kDstHalfHeight;
+  align_buffer_page_end(src, kSrcSize + kSrcUVSize * 2);
+  align_buffer_page_end(dst_scale, kDstSize + kDstUVSize * 2);
+  align_buffer_page_end(dst_plan, kDstSize + kDstUVSize * 2);
+  MemRandomize(src, kSrcSize + kSrcUVSize * 2);
+  memset(dst_scale, 1, kDstSize + kDstUVSize * 2);
+  memset(dst_plan, 2, kDstSize + kDstUVSize * 2);
+
+  double scale_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I420Scale(src, kSrcWidth, src + kSrcSize, kSrcHalfWidth,
+              src + kSrcSize + kSrcUVSize, kSrcHalfWidth, kSrcWidth,
+              kSrcHeight, dst_scale, kDstWidth, dst_scale + kDstSize,
+              kDstHalfWidth, dst_scale + kDstSize + kDstUVSize, kDstHalfWidth,
+              kDstWidth, kDstHeight, kFilterLanczos);
+  }
+  scale_time = (get_time() - scale_time) / benchmark_iterations_;
+
+  ScalePlan* plan = CreateScalePlan(FOURCC_I420, kSrcWidth, kSrcHeight,
+                                    kDstWidth, kDstHeight, kFilterLanczos);
+  ASSERT_TRUE(plan != NULL);
+  double plan_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ScalePlanI420(plan, src, kSrcWidth, src + kSrcSize, kSrcHalfWidth,
+                  src + kSrcSize + kSrcUVSize, kSrcHalfWidth, dst_plan,
+                  kDstWidth, dst_plan + kDstSize, kDstHalfWidth,
+                  dst_plan + kDstSize + kDstUVSize, kDstHalfWidth);
+  }
+  plan_time = (get_time() - plan_time) / benchmark_iterations_;
+  DestroyScalePlan(plan);
+
+  printf("%8d us I420Scale - %8d us ScalePlanI420\n",
+         static_cast<int>(scale_time * 1e6),
+         static_cast<int>(plan_time * 1e6));
+  EXPECT_EQ(0, memcmp(dst_scale, dst_plan, kDstSize + kDstUVSize * 2));
+
+  free_aligned_buffer_page_end(dst_plan);
+  free_aligned_buffer_page_end(dst_scale);
+  free_aligned_buffer_page_end(src);
+}
+
+}  // namespace libyuv
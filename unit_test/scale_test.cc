@@ -13,6 +13,7 @@
 
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/executor.h"
 #include "libyuv/scale.h"
 #include "libyuv/scale_row.h"  // For ScaleRowDown2Box_Odd_C
 
@@ -296,6 +297,31 @@ TEST_FACTOR(3by8, 3, 8, 1)
 TEST_FACTOR(3, 1, 3, 0)
 #undef TEST_FACTOR1
 #undef TEST_FACTOR
+
+// Polyphase filters are bit exact with C. The 16 bit scaler keeps ringing
+// past 255, so it is only compared with its own C version.
+#define TEST_FACTOR1(name, filter, nom, denom)                               \
+  TEST_F(LibYUVScaleTest, ScaleDownBy##name##_##filter) {                    \
+    int diff = TestFilter(                                                   \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, benchmark_iterations_, disable_cpu_flags_,          \
+        benchmark_cpu_info_);                                                \
+    EXPECT_EQ(0, diff);                                                      \
+  }
+
+#define TEST_FACTOR(name, nom, denom)     \
+  TEST_FACTOR1(name, Bicubic, nom, denom) \
+  TEST_FACTOR1(name, Lanczos, nom, denom)
+
+TEST_FACTOR(2, 1, 2)
+TEST_FACTOR(4, 1, 4)
+TEST_FACTOR(8, 1, 8)
+TEST_FACTOR(3by4, 3, 4)
+TEST_FACTOR(3by8, 3, 8)
+TEST_FACTOR(3, 1, 3)
+#undef TEST_FACTOR1
+#undef TEST_FACTOR
 #undef SX
 #undef DX
 
@@ -343,6 +369,146 @@ TEST_SCALETO(Scale, 1920, 1080)
 #undef TEST_SCALETO1
 #undef TEST_SCALETO
 
+#define TEST_SCALETO1(name, width, height, filter)                            \
+  TEST_F(LibYUVScaleTest, name##To##width##x##height##_##filter) {            \
+    int diff = TestFilter(benchmark_width_, benchmark_height_, width, height, \
+                          kFilter##filter, benchmark_iterations_,             \
+                          disable_cpu_flags_, benchmark_cpu_info_);           \
+    EXPECT_EQ(0, diff);                                                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, name##From##width##x##height##_##filter) {          \
+    int diff = TestFilter(width, height, Abs(benchmark_width_),               \
+                          Abs(benchmark_height_), kFilter##filter,            \
+                          benchmark_iterations_, disable_cpu_flags_,          \
+                          benchmark_cpu_info_);                               \
+    EXPECT_EQ(0, diff);                                                       \
+  }
+
+#define TEST_SCALETO(name, width, height)     \
+  TEST_SCALETO1(name, width, height, Bicubic) \
+  TEST_SCALETO1(name, width, height, Lanczos)
+
+TEST_SCALETO(Scale, 1, 1)
+TEST_SCALETO(Scale, 320, 240)
+TEST_SCALETO(Scale, 569, 480)
+TEST_SCALETO(Scale, 640, 360)
+TEST_SCALETO(Scale, 1280, 720)
+TEST_SCALETO(Scale, 1920, 1080)
+#undef TEST_SCALETO1
+#undef TEST_SCALETO
+
+// Polyphase filter weights sum to 1, so flat planes stay flat at any scale,
+// including the edges where weights past the plane are folded in.
+TEST_F(LibYUVScaleTest, ScalePlanePolyphaseFlat) {
+  const int kSizes[][4] = {{640, 360, 213, 120}, {97, 33, 640, 480},
+                           {1920, 1080, 7, 3},   {5, 3, 1, 1},
+                           {1, 1, 11, 5},        {-64, 48, 30, 100}};
+  for (int f = kFilterBicubic; f <= kFilterLanczos; ++f) {
+    for (size_t i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); ++i) {
+      const int src_width = Abs(kSizes[i][0]);
+      const int src_height = kSizes[i][1];
+      const int dst_width = kSizes[i][2];
+      const int dst_height = kSizes[i][3];
+      align_buffer_page_end(src, src_width * src_height);
+      align_buffer_page_end(dst, dst_width * dst_height);
+      align_buffer_page_end(src_16, src_width * src_height * 2);
+      align_buffer_page_end(dst_16, dst_width * dst_height * 2);
+      uint16_t* p_src_16 = reinterpret_cast<uint16_t*>(src_16);
+      uint16_t* p_dst_16 = reinterpret_cast<uint16_t*>(dst_16);
+      memset(src, 201, src_width * src_height);
+      for (int j = 0; j < src_width * src_height; ++j) {
+        p_src_16[j] = 1023;
+      }
+      ScalePlane(src, src_width, kSizes[i][0], src_height, dst, dst_width,
+                 dst_width, dst_height, static_cast<FilterMode>(f));
+      ScalePlane_16(p_src_16, src_width, kSizes[i][0], src_height, p_dst_16,
+                    dst_width, dst_width, dst_height,
+                    static_cast<FilterMode>(f));
+      for (int j = 0; j < dst_width * dst_height; ++j) {
+        EXPECT_EQ(201, dst[j]);
+        EXPECT_EQ(1023, p_dst_16[j]);
+      }
+      free_aligned_buffer_page_end(dst_16);
+      free_aligned_buffer_page_end(src_16);
+      free_aligned_buffer_page_end(dst);
+      free_aligned_buffer_page_end(src);
+    }
+  }
+}
+
+// A pattern with a period of 3 pixels is above the Nyquist frequency after
+// scaling down by 2. Box filtering aliases it to a pattern of +/- 50, while
+// Lanczos filters most of it out.
+TEST_F(LibYUVScaleTest, ScalePlaneLanczosAliasing) {
+  const int kWidth = 96;
+  const int kHeight = 8;
+  const int kDstWidth = kWidth / 2;
+  align_buffer_page_end(src, kWidth * kHeight);
+  align_buffer_page_end(dst, kDstWidth * kHeight / 2);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      src[y * kWidth + x] = x % 3 == 0 ? 228 : 78;
+    }
+  }
+  ScalePlane(src, kWidth, kWidth, kHeight, dst, kDstWidth, kDstWidth,
+             kHeight / 2, kFilterLanczos);
+  for (int y = 0; y < kHeight / 2; ++y) {
+    for (int x = 3; x < kDstWidth - 3; ++x) {
+      EXPECT_NEAR(128, dst[y * kDstWidth + x], 12);
+    }
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+// Box filtering with a negative source width matches box filtering followed
+// by a horizontal mirror when the step is exact in 16.16 fixed point.
+TEST_F(LibYUVScaleTest, ScalePlaneBoxMirror) {
+  const int kSizes[][4] = {
+      {60, 48, 20, 12}, {80, 40, 32, 16}, {99, 97, 33, 7}, {120, 63, 48, 20}};
+  for (size_t i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); ++i) {
+    const int src_width = kSizes[i][0];
+    const int src_height = kSizes[i][1];
+    const int dst_width = kSizes[i][2];
+    const int dst_height = kSizes[i][3];
+    align_buffer_page_end(src, src_width * src_height);
+    align_buffer_page_end(dst, dst_width * dst_height);
+    align_buffer_page_end(dst_mirror, dst_width * dst_height);
+    align_buffer_page_end(src_16, src_width * src_height * 2);
+    align_buffer_page_end(dst_16, dst_width * dst_height * 2);
+    align_buffer_page_end(dst_mirror_16, dst_width * dst_height * 2);
+    uint16_t* p_src_16 = reinterpret_cast<uint16_t*>(src_16);
+    uint16_t* p_dst_16 = reinterpret_cast<uint16_t*>(dst_16);
+    uint16_t* p_dst_mirror_16 = reinterpret_cast<uint16_t*>(dst_mirror_16);
+    MemRandomize(src, src_width * src_height);
+    for (int j = 0; j < src_width * src_height; ++j) {
+      p_src_16[j] = src[j] * 4 + (j & 3);
+    }
+    ScalePlane(src, src_width, src_width, src_height, dst, dst_width,
+               dst_width, dst_height, kFilterBox);
+    ScalePlane(src, src_width, -src_width, src_height, dst_mirror, dst_width,
+               dst_width, dst_height, kFilterBox);
+    ScalePlane_16(p_src_16, src_width, src_width, src_height, p_dst_16,
+                  dst_width, dst_width, dst_height, kFilterBox);
+    ScalePlane_16(p_src_16, src_width, -src_width, src_height, p_dst_mirror_16,
+                  dst_width, dst_width, dst_height, kFilterBox);
+    for (int y = 0; y < dst_height; ++y) {
+      for (int x = 0; x < dst_width; ++x) {
+        const int j = y * dst_width + x;
+        const int k = y * dst_width + dst_width - 1 - x;
+        EXPECT_EQ(dst[j], dst_mirror[k]);
+        EXPECT_EQ(p_dst_16[j], p_dst_mirror_16[k]);
+      }
+    }
+    free_aligned_buffer_page_end(dst_mirror_16);
+    free_aligned_buffer_page_end(dst_16);
+    free_aligned_buffer_page_end(src_16);
+    free_aligned_buffer_page_end(dst_mirror);
+    free_aligned_buffer_page_end(dst);
+    free_aligned_buffer_page_end(src);
+  }
+}
+
 #ifdef HAS_SCALEROWDOWN2_SSSE3
 TEST_F(LibYUVScaleTest, TestScaleRowDown2Box_Odd_SSSE3) {
   SIMD_ALIGNED(uint8_t orig_pixels[128 * 2]);
@@ -622,4 +788,694 @@ TEST_FACTOR(3, 1, 3, 0)
 #undef TEST_FACTOR
 #undef SX
 #undef DX
+
+// Test scaling plane with 16 bit C vs 16 bit SIMD and return maximum pixel
+// difference. Pixels use the full 16 bit range. 0 = exact.
+static int TestPlaneFilterOpt_16(int src_width,
+                                 int src_height,
+                                 int dst_width,
+                                 int dst_height,
+                                 FilterMode f,
+                                 int benchmark_iterations,
+                                 int disable_cpu_flags,
+                                 int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int64_t src_y_plane_size = (Abs(src_width)) * (Abs(src_height));
+  int src_stride_y = Abs(src_width);
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_stride_y = dst_width;
+
+  align_buffer_page_end(src_y_16, src_y_plane_size * 2);
+  align_buffer_page_end(dst_y_c, dst_y_plane_size * 2);
+  align_buffer_page_end(dst_y_opt, dst_y_plane_size * 2);
+  uint16_t* p_src_y_16 = reinterpret_cast<uint16_t*>(src_y_16);
+  uint16_t* p_dst_y_c = reinterpret_cast<uint16_t*>(dst_y_c);
+  uint16_t* p_dst_y_opt = reinterpret_cast<uint16_t*>(dst_y_opt);
+
+  MemRandomize(src_y_16, src_y_plane_size * 2);
+  memset(dst_y_c, 2, dst_y_plane_size * 2);
+  memset(dst_y_opt, 3, dst_y_plane_size * 2);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  double c_time = get_time();
+  ScalePlane_16(p_src_y_16, src_stride_y, src_width, src_height, p_dst_y_c,
+                dst_stride_y, dst_width, dst_height, f);
+  c_time = (get_time() - c_time);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  double opt_time = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    ScalePlane_16(p_src_y_16, src_stride_y, src_width, src_height,
+                  p_dst_y_opt, dst_stride_y, dst_width, dst_height, f);
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations;
+  // Report performance of C vs OPT.
+  printf("filter %d - %8d us C - %8d us OPT\n", f,
+         static_cast<int>(c_time * 1e6), static_cast<int>(opt_time * 1e6));
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_y_c[i] - p_dst_y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(src_y_16);
+
+  return max_diff;
+}
+
+#define DX(x, nom, denom) static_cast<int>(((Abs(x) / nom + 1) / 2) * nom * 2)
+#define SX(x, nom, denom) static_cast<int>(((x / nom + 1) / 2) * denom * 2)
+
+#define TEST_FACTOR1(name, filter, nom, denom)                               \
+  TEST_F(LibYUVScaleTest, ScalePlaneDownBy##name##_##filter##_16_Opt) {      \
+    int diff = TestPlaneFilterOpt_16(                                        \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, benchmark_iterations_, disable_cpu_flags_,          \
+        benchmark_cpu_info_);                                                \
+    EXPECT_EQ(0, diff);                                                      \
+  }
+
+// SIMD 16 bit scalers are bit exact with C for all filters.
+#define TEST_FACTOR(name, nom, denom)      \
+  TEST_FACTOR1(name, None, nom, denom)     \
+  TEST_FACTOR1(name, Linear, nom, denom)   \
+  TEST_FACTOR1(name, Bilinear, nom, denom) \
+  TEST_FACTOR1(name, Box, nom, denom)      \
+  TEST_FACTOR1(name, Bicubic, nom, denom)  \
+  TEST_FACTOR1(name, Lanczos, nom, denom)
+
+TEST_FACTOR(2, 1, 2)
+TEST_FACTOR(4, 1, 4)
+TEST_FACTOR(8, 1, 8)
+TEST_FACTOR(3by4, 3, 4)
+TEST_FACTOR(3by8, 3, 8)
+TEST_FACTOR(3, 1, 3)
+#undef TEST_FACTOR1
+#undef TEST_FACTOR
+#undef SX
+#undef DX
+
+#define TEST_SCALETO1(name, width, height, filter)                            \
+  TEST_F(LibYUVScaleTest, name##To##width##x##height##_##filter##_16_Opt) {   \
+    int diff = TestPlaneFilterOpt_16(                                         \
+        benchmark_width_, benchmark_height_, width, height,                   \
+        kFilter##filter, benchmark_iterations_, disable_cpu_flags_,           \
+        benchmark_cpu_info_);                                                 \
+    EXPECT_EQ(0, diff);                                                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, name##From##width##x##height##_##filter##_16_Opt) { \
+    int diff = TestPlaneFilterOpt_16(                                         \
+        width, height, Abs(benchmark_width_), Abs(benchmark_height_),         \
+        kFilter##filter, benchmark_iterations_, disable_cpu_flags_,           \
+        benchmark_cpu_info_);                                                 \
+    EXPECT_EQ(0, diff);                                                       \
+  }
+
+#define TEST_SCALETO(name, width, height)      \
+  TEST_SCALETO1(name, width, height, None)     \
+  TEST_SCALETO1(name, width, height, Linear)   \
+  TEST_SCALETO1(name, width, height, Bilinear) \
+  TEST_SCALETO1(name, width, height, Box)      \
+  TEST_SCALETO1(name, width, height, Bicubic)  \
+  TEST_SCALETO1(name, width, height, Lanczos)
+
+TEST_SCALETO(ScalePlane, 569, 480)
+TEST_SCALETO(ScalePlane, 1920, 1080)
+#undef TEST_SCALETO1
+#undef TEST_SCALETO
+
+// Test scaling with multiple threads vs a single thread and return maximum
+// pixel difference. 0 = exact.
+static int TestFilterMT(int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        FilterMode f,
+                        int num_threads,
+                        int benchmark_iterations,
+                        int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int src_width_uv = (Abs(src_width) + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+
+  int64_t src_y_plane_size = (Abs(src_width)) * (Abs(src_height));
+  int64_t src_uv_plane_size = (src_width_uv) * (src_height_uv);
+
+  int src_stride_y = Abs(src_width);
+  int src_stride_uv = src_width_uv;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_u, src_uv_plane_size);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  if (!src_y || !src_u || !src_v) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+
+  int64_t dst_y_plane_size = (dst_width) * (dst_height);
+  int64_t dst_uv_plane_size = (dst_width_uv) * (dst_height_uv);
+
+  int dst_stride_y = dst_width;
+  int dst_stride_uv = dst_width_uv;
+
+  align_buffer_page_end(dst_y_1, dst_y_plane_size);
+  align_buffer_page_end(dst_u_1, dst_uv_plane_size);
+  align_buffer_page_end(dst_v_1, dst_uv_plane_size);
+  align_buffer_page_end(dst_y_mt, dst_y_plane_size);
+  align_buffer_page_end(dst_u_mt, dst_uv_plane_size);
+  align_buffer_page_end(dst_v_mt, dst_uv_plane_size);
+  if (!dst_y_1 || !dst_u_1 || !dst_v_1 || !dst_y_mt || !dst_u_mt ||
+      !dst_v_mt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  memset(dst_y_1, 1, dst_y_plane_size);
+  memset(dst_u_1, 2, dst_uv_plane_size);
+  memset(dst_v_1, 3, dst_uv_plane_size);
+  memset(dst_y_mt, 4, dst_y_plane_size);
+  memset(dst_u_mt, 5, dst_uv_plane_size);
+  memset(dst_v_mt, 6, dst_uv_plane_size);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  double time_1 = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    I420Scale(src_y, src_stride_y, src_u, src_stride_uv, src_v, src_stride_uv,
+              src_width, src_height, dst_y_1, dst_stride_y, dst_u_1,
+              dst_stride_uv, dst_v_1, dst_stride_uv, dst_width, dst_height, f);
+  }
+  time_1 = (get_time() - time_1) / benchmark_iterations;
+
+  ParallelExecutor* pool = CreateThreadPool(num_threads);
+  double time_mt = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    I420ScaleMT(src_y, src_stride_y, src_u, src_stride_uv, src_v,
+                src_stride_uv, src_width, src_height, dst_y_mt, dst_stride_y,
+                dst_u_mt, dst_stride_uv, dst_v_mt, dst_stride_uv, dst_width,
+                dst_height, f, pool);
+  }
+  time_mt = (get_time() - time_mt) / benchmark_iterations;
+  DestroyThreadPool(pool);
+  printf("filter %d - %8d us 1 thread - %8d us %d threads\n", f,
+         static_cast<int>(time_1 * 1e6), static_cast<int>(time_mt * 1e6),
+         num_threads);
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(dst_y_1[i] - dst_y_mt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(dst_u_1[i] - dst_u_mt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(dst_v_1[i] - dst_v_mt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_1);
+  free_aligned_buffer_page_end(dst_u_1);
+  free_aligned_buffer_page_end(dst_v_1);
+  free_aligned_buffer_page_end(dst_y_mt);
+  free_aligned_buffer_page_end(dst_u_mt);
+  free_aligned_buffer_page_end(dst_v_mt);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+
+  return max_diff;
+}
+
+// Test scaling a 16 bit plane with multiple threads vs a single thread and
+// return maximum pixel difference. 0 = exact.
+static int TestPlaneFilterMT_16(int src_width,
+                                int src_height,
+                                int dst_width,
+                                int dst_height,
+                                FilterMode f,
+                                int num_threads,
+                                int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int64_t src_y_plane_size = (Abs(src_width)) * (Abs(src_height));
+  int src_stride_y = Abs(src_width);
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_stride_y = dst_width;
+
+  align_buffer_page_end(src_y_16, src_y_plane_size * 2);
+  align_buffer_page_end(dst_y_1, dst_y_plane_size * 2);
+  align_buffer_page_end(dst_y_mt, dst_y_plane_size * 2);
+  uint16_t* p_src_y_16 = reinterpret_cast<uint16_t*>(src_y_16);
+  uint16_t* p_dst_y_1 = reinterpret_cast<uint16_t*>(dst_y_1);
+  uint16_t* p_dst_y_mt = reinterpret_cast<uint16_t*>(dst_y_mt);
+
+  MemRandomize(src_y_16, src_y_plane_size * 2);
+  for (i = 0; i < src_y_plane_size; ++i) {
+    p_src_y_16[i] &= 1023;
+  }
+  memset(dst_y_1, 0, dst_y_plane_size * 2);
+  memset(dst_y_mt, 1, dst_y_plane_size * 2);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  ScalePlane_16(p_src_y_16, src_stride_y, src_width, src_height, p_dst_y_1,
+                dst_stride_y, dst_width, dst_height, f);
+  ParallelExecutor* pool = CreateThreadPool(num_threads);
+  ScalePlaneMT_16(p_src_y_16, src_stride_y, src_width, src_height, p_dst_y_mt,
+                  dst_stride_y, dst_width, dst_height, f, pool);
+  DestroyThreadPool(pool);
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_y_1[i] - p_dst_y_mt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_1);
+  free_aligned_buffer_page_end(dst_y_mt);
+  free_aligned_buffer_page_end(src_y_16);
+
+  return max_diff;
+}
+
+// The following adjustments in dimensions ensure the scale factor will be
+// exactly achieved.
+// 2 is chroma subsample.
+#define DX(x, nom, denom) static_cast<int>(((Abs(x) / nom + 1) / 2) * nom * 2)
+#define SX(x, nom, denom) static_cast<int>(((x / nom + 1) / 2) * denom * 2)
+
+#define TEST_FACTOR1(name, filter, nom, denom, threads)                      \
+  TEST_F(LibYUVScaleTest, ScaleDownBy##name##_##filter##_MT##threads) {      \
+    int diff = TestFilterMT(                                                 \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, threads, benchmark_iterations_,                     \
+        benchmark_cpu_info_);                                                \
+    EXPECT_EQ(0, diff);                                                      \
+  }                                                                          \
+  TEST_F(LibYUVScaleTest,                                                    \
+         ScalePlaneDownBy##name##_##filter##_MT##threads##_16) {             \
+    int diff = TestPlaneFilterMT_16(                                         \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, threads, benchmark_cpu_info_);                      \
+    EXPECT_EQ(0, diff);                                                      \
+  }
+
+// Test a scale factor with all 4 filters and an odd number of threads so
+// bands are uneven.
+#define TEST_FACTOR(name, nom, denom)         \
+  TEST_FACTOR1(name, None, nom, denom, 3)     \
+  TEST_FACTOR1(name, Linear, nom, denom, 3)   \
+  TEST_FACTOR1(name, Bilinear, nom, denom, 3) \
+  TEST_FACTOR1(name, Box, nom, denom, 3)      \
+  TEST_FACTOR1(name, Lanczos, nom, denom, 3)
+
+TEST_FACTOR(2, 1, 2)
+TEST_FACTOR(4, 1, 4)
+TEST_FACTOR(8, 1, 8)
+TEST_FACTOR(3by4, 3, 4)
+TEST_FACTOR(3by8, 3, 8)
+TEST_FACTOR(3, 1, 3)
+#undef TEST_FACTOR1
+#undef TEST_FACTOR
+#undef SX
+#undef DX
+
+#define TEST_SCALETO1(name, width, height, filter, threads)                   \
+  TEST_F(LibYUVScaleTest,                                                     \
+         name##To##width##x##height##_##filter##_MT##threads) {               \
+    int diff = TestFilterMT(benchmark_width_, benchmark_height_, width,       \
+                            height, kFilter##filter, threads,                 \
+                            benchmark_iterations_, benchmark_cpu_info_);      \
+    EXPECT_EQ(0, diff);                                                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest,                                                     \
+         name##From##width##x##height##_##filter##_MT##threads) {             \
+    int diff = TestFilterMT(width, height, Abs(benchmark_width_),             \
+                            Abs(benchmark_height_), kFilter##filter, threads, \
+                            benchmark_iterations_, benchmark_cpu_info_);      \
+    EXPECT_EQ(0, diff);                                                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest,                                                     \
+         name##To##width##x##height##_##filter##_MT##threads##_16) {          \
+    int diff = TestPlaneFilterMT_16(benchmark_width_, benchmark_height_,      \
+                                    width, height, kFilter##filter, threads,  \
+                                    benchmark_cpu_info_);                     \
+    EXPECT_EQ(0, diff);                                                       \
+  }
+
+// Test scale to a specified size with all 4 filters.
+#define TEST_SCALETO(name, width, height)         \
+  TEST_SCALETO1(name, width, height, None, 4)     \
+  TEST_SCALETO1(name, width, height, Linear, 4)   \
+  TEST_SCALETO1(name, width, height, Bilinear, 4) \
+  TEST_SCALETO1(name, width, height, Box, 4)      \
+  TEST_SCALETO1(name, width, height, Lanczos, 4)
+
+TEST_SCALETO(Scale, 1, 1)
+TEST_SCALETO(Scale, 320, 240)
+TEST_SCALETO(Scale, 569, 480)
+TEST_SCALETO(Scale, 1920, 1080)
+#undef TEST_SCALETO1
+#undef TEST_SCALETO
+
+// Report how I420ScaleMT scales with the number of threads.
+// Use LIBYUV_REPEAT=1000 to benchmark.
+TEST_F(LibYUVScaleTest, I420ScaleMT_Threads) {
+  static const int kThreads[] = {1, 2, 4, 8, 16};
+  for (int i = 0; i < static_cast<int>(sizeof(kThreads) / sizeof(kThreads[0]));
+       ++i) {
+    int diff = TestFilterMT(Abs(benchmark_width_) * 2,
+                            Abs(benchmark_height_) * 2, Abs(benchmark_width_),
+                            Abs(benchmark_height_), kFilterBilinear,
+                            kThreads[i], benchmark_iterations_,
+                            benchmark_cpu_info_);
+    EXPECT_EQ(0, diff);
+  }
+}
+
+// Test scaling the destination in tiles with the clipped scalers vs scaling
+// the whole image and return maximum pixel difference. 0 = exact.
+static int TestFilterClip(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          FilterMode f,
+                          int tile_width,
+                          int tile_height,
+                          int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int src_width_uv = (Abs(src_width) + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+
+  int64_t src_y_plane_size = (Abs(src_width)) * (Abs(src_height));
+  int64_t src_uv_plane_size = (src_width_uv) * (src_height_uv);
+
+  int src_stride_y = Abs(src_width);
+  int src_stride_uv = src_width_uv;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_u, src_uv_plane_size);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  if (!src_y || !src_u || !src_v) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+
+  int64_t dst_y_plane_size = (dst_width) * (dst_height);
+  int64_t dst_uv_plane_size = (dst_width_uv) * (dst_height_uv);
+
+  int dst_stride_y = dst_width;
+  int dst_stride_uv = dst_width_uv;
+
+  align_buffer_page_end(dst_y_1, dst_y_plane_size);
+  align_buffer_page_end(dst_u_1, dst_uv_plane_size);
+  align_buffer_page_end(dst_v_1, dst_uv_plane_size);
+  align_buffer_page_end(dst_y_clip, dst_y_plane_size);
+  align_buffer_page_end(dst_u_clip, dst_uv_plane_size);
+  align_buffer_page_end(dst_v_clip, dst_uv_plane_size);
+  if (!dst_y_1 || !dst_u_1 || !dst_v_1 || !dst_y_clip || !dst_u_clip ||
+      !dst_v_clip) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  memset(dst_y_1, 1, dst_y_plane_size);
+  memset(dst_u_1, 2, dst_uv_plane_size);
+  memset(dst_v_1, 3, dst_uv_plane_size);
+  memset(dst_y_clip, 4, dst_y_plane_size);
+  memset(dst_u_clip, 5, dst_uv_plane_size);
+  memset(dst_v_clip, 6, dst_uv_plane_size);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  I420Scale(src_y, src_stride_y, src_u, src_stride_uv, src_v, src_stride_uv,
+            src_width, src_height, dst_y_1, dst_stride_y, dst_u_1,
+            dst_stride_uv, dst_v_1, dst_stride_uv, dst_width, dst_height, f);
+  for (int y = 0; y < dst_height; y += tile_height) {
+    for (int x = 0; x < dst_width; x += tile_width) {
+      int clip_width = dst_width - x < tile_width ? dst_width - x : tile_width;
+      int clip_height =
+          dst_height - y < tile_height ? dst_height - y : tile_height;
+      EXPECT_EQ(0, I420ScaleClip(src_y, src_stride_y, src_u, src_stride_uv,
+                                 src_v, src_stride_uv, src_width, src_height,
+                                 dst_y_clip, dst_stride_y, dst_u_clip,
+                                 dst_stride_uv, dst_v_clip, dst_stride_uv,
+                                 dst_width, dst_height, x, y, clip_width,
+                                 clip_height, f));
+    }
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(dst_y_1[i] - dst_y_clip[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(dst_u_1[i] - dst_u_clip[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(dst_v_1[i] - dst_v_clip[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_1);
+  free_aligned_buffer_page_end(dst_u_1);
+  free_aligned_buffer_page_end(dst_v_1);
+  free_aligned_buffer_page_end(dst_y_clip);
+  free_aligned_buffer_page_end(dst_u_clip);
+  free_aligned_buffer_page_end(dst_v_clip);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+
+  return max_diff;
+}
+
+// Test scaling a 16 bit plane in tiles vs the whole plane and return maximum
+// pixel difference. 0 = exact.
+static int TestPlaneFilterClip_16(int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  FilterMode f,
+                                  int tile_width,
+                                  int tile_height,
+                                  int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int64_t src_y_plane_size = (Abs(src_width)) * (Abs(src_height));
+  int src_stride_y = Abs(src_width);
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_stride_y = dst_width;
+
+  align_buffer_page_end(src_y_16, src_y_plane_size * 2);
+  align_buffer_page_end(dst_y_1, dst_y_plane_size * 2);
+  align_buffer_page_end(dst_y_clip, dst_y_plane_size * 2);
+  uint16_t* p_src_y_16 = reinterpret_cast<uint16_t*>(src_y_16);
+  uint16_t* p_dst_y_1 = reinterpret_cast<uint16_t*>(dst_y_1);
+  uint16_t* p_dst_y_clip = reinterpret_cast<uint16_t*>(dst_y_clip);
+
+  MemRandomize(src_y_16, src_y_plane_size * 2);
+  for (i = 0; i < src_y_plane_size; ++i) {
+    p_src_y_16[i] &= 1023;
+  }
+  memset(dst_y_1, 0, dst_y_plane_size * 2);
+  memset(dst_y_clip, 1, dst_y_plane_size * 2);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  ScalePlane_16(p_src_y_16, src_stride_y, src_width, src_height, p_dst_y_1,
+                dst_stride_y, dst_width, dst_height, f);
+  for (int y = 0; y < dst_height; y += tile_height) {
+    for (int x = 0; x < dst_width; x += tile_width) {
+      int clip_width = dst_width - x < tile_width ? dst_width - x : tile_width;
+      int clip_height =
+          dst_height - y < tile_height ? dst_height - y : tile_height;
+      EXPECT_EQ(0, ScalePlaneClip_16(p_src_y_16, src_stride_y, src_width,
+                                     src_height, p_dst_y_clip, dst_stride_y,
+                                     dst_width, dst_height, x, y, clip_width,
+                                     clip_height, f));
+    }
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_y_1[i] - p_dst_y_clip[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_1);
+  free_aligned_buffer_page_end(dst_y_clip);
+  free_aligned_buffer_page_end(src_y_16);
+
+  return max_diff;
+}
+
+// The following adjustments in dimensions ensure the scale factor will be
+// exactly achieved.
+// 2 is chroma subsample.
+#define DX(x, nom, denom) static_cast<int>(((Abs(x) / nom + 1) / 2) * nom * 2)
+#define SX(x, nom, denom) static_cast<int>(((x / nom + 1) / 2) * denom * 2)
+
+// Tiles of 37x19 have odd edges and cut the row groups of the 3/4 and 3/8
+// scalers.
+#define TEST_FACTOR1(name, filter, nom, denom)                               \
+  TEST_F(LibYUVScaleTest, ScaleDownBy##name##_##filter##_Clip) {             \
+    int diff = TestFilterClip(                                               \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, 37, 19, benchmark_cpu_info_);                       \
+    EXPECT_EQ(0, diff);                                                      \
+  }                                                                          \
+  TEST_F(LibYUVScaleTest, ScalePlaneDownBy##name##_##filter##_Clip_16) {     \
+    int diff = TestPlaneFilterClip_16(                                       \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, 37, 19, benchmark_cpu_info_);                       \
+    EXPECT_EQ(0, diff);                                                      \
+  }
+
+#define TEST_FACTOR(name, nom, denom)        \
+  TEST_FACTOR1(name, None, nom, denom)       \
+  TEST_FACTOR1(name, Linear, nom, denom)     \
+  TEST_FACTOR1(name, Bilinear, nom, denom)   \
+  TEST_FACTOR1(name, Box, nom, denom)        \
+  TEST_FACTOR1(name, Bicubic, nom, denom)    \
+  TEST_FACTOR1(name, Lanczos, nom, denom)
+
+TEST_FACTOR(2, 1, 2)
+TEST_FACTOR(4, 1, 4)
+TEST_FACTOR(8, 1, 8)
+TEST_FACTOR(3by4, 3, 4)
+TEST_FACTOR(3by8, 3, 8)
+TEST_FACTOR(3, 1, 3)
+#undef TEST_FACTOR1
+#undef TEST_FACTOR
+#undef SX
+#undef DX
+
+#define TEST_SCALETO1(name, width, height, filter)                            \
+  TEST_F(LibYUVScaleTest, name##To##width##x##height##_##filter##_Clip) {     \
+    int diff = TestFilterClip(benchmark_width_, benchmark_height_, width,     \
+                              height, kFilter##filter, 37, 19,                \
+                              benchmark_cpu_info_);                           \
+    EXPECT_EQ(0, diff);                                                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, name##From##width##x##height##_##filter##_Clip) {   \
+    int diff = TestFilterClip(width, height, Abs(benchmark_width_),           \
+                              Abs(benchmark_height_), kFilter##filter, 37,    \
+                              19, benchmark_cpu_info_);                       \
+    EXPECT_EQ(0, diff);                                                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, name##To##width##x##height##_##filter##_Clip_16) {  \
+    int diff = TestPlaneFilterClip_16(benchmark_width_, benchmark_height_,    \
+                                      width, height, kFilter##filter, 37, 19, \
+                                      benchmark_cpu_info_);                   \
+    EXPECT_EQ(0, diff);                                                       \
+  }
+
+#define TEST_SCALETO(name, width, height)     \
+  TEST_SCALETO1(name, width, height, None)     \
+  TEST_SCALETO1(name, width, height, Linear)   \
+  TEST_SCALETO1(name, width, height, Bilinear) \
+  TEST_SCALETO1(name, width, height, Box)      \
+  TEST_SCALETO1(name, width, height, Bicubic)  \
+  TEST_SCALETO1(name, width, height, Lanczos)
+
+TEST_SCALETO(Scale, 1, 1)
+TEST_SCALETO(Scale, 320, 240)
+TEST_SCALETO(Scale, 569, 480)
+TEST_SCALETO(Scale, 1920, 1080)
+#undef TEST_SCALETO1
+#undef TEST_SCALETO
+
+// A clip only writes its rectangle of the destination.
+TEST_F(LibYUVScaleTest, ScalePlaneClip_Untouched) {
+  const int kSrcWidth = 64;
+  const int kSrcHeight = 48;
+  const int kDstWidth = 48;
+  const int kDstHeight = 36;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight);
+  MemRandomize(src, kSrcWidth * kSrcHeight);
+  for (int f = kFilterNone; f <= kFilterLanczos; ++f) {
+    memset(dst, 0x5a, kDstWidth * kDstHeight);
+    EXPECT_EQ(0, ScalePlaneClip(src, kSrcWidth, kSrcWidth, kSrcHeight, dst,
+                                kDstWidth, kDstWidth, kDstHeight, 7, 5, 11, 13,
+                                static_cast<FilterMode>(f)));
+    for (int y = 0; y < kDstHeight; ++y) {
+      for (int x = 0; x < kDstWidth; ++x) {
+        if (x < 7 || x >= 18 || y < 5 || y >= 18) {
+          EXPECT_EQ(0x5a, dst[y * kDstWidth + x]);
+        }
+      }
+    }
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVScaleTest, ScalePlaneClip_Invalid) {
+  uint8_t src[16 * 16];
+  uint8_t dst[8 * 8];
+  memset(src, 0, sizeof(src));
+  EXPECT_EQ(-1, ScalePlaneClip(src, 16, 16, 16, dst, 8, 8, 8, -1, 0, 4, 4,
+                               kFilterBilinear));
+  EXPECT_EQ(-1, ScalePlaneClip(src, 16, 16, 16, dst, 8, 8, 8, 0, 0, 0, 4,
+                               kFilterBilinear));
+  EXPECT_EQ(-1, ScalePlaneClip(src, 16, 16, 16, dst, 8, 8, 8, 6, 0, 4, 4,
+                               kFilterBilinear));
+  EXPECT_EQ(-1, ScalePlaneClip(src, 16, 16, 16, dst, 8, 8, 8, 0, 6, 4, 4,
+                               kFilterBilinear));
+  EXPECT_EQ(-1, ScalePlaneClip(NULL, 16, 16, 16, dst, 8, 8, 8, 0, 0, 4, 4,
+                               kFilterBilinear));
+}
+
 }  // namespace libyuv
@@ -0,0 +1,316 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "../unit_test/unit_test.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_uv.h"
+
+namespace libyuv {
+
+#define STRINGIZE(line) #line
+#define FILELINESTR(file, line) file ":" STRINGIZE(line)
+
+// Test scaling with C vs Opt and return maximum pixel difference. 0 = exact.
+static int UVTestFilter(int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        FilterMode f,
+                        int benchmark_iterations,
+                        int disable_cpu_flags,
+                        int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int64_t src_uv_plane_size = Abs(src_width) * Abs(src_height) * 2LL;
+  int src_stride_uv = Abs(src_width) * 2;
+  int64_t dst_uv_plane_size = dst_width * dst_height * 2LL;
+  int dst_stride_uv = dst_width * 2;
+
+  align_buffer_page_end(src_uv, src_uv_plane_size);
+  align_buffer_page_end(dst_uv_c, dst_uv_plane_size);
+  align_buffer_page_end(dst_uv_opt, dst_uv_plane_size);
+  if (!src_uv || !dst_uv_c || !dst_uv_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  MemRandomize(src_uv, src_uv_plane_size);
+  memset(dst_uv_c, 2, dst_uv_plane_size);
+  memset(dst_uv_opt, 3, dst_uv_plane_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  double c_time = get_time();
+  UVScale(src_uv, src_stride_uv, src_width, src_height, dst_uv_c,
+          dst_stride_uv, dst_width, dst_height, f);
+  c_time = (get_time() - c_time);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  double opt_time = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    UVScale(src_uv, src_stride_uv, src_width, src_height, dst_uv_opt,
+            dst_stride_uv, dst_width, dst_height, f);
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations;
+
+  // Report performance of C vs OPT
+  printf("filter %d - %8d us C - %8d us OPT\n", f,
+         static_cast<int>(c_time * 1e6), static_cast<int>(opt_time * 1e6));
+
+  int max_diff = 0;
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(dst_uv_c[i] - dst_uv_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  free_aligned_buffer_page_end(src_uv);
+  return max_diff;
+}
+
+// Test 16 bit scaling with C vs Opt and return maximum pixel difference.
+// 0 = exact.
+static int UVTestFilter_16(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           FilterMode f,
+                           int benchmark_iterations,
+                           int disable_cpu_flags,
+                           int benchmark_cpu_info) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int64_t src_uv_plane_size = Abs(src_width) * Abs(src_height) * 2LL;
+  int src_stride_uv = Abs(src_width) * 2;
+  int64_t dst_uv_plane_size = dst_width * dst_height * 2LL;
+  int dst_stride_uv = dst_width * 2;
+
+  align_buffer_page_end(src_uv, src_uv_plane_size * 2);
+  align_buffer_page_end(dst_uv_c, dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_uv_opt, dst_uv_plane_size * 2);
+  if (!src_uv || !dst_uv_c || !dst_uv_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  uint16_t* p_src_uv = reinterpret_cast<uint16_t*>(src_uv);
+  uint16_t* p_dst_uv_c = reinterpret_cast<uint16_t*>(dst_uv_c);
+  uint16_t* p_dst_uv_opt = reinterpret_cast<uint16_t*>(dst_uv_opt);
+  MemRandomize(src_uv, src_uv_plane_size * 2);
+  memset(dst_uv_c, 2, dst_uv_plane_size * 2);
+  memset(dst_uv_opt, 3, dst_uv_plane_size * 2);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  UVScale_16(p_src_uv, src_stride_uv, src_width, src_height, p_dst_uv_c,
+             dst_stride_uv, dst_width, dst_height, f);
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  for (i = 0; i < benchmark_iterations; ++i) {
+    UVScale_16(p_src_uv, src_stride_uv, src_width, src_height, p_dst_uv_opt,
+               dst_stride_uv, dst_width, dst_height, f);
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_uv_c[i] - p_dst_uv_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  free_aligned_buffer_page_end(src_uv);
+  return max_diff;
+}
+
+// The following adjustments in dimensions ensure the scale factor will be
+// exactly achieved.
+#define DX(x, nom, denom) static_cast<int>((Abs(x) / nom) * nom)
+#define SX(x, nom, denom) static_cast<int>((x / nom) * denom)
+
+#define TEST_FACTOR1(name, filter, nom, denom)                               \
+  TEST_F(LibYUVScaleTest, UVScaleDownBy##name##_##filter) {                  \
+    int diff = UVTestFilter(                                                 \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, benchmark_iterations_, disable_cpu_flags_,          \
+        benchmark_cpu_info_);                                                \
+    EXPECT_EQ(0, diff);                                                      \
+  }                                                                          \
+  TEST_F(LibYUVScaleTest, UVScaleDownBy##name##_##filter##_16) {             \
+    int diff = UVTestFilter_16(                                              \
+        SX(benchmark_width_, nom, denom), SX(benchmark_height_, nom, denom), \
+        DX(benchmark_width_, nom, denom), DX(benchmark_height_, nom, denom), \
+        kFilter##filter, benchmark_iterations_, disable_cpu_flags_,          \
+        benchmark_cpu_info_);                                                \
+    EXPECT_EQ(0, diff);                                                      \
+  }
+
+// Test a scale factor with all 4 filters. The SIMD UV scalers are exact.
+#define TEST_FACTOR(name, nom, denom)      \
+  TEST_FACTOR1(name, None, nom, denom)     \
+  TEST_FACTOR1(name, Linear, nom, denom)   \
+  TEST_FACTOR1(name, Bilinear, nom, denom) \
+  TEST_FACTOR1(name, Box, nom, denom)
+
+TEST_FACTOR(2, 1, 2)
+TEST_FACTOR(4, 1, 4)
+TEST_FACTOR(8, 1, 8)
+TEST_FACTOR(3by4, 3, 4)
+TEST_FACTOR(3by8, 3, 8)
+TEST_FACTOR(3, 1, 3)
+#undef TEST_FACTOR1
+#undef TEST_FACTOR
+#undef SX
+#undef DX
+
+#define TEST_SCALETO1(name, width, height, filter)                             \
+  TEST_F(LibYUVScaleTest, name##To##width##x##height##_##filter) {             \
+    int diff = UVTestFilter(benchmark_width_, benchmark_height_, width,        \
+                            height, kFilter##filter, benchmark_iterations_,    \
+                            disable_cpu_flags_, benchmark_cpu_info_);          \
+    EXPECT_EQ(0, diff);                                                        \
+  }                                                                            \
+  TEST_F(LibYUVScaleTest, name##From##width##x##height##_##filter) {           \
+    int diff = UVTestFilter(width, height, Abs(benchmark_width_),              \
+                            Abs(benchmark_height_), kFilter##filter,           \
+                            benchmark_iterations_, disable_cpu_flags_,         \
+                            benchmark_cpu_info_);                              \
+    EXPECT_EQ(0, diff);                                                        \
+  }                                                                            \
+  TEST_F(LibYUVScaleTest, name##To##width##x##height##_##filter##_16) {        \
+    int diff = UVTestFilter_16(benchmark_width_, benchmark_height_, width,     \
+                               height, kFilter##filter, benchmark_iterations_, \
+                               disable_cpu_flags_, benchmark_cpu_info_);       \
+    EXPECT_EQ(0, diff);                                                        \
+  }                                                                            \
+  TEST_F(LibYUVScaleTest, name##From##width##x##height##_##filter##_16) {      \
+    int diff = UVTestFilter_16(width, height, Abs(benchmark_width_),           \
+                               Abs(benchmark_height_), kFilter##filter,        \
+                               benchmark_iterations_, disable_cpu_flags_,      \
+                               benchmark_cpu_info_);                           \
+    EXPECT_EQ(0, diff);                                                        \
+  }
+
+// Test scale to a specified size with all 4 filters.
+#define TEST_SCALETO(name, width, height)      \
+  TEST_SCALETO1(name, width, height, None)     \
+  TEST_SCALETO1(name, width, height, Linear)   \
+  TEST_SCALETO1(name, width, height, Bilinear) \
+  TEST_SCALETO1(name, width, height, Box)
+
+TEST_SCALETO(UVScale, 1, 1)
+TEST_SCALETO(UVScale, 320, 240)
+TEST_SCALETO(UVScale, 569, 480)
+TEST_SCALETO(UVScale, 640, 360)
+TEST_SCALETO(UVScale, 1280, 720)
+#undef TEST_SCALETO1
+#undef TEST_SCALETO
+
+// Point sampled NV12Scale matches splitting the UV plane and using I420Scale.
+TEST_F(LibYUVScaleTest, NV12ScaleVsI420Scale) {
+  const int kSrcWidth = 642;
+  const int kSrcHeight = 362;
+  const int kDstWidth = 1001;
+  const int kDstHeight = 135;
+  const int kSrcHalfWidth = (kSrcWidth + 1) / 2;
+  const int kSrcHalfHeight = (kSrcHeight + 1) / 2;
+  const int kDstHalfWidth = (kDstWidth + 1) / 2;
+  const int kDstHalfHeight = (kDstHeight + 1) / 2;
+  const int kSrcUVSize = kSrcHalfWidth * kSrcHalfHeight;
+  const int kDstUVSize = kDstHalfWidth * kDstHalfHeight;
+  align_buffer_page_end(src_y, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(src_uv, kSrcUVSize * 2);
+  align_buffer_page_end(src_u, kSrcUVSize);
+  align_buffer_page_end(src_v, kSrcUVSize);
+  align_buffer_page_end(dst_y_nv12, kDstWidth * kDstHeight);
+  align_buffer_page_end(dst_uv_nv12, kDstUVSize * 2);
+  align_buffer_page_end(dst_y_i420, kDstWidth * kDstHeight);
+  align_buffer_page_end(dst_u_i420, kDstUVSize);
+  align_buffer_page_end(dst_v_i420, kDstUVSize);
+  align_buffer_page_end(dst_uv_i420, kDstUVSize * 2);
+  MemRandomize(src_y, kSrcWidth * kSrcHeight);
+  MemRandomize(src_uv, kSrcUVSize * 2);
+
+  EXPECT_EQ(0, NV12Scale(src_y, kSrcWidth, src_uv, kSrcHalfWidth * 2,
+                         kSrcWidth, kSrcHeight, dst_y_nv12, kDstWidth,
+                         dst_uv_nv12, kDstHalfWidth * 2, kDstWidth, kDstHeight,
+                         kFilterNone));
+
+  SplitUVPlane(src_uv, kSrcHalfWidth * 2, src_u, kSrcHalfWidth, src_v,
+               kSrcHalfWidth, kSrcHalfWidth, kSrcHalfHeight);
+  EXPECT_EQ(0, I420Scale(src_y, kSrcWidth, src_u, kSrcHalfWidth, src_v,
+                         kSrcHalfWidth, kSrcWidth, kSrcHeight, dst_y_i420,
+                         kDstWidth, dst_u_i420, kDstHalfWidth, dst_v_i420,
+                         kDstHalfWidth, kDstWidth, kDstHeight, kFilterNone));
+  MergeUVPlane(dst_u_i420, kDstHalfWidth, dst_v_i420, kDstHalfWidth,
+               dst_uv_i420, kDstHalfWidth * 2, kDstHalfWidth, kDstHalfHeight);
+
+  for (int i = 0; i < kDstWidth * kDstHeight; ++i) {
+    EXPECT_EQ(dst_y_i420[i], dst_y_nv12[i]);
+  }
+  for (int i = 0; i < kDstUVSize * 2; ++i) {
+    EXPECT_EQ(dst_uv_i420[i], dst_uv_nv12[i]);
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_y_nv12);
+  free_aligned_buffer_page_end(dst_uv_nv12);
+  free_aligned_buffer_page_end(dst_y_i420);
+  free_aligned_buffer_page_end(dst_u_i420);
+  free_aligned_buffer_page_end(dst_v_i420);
+  free_aligned_buffer_page_end(dst_uv_i420);
+}
+
+// A 2x box scale of P010 averages each 2x2 block of Y, U and V.
+TEST_F(LibYUVScaleTest, P010ScaleDownBy2_Box) {
+  const int kWidth = 64;
+  const int kHeight = 32;
+  align_buffer_page_end(src, kWidth * kHeight * 3);
+  align_buffer_page_end(dst, kWidth * kHeight * 3 / 4);
+  uint16_t* src_y = reinterpret_cast<uint16_t*>(src);
+  uint16_t* src_uv = src_y + kWidth * kHeight;
+  uint16_t* dst_y = reinterpret_cast<uint16_t*>(dst);
+  uint16_t* dst_uv = dst_y + kWidth * kHeight / 4;
+  for (int i = 0; i < kWidth * kHeight * 3 / 2; ++i) {
+    src_y[i] = static_cast<uint16_t>((fastrand() & 0x3ff) << 6);
+  }
+
+  EXPECT_EQ(0, P010Scale(src_y, kWidth, src_uv, kWidth, kWidth, kHeight, dst_y,
+                         kWidth / 2, dst_uv, kWidth / 2, kWidth / 2,
+                         kHeight / 2, kFilterBox));
+
+  for (int y = 0; y < kHeight / 4; ++y) {
+    for (int x = 0; x < kWidth / 2; ++x) {
+      const uint16_t* s = src_uv + y * 2 * kWidth + (x / 2) * 4 + (x & 1);
+      EXPECT_EQ((s[0] + s[2] + s[kWidth] + s[kWidth + 2] + 2) >> 2,
+                dst_uv[y * kWidth / 2 + x]);
+    }
+  }
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst);
+}
+
+}  // namespace libyuv
@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../unit_test/unit_test.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scratch.h"
+
+namespace libyuv {
+
+TEST_F(LibYUVBaseTest, ScratchAlloc) {
+  LibyuvScratch* scratch = CreateScratch(1100);
+  EXPECT_EQ(NULL, GetThreadScratch());
+  EXPECT_EQ(1152u, GetScratchSize(scratch));
+  EXPECT_EQ(0u, GetScratchPeak(scratch));
+
+  // Without an arena memory comes from malloc.
+  uint8_t* mem = static_cast<uint8_t*>(ScratchAlloc(100));
+  memset(mem, 0, 100);
+  ScratchFree(mem);
+
+  SetThreadScratch(scratch);
+  EXPECT_EQ(scratch, GetThreadScratch());
+  uint8_t* mem0 = static_cast<uint8_t*>(ScratchAlloc(100));
+  uint8_t* mem1 = static_cast<uint8_t*>(ScratchAlloc(900));
+  uint8_t* mem2 = static_cast<uint8_t*>(ScratchAlloc(100));
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mem0) & 63);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mem1) & 63);
+  EXPECT_EQ(mem0 + 128, mem1);
+  memset(mem0, 0, 100);
+  memset(mem1, 0, 900);
+  memset(mem2, 0, 100);  // Does not fit so comes from malloc.
+  EXPECT_EQ(128u + 960u + 128u, GetScratchPeak(scratch));
+  ScratchFree(mem0);
+  ScratchFree(mem2);
+  ScratchFree(mem1);
+
+  // The arena grows to the peak when no buffers are in use.
+  uint8_t* mem3 = static_cast<uint8_t*>(ScratchAlloc(100));
+  EXPECT_EQ(128u + 960u + 128u, GetScratchSize(scratch));
+  ScratchFree(mem3);
+  SetThreadScratch(NULL);
+  DestroyScratch(scratch);
+}
+
+// Freeing a buffer from before the arena was set does not stop the arena
+// from being reused and grown.
+TEST_F(LibYUVBaseTest, ScratchFreeBeforeArena) {
+  LibyuvScratch* scratch = CreateScratch(128);
+  uint8_t* mem = static_cast<uint8_t*>(ScratchAlloc(100));
+  SetThreadScratch(scratch);
+  ScratchFree(mem);
+
+  uint8_t* mem0 = static_cast<uint8_t*>(ScratchAlloc(100));
+  uint8_t* mem1 = static_cast<uint8_t*>(ScratchAlloc(100));  // From malloc.
+  memset(mem0, 0, 100);
+  memset(mem1, 0, 100);
+  ScratchFree(mem1);
+  ScratchFree(mem0);
+  EXPECT_EQ(256u, GetScratchPeak(scratch));
+
+  // The arena is empty, so it grows to the peak and is used from the start.
+  uint8_t* mem2 = static_cast<uint8_t*>(ScratchAlloc(100));
+  uint8_t* mem3 = static_cast<uint8_t*>(ScratchAlloc(100));
+  EXPECT_EQ(256u, GetScratchSize(scratch));
+  EXPECT_EQ(mem2 + 128, mem3);
+  ScratchFree(mem2);
+  ScratchFree(mem3);
+  uint8_t* mem4 = static_cast<uint8_t*>(ScratchAlloc(100));
+  EXPECT_EQ(mem2, mem4);
+  ScratchFree(mem4);
+  EXPECT_EQ(256u, GetScratchPeak(scratch));
+  SetThreadScratch(NULL);
+  DestroyScratch(scratch);
+}
+
+// Scaling with an arena matches scaling with malloc, and the arena grows to
+// fit the row buffers of the scaler.
+TEST_F(LibYUVBaseTest, ScratchScale) {
+  const int kSrcWidth = 320;
+  const int kSrcHeight = 180;
+  const int kDstWidth = 100;
+  const int kDstHeight = 60;
+  align_buffer_page_end(src_argb, kSrcWidth * kSrcHeight * 4);
+  align_buffer_page_end(dst_argb_c, kDstWidth * kDstHeight * 4);
+  align_buffer_page_end(dst_argb_opt, kDstWidth * kDstHeight * 4);
+  MemRandomize(src_argb, kSrcWidth * kSrcHeight * 4);
+  memset(dst_argb_c, 1, kDstWidth * kDstHeight * 4);
+  memset(dst_argb_opt, 2, kDstWidth * kDstHeight * 4);
+
+  ARGBScale(src_argb, kSrcWidth * 4, kSrcWidth, kSrcHeight, dst_argb_c,
+            kDstWidth * 4, kDstWidth, kDstHeight, kFilterBox);
+
+  LibyuvScratch* scratch = CreateScratch(0);
+  SetThreadScratch(scratch);
+  for (int i = 0; i < 2; ++i) {
+    ARGBScale(src_argb, kSrcWidth * 4, kSrcWidth, kSrcHeight, dst_argb_opt,
+              kDstWidth * 4, kDstWidth, kDstHeight, kFilterBox);
+  }
+  SetThreadScratch(NULL);
+  EXPECT_LT(0u, GetScratchPeak(scratch));
+  EXPECT_EQ(GetScratchPeak(scratch), GetScratchSize(scratch));
+  DestroyScratch(scratch);
+
+  for (int i = 0; i < kDstWidth * kDstHeight * 4; ++i) {
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);
+  }
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+}
+
+// Time many small conversions with and without an arena.
+static double TestScratchThumbnails(LibyuvScratch* scratch,
+                                    int benchmark_iterations) {
+  const int kSrcWidth = 160;
+  const int kSrcHeight = 120;
+  const int kDstWidth = 96;
+  const int kDstHeight = 72;
+  const int kSrcHalfWidth = kSrcWidth / 2;
+  const int kSrcHalfHeight = kSrcHeight / 2;
+  const int kDstHalfWidth = kDstWidth / 2;
+  const int kDstHalfHeight = kDstHeight / 2;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight * 3 / 2);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight * 3 / 2);
+  uint8_t* src_u = src + kSrcWidth * kSrcHeight;
+  uint8_t* src_v = src_u + kSrcHalfWidth * kSrcHalfHeight;
+  uint8_t* dst_u = dst + kDstWidth * kDstHeight;
+  uint8_t* dst_v = dst_u + kDstHalfWidth * kDstHalfHeight;
+  MemRandomize(src, kSrcWidth * kSrcHeight * 3 / 2);
+
+  SetThreadScratch(scratch);
+  double time = get_time();
+  for (int i = 0; i < benchmark_iterations * 240; ++i) {
+    I420Scale(src, kSrcWidth, src_u, kSrcHalfWidth, src_v, kSrcHalfWidth,
+              kSrcWidth, kSrcHeight, dst, kDstWidth, dst_u, kDstHalfWidth,
+              dst_v, kDstHalfWidth, kDstWidth, kDstHeight, kFilterBox);
+  }
+  time = (get_time() - time) / benchmark_iterations;
+  SetThreadScratch(NULL);
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst);
+  return time;
+}
+
+TEST_F(LibYUVBaseTest, ScratchThumbnails) {
+  LibyuvScratch* scratch = CreateScratch(0);
+  double malloc_time = TestScratchThumbnails(NULL, benchmark_iterations_);
+  double scratch_time = TestScratchThumbnails(scratch, benchmark_iterations_);
+  printf("240 thumbnails %8d us malloc - %8d us scratch\n",
+         static_cast<int>(malloc_time * 1e6),
+         static_cast<int>(scratch_time * 1e6));
+  EXPECT_LT(0u, GetScratchSize(scratch));
+  DestroyScratch(scratch);
+}
+
+}  // namespace libyuv
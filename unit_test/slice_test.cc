@@ -0,0 +1,278 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../unit_test/unit_test.h"
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/scale.h"
+#include "libyuv/slice.h"
+#include "libyuv/video_common.h"
+
+namespace libyuv {
+
+// Source and destination images with up to 3 planes. Chroma planes are half
+// size, rounded up. ARGB is one plane 4 bytes per pixel.
+struct SliceImage {
+  uint8_t* mem;
+  uint8_t* plane[3];
+  int stride[3];
+  int rows[3];
+};
+
+static void AllocSliceImage(SliceImage* image,
+                            uint32_t fourcc,
+                            int width,
+                            int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  int size;
+  memset(image, 0, sizeof(*image));
+  image->rows[0] = height;
+  if (fourcc == FOURCC_ARGB) {
+    image->stride[0] = width * 4;
+  } else {
+    image->stride[0] = width;
+  }
+  if (fourcc == FOURCC_I420) {
+    image->stride[1] = image->stride[2] = halfwidth;
+    image->rows[1] = image->rows[2] = halfheight;
+  } else if (fourcc == FOURCC_NV12) {
+    image->stride[1] = halfwidth * 2;
+    image->rows[1] = halfheight;
+  }
+  size = image->stride[0] * image->rows[0] + image->stride[1] * image->rows[1] +
+         image->stride[2] * image->rows[2];
+  image->mem = static_cast<uint8_t*>(malloc(size));
+  image->plane[0] = image->mem;
+  image->plane[1] = image->plane[0] + image->stride[0] * image->rows[0];
+  image->plane[2] = image->plane[1] + image->stride[1] * image->rows[1];
+}
+
+// Convert or scale a whole frame with the full frame functions.
+static void ConvertFrame(const SliceImage& src,
+                         uint32_t src_fourcc,
+                         int src_width,
+                         int src_height,
+                         const SliceImage& dst,
+                         uint32_t dst_fourcc,
+                         int dst_width,
+                         int dst_height,
+                         FilterMode filtering) {
+  if (src_fourcc == FOURCC_I420 && dst_fourcc == FOURCC_ARGB) {
+    I420ToARGB(src.plane[0], src.stride[0], src.plane[1], src.stride[1],
+               src.plane[2], src.stride[2], dst.plane[0], dst.stride[0],
+               src_width, src_height);
+  } else if (src_fourcc == FOURCC_ARGB) {
+    ARGBToI420(src.plane[0], src.stride[0], dst.plane[0], dst.stride[0],
+               dst.plane[1], dst.stride[1], dst.plane[2], dst.stride[2],
+               src_width, src_height);
+  } else if (src_fourcc == FOURCC_NV12) {
+    NV12ToI420(src.plane[0], src.stride[0], src.plane[1], src.stride[1],
+               dst.plane[0], dst.stride[0], dst.plane[1], dst.stride[1],
+               dst.plane[2], dst.stride[2], src_width, src_height);
+  } else if (src_fourcc == FOURCC_I420) {
+    I420Scale(src.plane[0], src.stride[0], src.plane[1], src.stride[1],
+              src.plane[2], src.stride[2], src_width, src_height, dst.plane[0],
+              dst.stride[0], dst.plane[1], dst.stride[1], dst.plane[2],
+              dst.stride[2], dst_width, dst_height, filtering);
+  } else {
+    ScalePlane(src.plane[0], src.stride[0], src_width, src_height,
+               dst.plane[0], dst.stride[0], dst_width, dst_height, filtering);
+  }
+}
+
+// Push a frame in slices of the given heights, cycling through them, from a
+// slice buffer that is overwritten after each push. After each push the rows
+// reported as written must match the full frame conversion.
+static void TestSlices(uint32_t src_fourcc,
+                       uint32_t dst_fourcc,
+                       int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       FilterMode filtering,
+                       const int* slice_rows,
+                       int num_slice_rows) {
+  const int src_abs_width = abs(src_width);
+  SliceImage src, dst, ref, slice;
+  AllocSliceImage(&src, src_fourcc, src_abs_width, src_height);
+  AllocSliceImage(&dst, dst_fourcc, dst_width, dst_height);
+  AllocSliceImage(&ref, dst_fourcc, dst_width, dst_height);
+  AllocSliceImage(&slice, src_fourcc, src_abs_width, src_height);
+  const int dst_uv_height = (dst_height + 1) / 2;
+  const int dst_size = dst.stride[0] * dst_height +
+                       (dst.stride[1] + dst.stride[2]) * dst_uv_height;
+  MemRandomize(src.mem, src.stride[0] * src.rows[0] +
+                            src.stride[1] * src.rows[1] +
+                            src.stride[2] * src.rows[2]);
+  memset(dst.mem, 1, dst_size);
+  memset(ref.mem, 2, dst_size);
+  ConvertFrame(src, src_fourcc, src_width, src_height, ref, dst_fourcc,
+               dst_width, dst_height, filtering);
+
+  SliceConverter* converter =
+      CreateSliceConverter(src_fourcc, dst_fourcc, src_width, src_height,
+                           dst_width, dst_height, filtering);
+  ASSERT_TRUE(converter != NULL);
+  // A converter converts any number of frames.
+  for (int frame = 0; frame < 2; ++frame) {
+    EXPECT_EQ(0, SliceConverterBegin(converter, dst.plane[0], dst.stride[0],
+                                     dst.plane[1], dst.stride[1],
+                                     dst.plane[2], dst.stride[2]));
+    int y = 0;
+    int written = 0;
+    for (int i = 0; y < src_height; ++i) {
+      int rows = slice_rows[i % num_slice_rows];
+      if (rows > src_height - y) {
+        rows = src_height - y;
+      }
+      const int uv_begin = (y + 1) / 2;
+      const int uv_rows = (y + rows + 1) / 2 - uv_begin;
+      // Copy the slice to the start of the slice buffer.
+      for (int p = 0; p < 3; ++p) {
+        const int begin = p == 0 ? y : uv_begin;
+        const int count = p == 0 ? rows : uv_rows;
+        if (src.stride[p] && count) {
+          memcpy(slice.plane[p], src.plane[p] + begin * src.stride[p],
+                 count * src.stride[p]);
+        }
+      }
+      int n = SliceConverterPushRows(converter, slice.plane[0],
+                                     slice.stride[0], slice.plane[1],
+                                     slice.stride[1], slice.plane[2],
+                                     slice.stride[2], rows);
+      MemRandomize(slice.mem, slice.stride[0] * slice.rows[0]);
+      y += rows;
+      ASSERT_GE(n, written);
+      written = n;
+      EXPECT_EQ(0, memcmp(ref.plane[0], dst.plane[0], n * dst.stride[0]))
+          << "row " << y;
+      for (int p = 1; p < 3; ++p) {
+        EXPECT_EQ(0, memcmp(ref.plane[p], dst.plane[p],
+                            (n + 1) / 2 * dst.stride[p]))
+            << "row " << y;
+      }
+    }
+    EXPECT_EQ(dst_height, written);
+    EXPECT_EQ(0, SliceConverterEnd(converter));
+    EXPECT_EQ(0, memcmp(ref.mem, dst.mem, dst_size));
+    memset(dst.mem, 3, dst_size);
+  }
+  DestroySliceConverter(converter);
+  free(slice.mem);
+  free(ref.mem);
+  free(dst.mem);
+  free(src.mem);
+}
+
+static const int kSlice16[] = {16};
+static const int kSliceOdd[] = {1, 2, 7, 3, 16, 5};
+
+TEST_F(LibYUVConvertTest, Slice_I420ToARGB) {
+  TestSlices(FOURCC_I420, FOURCC_ARGB, 640, 360, 640, 360, kFilterNone,
+             kSlice16, 1);
+  TestSlices(FOURCC_I420, FOURCC_ARGB, 33, 17, 33, 17, kFilterNone,
+             kSliceOdd, 6);
+}
+
+TEST_F(LibYUVConvertTest, Slice_ARGBToI420) {
+  TestSlices(FOURCC_ARGB, FOURCC_I420, 640, 360, 640, 360, kFilterNone,
+             kSlice16, 1);
+  TestSlices(FOURCC_ARGB, FOURCC_I420, 33, 17, 33, 17, kFilterNone,
+             kSliceOdd, 6);
+}
+
+TEST_F(LibYUVConvertTest, Slice_NV12ToI420) {
+  TestSlices(FOURCC_NV12, FOURCC_I420, 640, 360, 640, 360, kFilterNone,
+             kSlice16, 1);
+  TestSlices(FOURCC_NV12, FOURCC_I420, 33, 17, 33, 17, kFilterNone,
+             kSliceOdd, 6);
+}
+
+TEST_F(LibYUVScaleTest, Slice_I420Scale) {
+  static const FilterMode kFilters[] = {kFilterNone, kFilterLinear,
+                                        kFilterBilinear, kFilterBox,
+                                        kFilterLanczos};
+  // Sizes cover the copy, vertical, 3/4, 1/2, 3/8, 1/4, up and down
+  // scalers and mirroring.
+  static const int kSizes[][4] = {
+      {64, 48, 64, 48},  {64, 48, 64, 30},   {64, 48, 48, 36},
+      {64, 48, 32, 24},  {64, 48, 24, 18},   {64, 48, 16, 12},
+      {33, 17, 80, 41},  {127, 63, 40, 20},  {-64, 48, 50, 20},
+      {320, 180, 83, 45}, {320, 180, 20, 11}};
+  for (size_t i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); ++i) {
+    for (size_t f = 0; f < sizeof(kFilters) / sizeof(kFilters[0]); ++f) {
+      // The box scaler does not mirror.
+      if (kSizes[i][0] < 0 && kFilters[f] == kFilterBox) {
+        continue;
+      }
+      TestSlices(FOURCC_I420, FOURCC_I420, kSizes[i][0], kSizes[i][1],
+                 kSizes[i][2], kSizes[i][3], kFilters[f], kSliceOdd, 6);
+      TestSlices(FOURCC_I400, FOURCC_I400, kSizes[i][0], kSizes[i][1],
+                 kSizes[i][2], kSizes[i][3], kFilters[f], kSlice16, 1);
+    }
+  }
+}
+
+// Rows are written before the whole frame has arrived.
+TEST_F(LibYUVScaleTest, Slice_Latency) {
+  align_buffer_page_end(src, 640 * 480);
+  align_buffer_page_end(dst, 320 * 240);
+  MemRandomize(src, 640 * 480);
+  SliceConverter* converter = CreateSliceConverter(
+      FOURCC_I400, FOURCC_I400, 640, 480, 320, 240, kFilterLanczos);
+  ASSERT_TRUE(converter != NULL);
+  EXPECT_EQ(0, SliceConverterBegin(converter, dst, 320, NULL, 0, NULL, 0));
+  // 3 lobes at 2x down read 12 rows, from 5 rows above the first source row
+  // of a destination row.
+  EXPECT_EQ(0, SliceConverterPushRows(converter, src, 640, NULL, 0, NULL, 0,
+                                      4));
+  EXPECT_EQ(5, SliceConverterPushRows(converter, src + 4 * 640, 640, NULL, 0,
+                                      NULL, 0, 12));
+  EXPECT_EQ(-1, SliceConverterEnd(converter));
+  DestroySliceConverter(converter);
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVConvertTest, Slice_Invalid) {
+  uint8_t src[16 * 16 * 4] = {0};
+  uint8_t dst[16 * 16 * 4];
+  EXPECT_TRUE(NULL == CreateSliceConverter(FOURCC_I420, FOURCC_ARGB, 16, 16,
+                                           8, 8, kFilterBox));
+  EXPECT_TRUE(NULL == CreateSliceConverter(FOURCC_YUY2, FOURCC_I420, 16, 16,
+                                           16, 16, kFilterBox));
+  EXPECT_TRUE(NULL == CreateSliceConverter(FOURCC_ARGB, FOURCC_ARGB, 16, 16,
+                                           8, 8, kFilterBox));
+  EXPECT_TRUE(NULL == CreateSliceConverter(FOURCC_I420, FOURCC_I420, 16, -16,
+                                           8, 8, kFilterBox));
+  SliceConverter* converter = CreateSliceConverter(
+      FOURCC_I420, FOURCC_ARGB, 16, 16, 16, 16, kFilterNone);
+  ASSERT_TRUE(converter != NULL);
+  // Rows must be pushed between Begin and End.
+  EXPECT_EQ(-1, SliceConverterPushRows(converter, src, 16, src + 256, 8,
+                                       src + 320, 8, 16));
+  EXPECT_EQ(0, SliceConverterBegin(converter, dst, 64, NULL, 0, NULL, 0));
+  EXPECT_EQ(-1, SliceConverterPushRows(converter, src, 16, NULL, 8, src + 320,
+                                       8, 16));
+  EXPECT_EQ(-1, SliceConverterPushRows(converter, src, 16, src + 256, 8,
+                                       src + 320, 8, 17));
+  EXPECT_EQ(16, SliceConverterPushRows(converter, src, 16, src + 256, 8,
+                                       src + 320, 8, 16));
+  EXPECT_EQ(0, SliceConverterEnd(converter));
+  EXPECT_EQ(-1, SliceConverterEnd(converter));
+  DestroySliceConverter(converter);
+  DestroySliceConverter(NULL);
+}
+
+}  // namespace libyuv
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../unit_test/unit_test.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/scale.h"
+#include "libyuv/stats.h"
+
+namespace libyuv {
+
+static const LibyuvStat* FindStat(const LibyuvStat* stats,
+                                  int num_stats,
+                                  const char* name,
+                                  const char* kernel) {
+  int i;
+  for (i = 0; i < num_stats; ++i) {
+    if (strcmp(stats[i].name, name) == 0 &&
+        (kernel ? stats[i].kernel && strcmp(stats[i].kernel, kernel) == 0
+                : !stats[i].kernel)) {
+      return &stats[i];
+    }
+  }
+  return NULL;
+}
+
+// Bilinear scaling with the C row functions is attributed to ScalePlane and
+// to the C versions of InterpolateRow and ScaleFilterCols.
+TEST_F(LibYUVBaseTest, StatsScalePlane) {
+  const int kSrcWidth = 640;
+  const int kSrcHeight = 360;
+  const int kDstWidth = 500;
+  const int kDstHeight = 280;
+  LibyuvStat stats[64];
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight);
+  memset(src, 0, kSrcWidth * kSrcHeight);
+
+  LibyuvResetStats();
+  EXPECT_EQ(0, LibyuvGetStats(NULL, 0));
+  MaskCpuFlags(1);  // C only.
+  ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight, dst, kDstWidth, kDstWidth,
+             kDstHeight, kFilterBilinear);
+  MaskCpuFlags(benchmark_cpu_info_);
+  int num_stats = LibyuvGetStats(stats, 64);
+
+  if (!LibyuvStatsEnabled()) {
+    EXPECT_EQ(0, num_stats);
+  } else {
+    ASSERT_LE(num_stats, 64);
+    const LibyuvStat* scale = FindStat(stats, num_stats, "ScalePlane", NULL);
+    ASSERT_TRUE(scale != NULL);
+    EXPECT_EQ(1u, scale->calls);
+    EXPECT_EQ(static_cast<uint64_t>(kDstWidth * kDstHeight), scale->pixels);
+
+    const LibyuvStat* cols = FindStat(stats, num_stats, "ScaleFilterCols",
+                                      "ScaleFilterCols_C");
+    ASSERT_TRUE(cols != NULL);
+    EXPECT_EQ(static_cast<uint64_t>(kDstHeight), cols->calls);
+    EXPECT_EQ(static_cast<uint64_t>(kDstWidth * kDstHeight), cols->pixels);
+
+    const LibyuvStat* interpolate =
+        FindStat(stats, num_stats, "InterpolateRow", "InterpolateRow_C");
+    ASSERT_TRUE(interpolate != NULL);
+    EXPECT_EQ(static_cast<uint64_t>(kDstHeight), interpolate->calls);
+    EXPECT_EQ(static_cast<uint64_t>(kSrcWidth * kDstHeight),
+              interpolate->pixels);
+
+    // Only the counters that were called are returned.
+    EXPECT_EQ(3, num_stats);
+    EXPECT_EQ(3, LibyuvGetStats(stats, 1));
+  }
+
+  LibyuvResetStats();
+  EXPECT_EQ(0, LibyuvGetStats(stats, 64));
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst);
+}
+
+}  // namespace libyuv
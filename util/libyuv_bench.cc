@@ -0,0 +1,1069 @@
+/*
+ *  Copyright 2020 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Micro benchmark of the libyuv row kernels and the public functions built
+// on them. Each row kernel is timed directly for every instruction set it
+// is built for and the cpu supports. Public functions are timed at each
+// instruction set level selected with MaskCpuFlags.
+// Throughput is reported in bytes (read + written) per cycle and GB/s.
+// When libyuv is built with LIBYUV_STATS, the row functions each public
+// function chose are listed below it, ie to spot a fallback to C.
+//
+// Usage: libyuv_bench [-w width] [-s width height] [-i iterations]
+//                     [-f filter] [-json file]
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HAVE_RDTSC
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/rotate.h"
+#include "libyuv/rotate_row.h"
+#include "libyuv/row.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scale_row.h"
+#include "libyuv/stats.h"
+#include "libyuv/version.h"
+
+// options
+int row_width = 1920;  // width of the row kernels, in units of the kernel.
+int image_width = 1280, image_height = 720;  // frame size of the functions.
+int iterations = 0;  // 0 = pick per benchmark.
+double ghz = 0.;     // cycles per ns when there is no cycle counter.
+const char* filter = NULL;
+const char* json_name = NULL;
+
+typedef void (*KernelFunc)();
+
+// Calling conventions of the row kernels.
+enum KernelKind {
+  kKindRow,          // f(src, dst, width)
+  kKindAddRow,       // f(src, uint16_t* dst, width)
+  kKindYuvRow,       // f(y, u, v, dst, yuvconstants, width)
+  kKindNVRow,        // f(y, uv, dst, yuvconstants, width)
+  kKindUVRow,        // f(src, src_stride, dst_u, dst_v, width)
+  kKindInterpolate,  // f(dst, src, src_stride, width, fraction)
+  kKindScaleDown,    // f(src, src_stride, dst, dst_width)
+  kKindScaleCols,    // f(dst, src, dst_width, x, dx)
+  kKindPolyRows,     // f(src, src_stride, filter, taps, dst, dst_width)
+  kKindPolyCols,     // f(dst, src, dst_width, offsets, filter, taps)
+  kKindTranspose,    // f(src, src_stride, dst, dst_stride, width)
+  kKindTransposeUV,  // f(src, src_stride, dst_a, stride_a, dst_b, stride_b, w)
+};
+
+struct Kernel {
+  const char* name;
+  const char* isa;
+  int cpu_flag;  // 0 for C.
+  KernelKind kind;
+  KernelFunc func;
+  double src_bytes;  // Bytes read per unit of width.
+  double dst_bytes;  // Bytes written per unit of width.
+  int param;         // dx of column scalers, taps or rows of transposes.
+};
+
+#define KERNEL(kind, name, isa, flag, src_bytes, dst_bytes, param)      \
+  {                                                                     \
+    #name, #isa, flag, kind,                                            \
+        reinterpret_cast<KernelFunc>(libyuv::name##_##isa), src_bytes, \
+        dst_bytes, param                                                \
+  }
+
+// Every kernel is listed with its C version first, followed by the versions
+// enabled by the HAS_ macros of this build. To add a kernel, add a line for
+// each of its versions.
+static const Kernel kKernels[] = {
+    // row.h
+    KERNEL(kKindRow, CopyRow, C, 0, 1, 1, 0),
+#if defined(HAS_COPYROW_SSE2)
+    KERNEL(kKindRow, CopyRow, SSE2, libyuv::kCpuHasSSE2, 1, 1, 0),
+#endif
+#if defined(HAS_COPYROW_AVX)
+    KERNEL(kKindRow, CopyRow, AVX, libyuv::kCpuHasAVX, 1, 1, 0),
+#endif
+#if defined(HAS_COPYROW_ERMS)
+    KERNEL(kKindRow, CopyRow, ERMS, libyuv::kCpuHasERMS, 1, 1, 0),
+#endif
+#if defined(HAS_COPYROW_AVX512BW)
+    KERNEL(kKindRow, CopyRow, AVX512BW, libyuv::kCpuHasAVX512BW, 1, 1, 0),
+#endif
+#if defined(HAS_COPYROW_NEON)
+    KERNEL(kKindRow, CopyRow, NEON, libyuv::kCpuHasNEON, 1, 1, 0),
+#endif
+    KERNEL(kKindRow, MirrorRow, C, 0, 1, 1, 0),
+#if defined(HAS_MIRRORROW_SSSE3)
+    KERNEL(kKindRow, MirrorRow, SSSE3, libyuv::kCpuHasSSSE3, 1, 1, 0),
+#endif
+#if defined(HAS_MIRRORROW_AVX2)
+    KERNEL(kKindRow, MirrorRow, AVX2, libyuv::kCpuHasAVX2, 1, 1, 0),
+#endif
+#if defined(HAS_MIRRORROW_NEON)
+    KERNEL(kKindRow, MirrorRow, NEON, libyuv::kCpuHasNEON, 1, 1, 0),
+#endif
+    KERNEL(kKindRow, ARGBMirrorRow, C, 0, 4, 4, 0),
+#if defined(HAS_ARGBMIRRORROW_SSE2)
+    KERNEL(kKindRow, ARGBMirrorRow, SSE2, libyuv::kCpuHasSSE2, 4, 4, 0),
+#endif
+#if defined(HAS_ARGBMIRRORROW_AVX2)
+    KERNEL(kKindRow, ARGBMirrorRow, AVX2, libyuv::kCpuHasAVX2, 4, 4, 0),
+#endif
+#if defined(HAS_ARGBMIRRORROW_NEON)
+    KERNEL(kKindRow, ARGBMirrorRow, NEON, libyuv::kCpuHasNEON, 4, 4, 0),
+#endif
+    KERNEL(kKindRow, ARGBToYRow, C, 0, 4, 1, 0),
+#if defined(HAS_ARGBTOYROW_SSSE3)
+    KERNEL(kKindRow, ARGBToYRow, SSSE3, libyuv::kCpuHasSSSE3, 4, 1, 0),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2)
+    KERNEL(kKindRow, ARGBToYRow, AVX2, libyuv::kCpuHasAVX2, 4, 1, 0),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW)
+    KERNEL(kKindRow, ARGBToYRow, AVX512BW, libyuv::kCpuHasAVX512BW, 4, 1, 0),
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+    KERNEL(kKindRow, ARGBToYRow, NEON, libyuv::kCpuHasNEON, 4, 1, 0),
+#endif
+    KERNEL(kKindUVRow, ARGBToUVRow, C, 0, 8, 1, 0),
+#if defined(HAS_ARGBTOUVROW_SSSE3)
+    KERNEL(kKindUVRow, ARGBToUVRow, SSSE3, libyuv::kCpuHasSSSE3, 8, 1, 0),
+#endif
+#if defined(HAS_ARGBTOUVROW_AVX2)
+    KERNEL(kKindUVRow, ARGBToUVRow, AVX2, libyuv::kCpuHasAVX2, 8, 1, 0),
+#endif
+#if defined(HAS_ARGBTOUVROW_AVX512BW)
+    KERNEL(kKindUVRow,
+           ARGBToUVRow,
+           AVX512BW,
+           libyuv::kCpuHasAVX512BW,
+           8,
+           1,
+           0),
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+    KERNEL(kKindUVRow, ARGBToUVRow, NEON, libyuv::kCpuHasNEON, 8, 1, 0),
+#endif
+    KERNEL(kKindYuvRow, I422ToARGBRow, C, 0, 2, 4, 0),
+#if defined(HAS_I422TOARGBROW_SSSE3)
+    KERNEL(kKindYuvRow, I422ToARGBRow, SSSE3, libyuv::kCpuHasSSSE3, 2, 4, 0),
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+    KERNEL(kKindYuvRow, I422ToARGBRow, AVX2, libyuv::kCpuHasAVX2, 2, 4, 0),
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+    KERNEL(kKindYuvRow,
+           I422ToARGBRow,
+           AVX512BW,
+           libyuv::kCpuHasAVX512BW,
+           2,
+           4,
+           0),
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+    KERNEL(kKindYuvRow, I422ToARGBRow, NEON, libyuv::kCpuHasNEON, 2, 4, 0),
+#endif
+    KERNEL(kKindNVRow, NV12ToARGBRow, C, 0, 2, 4, 0),
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+    KERNEL(kKindNVRow, NV12ToARGBRow, SSSE3, libyuv::kCpuHasSSSE3, 2, 4, 0),
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+    KERNEL(kKindNVRow, NV12ToARGBRow, AVX2, libyuv::kCpuHasAVX2, 2, 4, 0),
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+    KERNEL(kKindNVRow,
+           NV12ToARGBRow,
+           AVX512BW,
+           libyuv::kCpuHasAVX512BW,
+           2,
+           4,
+           0),
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+    KERNEL(kKindNVRow, NV12ToARGBRow, NEON, libyuv::kCpuHasNEON, 2, 4, 0),
+#endif
+    KERNEL(kKindRow, ARGBToRGB24Row, C, 0, 4, 3, 0),
+#if defined(HAS_ARGBTORGB24ROW_SSSE3)
+    KERNEL(kKindRow, ARGBToRGB24Row, SSSE3, libyuv::kCpuHasSSSE3, 4, 3, 0),
+#endif
+#if defined(HAS_ARGBTORGB24ROW_AVX2)
+    KERNEL(kKindRow, ARGBToRGB24Row, AVX2, libyuv::kCpuHasAVX2, 4, 3, 0),
+#endif
+#if defined(HAS_ARGBTORGB24ROW_AVX512VBMI)
+    KERNEL(kKindRow,
+           ARGBToRGB24Row,
+           AVX512VBMI,
+           libyuv::kCpuHasAVX512VBMI,
+           4,
+           3,
+           0),
+#endif
+#if defined(HAS_ARGBTORGB24ROW_NEON)
+    KERNEL(kKindRow, ARGBToRGB24Row, NEON, libyuv::kCpuHasNEON, 4, 3, 0),
+#endif
+    KERNEL(kKindRow, RGB24ToARGBRow, C, 0, 3, 4, 0),
+#if defined(HAS_RGB24TOARGBROW_SSSE3)
+    KERNEL(kKindRow, RGB24ToARGBRow, SSSE3, libyuv::kCpuHasSSSE3, 3, 4, 0),
+#endif
+#if defined(HAS_RGB24TOARGBROW_NEON)
+    KERNEL(kKindRow, RGB24ToARGBRow, NEON, libyuv::kCpuHasNEON, 3, 4, 0),
+#endif
+    KERNEL(kKindRow, ARGBToRGB565Row, C, 0, 4, 2, 0),
+#if defined(HAS_ARGBTORGB565ROW_SSE2)
+    KERNEL(kKindRow, ARGBToRGB565Row, SSE2, libyuv::kCpuHasSSE2, 4, 2, 0),
+#endif
+#if defined(HAS_ARGBTORGB565ROW_AVX2)
+    KERNEL(kKindRow, ARGBToRGB565Row, AVX2, libyuv::kCpuHasAVX2, 4, 2, 0),
+#endif
+#if defined(HAS_ARGBTORGB565ROW_NEON)
+    KERNEL(kKindRow, ARGBToRGB565Row, NEON, libyuv::kCpuHasNEON, 4, 2, 0),
+#endif
+    KERNEL(kKindRow, J400ToARGBRow, C, 0, 1, 4, 0),
+#if defined(HAS_J400TOARGBROW_SSE2)
+    KERNEL(kKindRow, J400ToARGBRow, SSE2, libyuv::kCpuHasSSE2, 1, 4, 0),
+#endif
+#if defined(HAS_J400TOARGBROW_AVX2)
+    KERNEL(kKindRow, J400ToARGBRow, AVX2, libyuv::kCpuHasAVX2, 1, 4, 0),
+#endif
+#if defined(HAS_J400TOARGBROW_NEON)
+    KERNEL(kKindRow, J400ToARGBRow, NEON, libyuv::kCpuHasNEON, 1, 4, 0),
+#endif
+    KERNEL(kKindRow, YUY2ToYRow, C, 0, 2, 1, 0),
+#if defined(HAS_YUY2TOYROW_SSE2)
+    KERNEL(kKindRow, YUY2ToYRow, SSE2, libyuv::kCpuHasSSE2, 2, 1, 0),
+#endif
+#if defined(HAS_YUY2TOYROW_AVX2)
+    KERNEL(kKindRow, YUY2ToYRow, AVX2, libyuv::kCpuHasAVX2, 2, 1, 0),
+#endif
+#if defined(HAS_YUY2TOYROW_NEON)
+    KERNEL(kKindRow, YUY2ToYRow, NEON, libyuv::kCpuHasNEON, 2, 1, 0),
+#endif
+    KERNEL(kKindRow, ARGBAttenuateRow, C, 0, 4, 4, 0),
+#if defined(HAS_ARGBATTENUATEROW_SSSE3)
+    KERNEL(kKindRow, ARGBAttenuateRow, SSSE3, libyuv::kCpuHasSSSE3, 4, 4, 0),
+#endif
+#if defined(HAS_ARGBATTENUATEROW_AVX2)
+    KERNEL(kKindRow, ARGBAttenuateRow, AVX2, libyuv::kCpuHasAVX2, 4, 4, 0),
+#endif
+#if defined(HAS_ARGBATTENUATEROW_NEON)
+    KERNEL(kKindRow, ARGBAttenuateRow, NEON, libyuv::kCpuHasNEON, 4, 4, 0),
+#endif
+    KERNEL(kKindRow, ARGBGrayRow, C, 0, 4, 4, 0),
+#if defined(HAS_ARGBGRAYROW_SSSE3)
+    KERNEL(kKindRow, ARGBGrayRow, SSSE3, libyuv::kCpuHasSSSE3, 4, 4, 0),
+#endif
+#if defined(HAS_ARGBGRAYROW_NEON)
+    KERNEL(kKindRow, ARGBGrayRow, NEON, libyuv::kCpuHasNEON, 4, 4, 0),
+#endif
+    KERNEL(kKindInterpolate, InterpolateRow, C, 0, 2, 1, 0),
+#if defined(HAS_INTERPOLATEROW_SSSE3)
+    KERNEL(kKindInterpolate,
+           InterpolateRow,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           2,
+           1,
+           0),
+#endif
+#if defined(HAS_INTERPOLATEROW_AVX2)
+    KERNEL(kKindInterpolate, InterpolateRow, AVX2, libyuv::kCpuHasAVX2, 2, 1, 0),
+#endif
+#if defined(HAS_INTERPOLATEROW_NEON)
+    KERNEL(kKindInterpolate, InterpolateRow, NEON, libyuv::kCpuHasNEON, 2, 1, 0),
+#endif
+
+    // scale_row.h
+    KERNEL(kKindScaleDown, ScaleRowDown2, C, 0, 2, 1, 0),
+    KERNEL(kKindScaleDown, ScaleRowDown2Linear, C, 0, 2, 1, 0),
+    KERNEL(kKindScaleDown, ScaleRowDown2Box, C, 0, 4, 1, 0),
+#if defined(HAS_SCALEROWDOWN2_SSSE3)
+    KERNEL(kKindScaleDown, ScaleRowDown2, SSSE3, libyuv::kCpuHasSSSE3, 2, 1, 0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2Linear,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           2,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2Box,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           4,
+           1,
+           0),
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX2)
+    KERNEL(kKindScaleDown, ScaleRowDown2, AVX2, libyuv::kCpuHasAVX2, 2, 1, 0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2Linear,
+           AVX2,
+           libyuv::kCpuHasAVX2,
+           2,
+           1,
+           0),
+    KERNEL(kKindScaleDown, ScaleRowDown2Box, AVX2, libyuv::kCpuHasAVX2, 4, 1, 0),
+#endif
+#if defined(HAS_SCALEROWDOWN2_AVX512BW)
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2,
+           AVX512BW,
+           libyuv::kCpuHasAVX512BW,
+           2,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2Linear,
+           AVX512BW,
+           libyuv::kCpuHasAVX512BW,
+           2,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2Box,
+           AVX512BW,
+           libyuv::kCpuHasAVX512BW,
+           4,
+           1,
+           0),
+#endif
+#if defined(HAS_SCALEROWDOWN2_NEON)
+    KERNEL(kKindScaleDown, ScaleRowDown2, NEON, libyuv::kCpuHasNEON, 2, 1, 0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown2Linear,
+           NEON,
+           libyuv::kCpuHasNEON,
+           2,
+           1,
+           0),
+    KERNEL(kKindScaleDown, ScaleRowDown2Box, NEON, libyuv::kCpuHasNEON, 4, 1, 0),
+#endif
+    KERNEL(kKindScaleDown, ScaleRowDown4, C, 0, 4, 1, 0),
+    KERNEL(kKindScaleDown, ScaleRowDown4Box, C, 0, 16, 1, 0),
+#if defined(HAS_SCALEROWDOWN4_SSSE3)
+    KERNEL(kKindScaleDown, ScaleRowDown4, SSSE3, libyuv::kCpuHasSSSE3, 4, 1, 0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown4Box,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           16,
+           1,
+           0),
+#endif
+#if defined(HAS_SCALEROWDOWN4_AVX2)
+    KERNEL(kKindScaleDown, ScaleRowDown4, AVX2, libyuv::kCpuHasAVX2, 4, 1, 0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown4Box,
+           AVX2,
+           libyuv::kCpuHasAVX2,
+           16,
+           1,
+           0),
+#endif
+#if defined(HAS_SCALEROWDOWN4_NEON)
+    KERNEL(kKindScaleDown, ScaleRowDown4, NEON, libyuv::kCpuHasNEON, 4, 1, 0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown4Box,
+           NEON,
+           libyuv::kCpuHasNEON,
+           16,
+           1,
+           0),
+#endif
+    KERNEL(kKindScaleDown, ScaleRowDown34, C, 0, 4. / 3, 1, 0),
+    KERNEL(kKindScaleDown, ScaleRowDown34_0_Box, C, 0, 8. / 3, 1, 0),
+#if defined(HAS_SCALEROWDOWN34_SSSE3)
+    KERNEL(kKindScaleDown,
+           ScaleRowDown34,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           4. / 3,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown34_0_Box,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           8. / 3,
+           1,
+           0),
+#endif
+#if defined(HAS_SCALEROWDOWN34_NEON)
+    KERNEL(kKindScaleDown,
+           ScaleRowDown34,
+           NEON,
+           libyuv::kCpuHasNEON,
+           4. / 3,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown34_0_Box,
+           NEON,
+           libyuv::kCpuHasNEON,
+           8. / 3,
+           1,
+           0),
+#endif
+    KERNEL(kKindScaleDown, ScaleRowDown38, C, 0, 8. / 3, 1, 0),
+    KERNEL(kKindScaleDown, ScaleRowDown38_3_Box, C, 0, 8, 1, 0),
+#if defined(HAS_SCALEROWDOWN38_SSSE3)
+    KERNEL(kKindScaleDown,
+           ScaleRowDown38,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           8. / 3,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown38_3_Box,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           8,
+           1,
+           0),
+#endif
+#if defined(HAS_SCALEROWDOWN38_NEON)
+    KERNEL(kKindScaleDown,
+           ScaleRowDown38,
+           NEON,
+           libyuv::kCpuHasNEON,
+           8. / 3,
+           1,
+           0),
+    KERNEL(kKindScaleDown,
+           ScaleRowDown38_3_Box,
+           NEON,
+           libyuv::kCpuHasNEON,
+           8,
+           1,
+           0),
+#endif
+    KERNEL(kKindAddRow, ScaleAddRow, C, 0, 1, 2, 0),
+#if defined(HAS_SCALEADDROW_SSE2)
+    KERNEL(kKindAddRow, ScaleAddRow, SSE2, libyuv::kCpuHasSSE2, 1, 2, 0),
+#endif
+#if defined(HAS_SCALEADDROW_AVX2)
+    KERNEL(kKindAddRow, ScaleAddRow, AVX2, libyuv::kCpuHasAVX2, 1, 2, 0),
+#endif
+#if defined(HAS_SCALEADDROW_NEON)
+    KERNEL(kKindAddRow, ScaleAddRow, NEON, libyuv::kCpuHasNEON, 1, 2, 0),
+#endif
+    KERNEL(kKindScaleCols, ScaleFilterCols, C, 0, 1.5, 1, 0x18000),
+#if defined(HAS_SCALEFILTERCOLS_SSSE3)
+    KERNEL(kKindScaleCols,
+           ScaleFilterCols,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           1.5,
+           1,
+           0x18000),
+#endif
+#if defined(HAS_SCALEFILTERCOLS_NEON)
+    KERNEL(kKindScaleCols,
+           ScaleFilterCols,
+           NEON,
+           libyuv::kCpuHasNEON,
+           1.5,
+           1,
+           0x18000),
+#endif
+    KERNEL(kKindScaleCols, ScaleColsUp2, C, 0, 0.5, 1, 0x8000),
+#if defined(HAS_SCALECOLSUP2_SSE2)
+    KERNEL(kKindScaleCols,
+           ScaleColsUp2,
+           SSE2,
+           libyuv::kCpuHasSSE2,
+           0.5,
+           1,
+           0x8000),
+#endif
+    KERNEL(kKindPolyRows, ScalePolyphaseRows, C, 0, 4, 1, 4),
+#if defined(HAS_SCALEPOLYPHASEROWS_SSE2)
+    KERNEL(kKindPolyRows,
+           ScalePolyphaseRows,
+           SSE2,
+           libyuv::kCpuHasSSE2,
+           4,
+           1,
+           4),
+#endif
+#if defined(HAS_SCALEPOLYPHASEROWS_AVX2)
+    KERNEL(kKindPolyRows,
+           ScalePolyphaseRows,
+           AVX2,
+           libyuv::kCpuHasAVX2,
+           4,
+           1,
+           4),
+#endif
+    // Column filters of 8 bit pixels are padded to a multiple of 8 taps.
+    KERNEL(kKindPolyCols, ScalePolyphaseCols, C, 0, 1.5, 1, 8),
+#if defined(HAS_SCALEPOLYPHASECOLS_SSSE3)
+    KERNEL(kKindPolyCols,
+           ScalePolyphaseCols,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           1.5,
+           1,
+           8),
+#endif
+
+    // rotate_row.h
+    KERNEL(kKindTranspose, TransposeWx8, C, 0, 8, 8, 8),
+#if defined(HAS_TRANSPOSEWX8_SSSE3)
+    KERNEL(kKindTranspose, TransposeWx8, SSSE3, libyuv::kCpuHasSSSE3, 8, 8, 8),
+#endif
+#if defined(HAS_TRANSPOSEWX8_FAST_SSSE3)
+    KERNEL(kKindTranspose,
+           TransposeWx8_Fast,
+           SSSE3,
+           libyuv::kCpuHasSSSE3,
+           8,
+           8,
+           8),
+#endif
+#if defined(HAS_TRANSPOSEWX16_AVX2)
+    KERNEL(kKindTranspose,
+           TransposeWx16,
+           AVX2,
+           libyuv::kCpuHasAVX2,
+           16,
+           16,
+           16),
+#endif
+#if defined(HAS_TRANSPOSEWX16_AVX512VBMI)
+    KERNEL(kKindTranspose,
+           TransposeWx16,
+           AVX512VBMI,
+           libyuv::kCpuHasAVX512VBMI,
+           16,
+           16,
+           16),
+#endif
+#if defined(HAS_TRANSPOSEWX8_NEON)
+    KERNEL(kKindTranspose, TransposeWx8, NEON, libyuv::kCpuHasNEON, 8, 8, 8),
+#endif
+    KERNEL(kKindTransposeUV, TransposeUVWx8, C, 0, 16, 16, 8),
+#if defined(HAS_TRANSPOSEUVWX8_SSE2)
+    KERNEL(kKindTransposeUV,
+           TransposeUVWx8,
+           SSE2,
+           libyuv::kCpuHasSSE2,
+           16,
+           16,
+           8),
+#endif
+#if defined(HAS_TRANSPOSEUVWX16_AVX2)
+    KERNEL(kKindTransposeUV,
+           TransposeUVWx16,
+           AVX2,
+           libyuv::kCpuHasAVX2,
+           32,
+           32,
+           16),
+#endif
+#if defined(HAS_TRANSPOSEUVWX16_AVX512VBMI)
+    KERNEL(kKindTransposeUV,
+           TransposeUVWx16,
+           AVX512VBMI,
+           libyuv::kCpuHasAVX512VBMI,
+           32,
+           32,
+           16),
+#endif
+#if defined(HAS_TRANSPOSEUVWX8_NEON)
+    KERNEL(kKindTransposeUV,
+           TransposeUVWx8,
+           NEON,
+           libyuv::kCpuHasNEON,
+           16,
+           16,
+           8),
+#endif
+};
+
+#undef KERNEL
+
+// Buffers shared by the kernels. Each is big enough for 16 rows of 4 bytes
+// per unit of width, which covers the kernels that read the most.
+struct Buffers {
+  uint8_t* src;
+  uint8_t* src2;
+  uint8_t* src3;
+  uint8_t* dst;
+  uint8_t* dst2;
+  int* offsets;
+  int16_t* coeffs;
+  size_t size;
+};
+
+static uint8_t* AlignedAlloc(size_t size, uint8_t** mem) {
+  *mem = static_cast<uint8_t*>(malloc(size + 63));
+  if (!*mem) {
+    return NULL;
+  }
+  return reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(*mem) + 63) & ~static_cast<uintptr_t>(63));
+}
+
+static void RunKernel(const Kernel& k, const Buffers& b, int width) {
+  switch (k.kind) {
+    case kKindRow:
+      reinterpret_cast<void (*)(const uint8_t*, uint8_t*, int)>(k.func)(
+          b.src, b.dst, width);
+      break;
+    case kKindAddRow:
+      reinterpret_cast<void (*)(const uint8_t*, uint16_t*, int)>(k.func)(
+          b.src, reinterpret_cast<uint16_t*>(b.dst), width);
+      break;
+    case kKindYuvRow:
+      reinterpret_cast<void (*)(const uint8_t*, const uint8_t*,
+                                const uint8_t*, uint8_t*,
+                                const struct libyuv::YuvConstants*, int)>(
+          k.func)(b.src, b.src2, b.src3, b.dst, &libyuv::kYuvI601Constants,
+                  width);
+      break;
+    case kKindNVRow:
+      reinterpret_cast<void (*)(const uint8_t*, const uint8_t*, uint8_t*,
+                                const struct libyuv::YuvConstants*, int)>(
+          k.func)(b.src, b.src2, b.dst, &libyuv::kYuvI601Constants, width);
+      break;
+    case kKindUVRow:
+      reinterpret_cast<void (*)(const uint8_t*, int, uint8_t*, uint8_t*,
+                                int)>(k.func)(b.src, width * 4, b.dst,
+                                              b.dst2, width);
+      break;
+    case kKindInterpolate:
+      reinterpret_cast<void (*)(uint8_t*, const uint8_t*, ptrdiff_t, int,
+                                int)>(k.func)(b.dst, b.src, width, width, 64);
+      break;
+    case kKindScaleDown:
+      reinterpret_cast<void (*)(const uint8_t*, ptrdiff_t, uint8_t*, int)>(
+          k.func)(b.src, width * 4, b.dst, width);
+      break;
+    case kKindScaleCols:
+      reinterpret_cast<void (*)(uint8_t*, const uint8_t*, int, int, int)>(
+          k.func)(b.dst, b.src, width, 0, k.param);
+      break;
+    case kKindPolyRows:
+      reinterpret_cast<void (*)(const uint8_t*, ptrdiff_t, const int16_t*,
+                                int, uint8_t*, int)>(k.func)(
+          b.src, width, b.coeffs, k.param, b.dst, width);
+      break;
+    case kKindPolyCols:
+      reinterpret_cast<void (*)(uint8_t*, const uint8_t*, int, const int*,
+                                const int16_t*, int)>(k.func)(
+          b.dst, b.src, width, b.offsets, b.coeffs, k.param);
+      break;
+    case kKindTranspose:
+      reinterpret_cast<void (*)(const uint8_t*, int, uint8_t*, int, int)>(
+          k.func)(b.src, width, b.dst, k.param, width);
+      break;
+    case kKindTransposeUV:
+      reinterpret_cast<void (*)(const uint8_t*, int, uint8_t*, int, uint8_t*,
+                                int, int)>(k.func)(
+          b.src, width * 2, b.dst, k.param, b.dst2, k.param, width);
+      break;
+  }
+}
+
+// Reference cycles of the time stamp counter, or 0 if there is none.
+static uint64_t ReadCycles() {
+#if defined(HAVE_RDTSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+static double NowNs() {
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+struct Result {
+  double ns;       // Time per call.
+  double cycles;   // Cycles per call, 0 if unknown.
+  double bytes;    // Bytes read and written per call.
+  double units;    // Pixels per call.
+};
+
+static double BytesPerCycle(const Result& r) {
+  if (r.cycles > 0.) {
+    return r.bytes / r.cycles;
+  }
+  return ghz > 0. ? r.bytes / (r.ns * ghz) : 0.;
+}
+
+// Time num_calls calls of a benchmark after a few warm up calls.
+template <typename F>
+static void TimeCalls(F f, int num_calls, Result* r) {
+  for (int i = 0; i < 4; ++i) {
+    f();
+  }
+  double ns = NowNs();
+  uint64_t cycles = ReadCycles();
+  for (int i = 0; i < num_calls; ++i) {
+    f();
+  }
+  r->cycles = static_cast<double>(ReadCycles() - cycles) / num_calls;
+  r->ns = (NowNs() - ns) / num_calls;
+}
+
+static bool Match(const char* name, const char* isa) {
+  return !filter || strstr(name, filter) || strstr(isa, filter);
+}
+
+// Public functions timed at each instruction set level.
+enum FunctionKind {
+  kI420ToARGB,
+  kARGBToI420,
+  kI420ScaleHalf,
+  kARGBScaleHalf,
+  kI420Rotate90,
+};
+
+struct Function {
+  const char* name;
+  FunctionKind kind;
+  double bytes_per_pixel;  // Bytes read and written per source pixel.
+};
+
+static const Function kFunctions[] = {
+    {"I420ToARGB", kI420ToARGB, 1.5 + 4},
+    {"ARGBToI420", kARGBToI420, 4 + 1.5},
+    {"I420Scale_Bilinear_Half", kI420ScaleHalf, 1.5 + 1.5 / 4},
+    {"ARGBScale_Bilinear_Half", kARGBScaleHalf, 4 + 4. / 4},
+    {"I420Rotate90", kI420Rotate90, 1.5 + 1.5},
+};
+
+// Instruction set levels. Each level enables the flags of the ones before.
+struct Level {
+  const char* isa;
+  int required_flag;  // Level is skipped if the cpu does not have this.
+  int enable_flags;   // Passed to MaskCpuFlags.
+};
+
+static const int kSSE2Flags =
+    libyuv::kCpuInitialized | libyuv::kCpuHasX86 | libyuv::kCpuHasSSE2;
+static const int kSSSE3Flags = kSSE2Flags | libyuv::kCpuHasSSSE3 |
+                               libyuv::kCpuHasSSE41 | libyuv::kCpuHasSSE42;
+static const int kAVX2Flags = kSSSE3Flags | libyuv::kCpuHasAVX |
+                              libyuv::kCpuHasAVX2 | libyuv::kCpuHasERMS |
+                              libyuv::kCpuHasFMA3 | libyuv::kCpuHasF16C;
+
+static const Level kLevels[] = {
+    {"C", 0, libyuv::kCpuInitialized},
+    {"SSE2", libyuv::kCpuHasSSE2, kSSE2Flags},
+    {"SSSE3", libyuv::kCpuHasSSSE3, kSSSE3Flags},
+    {"AVX2", libyuv::kCpuHasAVX2, kAVX2Flags},
+    {"AVX512", libyuv::kCpuHasAVX512BW, -1},
+    {"NEON", libyuv::kCpuHasNEON, -1},
+    {"MSA", libyuv::kCpuHasMSA, -1},
+    {"MMI", libyuv::kCpuHasMMI, -1},
+};
+
+static void RunFunction(const Function& f, uint8_t* src, uint8_t* dst) {
+  const int w = image_width;
+  const int h = image_height;
+  const int hw = (w + 1) / 2;
+  const int hh = (h + 1) / 2;
+  uint8_t* src_u = src + w * h;
+  uint8_t* src_v = src_u + hw * hh;
+  switch (f.kind) {
+    case kI420ToARGB:
+      libyuv::I420ToARGB(src, w, src_u, hw, src_v, hw, dst, w * 4, w, h);
+      break;
+    case kARGBToI420:
+      libyuv::ARGBToI420(src, w * 4, dst, w, dst + w * h, hw,
+                         dst + w * h + hw * hh, hw, w, h);
+      break;
+    case kI420ScaleHalf: {
+      const int dw = w / 2;
+      const int dh = h / 2;
+      const int dhw = (dw + 1) / 2;
+      const int dhh = (dh + 1) / 2;
+      libyuv::I420Scale(src, w, src_u, hw, src_v, hw, w, h, dst, dw,
+                        dst + dw * dh, dhw, dst + dw * dh + dhw * dhh, dhw, dw,
+                        dh, libyuv::kFilterBilinear);
+      break;
+    }
+    case kARGBScaleHalf:
+      libyuv::ARGBScale(src, w * 4, w, h, dst, w / 2 * 4, w / 2, h / 2,
+                        libyuv::kFilterBilinear);
+      break;
+    case kI420Rotate90:
+      libyuv::I420Rotate(src, w, src_u, hw, src_v, hw, dst, h, dst + w * h,
+                         hh, dst + w * h + hw * hh, hh, w, h,
+                         libyuv::kRotate90);
+      break;
+  }
+}
+
+// Print the row functions counted by LIBYUV_STATS since the last reset,
+// and add them to the json record as "stats".
+static void PrintStats(FILE* text, FILE* json) {
+  libyuv::LibyuvStat stats[64];
+  int num_stats = libyuv::LibyuvGetStats(stats, 64);
+  if (num_stats > 64) {
+    num_stats = 64;
+  }
+  const char* separator = "";
+  if (json) {
+    fprintf(json, ", \"stats\": [");
+  }
+  for (int i = 0; i < num_stats; ++i) {
+    const libyuv::LibyuvStat& s = stats[i];
+    if (!s.kernel) {
+      continue;
+    }
+    fprintf(text, "  %-30s %10llu rows %10.1f cycles/row\n", s.kernel,
+            static_cast<unsigned long long>(s.calls),  // NOLINT
+            static_cast<double>(s.cycles) / s.calls);
+    if (json) {
+      fprintf(json,
+              "%s{\"family\": \"%s\", \"kernel\": \"%s\", "
+              "\"rows\": %llu, \"pixels\": %llu, \"cycles\": %llu}",
+              separator, s.name, s.kernel,
+              static_cast<unsigned long long>(s.calls),    // NOLINT
+              static_cast<unsigned long long>(s.pixels),   // NOLINT
+              static_cast<unsigned long long>(s.cycles));  // NOLINT
+      separator = ", ";
+    }
+  }
+  if (json) {
+    fprintf(json, "]");
+  }
+}
+
+static void PrintHelp(const char* program) {
+  printf("%s [-options]\n", program);
+  printf(" -w <width> ............. width of the row kernels (default 1920)\n");
+  printf(
+      " -s <width> <height> .... frame size of the functions (default "
+      "1280 720)\n");
+  printf(" -i <iterations> ........ calls per benchmark\n");
+  printf(" -f <filter> ............ only run names or isas containing filter\n");
+  printf(" -ghz <frequency> ....... cycles per ns if there is no counter\n");
+  printf(" -json <file> ........... write results as json, - for stdout\n");
+  printf(" -h ..................... this help\n");
+  exit(0);
+}
+
+static void ParseOptions(int argc, const char* argv[]) {
+  if (argc <= 1) {
+    return;
+  }
+  for (int c = 1; c < argc; ++c) {
+    if (!strcmp(argv[c], "-h") || !strcmp(argv[c], "-help")) {
+      PrintHelp(argv[0]);
+    } else if (!strcmp(argv[c], "-w") && c + 1 < argc) {
+      row_width = atoi(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-s") && c + 2 < argc) {
+      image_width = atoi(argv[++c]);   // NOLINT
+      image_height = atoi(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-i") && c + 1 < argc) {
+      iterations = atoi(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-f") && c + 1 < argc) {
+      filter = argv[++c];
+    } else if (!strcmp(argv[c], "-ghz") && c + 1 < argc) {
+      ghz = atof(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-json") && c + 1 < argc) {
+      json_name = argv[++c];
+    } else {
+      fprintf(stderr, "Unknown option: %s\n", argv[c]);
+      PrintHelp(argv[0]);
+    }
+  }
+  if (row_width <= 0 || image_width <= 1 || image_height <= 1 ||
+      iterations < 0) {
+    fprintf(stderr, "Invalid size or iterations\n");
+    exit(1);
+  }
+}
+
+int main(int argc, const char* argv[]) {
+  ParseOptions(argc, argv);
+  // Round the width up so every kernel runs on whole blocks, including the
+  // 24 and 12 pixel blocks of the 3/4 and 3/8 scalers.
+  row_width = (row_width + 191) / 192 * 192;
+
+  FILE* json = NULL;
+  if (json_name) {
+    json = strcmp(json_name, "-") ? fopen(json_name, "w") : stdout;
+    if (!json) {
+      fprintf(stderr, "Cannot open %s\n", json_name);
+      exit(1);
+    }
+  }
+  FILE* text = json == stdout ? stderr : stdout;
+
+  const int cpu_flags = libyuv::MaskCpuFlags(-1);
+  if (json) {
+    fprintf(json,
+            "{\n  \"version\": %d,\n  \"cpu_flags\": %d,\n"
+            "  \"cycle_counter\": %s,\n  \"row_width\": %d,\n"
+            "  \"image_width\": %d,\n  \"image_height\": %d,\n"
+            "  \"kernels\": [",
+            LIBYUV_VERSION, cpu_flags, ReadCycles() ? "true" : "false",
+            row_width, image_width, image_height);
+  }
+
+  // Row kernels.
+  Buffers b;
+  uint8_t* mem[5];
+  uint8_t* offsets_mem;
+  uint8_t* coeffs_mem;
+  b.size = static_cast<size_t>(row_width) * 4 * 16;
+  b.src = AlignedAlloc(b.size, &mem[0]);
+  b.src2 = AlignedAlloc(b.size, &mem[1]);
+  b.src3 = AlignedAlloc(b.size, &mem[2]);
+  b.dst = AlignedAlloc(b.size, &mem[3]);
+  b.dst2 = AlignedAlloc(b.size, &mem[4]);
+  b.offsets = reinterpret_cast<int*>(
+      AlignedAlloc(row_width * sizeof(int), &offsets_mem));
+  b.coeffs = reinterpret_cast<int16_t*>(
+      AlignedAlloc(row_width * 8 * sizeof(int16_t), &coeffs_mem));
+  if (!b.src || !b.src2 || !b.src3 || !b.dst || !b.dst2 || !b.offsets ||
+      !b.coeffs) {
+    fprintf(stderr, "Memory allocation failed\n");
+    exit(1);
+  }
+  for (size_t i = 0; i < b.size; ++i) {
+    b.src[i] = static_cast<uint8_t>(i * 7);
+    b.src2[i] = static_cast<uint8_t>(i * 11);
+    b.src3[i] = static_cast<uint8_t>(i * 13);
+  }
+  for (int i = 0; i < row_width; ++i) {
+    b.offsets[i] = i * 3 / 2;
+    for (int j = 0; j < 8; ++j) {
+      b.coeffs[i * 8 + j] = j == 3 || j == 4 ? 8192 : 0;
+    }
+  }
+
+  fprintf(text, "%-24s %-10s %10s %12s %10s\n", "kernel", "isa", "ns/call",
+          "bytes/cycle", "GB/s");
+  const char* separator = "\n";
+  for (size_t i = 0; i < sizeof(kKernels) / sizeof(kKernels[0]); ++i) {
+    const Kernel& k = kKernels[i];
+    if ((k.cpu_flag && !(cpu_flags & k.cpu_flag)) || !Match(k.name, k.isa)) {
+      continue;
+    }
+    Result r;
+    TimeCalls([&k, &b]() { RunKernel(k, b, row_width); },
+              iterations ? iterations : 2000, &r);
+    r.bytes = (k.src_bytes + k.dst_bytes) * row_width;
+    r.units = row_width;
+    fprintf(text, "%-24s %-10s %10.1f %12.3f %10.2f\n", k.name, k.isa, r.ns,
+            BytesPerCycle(r), r.bytes / r.ns);
+    if (json) {
+      fprintf(json,
+              "%s    {\"name\": \"%s\", \"isa\": \"%s\", \"width\": %d, "
+              "\"ns_per_call\": %.1f, \"cycles_per_call\": %.1f, "
+              "\"bytes_per_cycle\": %.4f, \"pixels_per_cycle\": %.4f, "
+              "\"gb_per_s\": %.3f}",
+              separator, k.name, k.isa, row_width, r.ns, r.cycles,
+              BytesPerCycle(r),
+              BytesPerCycle(r) * r.units / r.bytes, r.bytes / r.ns);
+      separator = ",\n";
+    }
+  }
+  for (int i = 0; i < 5; ++i) {
+    free(mem[i]);
+  }
+  free(offsets_mem);
+  free(coeffs_mem);
+
+  // Public functions at each instruction set level.
+  if (json) {
+    fprintf(json, "\n  ],\n  \"functions\": [");
+  }
+  size_t frame_size = static_cast<size_t>(image_width) * image_height * 4;
+  uint8_t* src_mem;
+  uint8_t* dst_mem;
+  uint8_t* src = AlignedAlloc(frame_size, &src_mem);
+  uint8_t* dst = AlignedAlloc(frame_size, &dst_mem);
+  if (!src || !dst) {
+    fprintf(stderr, "Memory allocation failed\n");
+    exit(1);
+  }
+  for (size_t i = 0; i < frame_size; ++i) {
+    src[i] = static_cast<uint8_t>(i * 7);
+  }
+  fprintf(text, "\n%-24s %-10s %10s %12s %10s\n", "function", "isa",
+          "us/frame", "bytes/cycle", "GB/s");
+  separator = "\n";
+  for (size_t i = 0; i < sizeof(kFunctions) / sizeof(kFunctions[0]); ++i) {
+    const Function& f = kFunctions[i];
+    for (size_t l = 0; l < sizeof(kLevels) / sizeof(kLevels[0]); ++l) {
+      const Level& level = kLevels[l];
+      if ((level.required_flag && !(cpu_flags & level.required_flag)) ||
+          !Match(f.name, level.isa)) {
+        continue;
+      }
+      libyuv::MaskCpuFlags(level.enable_flags);
+      libyuv::LibyuvResetStats();
+      Result r;
+      TimeCalls([&f, src, dst]() { RunFunction(f, src, dst); },
+                iterations ? iterations : 20, &r);
+      libyuv::MaskCpuFlags(-1);
+      r.units = static_cast<double>(image_width) * image_height;
+      r.bytes = f.bytes_per_pixel * r.units;
+      fprintf(text, "%-24s %-10s %10.1f %12.3f %10.2f\n", f.name, level.isa,
+              r.ns / 1000., BytesPerCycle(r), r.bytes / r.ns);
+      if (json) {
+        fprintf(json,
+                "%s    {\"name\": \"%s\", \"isa\": \"%s\", \"width\": %d, "
+                "\"height\": %d, \"ns_per_frame\": %.1f, "
+                "\"cycles_per_frame\": %.1f, \"bytes_per_cycle\": %.4f, "
+                "\"pixels_per_cycle\": %.4f, \"gb_per_s\": %.3f",
+                separator, f.name, level.isa, image_width, image_height, r.ns,
+                r.cycles, BytesPerCycle(r),
+                BytesPerCycle(r) * r.units / r.bytes, r.bytes / r.ns);
+        separator = ",\n";
+      }
+      if (libyuv::LibyuvStatsEnabled()) {
+        PrintStats(text, json);
+      }
+      if (json) {
+        fprintf(json, "}");
+      }
+    }
+  }
+  free(src_mem);
+  free(dst_mem);
+
+  if (json) {
+    fprintf(json, "\n  ]\n}\n");
+    if (json != stdout) {
+      fclose(json);
+    }
+  }
+  return 0;
+}
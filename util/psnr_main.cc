@@ -9,12 +9,13 @@
  */
 
 // Get PSNR or SSIM for video sequence. Assuming RAW 4:2:0 Y:Cb:Cr format
-// To build: g++ -O3 -o psnr psnr.cc ssim.cc psnr_main.cc
-// or VisualC: cl /Ox psnr.cc ssim.cc psnr_main.cc
+// To build: g++ -O3 -pthread -I../include -o psnr psnr.cc ssim.cc
+//           psnr_main.cc ../source/*.cc
+// or link with libyuv, as util/Makefile, linux.mk and BUILD.gn do.
 //
-// To enable OpenMP and SSE2
-// gcc: g++ -msse2 -O3 -fopenmp -o psnr psnr.cc ssim.cc psnr_main.cc
-// vc:  cl /arch:SSE2 /Ox /openmp psnr.cc ssim.cc psnr_main.cc
+// Sequences are memory mapped. Batches of frames are compared on a pool of
+// threads, while the pages of the next batch are read ahead. Sequences that
+// can not be mapped, such as pipes, are read a batch at a time.
 //
 // Usage: psnr org_seq rec_seq -s width height [-skip skip_org skip_rec]
 
@@ -22,18 +23,35 @@
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 
+#include <math.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <thread>
 
 #include "./psnr.h"
 #include "./ssim.h"
-#ifdef HAVE_JPEG
 #include "libyuv/compare.h"
+#include "libyuv/executor.h"
+#ifdef HAVE_JPEG
 #include "libyuv/convert.h"
 #endif
 
@@ -60,9 +78,9 @@ int num_rec = 0;
 int num_skip_org = 0;
 int num_skip_rec = 0;
 int num_frames = 0;
-#ifdef _OPENMP
 int num_threads = 0;
-#endif
+const char* csv_name = NULL;
+const char* json_name = NULL;
 
 // Parse PYUV format. ie name.1920x800_24Hz_P420.yuv
 bool ExtractResolutionFromFilename(const char* name,
@@ -141,9 +159,11 @@ void PrintHelp(const char* program) {
   printf(" -swap .................. Swap U and V plane\n");
   printf(" -skip <org> <rec> ...... Number of frame to skip of org and rec\n");
   printf(" -frames <num> .......... Number of frames to compare\n");
-#ifdef _OPENMP
-  printf(" -t <num> ............... Number of threads\n");
-#endif
+  printf(" -t <num> ............... Number of threads (default all cores)\n");
+  printf(" -csv <file> ............ write per frame metrics as csv, - for "
+         "stdout\n");
+  printf(" -json <file> ........... write per frame metrics as json, - for "
+         "stdout\n");
   printf(" -n ..................... Show file name\n");
   printf(" -v ..................... verbose++\n");
   printf(" -q ..................... quiet\n");
@@ -183,11 +203,13 @@ void ParseOptions(int argc, const char* argv[]) {
       num_skip_rec = atoi(argv[++c]);  // NOLINT
     } else if (!strcmp(argv[c], "-frames") && c + 1 < argc) {
       num_frames = atoi(argv[++c]);  // NOLINT
-#ifdef _OPENMP
     } else if (!strcmp(argv[c], "-t") && c + 1 < argc) {
       num_threads = atoi(argv[++c]);  // NOLINT
-#endif
-    } else if (argv[c][0] == '-') {
+    } else if (!strcmp(argv[c], "-csv") && c + 1 < argc) {
+      csv_name = argv[++c];
+    } else if (!strcmp(argv[c], "-json") && c + 1 < argc) {
+      json_name = argv[++c];
+    } else if (argv[c][0] == '-' && argv[c][1] != '\0') {
       fprintf(stderr, "Unknown option. %s\n", argv[c]);
     } else if (fileindex_org == 0) {
       fileindex_org = c;
@@ -240,159 +262,434 @@ void ParseOptions(int argc, const char* argv[]) {
   }
 }
 
-bool UpdateMetrics(uint8_t* ch_org,
-                   uint8_t* ch_rec,
-                   const int y_size,
-                   const int uv_size,
-                   const size_t total_size,
-                   int number_of_frames,
-                   metric* cur_distortion_psnr,
-                   metric* distorted_frame,
-                   bool do_psnr) {
-  const int uv_offset = (do_swap_uv ? uv_size : 0);
-  const uint8_t* const u_org = ch_org + y_size + uv_offset;
-  const uint8_t* const u_rec = ch_rec + y_size;
-  const uint8_t* const v_org = ch_org + y_size + (uv_size - uv_offset);
-  const uint8_t* const v_rec = ch_rec + y_size + uv_size;
-  if (do_psnr) {
+// A sequence, memory mapped if possible, else read a batch of frames at a
+// time into buffer.
+struct Sequence {
+  const char* name;
+  const uint8_t* data;  // Mapped file, or NULL.
+  uint64_t size;        // Bytes mapped.
+  FILE* file;           // Read when the file could not be mapped.
+  uint8_t* buffer;
+#if defined(_WIN32)
+  HANDLE handle;
+  HANDLE mapping;
+#endif
+};
+
+static bool OpenSequence(const char* name, uint64_t skip, Sequence* seq) {
+  memset(seq, 0, sizeof(*seq));
+  seq->name = name;
+#if defined(_WIN32)
+  seq->handle = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (seq->handle != INVALID_HANDLE_VALUE) {
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(seq->handle, &size) && size.QuadPart > 0 &&
+        static_cast<uint64_t>(size.QuadPart) <= SIZE_MAX) {
+      seq->mapping =
+          CreateFileMappingA(seq->handle, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (seq->mapping) {
+        seq->data = static_cast<const uint8_t*>(
+            MapViewOfFile(seq->mapping, FILE_MAP_READ, 0, 0, 0));
+        seq->size = size.QuadPart;
+      }
+    }
+    if (seq->data) {
+      return true;
+    }
+    if (seq->mapping) {
+      CloseHandle(seq->mapping);
+      seq->mapping = NULL;
+    }
+    CloseHandle(seq->handle);
+    seq->handle = INVALID_HANDLE_VALUE;
+  }
+#else
+  const int fd = open(name, O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+        static_cast<uint64_t>(st.st_size) <= SIZE_MAX) {
+      void* data = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ,
+                        MAP_SHARED, fd, 0);
+      if (data != MAP_FAILED) {
+        seq->data = static_cast<const uint8_t*>(data);
+        seq->size = st.st_size;
+        madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+    if (seq->data) {
+      return true;
+    }
+  }
+#endif
+  seq->file = fopen(name, "rb");
+  if (seq->file == NULL) {
+    return false;
+  }
+#if defined(_MSC_VER)
+  _fseeki64(seq->file, static_cast<__int64>(skip), SEEK_SET);
+#elif defined(_WIN32)
+  fseek(seq->file, static_cast<long>(skip), SEEK_SET);
+#else
+  fseeko(seq->file, static_cast<off_t>(skip), SEEK_SET);
+#endif
+  return true;
+}
+
+static void CloseSequence(Sequence* seq) {
+  if (seq->data) {
+#if defined(_WIN32)
+    UnmapViewOfFile(seq->data);
+    CloseHandle(seq->mapping);
+    CloseHandle(seq->handle);
+#else
+    munmap(const_cast<uint8_t*>(seq->data), static_cast<size_t>(seq->size));
+#endif
+  }
+  if (seq->file) {
+    fclose(seq->file);
+  }
+  delete[] seq->buffer;
+}
+
+// Get up to count frames starting at byte offset, which advances by a frame
+// per call. Returns the number of frames. A last frame shorter than
+// frame_size may be a jpeg.
+static int GetFrames(Sequence* seq,
+                     uint64_t offset,
+                     int count,
+                     size_t frame_size,
+                     const uint8_t** frames,
+                     size_t* sizes) {
+  int n;
+  for (n = 0; n < count; ++n) {
+    const uint64_t frame_offset = offset + n * static_cast<uint64_t>(frame_size);
+    size_t bytes;
+    if (seq->data) {
+      if (frame_offset >= seq->size) {
+        break;
+      }
+      frames[n] = seq->data + frame_offset;
+      bytes = seq->size - frame_offset < frame_size
+                  ? static_cast<size_t>(seq->size - frame_offset)
+                  : frame_size;
+    } else {
+      if (!seq->buffer) {
+        seq->buffer = new uint8_t[frame_size * count];
+      }
+      frames[n] = seq->buffer + n * frame_size;
+      bytes = fread(seq->buffer + n * frame_size, sizeof(uint8_t), frame_size,
+                    seq->file);
+      if (bytes == 0) {
+        break;
+      }
+    }
+    sizes[n] = bytes;
+    if (bytes < frame_size) {
 #ifdef HAVE_JPEG
-    double y_err = static_cast<double>(
-        libyuv::ComputeSumSquareError(ch_org, ch_rec, y_size));
-    double u_err = static_cast<double>(
-        libyuv::ComputeSumSquareError(u_org, u_rec, uv_size));
-    double v_err = static_cast<double>(
-        libyuv::ComputeSumSquareError(v_org, v_rec, uv_size));
+      ++n;
+#endif
+      break;
+    }
+  }
+  return n;
+}
+
+// Hint the OS to read the frames of the next batch while this one is
+// compared, and to drop the frames already compared.
+static void ReadAhead(const Sequence* seq,
+                      uint64_t done,
+                      uint64_t offset,
+                      uint64_t length) {
+#if defined(_WIN32)
+  (void)seq;
+  (void)done;
+  (void)offset;
+  (void)length;
 #else
-    double y_err = ComputeSumSquareError(ch_org, ch_rec, y_size);
-    double u_err = ComputeSumSquareError(u_org, u_rec, uv_size);
-    double v_err = ComputeSumSquareError(v_org, v_rec, uv_size);
+  const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  if (!seq->data) {
+    return;
+  }
+  done &= ~(page - 1);
+  if (done > 0) {
+    madvise(const_cast<uint8_t*>(seq->data), static_cast<size_t>(done),
+            MADV_DONTNEED);
+  }
+  if (offset < seq->size) {
+    const uint64_t start = offset & ~(page - 1);
+    if (length > seq->size - start) {
+      length = seq->size - start;
+    }
+    madvise(const_cast<uint8_t*>(seq->data) + start,
+            static_cast<size_t>(length), MADV_WILLNEED);
+  }
 #endif
-    const double total_err = y_err + u_err + v_err;
-    cur_distortion_psnr->global_y += y_err;
-    cur_distortion_psnr->global_u += u_err;
-    cur_distortion_psnr->global_v += v_err;
-    cur_distortion_psnr->global_all += total_err;
-    distorted_frame->y = ComputePSNR(y_err, static_cast<double>(y_size));
-    distorted_frame->u = ComputePSNR(u_err, static_cast<double>(uv_size));
-    distorted_frame->v = ComputePSNR(v_err, static_cast<double>(uv_size));
-    distorted_frame->all =
-        ComputePSNR(total_err, static_cast<double>(total_size));
-  } else {
-    distorted_frame->y = CalcSSIM(ch_org, ch_rec, image_width, image_height);
-    distorted_frame->u =
-        CalcSSIM(u_org, u_rec, (image_width + 1) / 2, (image_height + 1) / 2);
-    distorted_frame->v =
-        CalcSSIM(v_org, v_rec, (image_width + 1) / 2, (image_height + 1) / 2);
-    distorted_frame->all =
-        (distorted_frame->y + distorted_frame->u + distorted_frame->v) /
-        total_size;
-    distorted_frame->y /= y_size;
-    distorted_frame->u /= uv_size;
-    distorted_frame->v /= uv_size;
-
-    if (do_lssim) {
-      distorted_frame->all = CalcLSSIM(distorted_frame->all);
-      distorted_frame->y = CalcLSSIM(distorted_frame->y);
-      distorted_frame->u = CalcLSSIM(distorted_frame->u);
-      distorted_frame->v = CalcLSSIM(distorted_frame->v);
-    }
-  }
-
-  cur_distortion_psnr->y += distorted_frame->y;
-  cur_distortion_psnr->u += distorted_frame->u;
-  cur_distortion_psnr->v += distorted_frame->v;
-  cur_distortion_psnr->all += distorted_frame->all;
+}
+
+// Metrics of a frame of a rec sequence against the org sequence.
+struct FrameJob {
+  const uint8_t* org;
+  size_t org_size;
+  const uint8_t* rec;
+  size_t rec_size;
+  bool valid;
+  double sse_y, sse_u, sse_v;
+  metric psnr;
+  metric ssim;
+};
+
+struct Batch {
+  FrameJob* jobs;
+  bool threaded;
+  int y_size;
+  int uv_size;
+  size_t total_size;
+};
+
+#ifdef HAVE_JPEG
+// Decode a frame that is a jpeg, or return NULL.
+static uint8_t* DecodeJpeg(const uint8_t* jpeg,
+                           size_t size,
+                           int y_size,
+                           int uv_size) {
+  uint8_t* const frame = new uint8_t[y_size + 2 * uv_size];
+  memset(frame, 0, y_size + 2 * uv_size);
+  if (0 != libyuv::MJPGToI420(jpeg, size, frame, image_width, frame + y_size,
+                              (image_width + 1) / 2, frame + y_size + uv_size,
+                              (image_width + 1) / 2, image_width, image_height,
+                              image_width, image_height)) {
+    delete[] frame;
+    return NULL;
+  }
+  return frame;
+}
+#endif  // HAVE_JPEG
+
+static void CompareFrame(const Batch* batch, FrameJob* job) {
+  const int y_size = batch->y_size;
+  const int uv_size = batch->uv_size;
+  const size_t total_size = batch->total_size;
+  const uint8_t* ch_org = job->org;
+  const uint8_t* ch_rec = job->rec;
+  uint8_t* jpeg_org = NULL;
+  uint8_t* jpeg_rec = NULL;
+  job->valid = false;
+#ifdef HAVE_JPEG
+  if (job->org_size < total_size) {
+    jpeg_org = DecodeJpeg(job->org, job->org_size, y_size, uv_size);
+    ch_org = jpeg_org;
+  }
+  if (job->rec_size < total_size) {
+    jpeg_rec = DecodeJpeg(job->rec, job->rec_size, y_size, uv_size);
+    ch_rec = jpeg_rec;
+  }
+#endif
+  if (ch_org && ch_rec && job->org_size > 0 && job->rec_size > 0) {
+    const int uv_offset = (do_swap_uv ? uv_size : 0);
+    const uint8_t* const u_org = ch_org + y_size + uv_offset;
+    const uint8_t* const u_rec = ch_rec + y_size;
+    const uint8_t* const v_org = ch_org + y_size + (uv_size - uv_offset);
+    const uint8_t* const v_rec = ch_rec + y_size + uv_size;
+    if (do_psnr || do_mse) {
+      job->sse_y = static_cast<double>(
+          libyuv::ComputeSumSquareError(ch_org, ch_rec, y_size));
+      job->sse_u = static_cast<double>(
+          libyuv::ComputeSumSquareError(u_org, u_rec, uv_size));
+      job->sse_v = static_cast<double>(
+          libyuv::ComputeSumSquareError(v_org, v_rec, uv_size));
+      job->psnr.y = ComputePSNR(job->sse_y, static_cast<double>(y_size));
+      job->psnr.u = ComputePSNR(job->sse_u, static_cast<double>(uv_size));
+      job->psnr.v = ComputePSNR(job->sse_v, static_cast<double>(uv_size));
+      job->psnr.all = ComputePSNR(job->sse_y + job->sse_u + job->sse_v,
+                                  static_cast<double>(total_size));
+    }
+    if (do_ssim) {
+      metric* ssim = &job->ssim;
+      ssim->y = CalcSSIM(ch_org, ch_rec, image_width, image_height);
+      ssim->u =
+          CalcSSIM(u_org, u_rec, (image_width + 1) / 2, (image_height + 1) / 2);
+      ssim->v =
+          CalcSSIM(v_org, v_rec, (image_width + 1) / 2, (image_height + 1) / 2);
+      ssim->all = (ssim->y + ssim->u + ssim->v) / total_size;
+      ssim->y /= y_size;
+      ssim->u /= uv_size;
+      ssim->v /= uv_size;
+
+      if (do_lssim) {
+        ssim->all = CalcLSSIM(ssim->all);
+        ssim->y = CalcLSSIM(ssim->y);
+        ssim->u = CalcLSSIM(ssim->u);
+        ssim->v = CalcLSSIM(ssim->v);
+      }
+    }
+    job->valid = true;
+  }
+  delete[] jpeg_org;
+  delete[] jpeg_rec;
+}
+
+static void CompareFrames(void* arg, int begin, int end) {
+  const Batch* batch = static_cast<const Batch*>(arg);
+#ifdef _OPENMP
+  // Frames are already compared in parallel.
+  if (batch->threaded) {
+    omp_set_num_threads(1);
+  }
+#endif
+  for (int i = begin; i < end; ++i) {
+    CompareFrame(batch, &batch->jobs[i]);
+  }
+}
+
+bool UpdateMetrics(const metric& distorted_frame,
+                   int number_of_frames,
+                   metric* cur_distortion) {
+  cur_distortion->y += distorted_frame.y;
+  cur_distortion->u += distorted_frame.u;
+  cur_distortion->v += distorted_frame.v;
+  cur_distortion->all += distorted_frame.all;
 
   bool ismin = false;
-  if (distorted_frame->y < cur_distortion_psnr->min_y) {
-    cur_distortion_psnr->min_y = distorted_frame->y;
+  if (distorted_frame.y < cur_distortion->min_y) {
+    cur_distortion->min_y = distorted_frame.y;
   }
-  if (distorted_frame->u < cur_distortion_psnr->min_u) {
-    cur_distortion_psnr->min_u = distorted_frame->u;
+  if (distorted_frame.u < cur_distortion->min_u) {
+    cur_distortion->min_u = distorted_frame.u;
   }
-  if (distorted_frame->v < cur_distortion_psnr->min_v) {
-    cur_distortion_psnr->min_v = distorted_frame->v;
+  if (distorted_frame.v < cur_distortion->min_v) {
+    cur_distortion->min_v = distorted_frame.v;
   }
-  if (distorted_frame->all < cur_distortion_psnr->min_all) {
-    cur_distortion_psnr->min_all = distorted_frame->all;
-    cur_distortion_psnr->min_frame = number_of_frames;
+  if (distorted_frame.all < cur_distortion->min_all) {
+    cur_distortion->min_all = distorted_frame.all;
+    cur_distortion->min_frame = number_of_frames;
     ismin = true;
   }
   return ismin;
 }
 
-int main(int argc, const char* argv[]) {
-  ParseOptions(argc, argv);
-  if (!do_psnr && !do_ssim) {
-    do_psnr = true;
+// Quote names with commas or quotes for csv.
+static void PrintCsvName(FILE* csv, const char* name) {
+  if (!strpbrk(name, ",\"\n")) {
+    fprintf(csv, "%s", name);
+    return;
+  }
+  fputc('"', csv);
+  for (const char* c = name; *c; ++c) {
+    if (*c == '"') {
+      fputc('"', csv);
+    }
+    fputc(*c, csv);
   }
+  fputc('"', csv);
+}
 
-#ifdef _OPENMP
-  if (num_threads) {
-    omp_set_num_threads(num_threads);
+static void PrintJsonName(FILE* json, const char* name) {
+  fputc('"', json);
+  for (const char* c = name; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      fputc('\\', json);
+    }
+    fputc(*c, json);
   }
-  if (verbose) {
-    printf("OpenMP %d procs\n", omp_get_num_procs());
+  fputc('"', json);
+}
+
+// Per frame values of a metric. json has no infinity, which LSSIM of
+// identical frames is, so non finite values are null.
+static void PrintFrameMetric(FILE* csv,
+                             FILE* json,
+                             const char* name,
+                             double y,
+                             double u,
+                             double v,
+                             double all) {
+  const char* const kPlanes[4] = {"y", "u", "v", "all"};
+  const double values[4] = {y, u, v, all};
+  for (int i = 0; i < 4; ++i) {
+    if (csv) {
+      fprintf(csv, ",%.6f", values[i]);
+    }
+    if (json) {
+      if (isfinite(values[i])) {
+        fprintf(json, ", \"%s_%s\": %.6f", name, kPlanes[i], values[i]);
+      } else {
+        fprintf(json, ", \"%s_%s\": null", name, kPlanes[i]);
+      }
+    }
   }
-#endif
-  // Open original file (first file argument)
-  FILE* const file_org = fopen(argv[fileindex_org], "rb");
-  if (file_org == NULL) {
-    fprintf(stderr, "Cannot open %s\n", argv[fileindex_org]);
+}
+
+static FILE* OpenOutput(const char* name) {
+  if (!name) {
+    return NULL;
+  }
+  FILE* const file = strcmp(name, "-") ? fopen(name, "w") : stdout;
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", name);
     exit(1);
   }
+  return file;
+}
 
-  // Open all files to compare to
-  FILE** file_rec = new FILE*[num_rec];
-  memset(file_rec, 0, num_rec * sizeof(FILE*));  // NOLINT
-  for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-    file_rec[cur_rec] = fopen(argv[fileindex_rec + cur_rec], "rb");
-    if (file_rec[cur_rec] == NULL) {
-      fprintf(stderr, "Cannot open %s\n", argv[fileindex_rec + cur_rec]);
-      fclose(file_org);
-      for (int i = 0; i < cur_rec; ++i) {
-        fclose(file_rec[i]);
-      }
-      delete[] file_rec;
-      exit(1);
-    }
+int main(int argc, const char* argv[]) {
+  ParseOptions(argc, argv);
+  if (!do_psnr && !do_ssim) {
+    do_psnr = true;
   }
 
+  FILE* const csv = OpenOutput(csv_name);
+  FILE* const json = OpenOutput(json_name);
+  FILE* const text = (csv == stdout || json == stdout) ? stderr : stdout;
+
   const int y_size = image_width * image_height;
   const int uv_size = ((image_width + 1) / 2) * ((image_height + 1) / 2);
   const size_t total_size = y_size + 2 * uv_size;  // NOLINT
-#if defined(_MSC_VER)
-  _fseeki64(
-      file_org,
-      static_cast<__int64>(num_skip_org) * static_cast<__int64>(total_size),
-      SEEK_SET);
-#else
-  fseek(file_org, num_skip_org * total_size, SEEK_SET);
-#endif
-  for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-#if defined(_MSC_VER)
-    _fseeki64(
-        file_rec[cur_rec],
-        static_cast<__int64>(num_skip_rec) * static_cast<__int64>(total_size),
-        SEEK_SET);
-#else
-    fseek(file_rec[cur_rec], num_skip_rec * total_size, SEEK_SET);
-#endif
+  const uint64_t skip_org =
+      static_cast<uint64_t>(num_skip_org) * static_cast<uint64_t>(total_size);
+  const uint64_t skip_rec =
+      static_cast<uint64_t>(num_skip_rec) * static_cast<uint64_t>(total_size);
+
+  // Open original file (first file argument) and all files to compare to.
+  Sequence* const seqs = new Sequence[num_rec + 1];
+  for (int i = 0; i <= num_rec; ++i) {
+    const char* const name =
+        i ? argv[fileindex_rec + i - 1] : argv[fileindex_org];
+    if (!OpenSequence(name, i ? skip_rec : skip_org, &seqs[i])) {
+      fprintf(stderr, "Cannot open %s\n", name);
+      for (int j = 0; j < i; ++j) {
+        CloseSequence(&seqs[j]);
+      }
+      delete[] seqs;
+      exit(1);
+    }
   }
+  Sequence* const seq_org = &seqs[0];
+  Sequence* const seq_rec = &seqs[1];
 
-  uint8_t* const ch_org = new uint8_t[total_size];
-  uint8_t* const ch_rec = new uint8_t[total_size];
-  if (ch_org == NULL || ch_rec == NULL) {
-    fprintf(stderr, "No memory available\n");
-    fclose(file_org);
-    for (int i = 0; i < num_rec; ++i) {
-      fclose(file_rec[i]);
-    }
-    delete[] ch_org;
-    delete[] ch_rec;
-    delete[] file_rec;
-    exit(1);
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  if (num_threads <= 0) {
+    num_threads = 1;
   }
+  libyuv::ParallelExecutor* const pool =
+      num_threads > 1 ? libyuv::CreateThreadPool(num_threads) : NULL;
+  if (verbose) {
+    fprintf(text, "Threads: %d\n", num_threads);
+  }
+  // Enough frames to keep each thread busy.
+  const int batch_frames = num_threads * 2;
+
+  const uint8_t** const frames_org = new const uint8_t*[batch_frames];
+  size_t* const sizes_org = new size_t[batch_frames];
+  const uint8_t** const frames_rec =
+      new const uint8_t*[batch_frames * num_rec];
+  size_t* const sizes_rec = new size_t[batch_frames * num_rec];
+  FrameJob* const jobs = new FrameJob[batch_frames * num_rec];
+  Batch batch = {jobs, pool != NULL, y_size, uv_size, total_size};
 
   metric* const distortion_psnr = new metric[num_rec];
   metric* const distortion_ssim = new metric[num_rec];
@@ -411,118 +708,188 @@ int main(int argc, const char* argv[]) {
     cur_distortion_psnr->global_u = 0.0;
     cur_distortion_psnr->global_v = 0.0;
     cur_distortion_psnr->global_all = 0.0;
-    distortion_ssim[cur_rec] = cur_distortion_psnr[cur_rec];
+    distortion_ssim[cur_rec] = *cur_distortion_psnr;
   }
 
   if (verbose) {
-    printf("Size: %dx%d\n", image_width, image_height);
+    fprintf(text, "Size: %dx%d\n", image_width, image_height);
   }
 
   if (!quiet) {
-    printf("Frame");
+    fprintf(text, "Frame");
     if (do_psnr) {
-      printf("\t PSNR-Y \t PSNR-U \t PSNR-V \t PSNR-All \t Frame");
+      fprintf(text, "\t PSNR-Y \t PSNR-U \t PSNR-V \t PSNR-All \t Frame");
     }
     if (do_ssim) {
-      printf("\t  SSIM-Y\t  SSIM-U\t  SSIM-V\t  SSIM-All\t Frame");
+      fprintf(text, "\t  SSIM-Y\t  SSIM-U\t  SSIM-V\t  SSIM-All\t Frame");
     }
     if (show_name) {
-      printf("\tName\n");
+      fprintf(text, "\tName\n");
     } else {
-      printf("\n");
+      fprintf(text, "\n");
     }
   }
-
-  int number_of_frames;
-  for (number_of_frames = 0;; ++number_of_frames) {
-    if (num_frames && number_of_frames >= num_frames) {
+  if (csv) {
+    fprintf(csv, "frame,name");
+    if (do_psnr) {
+      fprintf(csv, ",psnr_y,psnr_u,psnr_v,psnr_all");
+    }
+    if (do_ssim) {
+      fprintf(csv, do_lssim ? ",lssim_y,lssim_u,lssim_v,lssim_all"
+                            : ",ssim_y,ssim_u,ssim_v,ssim_all");
+    }
+    if (do_mse) {
+      fprintf(csv, ",mse_y,mse_u,mse_v,mse_all");
+    }
+    fprintf(csv, "\n");
+  }
+  if (json) {
+    fprintf(json, "{\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": [",
+            image_width, image_height);
+  }
+  const char* json_separator = "\n";
+
+  int number_of_frames = 0;
+  bool done = false;
+  while (!done) {
+    int count = batch_frames;
+    if (num_frames && num_frames - number_of_frames < count) {
+      count = num_frames - number_of_frames;
+    }
+    const uint64_t offset_org =
+        skip_org + number_of_frames * static_cast<uint64_t>(total_size);
+    const uint64_t offset_rec =
+        skip_rec + number_of_frames * static_cast<uint64_t>(total_size);
+    count = GetFrames(seq_org, offset_org, count, total_size, frames_org,
+                      sizes_org);
+    for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+      count = GetFrames(&seq_rec[cur_rec], offset_rec, count, total_size,
+                        frames_rec + cur_rec * batch_frames,
+                        sizes_rec + cur_rec * batch_frames);
+    }
+    if (count <= 0) {
       break;
     }
 
-    size_t bytes_org = fread(ch_org, sizeof(uint8_t), total_size, file_org);
-    if (bytes_org < total_size) {
-#ifdef HAVE_JPEG
-      // Try parsing file as a jpeg.
-      uint8_t* const ch_jpeg = new uint8_t[bytes_org];
-      memcpy(ch_jpeg, ch_org, bytes_org);
-      memset(ch_org, 0, total_size);
-
-      if (0 != libyuv::MJPGToI420(ch_jpeg, bytes_org, ch_org, image_width,
-                                  ch_org + y_size, (image_width + 1) / 2,
-                                  ch_org + y_size + uv_size,
-                                  (image_width + 1) / 2, image_width,
-                                  image_height, image_width, image_height)) {
-        delete[] ch_jpeg;
-        break;
+    // Read the next batch while this one is compared.
+    const uint64_t batch_size = count * static_cast<uint64_t>(total_size);
+    ReadAhead(seq_org, offset_org, offset_org + batch_size, batch_size);
+    for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+      ReadAhead(&seq_rec[cur_rec], offset_rec, offset_rec + batch_size,
+                batch_size);
+    }
+
+    for (int i = 0; i < count; ++i) {
+      for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+        FrameJob* job = &jobs[i * num_rec + cur_rec];
+        memset(job, 0, sizeof(*job));
+        job->org = frames_org[i];
+        job->org_size = sizes_org[i];
+        job->rec = frames_rec[cur_rec * batch_frames + i];
+        job->rec_size = sizes_rec[cur_rec * batch_frames + i];
       }
-      delete[] ch_jpeg;
-#else
-      break;
-#endif  // HAVE_JPEG
+    }
+    if (pool) {
+      pool->parallel_for(pool->opaque, count * num_rec, CompareFrames, &batch);
+    } else {
+      CompareFrames(&batch, 0, count * num_rec);
     }
 
-    for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-      size_t bytes_rec =
-          fread(ch_rec, sizeof(uint8_t), total_size, file_rec[cur_rec]);
-      if (bytes_rec < total_size) {
-#ifdef HAVE_JPEG
-        // Try parsing file as a jpeg.
-        uint8_t* const ch_jpeg = new uint8_t[bytes_rec];
-        memcpy(ch_jpeg, ch_rec, bytes_rec);
-        memset(ch_rec, 0, total_size);
-
-        if (0 != libyuv::MJPGToI420(ch_jpeg, bytes_rec, ch_rec, image_width,
-                                    ch_rec + y_size, (image_width + 1) / 2,
-                                    ch_rec + y_size + uv_size,
-                                    (image_width + 1) / 2, image_width,
-                                    image_height, image_width, image_height)) {
-          delete[] ch_jpeg;
-          break;
+    // Report frames in order. Stop at the first frame that could not be
+    // compared, such as a short frame that is not a jpeg.
+    for (int i = 0; i < count && !done; ++i) {
+      for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+        if (!jobs[i * num_rec + cur_rec].valid) {
+          done = true;
         }
-        delete[] ch_jpeg;
-#else
-        break;
-#endif  // HAVE_JPEG
       }
-
-      if (verbose) {
-        printf("%5d", number_of_frames);
+      if (done) {
+        break;
       }
-      if (do_psnr) {
-        metric distorted_frame = {};
-        metric* cur_distortion_psnr = &distortion_psnr[cur_rec];
-        bool ismin = UpdateMetrics(ch_org, ch_rec, y_size, uv_size, total_size,
-                                   number_of_frames, cur_distortion_psnr,
-                                   &distorted_frame, true);
+      for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
+        const FrameJob* job = &jobs[i * num_rec + cur_rec];
+        const char* const name = argv[fileindex_rec + cur_rec];
         if (verbose) {
-          printf("\t%10.6f", distorted_frame.y);
-          printf("\t%10.6f", distorted_frame.u);
-          printf("\t%10.6f", distorted_frame.v);
-          printf("\t%10.6f", distorted_frame.all);
-          printf("\t%5s", ismin ? "min" : "");
+          fprintf(text, "%5d", number_of_frames);
+        }
+        if (do_psnr || do_mse) {
+          metric* cur_distortion_psnr = &distortion_psnr[cur_rec];
+          cur_distortion_psnr->global_y += job->sse_y;
+          cur_distortion_psnr->global_u += job->sse_u;
+          cur_distortion_psnr->global_v += job->sse_v;
+          cur_distortion_psnr->global_all +=
+              job->sse_y + job->sse_u + job->sse_v;
+        }
+        if (do_psnr) {
+          bool ismin = UpdateMetrics(job->psnr, number_of_frames,
+                                     &distortion_psnr[cur_rec]);
+          if (verbose) {
+            fprintf(text, "\t%10.6f", job->psnr.y);
+            fprintf(text, "\t%10.6f", job->psnr.u);
+            fprintf(text, "\t%10.6f", job->psnr.v);
+            fprintf(text, "\t%10.6f", job->psnr.all);
+            fprintf(text, "\t%5s", ismin ? "min" : "");
+          }
+        }
+        if (do_ssim) {
+          bool ismin = UpdateMetrics(job->ssim, number_of_frames,
+                                     &distortion_ssim[cur_rec]);
+          if (verbose) {
+            fprintf(text, "\t%10.6f", job->ssim.y);
+            fprintf(text, "\t%10.6f", job->ssim.u);
+            fprintf(text, "\t%10.6f", job->ssim.v);
+            fprintf(text, "\t%10.6f", job->ssim.all);
+            fprintf(text, "\t%5s", ismin ? "min" : "");
+          }
         }
-      }
-      if (do_ssim) {
-        metric distorted_frame = {};
-        metric* cur_distortion_ssim = &distortion_ssim[cur_rec];
-        bool ismin = UpdateMetrics(ch_org, ch_rec, y_size, uv_size, total_size,
-                                   number_of_frames, cur_distortion_ssim,
-                                   &distorted_frame, false);
         if (verbose) {
-          printf("\t%10.6f", distorted_frame.y);
-          printf("\t%10.6f", distorted_frame.u);
-          printf("\t%10.6f", distorted_frame.v);
-          printf("\t%10.6f", distorted_frame.all);
-          printf("\t%5s", ismin ? "min" : "");
+          if (show_name) {
+            fprintf(text, "\t%s", name);
+          }
+          fprintf(text, "\n");
         }
-      }
-      if (verbose) {
-        if (show_name) {
-          printf("\t%s", argv[fileindex_rec + cur_rec]);
+
+        if (csv) {
+          fprintf(csv, "%d,", number_of_frames);
+          PrintCsvName(csv, name);
+        }
+        if (json) {
+          fprintf(json, "%s    {\"frame\": %d, \"name\": ", json_separator,
+                  number_of_frames);
+          PrintJsonName(json, name);
+          json_separator = ",\n";
+        }
+        if (do_psnr) {
+          PrintFrameMetric(csv, json, "psnr", job->psnr.y, job->psnr.u,
+                           job->psnr.v, job->psnr.all);
+        }
+        if (do_ssim) {
+          PrintFrameMetric(csv, json, do_lssim ? "lssim" : "ssim",
+                           job->ssim.y, job->ssim.u, job->ssim.v,
+                           job->ssim.all);
+        }
+        if (do_mse) {
+          PrintFrameMetric(csv, json, "mse", GetMSE(job->sse_y, y_size),
+                           GetMSE(job->sse_u, uv_size),
+                           GetMSE(job->sse_v, uv_size),
+                           GetMSE(job->sse_y + job->sse_u + job->sse_v,
+                                  static_cast<double>(total_size)));
+        }
+        if (csv) {
+          fprintf(csv, "\n");
+        }
+        if (json) {
+          fprintf(json, "}");
         }
-        printf("\n");
       }
+      ++number_of_frames;
     }
+    if (count < batch_frames || (num_frames && number_of_frames >= num_frames)) {
+      done = true;
+    }
+  }
+  if (json) {
+    fprintf(json, "\n  ]\n}\n");
   }
 
   // Final PSNR computation.
@@ -554,49 +921,52 @@ int main(int argc, const char* argv[]) {
       const double global_psnr_all =
           ComputePSNR(cur_distortion_psnr->global_all,
                       static_cast<double>(total_size) * number_of_frames);
-      printf("Global:\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d", global_psnr_y,
-             global_psnr_u, global_psnr_v, global_psnr_all, number_of_frames);
+      fprintf(text, "Global:\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
+              global_psnr_y, global_psnr_u, global_psnr_v, global_psnr_all,
+              number_of_frames);
       if (show_name) {
-        printf("\t%s", argv[fileindex_rec + cur_rec]);
+        fprintf(text, "\t%s", argv[fileindex_rec + cur_rec]);
       }
-      printf("\n");
+      fprintf(text, "\n");
     }
 
     if (!quiet) {
-      printf("Avg:");
+      fprintf(text, "Avg:");
       if (do_psnr) {
-        printf("\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d", cur_distortion_psnr->y,
-               cur_distortion_psnr->u, cur_distortion_psnr->v,
-               cur_distortion_psnr->all, number_of_frames);
+        fprintf(text, "\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
+                cur_distortion_psnr->y, cur_distortion_psnr->u,
+                cur_distortion_psnr->v, cur_distortion_psnr->all,
+                number_of_frames);
       }
       if (do_ssim) {
-        printf("\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d", cur_distortion_ssim->y,
-               cur_distortion_ssim->u, cur_distortion_ssim->v,
-               cur_distortion_ssim->all, number_of_frames);
+        fprintf(text, "\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
+                cur_distortion_ssim->y, cur_distortion_ssim->u,
+                cur_distortion_ssim->v, cur_distortion_ssim->all,
+                number_of_frames);
       }
       if (show_name) {
-        printf("\t%s", argv[fileindex_rec + cur_rec]);
+        fprintf(text, "\t%s", argv[fileindex_rec + cur_rec]);
       }
-      printf("\n");
+      fprintf(text, "\n");
     }
     if (!quiet) {
-      printf("Min:");
+      fprintf(text, "Min:");
       if (do_psnr) {
-        printf("\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
-               cur_distortion_psnr->min_y, cur_distortion_psnr->min_u,
-               cur_distortion_psnr->min_v, cur_distortion_psnr->min_all,
-               cur_distortion_psnr->min_frame);
+        fprintf(text, "\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
+                cur_distortion_psnr->min_y, cur_distortion_psnr->min_u,
+                cur_distortion_psnr->min_v, cur_distortion_psnr->min_all,
+                cur_distortion_psnr->min_frame);
       }
       if (do_ssim) {
-        printf("\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
-               cur_distortion_ssim->min_y, cur_distortion_ssim->min_u,
-               cur_distortion_ssim->min_v, cur_distortion_ssim->min_all,
-               cur_distortion_ssim->min_frame);
+        fprintf(text, "\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d",
+                cur_distortion_ssim->min_y, cur_distortion_ssim->min_u,
+                cur_distortion_ssim->min_v, cur_distortion_ssim->min_all,
+                cur_distortion_ssim->min_frame);
       }
       if (show_name) {
-        printf("\t%s", argv[fileindex_rec + cur_rec]);
+        fprintf(text, "\t%s", argv[fileindex_rec + cur_rec]);
       }
-      printf("\n");
+      fprintf(text, "\n");
     }
 
     if (do_mse) {
@@ -612,22 +982,33 @@ int main(int argc, const char* argv[]) {
       double global_mse_all =
           GetMSE(cur_distortion_psnr->global_all,
                  static_cast<double>(total_size) * number_of_frames);
-      printf("MSE:\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d", global_mse_y,
-             global_mse_u, global_mse_v, global_mse_all, number_of_frames);
+      fprintf(text, "MSE:\t%10.6f\t%10.6f\t%10.6f\t%10.6f\t%5d", global_mse_y,
+              global_mse_u, global_mse_v, global_mse_all, number_of_frames);
       if (show_name) {
-        printf("\t%s", argv[fileindex_rec + cur_rec]);
+        fprintf(text, "\t%s", argv[fileindex_rec + cur_rec]);
       }
-      printf("\n");
+      fprintf(text, "\n");
     }
   }
-  fclose(file_org);
-  for (int cur_rec = 0; cur_rec < num_rec; ++cur_rec) {
-    fclose(file_rec[cur_rec]);
+  if (pool) {
+    libyuv::DestroyThreadPool(pool);
+  }
+  for (int i = 0; i <= num_rec; ++i) {
+    CloseSequence(&seqs[i]);
+  }
+  if (csv && csv != stdout) {
+    fclose(csv);
   }
+  if (json && json != stdout) {
+    fclose(json);
+  }
+  delete[] seqs;
+  delete[] frames_org;
+  delete[] sizes_org;
+  delete[] frames_rec;
+  delete[] sizes_rec;
+  delete[] jobs;
   delete[] distortion_psnr;
   delete[] distortion_ssim;
-  delete[] ch_org;
-  delete[] ch_rec;
-  delete[] file_rec;
   return 0;
 }
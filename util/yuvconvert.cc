@@ -68,7 +68,8 @@ void PrintHelp(const char* program) {
       "name.1920x800_24Hz_P420.yuv)\n"
       "                          Negative value mirrors.\n");
   printf(" -d <width> <height> .... specify destination resolution.\n");
-  printf(" -f <filter> ............ 0 = point, 1 = bilinear (default).\n");
+  printf(" -f <filter> ............ 0 = point, 1 = bilinear (default),\n");
+  printf("                          3 = box, 5 = lanczos.\n");
   printf(" -skip <src_argb> ....... Number of frame to skip of src_argb\n");
   printf(" -frames <num> .......... Number of frames to convert\n");
   printf(" -attenuate ............. Attenuate the ARGB image\n");